@@ -0,0 +1,201 @@
+/******************************************************************************
+ * File Name:   boot_cm7_stub.c
+ *
+ * Description: This file contains the CM7 hashing stub of the bootloader: a vector table and a
+ *              reset handler in the bootloader image that run boot_cm7_hash_run() on the
+ *              CM7 core of the application, with the stack at BOOT_CM7_HASH_ADDR. The
+ *              code is built for the CM0+ and runs unchanged on the CM7, whose instruction
+ *              set includes the one of the CM0+.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include "cy_pdl.h"
+#include "boot_cm7_stub.h"
+
+#if (BOOT_CM7_HASH)
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Core of the application, which is not running yet */
+#if (APP_CORE_ID == 0)
+#define BOOT_CM7_STUB_CORE              CORE_CM7_0
+#else
+#define BOOT_CM7_STUB_CORE              CORE_CM7_1
+#endif
+
+/* Exceptions of the vector table, the stub takes no interrupts */
+#define BOOT_CM7_STUB_VECTORS           (16U)
+
+/* The CM0+ hashes the slot itself if the stub makes no progress for this
+ * long */
+#define BOOT_CM7_STUB_POLL_US           (10U)
+#define BOOT_CM7_STUB_STALL_US          (100000U)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void boot_cm7_stub_reset(void);
+static void boot_cm7_stub_fault(void);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+typedef void (*boot_cm7_stub_vector_t)(void);
+
+/* Vector table of the stub, the CM7 requires 128-byte alignment */
+static const boot_cm7_stub_vector_t boot_cm7_stub_vectors[BOOT_CM7_STUB_VECTORS]
+    __attribute__((aligned(128))) =
+{
+    (boot_cm7_stub_vector_t)(BOOT_CM7_HASH_ADDR + BOOT_CM7_HASH_SIZE),
+    boot_cm7_stub_reset,
+    boot_cm7_stub_fault,
+    boot_cm7_stub_fault,
+    boot_cm7_stub_fault,
+    boot_cm7_stub_fault,
+    boot_cm7_stub_fault,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    boot_cm7_stub_fault,
+    boot_cm7_stub_fault,
+    NULL,
+    boot_cm7_stub_fault,
+    boot_cm7_stub_fault,
+};
+
+/******************************************************************************
+ * Function Name: boot_cm7_stub_reset
+ ******************************************************************************
+ * Summary:
+ *  Reset handler of the stub on the CM7: runs the job, then sleeps until the
+ *  CM0+ stops the core.
+ *
+ ******************************************************************************/
+static void boot_cm7_stub_reset(void)
+{
+    boot_cm7_hash_run();
+
+    while (true)
+    {
+        __WFI();
+    }
+}
+
+/******************************************************************************
+ * Function Name: boot_cm7_stub_fault
+ ******************************************************************************
+ * Summary:
+ *  Exception handler of the stub on the CM7. The job stays busy and the
+ *  CM0+ times out.
+ *
+ ******************************************************************************/
+static void boot_cm7_stub_fault(void)
+{
+    while (true)
+    {
+        __WFI();
+    }
+}
+
+/******************************************************************************
+ * Function Name: boot_cm7_stub_start
+ ******************************************************************************
+ * Summary:
+ *  This function requests the SHA-256 of a range of the flash and starts
+ *  the CM7 core of the application at the vector table of the stub.
+ *
+ * Parameters:
+ *  address - Flash address of the first byte
+ *  length - Bytes to hash
+ *
+ * Return:
+ *  true if the stub was started.
+ *
+ ******************************************************************************/
+bool boot_cm7_stub_start(uint32_t address, uint32_t length)
+{
+    boot_cm7_hash_request(address, length);
+    Cy_SysEnableCM7(BOOT_CM7_STUB_CORE, (uint32_t)boot_cm7_stub_vectors);
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: boot_cm7_stub_wait
+ ******************************************************************************
+ * Summary:
+ *  This function waits for the digest of the stub and stops the CM7 core,
+ *  so that it can be launched later at the application.
+ *
+ * Parameters:
+ *  digest - Receives the SHA-256
+ *
+ * Return:
+ *  true if the stub returned the digest, false if it made no progress for
+ *  BOOT_CM7_STUB_STALL_US.
+ *
+ ******************************************************************************/
+bool boot_cm7_stub_wait(uint8_t *digest)
+{
+    const boot_cm7_hash_job_t *job = boot_cm7_hash_job();
+    uint32_t progress = job->hashed;
+    uint32_t stalled_us = 0U;
+    bool done = false;
+
+    while (!done && (stalled_us < BOOT_CM7_STUB_STALL_US))
+    {
+        done = boot_cm7_hash_done(digest);
+        if (!done)
+        {
+            Cy_SysLib_DelayUs(BOOT_CM7_STUB_POLL_US);
+            if (job->hashed != progress)
+            {
+                progress = job->hashed;
+                stalled_us = 0U;
+            }
+            else
+            {
+                stalled_us += BOOT_CM7_STUB_POLL_US;
+            }
+        }
+    }
+
+    Cy_SysDisableCM7(BOOT_CM7_STUB_CORE);
+    return done;
+}
+#endif /* BOOT_CM7_HASH */
+
+/* [] END OF FILE */
@@ -0,0 +1,466 @@
+/******************************************************************************
+ * File Name:   boot_enc.c
+ *
+ * Description: This file contains the encrypted upgrade images of the bootloader. The AES-128 key
+ *              of an image is unwrapped from its ENC_EC256 TLV with the private key once per image.
+ *              The validation hashes the header, the code decrypted row by row and the protected
+ *              TLVs; the install decrypts the same rows on their way to the primary slot, so that
+ *              the code is read and programmed once.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "boot_enc.h"
+#include "boot_crypto.h"
+#include "swap_journal.h"
+
+#if (BOOT_ENC)
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Fields of the MCUboot image header and TLV area */
+#define BOOT_ENC_IMAGE_MAGIC            (0x96F3B83DUL)
+#define BOOT_ENC_TLV_INFO_MAGIC         (0x6907U)
+#define BOOT_ENC_TLV_PROT_INFO_MAGIC    (0x6908U)
+#define BOOT_ENC_HEADER_SIZE            (32U)
+#define BOOT_ENC_TLV_INFO_SIZE          (4U)
+
+/*******************************************************************************
+* Data Structures
+********************************************************************************/
+/* Encrypted image in a slot, offsets from the start of the slot */
+typedef struct
+{
+    uint32_t slot;
+    /* Encrypted code: from the end of the header to the TLVs */
+    uint32_t code_off;
+    uint32_t code_end;
+    /* End of the protected TLVs, the end of the hashed bytes */
+    uint32_t hashed_end;
+    /* End of the TLV area */
+    uint32_t end;
+    const uint8_t *key_tlv;
+} boot_enc_image_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static uint8_t enc_priv[BOOT_CRYPTO_P256_PRIV_SIZE];
+static bool enc_priv_valid = false;
+
+/* Key of the last TLV unwrapped: the validation and the install of an image
+ * run one ECDH */
+static uint8_t enc_key_tlv[BOOT_CRYPTO_ECIES_SIZE];
+static uint8_t enc_key[BOOT_CRYPTO_AES_KEY_SIZE];
+static bool enc_key_valid = false;
+
+static boot_enc_stats_t enc_stats;
+
+/* Row being decrypted, the flash controller programs from the SRAM */
+static uint32_t enc_row[BOOT_ENC_ROW_SIZE / sizeof(uint32_t)];
+
+/******************************************************************************
+ * Function Name: boot_enc_get16
+ ******************************************************************************
+ * Summary:
+ *  This function reads a little endian 16-bit field.
+ *
+ ******************************************************************************/
+static uint32_t boot_enc_get16(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+/******************************************************************************
+ * Function Name: boot_enc_get32
+ ******************************************************************************
+ * Summary:
+ *  This function reads a little endian 32-bit field.
+ *
+ ******************************************************************************/
+static uint32_t boot_enc_get32(const uint8_t *p)
+{
+    return boot_enc_get16(p) | (boot_enc_get16(&p[2]) << 16);
+}
+
+/******************************************************************************
+ * Function Name: boot_enc_parse
+ ******************************************************************************
+ * Summary:
+ *  This function finds the code, the TLV area and the key TLV of the
+ *  encrypted image in a slot. The key TLV is not protected, imgtool adds it
+ *  after the signature.
+ *
+ * Parameters:
+ *  slot - Address of the slot
+ *  slot_size - Size of the slot
+ *  img - Receives the layout of the image
+ *
+ * Return:
+ *  true if the slot holds an encrypted image with a key TLV, within the
+ *  slot.
+ *
+ ******************************************************************************/
+static bool boot_enc_parse(uint32_t slot, uint32_t slot_size, boot_enc_image_t *img)
+{
+    const uint8_t *header = swap_journal_port_ptr(slot, BOOT_ENC_HEADER_SIZE);
+    const uint8_t *info;
+    const uint8_t *tlvs;
+    uint32_t protect_size;
+    uint32_t info_off;
+
+    if ((NULL == header) || (BOOT_ENC_IMAGE_MAGIC != boot_enc_get32(header)) ||
+        (0U == (boot_enc_get32(&header[16]) & BOOT_ENC_FLAG)))
+    {
+        return false;
+    }
+    memset(img, 0, sizeof(*img));
+    img->slot = slot;
+    img->code_off = boot_enc_get16(&header[8]);
+    img->code_end = img->code_off + boot_enc_get32(&header[12]);
+    protect_size = boot_enc_get16(&header[10]);
+    img->hashed_end = img->code_end + protect_size;
+    info_off = img->hashed_end;
+    if ((img->code_off < BOOT_ENC_HEADER_SIZE) || (img->code_end < img->code_off) ||
+        (info_off < img->code_end) || (info_off > slot_size - BOOT_ENC_TLV_INFO_SIZE))
+    {
+        return false;
+    }
+    if (0U != protect_size)
+    {
+        info = swap_journal_port_ptr(slot + img->code_end, BOOT_ENC_TLV_INFO_SIZE);
+        if ((NULL == info) || (BOOT_ENC_TLV_PROT_INFO_MAGIC != boot_enc_get16(info)) ||
+            (boot_enc_get16(&info[2]) != protect_size))
+        {
+            return false;
+        }
+    }
+    info = swap_journal_port_ptr(slot + info_off, BOOT_ENC_TLV_INFO_SIZE);
+    if ((NULL == info) || (BOOT_ENC_TLV_INFO_MAGIC != boot_enc_get16(info)))
+    {
+        return false;
+    }
+    img->end = info_off + boot_enc_get16(&info[2]);
+    tlvs = swap_journal_port_ptr(slot + info_off, img->end - info_off);
+    if ((img->end > slot_size) || (NULL == tlvs))
+    {
+        return false;
+    }
+
+    for (uint32_t off = BOOT_ENC_TLV_INFO_SIZE; off + BOOT_ENC_TLV_INFO_SIZE <= img->end - info_off;)
+    {
+        uint32_t length = boot_enc_get16(&tlvs[off + 2U]);
+
+        if (off + BOOT_ENC_TLV_INFO_SIZE + length > img->end - info_off)
+        {
+            break;
+        }
+        if ((BOOT_ENC_TLV_EC256 == tlvs[off]) && (0U == tlvs[off + 1U]) && (BOOT_CRYPTO_ECIES_SIZE == length))
+        {
+            img->key_tlv = &tlvs[off + BOOT_ENC_TLV_INFO_SIZE];
+            return true;
+        }
+        off += BOOT_ENC_TLV_INFO_SIZE + length;
+    }
+    return false;
+}
+
+/******************************************************************************
+ * Function Name: boot_enc_key
+ ******************************************************************************
+ * Summary:
+ *  This function makes the key of an image the current key: it unwraps the
+ *  key TLV, unless the TLV is the one of the current key.
+ *
+ * Return:
+ *  true if the key is unwrapped, false if the key TLV does not belong to the
+ *  private key.
+ *
+ ******************************************************************************/
+static bool boot_enc_key(const boot_enc_image_t *img)
+{
+    if (enc_key_valid && (0 == memcmp(enc_key_tlv, img->key_tlv, BOOT_CRYPTO_ECIES_SIZE)))
+    {
+        enc_stats.key_hits++;
+        return true;
+    }
+    enc_key_valid = false;
+    if (!enc_priv_valid)
+    {
+        return false;
+    }
+    enc_stats.unwraps++;
+    if (!boot_crypto_ecies_p256_unwrap(enc_priv, img->key_tlv, enc_key))
+    {
+        return false;
+    }
+    memcpy(enc_key_tlv, img->key_tlv, BOOT_CRYPTO_ECIES_SIZE);
+    enc_key_valid = true;
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: boot_enc_read_row
+ ******************************************************************************
+ * Summary:
+ *  This function reads a row of an image to enc_row and decrypts the part
+ *  of it that is code.
+ *
+ * Parameters:
+ *  img - Image
+ *  aes - Cipher with the key of the image
+ *  off - Offset of the row in the slot
+ *  length - Length of the row, at most BOOT_ENC_ROW_SIZE
+ *
+ * Return:
+ *  Number of bytes decrypted, or -1 if the row is not flash.
+ *
+ ******************************************************************************/
+static int32_t boot_enc_read_row(const boot_enc_image_t *img, boot_crypto_aes_t *aes, uint32_t off,
+                                 uint32_t length)
+{
+    const uint8_t *src = swap_journal_port_ptr(img->slot + off, length);
+    uint8_t *row = (uint8_t *)enc_row;
+    uint32_t start = (off > img->code_off) ? off : img->code_off;
+    uint32_t end = ((off + length) < img->code_end) ? (off + length) : img->code_end;
+
+    if (NULL == src)
+    {
+        return -1;
+    }
+    memcpy(row, src, length);
+    if (start >= end)
+    {
+        return 0;
+    }
+    /* The counter is the offset in the code */
+    boot_crypto_aes_ctr(aes, start - img->code_off, &row[start - off], &row[start - off], end - start);
+    return (int32_t)(end - start);
+}
+
+/******************************************************************************
+ * Function Name: boot_enc_init
+ ******************************************************************************
+ * Summary:
+ *  This function sets the private key of the encrypted images, drops the
+ *  key unwrapped last and clears the counters, as a reset does.
+ *
+ * Parameters:
+ *  priv - Private key, PKCS#8 or SEC1 DER as imgtool getpriv writes it
+ *  priv_len - Length of the key
+ *
+ * Return:
+ *  true if the private key is an EC P-256 key.
+ *
+ ******************************************************************************/
+bool boot_enc_init(const uint8_t *priv, uint32_t priv_len)
+{
+    memset(&enc_stats, 0, sizeof(enc_stats));
+    enc_key_valid = false;
+    enc_priv_valid = boot_crypto_p256_priv_der(priv, priv_len, enc_priv);
+    return enc_priv_valid;
+}
+
+/******************************************************************************
+ * Function Name: boot_enc_is_encrypted
+ ******************************************************************************
+ * Summary:
+ *  This function returns true if the image header in a slot has the
+ *  encrypted flag. The primary slot keeps the flag of an installed image,
+ *  whose code is decrypted.
+ *
+ ******************************************************************************/
+bool boot_enc_is_encrypted(uint32_t slot)
+{
+    const uint8_t *header = swap_journal_port_ptr(slot, BOOT_ENC_HEADER_SIZE);
+
+    return (NULL != header) && (BOOT_ENC_IMAGE_MAGIC == boot_enc_get32(header)) &&
+           (0U != (boot_enc_get32(&header[16]) & BOOT_ENC_FLAG));
+}
+
+/******************************************************************************
+ * Function Name: boot_enc_hash
+ ******************************************************************************
+ * Summary:
+ *  This function computes the digest of the encrypted image in a slot as
+ *  its SHA256 TLV covers it: the header, the decrypted code and the
+ *  protected TLVs.
+ *
+ * Parameters:
+ *  slot - Address of the slot
+ *  slot_size - Size of the slot
+ *  digest - Receives the SHA-256
+ *
+ * Return:
+ *  true if the digest is computed, false if the slot holds no encrypted
+ *  image or its key cannot be unwrapped.
+ *
+ ******************************************************************************/
+bool boot_enc_hash(uint32_t slot, uint32_t slot_size, uint8_t digest[32])
+{
+    boot_enc_image_t img;
+    boot_crypto_aes_t aes;
+    boot_crypto_sha256_t sha256_ctx;
+    bool valid = true;
+
+    if (!boot_enc_parse(slot, slot_size, &img) || !boot_enc_key(&img))
+    {
+        return false;
+    }
+
+    boot_crypto_aes_init(&aes, enc_key);
+    boot_crypto_sha256_init(&sha256_ctx);
+    for (uint32_t off = 0U; off < img.hashed_end; off += BOOT_ENC_ROW_SIZE)
+    {
+        uint32_t length = ((img.hashed_end - off) < BOOT_ENC_ROW_SIZE) ? (img.hashed_end - off) : BOOT_ENC_ROW_SIZE;
+        int32_t decrypted = boot_enc_read_row(&img, &aes, off, length);
+
+        if (decrypted < 0)
+        {
+            valid = false;
+            break;
+        }
+        enc_stats.hashed += (uint32_t)decrypted;
+        boot_crypto_sha256_update(&sha256_ctx, (const uint8_t *)enc_row, length);
+    }
+    boot_crypto_sha256_final(&sha256_ctx, digest);
+    boot_crypto_aes_free(&aes);
+    return valid;
+}
+
+/******************************************************************************
+ * Function Name: boot_enc_install
+ ******************************************************************************
+ * Summary:
+ *  This function installs the encrypted image validated in the source slot
+ *  to the destination slot, as the overwrite upgrade of MCUboot copies it:
+ *  the sectors of the image and the last sector of the destination are
+ *  erased, the image is programmed row by row with its code decrypted, then
+ *  the first and the last sector of the source are erased. The source is
+ *  intact until the image is installed, an interrupted install starts again
+ *  at the next boot. The destination header keeps the encrypted flag.
+ *
+ * Parameters:
+ *  dst - Address of the destination slot
+ *  dst_size - Size of the destination slot
+ *  src - Address of the source slot
+ *  src_size - Size of the source slot
+ *
+ * Return:
+ *  0 on success, -1 if the source holds no encrypted image whose key can be
+ *  unwrapped or on a flash error.
+ *
+ ******************************************************************************/
+int boot_enc_install(uint32_t dst, uint32_t dst_size, uint32_t src, uint32_t src_size)
+{
+    boot_enc_image_t img;
+    boot_crypto_aes_t aes;
+    uint32_t erased = 0U;
+    uint32_t last;
+    int rc = 0;
+
+    if (!boot_enc_parse(src, src_size, &img) || (img.end > dst_size) || !boot_enc_key(&img) ||
+        (BOOT_ENC_ROW_SIZE != swap_journal_port_program_size(dst)) || (0U == dst_size) || (0U == src_size))
+    {
+        return -1;
+    }
+
+    boot_crypto_aes_init(&aes, enc_key);
+    for (uint32_t off = 0U; (0 == rc) && (off < img.end); off += BOOT_ENC_ROW_SIZE)
+    {
+        /* Erase the sector before its first row */
+        if (off >= erased)
+        {
+            uint32_t erase_size = swap_journal_port_erase_size(dst + off);
+
+            if ((0U == erase_size) || (0 != swap_journal_port_erase(dst + off)))
+            {
+                rc = -1;
+                break;
+            }
+            erased = off + erase_size - ((dst + off) % erase_size);
+            enc_stats.erases++;
+        }
+        /* The last row is programmed whole, the rest of it is the padding
+         * of the source */
+        if ((boot_enc_read_row(&img, &aes, off, BOOT_ENC_ROW_SIZE) < 0) ||
+            (0 != swap_journal_port_program(dst + off, (const uint8_t *)enc_row, BOOT_ENC_ROW_SIZE)))
+        {
+            rc = -1;
+            break;
+        }
+        enc_stats.installed += ((off + BOOT_ENC_ROW_SIZE) < img.code_end) ? BOOT_ENC_ROW_SIZE :
+                               ((off < img.code_end) ? (img.code_end - off) : 0U);
+        enc_stats.rows++;
+    }
+    boot_crypto_aes_free(&aes);
+
+    /* Trailer sector of the destination, then the header and the trailer of
+     * the source: the request is gone once the image is installed */
+    last = dst + dst_size - 1U;
+    if ((0 == rc) && (erased < dst_size))
+    {
+        rc = swap_journal_port_erase(last);
+        enc_stats.erases++;
+    }
+    if (0 == rc)
+    {
+        rc = swap_journal_port_erase(src);
+        enc_stats.erases++;
+    }
+    if (0 == rc)
+    {
+        rc = swap_journal_port_erase(src + src_size - 1U);
+        enc_stats.erases++;
+    }
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: boot_enc_stats_get
+ ******************************************************************************
+ * Summary:
+ *  This function returns the counters since boot_enc_init().
+ *
+ ******************************************************************************/
+void boot_enc_stats_get(boot_enc_stats_t *stats)
+{
+    *stats = enc_stats;
+}
+#endif /* BOOT_ENC */
+
+/* [] END OF FILE */
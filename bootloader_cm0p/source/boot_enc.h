@@ -0,0 +1,92 @@
+/******************************************************************************
+ * File Name:   boot_enc.h
+ *
+ * Description: This file contains the declarations of the encrypted upgrade images of the
+ *              bootloader: the key of an image is unwrapped from its ENC_EC256 TLV, the image is
+ *              validated and installed to the primary slot with its code decrypted row by row.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef BOOT_ENC_H
+#define BOOT_ENC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Set to 1 to install the encrypted upgrade images, ENC_IMG=1 */
+#ifndef BOOT_ENC
+#define BOOT_ENC                        (0)
+#endif
+
+/* Image header flag and key TLV of an image encrypted by imgtool with an EC
+ * P-256 key, as IMAGE_F_ENCRYPTED_AES128 and IMAGE_TLV_ENC_EC256 */
+#define BOOT_ENC_FLAG                   (0x00000004UL)
+#define BOOT_ENC_TLV_EC256              (0x32U)
+
+/* Rows decrypted at once, a code flash program row */
+#define BOOT_ENC_ROW_SIZE               (512U)
+
+/*******************************************************************************
+* Data Structures
+********************************************************************************/
+/* Counters since the last boot_enc_init() */
+typedef struct
+{
+    /* Keys unwrapped with the private key, and found in the key cache */
+    uint32_t unwraps;
+    uint32_t key_hits;
+    /* Bytes of code decrypted to be hashed, and to be installed */
+    uint32_t hashed;
+    uint32_t installed;
+    uint32_t rows;
+    uint32_t erases;
+} boot_enc_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+bool boot_enc_init(const uint8_t *priv, uint32_t priv_len);
+bool boot_enc_is_encrypted(uint32_t slot);
+bool boot_enc_hash(uint32_t slot, uint32_t slot_size, uint8_t digest[32]);
+int boot_enc_install(uint32_t dst, uint32_t dst_size, uint32_t src, uint32_t src_size);
+void boot_enc_stats_get(boot_enc_stats_t *stats);
+
+#endif /* BOOT_ENC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,175 @@
+/******************************************************************************
+ * File Name:   boot_fast.c
+ *
+ * Description: Fast boot profile of the bootloader: before boot_go(), the image headers and
+ *              trailers tell whether an image has an upgrade or a revert pending, a swap
+ *              interrupted or no valid header in its primary slot. Only then does the boot need the
+ *              console.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/image.h"
+#include "bootutil/bootutil.h"
+
+#include "boot_fast.h"
+
+/* The swap upgrade leaves trailers and a scratch area to check, the
+ * overwrite, the direct XIP and the RAM load modes do not */
+#if !defined(MCUBOOT_OVERWRITE_ONLY) && !defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)
+#define BOOT_FAST_SWAP              (1)
+#else
+#define BOOT_FAST_SWAP              (0)
+#endif
+
+#if (BOOT_FAST)
+/******************************************************************************
+ * Function Name: boot_fast_header_valid
+ ******************************************************************************
+ * Summary:
+ *  This function checks the magic of the image header in a slot. The image
+ *  is validated by boot_go() later.
+ *
+ * Parameters:
+ *  flash_area_id - Slot of the image
+ *
+ * Return:
+ *  true if the slot starts with an image header.
+ *
+ ******************************************************************************/
+static bool boot_fast_header_valid(int flash_area_id)
+{
+    const struct flash_area *fap = NULL;
+    struct image_header hdr;
+    bool valid = false;
+
+    if (0 == flash_area_open(flash_area_id, &fap))
+    {
+        valid = (0 == flash_area_read(fap, 0, &hdr, sizeof(hdr))) && (IMAGE_MAGIC == hdr.ih_magic);
+        flash_area_close(fap);
+    }
+    return valid;
+}
+
+#if (BOOT_FAST_SWAP)
+/******************************************************************************
+ * Function Name: boot_fast_swap_open
+ ******************************************************************************
+ * Summary:
+ *  This function reads the trailer of an area as boot_status_source() does:
+ *  a primary slot with the magic and no copy done flag, or a scratch area
+ *  with the magic, is left by an interrupted swap.
+ *
+ * Parameters:
+ *  flash_area_id - Primary slot or scratch area
+ *
+ * Return:
+ *  true if a swap is interrupted or the trailer cannot be read.
+ *
+ ******************************************************************************/
+static bool boot_fast_swap_open(int flash_area_id)
+{
+    struct boot_swap_state state;
+
+    if (0 != boot_read_swap_state_by_id(flash_area_id, &state))
+    {
+        return true;
+    }
+    if (FLASH_AREA_IMAGE_SCRATCH == flash_area_id)
+    {
+        return (BOOT_MAGIC_GOOD == state.magic);
+    }
+    return (BOOT_MAGIC_GOOD == state.magic) && (BOOT_FLAG_SET != state.copy_done);
+}
+#endif /* BOOT_FAST_SWAP */
+
+/******************************************************************************
+ * Function Name: boot_fast_pending
+ ******************************************************************************
+ * Summary:
+ *  This function tells whether boot_go() has more to do than to validate
+ *  and launch the primary images. It only reads the flash and prints
+ *  nothing, so it runs before the console is initialized. The journaled
+ *  swap writes the trailers last, an open journal leaves a request in them.
+ *  In the direct XIP and the RAM load modes boot_go() installs nothing, it
+ *  only selects the slot of the highest version.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  true if an image has an upgrade or a revert pending, a swap interrupted
+ *  or no header in its primary slot. In the direct XIP and the RAM load
+ *  modes, true if no slot of an image has a header.
+ *
+ ******************************************************************************/
+bool boot_fast_pending(void)
+{
+    for (int i = 0; i < MCUBOOT_IMAGE_NUMBER; i++)
+    {
+#if defined(MCUBOOT_DIRECT_XIP) || defined(MCUBOOT_RAM_LOAD)
+        if (!boot_fast_header_valid(FLASH_AREA_IMAGE_PRIMARY(i)) &&
+            !boot_fast_header_valid(FLASH_AREA_IMAGE_SECONDARY(i)))
+        {
+            return true;
+        }
+#else
+        if (!boot_fast_header_valid(FLASH_AREA_IMAGE_PRIMARY(i)) ||
+            (BOOT_SWAP_TYPE_NONE != boot_swap_type_multi(i)))
+        {
+            return true;
+        }
+#endif /* MCUBOOT_DIRECT_XIP || MCUBOOT_RAM_LOAD */
+#if (BOOT_FAST_SWAP)
+        if (boot_fast_swap_open(FLASH_AREA_IMAGE_PRIMARY(i)))
+        {
+            return true;
+        }
+#endif /* BOOT_FAST_SWAP */
+    }
+#if (BOOT_FAST_SWAP)
+    return boot_fast_swap_open(FLASH_AREA_IMAGE_SCRATCH);
+#else
+    return false;
+#endif /* BOOT_FAST_SWAP */
+}
+#endif /* BOOT_FAST */
+
+/* [] END OF FILE */
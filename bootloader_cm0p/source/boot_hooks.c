@@ -0,0 +1,1270 @@
+/******************************************************************************
+ * File Name:   boot_hooks.c
+ *
+ * Description: This file contains the MCUboot image access hooks of the edge protect bootloader.
+ *              The slots can be hashed on the CM7 while the CM0+ reads the TLVs. With the crypto
+ *              block backend of boot_crypto.c the slots are hashed and their signature verified on
+ *              the crypto block. Images signed with Ed25519, SIGN_KEY_TYPE=ED25519, are verified
+ *              here since the MCUboot configuration only verifies EC256. The slots can be swapped
+ *              with the journaled swap of swap_journal.c. All other hooks keep the regular MCUboot
+ *              behavior.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "sysflash/sysflash.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "bootutil/image.h"
+#include "bootutil/bootutil.h"
+#include "bootutil/boot_hooks.h"
+#include "bootutil/sign_key.h"
+#include "bootutil/bootutil_log.h"
+#include "bootutil/fault_injection_hardening.h"
+#include "bootutil_priv.h"
+#include "swap_priv.h"
+
+#include "boot_cm7_stub.h"
+#include "boot_crypto.h"
+#include "boot_enc.h"
+#include "boot_multi.h"
+#include "boot_timing.h"
+#include "dfu_sha256.h"
+#include "swap_journal.h"
+
+#if defined(MCUBOOT_IMAGE_ACCESS_HOOKS)
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Largest signature TLV read by the hook */
+#define BOOT_HOOKS_SIG_MAX_SIZE         (128U)
+
+/* Set by the Makefile with SIGN_KEY_TYPE=ED25519 */
+#ifndef BOOT_SIGN_ED25519
+#define BOOT_SIGN_ED25519               (0)
+#endif
+
+/* Ed25519 signature TLV, as imgtool writes it */
+#ifndef IMAGE_TLV_ED25519
+#define IMAGE_TLV_ED25519               (0x24U)
+#endif
+
+#if defined(MCUBOOT_SIGN_EC256) && !defined(MCUBOOT_HW_ROLLBACK_PROT) && \
+    !defined(MCUBOOT_ENC_IMAGES) && !defined(MCUBOOT_RAM_LOAD)
+#define BOOT_HOOKS_CM7_HASH             (BOOT_CM7_HASH)
+#define BOOT_HOOKS_CRYPTO               (BOOT_CRYPTO == BOOT_CRYPTO_HW)
+#define BOOT_HOOKS_ED25519              (BOOT_SIGN_ED25519)
+#define BOOT_HOOKS_ENC                  (BOOT_ENC)
+#else
+/* The security counter, the encryption of MCUboot and other signature types
+ * are left to the regular validation, so is the copy of the RAM load mode:
+ * the digests of the hooks are those of the slot, not of the SRAM */
+#define BOOT_HOOKS_CM7_HASH             (0)
+#define BOOT_HOOKS_CRYPTO               (0)
+#define BOOT_HOOKS_ED25519              (0)
+#define BOOT_HOOKS_ENC                  (0)
+#endif
+
+/* The hook validates images with a digest it did not compute in software on
+ * the CM0+, all images signed with Ed25519, which MCUboot does not verify in
+ * this configuration, and the encrypted upgrade images, which MCUboot does
+ * not decrypt */
+#define BOOT_HOOKS_DIGEST               ((BOOT_HOOKS_CM7_HASH) || (BOOT_HOOKS_CRYPTO) || \
+                                         (BOOT_HOOKS_ED25519) || (BOOT_HOOKS_ENC))
+
+/* SHA-256 of the images and of the keys */
+#define BOOT_HOOKS_DIGEST_SIZE          (32U)
+
+/* Signature TLV verified by the hooks */
+#if (BOOT_HOOKS_ED25519)
+#define BOOT_HOOKS_SIG_TLV              (IMAGE_TLV_ED25519)
+#else
+#define BOOT_HOOKS_SIG_TLV              (IMAGE_TLV_ECDSA256)
+#endif /* BOOT_HOOKS_ED25519 */
+
+/* An open journaled swap is validated by the hooks, which do not check the
+ * security counter */
+#if (BOOT_SWAP_JOURNAL) && !defined(MCUBOOT_OVERWRITE_ONLY) && !defined(MCUBOOT_DIRECT_XIP) && \
+    !defined(MCUBOOT_RAM_LOAD) && defined(MCUBOOT_SIGN_EC256) && !defined(MCUBOOT_HW_ROLLBACK_PROT)
+#define BOOT_HOOKS_SWAP                 (1)
+#else
+#define BOOT_HOOKS_SWAP                 (0)
+#endif
+
+#if (BOOT_HOOKS_ENC)
+/* enc_priv_key[] of ENC_KEY_FILE, in source/boot_keys.c */
+extern const struct bootutil_key bootutil_enc_key;
+#endif /* BOOT_HOOKS_ENC */
+
+#if (BOOT_HOOKS_DIGEST) || (BOOT_HOOKS_SWAP)
+/******************************************************************************
+ * Function Name: boot_hooks_find_key
+ ******************************************************************************
+ * Summary:
+ *  This function finds the built-in key whose SHA-256 is the key hash of the
+ *  image.
+ *
+ * Parameters:
+ *  keyhash - Key hash TLV of the image
+ *  keyhash_len - Length of the key hash TLV
+ *
+ * Return:
+ *  Index of the key, -1 if none matches.
+ *
+ ******************************************************************************/
+static int boot_hooks_find_key(const uint8_t *keyhash, uint32_t keyhash_len)
+{
+    boot_crypto_sha256_t sha256_ctx;
+    uint8_t hash[BOOT_HOOKS_DIGEST_SIZE];
+
+    if (keyhash_len != BOOT_HOOKS_DIGEST_SIZE)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < bootutil_key_cnt; i++)
+    {
+        const struct bootutil_key *key = &bootutil_keys[i];
+
+        boot_crypto_sha256_init(&sha256_ctx);
+        boot_crypto_sha256_update(&sha256_ctx, key->key, *key->len);
+        boot_crypto_sha256_final(&sha256_ctx, hash);
+
+        if (0 == memcmp(hash, keyhash, keyhash_len))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/******************************************************************************
+ * Function Name: boot_hooks_verify_sig
+ ******************************************************************************
+ * Summary:
+ *  This function verifies the signature TLV of an image over its digest:
+ *  Ed25519 with SIGN_KEY_TYPE=ED25519, otherwise EC256, on the crypto block
+ *  with BOOT_CRYPTO=HW.
+ *
+ * Parameters:
+ *  key_id - Index of the key
+ *  digest - SHA-256 of the image
+ *  sig - Signature TLV
+ *  sig_len - Length of the signature TLV
+ *
+ * Return:
+ *  FIH_SUCCESS if the signature verifies.
+ *
+ ******************************************************************************/
+static fih_int boot_hooks_verify_sig(int key_id, uint8_t *digest, uint8_t *sig, uint16_t sig_len)
+{
+    fih_int fih_sig = FIH_FAILURE;
+
+#if (BOOT_HOOKS_ED25519)
+    fih_sig = boot_crypto_ed25519_verify_der(bootutil_keys[key_id].key, *bootutil_keys[key_id].len,
+                                             digest, sig, sig_len) ? FIH_SUCCESS : FIH_FAILURE;
+#else
+#if (BOOT_HOOKS_CRYPTO)
+    if (boot_crypto_ready())
+    {
+        fih_sig = boot_crypto_p256_verify_der(bootutil_keys[key_id].key, *bootutil_keys[key_id].len,
+                                              digest, sig, sig_len) ? FIH_SUCCESS : FIH_FAILURE;
+    }
+    else
+#endif /* BOOT_HOOKS_CRYPTO */
+    {
+        FIH_CALL(bootutil_verify_sig, fih_sig, digest, BOOT_HOOKS_DIGEST_SIZE, sig, sig_len, (uint8_t)key_id);
+    }
+#endif /* BOOT_HOOKS_ED25519 */
+
+    FIH_RET(fih_sig);
+}
+#endif /* BOOT_HOOKS_DIGEST || BOOT_HOOKS_SWAP */
+
+#if (BOOT_HOOKS_DIGEST)
+#if (BOOT_HOOKS_ED25519)
+/******************************************************************************
+ * Function Name: boot_hooks_hash_slot
+ ******************************************************************************
+ * Summary:
+ *  This function hashes a memory mapped slot on the CM0+, with the crypto
+ *  backend when it is ready, otherwise in software. It computes the digest
+ *  of an Ed25519 signed image when no other unit did.
+ *
+ * Parameters:
+ *  addr - Address of the slot
+ *  extent - Length of the header, image and protected TLVs
+ *  digest - SHA-256 of the slot
+ *
+ ******************************************************************************/
+static void boot_hooks_hash_slot(uintptr_t addr, uint32_t extent, uint8_t digest[BOOT_HOOKS_DIGEST_SIZE])
+{
+    if (boot_crypto_ready())
+    {
+        boot_crypto_sha256_t sha256_ctx;
+
+        boot_crypto_sha256_init(&sha256_ctx);
+        boot_crypto_sha256_update(&sha256_ctx, (const uint8_t *)addr, extent);
+        boot_crypto_sha256_final(&sha256_ctx, digest);
+    }
+    else
+    {
+        dfu_sha256_t sha256_ctx;
+
+        dfu_sha256_init(&sha256_ctx);
+        dfu_sha256_update(&sha256_ctx, (const uint8_t *)addr, extent);
+        dfu_sha256_final(&sha256_ctx, digest);
+    }
+}
+#endif /* BOOT_HOOKS_ED25519 */
+
+#if (BOOT_HOOKS_ENC)
+/******************************************************************************
+ * Function Name: boot_hooks_enc_ready
+ ******************************************************************************
+ * Summary:
+ *  This function sets the private key of the encrypted images on its first
+ *  call.
+ *
+ * Return:
+ *  true if the private key is an EC P-256 key.
+ *
+ ******************************************************************************/
+static bool boot_hooks_enc_ready(void)
+{
+    static bool ready = false;
+
+    if (!ready)
+    {
+        ready = boot_enc_init(bootutil_enc_key.key, *bootutil_enc_key.len);
+        if (!ready)
+        {
+            BOOT_LOG_ERR("Invalid private key of the encrypted images");
+        }
+    }
+    return ready;
+}
+#endif /* BOOT_HOOKS_ENC */
+
+/******************************************************************************
+ * Function Name: boot_hooks_check_digest
+ ******************************************************************************
+ * Summary:
+ *  This function validates the image in a slot with a digest the CM0+ does
+ *  not compute: the digest of the CM7 hashing stub, which hashes the slot
+ *  while the CM0+ reads the TLVs and finds the key, otherwise the digest of
+ *  the crypto block. The digest must be the one of
+ *  the SHA256 TLV and the signature of the image must verify over it, on
+ *  the crypto block with BOOT_CRYPTO=HW. With SIGN_KEY_TYPE=ED25519 the
+ *  CM0+ hashes the slot when no other unit does and verifies the Ed25519
+ *  signature TLV itself. With ENC_IMG=1 the digest of an encrypted image in
+ *  the secondary slot is the one of its decrypted code, computed on the
+ *  CM0+; the primary slot holds an installed image decrypted.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *  slot - Slot of the image, 0 for the primary slot
+ *
+ * Return:
+ *  FIH_SUCCESS if the image is valid, otherwise BOOT_HOOK_REGULAR: the
+ *  regular validation hashes the slot on the CM0+ and decides, it rejects
+ *  Ed25519 signed images. FIH_FAILURE for an encrypted image whose key
+ *  cannot be unwrapped.
+ *
+ ******************************************************************************/
+static fih_int boot_hooks_check_digest(int img_index, int slot)
+{
+    fih_int fih_rc = fih_int_encode(BOOT_HOOK_REGULAR);
+    fih_int fih_sha = FIH_FAILURE;
+    fih_int fih_sig = FIH_FAILURE;
+    const struct flash_area *fap = NULL;
+    struct image_header hdr;
+    struct image_tlv_iter it;
+    uintptr_t flash_base = 0;
+    uint8_t digest[BOOT_HOOKS_DIGEST_SIZE];
+    uint8_t sha[BOOT_HOOKS_DIGEST_SIZE];
+    uint8_t buf[BOOT_HOOKS_SIG_MAX_SIZE];
+    uint32_t extent;
+    uint32_t off;
+    uint32_t sig_off = 0U;
+    uint16_t sig_len = 0U;
+    uint16_t len;
+    uint16_t type;
+    int key_id = -1;
+    bool have_sha = false;
+    bool have_digest = false;
+    bool hashing = false;
+#if (BOOT_HOOKS_ENC)
+    bool encrypted;
+#endif /* BOOT_HOOKS_ENC */
+    const char *source = "CM0+";
+    int rc;
+
+    if (0 != flash_area_open((BOOT_SECONDARY_SLOT == slot) ? FLASH_AREA_IMAGE_SECONDARY(img_index) :
+                             FLASH_AREA_IMAGE_PRIMARY(img_index), &fap))
+    {
+        FIH_RET(fih_rc);
+    }
+
+    rc = flash_area_read(fap, 0, &hdr, sizeof(hdr));
+    if ((0 != rc) || (IMAGE_MAGIC != hdr.ih_magic) || (0 != flash_device_base(fap->fa_device_id, &flash_base)))
+    {
+        flash_area_close(fap);
+        FIH_RET(fih_rc);
+    }
+#if (BOOT_HOOKS_ENC)
+    encrypted = IS_ENCRYPTED(&hdr) && (BOOT_SECONDARY_SLOT == slot);
+#else
+    if (IS_ENCRYPTED(&hdr))
+    {
+        flash_area_close(fap);
+        FIH_RET(fih_rc);
+    }
+#endif /* BOOT_HOOKS_ENC */
+    extent = (uint32_t)hdr.ih_hdr_size + hdr.ih_img_size + hdr.ih_protect_tlv_size;
+
+#if (BOOT_HOOKS_ENC)
+    if (encrypted)
+    {
+        /* The digests of the CM7 and the crypto block cover the encrypted
+         * code */
+        BOOT_TIMING_MARK(BOOT_PHASE_HASH_START, (uint32_t)slot);
+        if (!boot_hooks_enc_ready() ||
+            !boot_enc_hash((uint32_t)(flash_base + fap->fa_off), fap->fa_size, digest))
+        {
+            BOOT_LOG_ERR("Encrypted image cannot be decrypted");
+            flash_area_close(fap);
+            FIH_RET(FIH_FAILURE);
+        }
+        have_digest = true;
+        source = "decrypted image";
+    }
+#endif /* BOOT_HOOKS_ENC */
+#if (BOOT_HOOKS_CM7_HASH)
+    if (!have_digest && (extent <= fap->fa_size))
+    {
+        BOOT_TIMING_MARK(BOOT_PHASE_HASH_START, (uint32_t)slot);
+        hashing = boot_cm7_stub_start((uint32_t)(flash_base + fap->fa_off), extent);
+        source = "CM7 hashing stub";
+    }
+#endif /* BOOT_HOOKS_CM7_HASH */
+#if (BOOT_HOOKS_CRYPTO)
+    if (!have_digest && !hashing && (extent <= fap->fa_size) && boot_crypto_ready())
+    {
+        boot_crypto_sha256_t sha256_ctx;
+
+        /* The slot is memory mapped, the crypto block reads it directly */
+        BOOT_TIMING_MARK(BOOT_PHASE_HASH_START, (uint32_t)slot);
+        boot_crypto_sha256_init(&sha256_ctx);
+        boot_crypto_sha256_update(&sha256_ctx, (const uint8_t *)(flash_base + fap->fa_off), extent);
+        boot_crypto_sha256_final(&sha256_ctx, digest);
+        have_digest = true;
+        source = "crypto block";
+    }
+#endif /* BOOT_HOOKS_CRYPTO */
+#if (BOOT_HOOKS_ED25519)
+    if (!have_digest && !hashing && (extent <= fap->fa_size))
+    {
+        BOOT_TIMING_MARK(BOOT_PHASE_HASH_START, (uint32_t)slot);
+        boot_hooks_hash_slot(flash_base + fap->fa_off, extent, digest);
+        have_digest = true;
+        source = "CM0+";
+    }
+#endif /* BOOT_HOOKS_ED25519 */
+    if (!have_digest && !hashing)
+    {
+        flash_area_close(fap);
+        FIH_RET(fih_rc);
+    }
+
+    /* Read the TLVs and find the key while the CM7 hashes */
+    rc = bootutil_tlv_iter_begin(&it, &hdr, fap, IMAGE_TLV_ANY, false);
+    while (0 == rc)
+    {
+        rc = bootutil_tlv_iter_next(&it, &off, &len, &type);
+        if (0 != rc)
+        {
+            break;
+        }
+
+        if (IMAGE_TLV_SHA256 == type)
+        {
+            have_sha = (BOOT_HOOKS_DIGEST_SIZE == len) && (0 == flash_area_read(fap, off, sha, len));
+        }
+        else if (IMAGE_TLV_KEYHASH == type)
+        {
+            if ((len > sizeof(buf)) || (0 != flash_area_read(fap, off, buf, len)))
+            {
+                break;
+            }
+            key_id = boot_hooks_find_key(buf, len);
+        }
+        else if (BOOT_HOOKS_SIG_TLV == type)
+        {
+            sig_off = off;
+            sig_len = len;
+        }
+        else
+        {
+            /* Not covered by the digest */
+        }
+    }
+
+#if (BOOT_HOOKS_CM7_HASH)
+    if (hashing)
+    {
+        BOOT_TIMING_MARK(BOOT_PHASE_HASH_WAIT, (uint32_t)slot);
+        have_digest = boot_cm7_stub_wait(digest);
+        if (!have_digest)
+        {
+            BOOT_LOG_WRN("CM7 hashing stub timed out");
+        }
+    }
+#endif /* BOOT_HOOKS_CM7_HASH */
+#if (BOOT_HOOKS_ED25519)
+    /* The regular validation cannot verify Ed25519, hash the slot here */
+    if (!have_digest && (extent <= fap->fa_size))
+    {
+        boot_hooks_hash_slot(flash_base + fap->fa_off, extent, digest);
+        have_digest = true;
+        source = "CM0+";
+    }
+#endif /* BOOT_HOOKS_ED25519 */
+
+    if (have_digest && have_sha)
+    {
+        FIH_CALL(boot_fih_memequal, fih_sha, digest, sha, BOOT_HOOKS_DIGEST_SIZE);
+    }
+
+    if ((FIH_TRUE == fih_eq(fih_sha, FIH_SUCCESS)) && (key_id >= 0) && (0U != sig_len) &&
+        (sig_len <= sizeof(buf)) && (0 == flash_area_read(fap, sig_off, buf, sig_len)))
+    {
+        BOOT_TIMING_MARK(BOOT_PHASE_VERIFY_SIG, (uint32_t)slot);
+        FIH_CALL(boot_hooks_verify_sig, fih_sig, key_id, digest, buf, sig_len);
+    }
+
+    flash_area_close(fap);
+
+    if ((FIH_TRUE == fih_eq(fih_sha, FIH_SUCCESS)) && (FIH_TRUE == fih_eq(fih_sig, FIH_SUCCESS)))
+    {
+        BOOT_LOG_INF("%s slot validated with the digest of the %s",
+                     (BOOT_SECONDARY_SLOT == slot) ? "Secondary" : "Primary",
+                     source);
+        fih_rc = FIH_SUCCESS;
+    }
+
+    FIH_RET(fih_rc);
+}
+#endif /* BOOT_HOOKS_DIGEST */
+
+#if (BOOT_HOOKS_SWAP)
+/******************************************************************************
+ * Function Name: boot_hooks_swap_cfg
+ ******************************************************************************
+ * Summary:
+ *  This function describes the slots and the scratch area of an image for
+ *  the journaled swap: a move is the size of the scratch area, which must
+ *  divide the slots.
+ *
+ * Parameters:
+ *  primary - Primary slot
+ *  secondary - Secondary slot
+ *  cfg - Receives the swap configuration
+ *
+ * Return:
+ *  true if the journaled swap supports the slots.
+ *
+ ******************************************************************************/
+static bool boot_hooks_swap_cfg(const struct flash_area *primary, const struct flash_area *secondary,
+                                swap_journal_cfg_t *cfg)
+{
+    const struct flash_area *scratch = NULL;
+    uintptr_t base = 0;
+    bool supported = false;
+
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_SCRATCH, &scratch))
+    {
+        return false;
+    }
+
+    if ((0 == flash_device_base(scratch->fa_device_id, &base)) &&
+        (0U != scratch->fa_size) && (primary->fa_size == secondary->fa_size) &&
+        (0U == (primary->fa_size % scratch->fa_size)) &&
+        (primary->fa_size / scratch->fa_size <= SWAP_JOURNAL_MAX_SECTORS))
+    {
+        cfg->scratch = (uint32_t)(base + scratch->fa_off);
+        cfg->sector_size = scratch->fa_size;
+        cfg->sector_count = primary->fa_size / scratch->fa_size;
+        supported = (0 == flash_device_base(primary->fa_device_id, &base));
+        cfg->primary = (uint32_t)(base + primary->fa_off);
+        supported = supported && (0 == flash_device_base(secondary->fa_device_id, &base));
+        cfg->secondary = (uint32_t)(base + secondary->fa_off);
+    }
+
+    flash_area_close(scratch);
+    return supported;
+}
+
+/******************************************************************************
+ * Function Name: boot_hooks_swap_image
+ ******************************************************************************
+ * Summary:
+ *  This function describes the slots of an image for the journaled swap.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *  cfg - Receives the swap configuration
+ *
+ * Return:
+ *  true if the journaled swap supports the slots.
+ *
+ ******************************************************************************/
+static bool boot_hooks_swap_image(int img_index, swap_journal_cfg_t *cfg)
+{
+    const struct flash_area *primary = NULL;
+    const struct flash_area *secondary = NULL;
+    bool supported = false;
+
+    if ((0 == flash_area_open(FLASH_AREA_IMAGE_PRIMARY(img_index), &primary)) &&
+        (0 == flash_area_open(FLASH_AREA_IMAGE_SECONDARY(img_index), &secondary)))
+    {
+        supported = boot_hooks_swap_cfg(primary, secondary, cfg);
+    }
+
+    if (NULL != secondary)
+    {
+        flash_area_close(secondary);
+    }
+    if (NULL != primary)
+    {
+        flash_area_close(primary);
+    }
+    return supported;
+}
+
+/******************************************************************************
+ * Function Name: boot_hooks_swap_find
+ ******************************************************************************
+ * Summary:
+ *  This function finds the first sector of the upgrade image while a
+ *  journaled swap of the image is open: MCUboot reads the header and
+ *  validates the secondary slot before it calls boot_perform_update_hook(),
+ *  and the secondary slot holds parts of both images then.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *
+ * Return:
+ *  Address of the sector, 0 if no swap is open.
+ *
+ ******************************************************************************/
+static uint32_t boot_hooks_swap_find(int img_index)
+{
+    swap_journal_cfg_t cfg;
+
+    return boot_hooks_swap_image(img_index, &cfg) ? swap_journal_find_secondary(&cfg, 0U) : 0U;
+}
+
+/******************************************************************************
+ * Function Name: boot_hooks_swap_ptr
+ ******************************************************************************
+ * Summary:
+ *  This function maps bytes of the upgrade image of an open journaled swap,
+ *  up to the end of the sector that holds them. The sectors are found on
+ *  their first use.
+ *
+ * Parameters:
+ *  cfg - Swap configuration
+ *  sectors - Addresses of the sectors of the image found so far, 0 if not
+ *  off - Offset in the image
+ *  len - Bytes wanted, receives the bytes mapped
+ *
+ * Return:
+ *  Pointer to the bytes, NULL if their sector is not found.
+ *
+ ******************************************************************************/
+static const uint8_t *boot_hooks_swap_ptr(const swap_journal_cfg_t *cfg, uint32_t *sectors,
+                                          uint32_t off, uint32_t *len)
+{
+    uint32_t sector = off / cfg->sector_size;
+    uint32_t pos = off % cfg->sector_size;
+
+    if (sector >= cfg->sector_count)
+    {
+        return NULL;
+    }
+    if (0U == sectors[sector])
+    {
+        sectors[sector] = swap_journal_find_secondary(cfg, sector);
+        if (0U == sectors[sector])
+        {
+            return NULL;
+        }
+    }
+    if (*len > (cfg->sector_size - pos))
+    {
+        *len = cfg->sector_size - pos;
+    }
+    return swap_journal_port_ptr(sectors[sector] + pos, *len);
+}
+
+/******************************************************************************
+ * Function Name: boot_hooks_swap_read
+ ******************************************************************************
+ * Summary:
+ *  This function reads bytes of the upgrade image of an open journaled
+ *  swap, which may span two sectors.
+ *
+ * Parameters:
+ *  cfg - Swap configuration
+ *  sectors - Addresses of the sectors of the image found so far, 0 if not
+ *  off - Offset in the image
+ *  buf - Receives the bytes
+ *  len - Bytes to read
+ *
+ * Return:
+ *  true if the bytes are read.
+ *
+ ******************************************************************************/
+static bool boot_hooks_swap_read(const swap_journal_cfg_t *cfg, uint32_t *sectors, uint32_t off,
+                                 void *buf, uint32_t len)
+{
+    uint8_t *dst = (uint8_t *)buf;
+
+    while (0U != len)
+    {
+        uint32_t chunk = len;
+        const uint8_t *src = boot_hooks_swap_ptr(cfg, sectors, off, &chunk);
+
+        if (NULL == src)
+        {
+            return false;
+        }
+        (void)memcpy(dst, src, chunk);
+        dst += chunk;
+        off += chunk;
+        len -= chunk;
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: boot_hooks_swap_check
+ ******************************************************************************
+ * Summary:
+ *  This function validates the upgrade image while a journaled swap of it is
+ *  open. The journal is in the work flash, which the DFU application can
+ *  write, so it only tells where the sectors of the image are: the CM0+
+ *  hashes them in order, the digest must be the one of the SHA256 TLV and
+ *  the signature must verify over it. A sector is intact in one of the
+ *  slots during the swap, so an image validated before the swap started
+ *  validates again.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *
+ * Return:
+ *  FIH_SUCCESS if the image is valid.
+ *
+ ******************************************************************************/
+static fih_int boot_hooks_swap_check(int img_index)
+{
+    fih_int fih_rc = FIH_FAILURE;
+    fih_int fih_sha = FIH_FAILURE;
+    fih_int fih_sig = FIH_FAILURE;
+    swap_journal_cfg_t cfg;
+    uint32_t sectors[SWAP_JOURNAL_MAX_SECTORS] = { 0U };
+    boot_crypto_sha256_t sha256_ctx;
+    struct image_header hdr;
+    struct image_tlv_info info;
+    struct image_tlv tlv;
+    uint8_t digest[BOOT_HOOKS_DIGEST_SIZE];
+    uint8_t sha[BOOT_HOOKS_DIGEST_SIZE];
+    uint8_t buf[BOOT_HOOKS_SIG_MAX_SIZE];
+    uint32_t extent;
+    uint32_t end;
+    uint32_t off;
+    uint32_t sig_off = 0U;
+    uint16_t sig_len = 0U;
+    int key_id = -1;
+    bool have_sha = false;
+
+    if (!boot_hooks_swap_image(img_index, &cfg) ||
+        !boot_hooks_swap_read(&cfg, sectors, 0U, &hdr, sizeof(hdr)) ||
+        (IMAGE_MAGIC != hdr.ih_magic) || IS_ENCRYPTED(&hdr))
+    {
+        FIH_RET(fih_rc);
+    }
+    extent = (uint32_t)hdr.ih_hdr_size + hdr.ih_img_size + hdr.ih_protect_tlv_size;
+
+    BOOT_TIMING_MARK(BOOT_PHASE_HASH_START, (uint32_t)BOOT_SECONDARY_SLOT);
+    boot_crypto_sha256_init(&sha256_ctx);
+    for (off = 0U; off < extent;)
+    {
+        uint32_t chunk = extent - off;
+        const uint8_t *p = boot_hooks_swap_ptr(&cfg, sectors, off, &chunk);
+
+        if (NULL == p)
+        {
+            FIH_RET(fih_rc);
+        }
+        boot_crypto_sha256_update(&sha256_ctx, p, chunk);
+        off += chunk;
+    }
+    boot_crypto_sha256_final(&sha256_ctx, digest);
+
+    /* The unprotected TLVs: SHA256, key hash and signature */
+    if (!boot_hooks_swap_read(&cfg, sectors, extent, &info, sizeof(info)) ||
+        (IMAGE_TLV_INFO_MAGIC != info.it_magic))
+    {
+        FIH_RET(fih_rc);
+    }
+    end = extent + info.it_tlv_tot;
+    for (off = extent + sizeof(info); (off + sizeof(tlv)) <= end; off += sizeof(tlv) + tlv.it_len)
+    {
+        if (!boot_hooks_swap_read(&cfg, sectors, off, &tlv, sizeof(tlv)))
+        {
+            break;
+        }
+
+        if ((IMAGE_TLV_SHA256 == tlv.it_type) && (BOOT_HOOKS_DIGEST_SIZE == tlv.it_len))
+        {
+            have_sha = boot_hooks_swap_read(&cfg, sectors, off + sizeof(tlv), sha, tlv.it_len);
+        }
+        else if ((IMAGE_TLV_KEYHASH == tlv.it_type) && (tlv.it_len <= sizeof(buf)) &&
+                 boot_hooks_swap_read(&cfg, sectors, off + sizeof(tlv), buf, tlv.it_len))
+        {
+            key_id = boot_hooks_find_key(buf, tlv.it_len);
+        }
+        else if (BOOT_HOOKS_SIG_TLV == tlv.it_type)
+        {
+            sig_off = off + sizeof(tlv);
+            sig_len = tlv.it_len;
+        }
+        else
+        {
+            /* Not covered by the digest */
+        }
+    }
+
+    if (have_sha)
+    {
+        FIH_CALL(boot_fih_memequal, fih_sha, digest, sha, BOOT_HOOKS_DIGEST_SIZE);
+    }
+
+    if ((FIH_TRUE == fih_eq(fih_sha, FIH_SUCCESS)) && (key_id >= 0) && (0U != sig_len) &&
+        (sig_len <= sizeof(buf)) && boot_hooks_swap_read(&cfg, sectors, sig_off, buf, sig_len))
+    {
+        BOOT_TIMING_MARK(BOOT_PHASE_VERIFY_SIG, (uint32_t)BOOT_SECONDARY_SLOT);
+        FIH_CALL(boot_hooks_verify_sig, fih_sig, key_id, digest, buf, sig_len);
+    }
+
+    if ((FIH_TRUE == fih_eq(fih_sha, FIH_SUCCESS)) && (FIH_TRUE == fih_eq(fih_sig, FIH_SUCCESS)))
+    {
+        BOOT_LOG_INF("Secondary slot of the open journaled swap validated");
+        fih_rc = FIH_SUCCESS;
+    }
+    else
+    {
+        BOOT_LOG_ERR("Secondary slot of the open journaled swap is not valid");
+    }
+
+    FIH_RET(fih_rc);
+}
+
+/******************************************************************************
+ * Function Name: boot_hooks_swap_trailers
+ ******************************************************************************
+ * Summary:
+ *  This function updates the image trailers after the journaled swap as the
+ *  MCUboot swap does: the primary slot gets a new trailer, with the magic
+ *  written last, and the request in the secondary slot is erased. Every
+ *  step can be repeated after a power failure.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *  primary - Primary slot
+ *  secondary - Secondary slot
+ *  swap_type - BOOT_SWAP_TYPE_TEST, BOOT_SWAP_TYPE_PERM or BOOT_SWAP_TYPE_REVERT
+ *
+ * Return:
+ *  0 on success.
+ *
+ ******************************************************************************/
+static int boot_hooks_swap_trailers(int img_index, const struct flash_area *primary,
+                                    const struct flash_area *secondary, int swap_type)
+{
+    /* The swap status implementation of the trailers does not use the loader
+     * state */
+    int rc = swap_erase_trailer_sectors(NULL, primary);
+
+    if (0 == rc)
+    {
+        rc = boot_write_swap_info(primary, (uint8_t)swap_type, (uint8_t)img_index);
+    }
+    if ((0 == rc) && (BOOT_SWAP_TYPE_TEST != swap_type))
+    {
+        rc = boot_write_image_ok(primary);
+    }
+    if (0 == rc)
+    {
+        rc = boot_write_copy_done(primary);
+    }
+    if (0 == rc)
+    {
+        rc = boot_write_magic(primary);
+    }
+    if (0 == rc)
+    {
+        rc = swap_erase_trailer_sectors(NULL, secondary);
+    }
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: boot_hooks_swap
+ ******************************************************************************
+ * Summary:
+ *  This function swaps the slots of an image with the journaled swap and
+ *  updates the image trailers. A complete swap whose trailers are not
+ *  updated yet, the request in the secondary slot is still there, only gets
+ *  its trailers; an interrupted swap is resumed.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *  secondary - Secondary slot
+ *
+ * Return:
+ *  0 once the slots are swapped, BOOT_HOOK_REGULAR for the MCUboot swap.
+ *
+ ******************************************************************************/
+static int boot_hooks_swap(int img_index, const struct flash_area *secondary)
+{
+    const struct flash_area *primary = NULL;
+    struct boot_swap_state secondary_state;
+    swap_journal_cfg_t cfg;
+    swap_journal_state_t state;
+    int swap_type = boot_swap_type_multi(img_index);
+    int rc = BOOT_HOOK_REGULAR;
+
+    if ((BOOT_SWAP_TYPE_TEST != swap_type) && (BOOT_SWAP_TYPE_PERM != swap_type) &&
+        (BOOT_SWAP_TYPE_REVERT != swap_type))
+    {
+        return BOOT_HOOK_REGULAR;
+    }
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_PRIMARY(img_index), &primary))
+    {
+        return BOOT_HOOK_REGULAR;
+    }
+    if (!boot_hooks_swap_cfg(primary, secondary, &cfg) ||
+        (0 != boot_read_swap_state(secondary, &secondary_state)))
+    {
+        flash_area_close(primary);
+        return BOOT_HOOK_REGULAR;
+    }
+
+    swap_journal_port_init();
+    state = swap_journal_state(&cfg);
+    if ((SWAP_JOURNAL_STATE_COMPLETE == state) && (BOOT_MAGIC_GOOD != secondary_state.magic))
+    {
+        /* The trailers of that swap were updated, this is a new request */
+        (void)swap_journal_close();
+        state = SWAP_JOURNAL_STATE_NONE;
+    }
+    if (SWAP_JOURNAL_STATE_OPEN == state)
+    {
+        BOOT_LOG_INF("Resuming the journaled swap");
+    }
+
+    if ((0 == swap_journal_run(&cfg)) &&
+        (0 == boot_hooks_swap_trailers(img_index, primary, secondary, swap_type)) &&
+        (0 == swap_journal_close()))
+    {
+        swap_journal_stats_t stats;
+
+        swap_journal_stats_get(&stats);
+        BOOT_LOG_INF("Journaled swap: %u sectors through scratch, %u direct, %u erases",
+                     (unsigned)stats.sectors_scratch, (unsigned)stats.sectors_direct,
+                     (unsigned)stats.erases);
+        rc = 0;
+    }
+    else
+    {
+        /* Nothing moves until the next boot resumes the swap */
+        BOOT_LOG_ERR("Journaled swap failed");
+        rc = -1;
+    }
+
+    flash_area_close(primary);
+    return rc;
+}
+#endif /* BOOT_HOOKS_SWAP */
+
+#if (BOOT_HOOKS_ENC) && defined(MCUBOOT_OVERWRITE_ONLY)
+/******************************************************************************
+ * Function Name: boot_hooks_enc_install
+ ******************************************************************************
+ * Summary:
+ *  This function installs the encrypted image in the secondary slot to the
+ *  primary slot with its code decrypted, in place of the copy of MCUboot,
+ *  see boot_enc_install(). The key unwrapped by the validation is reused.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *  secondary - Secondary slot
+ *
+ * Return:
+ *  0 once the image is installed, -1 on failure: the secondary slot is
+ *  intact and the next boot installs it again.
+ *
+ ******************************************************************************/
+static int boot_hooks_enc_install(int img_index, const struct flash_area *secondary)
+{
+    const struct flash_area *primary = NULL;
+    uintptr_t flash_base = 0;
+    boot_enc_stats_t stats;
+    int rc = -1;
+
+    if (!boot_hooks_enc_ready() || (0 != flash_area_open(FLASH_AREA_IMAGE_PRIMARY(img_index), &primary)))
+    {
+        return -1;
+    }
+    if ((0 == flash_device_base(primary->fa_device_id, &flash_base)) &&
+        (primary->fa_device_id == secondary->fa_device_id))
+    {
+        swap_journal_port_init();
+        rc = boot_enc_install((uint32_t)(flash_base + primary->fa_off), primary->fa_size,
+                              (uint32_t)(flash_base + secondary->fa_off), secondary->fa_size);
+    }
+    flash_area_close(primary);
+
+    boot_enc_stats_get(&stats);
+    if (0 == rc)
+    {
+        BOOT_LOG_INF("Encrypted image installed: %u rows, %u erases, %u key unwraps",
+                     (unsigned)stats.rows, (unsigned)stats.erases, (unsigned)stats.unwraps);
+    }
+    else
+    {
+        BOOT_LOG_ERR("Install of the encrypted image failed");
+    }
+    return rc;
+}
+#endif /* BOOT_HOOKS_ENC && MCUBOOT_OVERWRITE_ONLY */
+
+#if (MCUBOOT_IMAGE_NUMBER > 1)
+/******************************************************************************
+ * Function Name: boot_hooks_check_primary
+ ******************************************************************************
+ * Summary:
+ *  This function validates the primary slot of an image in place of the
+ *  regular validation, which does not tell the hook its result, and
+ *  records the result with the entry of the image for its launch.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *  fih_hook - Result of the hook so far, BOOT_HOOK_REGULAR if it left the
+ *             validation to MCUboot
+ *
+ * Return:
+ *  FIH_SUCCESS if the image is valid, otherwise FIH_FAILURE.
+ *
+ ******************************************************************************/
+static fih_int boot_hooks_check_primary(int img_index, fih_int fih_hook)
+{
+    static uint8_t tmpbuf[BOOT_TMPBUF_SZ];
+    fih_int fih_rc = fih_hook;
+    const struct flash_area *fap = NULL;
+    struct image_header hdr;
+    uintptr_t flash_base = 0;
+    uint32_t entry = 0U;
+
+    if (0 != flash_area_open(FLASH_AREA_IMAGE_PRIMARY(img_index), &fap))
+    {
+        boot_multi_record(img_index, FIH_FAILURE, 0U);
+        FIH_RET(FIH_FAILURE);
+    }
+
+    if ((0 != flash_area_read(fap, 0, &hdr, sizeof(hdr))) || (IMAGE_MAGIC != hdr.ih_magic) ||
+        (0 != flash_device_base(fap->fa_device_id, &flash_base)))
+    {
+        fih_rc = FIH_FAILURE;
+    }
+    else
+    {
+        entry = (uint32_t)(flash_base + fap->fa_off + hdr.ih_hdr_size);
+        if (FIH_TRUE == fih_eq(fih_rc, fih_int_encode(BOOT_HOOK_REGULAR)))
+        {
+            FIH_CALL(bootutil_img_validate, fih_rc, NULL, img_index, &hdr, fap, tmpbuf, BOOT_TMPBUF_SZ,
+                     NULL, 0, NULL);
+        }
+    }
+    flash_area_close(fap);
+
+    if (FIH_TRUE != fih_eq(fih_rc, FIH_SUCCESS))
+    {
+        fih_rc = FIH_FAILURE;
+    }
+    boot_multi_record(img_index, fih_rc, entry);
+    FIH_RET(fih_rc);
+}
+#endif /* MCUBOOT_IMAGE_NUMBER > 1 */
+
+/******************************************************************************
+ * Function Name: boot_image_check_hook
+ ******************************************************************************
+ * Summary:
+ *  This function is called by MCUboot before it validates an image and
+ *  records the boot phase. While a journaled swap is open the secondary
+ *  slot is validated sector by sector where the journal places it. With
+ *  BOOT_CM7_HASH the other slots are hashed by the CM7 hashing stub, with
+ *  BOOT_CRYPTO=HW by the crypto block. With ENC_IMG an encrypted secondary
+ *  slot is hashed decrypted. In the direct XIP mode both slots are treated
+ *  as the primary and the secondary slot. With two images the hook
+ *  validates the primary slots itself and records the images the
+ *  bootloader may launch.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *  slot - Slot of the image, 0 for the primary slot
+ *
+ * Return:
+ *  FIH_SUCCESS if the image is valid, FIH_FAILURE if it is not,
+ *  BOOT_HOOK_REGULAR for the regular validation.
+ *
+ ******************************************************************************/
+fih_int boot_image_check_hook(int img_index, int slot)
+{
+    fih_int fih_rc = fih_int_encode(BOOT_HOOK_REGULAR);
+
+    BOOT_TIMING_MARK(BOOT_PHASE_VALIDATE, (uint32_t)slot);
+
+#if (BOOT_HOOKS_SWAP)
+    if ((BOOT_SECONDARY_SLOT == slot) && (0U != boot_hooks_swap_find(img_index)))
+    {
+        /* The slot holds parts of both images, validated where the journal
+         * places them before boot_perform_update_hook() resumes the swap */
+        FIH_RET(boot_hooks_swap_check(img_index));
+    }
+#endif /* BOOT_HOOKS_SWAP */
+
+#if (BOOT_HOOKS_DIGEST)
+    FIH_CALL(boot_hooks_check_digest, fih_rc, img_index, slot);
+#endif /* BOOT_HOOKS_DIGEST */
+#if (MCUBOOT_IMAGE_NUMBER > 1)
+    if (BOOT_PRIMARY_SLOT == slot)
+    {
+        FIH_CALL(boot_hooks_check_primary, fih_rc, img_index, fih_rc);
+    }
+#endif /* MCUBOOT_IMAGE_NUMBER > 1 */
+    (void)img_index;
+    (void)slot;
+
+    FIH_RET(fih_rc);
+}
+
+/******************************************************************************
+ * Function Name: boot_read_image_header_hook
+ ******************************************************************************
+ * Summary:
+ *  This function records the boot phase and keeps the regular reading of
+ *  the image header, except for the secondary slot while a journaled swap
+ *  is open: the header of the upgrade image is then read from the slot
+ *  that holds it.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *  slot - Slot of the image, 0 for the primary slot
+ *  img_hed - Receives the header
+ *
+ * Return:
+ *  0 if the header is read, BOOT_HOOK_REGULAR for the regular reading.
+ *
+ ******************************************************************************/
+int boot_read_image_header_hook(int img_index, int slot, struct image_header *img_hed)
+{
+    BOOT_TIMING_MARK(BOOT_PHASE_READ_HEADER, (uint32_t)slot);
+
+#if (BOOT_HOOKS_SWAP)
+    if (BOOT_SECONDARY_SLOT == slot)
+    {
+        uint32_t address = boot_hooks_swap_find(img_index);
+        const uint8_t *header = (0U != address) ?
+                                swap_journal_port_ptr(address, sizeof(*img_hed)) : NULL;
+
+        if (NULL != header)
+        {
+            (void)memcpy(img_hed, header, sizeof(*img_hed));
+            return 0;
+        }
+    }
+#else
+    (void)img_index;
+    (void)img_hed;
+#endif /* BOOT_HOOKS_SWAP */
+
+    return BOOT_HOOK_REGULAR;
+}
+
+/******************************************************************************
+ * Function Name: boot_perform_update_hook
+ ******************************************************************************
+ * Summary:
+ *  This function records the boot phase and swaps the slots with the
+ *  journaled swap if it is enabled. With ENC_IMG it installs an encrypted
+ *  image decrypted. Otherwise it keeps the regular update of the primary
+ *  slot.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *  img_head - Header of the image in the secondary slot
+ *  area - Secondary slot
+ *
+ * Return:
+ *  0 if the slots are swapped or the image is installed, BOOT_HOOK_REGULAR
+ *  for the regular update.
+ *
+ ******************************************************************************/
+int boot_perform_update_hook(int img_index, struct image_header *img_head,
+                             const struct flash_area *area)
+{
+    int rc = BOOT_HOOK_REGULAR;
+
+    (void)img_head;
+
+    BOOT_TIMING_MARK(BOOT_PHASE_UPDATE, (uint32_t)img_index);
+
+#if (BOOT_HOOKS_ENC) && defined(MCUBOOT_OVERWRITE_ONLY)
+    if (IS_ENCRYPTED(img_head))
+    {
+        rc = boot_hooks_enc_install(img_index, area);
+        if (0 == rc)
+        {
+            /* The copy hook is not called either */
+            BOOT_TIMING_MARK(BOOT_PHASE_UPDATE_DONE, (uint32_t)img_index);
+        }
+        return rc;
+    }
+#endif /* BOOT_HOOKS_ENC && MCUBOOT_OVERWRITE_ONLY */
+
+#if (BOOT_HOOKS_SWAP)
+    rc = boot_hooks_swap(img_index, area);
+    if (BOOT_HOOK_REGULAR != rc)
+    {
+        /* The copy hook is not called by the journaled swap */
+        BOOT_TIMING_MARK(BOOT_PHASE_UPDATE_DONE, (uint32_t)img_index);
+    }
+#else
+    (void)area;
+#endif /* BOOT_HOOKS_SWAP */
+
+    return rc;
+}
+
+/******************************************************************************
+ * Function Name: boot_copy_region_post_hook
+ ******************************************************************************
+ * Summary:
+ *  This function is called after an image is copied to the primary slot,
+ *  records the boot phase.
+ *
+ ******************************************************************************/
+int boot_copy_region_post_hook(int img_index, const struct flash_area *area, size_t size)
+{
+    (void)img_index;
+    (void)area;
+    (void)size;
+
+    BOOT_TIMING_MARK(BOOT_PHASE_UPDATE_DONE, (uint32_t)img_index);
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: boot_read_swap_state_primary_slot_hook
+ ******************************************************************************
+ * Summary:
+ *  This function keeps the regular reading of the swap state.
+ *
+ ******************************************************************************/
+int boot_read_swap_state_primary_slot_hook(int image_index, struct boot_swap_state *state)
+{
+    (void)image_index;
+    (void)state;
+
+    return BOOT_HOOK_REGULAR;
+}
+
+/******************************************************************************
+ * Function Name: boot_serial_uploaded_hook
+ ******************************************************************************
+ * Summary:
+ *  This function is called after an image is uploaded by serial recovery,
+ *  which is not used.
+ *
+ ******************************************************************************/
+int boot_serial_uploaded_hook(int img_index, const struct flash_area *area, size_t size)
+{
+    (void)img_index;
+    (void)area;
+    (void)size;
+
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: boot_img_install_stat_hook
+ ******************************************************************************
+ * Summary:
+ *  This function keeps the regular install status of an image.
+ *
+ ******************************************************************************/
+int boot_img_install_stat_hook(int image_index, int slot, int *img_install_stat)
+{
+    (void)image_index;
+    (void)slot;
+    (void)img_install_stat;
+
+    return BOOT_HOOK_REGULAR;
+}
+
+#endif /* MCUBOOT_IMAGE_ACCESS_HOOKS */
+
+/* [] END OF FILE */
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * File Name:   boot_keys.c
+ *
+ * Description: This file contains the built-in key table of an Ed25519 signing key,
+ *              SIGN_KEY_TYPE=ED25519, which replaces the keys.c of MCUboot that embeds an EC256
+ *              key, and the private key of the encrypted images, ENC_IMG=1. Both are read by the
+ *              image access hooks.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include "bootutil/sign_key.h"
+
+#if defined(BOOT_SIGN_ED25519) && (BOOT_SIGN_ED25519)
+/* ed25519_pub_key[] and ed25519_pub_key_len, as imgtool getpub writes them */
+#include ED25519_KEY_FILE
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+const struct bootutil_key bootutil_keys[] =
+{
+    {
+        .key = ed25519_pub_key,
+        .len = &ed25519_pub_key_len,
+    },
+};
+const int bootutil_key_cnt = 1;
+#endif /* BOOT_SIGN_ED25519 */
+
+#if defined(BOOT_ENC) && (BOOT_ENC)
+/* enc_priv_key[] and enc_priv_key_len, as imgtool getpriv writes them */
+#include ENC_KEY_FILE
+
+/* Private key of the encrypted images, see source/boot_enc.c */
+const struct bootutil_key bootutil_enc_key =
+{
+    .key = enc_priv_key,
+    .len = &enc_priv_key_len,
+};
+#endif /* BOOT_ENC */
+
+/* [] END OF FILE */
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * File Name:   boot_multi.c
+ *
+ * Description: This file contains the record of the images boot_go() validated. The image check
+ *              hook records the result of the last validation of each primary slot, and the
+ *              bootloader starts image 2 on the other CM7 core at the entry recorded for it only,
+ *              as do_boot() starts image 1 at the slot of the response of boot_go().
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sysflash/sysflash.h"
+#include "boot_multi.h"
+
+#if (MCUBOOT_IMAGE_NUMBER > 1)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Entry of the image in each primary slot, 0 for an image that failed */
+static fih_uint boot_multi_entries[MCUBOOT_IMAGE_NUMBER];
+/* The primary slot of the image was validated by boot_go() */
+static bool boot_multi_checked[MCUBOOT_IMAGE_NUMBER];
+
+/******************************************************************************
+ * Function Name: boot_multi_record
+ ******************************************************************************
+ * Summary:
+ *  This function records the result of the validation of the primary slot of
+ *  an image. boot_go() validates a primary slot again after its upgrade, the
+ *  last result counts.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *  fih_valid - FIH_SUCCESS if the image is valid
+ *  entry - Address of the vector table of the image
+ *
+ ******************************************************************************/
+void boot_multi_record(int img_index, fih_int fih_valid, uint32_t entry)
+{
+    if ((img_index < 0) || (img_index >= MCUBOOT_IMAGE_NUMBER))
+    {
+        return;
+    }
+
+    boot_multi_entries[img_index] = fih_uint_encode(0U);
+    if (FIH_TRUE == fih_eq(fih_valid, FIH_SUCCESS))
+    {
+        boot_multi_entries[img_index] = fih_uint_encode(entry);
+    }
+    boot_multi_checked[img_index] = true;
+}
+
+/******************************************************************************
+ * Function Name: boot_multi_entry
+ ******************************************************************************
+ * Summary:
+ *  This function returns the entry of an image boot_go() validated.
+ *
+ * Parameters:
+ *  img_index - Index of the image
+ *
+ * Return:
+ *  The address of the vector table of the image, 0 if boot_go() did not
+ *  validate its primary slot.
+ *
+ ******************************************************************************/
+fih_uint boot_multi_entry(int img_index)
+{
+    if ((img_index < 0) || (img_index >= MCUBOOT_IMAGE_NUMBER) || !boot_multi_checked[img_index])
+    {
+        return fih_uint_encode(0U);
+    }
+    return boot_multi_entries[img_index];
+}
+
+#endif /* MCUBOOT_IMAGE_NUMBER > 1 */
+
+/* [] END OF FILE */
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * File Name:   boot_ram.c
+ *
+ * Description: This file contains the launch check of the RAM load mode. MCUboot copies the image
+ *              of the highest version to its load address in the SRAM and validates the copy;
+ *              before the CM7 is started at it, the copy must lie in the load window and its vector
+ *              table must point into the SRAM and into the image.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "boot_ram.h"
+
+/******************************************************************************
+ * Function Name: boot_ram_get32
+ ******************************************************************************
+ * Summary:
+ *  This function reads a little endian 32-bit word.
+ *
+ ******************************************************************************/
+static uint32_t boot_ram_get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/******************************************************************************
+ * Function Name: boot_ram_entry
+ ******************************************************************************
+ * Summary:
+ *  This function checks the image boot_go() loaded to the SRAM and returns
+ *  the address the CM7 starts at, the vector table after the image header.
+ *  The image with its header must be in the load window, the vector table
+ *  aligned for the VTOR, the initial stack pointer in the SRAM and outside
+ *  the image, and the reset handler a Thumb address in the code of the
+ *  image. The image was validated in the SRAM, the check catches an image
+ *  signed for the RAM but linked for another address.
+ *
+ * Parameters:
+ *  window - Load window and SRAM of the device
+ *  copy - The loaded image, as the bootloader reads it
+ *  load_addr - Load address of the image header, ih_load_addr
+ *  hdr_size - Size of the image header, ih_hdr_size
+ *  img_size - Size of the code, ih_img_size
+ *
+ * Return:
+ *  The address of the vector table, 0 if the image cannot be started.
+ *
+ ******************************************************************************/
+uint32_t boot_ram_entry(const boot_ram_window_t *window, const uint8_t *copy, uint32_t load_addr,
+                        uint32_t hdr_size, uint32_t img_size)
+{
+    uint64_t end = (uint64_t)load_addr + hdr_size + img_size;
+    uint32_t entry = load_addr + hdr_size;
+    uint32_t stack;
+    uint32_t reset;
+
+    if ((NULL == window) || (NULL == copy) || (img_size < 8U) ||
+        (load_addr < window->start) || (end > ((uint64_t)window->start + window->size)) ||
+        (0U != (entry & (BOOT_RAM_VECTOR_ALIGN - 1U))))
+    {
+        return 0U;
+    }
+
+    stack = boot_ram_get32(&copy[hdr_size]);
+    reset = boot_ram_get32(&copy[hdr_size + 4U]);
+
+    /* The stack grows down from its top, which may be the end of the SRAM */
+    if ((stack <= window->sram_start) || (stack > (window->sram_start + window->sram_size)) ||
+        (0U != (stack & 7U)) || ((stack > load_addr) && (stack <= end)))
+    {
+        return 0U;
+    }
+    if ((0U == (reset & 1U)) || ((reset & ~1U) < (entry + 8U)) || ((reset & ~1U) >= end))
+    {
+        return 0U;
+    }
+    return entry;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * File Name:   boot_ram.h
+ *
+ * Description: This file contains the declarations of the launch check of the RAM load mode: the
+ *              image boot_go() copied to the SRAM of the CM7 and validated there must start with a
+ *              vector table the CM7 can run from the SRAM.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef BOOT_RAM_H
+#define BOOT_RAM_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Alignment of the vector table of the CM7, that of its VTOR for the
+ * interrupts of the device */
+#define BOOT_RAM_VECTOR_ALIGN           (0x400UL)
+
+/*******************************************************************************
+* Data Structures
+********************************************************************************/
+typedef struct
+{
+    /* Window the images are loaded to, IMAGE_EXECUTABLE_RAM_START and
+     * IMAGE_EXECUTABLE_RAM_SIZE */
+    uint32_t start;
+    uint32_t size;
+    /* SRAM of the device, the stack of the image must be in it */
+    uint32_t sram_start;
+    uint32_t sram_size;
+} boot_ram_window_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+uint32_t boot_ram_entry(const boot_ram_window_t *window, const uint8_t *copy, uint32_t load_addr,
+                        uint32_t hdr_size, uint32_t img_size);
+
+#endif /* BOOT_RAM_H */
+
+/* [] END OF FILE */
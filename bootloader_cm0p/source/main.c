@@ -59,6 +59,13 @@
 #include "bootutil/bootutil_log.h"
 #include "bootutil/fault_injection_hardening.h"
 
+#include "boot_crypto.h"
+#include "boot_fast.h"
+#include "boot_multi.h"
+#include "boot_ram.h"
+#include "boot_timing.h"
+#include "dlog.h"
+
 /*******************************************************************************
 * Macros
 ********************************************************************************/
@@ -76,6 +83,83 @@
 #define BOOT_MSG_FINISH                 "Edge Protect Bootloader finished.\r\n" \
                                         "Deinitializing hardware..."
 
+#if (BOOT_FAST)
+/* MCUboot is built without messages, which could come before the console is
+ * initialized. The messages of this file wait for it, except the errors,
+ * which initialize it */
+#undef BOOT_LOG_ERR
+#undef BOOT_LOG_WRN
+#undef BOOT_LOG_INF
+#undef BOOT_LOG_DBG
+#define BOOT_FAST_LOG(_prefix, _fmt, ...) \
+    do { if (console_ready) { printf(_prefix _fmt "\r\n", ##__VA_ARGS__); } } while (false)
+#define BOOT_LOG_ERR(_fmt, ...)         do { console_init(); BOOT_FAST_LOG("[ERR] ", _fmt, ##__VA_ARGS__); } while (false)
+#define BOOT_LOG_WRN(_fmt, ...)         BOOT_FAST_LOG("[WRN] ", _fmt, ##__VA_ARGS__)
+#define BOOT_LOG_INF(_fmt, ...)         BOOT_FAST_LOG("[INF] ", _fmt, ##__VA_ARGS__)
+#define BOOT_LOG_DBG(_fmt, ...)         BOOT_FAST_LOG("[DBG] ", _fmt, ##__VA_ARGS__)
+#endif /* BOOT_FAST */
+
+#if (DLOG)
+/* The messages of the boot path are deferred to the lane of the CM0+ and
+ * printed by the DFU application, the errors are printed as they occur */
+#undef BOOT_LOG_INF
+#undef BOOT_LOG_DBG
+#define BOOT_LOG_INF(_fmt, ...)         DLOG_INF(_fmt, ##__VA_ARGS__)
+#define BOOT_LOG_DBG(_fmt, ...)         DLOG_DBG(_fmt, ##__VA_ARGS__)
+#endif /* DLOG */
+
+#if (MCUBOOT_IMAGE_NUMBER > 1)
+/* Image 2 runs on the CM7 core that image 1 does not use */
+#if (APP_CORE_ID == 0)
+#define BOOT_IMAGE_2_CORE               CORE_CM7_1
+#else
+#define BOOT_IMAGE_2_CORE               CORE_CM7_0
+#endif
+#endif /* MCUBOOT_IMAGE_NUMBER > 1 */
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* retarget-io is initialized, always before boot_go() unless BOOT_FAST=1 */
+static bool console_ready = false;
+
+/******************************************************************************
+ * Function Name: console_init
+ ******************************************************************************
+ * Summary:
+ *  This function initializes retarget-io to use the debug UART port, clears
+ *  the terminal and prints the start message, once.
+ *
+ * Parameters:
+ *  void
+ *
+ ******************************************************************************/
+static void console_init(void)
+{
+    cy_rslt_t result;
+
+    if (console_ready)
+    {
+        return;
+    }
+
+    BOOT_TIMING_MARK(BOOT_PHASE_RETARGET_INIT, 0xFFFFu);
+    result = cy_retarget_io_init(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX, CY_RETARGET_IO_BAUDRATE);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        CY_ASSERT(0);
+        /* Loop forever... */
+        while (true)
+        {
+            __WFI();
+        }
+    }
+    console_ready = true;
+
+    BOOT_LOG_INF("\x1b[2J\x1b[;H");
+    BOOT_LOG_INF("Edge Protect Bootloader Started");
+}
+
 /******************************************************************************
  * Function Name: hw_deinit
  ******************************************************************************
@@ -88,6 +172,10 @@
  ******************************************************************************/
 static void hw_deinit(void)
 {
+    if (!console_ready)
+    {
+        return;
+    }
   /* Flush the TX buffer, need to be fixed in retarget_io */
     while(cy_retarget_io_is_tx_active()){}
     cy_retarget_io_deinit();
@@ -97,27 +185,93 @@ static void hw_deinit(void)
  * Function Name: calc_app_addr
  ******************************************************************************
  * Summary:
- *  This function extracts the calculate the application address
+ *  This function extracts the calculate the application address. In the
+ *  direct XIP mode rsp holds the slot of the highest valid version, which
+ *  the image was linked for. In the RAM load mode the image runs from its
+ *  copy in the SRAM, at the load address of its header, which
+ *  boot_ram_entry() checks.
  *
  * Parameters:
  *  flash_base - internal flash base address
  *  rsp - Pointer to a structure holding the address to boot from. 
  *
+ * Return:
+ *  The address of the vector table, 0 in the RAM load mode if the copy
+ *  cannot be started.
+ *
  ******************************************************************************/
 static inline __attribute__((always_inline))
 fih_uint calc_app_addr(uintptr_t flash_base, const struct boot_rsp *rsp)
 {
+#if defined(MCUBOOT_RAM_LOAD)
+    static const boot_ram_window_t window =
+    {
+        .start = IMAGE_EXECUTABLE_RAM_START,
+        .size = IMAGE_EXECUTABLE_RAM_SIZE,
+        .sram_start = CY_SRAM_BASE,
+        .sram_size = CY_SRAM_SIZE,
+    };
+    uint32_t load_addr = rsp->br_hdr->ih_load_addr;
+
+    (void)flash_base;
+    return fih_uint_encode(boot_ram_entry(&window, (const uint8_t *)(uintptr_t)load_addr, load_addr,
+                                          rsp->br_hdr->ih_hdr_size, rsp->br_hdr->ih_img_size));
+#else
     return fih_uint_encode(flash_base +
                            rsp->br_image_off +
                            rsp->br_hdr->ih_hdr_size);
+#endif /* MCUBOOT_RAM_LOAD */
+}
+
+#if (MCUBOOT_IMAGE_NUMBER > 1)
+/******************************************************************************
+ * Function Name: launch_image_2
+ ******************************************************************************
+ * Summary:
+ *  boot_go() validates the primary slots of all images, upgrading them
+ *  first, and responds with image 1. The image check hook records the
+ *  result of the validation of image 2 with its entry. This function
+ *  enables the other CM7 core at that entry only if boot_go() found image 2
+ *  valid. The core of image 1 is enabled last by do_boot().
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  true if the core of image 2 was enabled.
+ *
+ ******************************************************************************/
+static bool launch_image_2(void)
+{
+    fih_uint app_addr = boot_multi_entry(1);
+
+    if (0U == fih_uint_decode(app_addr))
+    {
+        BOOT_LOG_ERR("Image 2 was not validated");
+        return false;
+    }
+
+    if (fih_uint_eq(boot_multi_entry(1), app_addr) != FIH_TRUE)
+    {
+        return false;
+    }
+
+    BOOT_LOG_INF("Launching image 2 on CM7_%d core at 0x%08" PRIx32,
+                 (BOOT_IMAGE_2_CORE == CORE_CM7_0) ? 0 : 1, (uint32_t)fih_uint_decode(app_addr));
+    Cy_SysEnableCM7(BOOT_IMAGE_2_CORE, (uint32_t)fih_uint_decode(app_addr));
+    return true;
 }
+#endif /* MCUBOOT_IMAGE_NUMBER > 1 */
 
 /******************************************************************************
  * Function Name: do_boot
  ******************************************************************************
  * Summary:
  *  This function extracts the primary image address and enables CM7 to 
- *  let it boot from that address.
+ *  let it boot from that address, in the direct XIP mode the address in
+ *  the slot boot_go() selected, in the RAM load mode the address in the
+ *  SRAM boot_go() copied the image to. With two images the other CM7 core
+ *  boots image 2 first.
  *
  * Parameters:
  *  rsp - Pointer to a structure holding the address to boot from. 
@@ -151,10 +305,30 @@ static bool do_boot(struct boot_rsp *rsp)
                 return false;
             }
 
+#if defined(MCUBOOT_RAM_LOAD)
+            if (0U == fih_uint_decode(app_addr))
+            {
+                BOOT_LOG_ERR("Image in the SRAM has no vector table for 0x%08" PRIx32,
+                             (uint32_t)rsp->br_hdr->ih_load_addr);
+                return false;
+            }
+#endif /* MCUBOOT_RAM_LOAD */
+
 #ifdef APP_CM7
+#if (MCUBOOT_IMAGE_NUMBER > 1)
+            if (!launch_image_2())
+            {
+                return false;
+            }
+#endif
             BOOT_LOG_INF("Launching app on CM7 core");
             BOOT_LOG_INF(BOOT_MSG_FINISH);
+            BOOT_TIMING_MARK(BOOT_PHASE_DEINIT, 0xFFFFu);
             hw_deinit();
+#if (BOOT_TIMING)
+            /* The table is complete before the CM7 can read it */
+            boot_timing_stop(BOOT_PHASE_LAUNCH);
+#endif
             /* This function turns on CM7 */
             xmc7000_launch_cm7_app(app_addr);
             return true;
@@ -221,6 +395,16 @@ int main(void)
     cy_rslt_t result = MCUBOOTAPP_RSLT_ERR;
     cyhal_wdt_t *wdt = NULL;
 
+#if (BOOT_TIMING)
+    boot_timing_start();
+#endif
+#if (DLOG) && (BOOT_TIMING)
+    dlog_init(DLOG_LANE, boot_timing_now_us, 1000000u);
+#elif (DLOG)
+    dlog_init(DLOG_LANE, NULL, 0u);
+#endif
+    BOOT_TIMING_MARK(BOOT_PHASE_BSP_INIT, 0xFFFFu);
+
     result = cybsp_init();
     if (CY_RSLT_SUCCESS != result)
     {
@@ -235,22 +419,28 @@ int main(void)
     /* enable interrupts */
     __enable_irq();
 
-    /* Initialize retarget-io to use the debug UART port */
-    result = cy_retarget_io_init(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX, CY_RETARGET_IO_BAUDRATE);
-    if (CY_RSLT_SUCCESS != result)
+#if (BOOT_FAST)
+    /* The console is initialized for an upgrade, a revert or a recovery,
+     * otherwise the images are validated and launched without it */
+    BOOT_TIMING_MARK(BOOT_PHASE_FAST_CHECK, 0xFFFFu);
+    if (boot_fast_pending())
     {
-        CY_ASSERT(0);
-        /* Loop forever... */
-        while (true)
-        {
-            __WFI();
-        }
+        console_init();
     }
-    
-    BOOT_LOG_INF("\x1b[2J\x1b[;H");
-    BOOT_LOG_INF("Edge Protect Bootloader Started");
+#else
+    console_init();
+#endif /* BOOT_FAST */
 
+    /* Crypto block of the image validation, BOOT_CRYPTO=HW, released before
+     * the launch */
+    if (0 != boot_crypto_init())
+    {
+        BOOT_LOG_WRN("Crypto backend %s unavailable, validating in software", boot_crypto_name());
+    }
+
+    BOOT_TIMING_MARK(BOOT_PHASE_BOOT_GO, 0xFFFFu);
     FIH_CALL(boot_go, fih_status, &rsp);
+    boot_crypto_deinit();
 
     if (FIH_TRUE == fih_eq(fih_status, FIH_SUCCESS))
     {
@@ -261,6 +451,7 @@ int main(void)
         * reset will be initiated by watchdog timer and swap revert operation started
         * to roll back to operable image.
         */
+        BOOT_TIMING_MARK(BOOT_PHASE_WDT_INIT, 0xFFFFu);
         result = cyhal_wdt_init(wdt, WDT_TIME_OUT_MS);
 
         if (CY_RSLT_SUCCESS == result)
@@ -282,7 +473,15 @@ int main(void)
         BOOT_LOG_ERR("Edge Protect Bootloader found none of bootable images");
     }
 
-    deep_sleep_Prepare();
+#if (BOOT_TIMING)
+    /* No launch, the SysTick does not wake up the core any more */
+    boot_timing_stop(BOOT_PHASE_DEINIT);
+#endif
+
+    if (console_ready)
+    {
+        deep_sleep_Prepare();
+    }
 
     while (true)
     {
@@ -0,0 +1,726 @@
+/******************************************************************************
+ * File Name:   swap_journal.c
+ *
+ * Description: This file contains the journaled swap of the primary and secondary slots. A swap
+ *              moves whole erase sectors: equal sectors stay, a sector erased in one slot moves
+ *              without a scratch copy, and the other sectors go through a scratch sector, a slot
+ *              sector erased in both slots when there is one. The plan of the swap, with the
+ *              CRC-32C of every sector, is written to the journal before the first move, and one
+ *              entry after each sector; after a power failure the interrupted sector is resumed
+ *              from the contents of the slots.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "swap_journal.h"
+#include "boot_crc32c.h"
+
+#if (BOOT_SWAP_JOURNAL)
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Largest program unit of the flash, a code flash row */
+#define SWAP_JOURNAL_PROGRAM_MAX        (512U)
+
+/*******************************************************************************
+* Data Structures
+********************************************************************************/
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t swap;
+    uint8_t type;
+    uint8_t sector;
+    uint8_t count;
+    uint8_t method;
+    uint32_t crc_primary;
+    uint32_t crc_secondary;
+    uint32_t scratch;
+    uint32_t check;
+} swap_journal_entry_t;
+
+/* Latest swap found in the journal */
+typedef struct
+{
+    uint32_t swap;
+    uint32_t count;
+    uint32_t scratch;
+    uint32_t planned;
+    uint32_t done;
+    bool complete;
+    bool closed;
+    uint8_t method[SWAP_JOURNAL_MAX_SECTORS];
+    uint32_t crc_primary[SWAP_JOURNAL_MAX_SECTORS];
+    uint32_t crc_secondary[SWAP_JOURNAL_MAX_SECTORS];
+} swap_journal_plan_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Latest entry and journal entry of the next one */
+static uint32_t journal_sequence = 0U;
+static uint32_t journal_next = 0U;
+
+static swap_journal_plan_t journal_plan;
+static swap_journal_stats_t journal_stats;
+
+/* Program unit, the flash controller programs from the SRAM */
+static uint32_t journal_buf[SWAP_JOURNAL_PROGRAM_MAX / sizeof(uint32_t)];
+
+/******************************************************************************
+ * Function Name: swap_journal_crc_of
+ ******************************************************************************
+ * Summary:
+ *  This function returns the CRC-32C of a range of the flash, 0 if it is not
+ *  flash.
+ *
+ ******************************************************************************/
+static uint32_t swap_journal_crc_of(uint32_t address, uint32_t length)
+{
+    const uint8_t *p = swap_journal_port_ptr(address, length);
+
+    return (NULL != p) ? boot_crc32c(0U, p, length) : 0U;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_is_blank
+ ******************************************************************************
+ * Summary:
+ *  This function returns true if a range of the flash is erased.
+ *
+ ******************************************************************************/
+static bool swap_journal_is_blank(uint32_t address, uint32_t length)
+{
+    const uint8_t *p = swap_journal_port_ptr(address, length);
+
+    if (NULL == p)
+    {
+        return false;
+    }
+    for (uint32_t i = 0U; i < length; i++)
+    {
+        if (0xFFU != p[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_erase
+ ******************************************************************************
+ * Summary:
+ *  This function erases the sectors of a range that are not erased yet.
+ *
+ * Return:
+ *  0 on success, -1 on a flash error.
+ *
+ ******************************************************************************/
+static int swap_journal_erase(uint32_t address, uint32_t length)
+{
+    uint32_t end = address + length;
+
+    while (address < end)
+    {
+        uint32_t erase_size = swap_journal_port_erase_size(address);
+
+        if ((0U == erase_size) || (0U != (address % erase_size)))
+        {
+            return -1;
+        }
+        if (!swap_journal_is_blank(address, erase_size))
+        {
+            if (0 != swap_journal_port_erase(address))
+            {
+                return -1;
+            }
+            journal_stats.erases++;
+        }
+        address += erase_size;
+    }
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_copy
+ ******************************************************************************
+ * Summary:
+ *  This function erases a range and copies another range of the flash to
+ *  it. Erased program units are not programmed.
+ *
+ * Return:
+ *  0 if the destination holds the source, -1 otherwise.
+ *
+ ******************************************************************************/
+static int swap_journal_copy(uint32_t dst, uint32_t src, uint32_t length)
+{
+    const uint8_t *from = swap_journal_port_ptr(src, length);
+    const uint8_t *to = swap_journal_port_ptr(dst, length);
+
+    if ((NULL == from) || (NULL == to) || (0 != swap_journal_erase(dst, length)))
+    {
+        return -1;
+    }
+    for (uint32_t off = 0U; off < length;)
+    {
+        uint32_t unit = swap_journal_port_program_size(dst + off);
+
+        if ((0U == unit) || (unit > SWAP_JOURNAL_PROGRAM_MAX) || (off + unit > length))
+        {
+            return -1;
+        }
+        if (!swap_journal_is_blank(src + off, unit))
+        {
+            memcpy(journal_buf, &from[off], unit);
+            if (0 != swap_journal_port_program(dst + off, (const uint8_t *)journal_buf, unit))
+            {
+                return -1;
+            }
+            journal_stats.programs++;
+        }
+        off += unit;
+    }
+    return (0 == memcmp(to, from, length)) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_scan
+ ******************************************************************************
+ * Summary:
+ *  This function reads the journal: the latest entry, the entry to write
+ *  next and the plan and progress of the latest swap.
+ *
+ ******************************************************************************/
+static void swap_journal_scan(void)
+{
+    const uint8_t *log = swap_journal_port_ptr(BOOT_SWAP_JOURNAL_ADDR,
+                                               SWAP_JOURNAL_ENTRIES * SWAP_JOURNAL_ENTRY_SIZE);
+    swap_journal_entry_t entry;
+    uint32_t latest = SWAP_JOURNAL_ENTRIES;
+
+    memset(&journal_plan, 0, sizeof(journal_plan));
+    journal_sequence = 0U;
+    journal_next = 0U;
+
+    for (uint32_t pass = 0U; (NULL != log) && (pass < 2U); pass++)
+    {
+        for (uint32_t i = 0U; i < SWAP_JOURNAL_ENTRIES; i++)
+        {
+            memcpy(&entry, &log[i * SWAP_JOURNAL_ENTRY_SIZE], sizeof(entry));
+            if ((SWAP_JOURNAL_MAGIC != entry.magic) ||
+                (entry.check != boot_crc32c(0U, (const uint8_t *)&entry,
+                                                    offsetof(swap_journal_entry_t, check))) ||
+                (entry.count > SWAP_JOURNAL_MAX_SECTORS) || (entry.sector >= entry.count))
+            {
+                continue;
+            }
+
+            if (0U == pass)
+            {
+                /* Latest entry, its swap is the latest swap */
+                if ((SWAP_JOURNAL_ENTRIES == latest) || ((int32_t)(entry.sequence - journal_sequence) > 0))
+                {
+                    latest = i;
+                    journal_sequence = entry.sequence;
+                    journal_plan.swap = entry.swap;
+                    journal_plan.count = entry.count;
+                }
+            }
+            else if ((entry.swap == journal_plan.swap) && (entry.count == journal_plan.count))
+            {
+                switch (entry.type)
+                {
+                    case SWAP_JOURNAL_PLAN:
+                        journal_plan.planned |= (1UL << entry.sector);
+                        journal_plan.method[entry.sector] = entry.method;
+                        journal_plan.crc_primary[entry.sector] = entry.crc_primary;
+                        journal_plan.crc_secondary[entry.sector] = entry.crc_secondary;
+                        journal_plan.scratch = entry.scratch;
+                        break;
+                    case SWAP_JOURNAL_DONE:
+                        journal_plan.done |= (1UL << entry.sector);
+                        break;
+                    case SWAP_JOURNAL_COMPLETE:
+                        journal_plan.complete = true;
+                        break;
+                    case SWAP_JOURNAL_CLOSED:
+                        journal_plan.closed = true;
+                        break;
+                    default:
+                        break;
+                }
+            }
+            else
+            {
+                /* Entry of an older swap */
+            }
+        }
+    }
+
+    if (SWAP_JOURNAL_ENTRIES != latest)
+    {
+        journal_next = (latest + 1U) % SWAP_JOURNAL_ENTRIES;
+    }
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_append
+ ******************************************************************************
+ * Summary:
+ *  This function writes an entry of the latest swap after the latest entry.
+ *  The first entry of a journal sector erases the sector; an entry left
+ *  half written by a power failure is skipped.
+ *
+ * Return:
+ *  0 on success, -1 on a flash error.
+ *
+ ******************************************************************************/
+static int swap_journal_append(uint8_t type, uint32_t sector)
+{
+    swap_journal_entry_t entry;
+    uint32_t address;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.magic = SWAP_JOURNAL_MAGIC;
+    entry.sequence = journal_sequence + 1U;
+    entry.swap = journal_plan.swap;
+    entry.type = type;
+    entry.sector = (uint8_t)sector;
+    entry.count = (uint8_t)journal_plan.count;
+    if (SWAP_JOURNAL_PLAN == type)
+    {
+        entry.method = journal_plan.method[sector];
+        entry.crc_primary = journal_plan.crc_primary[sector];
+        entry.crc_secondary = journal_plan.crc_secondary[sector];
+        entry.scratch = journal_plan.scratch;
+    }
+    entry.check = boot_crc32c(0U, (const uint8_t *)&entry, offsetof(swap_journal_entry_t, check));
+
+    for (;;)
+    {
+        address = BOOT_SWAP_JOURNAL_ADDR + (journal_next * SWAP_JOURNAL_ENTRY_SIZE);
+        if (0U == (address % SWAP_JOURNAL_SECTOR_SIZE))
+        {
+            if (0 != swap_journal_port_erase(address))
+            {
+                return -1;
+            }
+            journal_stats.erases++;
+            break;
+        }
+        if (swap_journal_is_blank(address, SWAP_JOURNAL_ENTRY_SIZE))
+        {
+            break;
+        }
+        journal_next = (journal_next + 1U) % SWAP_JOURNAL_ENTRIES;
+    }
+
+    memcpy(journal_buf, &entry, sizeof(entry));
+    if (0 != swap_journal_port_program(address, (const uint8_t *)journal_buf, SWAP_JOURNAL_ENTRY_SIZE))
+    {
+        return -1;
+    }
+    journal_sequence = entry.sequence;
+    journal_next = (journal_next + 1U) % SWAP_JOURNAL_ENTRIES;
+    journal_stats.entries++;
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_plan
+ ******************************************************************************
+ * Summary:
+ *  This function plans a new swap from the contents of the slots and writes
+ *  the plan to the journal.
+ *
+ * Return:
+ *  0 on success, -1 on a flash error.
+ *
+ ******************************************************************************/
+static int swap_journal_plan(const swap_journal_cfg_t *cfg)
+{
+    uint32_t size = cfg->sector_size;
+    bool scratch_needed = false;
+
+    journal_plan.swap++;
+    journal_plan.count = cfg->sector_count;
+    journal_plan.scratch = cfg->scratch;
+    journal_plan.planned = 0U;
+    journal_plan.done = 0U;
+    journal_plan.complete = false;
+    journal_plan.closed = false;
+
+    for (uint32_t i = 0U; i < cfg->sector_count; i++)
+    {
+        uint32_t primary = cfg->primary + (i * size);
+        uint32_t secondary = cfg->secondary + (i * size);
+        const uint8_t *p = swap_journal_port_ptr(primary, size);
+        const uint8_t *s = swap_journal_port_ptr(secondary, size);
+
+        if ((NULL == p) || (NULL == s))
+        {
+            return -1;
+        }
+        journal_plan.crc_primary[i] = boot_crc32c(0U, p, size);
+        journal_plan.crc_secondary[i] = boot_crc32c(0U, s, size);
+
+        if (0 == memcmp(p, s, size))
+        {
+            journal_plan.method[i] = SWAP_JOURNAL_MOVE_NONE;
+            if ((cfg->scratch == journal_plan.scratch) && swap_journal_is_blank(primary, size))
+            {
+                /* Faster to program than the work flash, erased again at the end */
+                journal_plan.scratch = primary;
+            }
+        }
+        else if (swap_journal_is_blank(secondary, size))
+        {
+            journal_plan.method[i] = SWAP_JOURNAL_MOVE_TO_SECONDARY;
+        }
+        else if (swap_journal_is_blank(primary, size))
+        {
+            journal_plan.method[i] = SWAP_JOURNAL_MOVE_TO_PRIMARY;
+        }
+        else
+        {
+            journal_plan.method[i] = SWAP_JOURNAL_MOVE_SCRATCH;
+            scratch_needed = true;
+        }
+    }
+    if (!scratch_needed)
+    {
+        journal_plan.scratch = cfg->scratch;
+    }
+
+    for (uint32_t i = 0U; i < cfg->sector_count; i++)
+    {
+        if (0 != swap_journal_append(SWAP_JOURNAL_PLAN, i))
+        {
+            return -1;
+        }
+        journal_plan.planned |= (1UL << i);
+    }
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_move
+ ******************************************************************************
+ * Summary:
+ *  This function swaps one sector of the slots. After a power failure the
+ *  steps left are found from the CRC-32C of the slot and scratch sectors:
+ *  a step starts only once the previous one is complete, and a step is
+ *  repeated until its destination holds the expected sector.
+ *
+ * Parameters:
+ *  cfg - Swap configuration
+ *  i - Sector
+ *  resume - The swap of the sector may have been interrupted
+ *
+ * Return:
+ *  0 on success, -1 on a flash error or unexpected contents.
+ *
+ ******************************************************************************/
+static int swap_journal_move(const swap_journal_cfg_t *cfg, uint32_t i, bool resume)
+{
+    uint32_t size = cfg->sector_size;
+    uint32_t primary = cfg->primary + (i * size);
+    uint32_t secondary = cfg->secondary + (i * size);
+    uint32_t scratch = journal_plan.scratch;
+    uint32_t crc_primary = journal_plan.crc_primary[i];
+    uint32_t crc_secondary = journal_plan.crc_secondary[i];
+    uint32_t from = primary;
+    uint32_t to = secondary;
+    uint32_t crc_from = crc_primary;
+
+    switch (journal_plan.method[i])
+    {
+        case SWAP_JOURNAL_MOVE_TO_PRIMARY:
+            from = secondary;
+            to = primary;
+            crc_from = crc_secondary;
+            /* Fall through */
+        case SWAP_JOURNAL_MOVE_TO_SECONDARY:
+            journal_stats.sectors_direct++;
+            if (!resume || (swap_journal_crc_of(from, size) == crc_from))
+            {
+                if ((resume && (swap_journal_crc_of(to, size) == crc_from)) ||
+                    (0 == swap_journal_copy(to, from, size)))
+                {
+                    return swap_journal_erase(from, size);
+                }
+                return -1;
+            }
+            /* The erase of the source had started */
+            return (swap_journal_crc_of(to, size) == crc_from) ? swap_journal_erase(from, size) : -1;
+
+        case SWAP_JOURNAL_MOVE_SCRATCH:
+            journal_stats.sectors_scratch++;
+            if (scratch != cfg->scratch)
+            {
+                journal_stats.scratch_in_slot++;
+            }
+            if (!resume || (swap_journal_crc_of(primary, size) != crc_secondary))
+            {
+                if (!resume || (swap_journal_crc_of(scratch, size) != crc_primary))
+                {
+                    if ((resume && (swap_journal_crc_of(primary, size) != crc_primary)) ||
+                        (0 != swap_journal_copy(scratch, primary, size)))
+                    {
+                        return -1;
+                    }
+                }
+                if ((resume && (swap_journal_crc_of(secondary, size) != crc_secondary)) ||
+                    (0 != swap_journal_copy(primary, secondary, size)))
+                {
+                    return -1;
+                }
+            }
+            if (!resume || (swap_journal_crc_of(secondary, size) != crc_primary))
+            {
+                if ((resume && (swap_journal_crc_of(scratch, size) != crc_primary)) ||
+                    (0 != swap_journal_copy(secondary, scratch, size)))
+                {
+                    return -1;
+                }
+            }
+            return 0;
+
+        default:
+            return 0;
+    }
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_state
+ ******************************************************************************
+ * Summary:
+ *  This function reads the state of the latest swap from the journal. A
+ *  swap that moved all sectors is complete only while the slots still hold
+ *  what it left in them.
+ *
+ * Parameters:
+ *  cfg - Swap configuration
+ *
+ * Return:
+ *  State of the latest swap.
+ *
+ ******************************************************************************/
+swap_journal_state_t swap_journal_state(const swap_journal_cfg_t *cfg)
+{
+    uint32_t all;
+
+    swap_journal_scan();
+    if ((0U == cfg->sector_count) || (cfg->sector_count > SWAP_JOURNAL_MAX_SECTORS) ||
+        (journal_plan.count != cfg->sector_count) || journal_plan.closed)
+    {
+        return SWAP_JOURNAL_STATE_NONE;
+    }
+    all = (1UL << cfg->sector_count) - 1U;
+    if (journal_plan.planned != all)
+    {
+        /* Interrupted while it was planned, nothing moved */
+        return SWAP_JOURNAL_STATE_NONE;
+    }
+    if (!journal_plan.complete)
+    {
+        return SWAP_JOURNAL_STATE_OPEN;
+    }
+    for (uint32_t i = 0U; i < cfg->sector_count; i++)
+    {
+        if ((swap_journal_crc_of(cfg->primary + (i * cfg->sector_size), cfg->sector_size) !=
+             journal_plan.crc_secondary[i]) ||
+            (swap_journal_crc_of(cfg->secondary + (i * cfg->sector_size), cfg->sector_size) !=
+             journal_plan.crc_primary[i]))
+        {
+            return SWAP_JOURNAL_STATE_NONE;
+        }
+    }
+    return SWAP_JOURNAL_STATE_COMPLETE;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_find_secondary
+ ******************************************************************************
+ * Summary:
+ *  This function finds a sector of the image that was in the secondary
+ *  slot when the latest swap started, while that swap is open. A sector is
+ *  written to the primary slot before it is removed from the secondary
+ *  slot, so it is intact in one of them.
+ *
+ * Parameters:
+ *  cfg - Swap configuration
+ *  sector - Sector of the image
+ *
+ * Return:
+ *  Address of the sector, 0 if no swap is open.
+ *
+ ******************************************************************************/
+uint32_t swap_journal_find_secondary(const swap_journal_cfg_t *cfg, uint32_t sector)
+{
+    uint32_t offset = sector * cfg->sector_size;
+
+    if ((sector >= cfg->sector_count) || (SWAP_JOURNAL_STATE_OPEN != swap_journal_state(cfg)))
+    {
+        return 0U;
+    }
+    if (swap_journal_crc_of(cfg->secondary + offset, cfg->sector_size) == journal_plan.crc_secondary[sector])
+    {
+        return cfg->secondary + offset;
+    }
+    if (swap_journal_crc_of(cfg->primary + offset, cfg->sector_size) == journal_plan.crc_secondary[sector])
+    {
+        return cfg->primary + offset;
+    }
+    return 0U;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_run
+ ******************************************************************************
+ * Summary:
+ *  This function swaps the slots: it resumes the latest swap if it was
+ *  interrupted while it moved sectors, otherwise it plans a new one.
+ *
+ * Parameters:
+ *  cfg - Swap configuration
+ *
+ * Return:
+ *  0 once all sectors are swapped, -1 on a flash error.
+ *
+ ******************************************************************************/
+int swap_journal_run(const swap_journal_cfg_t *cfg)
+{
+    swap_journal_state_t state;
+    bool resume;
+
+    memset(&journal_stats, 0, sizeof(journal_stats));
+    if ((0U == cfg->sector_count) || (cfg->sector_count > SWAP_JOURNAL_MAX_SECTORS) ||
+        /* A swap must not wrap over its own plan */
+        ((2U * cfg->sector_count) + 2U > SWAP_JOURNAL_ENTRIES - (SWAP_JOURNAL_SECTOR_SIZE / SWAP_JOURNAL_ENTRY_SIZE)))
+    {
+        return -1;
+    }
+
+    state = swap_journal_state(cfg);
+    resume = (SWAP_JOURNAL_STATE_OPEN == state);
+    if (SWAP_JOURNAL_STATE_NONE == state)
+    {
+        if (0 != swap_journal_plan(cfg))
+        {
+            return -1;
+        }
+    }
+    else if (SWAP_JOURNAL_STATE_COMPLETE == state)
+    {
+        return 0;
+    }
+    else
+    {
+        /* Resume the first sector not done */
+    }
+
+    for (uint32_t i = 0U; i < cfg->sector_count; i++)
+    {
+        if (SWAP_JOURNAL_MOVE_NONE == journal_plan.method[i])
+        {
+            journal_stats.sectors_skipped++;
+            continue;
+        }
+        if (0U != (journal_plan.done & (1UL << i)))
+        {
+            continue;
+        }
+        if ((0 != swap_journal_move(cfg, i, resume)) || (0 != swap_journal_append(SWAP_JOURNAL_DONE, i)))
+        {
+            return -1;
+        }
+        journal_plan.done |= (1UL << i);
+        resume = false;
+    }
+
+    /* A slot sector used as scratch was erased in both slots */
+    if ((journal_plan.scratch != cfg->scratch) &&
+        (0 != swap_journal_erase(journal_plan.scratch, cfg->sector_size)))
+    {
+        return -1;
+    }
+    if (0 != swap_journal_append(SWAP_JOURNAL_COMPLETE, 0U))
+    {
+        return -1;
+    }
+    journal_plan.complete = true;
+    return 0;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_close
+ ******************************************************************************
+ * Summary:
+ *  This function closes the latest swap once the image trailers describe
+ *  it, so that the next call of swap_journal_run() plans a new swap.
+ *
+ * Return:
+ *  0 on success, -1 on a flash error.
+ *
+ ******************************************************************************/
+int swap_journal_close(void)
+{
+    swap_journal_scan();
+    if ((0U == journal_plan.count) || journal_plan.closed)
+    {
+        return 0;
+    }
+    return swap_journal_append(SWAP_JOURNAL_CLOSED, 0U);
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_stats_get
+ ******************************************************************************
+ * Summary:
+ *  This function returns the counters of the last swap_journal_run().
+ *
+ ******************************************************************************/
+void swap_journal_stats_get(swap_journal_stats_t *stats)
+{
+    *stats = journal_stats;
+}
+#endif /* BOOT_SWAP_JOURNAL */
+
+/* [] END OF FILE */
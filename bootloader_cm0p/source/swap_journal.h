@@ -0,0 +1,171 @@
+/******************************************************************************
+ * File Name:   swap_journal.h
+ *
+ * Description: This file contains the declarations of the journaled swap of the primary and
+ *              secondary slots, which moves whole erase sectors and records its progress in
+ *              an append-only journal in the work flash.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef SWAP_JOURNAL_H
+#define SWAP_JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Set to 1 to swap the slots with the journaled swap instead of the MCUboot
+ * swap using scratch */
+#ifndef BOOT_SWAP_JOURNAL
+#define BOOT_SWAP_JOURNAL               (0)
+#endif
+
+/* Start of the journal, BOOT_SWAP_JOURNAL_SECTORS small sectors of the work
+ * flash. The default follows the MCUboot swap status area */
+#ifndef BOOT_SWAP_JOURNAL_ADDR
+#define BOOT_SWAP_JOURNAL_ADDR          (0x14032800UL)
+#endif
+
+#ifndef BOOT_SWAP_JOURNAL_SECTORS
+#define BOOT_SWAP_JOURNAL_SECTORS       (8U)
+#endif
+
+#define SWAP_JOURNAL_SECTOR_SIZE        (0x80U)
+#define SWAP_JOURNAL_ENTRY_SIZE         (32U)
+#define SWAP_JOURNAL_ENTRIES            ((BOOT_SWAP_JOURNAL_SECTORS * SWAP_JOURNAL_SECTOR_SIZE) / \
+                                         SWAP_JOURNAL_ENTRY_SIZE)
+
+/* Largest number of sectors of a slot */
+#define SWAP_JOURNAL_MAX_SECTORS        (16U)
+
+/*
+ * Entry, one work flash program unit. The journal is written in order and
+ * wraps around, erasing a sector before its first entry; the valid entry
+ * with the highest sequence number is the latest:
+ * [0..3]   magic "SWPJ"
+ * [4..7]   sequence number
+ * [8..11]  swap number, the same for all entries of one swap
+ * [12]     type, SWAP_JOURNAL_PLAN/DONE/COMPLETE/CLOSED
+ * [13]     sector
+ * [14]     sector count of the swap
+ * [15]     method of the sector, SWAP_JOURNAL_MOVE_*
+ * [16..19] PLAN: CRC-32C of the sector in the primary slot before the swap
+ * [20..23] PLAN: CRC-32C of the sector in the secondary slot before the swap
+ * [24..27] PLAN: scratch address of the swap
+ * [28..31] CRC-32C of bytes 0 to 27
+ *
+ * A swap writes one PLAN entry per sector before it changes the slots, a
+ * DONE entry after each sector it moves, COMPLETE after the last one and
+ * CLOSED once the caller has updated the image trailers. A swap with a
+ * missing PLAN entry never moved a sector.
+ */
+#define SWAP_JOURNAL_MAGIC              (0x4A505753UL)
+
+#define SWAP_JOURNAL_PLAN               (1U)
+#define SWAP_JOURNAL_DONE               (2U)
+#define SWAP_JOURNAL_COMPLETE           (3U)
+#define SWAP_JOURNAL_CLOSED             (4U)
+
+/* The sectors are equal, nothing moves */
+#define SWAP_JOURNAL_MOVE_NONE          (0U)
+/* The secondary sector is erased: primary to secondary, erase primary */
+#define SWAP_JOURNAL_MOVE_TO_SECONDARY  (1U)
+/* The primary sector is erased: secondary to primary, erase secondary */
+#define SWAP_JOURNAL_MOVE_TO_PRIMARY    (2U)
+/* Primary to scratch, secondary to primary, scratch to secondary */
+#define SWAP_JOURNAL_MOVE_SCRATCH       (3U)
+
+/*******************************************************************************
+* Data Structures
+********************************************************************************/
+typedef struct
+{
+    /* Start of the slots */
+    uint32_t primary;
+    uint32_t secondary;
+    /* Start of the scratch area, at least one sector */
+    uint32_t scratch;
+    /* Size of a move, a multiple of the erase size of the slots */
+    uint32_t sector_size;
+    /* Sectors of a slot */
+    uint32_t sector_count;
+} swap_journal_cfg_t;
+
+typedef enum
+{
+    /* No swap started, or the latest one is closed */
+    SWAP_JOURNAL_STATE_NONE,
+    /* The latest swap was interrupted while it moved sectors */
+    SWAP_JOURNAL_STATE_OPEN,
+    /* The latest swap moved all sectors, the trailers may be outdated */
+    SWAP_JOURNAL_STATE_COMPLETE
+} swap_journal_state_t;
+
+/* Counters of the last swap_journal_run() */
+typedef struct
+{
+    uint32_t sectors_scratch;
+    uint32_t sectors_direct;
+    uint32_t sectors_skipped;
+    /* Sectors moved through a slot sector erased in both slots */
+    uint32_t scratch_in_slot;
+    uint32_t entries;
+    uint32_t erases;
+    uint32_t programs;
+} swap_journal_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+swap_journal_state_t swap_journal_state(const swap_journal_cfg_t *cfg);
+uint32_t swap_journal_find_secondary(const swap_journal_cfg_t *cfg, uint32_t sector);
+int swap_journal_run(const swap_journal_cfg_t *cfg);
+int swap_journal_close(void);
+void swap_journal_stats_get(swap_journal_stats_t *stats);
+
+/* Flash access, blocking, provided by swap_journal_port.c */
+void swap_journal_port_init(void);
+uint32_t swap_journal_port_erase_size(uint32_t address);
+uint32_t swap_journal_port_program_size(uint32_t address);
+int swap_journal_port_erase(uint32_t address);
+int swap_journal_port_program(uint32_t address, const uint8_t *data, uint32_t length);
+const uint8_t *swap_journal_port_ptr(uint32_t address, uint32_t length);
+
+#endif /* SWAP_JOURNAL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,214 @@
+/******************************************************************************
+ * File Name:   swap_journal_port.c
+ *
+ * Description: This file contains the flash access of the journaled swap: blocking erases and
+ *              programs of the code flash slots and of the work flash scratch area and journal.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include "cy_pdl.h"
+#include "memorymap.h"
+#include "boot_enc.h"
+#include "swap_journal.h"
+
+/* Also the code flash access of the install of the encrypted images */
+#if (BOOT_SWAP_JOURNAL) || (BOOT_ENC)
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Number of flash regions in flash_devices[] */
+#define SWAP_JOURNAL_REGION_COUNT       (INTERNAL_FLASH_WORK_SMALL + 1U)
+
+/* Size of a code flash program row */
+#define SWAP_JOURNAL_CODE_ROW_SIZE      (512U)
+
+/* Size of a work flash program unit, a journal entry */
+#define SWAP_JOURNAL_WORK_ROW_SIZE      (32U)
+
+/******************************************************************************
+ * Function Name: swap_journal_port_region
+ ******************************************************************************
+ * Summary:
+ *  This function returns the flash region that contains the address, NULL
+ *  if none.
+ *
+ ******************************************************************************/
+static const struct flash_device *swap_journal_port_region(uint32_t address)
+{
+    for (uint32_t i = 0U; i < SWAP_JOURNAL_REGION_COUNT; i++)
+    {
+        if ((address >= flash_devices[i].address) &&
+            (address - flash_devices[i].address < flash_devices[i].size))
+        {
+            return &flash_devices[i];
+        }
+    }
+    return NULL;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_port_is_work
+ ******************************************************************************
+ * Summary:
+ *  This function returns true if the region is in the work flash.
+ *
+ ******************************************************************************/
+static bool swap_journal_port_is_work(const struct flash_device *region)
+{
+    return (INTERNAL_FLASH_WORK_LARGE == region->device_id) ||
+           (INTERNAL_FLASH_WORK_SMALL == region->device_id);
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_port_init
+ ******************************************************************************
+ * Summary:
+ *  This function enables writes to the code flash and to the work flash.
+ *
+ ******************************************************************************/
+void swap_journal_port_init(void)
+{
+    Cy_Flashc_MainWriteEnable();
+    Cy_Flashc_WorkWriteEnable();
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_port_erase_size
+ ******************************************************************************
+ * Summary:
+ *  This function returns the erase sector size at the address, 0 outside
+ *  the flash.
+ *
+ ******************************************************************************/
+uint32_t swap_journal_port_erase_size(uint32_t address)
+{
+    const struct flash_device *region = swap_journal_port_region(address);
+
+    return (NULL != region) ? region->erase_size : 0U;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_port_program_size
+ ******************************************************************************
+ * Summary:
+ *  This function returns the program unit at the address: a row of the code
+ *  flash, 32 bytes of the work flash, 0 outside the flash.
+ *
+ ******************************************************************************/
+uint32_t swap_journal_port_program_size(uint32_t address)
+{
+    const struct flash_device *region = swap_journal_port_region(address);
+
+    if (NULL == region)
+    {
+        return 0U;
+    }
+    return swap_journal_port_is_work(region) ? SWAP_JOURNAL_WORK_ROW_SIZE : SWAP_JOURNAL_CODE_ROW_SIZE;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_port_erase
+ ******************************************************************************
+ * Summary:
+ *  This function erases the sector that contains the address.
+ *
+ * Return:
+ *  0 on success, -1 on a flash error.
+ *
+ ******************************************************************************/
+int swap_journal_port_erase(uint32_t address)
+{
+    uint32_t erase_size = swap_journal_port_erase_size(address);
+
+    if (0U == erase_size)
+    {
+        return -1;
+    }
+    return (CY_FLASH_DRV_SUCCESS == Cy_Flash_EraseSector(address - (address % erase_size))) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_port_program
+ ******************************************************************************
+ * Summary:
+ *  This function programs one program unit from a word aligned buffer in
+ *  the SRAM.
+ *
+ * Return:
+ *  0 on success, -1 on a flash error.
+ *
+ ******************************************************************************/
+int swap_journal_port_program(uint32_t address, const uint8_t *data, uint32_t length)
+{
+    cy_stc_flash_programrow_config_t config =
+    {
+        .destAddr = (uint32_t *)address,
+        .dataAddr = (uint32_t *)(uintptr_t)data,
+        .blocking = CY_FLASH_PROGRAMROW_BLOCKING,
+        .skipBC = CY_FLASH_PROGRAMROW_SKIP_BLANK_CHECK,
+        .dataSize = CY_FLASH_PROGRAMROW_DATA_SIZE_4096BIT,
+        .dataLoc = CY_FLASH_PROGRAMROW_DATA_LOCATION_SRAM,
+        .intrMask = CY_FLASH_PROGRAMROW_NOT_SET_INTR_MASK,
+    };
+
+    if ((0U == length) || (length != swap_journal_port_program_size(address)) || (0U != (address % length)))
+    {
+        return -1;
+    }
+    if (swap_journal_port_is_work(swap_journal_port_region(address)))
+    {
+        config.dataSize = CY_FLASH_PROGRAMROW_DATA_SIZE_256BIT;
+        return (CY_FLASH_DRV_SUCCESS == Cy_Flash_Program_WorkFlash(&config)) ? 0 : -1;
+    }
+    return (CY_FLASH_DRV_SUCCESS == Cy_Flash_Program(&config, CY_FLASH_DRIVER_BLOCKING)) ? 0 : -1;
+}
+
+/******************************************************************************
+ * Function Name: swap_journal_port_ptr
+ ******************************************************************************
+ * Summary:
+ *  This function returns a pointer to a range of the flash, which is memory
+ *  mapped, NULL if the range is not flash.
+ *
+ ******************************************************************************/
+const uint8_t *swap_journal_port_ptr(uint32_t address, uint32_t length)
+{
+    return ((NULL != swap_journal_port_region(address)) &&
+            (NULL != swap_journal_port_region(address + length - 1U))) ? (const uint8_t *)address : NULL;
+}
+#endif /* BOOT_SWAP_JOURNAL || BOOT_ENC */
+
+/* [] END OF FILE */
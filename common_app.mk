@@ -47,3 +47,16 @@ CY_TOOLS_DIR=$(lastword $(sort $(wildcard $(CY_TOOLS_PATHS))))
 ifeq ($(CY_TOOLS_DIR),)
 $(error Unable to find any of the available CY_TOOLS_PATHS -- $(CY_TOOLS_PATHS))
 endif
+
+################################################################################
+# Direct XIP
+################################################################################
+
+# Slots of a direct XIP flashmap such as xmc7000_direct_xip_single.json, where
+# memorymap.mk sets USE_DIRECT_XIP=1. The bootloader starts the image of the
+# highest version in place, so each image is linked for the slot it is written
+# to. XIP_SLOT selects the slot of a build: by default the primary slot for
+# IMG_TYPE=BOOT and the secondary slot for IMG_TYPE=UPGRADE. Each slot builds
+# to build/<IMG_TYPE>/<XIP_SLOT>, `make build_xip` builds both.
+XIP_SLOTS:=PRIMARY SECONDARY
+XIP_SLOT?=$(if $(filter UPGRADE,$(IMG_TYPE)),SECONDARY,PRIMARY)
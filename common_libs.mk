@@ -57,3 +57,12 @@ INCLUDES+=\
     $(MCUBOOT_CY_PATH)/platforms/utils/$(FAMILY)\
     $(MCUBOOTAPP_PATH)/config\
     $(MCUBOOTAPP_PATH)
+
+################################################################################
+# Shared Files
+################################################################################
+
+# Modules used by both the bootloader and the DFU application
+SOURCES+=$(wildcard ../shared/source/*.c)
+
+INCLUDES+=../shared/source
@@ -0,0 +1,259 @@
+/******************************************************************************
+ * File Name:   dfu_delta.c
+ *
+ * Description: This file contains the delta image decoder. It rebuilds the new image in
+ *              the secondary slot from the image running from the primary slot and a
+ *              compressed patch, one row at a time. MCUboot validates the rebuilt image
+ *              like any other upgrade image.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "boot_crc32c.h"
+#include "dfu_delta.h"
+#include "dfu_flash.h"
+#include "dfu_lz.h"
+
+#if (DFU_DELTA)
+#if !(DFU_LZ)
+#error "DFU_DELTA requires DFU_LZ"
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    DFU_DELTA_OP,
+    DFU_DELTA_ARG,
+    DFU_DELTA_DATA,
+} dfu_delta_state_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static bool delta_active = false;
+static dfu_delta_state_t delta_state = DFU_DELTA_OP;
+
+/* Base image in the primary slot and the position in it */
+static const uint8_t *delta_base = NULL;
+static uint32_t delta_base_size = 0u;
+static uint32_t delta_base_pos = 0u;
+
+/* Size of the new image and bytes rebuilt */
+static uint32_t delta_size = 0u;
+static uint32_t delta_out = 0u;
+
+/* Current operation, its argument and the LEB128 shift */
+static uint8_t delta_op = 0u;
+static uint32_t delta_arg = 0u;
+static uint32_t delta_shift = 0u;
+
+static uint8_t delta_row[CY_DFU_ROW_SIZE];
+static uint32_t delta_row_fill = 0u;
+
+/*******************************************************************************
+ * Function Name: dfu_delta_get_u32
+ ********************************************************************************
+ * Reads a little endian 32-bit value.
+ *******************************************************************************/
+static uint32_t dfu_delta_get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_delta_output
+ ********************************************************************************
+ * Appends a byte of the new image, a full row goes to the flash writer.
+ *******************************************************************************/
+static cy_en_dfu_status_t dfu_delta_output(uint8_t byte) {
+    if (delta_out >= delta_size) {
+        return CY_DFU_ERROR_DATA;
+    }
+    delta_row[delta_row_fill++] = byte;
+    delta_out++;
+
+    if ((delta_row_fill == CY_DFU_ROW_SIZE) || (delta_out == delta_size)) {
+        uint32_t length = delta_row_fill;
+
+        delta_row_fill = 0u;
+        return dfu_flash_queue_slot(delta_out - length, delta_row, length);
+    }
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_delta_operation
+ ********************************************************************************
+ * Starts an operation once its argument is complete.
+ *******************************************************************************/
+static cy_en_dfu_status_t dfu_delta_operation(void) {
+    if (delta_op == DFU_DELTA_OP_SEEK) {
+        /* Zigzag: 2n for n, 2n - 1 for -n */
+        int64_t pos = (int64_t)delta_base_pos +
+                      (((delta_arg & 1u) != 0u) ? -(int64_t)((delta_arg >> 1) + 1u) : (int64_t)(delta_arg >> 1));
+
+        if ((pos < 0) || (pos > (int64_t)delta_base_size)) {
+            return CY_DFU_ERROR_DATA;
+        }
+        delta_base_pos = (uint32_t)pos;
+        delta_state = DFU_DELTA_OP;
+    } else if ((delta_op == DFU_DELTA_OP_DIFF) && (delta_arg > delta_base_size - delta_base_pos)) {
+        return CY_DFU_ERROR_DATA;
+    } else {
+        delta_state = (delta_arg == 0u) ? DFU_DELTA_OP : DFU_DELTA_DATA;
+    }
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_delta_patch
+ ********************************************************************************
+ * Applies decompressed patch bytes, the sink of the compressed stream.
+ *******************************************************************************/
+static cy_en_dfu_status_t dfu_delta_patch(uint32_t offset, const uint8_t *data, uint32_t length) {
+    cy_en_dfu_status_t status = CY_DFU_SUCCESS;
+
+    (void)offset;
+    for (uint32_t i = 0u; (i < length) && (status == CY_DFU_SUCCESS); i++) {
+        uint8_t byte = data[i];
+
+        switch (delta_state) {
+        case DFU_DELTA_OP:
+            if ((byte < DFU_DELTA_OP_DIFF) || (byte > DFU_DELTA_OP_SEEK)) {
+                status = CY_DFU_ERROR_DATA;
+                break;
+            }
+            delta_op = byte;
+            delta_arg = 0u;
+            delta_shift = 0u;
+            delta_state = DFU_DELTA_ARG;
+            break;
+
+        case DFU_DELTA_ARG:
+            if (delta_shift > 28u) {
+                status = CY_DFU_ERROR_DATA;
+                break;
+            }
+            delta_arg |= (uint32_t)(byte & 0x7Fu) << delta_shift;
+            delta_shift += 7u;
+            if ((byte & 0x80u) == 0u) {
+                status = dfu_delta_operation();
+            }
+            break;
+
+        case DFU_DELTA_DATA:
+            if (delta_op == DFU_DELTA_OP_DIFF) {
+                byte = (uint8_t)(byte + delta_base[delta_base_pos++]);
+            }
+            status = dfu_delta_output(byte);
+            if (--delta_arg == 0u) {
+                delta_state = DFU_DELTA_OP;
+            }
+            break;
+
+        default:
+            status = CY_DFU_ERROR_DATA;
+            break;
+        }
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_delta_is_stream
+ ********************************************************************************
+ * Return:
+ *  true if the data starts with a delta image header.
+ *******************************************************************************/
+bool dfu_delta_is_stream(const uint8_t *data, uint32_t length) {
+    return (length >= DFU_DELTA_HEADER_SIZE) && (dfu_delta_get_u32(data) == DFU_DELTA_MAGIC);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_delta_write
+ ********************************************************************************
+ * Applies a row of the delta image. The row at offset 0 starts the image and
+ * checks that the primary slot of the image holds the base image the patch
+ * was made for.
+ *
+ * Parameters:
+ *  image          Slots of the image.
+ *  offset         Offset of the row in the delta image.
+ *  data, length   Delta image bytes.
+ *
+ * Return:
+ *  Status of operation, CY_DFU_ERROR_VERIFY if the base image differs.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_delta_write(const dfu_image_t *image, uint32_t offset, const uint8_t *data,
+                                   uint32_t length) {
+    cy_en_dfu_status_t status;
+
+    if (offset == 0u) {
+        delta_active = false;
+        if (!dfu_delta_is_stream(data, length) || (data[4] != DFU_DELTA_VERSION)) {
+            return CY_DFU_ERROR_DATA;
+        }
+        delta_size = dfu_delta_get_u32(&data[8]);
+        delta_base_size = dfu_delta_get_u32(&data[12]);
+        if ((delta_size == 0u) || (delta_size > image->size) || (delta_base_size > image->size)) {
+            return CY_DFU_ERROR_DATA;
+        }
+        delta_base = dfu_flash_port_ptr(image->primary, delta_base_size);
+        if ((delta_base == NULL) ||
+            (boot_crc32c(0u, delta_base, delta_base_size) != dfu_delta_get_u32(&data[16]))) {
+            return CY_DFU_ERROR_VERIFY;
+        }
+        delta_state = DFU_DELTA_OP;
+        delta_base_pos = 0u;
+        delta_out = 0u;
+        delta_row_fill = 0u;
+        delta_active = true;
+        status = dfu_lz_write(0u, &data[DFU_DELTA_HEADER_SIZE], length - DFU_DELTA_HEADER_SIZE,
+                              &dfu_delta_patch);
+    } else if (!delta_active || (offset < DFU_DELTA_HEADER_SIZE)) {
+        return CY_DFU_ERROR_DATA;
+    } else {
+        status = dfu_lz_write(offset - DFU_DELTA_HEADER_SIZE, data, length, &dfu_delta_patch);
+    }
+
+    if (status != CY_DFU_SUCCESS) {
+        delta_active = false;
+    }
+    return status;
+}
+#endif /* DFU_DELTA */
+
+/* [] END OF FILE */
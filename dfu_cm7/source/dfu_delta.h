@@ -0,0 +1,89 @@
+/******************************************************************************
+ * File Name:   dfu_delta.h
+ *
+ * Description: This file contains the declarations of the delta image decoder and the
+ *              delta image format.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_DELTA_H
+#define DFU_DELTA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_dfu.h"
+#include "dfu_image.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Set to 1 to accept delta images, requires DFU_LZ */
+#ifndef DFU_DELTA
+#define DFU_DELTA                   (0)
+#endif
+
+/*
+ * Delta image, sent with Program Data in place of the image from the start
+ * of its secondary slot. Header:
+ * [0..3]   magic "DFUD"
+ * [4]      format version
+ * [5..7]   reserved, 0
+ * [8..11]  size of the new image, little endian
+ * [12..15] size of the base image in the primary slot of the image, little endian
+ * [16..19] CRC-32C of the base image, little endian
+ * The header is followed by a compressed stream (see dfu_lz.h) of patch
+ * operations, each an operation byte and an unsigned LEB128 argument:
+ * DIFF n   n bytes follow, each added to the next base byte
+ * EXTRA n  n bytes follow, copied as they are
+ * SEEK d   moves the base position by d, zigzag encoded
+ */
+#define DFU_DELTA_MAGIC             (0x44554644uL)
+#define DFU_DELTA_VERSION           (1u)
+#define DFU_DELTA_HEADER_SIZE       (20u)
+#define DFU_DELTA_OP_DIFF           (0x01u)
+#define DFU_DELTA_OP_EXTRA          (0x02u)
+#define DFU_DELTA_OP_SEEK           (0x03u)
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+bool dfu_delta_is_stream(const uint8_t *data, uint32_t length);
+cy_en_dfu_status_t dfu_delta_write(const dfu_image_t *image, uint32_t offset, const uint8_t *data,
+                                   uint32_t length);
+
+#endif /* DFU_DELTA_H */
+
+/* [] END OF FILE */
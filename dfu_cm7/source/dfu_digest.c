@@ -0,0 +1,326 @@
+/******************************************************************************
+ * File Name:   dfu_digest.c
+ *
+ * Description: This file contains the digest of the upgrade image. Every row written to the
+ *              secondary slot from its start is hashed on its way to the flash, so that the
+ *              validation compares the SHA-256 with the SHA256 TLV of the image without
+ *              reading the slot back. The bootloader hashes the slot again before it
+ *              upgrades.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "dfu_digest.h"
+#include "boot_crypto.h"
+#include "dfu_flash.h"
+#include "dfu_image.h"
+
+#if (DFU_HASH_STREAM)
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Digest of the secondary slot of an image. The rows of the images may be
+ * interleaved, every image is hashed with its own context */
+typedef struct {
+    /* The bytes from the start of the slot up to progress were hashed in
+     * the order they were written, and not written again since */
+    bool valid;
+    bool complete;
+    /* Bytes MCUboot hashes: header, image and protected TLVs */
+    uint32_t extent;
+    uint32_t progress;
+    boot_crypto_sha256_t ctx;
+    uint8_t streamed[BOOT_CRYPTO_SHA256_SIZE];
+
+    /* Last row hashed, a retransmission of it keeps the digest */
+    uint32_t last_offset;
+    uint32_t last_length;
+    uint8_t last[CY_DFU_ROW_SIZE];
+
+    /* Result of the last validation, until the slot is written again */
+    bool checked;
+    cy_en_dfu_status_t status;
+} dfu_digest_image_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static bool digest_stream = true;
+static dfu_digest_image_t digest_images[DFU_IMAGE_COUNT];
+static dfu_digest_stats_t digest_stats;
+
+/*******************************************************************************
+ * Function Name: dfu_digest_get_u16
+ ********************************************************************************
+ * Reads a little endian 16-bit value.
+ *******************************************************************************/
+static uint32_t dfu_digest_get_u16(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_digest_extent
+ ********************************************************************************
+ * Return:
+ *  Bytes of the image MCUboot hashes, from its header, 0 if the data does
+ *  not start with an MCUboot header of an image that fits the slot.
+ *******************************************************************************/
+static uint32_t dfu_digest_extent(const uint8_t *header, uint32_t slot_size) {
+    uint32_t magic = dfu_digest_get_u16(&header[0]) | (dfu_digest_get_u16(&header[2]) << 16);
+    uint32_t hdr_size = dfu_digest_get_u16(&header[8]);
+    uint32_t protect_tlv_size = dfu_digest_get_u16(&header[10]);
+    uint32_t img_size = dfu_digest_get_u16(&header[12]) | (dfu_digest_get_u16(&header[14]) << 16);
+
+    if ((magic != DFU_DIGEST_IMAGE_MAGIC) || (img_size > slot_size) ||
+        (hdr_size + protect_tlv_size + img_size > slot_size)) {
+        return 0u;
+    }
+    return hdr_size + img_size + protect_tlv_size;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_digest_init
+ ********************************************************************************
+ * Initializes the digests of all images.
+ *
+ * Parameters:
+ *  stream         Hash the rows as they are written. If false, the
+ *                 validation reads the slot back and hashes it.
+ *******************************************************************************/
+void dfu_digest_init(bool stream) {
+    digest_stream = stream;
+    for (uint32_t i = 0u; i < DFU_IMAGE_COUNT; i++) {
+        digest_images[i].valid = false;
+        digest_images[i].complete = false;
+        digest_images[i].checked = false;
+    }
+    memset(&digest_stats, 0, sizeof(digest_stats));
+}
+
+/*******************************************************************************
+ * Function Name: dfu_digest_update
+ ********************************************************************************
+ * Hashes a row written to the secondary slot of an image. The row at offset
+ * 0 starts a new image. A row that does not continue the rows of the image
+ * hashed so far, other than a retransmission of the last one, leaves the
+ * validation to read the slot back.
+ *
+ * Parameters:
+ *  image          Index of the image.
+ *  offset         Offset of the row in the secondary slot.
+ *  data, length   Row.
+ *******************************************************************************/
+void dfu_digest_update(uint32_t image, uint32_t offset, const uint8_t *data, uint32_t length) {
+    dfu_digest_image_t *digest = &digest_images[image];
+
+    digest->checked = false;
+    if (!digest_stream) {
+        return;
+    }
+    if (offset == 0u) {
+        digest->extent = (length >= DFU_DIGEST_HEADER_SIZE) ?
+                         dfu_digest_extent(data, dfu_image_get(image)->size) : 0u;
+        digest->valid = (digest->extent != 0u);
+        digest->complete = false;
+        digest->progress = 0u;
+        digest->last_length = 0u;
+        boot_crypto_sha256_init(&digest->ctx);
+    }
+    if (!digest->valid || (offset >= digest->extent)) {
+        /* Padding and trailer are not hashed */
+        return;
+    }
+    if (length > digest->extent - offset) {
+        length = digest->extent - offset;
+    }
+
+    if (offset + length <= digest->progress) {
+        if ((offset != digest->last_offset) || (length != digest->last_length) ||
+            (memcmp(digest->last, data, length) != 0)) {
+            digest->valid = false;
+        }
+        return;
+    }
+    if (offset != digest->progress) {
+        digest->valid = false;
+        return;
+    }
+
+    boot_crypto_sha256_update(&digest->ctx, data, length);
+    digest_stats.streamed += length;
+    digest->progress += length;
+    digest->last_offset = offset;
+    digest->last_length = length;
+    memcpy(digest->last, data, length);
+    if (digest->progress == digest->extent) {
+        boot_crypto_sha256_final(&digest->ctx, digest->streamed);
+        digest->complete = true;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dfu_digest_invalidate
+ ********************************************************************************
+ * Drops the digest of an image after its slot is modified other than by
+ * rows, such as by an erase.
+ *******************************************************************************/
+void dfu_digest_invalidate(uint32_t image) {
+    digest_images[image].valid = false;
+    digest_images[image].checked = false;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_digest_validate
+ ********************************************************************************
+ * Validates the upgrade image in the secondary slot of an image after all
+ * rows are programmed: the SHA-256 of its header, image and protected TLVs
+ * must match its SHA256 TLV. The digest of the rows written is used if it
+ * covers the whole image, otherwise the slot is read back. The result is
+ * kept until the slot is written again. The code of an encrypted image
+ * cannot be hashed without its key: the image is accepted and the
+ * bootloader validates it decrypted.
+ *
+ * Parameters:
+ *  image          Index of the image.
+ *
+ * Return:
+ *  CY_DFU_SUCCESS if the image is valid, CY_DFU_ERROR_VERIFY otherwise.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_digest_validate(uint32_t image) {
+    const dfu_image_t *slots = dfu_image_get(image);
+    dfu_digest_image_t *state;
+    const uint8_t *header;
+    const uint8_t *tlv = NULL;
+    uint32_t extent = 0u;
+    uint32_t tlv_size = 0u;
+    uint8_t digest[BOOT_CRYPTO_SHA256_SIZE];
+
+    if ((slots == NULL) || (dfu_flash_flush() != CY_DFU_SUCCESS)) {
+        return CY_DFU_ERROR_VERIFY;
+    }
+    state = &digest_images[image];
+    if (state->checked) {
+        return state->status;
+    }
+    state->checked = true;
+    state->status = CY_DFU_ERROR_VERIFY;
+
+    header = dfu_flash_port_ptr(slots->secondary, DFU_DIGEST_HEADER_SIZE);
+    if (header != NULL) {
+        extent = dfu_digest_extent(header, slots->size);
+    }
+    if (extent != 0u) {
+        tlv = dfu_flash_port_ptr(slots->secondary + extent, 4u);
+    }
+    if ((tlv == NULL) || (dfu_digest_get_u16(tlv) != DFU_DIGEST_TLV_INFO_MAGIC)) {
+        return state->status;
+    }
+    tlv_size = dfu_digest_get_u16(&tlv[2]);
+    tlv = dfu_flash_port_ptr(slots->secondary + extent, tlv_size);
+    if (tlv == NULL) {
+        return state->status;
+    }
+    if ((header[16] & DFU_DIGEST_FLAG_ENCRYPTED) != 0u) {
+        /* The SHA256 TLV covers the decrypted code, the bootloader checks it */
+        state->status = CY_DFU_SUCCESS;
+        return state->status;
+    }
+
+    if (state->valid && state->complete && (state->extent == extent)) {
+        memcpy(digest, state->streamed, BOOT_CRYPTO_SHA256_SIZE);
+    } else {
+        const uint8_t *slot = dfu_flash_port_ptr(slots->secondary, extent);
+        boot_crypto_sha256_t ctx;
+
+        if (slot == NULL) {
+            return state->status;
+        }
+        boot_crypto_sha256_init(&ctx);
+        boot_crypto_sha256_update(&ctx, slot, extent);
+        boot_crypto_sha256_final(&ctx, digest);
+        digest_stats.readback += extent;
+    }
+
+    for (uint32_t off = 4u; off + 4u <= tlv_size;) {
+        uint32_t type = dfu_digest_get_u16(&tlv[off]);
+        uint32_t length = dfu_digest_get_u16(&tlv[off + 2u]);
+
+        if (off + 4u + length > tlv_size) {
+            break;
+        }
+        if ((type == DFU_DIGEST_TLV_SHA256) && (length == BOOT_CRYPTO_SHA256_SIZE)) {
+            if (memcmp(&tlv[off + 4u], digest, BOOT_CRYPTO_SHA256_SIZE) == 0) {
+                state->status = CY_DFU_SUCCESS;
+            }
+            break;
+        }
+        off += 4u + length;
+    }
+    return state->status;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_digest_stats_get
+ ********************************************************************************
+ * Returns the number of bytes hashed since dfu_digest_init().
+ *******************************************************************************/
+void dfu_digest_stats_get(dfu_digest_stats_t *stats) {
+    *stats = digest_stats;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_ValidateApp
+ ********************************************************************************
+ * Validates an upgrade image, see dfu_digest_validate(). The signature is
+ * checked by the bootloader.
+ *
+ * Parameters:
+ *  appId          Application number: 1 for MCUboot image 0 on CM7_0, 2 for
+ *                 MCUboot image 1 on CM7_1.
+ *  params         DFU parameters, unused.
+ *
+ * Return:
+ *  Status of operation, CY_DFU_ERROR_VERIFY for an unknown application.
+ *******************************************************************************/
+cy_en_dfu_status_t Cy_DFU_ValidateApp(uint32_t appId, cy_stc_dfu_params_t *params) {
+    uint32_t image = dfu_image_of_app(appId);
+
+    (void)params;
+    return (image != DFU_IMAGE_NONE) ? dfu_digest_validate(image) : CY_DFU_ERROR_VERIFY;
+}
+#endif /* DFU_HASH_STREAM */
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * File Name:   dfu_digest.h
+ *
+ * Description: This file contains the declarations of the digest of the upgrade image, hashed
+ *              while the image is written, and of the validation that uses it.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_DIGEST_H
+#define DFU_DIGEST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_dfu.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Set to 1 to hash the upgrade image while it is written */
+#ifndef DFU_HASH_STREAM
+#define DFU_HASH_STREAM             (0)
+#endif
+
+/* MCUboot image layout */
+#define DFU_DIGEST_IMAGE_MAGIC      (0x96f3b83duL)
+#define DFU_DIGEST_HEADER_SIZE      (32u)
+#define DFU_DIGEST_TLV_INFO_MAGIC   (0x6907u)
+#define DFU_DIGEST_TLV_SHA256       (0x10u)
+/* IMAGE_F_ENCRYPTED_AES128 of the header flags */
+#define DFU_DIGEST_FLAG_ENCRYPTED   (0x04u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    /* Bytes hashed as they were written */
+    uint32_t streamed;
+    /* Bytes read back from the slot and hashed by the validation */
+    uint32_t readback;
+} dfu_digest_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+void dfu_digest_init(bool stream);
+void dfu_digest_update(uint32_t image, uint32_t offset, const uint8_t *data, uint32_t length);
+void dfu_digest_invalidate(uint32_t image);
+cy_en_dfu_status_t dfu_digest_validate(uint32_t image);
+void dfu_digest_stats_get(dfu_digest_stats_t *stats);
+
+#endif /* DFU_DIGEST_H */
+
+/* [] END OF FILE */
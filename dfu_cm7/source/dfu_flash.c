@@ -0,0 +1,680 @@
+/******************************************************************************
+ * File Name:   dfu_flash.c
+ *
+ * Description: This file contains the flash writer of the DFU application. Rows
+ *              received with Program Data are queued in a ring, with the erases they
+ *              need, and programmed in the background. A Program Data command is
+ *              acknowledged once its row is programmed: by the window layer, which
+ *              receives the next commands meanwhile, or here without it.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "dfu_flash.h"
+#include "dfu_delta.h"
+#include "dfu_digest.h"
+#include "dfu_image.h"
+#include "dfu_lz.h"
+#include "dfu_resume.h"
+#include "dfu_window.h"
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    DFU_FLASH_IDLE,
+    DFU_FLASH_ERASING,
+    DFU_FLASH_PROGRAMMING,
+} dfu_flash_phase_t;
+
+/* Format of an image sent to its secondary slot */
+typedef enum {
+    DFU_FLASH_STREAM_PLAIN,
+    DFU_FLASH_STREAM_LZ,
+    DFU_FLASH_STREAM_DELTA,
+} dfu_flash_stream_t;
+
+/* State of the erase sector the rows are written to */
+typedef enum {
+    DFU_FLASH_SECTOR_NONE,
+    /* Erased in this session, or found blank: erased rows are skipped */
+    DFU_FLASH_SECTOR_ERASED,
+    /* Not erased: rows equal to the flash are skipped, rows over erased
+     * flash are programmed, any other row erases the sector */
+    DFU_FLASH_SECTOR_KEPT,
+} dfu_flash_sector_t;
+
+/* Rows of an image: the format of its stream and the erase sector its rows
+ * are written to. The rows of several images may be interleaved */
+typedef struct {
+    dfu_flash_stream_t stream;
+    uint32_t sector;
+    uint32_t sector_size;
+    dfu_flash_sector_t sector_state;
+} dfu_flash_slot_t;
+
+typedef struct {
+    uint32_t address;
+    /* Bytes to program, 0 for an erase only */
+    uint32_t length;
+    /* Erase the sector before programming */
+    bool erase;
+    uint32_t data[CY_DFU_ROW_SIZE / sizeof(uint32_t)];
+} dfu_flash_row_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static dfu_flash_row_t flash_ring[DFU_FLASH_RING_SIZE];
+static uint32_t flash_ring_tail = 0u;
+static uint32_t flash_ring_count = 0u;
+static dfu_flash_phase_t flash_phase = DFU_FLASH_IDLE;
+
+/* Operations queued, and errors that dropped queued operations, since
+ * dfu_flash_init(). The mark is the operation of the last row queued, the
+ * progress records after it are not waited for. */
+static uint32_t flash_queued = 0u;
+static uint32_t flash_mark = 0u;
+static uint32_t flash_failures = 0u;
+
+/* First error of a background operation, reported by the next command */
+static cy_en_dfu_status_t flash_error = CY_DFU_SUCCESS;
+
+static dfu_flash_slot_t flash_slots[DFU_IMAGE_COUNT];
+
+/* Image of the compressed or delta stream being decoded, one at a time */
+static uint32_t flash_decode_image = 0u;
+
+/* Short last row of an image, filled up to a whole row */
+static uint8_t flash_short_row[CY_DFU_ROW_SIZE];
+
+/* Bit i: image i was written since dfu_flash_init() or dfu_flash_images_reset() */
+static uint32_t flash_images = 0u;
+
+static dfu_flash_stats_t flash_stats;
+
+#if (DFU_FLASH_RESTORE_SIZE > 0u)
+/* Rows of a kept sector programmed back after the sector is erased */
+static uint32_t flash_restore[DFU_FLASH_RESTORE_SIZE / sizeof(uint32_t)];
+#endif /* DFU_FLASH_RESTORE_SIZE */
+
+/*******************************************************************************
+ * Function Name: dfu_flash_init
+ ********************************************************************************
+ * Initializes the flash port and the ring.
+ *******************************************************************************/
+void dfu_flash_init(void) {
+    flash_ring_tail = 0u;
+    flash_ring_count = 0u;
+    flash_phase = DFU_FLASH_IDLE;
+    flash_queued = 0u;
+    flash_mark = 0u;
+    flash_failures = 0u;
+    flash_error = dfu_flash_port_init();
+    for (uint32_t i = 0u; i < DFU_IMAGE_COUNT; i++) {
+        flash_slots[i].stream = DFU_FLASH_STREAM_PLAIN;
+        flash_slots[i].sector_state = DFU_FLASH_SECTOR_NONE;
+    }
+    flash_decode_image = 0u;
+    flash_images = 0u;
+    memset(&flash_stats, 0, sizeof(flash_stats));
+#if (DFU_LZ)
+    dfu_lz_reset();
+#endif /* DFU_LZ */
+#if (DFU_RESUME)
+    dfu_resume_load();
+#endif /* DFU_RESUME */
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_stats_get
+ ********************************************************************************
+ * Returns the row counters since dfu_flash_init().
+ *******************************************************************************/
+void dfu_flash_stats_get(dfu_flash_stats_t *stats) {
+    *stats = flash_stats;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_images
+ ********************************************************************************
+ * Return:
+ *  The images written since dfu_flash_init() or dfu_flash_images_reset(),
+ *  bit i for the image of index i.
+ *******************************************************************************/
+uint32_t dfu_flash_images(void) {
+    return flash_images;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_images_reset
+ ********************************************************************************
+ * Forgets the images written, when the DFU restarts.
+ *******************************************************************************/
+void dfu_flash_images_reset(void) {
+    flash_images = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_service
+ ********************************************************************************
+ * Advances the ring: completes the running flash operation and starts the
+ * next one. Does not wait for the flash.
+ *******************************************************************************/
+void dfu_flash_service(void) {
+    while (flash_ring_count != 0u) {
+        dfu_flash_row_t *row = &flash_ring[flash_ring_tail];
+        cy_en_dfu_status_t status;
+
+        if (flash_phase != DFU_FLASH_IDLE) {
+            if (dfu_flash_port_busy()) {
+                return;
+            }
+            status = dfu_flash_port_result();
+            if (status != CY_DFU_SUCCESS) {
+                /* Drop the queued rows, the host restarts the update */
+                flash_error = status;
+                flash_failures++;
+                flash_ring_count = 0u;
+                flash_phase = DFU_FLASH_IDLE;
+                return;
+            }
+            if ((flash_phase == DFU_FLASH_PROGRAMMING) || (row->length == 0u)) {
+                flash_ring_tail = (flash_ring_tail + 1u) % DFU_FLASH_RING_SIZE;
+                flash_ring_count--;
+                flash_phase = DFU_FLASH_IDLE;
+                continue;
+            }
+            row->erase = false;
+        }
+
+        if (row->erase) {
+            status = dfu_flash_port_start_erase(row->address);
+            flash_phase = DFU_FLASH_ERASING;
+        } else {
+            status = dfu_flash_port_start_program(row->address, row->data, row->length);
+            flash_phase = DFU_FLASH_PROGRAMMING;
+        }
+        if (status != CY_DFU_SUCCESS) {
+            flash_error = status;
+            flash_failures++;
+            flash_ring_count = 0u;
+            flash_phase = DFU_FLASH_IDLE;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_pending
+ ********************************************************************************
+ * Return:
+ *  true if rows are still to be programmed.
+ *******************************************************************************/
+bool dfu_flash_pending(void) {
+    return (flash_ring_count != 0u);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_mark
+ ********************************************************************************
+ * Return:
+ *  Number of the operation of the last row queued, to wait for with
+ *  dfu_flash_reached().
+ *******************************************************************************/
+uint32_t dfu_flash_mark(void) {
+    return flash_mark;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_reached
+ ********************************************************************************
+ * Return:
+ *  true once the operations up to the given mark are done, or dropped by an
+ *  error that dfu_flash_failures() counts.
+ *******************************************************************************/
+bool dfu_flash_reached(uint32_t mark) {
+    return ((int32_t)(flash_queued - flash_ring_count - mark) >= 0);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_failures
+ ********************************************************************************
+ * Return:
+ *  Number of flash errors that dropped queued operations.
+ *******************************************************************************/
+uint32_t dfu_flash_failures(void) {
+    return flash_failures;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_flush
+ ********************************************************************************
+ * Waits until all queued rows are programmed and clears the error.
+ *
+ * Return:
+ *  CY_DFU_SUCCESS if all rows accepted since the last flush were programmed.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_flush(void) {
+    cy_en_dfu_status_t status;
+
+    while (flash_ring_count != 0u) {
+        dfu_flash_service();
+    }
+    status = flash_error;
+    flash_error = CY_DFU_SUCCESS;
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_is_blank
+ ********************************************************************************
+ * Return:
+ *  true if every byte holds the erased value.
+ *******************************************************************************/
+static bool dfu_flash_is_blank(const uint8_t *data, uint32_t length) {
+    for (uint32_t i = 0u; i < length; i++) {
+        if (data[i] != DFU_FLASH_ERASED_VALUE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_wait
+ ********************************************************************************
+ * Waits until all queued operations are done, so that the flash can be read.
+ *******************************************************************************/
+static void dfu_flash_wait(void) {
+    while (flash_ring_count != 0u) {
+        dfu_flash_service();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_push
+ ********************************************************************************
+ * Adds an operation to the ring, waiting for a free row buffer.
+ *******************************************************************************/
+static void dfu_flash_push(uint32_t address, const uint8_t *data, uint32_t length, bool erase) {
+    dfu_flash_row_t *row;
+
+    while (flash_ring_count >= DFU_FLASH_RING_SIZE) {
+        dfu_flash_service();
+    }
+    row = &flash_ring[(flash_ring_tail + flash_ring_count) % DFU_FLASH_RING_SIZE];
+    row->address = address;
+    row->length = length;
+    row->erase = erase;
+    if (length != 0u) {
+        memcpy(row->data, data, length);
+    }
+    flash_ring_count++;
+    flash_queued++;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_open
+ ********************************************************************************
+ * Starts writing the erase sector of the given row of an image. A blank
+ * sector is not erased. A sector that fits DFU_FLASH_RESTORE_SIZE, or that is
+ * entered after its first row, is kept until a row needs the erase. Any
+ * other sector is erased at once.
+ *******************************************************************************/
+static void dfu_flash_open(dfu_flash_slot_t *slot, uint32_t address, uint32_t erase_size) {
+    const uint8_t *flash;
+
+    slot->sector = address - (address % erase_size);
+    slot->sector_size = erase_size;
+    dfu_flash_wait();
+    flash = dfu_flash_port_ptr(slot->sector, erase_size);
+
+    if ((flash != NULL) && dfu_flash_is_blank(flash, erase_size)) {
+        slot->sector_state = DFU_FLASH_SECTOR_ERASED;
+    } else if ((flash != NULL) && ((erase_size <= DFU_FLASH_RESTORE_SIZE) || (address != slot->sector))) {
+        slot->sector_state = DFU_FLASH_SECTOR_KEPT;
+    } else {
+        dfu_flash_push(slot->sector, NULL, 0u, true);
+        flash_stats.erased++;
+        slot->sector_state = DFU_FLASH_SECTOR_ERASED;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_erase_kept
+ ********************************************************************************
+ * Erases the kept sector before the given row, and programs back the rows
+ * of the sector before it, which were skipped or programmed over erased
+ * flash.
+ *
+ * Return:
+ *  CY_DFU_ERROR_VERIFY if these rows do not fit DFU_FLASH_RESTORE_SIZE.
+ *******************************************************************************/
+static cy_en_dfu_status_t dfu_flash_erase_kept(dfu_flash_slot_t *slot, uint32_t address) {
+    uint32_t prefix = address - slot->sector;
+
+    if (prefix > DFU_FLASH_RESTORE_SIZE) {
+        return CY_DFU_ERROR_VERIFY;
+    }
+#if (DFU_FLASH_RESTORE_SIZE > 0u)
+    if (prefix != 0u) {
+        memcpy(flash_restore, dfu_flash_port_ptr(slot->sector, prefix), prefix);
+    }
+    dfu_flash_push(slot->sector, NULL, 0u, true);
+    flash_stats.erased++;
+    for (uint32_t offset = 0u; offset < prefix; offset += CY_DFU_ROW_SIZE) {
+        const uint8_t *data = (const uint8_t *)flash_restore + offset;
+        uint32_t length = ((prefix - offset) < CY_DFU_ROW_SIZE) ? (prefix - offset) : CY_DFU_ROW_SIZE;
+
+        if (!dfu_flash_is_blank(data, length)) {
+            dfu_flash_push(slot->sector + offset, data, length, false);
+            flash_stats.restored++;
+        }
+    }
+#else
+    dfu_flash_push(slot->sector, NULL, 0u, true);
+    flash_stats.erased++;
+#endif /* DFU_FLASH_RESTORE_SIZE */
+    slot->sector_state = DFU_FLASH_SECTOR_ERASED;
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_queue
+ ********************************************************************************
+ * Queues a row for the secondary slot of an image. A short row, the last one
+ * of an image, is filled up with the erased value. A row equal to the flash,
+ * or an erased row over erased flash, is skipped. A sector is erased only if
+ * a row cannot be programmed over its contents. With the window layer the
+ * row is programmed while the next commands are received, and the window
+ * layer holds back the response until dfu_flash_reached(). Without it, the
+ * function returns once the row is programmed.
+ *
+ * Parameters:
+ *  address        Flash address of the row.
+ *  data, length   Row, up to CY_DFU_ROW_SIZE bytes.
+ *
+ * Return:
+ *  Status of operation, including an error of an earlier background write.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_queue(uint32_t address, const uint8_t *data, uint32_t length) {
+    uint32_t erase_size = dfu_flash_port_erase_size(address);
+    uint32_t image = dfu_image_find(address, length);
+    dfu_flash_slot_t *slot;
+
+    if ((image == DFU_IMAGE_NONE) || (erase_size == 0u) || (length > CY_DFU_ROW_SIZE)) {
+        return CY_DFU_ERROR_ADDRESS;
+    }
+    if (length < CY_DFU_ROW_SIZE) {
+        /* The last row of an image that is not padded to a whole row */
+        memcpy(flash_short_row, data, length);
+        memset(&flash_short_row[length], DFU_FLASH_ERASED_VALUE, CY_DFU_ROW_SIZE - length);
+        data = flash_short_row;
+        length = CY_DFU_ROW_SIZE;
+    }
+    if (flash_error != CY_DFU_SUCCESS) {
+        return dfu_flash_flush();
+    }
+
+    slot = &flash_slots[image];
+    flash_images |= 1uL << image;
+    flash_stats.rows++;
+#if (DFU_HASH_STREAM)
+    dfu_digest_update(image, address - dfu_image_get(image)->secondary, data, length);
+#endif /* DFU_HASH_STREAM */
+
+    if ((slot->sector_state == DFU_FLASH_SECTOR_NONE) || (address < slot->sector) ||
+        (address - slot->sector >= slot->sector_size)) {
+        dfu_flash_open(slot, address, erase_size);
+    }
+
+    if (slot->sector_state == DFU_FLASH_SECTOR_KEPT) {
+        const uint8_t *flash;
+
+        /* Earlier rows of the sector may still be programming */
+        dfu_flash_wait();
+        flash = dfu_flash_port_ptr(address, length);
+        if ((flash != NULL) && (memcmp(flash, data, length) == 0)) {
+            if (dfu_flash_is_blank(data, length)) {
+                flash_stats.blank++;
+            } else {
+                flash_stats.unchanged++;
+            }
+            return (flash_error == CY_DFU_SUCCESS) ? CY_DFU_SUCCESS : dfu_flash_flush();
+        }
+        if ((flash == NULL) || !dfu_flash_is_blank(flash, length)) {
+            cy_en_dfu_status_t status = dfu_flash_erase_kept(slot, address);
+
+            if (status != CY_DFU_SUCCESS) {
+                return status;
+            }
+        }
+    } else if (dfu_flash_is_blank(data, length)) {
+        flash_stats.blank++;
+        return (flash_error == CY_DFU_SUCCESS) ? CY_DFU_SUCCESS : dfu_flash_flush();
+    } else {
+        /* Programmed over the erased sector */
+    }
+
+    dfu_flash_push(address, data, length, false);
+    flash_mark = flash_queued;
+    flash_stats.programmed++;
+    dfu_flash_service();
+#if !(DFU_WINDOW)
+    /* No one else holds back the acknowledgment */
+    dfu_flash_wait();
+#endif /* !DFU_WINDOW */
+
+    return (flash_error == CY_DFU_SUCCESS) ? CY_DFU_SUCCESS : dfu_flash_flush();
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_queue_slot
+ ********************************************************************************
+ * Queues decoded bytes at the given offset of the secondary slot of the
+ * image being decoded.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_queue_slot(uint32_t offset, const uint8_t *data, uint32_t length) {
+    return dfu_flash_queue(dfu_image_get(flash_decode_image)->secondary + offset, data, length);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_queue_record
+ ********************************************************************************
+ * Queues a write outside the upgrade slot, such as a progress record, that
+ * is done after the rows queued before it. Does not wait for it.
+ *
+ * Parameters:
+ *  address        Flash address.
+ *  data, length   Bytes to program, up to CY_DFU_ROW_SIZE; 0 to only erase.
+ *  erase          Erase the sector of the address first.
+ *******************************************************************************/
+void dfu_flash_queue_record(uint32_t address, const uint8_t *data, uint32_t length, bool erase) {
+    if ((flash_error == CY_DFU_SUCCESS) && (length <= CY_DFU_ROW_SIZE)) {
+        dfu_flash_push(address, data, length, erase);
+        dfu_flash_service();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_WriteData
+ ********************************************************************************
+ * Writes a row of an upgrade image received with Program Data, or erases a
+ * sector. The address selects the image: the row goes to the secondary slot
+ * that holds it. A row at the start of a secondary slot that carries a
+ * compressed stream or a delta image header starts a compressed or delta
+ * image, the rows that follow it are decompressed or patched into the slot.
+ * The rows of plain images may be interleaved; compressed and delta images
+ * share one decoder and are sent one after the other.
+ *
+ * Parameters:
+ *  address        Flash address of the row.
+ *  length         Row length, up to CY_DFU_ROW_SIZE.
+ *  ctl            CY_DFU_IOCTL_WRITE or CY_DFU_IOCTL_ERASE.
+ *  params         DFU parameters, the row is in params->dataBuffer.
+ *
+ * Return:
+ *  Status of operation, including an error of an earlier background write.
+ *******************************************************************************/
+cy_en_dfu_status_t Cy_DFU_WriteData(uint32_t address, uint32_t length, uint32_t ctl,
+                                    cy_stc_dfu_params_t *params) {
+    uint32_t image = dfu_image_find(address, length);
+    const dfu_image_t *slots;
+    dfu_flash_slot_t *slot;
+    cy_en_dfu_status_t status;
+
+    if ((image == DFU_IMAGE_NONE) || (dfu_flash_port_erase_size(address) == 0u) ||
+        (length > CY_DFU_ROW_SIZE)) {
+        return CY_DFU_ERROR_ADDRESS;
+    }
+    slots = dfu_image_get(image);
+    slot = &flash_slots[image];
+    (void)slots;
+
+    if ((ctl & CY_DFU_IOCTL_ERASE) != 0u) {
+        status = dfu_flash_flush();
+        if (status == CY_DFU_SUCCESS) {
+            status = dfu_flash_port_start_erase(address);
+        }
+        while ((status == CY_DFU_SUCCESS) && dfu_flash_port_busy()) {
+        }
+        slot->sector_state = DFU_FLASH_SECTOR_NONE;
+#if (DFU_RESUME)
+        if (image == 0u) {
+            dfu_resume_stop();
+        }
+#endif /* DFU_RESUME */
+#if (DFU_HASH_STREAM)
+        dfu_digest_invalidate(image);
+#endif /* DFU_HASH_STREAM */
+        return (status == CY_DFU_SUCCESS) ? dfu_flash_port_result() : status;
+    }
+
+#if (DFU_RESUME)
+    /* A new image. The progress record covers the first image only */
+    if ((image == 0u) && (address == slots->secondary)) {
+        dfu_resume_start();
+    }
+#endif /* DFU_RESUME */
+
+#if (DFU_LZ)
+    /* The first row of the slot tells the image format */
+    if (address == slots->secondary) {
+        slot->stream = DFU_FLASH_STREAM_PLAIN;
+        if (dfu_lz_is_stream(params->dataBuffer, length)) {
+            slot->stream = DFU_FLASH_STREAM_LZ;
+        }
+#if (DFU_DELTA)
+        if (dfu_delta_is_stream(params->dataBuffer, length)) {
+            slot->stream = DFU_FLASH_STREAM_DELTA;
+        }
+#endif /* DFU_DELTA */
+        if (slot->stream != DFU_FLASH_STREAM_PLAIN) {
+            dfu_lz_reset();
+            flash_decode_image = image;
+        }
+    }
+#if (DFU_RESUME)
+    if ((image == 0u) && (address == slots->secondary) && (slot->stream != DFU_FLASH_STREAM_PLAIN)) {
+        /* The decoder state is not recorded */
+        dfu_resume_stop();
+    }
+#endif /* DFU_RESUME */
+    if ((slot->stream != DFU_FLASH_STREAM_PLAIN) && (image != flash_decode_image)) {
+        /* The decoder moved on to the stream of another image */
+        return CY_DFU_ERROR_DATA;
+    }
+    if (slot->stream == DFU_FLASH_STREAM_LZ) {
+        return dfu_lz_write(address - slots->secondary, params->dataBuffer, length,
+                            &dfu_flash_queue_slot);
+    }
+#if (DFU_DELTA)
+    if (slot->stream == DFU_FLASH_STREAM_DELTA) {
+        return dfu_delta_write(slots, address - slots->secondary, params->dataBuffer, length);
+    }
+#endif /* DFU_DELTA */
+#endif /* DFU_LZ */
+
+    status = dfu_flash_queue(address, params->dataBuffer, length);
+#if (DFU_RESUME)
+    if ((status == CY_DFU_SUCCESS) && (image == 0u)) {
+        dfu_resume_track(address - slots->secondary, params->dataBuffer, length);
+    }
+#endif /* DFU_RESUME */
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_ReadData
+ ********************************************************************************
+ * Reads flash into, or compares flash against, params->dataBuffer after all
+ * queued rows are programmed. A read of the resume metadata returns the
+ * latest progress record.
+ *
+ * Parameters:
+ *  address        Flash address.
+ *  length         Number of bytes.
+ *  ctl            CY_DFU_IOCTL_READ or CY_DFU_IOCTL_COMPARE.
+ *  params         DFU parameters.
+ *
+ * Return:
+ *  Status of operation.
+ *******************************************************************************/
+cy_en_dfu_status_t Cy_DFU_ReadData(uint32_t address, uint32_t length, uint32_t ctl,
+                                   cy_stc_dfu_params_t *params) {
+    cy_en_dfu_status_t status = dfu_flash_flush();
+    const uint8_t *src = dfu_flash_port_ptr(address, length);
+
+    if (status != CY_DFU_SUCCESS) {
+        return status;
+    }
+#if (DFU_RESUME)
+    if (((ctl & CY_DFU_IOCTL_COMPARE) == 0u) && dfu_resume_is_metadata(address, length)) {
+        dfu_resume_metadata(address, params->dataBuffer, length);
+        return CY_DFU_SUCCESS;
+    }
+#endif /* DFU_RESUME */
+    if (src == NULL) {
+        return CY_DFU_ERROR_ADDRESS;
+    }
+    if ((ctl & CY_DFU_IOCTL_COMPARE) != 0u) {
+        return (memcmp(src, params->dataBuffer, length) == 0) ? CY_DFU_SUCCESS : CY_DFU_ERROR_VERIFY;
+    }
+    memcpy(params->dataBuffer, src, length);
+    return CY_DFU_SUCCESS;
+}
+
+/* [] END OF FILE */
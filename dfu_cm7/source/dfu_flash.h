@@ -0,0 +1,119 @@
+/******************************************************************************
+ * File Name:   dfu_flash.h
+ *
+ * Description: This file contains the declarations of the flash writer of the DFU
+ *              application and of the flash port it runs on.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_FLASH_H
+#define DFU_FLASH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_dfu.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Number of row buffers of the flash ring */
+#ifndef DFU_FLASH_RING_SIZE
+#define DFU_FLASH_RING_SIZE         (4u)
+#endif
+
+/* Largest erase sector whose rows are compared with the flash before it is
+ * erased, so that rows left unchanged are not programmed again. Needs a
+ * static RAM buffer of this size, 0 leaves it out. Larger sectors are erased
+ * at their first row unless they are blank */
+#ifndef DFU_FLASH_RESTORE_SIZE
+#define DFU_FLASH_RESTORE_SIZE      (0u)
+#endif
+
+#define DFU_FLASH_ERASED_VALUE      (0xFFu)
+
+/* Longest sleep of the event-driven DFU session while records are in flight */
+#define DFU_FLASH_SERVICE_MS        (1u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Row counters of the flash writer */
+typedef struct {
+    /* Rows received */
+    uint32_t rows;
+    /* Rows programmed */
+    uint32_t programmed;
+    /* Rows skipped: equal to the flash */
+    uint32_t unchanged;
+    /* Rows skipped: erased, over erased flash */
+    uint32_t blank;
+    /* Sectors erased */
+    uint32_t erased;
+    /* Rows programmed back after the erase of a kept sector */
+    uint32_t restored;
+} dfu_flash_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+void dfu_flash_init(void);
+void dfu_flash_stats_get(dfu_flash_stats_t *stats);
+uint32_t dfu_flash_images(void);
+void dfu_flash_images_reset(void);
+void dfu_flash_service(void);
+bool dfu_flash_pending(void);
+uint32_t dfu_flash_mark(void);
+bool dfu_flash_reached(uint32_t mark);
+uint32_t dfu_flash_failures(void);
+cy_en_dfu_status_t dfu_flash_flush(void);
+cy_en_dfu_status_t dfu_flash_queue(uint32_t address, const uint8_t *data, uint32_t length);
+cy_en_dfu_status_t dfu_flash_queue_slot(uint32_t offset, const uint8_t *data, uint32_t length);
+void dfu_flash_queue_record(uint32_t address, const uint8_t *data, uint32_t length, bool erase);
+
+/* Flash port, provided by the platform. The start functions return as soon
+ * as the operation is started, dfu_flash_port_busy() reports its completion */
+cy_en_dfu_status_t dfu_flash_port_init(void);
+uint32_t dfu_flash_port_erase_size(uint32_t address);
+cy_en_dfu_status_t dfu_flash_port_start_erase(uint32_t address);
+cy_en_dfu_status_t dfu_flash_port_start_program(uint32_t address, const uint32_t *data,
+                                                uint32_t length);
+bool dfu_flash_port_busy(void);
+cy_en_dfu_status_t dfu_flash_port_result(void);
+const uint8_t *dfu_flash_port_ptr(uint32_t address, uint32_t length);
+
+#endif /* DFU_FLASH_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * File Name:   dfu_flash_port.c
+ *
+ * Description: This file contains the XMC7000 flash port of the flash writer. Code
+ *              flash rows are programmed and sectors erased with the non-blocking
+ *              flash driver API, the sector geometry comes from the generated
+ *              memory map.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include "cy_pdl.h"
+#include "memorymap.h"
+#include "dfu_flash.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Number of flash regions in flash_devices[] */
+#define DFU_FLASH_REGION_COUNT      (INTERNAL_FLASH_WORK_SMALL + 1u)
+
+/* Size of a code flash program row */
+#define DFU_FLASH_CODE_ROW_SIZE     (512u)
+
+/* Size of a work flash program unit, a progress record */
+#define DFU_FLASH_WORK_ROW_SIZE     (32u)
+
+/*******************************************************************************
+ * Function Name: dfu_flash_region
+ ********************************************************************************
+ * Returns the flash region that contains the address, NULL if none.
+ *******************************************************************************/
+static const struct flash_device *dfu_flash_region(uint32_t address) {
+    for (uint32_t i = 0u; i < DFU_FLASH_REGION_COUNT; i++) {
+        if ((address >= flash_devices[i].address) &&
+            (address - flash_devices[i].address < flash_devices[i].size)) {
+            return &flash_devices[i];
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_init
+ ********************************************************************************
+ * Enables writes to the code flash and to the work flash.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_port_init(void) {
+    Cy_Flashc_MainWriteEnable();
+    Cy_Flashc_WorkWriteEnable();
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_erase_size
+ ********************************************************************************
+ * Returns the erase sector size at the address, 0 outside the flash.
+ *******************************************************************************/
+uint32_t dfu_flash_port_erase_size(uint32_t address) {
+    const struct flash_device *region = dfu_flash_region(address);
+
+    return (region != NULL) ? region->erase_size : 0u;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_start_erase
+ ********************************************************************************
+ * Starts erasing the sector that contains the address.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_port_start_erase(uint32_t address) {
+    uint32_t erase_size = dfu_flash_port_erase_size(address);
+
+    if (erase_size == 0u) {
+        return CY_DFU_ERROR_ADDRESS;
+    }
+    return (Cy_Flash_StartEraseSector(address - (address % erase_size)) == CY_FLASH_DRV_SUCCESS) ?
+           CY_DFU_SUCCESS : CY_DFU_ERROR_DATA;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_start_program
+ ********************************************************************************
+ * Starts programming a code flash row, the upgrade slot is in the code flash,
+ * or a 32-byte work flash unit, the progress record. The flash controller
+ * reads the data from its ring buffer, which is not reused until the
+ * operation completes.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_port_start_program(uint32_t address, const uint32_t *data,
+                                                uint32_t length) {
+    cy_stc_flash_programrow_config_t config = {
+        .destAddr = (uint32_t *)address,
+        .dataAddr = (uint32_t *)data,
+        .blocking = CY_FLASH_PROGRAMROW_NON_BLOCKING,
+        .skipBC = CY_FLASH_PROGRAMROW_SKIP_BLANK_CHECK,
+        .dataSize = CY_FLASH_PROGRAMROW_DATA_SIZE_4096BIT,
+        .dataLoc = CY_FLASH_PROGRAMROW_DATA_LOCATION_SRAM,
+        .intrMask = CY_FLASH_PROGRAMROW_NOT_SET_INTR_MASK,
+    };
+
+    const struct flash_device *region = dfu_flash_region(address);
+
+    if ((region != NULL) &&
+        ((region->device_id == INTERNAL_FLASH_WORK_LARGE) || (region->device_id == INTERNAL_FLASH_WORK_SMALL))) {
+        if ((length != DFU_FLASH_WORK_ROW_SIZE) || ((address % DFU_FLASH_WORK_ROW_SIZE) != 0u)) {
+            return CY_DFU_ERROR_ADDRESS;
+        }
+        config.dataSize = CY_FLASH_PROGRAMROW_DATA_SIZE_256BIT;
+        return (Cy_Flash_Program_WorkFlash(&config) == CY_FLASH_DRV_SUCCESS) ? CY_DFU_SUCCESS : CY_DFU_ERROR_DATA;
+    }
+    if ((region == NULL) ||
+        ((region->device_id != INTERNAL_FLASH_CODE_LARGE) && (region->device_id != INTERNAL_FLASH_CODE_SMALL)) ||
+        (length != DFU_FLASH_CODE_ROW_SIZE) || ((address % DFU_FLASH_CODE_ROW_SIZE) != 0u)) {
+        return CY_DFU_ERROR_ADDRESS;
+    }
+    return (Cy_Flash_Program(&config, CY_FLASH_DRIVER_NON_BLOCKING) == CY_FLASH_DRV_SUCCESS) ?
+           CY_DFU_SUCCESS : CY_DFU_ERROR_DATA;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_busy
+ ********************************************************************************
+ * Return:
+ *  true while a flash operation is running.
+ *******************************************************************************/
+bool dfu_flash_port_busy(void) {
+    return (Cy_Flash_IsOperationComplete() == CY_FLASH_DRV_OPCODE_BUSY);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_result
+ ********************************************************************************
+ * Returns the status of the last completed operation.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_port_result(void) {
+    return (Cy_Flash_IsOperationComplete() == CY_FLASH_DRV_SUCCESS) ? CY_DFU_SUCCESS : CY_DFU_ERROR_DATA;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_ptr
+ ********************************************************************************
+ * The flash is memory mapped.
+ *******************************************************************************/
+const uint8_t *dfu_flash_port_ptr(uint32_t address, uint32_t length) {
+    return ((dfu_flash_region(address) != NULL) && (dfu_flash_region(address + length - 1u) != NULL)) ?
+           (const uint8_t *)address : NULL;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * File Name:   dfu_image.c
+ *
+ * Description: This file contains the slot table of the images the DFU application updates,
+ *              built from the slots of the memory map that the Makefile passes in IMG_<n>_*.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stddef.h>
+#include "dfu_image.h"
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const dfu_image_t dfu_images[DFU_IMAGE_COUNT] = {
+#if (USE_DIRECT_XIP)
+    /* The bootloader runs the image in place, from either slot */
+    { USER_APP_START, (USER_APP_START == IMG_1_SECONDARY_START) ? IMG_1_PRIMARY_START : IMG_1_SECONDARY_START,
+      IMG_1_SLOT_SIZE },
+#else
+    { IMG_1_PRIMARY_START, IMG_1_SECONDARY_START, IMG_1_SLOT_SIZE },
+#endif
+#if (MCUBOOT_IMAGE_NUMBER > 1)
+    { IMG_2_PRIMARY_START, IMG_2_SECONDARY_START, IMG_2_SLOT_SIZE },
+#endif
+};
+
+/*******************************************************************************
+ * Function Name: dfu_image_get
+ ********************************************************************************
+ * Return:
+ *  The slots of the image of the index, NULL if there is no such image.
+ *******************************************************************************/
+const dfu_image_t *dfu_image_get(uint32_t image) {
+    return (image < DFU_IMAGE_COUNT) ? &dfu_images[image] : NULL;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_image_find
+ ********************************************************************************
+ * Finds the image whose secondary slot holds a range.
+ *
+ * Parameters:
+ *  address        Flash address.
+ *  length         Number of bytes.
+ *
+ * Return:
+ *  Index of the image, DFU_IMAGE_NONE if the range is in no secondary slot.
+ *******************************************************************************/
+uint32_t dfu_image_find(uint32_t address, uint32_t length) {
+    for (uint32_t i = 0u; i < DFU_IMAGE_COUNT; i++) {
+        const dfu_image_t *image = &dfu_images[i];
+
+        if ((address >= image->secondary) &&
+            ((uint64_t)address + length <= (uint64_t)image->secondary + image->size)) {
+            return i;
+        }
+    }
+    return DFU_IMAGE_NONE;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_image_of_app
+ ********************************************************************************
+ * Return:
+ *  Index of the image of an application ID of Verify Application,
+ *  DFU_IMAGE_NONE if there is no such image.
+ *******************************************************************************/
+uint32_t dfu_image_of_app(uint32_t app_id) {
+    return ((app_id >= 1u) && (app_id <= DFU_IMAGE_COUNT)) ? (app_id - 1u) : DFU_IMAGE_NONE;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * File Name:   dfu_image.h
+ *
+ * Description: This file contains the declarations of the slot table of the images the DFU
+ *              application updates: one image per CM7 core.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_IMAGE_H
+#define DFU_IMAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Number of images of the memory map, one per CM7 core */
+#ifndef MCUBOOT_IMAGE_NUMBER
+#define MCUBOOT_IMAGE_NUMBER        (1)
+#endif
+
+#if (MCUBOOT_IMAGE_NUMBER < 1) || (MCUBOOT_IMAGE_NUMBER > 2)
+#error "The DFU application updates one image per CM7 core: MCUBOOT_IMAGE_NUMBER must be 1 or 2"
+#endif
+
+#define DFU_IMAGE_COUNT             ((uint32_t)MCUBOOT_IMAGE_NUMBER)
+
+/* Set by the Makefile when the memory map is in the direct XIP mode */
+#ifndef USE_DIRECT_XIP
+#define USE_DIRECT_XIP              (0)
+#endif
+
+/* No image holds the address */
+#define DFU_IMAGE_NONE              (0xFFFFFFFFu)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Slots of an image, from the memory map. The image of index i is MCUboot
+ * image i and has the application ID i + 1 in Verify Application. In the
+ * direct XIP mode primary is the slot this application runs from and
+ * secondary the other slot, the one an upgrade is written to */
+typedef struct {
+    uint32_t primary;
+    uint32_t secondary;
+    uint32_t size;
+} dfu_image_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+const dfu_image_t *dfu_image_get(uint32_t image);
+uint32_t dfu_image_find(uint32_t address, uint32_t length);
+uint32_t dfu_image_of_app(uint32_t app_id);
+
+#endif /* DFU_IMAGE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,285 @@
+/******************************************************************************
+ * File Name:   dfu_lz.c
+ *
+ * Description: This file contains the streaming decompressor of compressed upgrade images.
+ *              The compressed stream arrives with Program Data at the secondary slot
+ *              addresses; it is inflated one row at a time into the flash writer, with a
+ *              fixed window in RAM, so that only the compressed bytes cross the DFU
+ *              transport.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "dfu_lz.h"
+
+#if (DFU_LZ)
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define DFU_LZ_WINDOW_MASK          ((1uL << DFU_LZ_WINDOW_BITS) - 1u)
+#define DFU_LZ_DISTANCE_MASK        (0x0FFFu)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    DFU_LZ_FLAGS,
+    DFU_LZ_ITEM,
+    DFU_LZ_MATCH_HI,
+    DFU_LZ_MATCH_EXT,
+} dfu_lz_state_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static bool lz_active = false;
+static dfu_lz_state_t lz_state = DFU_LZ_FLAGS;
+
+/* Decompressed size, bytes decompressed and compressed bytes consumed */
+static uint32_t lz_size = 0u;
+static uint32_t lz_out = 0u;
+static uint32_t lz_in = 0u;
+
+/* Largest match distance of the stream */
+static uint32_t lz_max_distance = 0u;
+
+static uint8_t lz_flags = 0u;
+static uint32_t lz_flag_count = 0u;
+static uint16_t lz_match = 0u;
+static uint32_t lz_length = 0u;
+
+/* Receives the decompressed rows */
+static dfu_lz_sink_t lz_sink = NULL;
+
+static uint8_t lz_window[DFU_LZ_WINDOW_MASK + 1u];
+static uint8_t lz_row[CY_DFU_ROW_SIZE];
+static uint32_t lz_row_fill = 0u;
+
+/*******************************************************************************
+ * Function Name: dfu_lz_output
+ ********************************************************************************
+ * Appends a decompressed byte, a full row goes to the sink.
+ *******************************************************************************/
+static cy_en_dfu_status_t dfu_lz_output(uint8_t byte) {
+    if (lz_out >= lz_size) {
+        return CY_DFU_ERROR_DATA;
+    }
+    lz_window[lz_out & DFU_LZ_WINDOW_MASK] = byte;
+    lz_row[lz_row_fill++] = byte;
+    lz_out++;
+
+    if ((lz_row_fill == CY_DFU_ROW_SIZE) || (lz_out == lz_size)) {
+        uint32_t length = lz_row_fill;
+
+        lz_row_fill = 0u;
+        return lz_sink(lz_out - length, lz_row, length);
+    }
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_lz_copy
+ ********************************************************************************
+ * Decompresses a match.
+ *******************************************************************************/
+static cy_en_dfu_status_t dfu_lz_copy(void) {
+    uint32_t distance = (uint32_t)(lz_match & DFU_LZ_DISTANCE_MASK) + 1u;
+    cy_en_dfu_status_t status = CY_DFU_SUCCESS;
+
+    if ((distance > lz_out) || (distance > lz_max_distance) || (lz_length > lz_size - lz_out)) {
+        return CY_DFU_ERROR_DATA;
+    }
+    while ((lz_length != 0u) && (status == CY_DFU_SUCCESS)) {
+        status = dfu_lz_output(lz_window[(lz_out - distance) & DFU_LZ_WINDOW_MASK]);
+        lz_length--;
+    }
+    lz_state = (lz_flag_count == 0u) ? DFU_LZ_FLAGS : DFU_LZ_ITEM;
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_lz_decode
+ ********************************************************************************
+ * Advances the decompressor by one compressed byte.
+ *******************************************************************************/
+static cy_en_dfu_status_t dfu_lz_decode(uint8_t byte) {
+    cy_en_dfu_status_t status = CY_DFU_SUCCESS;
+
+    if (lz_out == lz_size) {
+        /* Data after the end of the stream */
+        return CY_DFU_ERROR_DATA;
+    }
+
+    switch (lz_state) {
+    case DFU_LZ_FLAGS:
+        lz_flags = byte;
+        lz_flag_count = 8u;
+        lz_state = DFU_LZ_ITEM;
+        break;
+
+    case DFU_LZ_ITEM:
+        lz_flag_count--;
+        if ((lz_flags & 1u) != 0u) {
+            lz_match = byte;
+            lz_state = DFU_LZ_MATCH_HI;
+        } else {
+            status = dfu_lz_output(byte);
+            lz_state = (lz_flag_count == 0u) ? DFU_LZ_FLAGS : DFU_LZ_ITEM;
+        }
+        lz_flags >>= 1;
+        break;
+
+    case DFU_LZ_MATCH_HI:
+        lz_match |= (uint16_t)((uint16_t)byte << 8);
+        lz_length = (uint32_t)(lz_match >> 12) + DFU_LZ_MIN_MATCH;
+        if ((lz_match >> 12) == DFU_LZ_LENGTH_EXT) {
+            lz_state = DFU_LZ_MATCH_EXT;
+        } else {
+            status = dfu_lz_copy();
+        }
+        break;
+
+    case DFU_LZ_MATCH_EXT:
+        lz_length += byte;
+        if (lz_length > lz_size) {
+            status = CY_DFU_ERROR_DATA;
+        } else if (byte != 0xFFu) {
+            status = dfu_lz_copy();
+        }
+        break;
+
+    default:
+        status = CY_DFU_ERROR_DATA;
+        break;
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_lz_reset
+ ********************************************************************************
+ * Ends the compressed stream, if any.
+ *******************************************************************************/
+void dfu_lz_reset(void) {
+    lz_active = false;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_lz_active
+ ********************************************************************************
+ * Return:
+ *  true while a compressed stream is being received.
+ *******************************************************************************/
+bool dfu_lz_active(void) {
+    return lz_active;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_lz_is_stream
+ ********************************************************************************
+ * Return:
+ *  true if the data starts with a compressed stream header.
+ *******************************************************************************/
+bool dfu_lz_is_stream(const uint8_t *data, uint32_t length) {
+    return (length >= DFU_LZ_HEADER_SIZE) &&
+           (((uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) |
+             ((uint32_t)data[3] << 24)) == DFU_LZ_MAGIC);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_lz_write
+ ********************************************************************************
+ * Decompresses a row of the compressed stream. The row at offset 0 starts
+ * the stream. A row that was already decompressed, as a retransmission, is
+ * accepted and ignored.
+ *
+ * Parameters:
+ *  offset         Offset of the row in the compressed stream.
+ *  data, length   Compressed bytes.
+ *  sink           Receives the decompressed bytes, up to CY_DFU_ROW_SIZE at a
+ *                 time, with their offset in the decompressed data.
+ *
+ * Return:
+ *  Status of operation.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_lz_write(uint32_t offset, const uint8_t *data, uint32_t length,
+                                dfu_lz_sink_t sink) {
+    cy_en_dfu_status_t status = CY_DFU_SUCCESS;
+    uint32_t start = 0u;
+
+    if (offset == 0u) {
+        uint32_t bits;
+
+        lz_active = false;
+        if (!dfu_lz_is_stream(data, length)) {
+            return CY_DFU_ERROR_DATA;
+        }
+        bits = data[5];
+        lz_size = (uint32_t)data[8] | ((uint32_t)data[9] << 8) | ((uint32_t)data[10] << 16) |
+                  ((uint32_t)data[11] << 24);
+        if ((data[4] != DFU_LZ_VERSION) || (bits > DFU_LZ_WINDOW_BITS) || (lz_size == 0u)) {
+            return CY_DFU_ERROR_DATA;
+        }
+        lz_sink = sink;
+        lz_max_distance = 1uL << bits;
+        lz_state = DFU_LZ_FLAGS;
+        lz_out = 0u;
+        lz_in = 0u;
+        lz_row_fill = 0u;
+        lz_active = true;
+        start = DFU_LZ_HEADER_SIZE;
+    } else if (!lz_active) {
+        return CY_DFU_ERROR_DATA;
+    } else if (offset + length <= lz_in) {
+        return CY_DFU_SUCCESS;
+    } else if (offset != lz_in) {
+        return CY_DFU_ERROR_DATA;
+    } else {
+        /* In sequence */
+    }
+
+    lz_in = offset + length;
+    for (uint32_t i = start; (i < length) && (status == CY_DFU_SUCCESS); i++) {
+        status = dfu_lz_decode(data[i]);
+    }
+    if (status != CY_DFU_SUCCESS) {
+        lz_active = false;
+    }
+    return status;
+}
+#endif /* DFU_LZ */
+
+/* [] END OF FILE */
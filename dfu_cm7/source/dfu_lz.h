@@ -0,0 +1,104 @@
+/******************************************************************************
+ * File Name:   dfu_lz.h
+ *
+ * Description: This file contains the declarations of the streaming decompressor of
+ *              compressed upgrade images and the compressed stream format.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_LZ_H
+#define DFU_LZ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_dfu.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Set to 1 to accept compressed upgrade images */
+#ifndef DFU_LZ
+#define DFU_LZ                      (0)
+#endif
+
+/* Largest match distance the decompressor supports, as a power of two. The
+ * decompressor keeps a window of this size in RAM */
+#ifndef DFU_LZ_WINDOW_BITS
+#define DFU_LZ_WINDOW_BITS          (12u)
+#endif
+
+#if (DFU_LZ_WINDOW_BITS < 8u) || (DFU_LZ_WINDOW_BITS > 12u)
+#error "DFU_LZ_WINDOW_BITS must be 8 to 12"
+#endif
+
+/*
+ * Compressed stream, sent with Program Data in place of the image from the
+ * start of the secondary slot, or carried by a delta image. Header:
+ * [0..3]   magic "DFUZ"
+ * [4]      format version
+ * [5]      window bits used by the compressor, up to DFU_LZ_WINDOW_BITS
+ * [6..7]   reserved, 0
+ * [8..11]  decompressed size, little endian
+ * Body: groups of a flag byte followed by 8 items, the flag bits LSB first.
+ * A clear bit is a literal byte. A set bit is a match of two bytes, little
+ * endian: bits 0-11 are the distance - 1, bits 12-15 the length - 3. A
+ * length field of 15 is followed by bytes added to the length, up to and
+ * including the first byte that is not 255.
+ */
+#define DFU_LZ_MAGIC                (0x5A554644uL)
+#define DFU_LZ_VERSION              (1u)
+#define DFU_LZ_HEADER_SIZE          (12u)
+#define DFU_LZ_MIN_MATCH            (3u)
+#define DFU_LZ_LENGTH_EXT           (15u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Receives decompressed bytes at the given offset of the decompressed data */
+typedef cy_en_dfu_status_t (*dfu_lz_sink_t)(uint32_t offset, const uint8_t *data, uint32_t length);
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+void dfu_lz_reset(void);
+bool dfu_lz_active(void);
+bool dfu_lz_is_stream(const uint8_t *data, uint32_t length);
+cy_en_dfu_status_t dfu_lz_write(uint32_t offset, const uint8_t *data, uint32_t length,
+                                dfu_lz_sink_t sink);
+
+#endif /* DFU_LZ_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,271 @@
+/******************************************************************************
+ * File Name:   dfu_resume.c
+ *
+ * Description: This file contains the resume record of interrupted DFU sessions. While a plain
+ *              upgrade image is written, the number of rows programmed from the start of the
+ *              secondary slot and their CRC-32C are logged to the work flash through the flash
+ *              ring, after the rows they cover. After a reset or a dropped link the host reads
+ *              the record and sends only the rows that follow it.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "boot_crc32c.h"
+#include "dfu_flash.h"
+#include "dfu_resume.h"
+
+#if (DFU_RESUME)
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t offset;
+    uint32_t crc;
+    uint32_t reserved[3];
+    uint32_t check;
+} dfu_resume_entry_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+/* Latest record queued and log entry of the next one */
+static uint32_t resume_sequence = 0u;
+static uint32_t resume_offset = 0u;
+static uint32_t resume_slot = 0u;
+
+/* Progress of the image being received */
+static bool track_valid = false;
+static uint32_t track_offset = 0u;
+static uint32_t track_crc = 0u;
+static uint32_t track_rows = 0u;
+
+/*******************************************************************************
+ * Function Name: dfu_resume_latest
+ ********************************************************************************
+ * Finds the latest valid record of the log in the flash.
+ *
+ * Return:
+ *  Log entry of the record, DFU_RESUME_ENTRIES if there is none.
+ *******************************************************************************/
+static uint32_t dfu_resume_latest(dfu_resume_entry_t *latest) {
+    const uint8_t *log = dfu_flash_port_ptr(DFU_RESUME_ADDR, DFU_RESUME_ENTRIES * DFU_RESUME_ENTRY_SIZE);
+    uint32_t found = DFU_RESUME_ENTRIES;
+
+    for (uint32_t i = 0u; (log != NULL) && (i < DFU_RESUME_ENTRIES); i++) {
+        dfu_resume_entry_t entry;
+
+        memcpy(&entry, &log[i * DFU_RESUME_ENTRY_SIZE], sizeof(entry));
+        if ((entry.magic != DFU_RESUME_MAGIC) ||
+            (entry.check != boot_crc32c(0u, (const uint8_t *)&entry, offsetof(dfu_resume_entry_t, check))) ||
+            ((entry.offset % CY_DFU_ROW_SIZE) != 0u) || (entry.offset > SLOT_SIZE)) {
+            continue;
+        }
+        if ((found == DFU_RESUME_ENTRIES) || ((int32_t)(entry.sequence - latest->sequence) > 0)) {
+            *latest = entry;
+            found = i;
+        }
+    }
+    return found;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_resume_save
+ ********************************************************************************
+ * Queues a record after the rows already queued. The first record of a log
+ * sector erases the sector.
+ *******************************************************************************/
+static void dfu_resume_save(uint32_t offset, uint32_t crc) {
+    dfu_resume_entry_t entry;
+    uint32_t address = DFU_RESUME_ADDR + (resume_slot * DFU_RESUME_ENTRY_SIZE);
+
+    memset(&entry, 0, sizeof(entry));
+    entry.magic = DFU_RESUME_MAGIC;
+    entry.sequence = resume_sequence + 1u;
+    entry.offset = offset;
+    entry.crc = crc;
+    entry.check = boot_crc32c(0u, (const uint8_t *)&entry, offsetof(dfu_resume_entry_t, check));
+
+    if ((address % DFU_RESUME_SECTOR_SIZE) == 0u) {
+        dfu_flash_queue_record(address, NULL, 0u, true);
+    }
+    dfu_flash_queue_record(address, (const uint8_t *)&entry, DFU_RESUME_ENTRY_SIZE, false);
+
+    resume_sequence = entry.sequence;
+    resume_offset = offset;
+    resume_slot = (resume_slot + 1u) % DFU_RESUME_ENTRIES;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_resume_load
+ ********************************************************************************
+ * Reads the latest record from the work flash and continues the progress of
+ * the image it covers. Call after a reset, once the flash writer is
+ * initialized.
+ *******************************************************************************/
+void dfu_resume_load(void) {
+    dfu_resume_entry_t latest;
+    uint32_t found = dfu_resume_latest(&latest);
+    const uint8_t *next;
+
+    resume_sequence = 0u;
+    resume_offset = 0u;
+    resume_slot = 0u;
+    track_valid = true;
+    track_offset = 0u;
+    track_crc = 0u;
+    track_rows = 0u;
+    if (found == DFU_RESUME_ENTRIES) {
+        return;
+    }
+
+    resume_sequence = latest.sequence;
+    resume_offset = latest.offset;
+    resume_slot = (found + 1u) % DFU_RESUME_ENTRIES;
+    track_offset = latest.offset;
+    track_crc = latest.crc;
+
+    /* An entry torn by a reset is skipped along with the rest of its sector */
+    next = dfu_flash_port_ptr(DFU_RESUME_ADDR + (resume_slot * DFU_RESUME_ENTRY_SIZE), DFU_RESUME_ENTRY_SIZE);
+    for (uint32_t i = 0u; (next != NULL) && (i < DFU_RESUME_ENTRY_SIZE); i++) {
+        if (next[i] != DFU_FLASH_ERASED_VALUE) {
+            uint32_t per_sector = DFU_RESUME_SECTOR_SIZE / DFU_RESUME_ENTRY_SIZE;
+
+            resume_slot = (((resume_slot / per_sector) + 1u) * per_sector) % DFU_RESUME_ENTRIES;
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dfu_resume_start
+ ********************************************************************************
+ * Starts a new image: the record is reset before the first row is queued, so
+ * that a record never covers rows of another image.
+ *******************************************************************************/
+void dfu_resume_start(void) {
+    if (resume_offset != 0u) {
+        dfu_resume_save(0u, 0u);
+    }
+    track_valid = true;
+    track_offset = 0u;
+    track_crc = 0u;
+    track_rows = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_resume_track
+ ********************************************************************************
+ * Accounts for a row of a plain image queued at the given offset of the
+ * secondary slot, and queues a record every DFU_RESUME_INTERVAL rows. A row
+ * before the progress, as the rows sent again after a resume, is ignored;
+ * a row after it stops the progress until the next image.
+ *******************************************************************************/
+void dfu_resume_track(uint32_t offset, const uint8_t *data, uint32_t length) {
+    if (!track_valid || (offset + length <= track_offset)) {
+        return;
+    }
+    if ((offset != track_offset) || (length != CY_DFU_ROW_SIZE)) {
+        track_valid = false;
+        return;
+    }
+    track_crc = boot_crc32c(track_crc, data, length);
+    track_offset += length;
+    if (++track_rows >= DFU_RESUME_INTERVAL) {
+        track_rows = 0u;
+        dfu_resume_save(track_offset, track_crc);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dfu_resume_stop
+ ********************************************************************************
+ * Stops the progress, for an image that cannot be resumed.
+ *******************************************************************************/
+void dfu_resume_stop(void) {
+    track_valid = false;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_resume_clear
+ ********************************************************************************
+ * Resets the record once the image is complete.
+ *******************************************************************************/
+void dfu_resume_clear(void) {
+    if (resume_offset != 0u) {
+        dfu_resume_save(0u, 0u);
+    }
+    track_valid = false;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_resume_is_metadata
+ ********************************************************************************
+ * Return:
+ *  true if the range is within the metadata read with Get Metadata.
+ *******************************************************************************/
+bool dfu_resume_is_metadata(uint32_t address, uint32_t length) {
+    return (address >= DFU_RESUME_ADDR) && (length <= DFU_RESUME_METADATA_SIZE) &&
+           (address - DFU_RESUME_ADDR <= DFU_RESUME_METADATA_SIZE - length);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_resume_metadata
+ ********************************************************************************
+ * Reads the metadata: the offset and the CRC-32C of the latest record in the
+ * flash, little endian. Zero if there is no record.
+ *
+ * Parameters:
+ *  address, length  Range, see dfu_resume_is_metadata().
+ *  data             Receives the bytes.
+ *******************************************************************************/
+void dfu_resume_metadata(uint32_t address, uint8_t *data, uint32_t length) {
+    dfu_resume_entry_t latest;
+    uint8_t metadata[DFU_RESUME_METADATA_SIZE] = { 0u };
+
+    if (dfu_resume_latest(&latest) != DFU_RESUME_ENTRIES) {
+        for (uint32_t i = 0u; i < 4u; i++) {
+            metadata[i] = (uint8_t)(latest.offset >> (8u * i));
+            metadata[4u + i] = (uint8_t)(latest.crc >> (8u * i));
+        }
+    }
+    memcpy(data, &metadata[address - DFU_RESUME_ADDR], length);
+}
+#endif /* DFU_RESUME */
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * File Name:   dfu_resume.h
+ *
+ * Description: This file contains the declarations of the resume record of interrupted DFU
+ *              sessions and its format in the work flash.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_RESUME_H
+#define DFU_RESUME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_dfu.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Set to 1 to record the progress of a plain upgrade image, so that the host
+ * resumes an interrupted session instead of starting it again */
+#ifndef DFU_RESUME
+#define DFU_RESUME                  (0)
+#endif
+
+/* Start of the record log, DFU_RESUME_SECTORS small sectors of the work
+ * flash. The default is the top of the small sectors, clear of the MCUboot
+ * swap status area at their start */
+#ifndef DFU_RESUME_ADDR
+#define DFU_RESUME_ADDR             (0x1403FE00uL)
+#endif
+
+#ifndef DFU_RESUME_SECTORS
+#define DFU_RESUME_SECTORS          (4u)
+#endif
+
+/* Rows programmed between two records */
+#ifndef DFU_RESUME_INTERVAL
+#define DFU_RESUME_INTERVAL         (8u)
+#endif
+
+#define DFU_RESUME_SECTOR_SIZE      (0x80u)
+#define DFU_RESUME_ENTRY_SIZE       (32u)
+#define DFU_RESUME_ENTRIES          ((DFU_RESUME_SECTORS * DFU_RESUME_SECTOR_SIZE) / DFU_RESUME_ENTRY_SIZE)
+
+/*
+ * Record, one work flash program unit. The log is written in order and
+ * wraps around, the valid record with the highest sequence number is the
+ * latest:
+ * [0..3]   magic "RESM"
+ * [4..7]   sequence number
+ * [8..11]  bytes of the image programmed from the start of the secondary
+ *          slot, a multiple of CY_DFU_ROW_SIZE
+ * [12..15] CRC-32C of these bytes
+ * [16..27] reserved, 0
+ * [28..31] CRC-32C of bytes 0 to 27
+ * The host reads bytes 8 to 15 of the latest record with Get Metadata at
+ * DFU_RESUME_ADDR.
+ */
+#define DFU_RESUME_MAGIC            (0x4D534552uL)
+#define DFU_RESUME_METADATA_SIZE    (8u)
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+void dfu_resume_load(void);
+void dfu_resume_start(void);
+void dfu_resume_track(uint32_t offset, const uint8_t *data, uint32_t length);
+void dfu_resume_stop(void);
+void dfu_resume_clear(void);
+bool dfu_resume_is_metadata(uint32_t address, uint32_t length);
+void dfu_resume_metadata(uint32_t address, uint8_t *data, uint32_t length);
+
+#endif /* DFU_RESUME_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,378 @@
+/******************************************************************************
+ * File Name:   dfu_session.c
+ *
+ * Description: This file contains the DFU session state machine of the DFU
+ *              application. It is kept free of HAL calls so that the same
+ *              code runs on the target and in the host simulator.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdio.h>
+#include "dfu_flash.h"
+#include "dfu_image.h"
+#include "dfu_resume.h"
+#include "dfu_session.h"
+#include "dfu_window.h"
+#include "dlog.h"
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static uint32_t get_counter_timeout(uint32_t seconds, uint32_t timeout);
+static cy_en_dfu_status_t session_validate(dfu_session_t *session);
+static cy_en_dfu_status_t session_wait_command(dfu_session_t *session);
+static void session_rearm(dfu_session_t *session);
+
+/*******************************************************************************
+ * Function Name: dfu_session_init
+ ********************************************************************************
+ * Initializes the DFU session context and the DFU middleware.
+ *
+ * Parameters:
+ *  session        DFU session context.
+ *  params         DFU parameters, buffers and timeout already set. The
+ *                 event-driven mode lowers the timeout to
+ *                 DFU_SESSION_EVENT_TIMEOUT_MS.
+ *  ops            Platform services.
+ *
+ * Return:
+ *  Status of Cy_DFU_Init().
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_session_init(dfu_session_t *session, cy_stc_dfu_params_t *params,
+                                    const dfu_session_ops_t *ops) {
+    session->ops = ops;
+    session->params = params;
+    session->state = CY_DFU_STATE_NONE;
+    session->count = 0u;
+    session->event_driven = (ops->get_tick_ms != NULL) && (ops->wait_event != NULL);
+    if (session->event_driven) {
+        session->command_tick_ms = ops->get_tick_ms();
+        session->led_tick_ms = session->command_tick_ms + LED_TOGGLE_INTERVAL_MS;
+        params->timeout = DFU_SESSION_EVENT_TIMEOUT_MS;
+    }
+    session->status = Cy_DFU_Init(&session->state, params);
+
+    return session->status;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_session_step
+ ********************************************************************************
+ * Runs one iteration of the DFU loop: waits up to DFU_SESSION_TIMEOUT_MS for
+ * the next host command and handles the resulting DFU state.
+ * 1. If the updated applications have been received and validated, hand the
+ *    control over to the bootloader.
+ * 2. If the loading failed or no command was received within
+ *    DFU_COMMAND_TIMEOUT_MS, restart the DFU.
+ * 3. Toggle the user LED once per LED_TOGGLE_INTERVAL_MS.
+ *
+ * In the event-driven mode the iteration sleeps until the transport receives
+ * data or the next timeout is due, and the timeouts are taken from the tick
+ * instead of the iteration count.
+ *
+ * Parameters:
+ *  session        DFU session context.
+ *******************************************************************************/
+void dfu_session_step(dfu_session_t *session) {
+    cy_en_dfu_status_t status;
+    bool time_out;
+    bool led_due;
+
+    if (session->event_driven) {
+        uint32_t now;
+
+        status = session_wait_command(session);
+        now = session->ops->get_tick_ms();
+        time_out = ((now - session->command_tick_ms) >= DFU_COMMAND_TIMEOUT_MS);
+        led_due = ((int32_t)(now - session->led_tick_ms) >= 0);
+        if (led_due) {
+            session->led_tick_ms = now + LED_TOGGLE_INTERVAL_MS;
+        }
+    } else {
+        status = Cy_DFU_Continue(&session->state, session->params);
+        ++session->count;
+        /*
+         * The DFU_SESSION_TIMEOUT_MS variable is equal to the time DFU waits for the
+         * next Host command.
+         */
+        time_out = (session->count >= (DFU_COMMAND_TIMEOUT_MS / DFU_SESSION_TIMEOUT_MS));
+        led_due = false;
+    }
+    session->status = status;
+
+    /* Keep the flash programming the rows received so far, and acknowledge
+     * the last one once it is programmed */
+    dfu_flash_service();
+    dfu_window_service();
+
+    if (session->state == CY_DFU_STATE_FINISHED) {
+        /*
+         * Finished loading the application images
+         * Validate every image written in the session, the application of
+         * image i has the ID i + 1. Stop transporting if they are valid.
+         * NOTE Cy_DFU_ValidateApp should be implemented on the application level
+         */
+        status = dfu_flash_flush();
+        if (status == CY_DFU_SUCCESS) {
+            status = session_validate(session);
+        } else {
+            status = CY_DFU_ERROR_VERIFY;
+        }
+        if (status == CY_DFU_SUCCESS) {
+#if (DFU_RESUME)
+            /* Nothing to resume once the image is complete */
+            dfu_resume_clear();
+            (void)dfu_flash_flush();
+#endif /* DFU_RESUME */
+            DLOG_PRINTF("[DFU App] Successfully downloaded the upgrade images and placed them into the secondary slots\r\n");
+            DLOG_PRINTF("[DFU App] Reset the device to switch the control to the edge protect bootloader\r\n");
+            session->ops->delay_ms(50);
+            session->ops->reset();
+        } else if (status == CY_DFU_ERROR_VERIFY) {
+            /*
+             * Restarts loading, the alternatives to Halt MCU are here
+             * or switch to the other app if it is valid.
+             * Error code can be handled here, which means print to debug UART.
+             */
+            DLOG_PRINTF("[DFU App] Upgrade image verification failed\r\n");
+            status = dfu_session_restart(session);
+        }
+    } else if (session->state == CY_DFU_STATE_FAILED) {
+        /*
+         * An error occurred during the loading process.
+         * Handle it here. This code just restarts the loading process.
+         */
+        DLOG_PRINTF("[DFU App] An error occurred during the loading process\r\n");
+        status = dfu_session_restart(session);
+    } else if (session->state == CY_DFU_STATE_UPDATING) {
+        /*
+         * if no command was received within few seconds after the loading
+         * started, restart loading.
+         */
+        if (status == CY_DFU_SUCCESS) {
+            session_rearm(session);
+        } else if (status == CY_DFU_ERROR_TIMEOUT) {
+            if (time_out) {
+                session_rearm(session);
+                dfu_session_restart(session);
+            }
+        } else {
+#if defined COMPONENT_DFU_UART
+            /*
+             * DFU updating status is unknown,
+             * Delay because Transport still may be sending an error or success response to the host.
+             * Reset the device, to give a control to edge protect bootloader.
+             * To validate the downloaded image
+             */
+            DLOG_PRINTF("[DFU App] DFU updating status is unknown \r\n");
+            DLOG_PRINTF("[DFU App] Reset the device to switch the control to the edge protect bootloader\r\n");
+            DLOG_PRINTF("[DFU App] To vaild the upgrade image\r\n");
+            session->ops->delay_ms(50);
+            session->ops->reset();
+#else
+            session_rearm(session);
+            /* Delay because Transport still may be sending an error response to the host. */
+            session->ops->delay_ms(50);
+            dfu_session_restart(session);
+#endif
+        }
+    }
+    /* Blink once per seconds approximately */
+    if (!session->event_driven) {
+        led_due = ((session->count % get_counter_timeout(LED_TOGGLE_INTERVAL_MS, DFU_SESSION_TIMEOUT_MS)) == 0u);
+    }
+    if (led_due) {
+        /* Invert the USER LED state */
+        session->ops->led_toggle();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dfu_session_restart
+ ********************************************************************************
+ * This function re-initializes the DFU and resets the DFU transport.
+ *
+ * Parameters:
+ *  session        DFU session context.
+ *
+ * Return:
+ *  Status of operation.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_session_restart(dfu_session_t *session) {
+    cy_en_dfu_status_t status = CY_DFU_SUCCESS;
+
+    if (!session || !session->params) {
+        status = CY_DFU_ERROR_UNKNOWN;
+    }
+
+    /* Restart DFU process, after the rows already received are programmed.
+     * With DFU_RESUME the host may continue after the latest record */
+    if (status == CY_DFU_SUCCESS) {
+        (void)dfu_flash_flush();
+        dfu_flash_images_reset();
+        status = Cy_DFU_Init(&session->state, session->params);
+        if (status == CY_DFU_SUCCESS) {
+            Cy_DFU_TransportReset();
+        }
+    }
+    DLOG_PRINTF("[DFU App] Restarted the DFU\r\n");
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: session_validate
+ ********************************************************************************
+ * Validates the images written since the DFU started, image 1 if none was.
+ *
+ * Parameters:
+ *  session        DFU session context.
+ *
+ * Return:
+ *  CY_DFU_SUCCESS if all of them are valid, else the first failing status.
+ *******************************************************************************/
+static cy_en_dfu_status_t session_validate(dfu_session_t *session) {
+    uint32_t images = dfu_flash_images();
+    cy_en_dfu_status_t status = CY_DFU_SUCCESS;
+
+    if (images == 0u) {
+        images = 1u << (USER_APP_ID - 1u);
+    }
+    for (uint32_t i = 0u; (i < DFU_IMAGE_COUNT) && (status == CY_DFU_SUCCESS); i++) {
+        if ((images & (1uL << i)) != 0u) {
+            status = Cy_DFU_ValidateApp(i + 1u, session->params);
+        }
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: session_wait_command
+ ********************************************************************************
+ * Event-driven mode: sleeps until the transport receives data or the next
+ * LED toggle or command timeout is due, then handles the received command.
+ * Cy_DFU_Continue() is called only when data arrived. While progress records
+ * are being programmed it wakes up every DFU_FLASH_SERVICE_MS.
+ *
+ * Parameters:
+ *  session        DFU session context.
+ *
+ * Return:
+ *  Status of Cy_DFU_Continue(), CY_DFU_ERROR_TIMEOUT if no data arrived.
+ *******************************************************************************/
+static cy_en_dfu_status_t session_wait_command(dfu_session_t *session) {
+    uint32_t now = session->ops->get_tick_ms();
+    uint32_t deadline = session->led_tick_ms;
+    uint32_t timeout_ms = 0u;
+
+    if (session->state == CY_DFU_STATE_UPDATING) {
+        uint32_t command_deadline = session->command_tick_ms + DFU_COMMAND_TIMEOUT_MS;
+
+        if ((int32_t)(command_deadline - deadline) < 0) {
+            deadline = command_deadline;
+        }
+    }
+    if ((int32_t)(deadline - now) > 0) {
+        timeout_ms = deadline - now;
+    }
+    if (dfu_flash_pending() && (timeout_ms > DFU_FLASH_SERVICE_MS)) {
+        timeout_ms = DFU_FLASH_SERVICE_MS;
+    }
+    /* The window layer may already hold the next command, or a response that
+     * waits for the flash */
+    if ((!dfu_window_ready()) && (!session->ops->wait_event(timeout_ms))) {
+        return CY_DFU_ERROR_TIMEOUT;
+    }
+    return Cy_DFU_Continue(&session->state, session->params);
+}
+
+/*******************************************************************************
+ * Function Name: session_rearm
+ ********************************************************************************
+ * Restarts the command timeout.
+ *
+ * Parameters:
+ *  session        DFU session context.
+ *******************************************************************************/
+static void session_rearm(dfu_session_t *session) {
+    session->count = 0u;
+    if (session->event_driven) {
+        session->command_tick_ms = session->ops->get_tick_ms();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: get_counter_timeout
+ ********************************************************************************
+ * Returns number of counts that correspond to number of seconds passed as
+ * a parameter.
+ * E.g. comparing counter with 300 seconds is like this.
+ * ---
+ * uint32_t counter = 0u;
+ * for (;;)
+ * {
+ *     Cy_SysLib_Delay(UART_TIMEOUT);
+ *     ++count;
+ *     if (count >= get_counter_timeout(seconds: 300u, timeout: UART_TIMEOUT))
+ *     {
+ *         count = 0u;
+ *         DoSomething();
+ *     }
+ * }
+ * ---
+ *
+ * Both parameters are required to be compile time constants,
+ * so this function gets optimized out to single constant value.
+ *
+ * Parameters:
+ *  seconds    Number of seconds to pass. Must be less that 4_294_967 seconds.
+ *  timeout    Timeout for Cy_DFU_Continue() function, in milliseconds.
+ *             Must be greater than zero.
+ *             It is recommended to be a value that produces no reminder
+ *             for this function to be precise.
+ * Return:
+ *  See description.
+ *******************************************************************************/
+static uint32_t get_counter_timeout(uint32_t seconds, uint32_t timeout) {
+    uint32_t count = 1;
+
+    if (timeout != 0) {
+        count = ((seconds) / timeout);
+    }
+
+    return count;
+}
+
+/* [] END OF FILE */
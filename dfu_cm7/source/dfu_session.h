@@ -0,0 +1,125 @@
+/******************************************************************************
+ * File Name:   dfu_session.h
+ *
+ * Description: This file contains the declarations of the DFU session state
+ *              machine that drives Cy_DFU_Continue() for the DFU application.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_SESSION_H
+#define DFU_SESSION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_dfu.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Timeout for Cy_DFU_Continue(), in milliseconds */
+#define DFU_SESSION_TIMEOUT_MS      (20u)
+
+/* Timeout for Cy_DFU_Continue() in the event-driven mode, which calls it only
+ * once the transport has received data. The rest of a longer command wakes
+ * the session up again */
+#define DFU_SESSION_EVENT_TIMEOUT_MS    (2u)
+
+/* Application ID of the DFU application, image 1. Image 2, run by CM7_1,
+ * has the application ID 2 */
+#define USER_APP_ID                 (1u)
+
+/* DFU command timeout */
+#define DFU_COMMAND_TIMEOUT_MS      (5000u)
+
+/* Interval for LED toggle */
+#define LED_TOGGLE_INTERVAL_MS      (1000u)
+
+/* Set to 1 to sleep until the DFU transport receives data instead of polling
+ * Cy_DFU_Continue() every DFU_SESSION_TIMEOUT_MS */
+#ifndef DFU_EVENT_DRIVEN
+#define DFU_EVENT_DRIVEN            (0)
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Platform services used by the DFU session. The target implementation is
+ * provided by main.c, the host simulator provides its own. */
+typedef struct {
+    /* Invert the state of the user LED */
+    void (*led_toggle)(void);
+    /* Blocking delay, in milliseconds */
+    void (*delay_ms)(uint32_t milliseconds);
+    /* Hand the control over to the bootloader, does not return on target */
+    void (*reset)(void);
+    /* Optional. Free running millisecond tick */
+    uint32_t (*get_tick_ms)(void);
+    /* Optional. Sleeps until the DFU transport receives data or timeout_ms
+     * elapses. Returns true if the transport received data since the last
+     * call, as its interrupt reports it. The session is event-driven when
+     * both get_tick_ms and wait_event are provided, and then sets the
+     * timeout of Cy_DFU_Continue() to DFU_SESSION_EVENT_TIMEOUT_MS */
+    bool (*wait_event)(uint32_t timeout_ms);
+} dfu_session_ops_t;
+
+/* DFU session context */
+typedef struct {
+    const dfu_session_ops_t *ops;
+    cy_stc_dfu_params_t *params;
+    /* One of CY_DFU_STATE_NONE/UPDATING/FINISHED/FAILED */
+    uint32_t state;
+    /* Number of Cy_DFU_Continue() calls since the last command */
+    uint32_t count;
+    /* Event-driven mode, see dfu_session_ops_t */
+    bool event_driven;
+    /* Event-driven mode: tick of the last command and of the next LED toggle */
+    uint32_t command_tick_ms;
+    uint32_t led_tick_ms;
+    /* Status of the last Cy_DFU_Continue() call */
+    cy_en_dfu_status_t status;
+} dfu_session_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+cy_en_dfu_status_t dfu_session_init(dfu_session_t *session, cy_stc_dfu_params_t *params,
+                                    const dfu_session_ops_t *ops);
+void dfu_session_step(dfu_session_t *session);
+cy_en_dfu_status_t dfu_session_restart(dfu_session_t *session);
+
+#endif /* DFU_SESSION_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,455 @@
+/******************************************************************************
+ * File Name:   dfu_window.c
+ *
+ * Description: This file contains the sliding window layer of the DFU transport. The
+ *              host keeps several commands in flight; the layer buffers commands that
+ *              arrive out of order, hands them to the DFU middleware in sequence and
+ *              acknowledges them cumulatively and selectively. The response of a
+ *              command that queued flash operations is held back until they are
+ *              done, while the next commands are received.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "dfu_flash.h"
+#include "dfu_window.h"
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Command received ahead of the expected one */
+typedef struct {
+    bool valid;
+    uint32_t length;
+    uint8_t packet[CY_DFU_SIZEOF_CMD_BUFFER];
+} dfu_window_slot_t;
+
+/* Response kept for a retransmitted command */
+typedef struct {
+    bool valid;
+    uint8_t seq;
+    uint32_t length;
+    uint8_t packet[DFU_WINDOW_RSP_CACHE_SIZE];
+} dfu_window_rsp_t;
+
+/* Response held back until the flash operations of its command are done */
+typedef struct {
+    bool valid;
+    uint8_t seq;
+    /* dfu_flash_mark() and dfu_flash_failures() when the command started */
+    uint32_t mark;
+    uint32_t failures;
+    uint32_t timeout;
+    uint32_t length;
+    uint8_t packet[DFU_WINDOW_RSP_CACHE_SIZE];
+} dfu_window_held_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+/* Window size, 0 passes the packets through unchanged */
+static uint32_t window_size = 0u;
+
+/* Sequence number expected next, and of the command being handled */
+static uint8_t window_expected = 0u;
+static uint8_t window_current = 0u;
+
+/* Sequence number after the last command answered */
+static uint8_t window_acked = 0u;
+
+/* Flash mark and failure count at the last response */
+static uint32_t window_mark = 0u;
+static uint32_t window_failures = 0u;
+
+static dfu_window_held_t window_held;
+
+static dfu_window_slot_t window_slots[DFU_WINDOW_SIZE];
+static dfu_window_rsp_t window_rsp[DFU_WINDOW_SIZE];
+static uint8_t window_frame[DFU_WINDOW_FRAME_SIZE];
+
+/*******************************************************************************
+ * Function Name: dfu_window_reset
+ ********************************************************************************
+ * Forgets all commands and responses, the host restarts at sequence 0.
+ *******************************************************************************/
+static void dfu_window_reset(void) {
+    window_expected = 0u;
+    window_current = 0u;
+    window_acked = 0u;
+    window_mark = dfu_flash_mark();
+    window_failures = dfu_flash_failures();
+    memset(window_slots, 0, sizeof(window_slots));
+    memset(window_rsp, 0, sizeof(window_rsp));
+    memset(&window_held, 0, sizeof(window_held));
+}
+
+/*******************************************************************************
+ * Function Name: dfu_window_init
+ ********************************************************************************
+ * Enables the window layer.
+ *
+ * Parameters:
+ *  size           Window size, up to DFU_WINDOW_SIZE. 0 passes the DFU packets
+ *                 through unchanged (stop-and-wait).
+ *******************************************************************************/
+void dfu_window_init(uint32_t size) {
+    window_size = (size > DFU_WINDOW_SIZE) ? DFU_WINDOW_SIZE : size;
+    dfu_window_reset();
+}
+
+/*******************************************************************************
+ * Function Name: dfu_window_ready
+ ********************************************************************************
+ * Return:
+ *  true if the next command has already been received, or a response waits
+ *  for the flash, so that the DFU session must not wait for the transport.
+ *******************************************************************************/
+bool dfu_window_ready(void) {
+    return (window_size != 0u) && (window_slots[window_expected % DFU_WINDOW_SIZE].valid || window_held.valid);
+}
+
+#if (DFU_WINDOW)
+/*******************************************************************************
+ * Physical transport, the DFU middleware transport renamed by the linker
+ ********************************************************************************/
+cy_en_dfu_status_t __real_Cy_DFU_TransportRead(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                               uint32_t timeout);
+cy_en_dfu_status_t __real_Cy_DFU_TransportWrite(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                                uint32_t timeout);
+void __real_Cy_DFU_TransportReset(void);
+
+/*******************************************************************************
+ * Function Name: dfu_window_header
+ ********************************************************************************
+ * Fills in a frame header with the current acknowledgement state. The
+ * cumulative ack stops at a held response, the commands handled after it are
+ * reported as received only along with a gap.
+ *******************************************************************************/
+static void dfu_window_header(uint8_t *frame, uint8_t type, uint8_t seq) {
+    uint8_t ack = window_held.valid ? window_held.seq : window_acked;
+    uint8_t handled = (uint8_t)(window_expected - ack);
+    uint32_t sack = 0u;
+
+    for (uint32_t i = 0u; (i + 1u < window_size) && (i < DFU_WINDOW_SACK_BITS); i++) {
+        uint8_t next = (uint8_t)(ack + 1u + i);
+
+        if (((i + 1u) >= handled) && window_slots[next % DFU_WINDOW_SIZE].valid) {
+            sack |= (1uL << i);
+        }
+    }
+    for (uint32_t i = 0u; (sack != 0u) && (i + 1u < handled) && (i < DFU_WINDOW_SACK_BITS); i++) {
+        sack |= (1uL << i);
+    }
+    frame[0] = type;
+    frame[1] = seq;
+    frame[2] = ack;
+    frame[3] = (uint8_t)sack;
+    frame[4] = (uint8_t)(sack >> 8);
+    frame[5] = (uint8_t)(sack >> 16);
+    frame[6] = (uint8_t)(sack >> 24);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_window_send_ack
+ ********************************************************************************
+ * Tells the host which commands arrived, so that it retransmits only the
+ * missing ones.
+ *******************************************************************************/
+static void dfu_window_send_ack(uint32_t timeout) {
+    uint8_t frame[DFU_WINDOW_HEADER_SIZE];
+    uint32_t count;
+
+    dfu_window_header(frame, DFU_WINDOW_FRAME_ACK, window_expected);
+    (void)__real_Cy_DFU_TransportWrite(frame, sizeof(frame), &count, timeout);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_window_fail
+ ********************************************************************************
+ * Turns a success response into CY_DFU_ERROR_UNKNOWN, for a command whose
+ * flash operations failed after it returned. The packet checksum is the
+ * 16-bit sum of the DFU middleware, it changes by the difference.
+ *******************************************************************************/
+static void dfu_window_fail(uint8_t *packet, uint32_t size) {
+    uint16_t checksum;
+
+    if ((size < CY_DFU_PACKET_OVERHEAD) || (packet[1] != (uint8_t)CY_DFU_SUCCESS)) {
+        return;
+    }
+    checksum = (uint16_t)(packet[size - 3u] | (packet[size - 2u] << 8));
+    checksum = (uint16_t)(checksum + (uint8_t)CY_DFU_SUCCESS - (uint8_t)CY_DFU_ERROR_UNKNOWN);
+    packet[1] = (uint8_t)CY_DFU_ERROR_UNKNOWN;
+    packet[size - 3u] = (uint8_t)checksum;
+    packet[size - 2u] = (uint8_t)(checksum >> 8);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_window_send
+ ********************************************************************************
+ * Sends the response of a command with the acknowledgement state and keeps it
+ * for a retransmitted command.
+ *******************************************************************************/
+static cy_en_dfu_status_t dfu_window_send(uint8_t seq, const uint8_t *packet, uint32_t size, bool failed,
+                                          uint32_t timeout) {
+    dfu_window_rsp_t *rsp = &window_rsp[seq % DFU_WINDOW_SIZE];
+    uint8_t *body = &window_frame[DFU_WINDOW_HEADER_SIZE];
+    uint32_t sent = 0u;
+
+    if ((uint8_t)(seq - window_acked) < 0x80u) {
+        window_acked = (uint8_t)(seq + 1u);
+    }
+    dfu_window_header(window_frame, DFU_WINDOW_FRAME_DATA, seq);
+    memcpy(body, packet, size);
+    if (failed) {
+        dfu_window_fail(body, size);
+    }
+    size += DFU_WINDOW_HEADER_SIZE;
+
+    rsp->valid = (size <= sizeof(rsp->packet));
+    if (rsp->valid) {
+        rsp->seq = seq;
+        rsp->length = size;
+        memcpy(rsp->packet, window_frame, size);
+    }
+    return __real_Cy_DFU_TransportWrite(window_frame, size, &sent, timeout);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_window_release
+ ********************************************************************************
+ * Sends the held response once the flash operations of its command are done.
+ *******************************************************************************/
+static void dfu_window_release(void) {
+    while (!dfu_flash_reached(window_held.mark)) {
+        dfu_flash_service();
+    }
+    window_held.valid = false;
+    (void)dfu_window_send(window_held.seq, window_held.packet, window_held.length,
+                          (dfu_flash_failures() != window_held.failures), window_held.timeout);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_window_read
+ ********************************************************************************
+ * Reads a frame from the transport. While a response is held the transport is
+ * polled without waiting and the flash serviced, so that the response goes
+ * out as soon as the flash is done. The read then times out and the DFU
+ * session waits for the next command.
+ *******************************************************************************/
+static cy_en_dfu_status_t dfu_window_read(uint32_t *length, uint32_t timeout) {
+    cy_en_dfu_status_t status;
+
+    if (!window_held.valid) {
+        return __real_Cy_DFU_TransportRead(window_frame, sizeof(window_frame), length, timeout);
+    }
+    for (;;) {
+        status = __real_Cy_DFU_TransportRead(window_frame, sizeof(window_frame), length, 0u);
+        if ((status != CY_DFU_ERROR_TIMEOUT) || !window_held.valid) {
+            return status;
+        }
+        dfu_flash_service();
+        dfu_window_service();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dfu_window_deliver
+ ********************************************************************************
+ * Hands the expected command to the DFU middleware.
+ *******************************************************************************/
+static cy_en_dfu_status_t dfu_window_deliver(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                             const uint8_t *packet, uint32_t length) {
+    if (length > size) {
+        return CY_DFU_ERROR_LENGTH;
+    }
+    memcpy(buffer, packet, length);
+    *count = length;
+    window_current = window_expected;
+    window_expected++;
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: __wrap_Cy_DFU_TransportRead
+ ********************************************************************************
+ * Returns the next command in sequence. Commands received ahead of it are
+ * buffered, retransmitted commands that were already handled are answered
+ * from the response cache.
+ *******************************************************************************/
+cy_en_dfu_status_t __wrap_Cy_DFU_TransportRead(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                               uint32_t timeout) {
+    dfu_window_slot_t *slot;
+    cy_en_dfu_status_t status;
+
+    if (window_size == 0u) {
+        return __real_Cy_DFU_TransportRead(buffer, size, count, timeout);
+    }
+
+    for (;;) {
+        uint32_t length = 0u;
+        uint8_t offset;
+
+        slot = &window_slots[window_expected % DFU_WINDOW_SIZE];
+        if (slot->valid) {
+            slot->valid = false;
+            return dfu_window_deliver(buffer, size, count, slot->packet, slot->length);
+        }
+
+        status = dfu_window_read(&length, timeout);
+        if (status != CY_DFU_SUCCESS) {
+            *count = 0u;
+            return status;
+        }
+        if ((length <= DFU_WINDOW_HEADER_SIZE) || (window_frame[0] != DFU_WINDOW_FRAME_DATA)) {
+            continue;
+        }
+
+        offset = (uint8_t)(window_frame[1] - window_expected);
+        length -= DFU_WINDOW_HEADER_SIZE;
+        if (offset == 0u) {
+            return dfu_window_deliver(buffer, size, count, &window_frame[DFU_WINDOW_HEADER_SIZE], length);
+        }
+        if (offset < window_size) {
+            /* Ahead of a missing command, keep it and report the gap */
+            slot = &window_slots[window_frame[1] % DFU_WINDOW_SIZE];
+            if ((!slot->valid) && (length <= sizeof(slot->packet))) {
+                memcpy(slot->packet, &window_frame[DFU_WINDOW_HEADER_SIZE], length);
+                slot->length = length;
+                slot->valid = true;
+            }
+            dfu_window_send_ack(timeout);
+        } else {
+            /* Already handled, the host missed the response */
+            dfu_window_rsp_t *rsp = &window_rsp[window_frame[1] % DFU_WINDOW_SIZE];
+
+            if (rsp->valid && (rsp->seq == window_frame[1])) {
+                /* With the acknowledgement state of now, which may have moved
+                 * past a held response since */
+                dfu_window_header(rsp->packet, DFU_WINDOW_FRAME_DATA, rsp->seq);
+                (void)__real_Cy_DFU_TransportWrite(rsp->packet, rsp->length, &length, timeout);
+            } else {
+                dfu_window_send_ack(timeout);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: __wrap_Cy_DFU_TransportWrite
+ ********************************************************************************
+ * Sends the response of the current command with the acknowledgement state.
+ * If the command queued flash operations, the response is held back until
+ * they are done: one response at a time, so that the flash programs a row
+ * while the commands of the next one are received. Stop-and-wait sends the
+ * response once the flash is done.
+ *******************************************************************************/
+cy_en_dfu_status_t __wrap_Cy_DFU_TransportWrite(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                                uint32_t timeout) {
+    uint32_t mark = dfu_flash_mark();
+    uint32_t failures = window_failures;
+    bool queued = (mark != window_mark);
+    cy_en_dfu_status_t status;
+
+    window_mark = mark;
+    window_failures = dfu_flash_failures();
+    if (window_size == 0u) {
+        while (!dfu_flash_reached(mark)) {
+            dfu_flash_service();
+        }
+        if (dfu_flash_failures() != failures) {
+            dfu_window_fail(buffer, size);
+        }
+        return __real_Cy_DFU_TransportWrite(buffer, size, count, timeout);
+    }
+    if (size + DFU_WINDOW_HEADER_SIZE > sizeof(window_frame)) {
+        return CY_DFU_ERROR_LENGTH;
+    }
+
+    dfu_window_service();
+    if (queued && window_held.valid) {
+        dfu_window_release();
+    }
+    if (queued && !dfu_flash_reached(mark) && (size <= sizeof(window_held.packet))) {
+        /* Not answered yet, a retransmission gets an ack */
+        window_rsp[window_current % DFU_WINDOW_SIZE].valid = false;
+        window_held.valid = true;
+        window_held.seq = window_current;
+        window_held.mark = mark;
+        window_held.failures = failures;
+        window_held.timeout = timeout;
+        window_held.length = size;
+        memcpy(window_held.packet, buffer, size);
+        *count = size;
+        return CY_DFU_SUCCESS;
+    }
+    /* A response too long to hold, or one that does not depend on the flash */
+    while (queued && !dfu_flash_reached(mark)) {
+        dfu_flash_service();
+    }
+
+    status = dfu_window_send(window_current, buffer, size, queued && (dfu_flash_failures() != failures), timeout);
+    *count = (status == CY_DFU_SUCCESS) ? size : 0u;
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: __wrap_Cy_DFU_TransportReset
+ ********************************************************************************
+ * Resets the window together with the transport.
+ *******************************************************************************/
+void __wrap_Cy_DFU_TransportReset(void) {
+    if (window_size != 0u) {
+        dfu_window_reset();
+    }
+    __real_Cy_DFU_TransportReset();
+}
+#endif /* DFU_WINDOW */
+
+/*******************************************************************************
+ * Function Name: dfu_window_service
+ ********************************************************************************
+ * Sends the held response if the flash operations of its command are done.
+ * Called by the DFU session after dfu_flash_service().
+ *******************************************************************************/
+void dfu_window_service(void) {
+#if (DFU_WINDOW)
+    if (window_held.valid && dfu_flash_reached(window_held.mark)) {
+        dfu_window_release();
+    }
+#endif /* DFU_WINDOW */
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * File Name:   dfu_window.h
+ *
+ * Description: This file contains the declarations of the sliding window layer of
+ *              the DFU transport and the frame format it shares with the host.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_WINDOW_H
+#define DFU_WINDOW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_dfu.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Set to 1 to link the window layer between the DFU middleware and the DFU
+ * transport (GCC --wrap of Cy_DFU_TransportRead/Write/Reset) */
+#ifndef DFU_WINDOW
+#define DFU_WINDOW                  (0)
+#endif
+
+/* Largest number of commands the host may have in flight, a power of two */
+#ifndef DFU_WINDOW_SIZE
+#define DFU_WINDOW_SIZE             (8u)
+#endif
+
+#if ((DFU_WINDOW_SIZE & (DFU_WINDOW_SIZE - 1u)) != 0u) || (DFU_WINDOW_SIZE > 32u)
+#error "DFU_WINDOW_SIZE must be a power of two, up to 32"
+#endif
+
+/*
+ * Frame format, in front of every DFU packet in both directions:
+ * [0]     frame type
+ * [1]     sequence number of the command, or of the command answered
+ * [2]     cumulative ack: sequence number the device expects next
+ * [3..6]  selective ack, little endian: bit i set if command ack + 1 + i
+ *         has been received out of order
+ */
+#define DFU_WINDOW_HEADER_SIZE      (7u)
+#define DFU_WINDOW_FRAME_DATA       (0x01u)
+#define DFU_WINDOW_FRAME_ACK        (0x02u)
+#define DFU_WINDOW_SACK_BITS        (32u)
+
+/* Size of a frame carrying the largest DFU packet */
+#define DFU_WINDOW_FRAME_SIZE       (DFU_WINDOW_HEADER_SIZE + CY_DFU_SIZEOF_CMD_BUFFER)
+
+/* Responses up to this size are kept to answer retransmitted commands */
+#define DFU_WINDOW_RSP_CACHE_SIZE   (32u)
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+void dfu_window_init(uint32_t size);
+bool dfu_window_ready(void);
+void dfu_window_service(void);
+
+#endif /* DFU_WINDOW_H */
+
+/* [] END OF FILE */
@@ -44,6 +44,13 @@
 #include "cybsp.h"
 #include "cy_dfu.h"
 #include "cy_retarget_io.h"
+#include "boot_crypto.h"
+#include "boot_timing.h"
+#include "dfu_digest.h"
+#include "dfu_flash.h"
+#include "dfu_session.h"
+#include "dfu_window.h"
+#include "dlog.h"
 
 #if !(SWAP_DISABLED) && defined(UPGRADE_IMAGE)
 /* Header file which contains the function to Write Image OK flag to the slot trailer */
@@ -59,17 +66,21 @@
 #define DFU_APP_USER_LED             CYBSP_USER_LED
 #endif
 
-/* Timeout for Cy_DFU_Continue(), in milliseconds */
-#define DFU_SESSION_TIMEOUT_MS      (20u)
-
-/* Application ID */
-#define USER_APP_ID                 (1u)
-
-/* DFU command timeout */
-#define DFU_COMMAND_TIMEOUT_MS      (5000u)
+/* Image of the memory map this build is, see IMG_ID in user_config.mk */
+#ifndef USER_APP_IMG_ID
+#define USER_APP_IMG_ID             (1)
+#endif
 
-/* Interval for LED toggle */
-#define LED_TOGGLE_INTERVAL_MS      (1000u)
+/* Image 2 runs on the other CM7 core without a DFU transport and blinks
+ * its own LED */
+#if (USER_APP_IMG_ID != 1)
+#if defined(CYBSP_USER_LED3)
+#define COMPANION_USER_LED          CYBSP_USER_LED3
+#else
+#define COMPANION_USER_LED          CYBSP_USER_LED
+#endif
+#define COMPANION_BLINK_MS          (500u)
+#endif
 
 #define VERSION_MESSAGE_VER         "[DFU App] Version:"
 
@@ -87,9 +98,27 @@
 /*******************************************************************************
  * Function Prototypes
  ********************************************************************************/
-static uint32_t get_counter_timeout(uint32_t seconds, uint32_t timeout);
-static cy_en_dfu_status_t restart_dfu(uint32_t *state, cy_stc_dfu_params_t *dfu_params);
+static void user_app_led_toggle(void);
+static void user_app_delay_ms(uint32_t milliseconds);
+static void user_app_handover(void);
 static void user_app_soft_reset(void);
+#if (USER_APP_IMG_ID != 1)
+static void user_app_companion(void);
+#endif
+#if (BOOT_CRYPTO_KAT)
+static void user_app_kat_report(const char *name, bool passed);
+#endif
+#if (DFU_EVENT_DRIVEN)
+static uint32_t user_app_get_tick_ms(void);
+static bool user_app_wait_event(uint32_t timeout_ms);
+static void user_app_transport_isr(void);
+static void user_app_transport_hook(void);
+#endif
+#if (DLOG)
+static void user_app_dlog_init(void);
+static uint32_t user_app_dlog_cycles(void);
+static bool user_app_dlog_out(const char *line, uint32_t length);
+#endif
 
 /*******************************************************************************
  * Global Variables
@@ -108,6 +137,42 @@ cy_en_dfu_transport_t selected_transport = CY_DFU_SPI;
 cy_en_dfu_transport_t selected_transport = CY_DFU_CANFD;
 #endif
 
+#if (DFU_EVENT_DRIVEN)
+/* Low power timer, tick source and wake-up timer of the event-driven DFU session */
+static cyhal_lptimer_t dfu_tick_timer;
+static cyhal_lptimer_info_t dfu_tick_info;
+
+/* System interrupt of the DFU transport, as named by the BSP */
+#ifndef DFU_TRANSPORT_IRQ
+#if defined COMPONENT_DFU_I2C
+#define DFU_TRANSPORT_IRQ               CYBSP_DFU_I2C_IRQ
+#elif defined COMPONENT_DFU_UART
+#define DFU_TRANSPORT_IRQ               CYBSP_DFU_UART_IRQ
+#elif defined COMPONENT_DFU_SPI
+#define DFU_TRANSPORT_IRQ               CYBSP_DFU_SPI_IRQ
+#elif defined COMPONENT_DFU_CANFD
+#define DFU_TRANSPORT_IRQ               CYBSP_DFU_CANFD_IRQ
+#endif
+#endif
+
+/* Handler the DFU transport installed, called by user_app_transport_isr() */
+static cy_israddress dfu_transport_isr = NULL;
+
+/* Set by the interrupt of the DFU transport, taken by user_app_wait_event() */
+static volatile bool dfu_transport_event = false;
+#endif
+
+/* Platform services used by the DFU session */
+static const dfu_session_ops_t dfu_session_ops = {
+    .led_toggle = user_app_led_toggle,
+    .delay_ms = user_app_delay_ms,
+    .reset = user_app_handover,
+#if (DFU_EVENT_DRIVEN)
+    .get_tick_ms = user_app_get_tick_ms,
+    .wait_event = user_app_wait_event,
+#endif
+};
+
 /*******************************************************************************
 * Function Name: main
 ********************************************************************************
@@ -132,20 +197,11 @@ cy_en_dfu_transport_t selected_transport = CY_DFU_CANFD;
 int main(void) {
     cy_rslt_t result = CY_RSLT_TYPE_ERROR;
 
-    /* Used to count seconds */
-    uint32_t count = 0;
-
     /* Status codes for DFU API */
     cy_en_dfu_status_t status = CY_DFU_ERROR_UNKNOWN;
 
-    /*
-     * DFU state, one of the:
-     * - CY_DFU_STATE_NONE
-     * - CY_DFU_STATE_UPDATING
-     * - CY_DFU_STATE_FINISHED
-     * - CY_DFU_STATE_FAILED
-     */
-    uint32_t state = CY_DFU_STATE_NONE;
+    /* DFU session, holds the DFU state and the command timeout counter */
+    static dfu_session_t session;
 
     /* Buffer to store DFU commands */
     CY_ALIGN(4) static uint8_t buffer[CY_DFU_SIZEOF_DATA_BUFFER];
@@ -166,6 +222,11 @@ int main(void) {
         CY_ASSERT(0);
     }
 
+#if (USER_APP_IMG_ID != 1)
+    /* The debug UART and the DFU transport belong to image 1 */
+    user_app_companion();
+#endif
+
     /* Initialize retarget-io to use the debug UART port */
     result = cy_retarget_io_init(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX, CY_RETARGET_IO_BAUDRATE);
     
@@ -181,6 +242,27 @@ int main(void) {
     CORE_NAME_MSG);
     printf("\n===========================\r\n");
 
+#if (DLOG)
+    /* Messages of the DFU session deferred to the lane of this core, the
+     * lane of the bootloader is drained with it */
+    user_app_dlog_init();
+#endif
+
+#if (BOOT_TIMING)
+    /* Boot phases recorded by the bootloader before the launch */
+    boot_timing_print(boot_timing_table());
+#endif
+
+    /* Crypto backend of the digest of the upgrade image */
+    if (boot_crypto_init() != 0)
+    {
+        CY_ASSERT(0);
+    }
+#if (BOOT_CRYPTO_KAT)
+    printf("[DFU App] Crypto backend %s: %u known-answer tests failed\r\n", boot_crypto_name(),
+           (unsigned int)boot_crypto_kat_run(user_app_kat_report));
+#endif
+
     /* Initialize the User LED */
     result = cyhal_gpio_init(DFU_APP_USER_LED, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG, CYBSP_LED_STATE_ON);
     
@@ -225,187 +307,275 @@ int main(void) {
     /* DFU params, used to configure DFU */
     cy_stc_dfu_params_t dfu_params;
 
+#if (DFU_EVENT_DRIVEN)
+    /* Initialize the tick source of the event-driven DFU session */
+    result = cyhal_lptimer_init(&dfu_tick_timer);
+
+    /* LPTimer init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    cyhal_lptimer_get_info(&dfu_tick_timer, &dfu_tick_info);
+#endif
+
     /* Initialize dfu_params structure */
     dfu_params.timeout = DFU_SESSION_TIMEOUT_MS;
     dfu_params.dataBuffer = &buffer[0];
     dfu_params.packetBuffer = &packet[0];
 
+    /* Initialize the flash writer of the upgrade slot */
+    dfu_flash_init();
+
+#if (DFU_HASH_STREAM)
+    /* Hash the upgrade image while it is written */
+    dfu_digest_init(true);
+#endif
+
     /* Initialize DFU */
-    status = Cy_DFU_Init(&state, &dfu_params);
+    status = dfu_session_init(&session, &dfu_params, &dfu_session_ops);
 
     /* DFU init failed. Stop program execution */
-    if (result != CY_RSLT_SUCCESS)
+    if (status != CY_DFU_SUCCESS)
     {
         CY_ASSERT(0);
     }
 
+#if (DFU_WINDOW)
+    /* Accept up to DFU_WINDOW_SIZE commands in flight */
+    dfu_window_init(DFU_WINDOW_SIZE);
+#endif
+
     /* Initialize DFU communication */
     Cy_DFU_TransportStart(selected_transport);
 
+#if (DFU_EVENT_DRIVEN)
+    /* Report the interrupts of the transport to the session */
+    user_app_transport_hook();
+#endif
+
     /* enable interrupts */
     __enable_irq();
 
     printf("[DFU App] %s DFU TRANSPORT STARTED !!!\r\n", DFU_TRANSPORT_MESSAGE_VER);
 
     for (;;) {
-        status = Cy_DFU_Continue(&state, &dfu_params);
+        dfu_session_step(&session);
+#if (DLOG)
+        /* Between the commands, as much as the TX FIFO takes */
+        (void)dlog_drain(user_app_dlog_out);
+#endif
+    }
+}
 
-        ++count;
+#if (USER_APP_IMG_ID != 1)
+/*******************************************************************************
+ * Function Name: user_app_companion
+ ********************************************************************************
+ * Main loop of image 2 on the other CM7 core. The DFU application on the core
+ * of image 1 updates both images, this image only blinks its LED. After a
+ * swap upgrade the image confirms itself once it runs, as there is no console
+ * to ask.
+ *******************************************************************************/
+static void user_app_companion(void) {
+    cy_rslt_t result;
 
-        if (state == CY_DFU_STATE_FINISHED) {
-            /*
-             * Finished loading the application image
-             * Validate the DFU application. Stop transporting if the application is valid.
-             * NOTE Cy_DFU_ValidateApp should be implemented on the application level
-             */
-            status = Cy_DFU_ValidateApp(USER_APP_ID, &dfu_params);
-            if (status == CY_DFU_SUCCESS) {
-                printf("[DFU App] Successfully downloaded the upgrade image and placed it into the secondary slot\r\n");
-                printf("[DFU App] Reset the device to switch the control to the edge protect bootloader\r\n");
-                cyhal_system_delay_ms(50);
-                /* Flush the TX buffer, need to be fixed in retarget_io */
-                while (cy_retarget_io_is_tx_active()) {
-                }
-                cy_retarget_io_deinit();
-                Cy_DFU_TransportStop();
-                user_app_soft_reset();
-            } else if (status == CY_DFU_ERROR_VERIFY) {
-                /*
-                 * Restarts loading, the alternatives to Halt MCU are here
-                 * or switch to the other app if it is valid.
-                 * Error code can be handled here, which means print to debug UART.
-                 */
-                printf("[DFU App] Upgrade image verification failed\r\n");
-                status = restart_dfu(&state, &dfu_params);
-            }
-        } else if (state == CY_DFU_STATE_FAILED) {
-            /*
-             * An error occurred during the loading process.
-             * Handle it here. This code just restarts the loading process.
-             */
-            printf("[DFU App] An error occurred during the loading process\r\n");
-            status = restart_dfu(&state, &dfu_params);
-        } else if (state == CY_DFU_STATE_UPDATING) {
-            /*
-             * The DFU_SESSION_TIMEOUT_MS variable is equal to the time DFU waits for the
-             * next Host command.
-             */
-            bool time_out = (count >= (DFU_COMMAND_TIMEOUT_MS / DFU_SESSION_TIMEOUT_MS));
-            /*
-             * if no command was received within few seconds after the loading
-             * started, restart loading.
-             */
-            if (status == CY_DFU_SUCCESS) {
-                count = 0u;
-            } else if (status == CY_DFU_ERROR_TIMEOUT) {
-                if (time_out != 0u) {
-                    count = 0u;
-                    restart_dfu(&state, &dfu_params);
-                }
-            } else {
-#if defined COMPONENT_DFU_UART
-                /*
-                 * DFU updating status is unknown,
-                 * Delay because Transport still may be sending an error or success response to the host.
-                 * Reset the device, to give a control to edge protect bootloader.
-                 * To validate the downloaded image
-                 */
-                printf("[DFU App] DFU updating status is unknown \r\n");
-                printf("[DFU App] Reset the device to switch the control to the edge protect bootloader\r\n");
-                printf("[DFU App] To vaild the upgrade image\r\n");
-                cyhal_system_delay_ms(50);
-                /* Flush the TX buffer, need to be fixed in retarget_io */
-                while (cy_retarget_io_is_tx_active()) {
-                }
-                cy_retarget_io_deinit();
-                Cy_DFU_TransportStop();
-                user_app_soft_reset();
-#else
-                count = 0u;
-                /* Delay because Transport still may be sending an error response to the host. */
-                cyhal_system_delay_ms(50);
-                restart_dfu(&state, &dfu_params);
+#if !(SWAP_DISABLED) && defined(UPGRADE_IMAGE)
+    if (*((uint8_t*) IMG_OK_ADDR) != USER_SWAP_IMAGE_OK) {
+        (void)set_img_ok(IMG_OK_ADDR, USER_SWAP_IMAGE_OK);
+    }
 #endif
-            }
-        }
-        /* Blink once per seconds approximately */
-        if ((count % get_counter_timeout(LED_TOGGLE_INTERVAL_MS, DFU_SESSION_TIMEOUT_MS)) == 0u) {
-            /* Invert the USER LED state */
-            cyhal_gpio_toggle(DFU_APP_USER_LED);
-        }
+
+    result = cyhal_gpio_init(COMPANION_USER_LED, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG, CYBSP_LED_STATE_ON);
+
+    /* GPIO init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    __enable_irq();
+
+    for (;;) {
+        cyhal_gpio_toggle(COMPANION_USER_LED);
+        cyhal_system_delay_ms(COMPANION_BLINK_MS);
     }
 }
+#endif /* USER_APP_IMG_ID != 1 */
 
+#if (BOOT_CRYPTO_KAT)
 /*******************************************************************************
- * Function Name: get_counter_timeout
+ * Function Name: user_app_kat_report
  ********************************************************************************
- * Returns number of counts that correspond to number of seconds passed as
- * a parameter.
- * E.g. comparing counter with 300 seconds is like this.
- * ---
- * uint32_t counter = 0u;
- * for (;;)
- * {
- *     Cy_SysLib_Delay(UART_TIMEOUT);
- *     ++count;
- *     if (count >= get_counter_timeout(seconds: 300u, timeout: UART_TIMEOUT))
- *     {
- *         count = 0u;
- *         DoSomething();
- *     }
- * }
- * ---
+ * Prints a failed known-answer test of the crypto backend.
+ *******************************************************************************/
+static void user_app_kat_report(const char *name, bool passed) {
+    if (!passed) {
+        printf("[DFU App] Known-answer test %s failed\r\n", name);
+    }
+}
+#endif /* BOOT_CRYPTO_KAT */
+
+/*******************************************************************************
+ * Function Name: user_app_led_toggle
+ ********************************************************************************
+ * Inverts the state of the DFU application user LED.
+ *******************************************************************************/
+static void user_app_led_toggle(void) {
+    cyhal_gpio_toggle(DFU_APP_USER_LED);
+}
+
+/*******************************************************************************
+ * Function Name: user_app_delay_ms
+ ********************************************************************************
+ * Blocking delay used by the DFU session.
  *
- * Both parameters are required to be compile time constants,
- * so this function gets optimized out to single constant value.
+ * Parameters:
+ *  milliseconds   Delay, in milliseconds.
+ *******************************************************************************/
+static void user_app_delay_ms(uint32_t milliseconds) {
+    cyhal_system_delay_ms(milliseconds);
+}
+
+#if (DFU_EVENT_DRIVEN)
+/*******************************************************************************
+ * Function Name: user_app_get_tick_ms
+ ********************************************************************************
+ * Free running millisecond tick derived from the low power timer. The counter
+ * is accumulated so that the tick does not depend on the counter width.
+ *******************************************************************************/
+static uint32_t user_app_get_tick_ms(void) {
+    static uint32_t last_count = 0u;
+    static uint64_t total_count = 0u;
+    uint32_t count = cyhal_lptimer_read(&dfu_tick_timer);
+
+    total_count += (uint32_t)(count - last_count);
+    last_count = count;
+    return (uint32_t)((total_count * 1000u) / dfu_tick_info.frequency_hz);
+}
+
+/*******************************************************************************
+ * Function Name: user_app_wait_event
+ ********************************************************************************
+ * Puts the CPU to sleep until an interrupt occurs or timeout_ms elapses,
+ * unless the DFU transport has already interrupted. The interrupts stay
+ * masked while the flag is checked, a pending interrupt still wakes the CPU.
  *
  * Parameters:
- *  seconds    Number of seconds to pass. Must be less that 4_294_967 seconds.
- *  timeout    Timeout for Cy_DFU_Continue() function, in milliseconds.
- *             Must be greater than zero.
- *             It is recommended to be a value that produces no reminder
- *             for this function to be precise.
+ *  timeout_ms     Longest time to sleep, in milliseconds.
+ *
  * Return:
- *  See description.
+ *  true if the DFU transport interrupted since the last call, false if the
+ *  CPU woke up for another reason.
  *******************************************************************************/
-static uint32_t get_counter_timeout(uint32_t seconds, uint32_t timeout) {
-    uint32_t count = 1;
+static bool user_app_wait_event(uint32_t timeout_ms) {
+    uint32_t actual_ms = 0u;
+    uint32_t saved_intr = cyhal_system_critical_section_enter();
+    bool event;
 
-    if (timeout != 0) {
-        count = ((seconds) / timeout);
+    if ((!dfu_transport_event) && (timeout_ms != 0u)) {
+        (void)cyhal_syspm_tickless_sleep(&dfu_tick_timer, timeout_ms, &actual_ms);
     }
+    cyhal_system_critical_section_exit(saved_intr);
+
+    /* The interrupt that woke the CPU up has run by now */
+    saved_intr = cyhal_system_critical_section_enter();
+    event = dfu_transport_event;
+    dfu_transport_event = false;
+    cyhal_system_critical_section_exit(saved_intr);
+    return event;
+}
 
-    return count;
+/*******************************************************************************
+ * Function Name: user_app_transport_isr
+ ********************************************************************************
+ * Interrupt of the DFU transport: records the event for the session and runs
+ * the handler of the transport.
+ *******************************************************************************/
+static void user_app_transport_isr(void) {
+    dfu_transport_event = true;
+    if (dfu_transport_isr != NULL) {
+        dfu_transport_isr();
+    }
 }
 
 /*******************************************************************************
- * Function Name: restart_dfu
+ * Function Name: user_app_transport_hook
  ********************************************************************************
- * This function re-initializes the DFU and resets the DFU transport.
- *
- * Parameters:
- *  dfu_params     input DFU parameters.
- *  state          input current state of the DFU
+ * Chains user_app_transport_isr() in front of the handler that
+ * Cy_DFU_TransportStart() installed for the interrupt of the transport.
+ *******************************************************************************/
+static void user_app_transport_hook(void) {
+    dfu_transport_isr = Cy_SysInt_GetVector(DFU_TRANSPORT_IRQ);
+    (void)Cy_SysInt_SetVector(DFU_TRANSPORT_IRQ, user_app_transport_isr);
+}
+#endif /* DFU_EVENT_DRIVEN */
+
+#if (DLOG)
+/*******************************************************************************
+ * Function Name: user_app_dlog_init
+ ********************************************************************************
+ * Starts the cycle counter of the CM7, the clock of the records, and sets up
+ * the lane of this core.
+ *******************************************************************************/
+static void user_app_dlog_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55u;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    dlog_init(DLOG_LANE, user_app_dlog_cycles, SystemCoreClock);
+}
+
+/*******************************************************************************
+ * Function Name: user_app_dlog_cycles
+ ********************************************************************************
+ * Return:
+ *  CPU cycles since user_app_dlog_init(), the timestamp of a record.
+ *******************************************************************************/
+static uint32_t user_app_dlog_cycles(void) {
+    return DWT->CYCCNT;
+}
+
+/*******************************************************************************
+ * Function Name: user_app_dlog_out
+ ********************************************************************************
+ * Output of the deferred log: puts a whole line into the TX FIFO of the debug
+ * UART without waiting, once retarget-io has nothing left to send.
  *
  * Return:
- *  Status of operation.
+ *  false if the line does not fit yet.
  *******************************************************************************/
-static cy_en_dfu_status_t restart_dfu(uint32_t *state, cy_stc_dfu_params_t *dfu_params) {
-    cy_en_dfu_status_t status = CY_DFU_SUCCESS;
+static bool user_app_dlog_out(const char *line, uint32_t length) {
+    CySCB_Type *base = cy_retarget_io_uart_obj.base;
 
-    if (!state || !dfu_params) {
-        status = CY_DFU_ERROR_UNKNOWN;
+    if (cy_retarget_io_is_tx_active() ||
+        ((Cy_SCB_GetFifoSize(base) - Cy_SCB_UART_GetNumInTxFifo(base)) < length)) {
+        return false;
     }
+    (void)Cy_SCB_UART_PutArray(base, (void *)line, length);
+    return true;
+}
+#endif /* DLOG */
 
-    /* Restart DFU process */
-    if (status == CY_DFU_SUCCESS) {
-        status = Cy_DFU_Init(state, dfu_params);
-        if (status == CY_DFU_SUCCESS) {
-        Cy_DFU_TransportReset();
-        }
+/*******************************************************************************
+ * Function Name: user_app_handover
+ ********************************************************************************
+ * Stops the DFU transport and soft resets the device, so that the edge
+ * protect bootloader can validate the upgrade image.
+ *******************************************************************************/
+static void user_app_handover(void) {
+#if (DLOG)
+    /* The lane of this core is cleared at the next start */
+    while (!dlog_empty()) {
+        (void)dlog_drain(user_app_dlog_out);
+    }
+#endif
+    /* Flush the TX buffer, need to be fixed in retarget_io */
+    while (cy_retarget_io_is_tx_active()) {
     }
-    printf("[DFU App] Restarted the DFU\r\n");
-    return status;
+    cy_retarget_io_deinit();
+    Cy_DFU_TransportStop();
+    user_app_soft_reset();
 }
 
 /*******************************************************************************
@@ -0,0 +1,173 @@
+/******************************************************************************
+ * File Name:   cy_dfu.h
+ *
+ * Description: Host stand-in for the subset of the DFU middleware API used by
+ *              the DFU application. Names and semantics follow the DFU middleware
+ *              so that application sources compile unchanged for the host.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef CY_DFU_H
+#define CY_DFU_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* DFU states */
+#define CY_DFU_STATE_NONE           (0u)
+#define CY_DFU_STATE_UPDATING       (1u)
+#define CY_DFU_STATE_FINISHED       (2u)
+#define CY_DFU_STATE_FAILED         (3u)
+
+/* Cy_DFU_WriteData() / Cy_DFU_ReadData() control values */
+#define CY_DFU_IOCTL_READ           (0x00u)
+#define CY_DFU_IOCTL_COMPARE        (0x01u)
+#define CY_DFU_IOCTL_WRITE          (0x00u)
+#define CY_DFU_IOCTL_ERASE          (0x01u)
+
+/* Packet framing */
+#define CY_DFU_PACKET_SOP           (0x01u)
+#define CY_DFU_PACKET_EOP           (0x17u)
+#define CY_DFU_PACKET_HEADER_SIZE   (4u)
+#define CY_DFU_PACKET_FOOTER_SIZE   (3u)
+#define CY_DFU_PACKET_OVERHEAD      (CY_DFU_PACKET_HEADER_SIZE + CY_DFU_PACKET_FOOTER_SIZE)
+
+/* DFU commands */
+#define CY_DFU_CMD_VERIFY_APP       (0x31u)
+#define CY_DFU_CMD_SYNC             (0x35u)
+#define CY_DFU_CMD_SEND_DATA        (0x37u)
+#define CY_DFU_CMD_ENTER            (0x38u)
+#define CY_DFU_CMD_EXIT             (0x3Bu)
+#define CY_DFU_CMD_GET_METADATA     (0x3Cu)
+#define CY_DFU_CMD_ERASE_DATA       (0x44u)
+#define CY_DFU_CMD_SEND_DATA_WR     (0x47u)
+#define CY_DFU_CMD_PROGRAM_DATA     (0x49u)
+#define CY_DFU_CMD_VERIFY_DATA      (0x4Au)
+#define CY_DFU_CMD_SET_METADATA     (0x4Cu)
+
+/* Size of the program row written by a single Cy_DFU_WriteData() call */
+#ifndef CY_DFU_ROW_SIZE
+#define CY_DFU_ROW_SIZE             (0x200u)
+#endif
+
+/* Largest payload of a single DFU packet */
+#ifndef CY_DFU_MAX_PACKET_DATA
+#define CY_DFU_MAX_PACKET_DATA      (CY_DFU_ROW_SIZE + 8u)
+#endif
+
+/* Address of the metadata read by Get Metadata through Cy_DFU_ReadData(),
+ * placed by the application */
+#ifndef CY_DFU_METADATA_ADDR
+#define CY_DFU_METADATA_ADDR        (0u)
+#endif
+
+/* Largest metadata read by a single Get Metadata command */
+#define CY_DFU_METADATA_MAX_SIZE    (64u)
+
+/* Buffer for a DFU row being collected from Send Data / Program Data */
+#define CY_DFU_SIZEOF_DATA_BUFFER   (CY_DFU_ROW_SIZE + 16u)
+
+/* Buffer for one DFU packet */
+#define CY_DFU_SIZEOF_CMD_BUFFER    (CY_DFU_MAX_PACKET_DATA + CY_DFU_PACKET_OVERHEAD)
+
+/*******************************************************************************
+ * Enumerations
+ ********************************************************************************/
+/* The low byte is the status code sent in a DFU response packet */
+typedef enum {
+    CY_DFU_SUCCESS              = 0x00u,
+    CY_DFU_ERROR_VERIFY         = 0x02u,
+    CY_DFU_ERROR_LENGTH         = 0x03u,
+    CY_DFU_ERROR_DATA           = 0x04u,
+    CY_DFU_ERROR_CMD            = 0x05u,
+    CY_DFU_ERROR_CHECKSUM       = 0x08u,
+    CY_DFU_ERROR_ADDRESS        = 0x0Au,
+    CY_DFU_ERROR_TIMEOUT        = 0x0Du,
+    CY_DFU_ERROR_UNKNOWN        = 0x0Fu,
+} cy_en_dfu_status_t;
+
+typedef enum {
+    CY_DFU_I2C,
+    CY_DFU_UART,
+    CY_DFU_SPI,
+    CY_DFU_CANFD,
+    CY_DFU_USER,
+} cy_en_dfu_transport_t;
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    /* Timeout for a transport read, in milliseconds */
+    uint32_t timeout;
+    /* Row collected from Send Data / Program Data */
+    uint8_t *dataBuffer;
+    /* Transport packet */
+    uint8_t *packetBuffer;
+    /* Number of bytes collected in dataBuffer */
+    uint32_t dataOffset;
+    /* Application ID passed with Verify Application */
+    uint32_t appId;
+} cy_stc_dfu_params_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+cy_en_dfu_status_t Cy_DFU_Init(uint32_t *state, cy_stc_dfu_params_t *params);
+cy_en_dfu_status_t Cy_DFU_Continue(uint32_t *state, cy_stc_dfu_params_t *params);
+
+/* Application level routines, weak defaults are provided by the simulator */
+cy_en_dfu_status_t Cy_DFU_ValidateApp(uint32_t appId, cy_stc_dfu_params_t *params);
+cy_en_dfu_status_t Cy_DFU_WriteData(uint32_t address, uint32_t length, uint32_t ctl,
+                                    cy_stc_dfu_params_t *params);
+cy_en_dfu_status_t Cy_DFU_ReadData(uint32_t address, uint32_t length, uint32_t ctl,
+                                   cy_stc_dfu_params_t *params);
+
+/* Transport */
+void Cy_DFU_TransportStart(cy_en_dfu_transport_t transport);
+void Cy_DFU_TransportStop(void);
+void Cy_DFU_TransportReset(void);
+cy_en_dfu_status_t Cy_DFU_TransportRead(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                        uint32_t timeout);
+cy_en_dfu_status_t Cy_DFU_TransportWrite(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                         uint32_t timeout);
+
+#endif /* CY_DFU_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * File Name:   flash_map_backend.h
+ *
+ * Description: Host stand-in for the flash map backend of the Cypress MCUboot port, the
+ *              types used by the memory map that memorymap_xmc7000.py generates and the
+ *              flash area API. Implemented over the flash model by sim_flash_map.c.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef FLASH_MAP_BACKEND_H
+#define FLASH_MAP_BACKEND_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+struct flash_device {
+    uint32_t address;
+    uint32_t size;
+    uint32_t erase_size;
+    uint8_t erase_val;
+    uint8_t device_id;
+};
+
+struct flash_sector {
+    uint32_t fs_off;
+    uint32_t fs_size;
+};
+
+struct flash_area {
+    uint8_t fa_id;
+    uint8_t fa_device_id;
+    uint16_t pad16;
+    uint32_t fa_off;
+    uint32_t fa_size;
+};
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+int flash_area_open(uint8_t id, const struct flash_area **fa);
+void flash_area_close(const struct flash_area *fa);
+int flash_area_read(const struct flash_area *fa, uint32_t off, void *dst, uint32_t len);
+int flash_area_write(const struct flash_area *fa, uint32_t off, const void *src, uint32_t len);
+int flash_area_erase(const struct flash_area *fa, uint32_t off, uint32_t len);
+uint32_t flash_area_align(const struct flash_area *fa);
+uint8_t flash_area_erased_val(const struct flash_area *fa);
+int flash_device_base(uint8_t fd_id, uintptr_t *ret);
+int flash_area_get_sectors(int fa_id, uint32_t *count, struct flash_sector *sectors);
+
+#endif /* FLASH_MAP_BACKEND_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * File Name:   bench_stats.c
+ *
+ * Description: Summary statistics used by the host benchmarks.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "bench_stats.h"
+
+/*******************************************************************************
+ * Function Name: compare_u32
+ ********************************************************************************
+ * qsort() comparator.
+ *******************************************************************************/
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*******************************************************************************
+ * Function Name: percentile
+ ********************************************************************************
+ * Nearest-rank percentile of a sorted array.
+ *******************************************************************************/
+static uint32_t percentile(const uint32_t *sorted, uint32_t count, uint32_t pct) {
+    uint32_t rank = (uint32_t)(((uint64_t)pct * count + 99u) / 100u);
+
+    return sorted[(rank > 0u) ? rank - 1u : 0u];
+}
+
+/*******************************************************************************
+ * Function Name: bench_stats_compute
+ ********************************************************************************
+ * Computes min, mean, percentiles and max of the given samples.
+ *******************************************************************************/
+void bench_stats_compute(const uint32_t *values, uint32_t count, bench_stats_t *stats) {
+    uint32_t *sorted;
+    uint64_t sum = 0u;
+
+    memset(stats, 0, sizeof(*stats));
+    if ((count == 0u) || ((sorted = malloc(count * sizeof(uint32_t))) == NULL)) {
+        return;
+    }
+    memcpy(sorted, values, count * sizeof(uint32_t));
+    qsort(sorted, count, sizeof(uint32_t), compare_u32);
+    for (uint32_t i = 0u; i < count; i++) {
+        sum += sorted[i];
+    }
+
+    stats->count = count;
+    stats->mean = (double)sum / count;
+    stats->min = sorted[0];
+    stats->p50 = percentile(sorted, count, 50u);
+    stats->p90 = percentile(sorted, count, 90u);
+    stats->p99 = percentile(sorted, count, 99u);
+    stats->max = sorted[count - 1u];
+    free(sorted);
+}
+
+/* [] END OF FILE */
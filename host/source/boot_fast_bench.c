@@ -0,0 +1,458 @@
+/******************************************************************************
+ * File Name:   boot_fast_bench.c
+ *
+ * Description: Reset to CM7 entry time of the bootloader with and without the fast boot profile
+ *              (BOOT_FAST=1): the boot_go() model of the power failure harness on the overwrite
+ *              flash map, with modelled startup, console and launch times around it.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "memorymap.h"
+#include "image_file.h"
+#include "sim_flash.h"
+#include "sim_loader.h"
+#include "sim_swap_port.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Trailer magic at the end of the synthetic images */
+#define FAST_BENCH_MAGIC_SIZE       (16u)
+
+/* Bits of a UART character: start, 8 data and stop bits */
+#define FAST_BENCH_UART_BITS        (10u)
+
+/* Console messages of the bootloader main.c, with the "[INF] " prefix and
+ * the line end of the messages of MCUboot */
+#define FAST_BENCH_LINE(text)       (sizeof("[INF] " text "\r\n") - 1u)
+#define FAST_BENCH_START_BYTES      (FAST_BENCH_LINE("\x1b[2J\x1b[;H") + \
+                                     FAST_BENCH_LINE("Edge Protect Bootloader Started"))
+#define FAST_BENCH_VALID_BYTES      (FAST_BENCH_LINE("User Application validated successfully"))
+#define FAST_BENCH_LAUNCH_BYTES     (FAST_BENCH_LINE("Starting User Application (wait)...") + \
+                                     FAST_BENCH_LINE("Start slot Address: 0x10020400") + \
+                                     FAST_BENCH_LINE("Launching app on CM7 core") + \
+                                     FAST_BENCH_LINE("Edge Protect Bootloader finished.\r\nDeinitializing hardware..."))
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    FAST_PHASE_RESET = 0,
+    FAST_PHASE_BSP_INIT,
+    FAST_PHASE_FAST_CHECK,
+    FAST_PHASE_CONSOLE_INIT,
+    FAST_PHASE_BOOT_GO,
+    FAST_PHASE_WDT_INIT,
+    FAST_PHASE_CONSOLE_WAIT,
+    FAST_PHASE_LAUNCH,
+    FAST_PHASE_COUNT
+} fast_phase_t;
+
+typedef enum {
+    FAST_CASE_BOOT = 0,
+    FAST_CASE_UPGRADE,
+    FAST_CASE_COUNT
+} fast_case_t;
+
+/* Modelled durations, assumptions for the CM0+ of the device */
+typedef struct {
+    uint32_t reset_us;
+    uint32_t bsp_us;
+    uint32_t check_us;
+    uint32_t retarget_us;
+    uint32_t wdt_us;
+    uint32_t launch_us;
+    uint32_t baud;
+    uint32_t fifo;
+    uint32_t mcuboot_bytes;
+} fast_bench_timing_t;
+
+typedef struct {
+    uint32_t code_size;
+    uint32_t seed;
+    bool json;
+    fast_bench_timing_t model;
+    sim_swap_timing_t timing;
+    sim_loader_cfg_t loader;
+} fast_bench_options_t;
+
+/* One boot in one profile */
+typedef struct {
+    bool pending;
+    bool console;
+    bool booted;
+    uint32_t console_bytes;
+    double phase_us[FAST_PHASE_COUNT];
+    double total_us;
+} fast_bench_boot_t;
+
+/* Transmission of the console, the CPU waits when the TX FIFO is full */
+typedef struct {
+    double now_us;
+    double tx_end_us;
+    double wait_us;
+    uint32_t bytes;
+} fast_bench_uart_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const char *const fast_phase_names[FAST_PHASE_COUNT] = {
+    "reset to main()", "bsp init", "fast check", "retarget-io init", "boot_go", "wdt init", "console wait",
+    "launch",
+};
+
+static const char *const fast_phase_keys[FAST_PHASE_COUNT] = {
+    "reset", "bsp_init", "fast_check", "console_init", "boot_go", "wdt_init", "console_wait", "launch",
+};
+
+static const char *const fast_case_names[FAST_CASE_COUNT] = {
+    "boot, no upgrade", "upgrade",
+};
+
+static const char *const fast_case_keys[FAST_CASE_COUNT] = { "boot", "upgrade" };
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name, const fast_bench_options_t *opt) {
+    printf("Usage: %s [options]\n"
+           "Reset to CM7 entry time of the default and the fast boot profile (BOOT_FAST=1), overwrite flash map.\n"
+           "  --code-size N       code size of the image in the primary slot (default 0x%x)\n"
+           "  --hash-us-per-kb N  modelled time to hash 1 KB of an image (default %u)\n"
+           "  --reset-us N        modelled time from the reset to the CM0+ main() (default %u)\n"
+           "  --bsp-us N          modelled time of cybsp_init(), clocks included (default %u)\n"
+           "  --check-us N        modelled time of boot_fast_pending() (default %u)\n"
+           "  --retarget-us N     modelled time of cy_retarget_io_init() (default %u)\n"
+           "  --wdt-us N          modelled time of cyhal_wdt_init() (default %u)\n"
+           "  --launch-us N       modelled time from the CM7 enable to its reset handler (default %u)\n"
+           "  --baud N            console baud rate (default %u)\n"
+           "  --fifo N            TX FIFO size of the console UART in bytes (default %u)\n"
+           "  --mcuboot-bytes N   console bytes of MCUboot per boot in the default profile (default %u)\n"
+           "  --seed N            seed of the images (default 1)\n"
+           "  --json              machine-readable output\n",
+           name, opt->code_size, opt->loader.hash_us_per_kb, opt->model.reset_us, opt->model.bsp_us,
+           opt->model.check_us, opt->model.retarget_us, opt->model.wdt_us, opt->model.launch_us, opt->model.baud,
+           opt->model.fifo, opt->model.mcuboot_bytes);
+}
+
+/*******************************************************************************
+ * Function Name: uart_print
+ ********************************************************************************
+ * Queues bytes on the console: the CPU waits until the last one fits in the
+ * TX FIFO.
+ *******************************************************************************/
+static void uart_print(fast_bench_uart_t *uart, const fast_bench_timing_t *model, uint32_t bytes) {
+    double byte_us = (FAST_BENCH_UART_BITS * 1000000.0) / model->baud;
+    double start_us = (uart->tx_end_us > uart->now_us) ? uart->tx_end_us : uart->now_us;
+    double room_us;
+
+    uart->tx_end_us = start_us + (bytes * byte_us);
+    uart->bytes += bytes;
+    room_us = uart->tx_end_us - (model->fifo * byte_us);
+    if (room_us > uart->now_us) {
+        uart->wait_us += room_us - uart->now_us;
+        uart->now_us = room_us;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: fast_bench_timeline
+ ********************************************************************************
+ * Models main() of the bootloader around a boot_go() of boot_go_us, in the
+ * default profile or the fast one: the default profile initializes the
+ * console before boot_go() and prints the messages of MCUboot, the fast one
+ * initializes it only if the headers and trailers request more than the
+ * launch. hw_deinit() waits until the console is sent.
+ *******************************************************************************/
+static void fast_bench_timeline(const fast_bench_timing_t *model, bool fast, bool pending, bool booted,
+                                uint64_t boot_go_us, fast_bench_boot_t *boot) {
+    fast_bench_uart_t uart = { 0 };
+
+    memset(boot, 0, sizeof(*boot));
+    boot->pending = pending;
+    boot->booted = booted;
+    boot->console = !fast || pending;
+
+    /* The phases exclude the waits for the TX FIFO, counted apart */
+    boot->phase_us[FAST_PHASE_RESET] = model->reset_us;
+    boot->phase_us[FAST_PHASE_BSP_INIT] = model->bsp_us;
+    if (fast) {
+        boot->phase_us[FAST_PHASE_FAST_CHECK] = model->check_us;
+    }
+    uart.now_us = boot->phase_us[FAST_PHASE_RESET] + boot->phase_us[FAST_PHASE_BSP_INIT] +
+                  boot->phase_us[FAST_PHASE_FAST_CHECK];
+    if (boot->console) {
+        boot->phase_us[FAST_PHASE_CONSOLE_INIT] = model->retarget_us;
+        uart.now_us += model->retarget_us;
+        uart_print(&uart, model, FAST_BENCH_START_BYTES);
+    }
+
+    /* The messages of MCUboot come at the start of boot_go() */
+    if (!fast) {
+        uart_print(&uart, model, model->mcuboot_bytes);
+    }
+    boot->phase_us[FAST_PHASE_BOOT_GO] = (double)boot_go_us;
+    uart.now_us += (double)boot_go_us;
+
+    if (booted) {
+        if (boot->console) {
+            uart_print(&uart, model, FAST_BENCH_VALID_BYTES);
+        }
+        boot->phase_us[FAST_PHASE_WDT_INIT] = model->wdt_us;
+        uart.now_us += model->wdt_us;
+        if (boot->console) {
+            uart_print(&uart, model, FAST_BENCH_LAUNCH_BYTES);
+        }
+
+        /* hw_deinit() */
+        if (boot->console && (uart.tx_end_us > uart.now_us)) {
+            uart.wait_us += uart.tx_end_us - uart.now_us;
+            uart.now_us = uart.tx_end_us;
+        }
+        boot->phase_us[FAST_PHASE_LAUNCH] = model->launch_us;
+        uart.now_us += model->launch_us;
+    }
+    boot->phase_us[FAST_PHASE_CONSOLE_WAIT] = uart.wait_us;
+    boot->console_bytes = uart.bytes;
+    boot->total_us = uart.now_us;
+}
+
+/*******************************************************************************
+ * Function Name: fast_bench_boot
+ ********************************************************************************
+ * Boots once and models the boot in both profiles.
+ *******************************************************************************/
+static void fast_bench_boot(const fast_bench_options_t *opt, fast_bench_boot_t boots[2]) {
+    sim_loader_rsp_t rsp;
+    bool pending;
+
+    pending = sim_loader_pending();
+    sim_loader_boot_go(&opt->loader, &rsp);
+    fast_bench_timeline(&opt->model, false, pending, rsp.booted, rsp.time_us, &boots[0]);
+    fast_bench_timeline(&opt->model, true, pending, rsp.booted, rsp.time_us, &boots[1]);
+}
+
+/*******************************************************************************
+ * Function Name: fast_bench_run
+ ********************************************************************************
+ * Runs a boot without upgrade, then an upgrade.
+ *
+ * Return:
+ *  0 on success, -1 if the flash cannot be set up.
+ *******************************************************************************/
+static int fast_bench_run(const fast_bench_options_t *opt, const image_t *image_old, const image_t *image_new,
+                          fast_bench_boot_t boots[FAST_CASE_COUNT][2]) {
+    if (sim_flash_load(PRIMARY_IMG_START, image_old->data, SLOT_SIZE) != 0) {
+        return -1;
+    }
+    fast_bench_boot(opt, boots[FAST_CASE_BOOT]);
+
+    if ((sim_flash_load(SECONDARY_IMG_START, image_new->data, SLOT_SIZE) != 0) ||
+        (sim_loader_set_pending(true) != 0)) {
+        return -1;
+    }
+    fast_bench_boot(opt, boots[FAST_CASE_UPGRADE]);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: print_result
+ ********************************************************************************
+ * Prints the result.
+ *******************************************************************************/
+static void print_result(const fast_bench_options_t *opt, uint32_t extent,
+                         fast_bench_boot_t boots[FAST_CASE_COUNT][2]) {
+    printf("Reset to CM7 entry, image of 0x%x bytes, console at %u baud\n", extent, opt->model.baud);
+    printf("                           default     fast\n");
+    for (uint32_t c = 0u; c < FAST_CASE_COUNT; c++) {
+        printf("  %-22s : %8.3f %8.3f ms%s\n", fast_case_names[c], boots[c][0].total_us / 1000.0,
+               boots[c][1].total_us / 1000.0, boots[c][1].console ? ", fast profile with console" : "");
+    }
+    for (uint32_t c = 0u; c < FAST_CASE_COUNT; c++) {
+        printf("Phases of the %s, ms:\n", fast_case_names[c]);
+        for (uint32_t p = 0u; p < FAST_PHASE_COUNT; p++) {
+            printf("  %-22s : %8.3f %8.3f\n", fast_phase_names[p], boots[c][0].phase_us[p] / 1000.0,
+                   boots[c][1].phase_us[p] / 1000.0);
+        }
+        printf("  %-22s : %8u %8u\n", "console bytes", boots[c][0].console_bytes, boots[c][1].console_bytes);
+    }
+    printf("Modelled times: flash operations, --hash-us-per-kb and the durations listed by --help.\n");
+}
+
+/*******************************************************************************
+ * Function Name: print_result_json
+ ********************************************************************************
+ * Prints the result as JSON.
+ *******************************************************************************/
+static void print_result_json(const fast_bench_options_t *opt, uint32_t extent,
+                              fast_bench_boot_t boots[FAST_CASE_COUNT][2]) {
+    printf("{\"image_size\": %u, \"baud\": %u", extent, opt->model.baud);
+    for (uint32_t c = 0u; c < FAST_CASE_COUNT; c++) {
+        for (uint32_t profile = 0u; profile < 2u; profile++) {
+            const fast_bench_boot_t *boot = &boots[c][profile];
+
+            printf(", \"%s_%s\": {\"total_us\": %.0f, \"console\": %s, \"console_bytes\": %u, \"phases_us\": {",
+                   fast_case_keys[c], (profile == 0u) ? "default" : "fast", boot->total_us,
+                   boot->console ? "true" : "false", boot->console_bytes);
+            for (uint32_t p = 0u; p < FAST_PHASE_COUNT; p++) {
+                printf("%s\"%s\": %.0f", (p == 0u) ? "" : ", ", fast_phase_keys[p], boot->phase_us[p]);
+            }
+            printf("}}");
+        }
+    }
+    printf("}\n");
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Runs the boots and prints the report.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "code-size",      required_argument, NULL, 'c' },
+        { "hash-us-per-kb", required_argument, NULL, 'G' },
+        { "reset-us",       required_argument, NULL, 'R' },
+        { "bsp-us",         required_argument, NULL, 'B' },
+        { "check-us",       required_argument, NULL, 'K' },
+        { "retarget-us",    required_argument, NULL, 'T' },
+        { "wdt-us",         required_argument, NULL, 'W' },
+        { "launch-us",      required_argument, NULL, 'L' },
+        { "baud",           required_argument, NULL, 'b' },
+        { "fifo",           required_argument, NULL, 'f' },
+        { "mcuboot-bytes",  required_argument, NULL, 'm' },
+        { "seed",           required_argument, NULL, 'S' },
+        { "json",           no_argument,       NULL, 'j' },
+        { "help",           no_argument,       NULL, 'h' },
+        { NULL,             0,                 NULL, 0 },
+    };
+    /* Assumed typical durations, as boot_harness; set them from measurements
+     * of the target, the boot timing table gives the phases after main() */
+    fast_bench_options_t opt = {
+        .code_size = 0x10000u,
+        .seed = 1u,
+        .json = false,
+        .model = {
+            .reset_us = 1000u,
+            .bsp_us = 600u,
+            .check_us = 20u,
+            .retarget_us = 150u,
+            .wdt_us = 30u,
+            .launch_us = 50u,
+            .baud = 115200u,
+            .fifo = 128u,
+            .mcuboot_bytes = 256u,
+        },
+        .timing = {
+            .code_erase_us = 45000u,
+            .work_erase_us = 20000u,
+            .small_erase_us = 8000u,
+            .code_program_us = 1300u,
+            .work_program_us = 70u,
+        },
+        .loader = {
+            .journal = false,
+            .hash_us_per_kb = 60u,
+        },
+    };
+    fast_bench_boot_t boots[FAST_CASE_COUNT][2];
+    image_t image_old;
+    image_t image_new;
+    bool ok;
+    int c;
+    int rc;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'c': opt.code_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'G': opt.loader.hash_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'R': opt.model.reset_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'B': opt.model.bsp_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'K': opt.model.check_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'T': opt.model.retarget_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'W': opt.model.wdt_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'L': opt.model.launch_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'b': opt.model.baud = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'f': opt.model.fifo = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'm': opt.model.mcuboot_bytes = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'S': opt.seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'j': opt.json = true; break;
+        default: usage(argv[0], &opt); return (c == 'h') ? 0 : 2;
+        }
+    }
+    if (opt.model.baud == 0u) {
+        usage(argv[0], &opt);
+        return 2;
+    }
+
+    sim_swap_port_set_timing(&opt.timing);
+    if ((sim_flash_init() != 0) || (sim_loader_init() != 0) ||
+        (image_synthetic(PRIMARY_IMG_START, SLOT_SIZE, opt.code_size, opt.seed, &image_old) != 0) ||
+        (image_synthetic_update(&image_old, 0x400u, opt.seed + 1u, &image_new) != 0)) {
+        fprintf(stderr, "cannot set up the images and the flash areas\n");
+        return 1;
+    }
+    /* Only the upgrade image carries the request */
+    memset(&image_old.data[SLOT_SIZE - FAST_BENCH_MAGIC_SIZE], 0xFF, FAST_BENCH_MAGIC_SIZE);
+
+    rc = fast_bench_run(&opt, &image_old, &image_new, boots);
+    /* The boot without upgrade takes the fast path, the upgrade does not */
+    ok = (rc == 0) && boots[FAST_CASE_BOOT][1].booted && boots[FAST_CASE_UPGRADE][1].booted &&
+         !boots[FAST_CASE_BOOT][1].console && boots[FAST_CASE_UPGRADE][1].console;
+    if (rc != 0) {
+        fprintf(stderr, "cannot load the images\n");
+    } else if (opt.json) {
+        print_result_json(&opt, image_extent(&image_old), boots);
+    } else {
+        print_result(&opt, image_extent(&image_old), boots);
+    }
+    if ((rc == 0) && !ok) {
+        fprintf(stderr, "the fast profile does not take the expected path\n");
+    }
+    image_free(&image_old);
+    image_free(&image_new);
+    sim_flash_deinit();
+    return ok ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,731 @@
+/******************************************************************************
+ * File Name:   boot_harness.c
+ *
+ * Description: Power failure harness of the upgrade of the bootloader. Runs the boot_go() model
+ *              of sim_loader.c over the flash areas of the memory map the build is generated
+ *              for, replays the upgrade with the power cut at every N-th flash operation and
+ *              boots until the expected image starts, then reports how many upgrades the model
+ *              recovered and the distribution of their boots and recovery times. MCUboot's
+ *              bootutil is not part of this repository, so the harness checks the model, not
+ *              the bootloader that runs on the device.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "memorymap.h"
+#include "bench_stats.h"
+#include "image_enc.h"
+#include "image_file.h"
+#include "sim_flash.h"
+#include "sim_loader.h"
+#include "sim_swap_port.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#if defined(MCUBOOT_DIRECT_XIP)
+#define HARNESS_MODE                "direct XIP"
+#elif defined(MCUBOOT_RAM_LOAD)
+#define HARNESS_MODE                "RAM load"
+#elif defined(MCUBOOT_OVERWRITE_ONLY)
+#define HARNESS_MODE                "overwrite"
+#else
+#define HARNESS_MODE                "swap"
+#endif /* MCUBOOT_DIRECT_XIP */
+
+/* The swap modes: the journaled swap and the revert of a test upgrade */
+#if !defined(MCUBOOT_OVERWRITE_ONLY) && !defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)
+#define HARNESS_SWAP                (1)
+#else
+#define HARNESS_SWAP                (0)
+#endif
+
+/* The modes that start the slot of the highest version, in place or from
+ * the SRAM */
+#if defined(MCUBOOT_DIRECT_XIP) || defined(MCUBOOT_RAM_LOAD)
+#define HARNESS_SELECT              (1)
+#else
+#define HARNESS_SELECT              (0)
+#endif
+
+/* Direct XIP and RAM load: the boot writes the flash only to erase an
+ * invalid image, the trials stop the transfer of the upgrade after every
+ * N-th code flash row */
+#define HARNESS_ROW_SIZE            (512u)
+
+/* Boots allowed to recover from one power cut */
+#define HARNESS_MAX_BOOTS           (64u)
+
+/* Trailer magic at the end of the synthetic images */
+#define HARNESS_MAGIC_SIZE          (16u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    /* Upgrade to the secondary image, permanent for the swap */
+    HARNESS_PHASE_UPGRADE,
+    /* Swap: revert of a test upgrade that was not confirmed */
+    HARNESS_PHASE_REVERT,
+    HARNESS_PHASES
+} harness_phase_t;
+
+typedef struct {
+    uint32_t code_size;
+    uint32_t change_size;
+    uint32_t every;
+    uint32_t recut_percent;
+    uint32_t seed;
+    bool revert;
+    bool encrypt;
+    bool json;
+    sim_swap_timing_t timing;
+    sim_loader_cfg_t loader;
+} harness_options_t;
+
+typedef struct {
+    /* Flash operations and modelled time of the uninterrupted boot */
+    uint64_t ops;
+    uint64_t time_us;
+    uint32_t trials;
+    uint32_t cuts;
+    uint32_t recovered;
+    uint32_t wrong_image;
+    uint32_t no_boot;
+    uint32_t unsettled;
+    bench_stats_t boots;
+    bench_stats_t recovery_us;
+} harness_result_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const char *const phase_names[HARNESS_PHASES] = { "upgrade", "revert" };
+
+static image_t image_old;
+static image_t image_new;
+/* Image loaded to the secondary slot: the upgrade, or its encrypted copy */
+static image_t image_enc;
+static const image_t *image_upgrade = &image_new;
+static uint32_t extent_old;
+static uint32_t extent_new;
+static uint8_t work_erased[0x800];
+#if (HARNESS_SELECT)
+/* Bytes of the upgrade written to the secondary slot before the transfer
+ * stopped */
+static uint32_t xip_sent;
+#endif /* HARNESS_SELECT */
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name, const harness_options_t *opt) {
+    printf("Usage: %s [options]\n"
+           "Power failure harness of the " HARNESS_MODE " upgrade on the flash map of this build.\n"
+           "  --code-size N       code size of the image in the primary slot (default 0x%x)\n"
+           "  --change N          bytes of new code in the upgrade image (default 0x%x)\n"
+#if (HARNESS_SELECT)
+           "  --every N           stop the transfer of the upgrade at every N-th row (default %u)\n"
+#else
+           "  --every N           cut the power at every N-th flash operation (default %u)\n"
+#endif /* HARNESS_SELECT */
+           "  --recut PERCENT     chance of another power cut in each recovery boot (default %u)\n"
+#if (HARNESS_SWAP)
+           "  --journal           swap with the journaled swap (BOOT_SWAP_JOURNAL=1)\n"
+           "  --revert            also cut the power during the revert of a test upgrade\n"
+#elif defined(MCUBOOT_OVERWRITE_ONLY)
+           "  --encrypt           encrypted upgrade image (ENC_IMG=1)\n"
+#endif /* HARNESS_SWAP */
+#if defined(MCUBOOT_RAM_LOAD)
+           "  --copy-us-per-kb N  modelled time to copy 1 KB of an image to the SRAM (default %u)\n"
+#endif /* MCUBOOT_RAM_LOAD */
+           "  --hash-us-per-kb N  modelled time to hash 1 KB of an image (default %u)\n"
+#if defined(MCUBOOT_OVERWRITE_ONLY)
+           "  --aes-us-per-kb N   modelled time to decrypt 1 KB of an image (default %u)\n"
+           "  --ecdh-us N         modelled time to unwrap the key of an image (default %u)\n"
+#endif /* MCUBOOT_OVERWRITE_ONLY */
+           "  --code-erase-us N   modelled time to erase a code flash sector (default %u)\n"
+           "  --work-erase-us N   modelled time to erase a 2 KB work flash sector (default %u)\n"
+           "  --small-erase-us N  modelled time to erase a 128-byte work flash sector (default %u)\n"
+           "  --code-program-us N modelled time to program a 512-byte code flash row (default %u)\n"
+           "  --work-program-us N modelled time to program 32 bytes of work flash (default %u)\n"
+           "  --seed N            seed of the images and of the damage of the cuts (default 1)\n"
+           "  --json              machine-readable output\n",
+           name, opt->code_size, opt->change_size, opt->every, opt->recut_percent,
+#if defined(MCUBOOT_RAM_LOAD)
+           opt->loader.copy_us_per_kb,
+#endif /* MCUBOOT_RAM_LOAD */
+           opt->loader.hash_us_per_kb,
+#if defined(MCUBOOT_OVERWRITE_ONLY)
+           opt->loader.aes_us_per_kb, opt->loader.ecdh_us,
+#endif /* MCUBOOT_OVERWRITE_ONLY */
+           opt->timing.code_erase_us, opt->timing.work_erase_us, opt->timing.small_erase_us,
+           opt->timing.code_program_us, opt->timing.work_program_us);
+}
+
+/*******************************************************************************
+ * Function Name: harness_random
+ ********************************************************************************
+ * Returns the next number of a xorshift32 sequence.
+ *******************************************************************************/
+static uint32_t harness_random(uint32_t *state) {
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/*******************************************************************************
+ * Function Name: harness_images
+ ********************************************************************************
+ * Builds the image in the primary slot and its upgrade. The swap keeps the
+ * trailers in the swap status partition and the direct XIP mode has none,
+ * the trailer magic the post-build step places at the end of the slot is
+ * removed. An encrypted upgrade is loaded encrypted, the primary slot gets
+ * it decrypted. The RAM load images are linked for the load window, their
+ * stack at its end.
+ *******************************************************************************/
+static int harness_images(const harness_options_t *opt) {
+    if ((image_synthetic(PRIMARY_IMG_START, SLOT_SIZE, opt->code_size, opt->seed, &image_old) != 0) ||
+        (image_synthetic_update(&image_old, opt->change_size, opt->seed + 1u, &image_new) != 0)) {
+        return -1;
+    }
+#if defined(MCUBOOT_RAM_LOAD)
+    if ((image_ram_load(&image_old, IMAGE_EXECUTABLE_RAM_START,
+                        IMAGE_EXECUTABLE_RAM_START + IMAGE_EXECUTABLE_RAM_SIZE) != 0) ||
+        (image_ram_load(&image_new, IMAGE_EXECUTABLE_RAM_START,
+                        IMAGE_EXECUTABLE_RAM_START + IMAGE_EXECUTABLE_RAM_SIZE) != 0)) {
+        return -1;
+    }
+#endif /* MCUBOOT_RAM_LOAD */
+    if (opt->encrypt) {
+        if (image_encrypt(&image_new, opt->seed + 2u, &image_enc) != 0) {
+            return -1;
+        }
+        image_upgrade = &image_enc;
+    }
+    extent_old = image_extent(&image_old);
+    extent_new = image_extent(&image_new);
+    /* Only the upgrade image carries the request */
+    memset(&image_old.data[SLOT_SIZE - HARNESS_MAGIC_SIZE], 0xFF, HARNESS_MAGIC_SIZE);
+#if !defined(MCUBOOT_OVERWRITE_ONLY)
+    memset(&image_new.data[SLOT_SIZE - HARNESS_MAGIC_SIZE], 0xFF, HARNESS_MAGIC_SIZE);
+#endif /* !MCUBOOT_OVERWRITE_ONLY */
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: harness_slots_hold
+ ********************************************************************************
+ * Returns true if the primary slot holds the given image, and for the swap
+ * the secondary slot the other one.
+ *******************************************************************************/
+static bool harness_slots_hold(const image_t *primary, uint32_t primary_size, const image_t *secondary,
+                               uint32_t secondary_size) {
+    const uint8_t *p = sim_flash_ptr(PRIMARY_IMG_START, primary_size);
+    const uint8_t *s = sim_flash_ptr(SECONDARY_IMG_START, secondary_size);
+
+#if defined(MCUBOOT_OVERWRITE_ONLY)
+    (void)s;
+    (void)secondary;
+    return (p != NULL) && (memcmp(p, primary->data, primary_size) == 0);
+#else
+    /* No secondary image: the slot is not checked */
+    return (p != NULL) && (memcmp(p, primary->data, primary_size) == 0) &&
+           ((secondary == NULL) || ((s != NULL) && (memcmp(s, secondary->data, secondary_size) == 0)));
+#endif /* MCUBOOT_OVERWRITE_ONLY */
+}
+
+#if defined(MCUBOOT_RAM_LOAD)
+/*******************************************************************************
+ * Function Name: harness_ram_holds
+ ********************************************************************************
+ * Returns true if the load window of the SRAM starts with the given image.
+ *******************************************************************************/
+static bool harness_ram_holds(const image_t *image, uint32_t size) {
+    uint32_t ram_size;
+    const uint8_t *ram = sim_loader_ram(&ram_size);
+
+    return (ram != NULL) && (size <= ram_size) && (memcmp(ram, image->data, size) == 0);
+}
+#endif /* MCUBOOT_RAM_LOAD */
+
+/*******************************************************************************
+ * Function Name: harness_expected
+ ********************************************************************************
+ * Returns true if the slots hold what the phase leaves in them and the image
+ * started from the slot it should. In the RAM load mode, the SRAM must hold
+ * the copy of that slot.
+ *
+ * Parameters:
+ *  slot           Address of the slot of the started image.
+ *******************************************************************************/
+static bool harness_expected(harness_phase_t phase, uint32_t slot) {
+#if defined(MCUBOOT_RAM_LOAD)
+    /* Both images stay in their slots, the upgrade is copied if it arrived
+     * whole */
+    (void)phase;
+    if (xip_sent < extent_new) {
+        return (slot == PRIMARY_IMG_START) && harness_slots_hold(&image_old, extent_old, NULL, 0u) &&
+               harness_ram_holds(&image_old, extent_old);
+    }
+    return (slot == SECONDARY_IMG_START) && harness_slots_hold(&image_old, extent_old, &image_new, extent_new) &&
+           harness_ram_holds(&image_new, extent_new);
+#elif defined(MCUBOOT_DIRECT_XIP)
+    /* Both images stay in place: the upgrade runs if it arrived whole */
+    (void)phase;
+    if (xip_sent < extent_new) {
+        return (slot == PRIMARY_IMG_START) && harness_slots_hold(&image_old, extent_old, NULL, 0u);
+    }
+    return (slot == SECONDARY_IMG_START) && harness_slots_hold(&image_old, extent_old, &image_new, extent_new);
+#else
+    if (slot != PRIMARY_IMG_START) {
+        return false;
+    }
+    if (phase == HARNESS_PHASE_UPGRADE) {
+        return harness_slots_hold(&image_new, extent_new, &image_old, extent_old);
+    }
+    return harness_slots_hold(&image_old, extent_old, &image_new, extent_new);
+#endif /* MCUBOOT_RAM_LOAD */
+}
+
+/*******************************************************************************
+ * Function Name: harness_erase_work_flash
+ ********************************************************************************
+ * Erases the work flash, which holds the scratch area, the swap status
+ * partition and the journal, faster than a new flash model.
+ *******************************************************************************/
+static int harness_erase_work_flash(void) {
+    static const uint8_t devices[] = { INTERNAL_FLASH_WORK_LARGE, INTERNAL_FLASH_WORK_SMALL };
+
+    for (uint32_t i = 0u; i < sizeof(devices); i++) {
+        const struct flash_device *device = &flash_devices[devices[i]];
+
+        for (uint32_t off = 0u; off < device->size; off += sizeof(work_erased)) {
+            if (sim_flash_load(device->address + off, work_erased, sizeof(work_erased)) != 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: harness_setup
+ ********************************************************************************
+ * Puts the flash in the state before the phase: the image in the primary
+ * slot, the upgrade image in the secondary slot with its request. The revert
+ * phase starts after the test upgrade has booted once. In the direct XIP
+ * and RAM load modes the secondary slot holds the first xip_sent bytes of the upgrade and
+ * is erased after them.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int harness_setup(const harness_options_t *opt, harness_phase_t phase) {
+    sim_loader_rsp_t rsp;
+
+    sim_swap_port_power_on();
+    sim_loader_power_on();
+    sim_swap_port_cut_after(0u, 0u);
+    if ((harness_erase_work_flash() != 0) || (sim_flash_load(PRIMARY_IMG_START, image_old.data, SLOT_SIZE) != 0) ||
+        (sim_flash_load(SECONDARY_IMG_START, image_upgrade->data, SLOT_SIZE) != 0) ||
+        (sim_loader_set_pending(phase == HARNESS_PHASE_UPGRADE) != 0)) {
+        return -1;
+    }
+#if (HARNESS_SELECT)
+    for (uint32_t off = xip_sent; off < SLOT_SIZE; off += sizeof(work_erased)) {
+        uint32_t length = ((SLOT_SIZE - off) < sizeof(work_erased)) ? (SLOT_SIZE - off) : sizeof(work_erased);
+
+        if (sim_flash_load(SECONDARY_IMG_START + off, work_erased, length) != 0) {
+            return -1;
+        }
+    }
+#endif /* HARNESS_SELECT */
+    if (phase == HARNESS_PHASE_REVERT) {
+        sim_loader_boot_go(&opt->loader, &rsp);
+        if (!rsp.booted || !harness_expected(HARNESS_PHASE_UPGRADE, rsp.slot)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: harness_boot_until_up
+ ********************************************************************************
+ * Boots after a power cut until an image starts. Each boot may lose the
+ * power again with the chance set by --recut.
+ *
+ * Parameters:
+ *  boots          Receives the boots.
+ *  time_us        Receives the modelled time of the boots.
+ *  slot           Receives the address of the slot of the started image.
+ *
+ * Return:
+ *  true if an image started.
+ *******************************************************************************/
+static bool harness_boot_until_up(const harness_options_t *opt, uint64_t ops, uint32_t *state, uint32_t *boots,
+                                  uint64_t *time_us, uint32_t *cuts, uint32_t *slot) {
+    *boots = 0u;
+    *time_us = 0u;
+    while (*boots < HARNESS_MAX_BOOTS) {
+        sim_loader_rsp_t rsp;
+
+        sim_swap_port_power_on();
+        sim_loader_power_on();
+        if ((opt->recut_percent != 0u) && ((harness_random(state) % 100u) < opt->recut_percent)) {
+            sim_swap_port_cut_after(1u + (harness_random(state) % ops), harness_random(state));
+        }
+        sim_loader_boot_go(&opt->loader, &rsp);
+        (*boots)++;
+        *time_us += rsp.time_us;
+        if (!sim_swap_port_powered()) {
+            (*cuts)++;
+            continue;
+        }
+        *slot = rsp.slot;
+        return rsp.booted;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ * Function Name: harness_settled
+ ********************************************************************************
+ * Returns true if the next boot starts the image without writing the flash.
+ *******************************************************************************/
+static bool harness_settled(const harness_options_t *opt) {
+    uint64_t start = sim_swap_port_ops();
+    sim_loader_rsp_t rsp;
+
+    sim_loader_boot_go(&opt->loader, &rsp);
+    return rsp.booted && (sim_swap_port_ops() == start);
+}
+
+/*******************************************************************************
+ * Function Name: harness_phase
+ ********************************************************************************
+ * Runs one phase: an uninterrupted boot for reference, then one trial per
+ * N-th flash operation of that boot with the power cut during it. The direct
+ * XIP and RAM load modes start the upgrade without a flash operation: the
+ * trials stop the
+ * transfer of the upgrade at every N-th row instead, and the boots after it
+ * must start the old image.
+ *
+ * Return:
+ *  0 on success, -1 if the phase cannot run.
+ *******************************************************************************/
+static int harness_phase(const harness_options_t *opt, harness_phase_t phase, harness_result_t *result) {
+    uint32_t state = (opt->seed * 2654435761u) | 1u;
+    uint32_t *boots;
+    uint32_t *recovery;
+    uint64_t start;
+    sim_loader_rsp_t rsp;
+
+    uint64_t steps;
+    uint64_t recut_ops;
+    uint32_t slot = 0u;
+
+    memset(result, 0, sizeof(*result));
+#if (HARNESS_SELECT)
+    xip_sent = SLOT_SIZE;
+#endif /* HARNESS_SELECT */
+    if (harness_setup(opt, phase) != 0) {
+        return -1;
+    }
+    start = sim_swap_port_ops();
+    sim_loader_boot_go(&opt->loader, &rsp);
+    result->ops = sim_swap_port_ops() - start;
+    result->time_us = rsp.time_us;
+#if (HARNESS_SELECT)
+    if (!rsp.booted || !harness_expected(phase, rsp.slot) || (result->ops != 0u)) {
+        fprintf(stderr, "%s: the uninterrupted boot does not start the upgrade\n", phase_names[phase]);
+        return -1;
+    }
+    steps = (extent_new + HARNESS_ROW_SIZE - 1u) / HARNESS_ROW_SIZE - 1u;
+    /* A recut falls in the erase of the partial upgrade */
+    recut_ops = SLOT_SIZE / sim_flash_erase_size(SECONDARY_IMG_START);
+#else
+    if (!rsp.booted || !harness_expected(phase, rsp.slot) || (result->ops == 0u)) {
+        fprintf(stderr, "%s: the uninterrupted boot does not %s\n", phase_names[phase], phase_names[phase]);
+        return -1;
+    }
+    steps = result->ops;
+    recut_ops = result->ops;
+#endif /* HARNESS_SELECT */
+
+    boots = malloc(sizeof(uint32_t) * (size_t)(steps / opt->every + 1u));
+    recovery = malloc(sizeof(uint32_t) * (size_t)(steps / opt->every + 1u));
+    if ((boots == NULL) || (recovery == NULL)) {
+        free(boots);
+        free(recovery);
+        return -1;
+    }
+
+    for (uint64_t cut = opt->every; cut <= steps; cut += opt->every) {
+        uint32_t trial_boots;
+        uint64_t time_us;
+        bool up;
+
+#if (HARNESS_SELECT)
+        /* The transfer stops after the row, the boots that follow recover */
+        xip_sent = (uint32_t)cut * HARNESS_ROW_SIZE;
+#endif /* HARNESS_SELECT */
+        if (harness_setup(opt, phase) != 0) {
+            free(boots);
+            free(recovery);
+            return -1;
+        }
+#if !(HARNESS_SELECT)
+        sim_swap_port_cut_after(cut, harness_random(&state));
+        sim_loader_boot_go(&opt->loader, &rsp);
+#endif /* !HARNESS_SELECT */
+        result->trials++;
+        result->cuts++;
+
+        up = harness_boot_until_up(opt, recut_ops, &state, &trial_boots, &time_us, &result->cuts, &slot);
+        if (!up) {
+            result->no_boot++;
+            fprintf(stderr, "%s: cut at operation %llu: no image starts\n", phase_names[phase],
+                    (unsigned long long)cut);
+        } else if (!harness_expected(phase, slot)) {
+            result->wrong_image++;
+            fprintf(stderr, "%s: cut at operation %llu: the slots do not hold the expected images\n",
+                    phase_names[phase], (unsigned long long)cut);
+        } else if (!harness_settled(opt)) {
+            result->unsettled++;
+            fprintf(stderr, "%s: cut at operation %llu: the next boot writes the flash again\n",
+                    phase_names[phase], (unsigned long long)cut);
+        } else {
+            boots[result->recovered] = trial_boots;
+            recovery[result->recovered] = (time_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)time_us;
+            result->recovered++;
+        }
+    }
+    bench_stats_compute(boots, result->recovered, &result->boots);
+    bench_stats_compute(recovery, result->recovered, &result->recovery_us);
+    free(boots);
+    free(recovery);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: print_result
+ ********************************************************************************
+ * Prints the result of one phase.
+ *******************************************************************************/
+static void print_result(harness_phase_t phase, const harness_result_t *r) {
+    printf("  %s\n", phase_names[phase]);
+    printf("    uninterrupted     : %llu flash operations, %.1f ms\n", (unsigned long long)r->ops,
+           r->time_us / 1000.0);
+    printf("    trials            : %u, %u power cuts\n", r->trials, r->cuts);
+    printf("    model recovered   : %u (%u wrong image, %u no image, %u not settled)\n", r->recovered,
+           r->wrong_image, r->no_boot, r->unsettled);
+    if (r->recovered != 0u) {
+        printf("    boots             : mean %.2f, p50 %u, p90 %u, p99 %u, max %u\n", r->boots.mean, r->boots.p50,
+               r->boots.p90, r->boots.p99, r->boots.max);
+        printf("    recovery time     : mean %.1f ms, min %.1f, p50 %.1f, p90 %.1f, p99 %.1f, max %.1f\n",
+               r->recovery_us.mean / 1000.0, r->recovery_us.min / 1000.0, r->recovery_us.p50 / 1000.0,
+               r->recovery_us.p90 / 1000.0, r->recovery_us.p99 / 1000.0, r->recovery_us.max / 1000.0);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: print_result_json
+ ********************************************************************************
+ * Prints the result of one phase as JSON.
+ *******************************************************************************/
+static void print_result_json(harness_phase_t phase, const harness_result_t *r) {
+    printf("\"%s\": {\"ops\": %llu, \"time_us\": %llu, \"trials\": %u, \"cuts\": %u, \"recovered\": %u, "
+           "\"wrong_image\": %u, \"no_image\": %u, \"unsettled\": %u, "
+           "\"boots\": {\"mean\": %.2f, \"p50\": %u, \"p90\": %u, \"p99\": %u, \"max\": %u}, "
+           "\"recovery_us\": {\"mean\": %.0f, \"min\": %u, \"p50\": %u, \"p90\": %u, \"p99\": %u, \"max\": %u}}",
+           phase_names[phase], (unsigned long long)r->ops, (unsigned long long)r->time_us, r->trials, r->cuts,
+           r->recovered, r->wrong_image, r->no_boot, r->unsettled, r->boots.mean, r->boots.p50, r->boots.p90,
+           r->boots.p99, r->boots.max, r->recovery_us.mean, r->recovery_us.min, r->recovery_us.p50,
+           r->recovery_us.p90, r->recovery_us.p99, r->recovery_us.max);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Runs the phases and prints the report.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "code-size",       required_argument, NULL, 'c' },
+        { "change",          required_argument, NULL, 'C' },
+        { "every",           required_argument, NULL, 'n' },
+        { "recut",           required_argument, NULL, 'r' },
+        { "journal",         no_argument,       NULL, 'J' },
+        { "revert",          no_argument,       NULL, 'R' },
+        { "encrypt",         no_argument,       NULL, 'X' },
+        { "copy-us-per-kb",  required_argument, NULL, 'Y' },
+        { "hash-us-per-kb",  required_argument, NULL, 'G' },
+        { "aes-us-per-kb",   required_argument, NULL, 'A' },
+        { "ecdh-us",         required_argument, NULL, 'D' },
+        { "code-erase-us",   required_argument, NULL, 'E' },
+        { "work-erase-us",   required_argument, NULL, 'W' },
+        { "small-erase-us",  required_argument, NULL, 'V' },
+        { "code-program-us", required_argument, NULL, 'P' },
+        { "work-program-us", required_argument, NULL, 'Q' },
+        { "seed",            required_argument, NULL, 'S' },
+        { "json",            no_argument,       NULL, 'j' },
+        { "help",            no_argument,       NULL, 'h' },
+        { NULL,              0,                 NULL, 0 },
+    };
+    /* Assumed typical durations, as swap_bench */
+    harness_options_t opt = {
+        .code_size = 0x10000u,
+        .change_size = 0x400u,
+        .every = 1u,
+        .recut_percent = 0u,
+        .seed = 1u,
+        .revert = false,
+        .encrypt = false,
+        .json = false,
+        .timing = {
+            .code_erase_us = 45000u,
+            .work_erase_us = 20000u,
+            .small_erase_us = 8000u,
+            .code_program_us = 1300u,
+            .work_program_us = 70u,
+        },
+        .loader = {
+            .journal = false,
+            .hash_us_per_kb = 60u,
+            .aes_us_per_kb = 50u,
+            .ecdh_us = 60000u,
+            .ram_fault = false,
+            .copy_us_per_kb = 15u,
+        },
+    };
+    harness_result_t results[HARNESS_PHASES];
+    uint32_t failures = 0u;
+    uint32_t phases = 1u;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'c': opt.code_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'C': opt.change_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'n': opt.every = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'r': opt.recut_percent = (uint32_t)strtoul(optarg, NULL, 0); break;
+#if (HARNESS_SWAP)
+        case 'J': opt.loader.journal = true; break;
+        case 'R': opt.revert = true; break;
+#elif defined(MCUBOOT_OVERWRITE_ONLY)
+        case 'X': opt.encrypt = true; break;
+        case 'A': opt.loader.aes_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'D': opt.loader.ecdh_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+#endif /* HARNESS_SWAP */
+#if defined(MCUBOOT_RAM_LOAD)
+        case 'Y': opt.loader.copy_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0); break;
+#endif /* MCUBOOT_RAM_LOAD */
+        case 'G': opt.loader.hash_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'E': opt.timing.code_erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'W': opt.timing.work_erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'V': opt.timing.small_erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'P': opt.timing.code_program_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'Q': opt.timing.work_program_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'S': opt.seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'j': opt.json = true; break;
+        default: usage(argv[0], &opt); return (c == 'h') ? 0 : 2;
+        }
+    }
+    if ((opt.every == 0u) || (opt.recut_percent > 100u)) {
+        usage(argv[0], &opt);
+        return 2;
+    }
+
+    sim_swap_port_set_timing(&opt.timing);
+    memset(work_erased, 0xFF, sizeof(work_erased));
+    if ((sim_flash_init() != 0) || (sim_loader_init() != 0) || (harness_images(&opt) != 0)) {
+        fprintf(stderr, "cannot set up the images and the flash areas\n");
+        return 1;
+    }
+    if (opt.revert) {
+        phases = HARNESS_PHASES;
+    }
+    for (uint32_t phase = 0u; phase < phases; phase++) {
+        if (harness_phase(&opt, (harness_phase_t)phase, &results[phase]) != 0) {
+            return 1;
+        }
+        failures += results[phase].trials - results[phase].recovered;
+    }
+
+    if (opt.json) {
+        printf("{\"model\": \"sim_loader\", \"mode\": \"%s\", \"journal\": %s, \"encrypt\": %s, \"image_size\": %u, "
+               "\"upgrade_size\": %u, \"every\": %u, \"recut_percent\": %u, ",
+               HARNESS_MODE, opt.loader.journal ? "true" : "false", opt.encrypt ? "true" : "false", extent_old,
+               extent_new, opt.every, opt.recut_percent);
+        for (uint32_t phase = 0u; phase < phases; phase++) {
+            print_result_json((harness_phase_t)phase, &results[phase]);
+            printf("%s", (phase + 1u < phases) ? ", " : "");
+        }
+        printf("}\n");
+    } else {
+        printf("Boot harness, %s%s upgrade%s\n", opt.encrypt ? "encrypted " : "", HARNESS_MODE,
+               opt.loader.journal ? " with the journaled swap" : "");
+        printf("  bootloader          : boot_go() model of sim_loader.c, not MCUboot's bootutil\n");
+#if (HARNESS_SELECT)
+        printf("  images              : 0x%x and 0x%x bytes, transfer stopped at every %u. row\n", extent_old,
+               extent_new, opt.every);
+#else
+        printf("  images              : 0x%x and 0x%x bytes, power cut at every %u. flash operation\n", extent_old,
+               extent_new, opt.every);
+#endif /* HARNESS_SELECT */
+        for (uint32_t phase = 0u; phase < phases; phase++) {
+            print_result((harness_phase_t)phase, &results[phase]);
+        }
+    }
+    image_free(&image_old);
+    image_free(&image_new);
+    image_free(&image_enc);
+    sim_flash_deinit();
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
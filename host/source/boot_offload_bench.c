@@ -0,0 +1,491 @@
+/******************************************************************************
+ * File Name:   boot_offload_bench.c
+ *
+ * Description: Benchmark of the validation of the slots by the bootloader with the CM7 hashing
+ *              stub: the stub runs on a host thread over synthetic images, and the boot time
+ *              with and without the stub is projected from an assumed cost of each step. The
+ *              projection does not read the BOOT_TIMING marks of a target.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "boot_cm7_hash.h"
+#include "boot_timing.h"
+#include "dfu_digest.h"
+#include "dfu_packet.h"
+#include "dfu_sha256.h"
+#include "image_file.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define BENCH_DEFAULT_CODE_SIZE     (0x10000u)
+
+/* Modelled costs of the validation steps on the target, see usage() */
+#define BENCH_DEFAULT_CM0_US_PER_KB (1000u)
+#define BENCH_DEFAULT_CM7_US_PER_KB (100u)
+#define BENCH_DEFAULT_START_US      (50u)
+#define BENCH_DEFAULT_HEADER_US     (100u)
+#define BENCH_DEFAULT_TLV_US        (200u)
+#define BENCH_DEFAULT_KEY_US        (1000u)
+#define BENCH_DEFAULT_VERIFY_US     (60000u)
+
+/* Slots validated by one boot */
+#define BENCH_MAX_SLOTS             (2u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    /* MCUboot hashes the slots on the CM0+ */
+    BENCH_MODE_CM0,
+    /* The stub hashes the slots while the CM0+ reads the TLVs and the key */
+    BENCH_MODE_CM7,
+    BENCH_MODE_COUNT
+} bench_mode_t;
+
+typedef struct {
+    uint32_t code_size;
+    uint32_t cm0_us_per_kb;
+    uint32_t cm7_us_per_kb;
+    uint32_t start_us;
+    uint32_t header_us;
+    uint32_t tlv_us;
+    uint32_t key_us;
+    uint32_t verify_us;
+    int json;
+} bench_options_t;
+
+typedef struct {
+    const char *name;
+    uint32_t count;
+    /* Slots validated by the boot: 0 primary, 1 secondary */
+    uint32_t slots[BENCH_MAX_SLOTS];
+} bench_scenario_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const char *const mode_names[BENCH_MODE_COUNT] = { "cm0+ only", "cm7 hash" };
+
+/* Boots of image 1 of the overwrite upgrade: the primary slot is validated on
+ * every boot, the secondary slot before an upgrade */
+static const bench_scenario_t scenarios[] = {
+    { "boot",            1u, { 0u } },
+    { "upgrade",         2u, { 1u, 0u } },
+};
+
+/* Images of the slots, read by the stub through boot_cm7_hash_flash() */
+static image_t bench_images[BENCH_MAX_SLOTS];
+
+/* Shared SRAM of the stub */
+static boot_cm7_hash_job_t bench_job;
+
+/* Table of the modelled boot */
+static boot_timing_t bench_timing;
+static uint32_t bench_now_us;
+
+/* Set when the stub thread returns */
+static int bench_stub_exited;
+
+/*******************************************************************************
+ * Function Name: boot_cm7_hash_job
+ ********************************************************************************
+ * Return:
+ *  The job shared by the CM0+ model and the stub thread.
+ *******************************************************************************/
+boot_cm7_hash_job_t *boot_cm7_hash_job(void) {
+    return &bench_job;
+}
+
+/*******************************************************************************
+ * Function Name: boot_cm7_hash_flash
+ ********************************************************************************
+ * Return:
+ *  Pointer to the contents of a slot, NULL if the range is in no slot.
+ *******************************************************************************/
+const uint8_t *boot_cm7_hash_flash(uint32_t address, uint32_t length) {
+    for (uint32_t i = 0u; i < BENCH_MAX_SLOTS; i++) {
+        const image_t *image = &bench_images[i];
+
+        if ((address >= image->address) &&
+            ((uint64_t)address + length <= (uint64_t)image->address + image->size)) {
+            return &image->data[address - image->address];
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name) {
+    printf("Usage: %s [options]\n"
+           "  --code-size N       code size of the synthetic images (default 0x%x)\n"
+           "  --cm0-us-per-kb N   modelled time to hash 1 KB on the CM0+ (default %u)\n"
+           "  --cm7-us-per-kb N   modelled time to hash 1 KB on the CM7 (default %u)\n"
+           "  --start-us N        modelled time to start the stub on the CM7 (default %u)\n"
+           "  --header-us N       modelled time to read an image header (default %u)\n"
+           "  --tlv-us N          modelled time to read the TLVs of an image (default %u)\n"
+           "  --key-us N          modelled time to find and load the public key (default %u)\n"
+           "  --verify-us N       modelled time of an ECDSA P-256 verification (default %u)\n"
+           "  --json              machine-readable output\n",
+           name, BENCH_DEFAULT_CODE_SIZE, BENCH_DEFAULT_CM0_US_PER_KB, BENCH_DEFAULT_CM7_US_PER_KB,
+           BENCH_DEFAULT_START_US, BENCH_DEFAULT_HEADER_US, BENCH_DEFAULT_TLV_US,
+           BENCH_DEFAULT_KEY_US, BENCH_DEFAULT_VERIFY_US);
+}
+
+/*******************************************************************************
+ * Function Name: host_us
+ ********************************************************************************
+ * Return:
+ *  Monotonic time of the host in microseconds.
+ *******************************************************************************/
+static uint64_t host_us(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+/*******************************************************************************
+ * Function Name: get_u16
+ ********************************************************************************
+ * Reads a little endian 16-bit value.
+ *******************************************************************************/
+static uint32_t get_u16(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+/*******************************************************************************
+ * Function Name: stub_thread
+ ********************************************************************************
+ * The CM7 core running the stub.
+ *******************************************************************************/
+static void *stub_thread(void *arg) {
+    (void)arg;
+    boot_cm7_hash_run();
+    __atomic_store_n(&bench_stub_exited, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function Name: validate_slot
+ ********************************************************************************
+ * Validates a slot as boot_hooks_check_digest() does: the stub hashes the
+ * image while this thread walks the TLVs, then the digest is compared with
+ * the SHA256 TLV.
+ *
+ * Parameters:
+ *  image          Image in the slot.
+ *  hashed         Receives the bytes hashed by the stub.
+ *
+ * Return:
+ *  true if the digest of the stub matches the SHA256 TLV.
+ *******************************************************************************/
+static bool validate_slot(const image_t *image, uint32_t *hashed) {
+    const uint8_t *p = image->data;
+    const uint8_t *sha = NULL;
+    uint8_t digest[BOOT_CM7_HASH_DIGEST_SIZE];
+    pthread_t cm7;
+    uint32_t extent;
+    uint32_t tlv_size;
+    bool done;
+
+    *hashed = 0u;
+    if (dfu_packet_get_u32(p) != DFU_DIGEST_IMAGE_MAGIC) {
+        return false;
+    }
+    extent = get_u16(&p[8]) + get_u16(&p[10]) + dfu_packet_get_u32(&p[12]);
+    if ((extent + 4u > image->size) || (get_u16(&p[extent]) != DFU_DIGEST_TLV_INFO_MAGIC)) {
+        return false;
+    }
+
+    boot_cm7_hash_request(image->address, extent);
+    bench_stub_exited = 0;
+    if (pthread_create(&cm7, NULL, stub_thread, NULL) != 0) {
+        return false;
+    }
+
+    tlv_size = get_u16(&p[extent + 2u]);
+    for (uint32_t off = 4u; (off + 4u <= tlv_size) && (extent + tlv_size <= image->size);) {
+        const uint8_t *tlv = &p[extent + off];
+        uint32_t length = get_u16(&tlv[2]);
+
+        if ((get_u16(tlv) == DFU_DIGEST_TLV_SHA256) && (length == DFU_SHA256_SIZE)) {
+            sha = &tlv[4];
+        }
+        off += 4u + length;
+    }
+
+    do {
+        done = boot_cm7_hash_done(digest);
+    } while (!done && (__atomic_load_n(&bench_stub_exited, __ATOMIC_ACQUIRE) == 0));
+    pthread_join(cm7, NULL);
+    done = done || boot_cm7_hash_done(digest);
+
+    *hashed = bench_job.hashed;
+    return done && (sha != NULL) && (memcmp(sha, digest, DFU_SHA256_SIZE) == 0);
+}
+
+/*******************************************************************************
+ * Function Name: bench_mark
+ ********************************************************************************
+ * Records a phase of the modelled boot at the modelled time.
+ *******************************************************************************/
+static void bench_mark(boot_phase_t phase, uint32_t arg) {
+    if (bench_timing.count < BOOT_TIMING_MAX_ENTRIES) {
+        boot_timing_entry_t *entry = &bench_timing.entries[bench_timing.count];
+
+        entry->phase = (uint16_t)phase;
+        entry->arg = (uint16_t)arg;
+        entry->time_us = bench_now_us;
+        bench_timing.count++;
+    } else {
+        bench_timing.dropped++;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: model_boot
+ ********************************************************************************
+ * Models the validation of the slots of a boot and records its phases.
+ *
+ * Parameters:
+ *  opts           Modelled costs.
+ *  scenario       Slots validated.
+ *  mode           Where the slots are hashed.
+ *  extent         Bytes hashed per slot.
+ *
+ * Return:
+ *  Modelled time from boot_go() to the launch in microseconds.
+ *******************************************************************************/
+static uint32_t model_boot(const bench_options_t *opts, const bench_scenario_t *scenario,
+                           bench_mode_t mode, uint32_t extent) {
+    uint32_t cm0_hash_us = (uint32_t)(((uint64_t)extent * opts->cm0_us_per_kb) / 1024u);
+    uint32_t cm7_hash_us = (uint32_t)(((uint64_t)extent * opts->cm7_us_per_kb) / 1024u);
+
+    memset(&bench_timing, 0, sizeof(bench_timing));
+    bench_now_us = 0u;
+    bench_mark(BOOT_PHASE_BOOT_GO, 0xFFFFu);
+
+    for (uint32_t i = 0u; i < scenario->count; i++) {
+        uint32_t slot = scenario->slots[i];
+
+        bench_mark(BOOT_PHASE_READ_HEADER, slot);
+        bench_now_us += opts->header_us;
+        bench_mark(BOOT_PHASE_VALIDATE, slot);
+        if (mode == BENCH_MODE_CM7) {
+            uint32_t hash_end;
+
+            bench_mark(BOOT_PHASE_HASH_START, slot);
+            hash_end = bench_now_us + opts->start_us + cm7_hash_us;
+            bench_now_us += opts->tlv_us + opts->key_us;
+            bench_mark(BOOT_PHASE_HASH_WAIT, slot);
+            if (bench_now_us < hash_end) {
+                bench_now_us = hash_end;
+            }
+            bench_mark(BOOT_PHASE_VERIFY_SIG, slot);
+        } else {
+            /* bootutil_img_validate(): hash, then the TLVs and the key */
+            bench_now_us += cm0_hash_us + opts->tlv_us + opts->key_us;
+        }
+        bench_now_us += opts->verify_us;
+    }
+
+    bench_mark(BOOT_PHASE_LAUNCH, 0xFFFFu);
+    bench_timing.magic = BOOT_TIMING_MAGIC;
+    bench_timing.version = BOOT_TIMING_VERSION;
+    return bench_now_us;
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Runs the stub over the synthetic images and prints the modelled boot times.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "code-size",     required_argument, NULL, 'c' },
+        { "cm0-us-per-kb", required_argument, NULL, '0' },
+        { "cm7-us-per-kb", required_argument, NULL, '7' },
+        { "start-us",      required_argument, NULL, 's' },
+        { "header-us",     required_argument, NULL, 'r' },
+        { "tlv-us",        required_argument, NULL, 't' },
+        { "key-us",        required_argument, NULL, 'k' },
+        { "verify-us",     required_argument, NULL, 'v' },
+        { "json",          no_argument,       NULL, 'j' },
+        { "help",          no_argument,       NULL, 'h' },
+        { NULL,            0,                 NULL, 0 },
+    };
+    bench_options_t opts = {
+        .code_size = BENCH_DEFAULT_CODE_SIZE,
+        .cm0_us_per_kb = BENCH_DEFAULT_CM0_US_PER_KB,
+        .cm7_us_per_kb = BENCH_DEFAULT_CM7_US_PER_KB,
+        .start_us = BENCH_DEFAULT_START_US,
+        .header_us = BENCH_DEFAULT_HEADER_US,
+        .tlv_us = BENCH_DEFAULT_TLV_US,
+        .key_us = BENCH_DEFAULT_KEY_US,
+        .verify_us = BENCH_DEFAULT_VERIFY_US,
+        .json = 0,
+    };
+    const uint32_t slot_address[BENCH_MAX_SLOTS] = { IMG_1_PRIMARY_START, IMG_1_SECONDARY_START };
+    uint32_t times[sizeof(scenarios) / sizeof(scenarios[0])][BENCH_MODE_COUNT];
+    uint32_t hashed = 0u;
+    uint32_t extent;
+    uint64_t host_start;
+    uint64_t host_time;
+    bool valid = true;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'c':
+            opts.code_size = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case '0':
+            opts.cm0_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case '7':
+            opts.cm7_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            opts.start_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            opts.header_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            opts.tlv_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'k':
+            opts.key_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'v':
+            opts.verify_us = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'j':
+            opts.json = 1;
+            break;
+        case 'h':
+            usage(argv[0]);
+            return 0;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    for (uint32_t i = 0u; i < BENCH_MAX_SLOTS; i++) {
+        if (image_synthetic(slot_address[i], IMG_1_SLOT_SIZE, opts.code_size, i + 1u,
+                            &bench_images[i]) != 0) {
+            fprintf(stderr, "Code size 0x%x does not fit the slot of 0x%x bytes\n", opts.code_size,
+                    (uint32_t)IMG_1_SLOT_SIZE);
+            return 1;
+        }
+    }
+
+    /* The stub on a host thread checks the handshake and the digest, the
+     * boot times below are modelled */
+    host_start = host_us();
+    for (uint32_t i = 0u; i < BENCH_MAX_SLOTS; i++) {
+        uint32_t slot_hashed;
+
+        valid = validate_slot(&bench_images[i], &slot_hashed) && valid;
+        hashed += slot_hashed;
+    }
+    host_time = host_us() - host_start;
+    extent = hashed / BENCH_MAX_SLOTS;
+
+    for (uint32_t s = 0u; s < sizeof(scenarios) / sizeof(scenarios[0]); s++) {
+        for (uint32_t m = 0u; m < BENCH_MODE_COUNT; m++) {
+            times[s][m] = model_boot(&opts, &scenarios[s], (bench_mode_t)m, extent);
+        }
+    }
+
+    if (opts.json) {
+        printf("{\"extent\": %u, \"stub_valid\": %s, \"host_us\": %llu, \"projection\": true, \"scenarios\": [",
+               extent, valid ? "true" : "false", (unsigned long long)host_time);
+        for (uint32_t s = 0u; s < sizeof(scenarios) / sizeof(scenarios[0]); s++) {
+            printf("%s{\"scenario\": \"%s\"", (s == 0u) ? "" : ", ", scenarios[s].name);
+            for (uint32_t m = 0u; m < BENCH_MODE_COUNT; m++) {
+                printf(", \"%s_us\": %u", (m == BENCH_MODE_CM0) ? "cm0" : "cm7", times[s][m]);
+            }
+            printf("}");
+        }
+        printf("]}\n");
+    } else {
+        printf("Image          : %u bytes hashed per slot\n", extent);
+        printf("Stub           : %s on the host thread (%llu us for %u slots)\n",
+               valid ? "digests match the SHA256 TLVs" : "DIGEST MISMATCH",
+               (unsigned long long)host_time, BENCH_MAX_SLOTS);
+        printf("Projection     : assumed costs, not measured by BOOT_TIMING on a target\n");
+        printf("Assumed costs  : hash %u us/KB on the CM0+, %u us/KB on the CM7, stub start %u us,\n"
+               "                 header %u us, TLVs %u us, key %u us, signature %u us\n",
+               opts.cm0_us_per_kb, opts.cm7_us_per_kb, opts.start_us, opts.header_us, opts.tlv_us,
+               opts.key_us, opts.verify_us);
+        printf("\nProjected time from boot_go() to the launch\n");
+        printf("%-16s %12s %12s %8s\n", "scenario", mode_names[BENCH_MODE_CM0],
+               mode_names[BENCH_MODE_CM7], "saved");
+        for (uint32_t s = 0u; s < sizeof(scenarios) / sizeof(scenarios[0]); s++) {
+            uint32_t cm0 = times[s][BENCH_MODE_CM0];
+            uint32_t cm7 = times[s][BENCH_MODE_CM7];
+
+            printf("%-16s %9u us %9u us %7.1f%%\n", scenarios[s].name, cm0, cm7,
+                   (cm0 != 0u) ? 100.0 * ((double)cm0 - (double)cm7) / (double)cm0 : 0.0);
+        }
+
+        /* Projected phases of the upgrade with the stub, in the format of
+         * boot_timing_decode */
+        printf("\nProjected phases of the upgrade with the stub\n");
+        (void)model_boot(&opts, &scenarios[1], BENCH_MODE_CM7, extent);
+        boot_timing_print(&bench_timing);
+    }
+
+    for (uint32_t i = 0u; i < BENCH_MAX_SLOTS; i++) {
+        image_free(&bench_images[i]);
+    }
+    return valid ? 0 : 1;
+}
+
+/* [] END OF FILE */
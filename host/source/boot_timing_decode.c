@@ -0,0 +1,138 @@
+/******************************************************************************
+ * File Name:   boot_timing_decode.c
+ *
+ * Description: Host tool that decodes the boot timing table of the edge protect bootloader
+ *              from a binary dump of the RAM at BOOT_TIMING_ADDR, for example taken by the
+ *              debugger after the launch of the DFU application.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "boot_timing.h"
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name) {
+    printf("Usage: %s [options] DUMP\n"
+           "  --offset N          offset of the table in the dump (default 0)\n"
+           "  --json              machine-readable output\n",
+           name);
+}
+
+/*******************************************************************************
+ * Function Name: print_json
+ ********************************************************************************
+ * Prints the phases of the table as JSON.
+ *******************************************************************************/
+static void print_json(const boot_timing_t *table) {
+    printf("{\"cpu_hz\": %u, \"launch_us\": %u, \"dropped\": %u, \"phases\": [",
+           table->cpu_hz, table->entries[table->count - 1u].time_us, table->dropped);
+    for (uint32_t i = 0u; i + 1u < table->count; i++) {
+        const boot_timing_entry_t *entry = &table->entries[i];
+
+        printf("%s{\"phase\": \"%s\", ", (i == 0u) ? "" : ", ", boot_timing_phase_name(entry->phase));
+        if (entry->arg != 0xFFFFu) {
+            printf("\"arg\": %u, ", entry->arg);
+        }
+        printf("\"start_us\": %u, \"duration_us\": %u}", entry->time_us,
+               table->entries[i + 1u].time_us - entry->time_us);
+    }
+    printf("]}\n");
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Reads the dump and prints the boot phases.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "offset",      required_argument, NULL, 'o' },
+        { "json",        no_argument,       NULL, 'j' },
+        { "help",        no_argument,       NULL, 'h' },
+        { NULL,          0,                 NULL, 0 },
+    };
+    boot_timing_t table;
+    long offset = 0;
+    int json = 0;
+    FILE *file;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'o': offset = strtol(optarg, NULL, 0); break;
+        case 'j': json = 1; break;
+        default: usage(argv[0]); return (c == 'h') ? 0 : 2;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    file = fopen(argv[optind], "rb");
+    if (file == NULL) {
+        fprintf(stderr, "cannot open %s\n", argv[optind]);
+        return 1;
+    }
+    memset(&table, 0, sizeof(table));
+    if ((fseek(file, offset, SEEK_SET) != 0) || (fread(&table, 1u, sizeof(table), file) != sizeof(table))) {
+        fprintf(stderr, "%s: no table at offset %ld\n", argv[optind], offset);
+        fclose(file);
+        return 1;
+    }
+    fclose(file);
+
+    if (!boot_timing_valid(&table)) {
+        fprintf(stderr, "%s: no boot timing table, the bootloader did not launch an application "
+                "or was built without BOOT_TIMING=1\n", argv[optind]);
+        return 1;
+    }
+    if (json) {
+        print_json(&table);
+    } else {
+        boot_timing_print(&table);
+    }
+    return 0;
+}
+
+/* [] END OF FILE */
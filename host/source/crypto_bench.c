@@ -0,0 +1,342 @@
+/******************************************************************************
+ * File Name:   crypto_bench.c
+ *
+ * Description: Benchmark of the crypto backend of the image validation: runs the known-answer
+ *              tests, then measures the SHA-256 throughput and the ECDSA P-256 verifications per
+ *              second.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "boot_crypto.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define BENCH_DEFAULT_MIN_MS        (500u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t min_ms;
+    bool kat_only;
+    bool verbose;
+    int json;
+} bench_options_t;
+
+typedef struct {
+    uint32_t size;
+    double mb_per_s;
+} bench_hash_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+/* Hash sizes: a row, a flash page and a slot of the memory map */
+static const uint32_t bench_hash_sizes[] = { 512u, 4096u, SLOT_SIZE };
+
+/* RFC 6979 A.2.5, SHA-256 of "sample", also one of the known-answer tests */
+static const uint8_t bench_pub[BOOT_CRYPTO_P256_KEY_SIZE] = {
+    0x60u, 0xfeu, 0xd4u, 0xbau, 0x25u, 0x5au, 0x9du, 0x31u, 0xc9u, 0x61u, 0xebu, 0x74u,
+    0xc6u, 0x35u, 0x6du, 0x68u, 0xc0u, 0x49u, 0xb8u, 0x92u, 0x3bu, 0x61u, 0xfau, 0x6cu,
+    0xe6u, 0x69u, 0x62u, 0x2eu, 0x60u, 0xf2u, 0x9fu, 0xb6u, 0x79u, 0x03u, 0xfeu, 0x10u,
+    0x08u, 0xb8u, 0xbcu, 0x99u, 0xa4u, 0x1au, 0xe9u, 0xe9u, 0x56u, 0x28u, 0xbcu, 0x64u,
+    0xf2u, 0xf1u, 0xb2u, 0x0cu, 0x2du, 0x7eu, 0x9fu, 0x51u, 0x77u, 0xa3u, 0xc2u, 0x94u,
+    0xd4u, 0x46u, 0x22u, 0x99u,
+};
+static const uint8_t bench_hash[BOOT_CRYPTO_SHA256_SIZE] = {
+    0xafu, 0x2bu, 0xdbu, 0xe1u, 0xaau, 0x9bu, 0x6eu, 0xc1u, 0xe2u, 0xadu, 0xe1u, 0xd6u,
+    0x94u, 0xf4u, 0x1fu, 0xc7u, 0x1au, 0x83u, 0x1du, 0x02u, 0x68u, 0xe9u, 0x89u, 0x15u,
+    0x62u, 0x11u, 0x3du, 0x8au, 0x62u, 0xadu, 0xd1u, 0xbfu,
+};
+static const uint8_t bench_sig[BOOT_CRYPTO_P256_SIG_SIZE] = {
+    0xefu, 0xd4u, 0x8bu, 0x2au, 0xacu, 0xb6u, 0xa8u, 0xfdu, 0x11u, 0x40u, 0xddu, 0x9cu,
+    0xd4u, 0x5eu, 0x81u, 0xd6u, 0x9du, 0x2cu, 0x87u, 0x7bu, 0x56u, 0xaau, 0xf9u, 0x91u,
+    0xc3u, 0x4du, 0x0eu, 0xa8u, 0x4eu, 0xafu, 0x37u, 0x16u, 0xf7u, 0xcbu, 0x1cu, 0x94u,
+    0x2du, 0x65u, 0x7cu, 0x41u, 0xd4u, 0x36u, 0xc7u, 0xa1u, 0xb6u, 0xe2u, 0x9fu, 0x65u,
+    0xf3u, 0xe9u, 0x00u, 0xdbu, 0xb9u, 0xafu, 0xf4u, 0x06u, 0x4du, 0xc4u, 0xabu, 0x2fu,
+    0x84u, 0x3au, 0xcdu, 0xa8u,
+};
+
+static bool bench_verbose;
+static bool bench_quiet;
+static uint32_t bench_kat_count;
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name) {
+    printf("Usage: %s [options]\n"
+           "  --min-ms N          minimum duration of each measurement (default %u)\n"
+           "  --kat-only          run the known-answer tests only\n"
+           "  --verbose           print every known-answer test\n"
+           "  --json              machine-readable output\n"
+           "The exit code is 1 if a known-answer test fails.\n",
+           name, BENCH_DEFAULT_MIN_MS);
+}
+
+/*******************************************************************************
+ * Function Name: kat_report
+ ********************************************************************************
+ * Counts the known-answer tests, prints them with --verbose.
+ *******************************************************************************/
+static void kat_report(const char *name, bool passed) {
+    bench_kat_count++;
+    if (!bench_quiet && (bench_verbose || !passed)) {
+        printf("  %-28s %s\n", name, passed ? "passed" : "FAILED");
+    }
+}
+
+/*******************************************************************************
+ * Function Name: bench_sha256
+ ********************************************************************************
+ * Hashes a buffer again and again for at least min_ms.
+ *
+ * Return:
+ *  Throughput in MB/s.
+ *******************************************************************************/
+static double bench_sha256(const uint8_t *data, uint32_t size, uint32_t min_ms) {
+    uint8_t digest[BOOT_CRYPTO_SHA256_SIZE];
+    boot_crypto_sha256_t ctx;
+    uint64_t start = sim_time_us();
+    uint64_t elapsed;
+    uint64_t bytes = 0u;
+
+    do {
+        boot_crypto_sha256_init(&ctx);
+        boot_crypto_sha256_update(&ctx, data, size);
+        boot_crypto_sha256_final(&ctx, digest);
+        bytes += size;
+        elapsed = sim_time_us() - start;
+    } while (elapsed < (uint64_t)min_ms * 1000u);
+    return (double)bytes / (double)elapsed;
+}
+
+/*******************************************************************************
+ * Function Name: bench_verify
+ ********************************************************************************
+ * Verifies a valid signature again and again for at least min_ms.
+ *
+ * Return:
+ *  Verifications per second, 0 if the signature does not verify.
+ *******************************************************************************/
+static double bench_verify(uint32_t min_ms) {
+    uint64_t start = sim_time_us();
+    uint64_t elapsed;
+    uint32_t count = 0u;
+
+    do {
+        if (!boot_crypto_p256_verify(bench_pub, bench_hash, bench_sig)) {
+            return 0.0;
+        }
+        count++;
+        elapsed = sim_time_us() - start;
+    } while (elapsed < (uint64_t)min_ms * 1000u);
+    return (double)count * 1e6 / (double)elapsed;
+}
+
+/*******************************************************************************
+ * Function Name: bench_aes_ctr
+ ********************************************************************************
+ * Decrypts a buffer in place again and again for at least min_ms, as the
+ * bootloader decrypts an encrypted image.
+ *
+ * Return:
+ *  Throughput in MB/s.
+ *******************************************************************************/
+static double bench_aes_ctr(uint8_t *data, uint32_t size, uint32_t min_ms) {
+    boot_crypto_aes_t ctx;
+    uint64_t start = sim_time_us();
+    uint64_t elapsed;
+    uint64_t bytes = 0u;
+
+    boot_crypto_aes_init(&ctx, bench_hash);
+    do {
+        boot_crypto_aes_ctr(&ctx, 0u, data, data, size);
+        bytes += size;
+        elapsed = sim_time_us() - start;
+    } while (elapsed < (uint64_t)min_ms * 1000u);
+    boot_crypto_aes_free(&ctx);
+    return (double)bytes / (double)elapsed;
+}
+
+/*******************************************************************************
+ * Function Name: bench_ecdh
+ ********************************************************************************
+ * Computes an ECDH secret again and again for at least min_ms, as the
+ * bootloader unwraps the key of an encrypted image.
+ *
+ * Return:
+ *  Secrets per second, 0 if the public key is not on the curve.
+ *******************************************************************************/
+static double bench_ecdh(uint32_t min_ms) {
+    uint8_t shared[BOOT_CRYPTO_P256_PRIV_SIZE];
+    uint64_t start = sim_time_us();
+    uint64_t elapsed;
+    uint32_t count = 0u;
+
+    do {
+        if (!boot_crypto_p256_ecdh(bench_hash, bench_pub, shared)) {
+            return 0.0;
+        }
+        count++;
+        elapsed = sim_time_us() - start;
+    } while (elapsed < (uint64_t)min_ms * 1000u);
+    return (double)count * 1e6 / (double)elapsed;
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Runs the known-answer tests and the benchmarks of the backend.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "min-ms",   required_argument, NULL, 'm' },
+        { "kat-only", no_argument,       NULL, 'k' },
+        { "verbose",  no_argument,       NULL, 'v' },
+        { "json",     no_argument,       NULL, 'j' },
+        { "help",     no_argument,       NULL, 'h' },
+        { NULL,       0,                 NULL, 0 },
+    };
+    bench_options_t opts = {
+        .min_ms = BENCH_DEFAULT_MIN_MS,
+        .kat_only = false,
+        .verbose = false,
+        .json = 0,
+    };
+    bench_hash_t hashes[sizeof(bench_hash_sizes) / sizeof(bench_hash_sizes[0])];
+    uint32_t hash_count = 0u;
+    double verifies = 0.0;
+    double aes_mb_per_s = 0.0;
+    double ecdhs = 0.0;
+    uint32_t failed;
+    uint8_t *data;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'm':
+            opts.min_ms = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'k':
+            opts.kat_only = true;
+            break;
+        case 'v':
+            opts.verbose = true;
+            break;
+        case 'j':
+            opts.json = 1;
+            break;
+        case 'h':
+            usage(argv[0]);
+            return 0;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (boot_crypto_init() != 0) {
+        fprintf(stderr, "Crypto backend %s failed to start\n", boot_crypto_name());
+        return 1;
+    }
+    bench_verbose = opts.verbose;
+    bench_quiet = (opts.json != 0);
+    failed = boot_crypto_kat_run(kat_report);
+
+    if (!opts.kat_only && (failed == 0u)) {
+        data = malloc(SLOT_SIZE);
+        if (data == NULL) {
+            return 1;
+        }
+        for (uint32_t i = 0u; i < SLOT_SIZE; i++) {
+            data[i] = (uint8_t)(i * 31u + (i >> 8));
+        }
+        for (uint32_t i = 0u; i < sizeof(bench_hash_sizes) / sizeof(bench_hash_sizes[0]); i++) {
+            hashes[hash_count].size = bench_hash_sizes[i];
+            hashes[hash_count].mb_per_s = bench_sha256(data, bench_hash_sizes[i], opts.min_ms);
+            hash_count++;
+        }
+        aes_mb_per_s = bench_aes_ctr(data, SLOT_SIZE, opts.min_ms);
+        free(data);
+        verifies = bench_verify(opts.min_ms);
+        if (verifies == 0.0) {
+            fprintf(stderr, "The benchmark signature does not verify\n");
+            failed++;
+        }
+        ecdhs = bench_ecdh(opts.min_ms);
+    }
+    boot_crypto_deinit();
+
+    if (opts.json) {
+        printf("{\"backend\": \"%s\", \"kat\": %u, \"kat_failed\": %u, \"sha256\": [", boot_crypto_name(),
+               bench_kat_count, failed);
+        for (uint32_t i = 0u; i < hash_count; i++) {
+            printf("%s{\"size\": %u, \"mb_per_s\": %.2f}", (i == 0u) ? "" : ", ", hashes[i].size,
+                   hashes[i].mb_per_s);
+        }
+        printf("], \"p256_verifies_per_s\": %.1f, \"aes_ctr_mb_per_s\": %.2f, \"p256_ecdh_per_s\": %.1f}\n", verifies,
+               aes_mb_per_s, ecdhs);
+    } else {
+        printf("Crypto backend      : %s\n", boot_crypto_name());
+        printf("Known-answer tests  : %u of %u passed\n", bench_kat_count - failed, bench_kat_count);
+        for (uint32_t i = 0u; i < hash_count; i++) {
+            printf("SHA-256 %7u B   : %8.2f MB/s (%.3f ms)\n", hashes[i].size, hashes[i].mb_per_s,
+                   (double)hashes[i].size / hashes[i].mb_per_s / 1000.0);
+        }
+        if (verifies > 0.0) {
+            printf("ECDSA P-256 verify  : %8.1f verifies/s (%.3f ms)\n", verifies, 1000.0 / verifies);
+        }
+        if (aes_mb_per_s > 0.0) {
+            printf("AES-128-CTR %7u B: %8.2f MB/s (%.3f ms)\n", SLOT_SIZE, aes_mb_per_s,
+                   (double)SLOT_SIZE / aes_mb_per_s / 1000.0);
+        }
+        if (ecdhs > 0.0) {
+            printf("ECDH P-256          : %8.1f secrets/s (%.3f ms)\n", ecdhs, 1000.0 / ecdhs);
+        }
+    }
+    return (failed == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,643 @@
+/******************************************************************************
+ * File Name:   dfu_bench.c
+ *
+ * Description: DFU session throughput benchmark. Runs the DFU application session
+ *              loop against the simulated transport and flash and reports
+ *              throughput, per-command latency and end-to-end session time.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "bench_stats.h"
+#include "cy_dfu.h"
+#include "dfu_digest.h"
+#include "dfu_flash.h"
+#include "dfu_host.h"
+#include "dfu_lz.h"
+#include "image_delta.h"
+#include "image_file.h"
+#include "image_lz.h"
+#include "sim_boot.h"
+#include "sim_device.h"
+#include "sim_flash.h"
+#include "sim_flash_port.h"
+#include "sim_link.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define BENCH_DEFAULT_PACKET_SIZE   (64u)
+#define BENCH_DEFAULT_CODE_SIZE     (0x10000u)
+#define BENCH_HANDOVER_TIMEOUT_MS   (2000u)
+#define BENCH_DEFAULT_RTO_MS        (20u)
+#define BENCH_MAX_DROPS             (64u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    const char *image_path;
+    uint32_t code_size;
+    bool unpadded;
+    uint32_t packet_size;
+    uint32_t poll_us;
+    bool event_driven;
+    sim_flash_timing_t flash_timing;
+    uint32_t window;
+    uint32_t rto_ms;
+    uint32_t latency_us;
+    uint32_t loss_ppm;
+    bool compress;
+    uint32_t delta;
+    bool update;
+    uint32_t change_size;
+    bool old_secondary;
+    uint32_t drops;
+    bool resume;
+    bool stream;
+    uint32_t hash_us_per_kb;
+    uint32_t seed;
+    uint32_t runs;
+    int json;
+} bench_options_t;
+
+typedef struct {
+    uint32_t *session_us;
+    uint32_t *transfer_us;
+    uint32_t *verify_us;
+    uint32_t *boot_us;
+    uint32_t *latency_us;
+    uint32_t latency_count;
+    uint32_t commands;
+    uint64_t wire_bytes;
+    uint32_t fast_retransmits;
+    uint32_t timeout_retransmits;
+    uint32_t resumed_bytes;
+    sim_link_stats_t link;
+    sim_flash_stats_t flash;
+    dfu_flash_stats_t rows;
+    dfu_digest_stats_t digest;
+    uint32_t boot_hashed;
+    sim_device_stats_t device;
+} bench_result_t;
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name) {
+    printf("Usage: %s [options]\n"
+           "  --image PATH        signed UPGRADE image (.hex or .bin at SECONDARY_IMG_START)\n"
+           "  --code-size N       code size of the synthetic image if no --image (default 0x%x)\n"
+           "  --unpadded          end the synthetic image after its TLVs, as an image signed\n"
+           "                      without --pad, so that its last row is short\n"
+           "  --packet-size N     DFU packet payload size in bytes (default %u)\n"
+           "  --poll-us N         device transport poll interval in us (default 1000)\n"
+           "  --mode poll|event   DFU session loop mode (default poll)\n"
+           "  --flash-program-us N  modelled time to program one 0x%x-byte row (default 0)\n"
+           "  --flash-erase-us N  modelled time to erase one sector (default 0)\n"
+           "  --window N          commands in flight, up to %u; 0 is stop-and-wait (default 0)\n"
+           "  --rto-ms N          windowed mode retransmission timeout in ms (default %u)\n"
+           "  --latency-us N      one-way link latency in us (default 0)\n"
+           "  --loss-ppm N        packets dropped by the link per million (default 0)\n"
+           "  --compress          send the image as a compressed stream\n"
+           "  --update N          send an update inserting N bytes of code into the image,\n"
+           "                      which is placed in the primary slot; with 0 the update\n"
+           "                      changes a few constants, the version and the TLVs\n"
+           "  --delta N           send the update as a delta image, implies --update N\n"
+           "  --old-secondary     the secondary slot holds the image before the update, as\n"
+           "                      after a swap upgrade or an interrupted update\n"
+           "  --drops N           drop the link and reset the device N times per session, at\n"
+           "                      random offsets of the image\n"
+           "  --resume            after a drop, continue after the progress record of the\n"
+           "                      device instead of starting again\n"
+           "  --readback          the DFU application reads the slot back to validate it\n"
+           "                      instead of hashing the rows while they are written\n"
+           "  --hash-us-per-kb N  modelled time to hash 1 KB on the target, added to the\n"
+           "                      validation latencies (default 0)\n"
+           "  --seed N            seed of the drop offsets (default 1)\n"
+           "  --runs N            number of sessions (default 3)\n"
+           "  --json              machine-readable output\n",
+           name, BENCH_DEFAULT_CODE_SIZE, BENCH_DEFAULT_PACKET_SIZE, CY_DFU_ROW_SIZE, DFU_WINDOW_SIZE,
+           BENCH_DEFAULT_RTO_MS);
+}
+
+/*******************************************************************************
+ * Function Name: bench_random
+ ********************************************************************************
+ * Returns the next number of a xorshift32 sequence.
+ *******************************************************************************/
+static uint32_t bench_random(uint32_t *state) {
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/*******************************************************************************
+ * Function Name: drop_offsets
+ ********************************************************************************
+ * Draws the offsets of the stream at which the link drops, in ascending
+ * order.
+ *******************************************************************************/
+static void drop_offsets(const bench_options_t *opt, uint32_t run, uint32_t size, uint32_t *offsets) {
+    uint32_t state = (opt->seed * 2654435761u) ^ (run + 1u);
+
+    if (state == 0u) {
+        state = 1u;
+    }
+    for (uint32_t i = 0u; i < opt->drops; i++) {
+        uint32_t offset = 1u + (bench_random(&state) % (size - 1u));
+        uint32_t j = i;
+
+        while ((j > 0u) && (offsets[j - 1u] > offset)) {
+            offsets[j] = offsets[j - 1u];
+            j--;
+        }
+        offsets[j] = offset;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: run_session
+ ********************************************************************************
+ * Runs one DFU session that sends stream, the image itself or its
+ * compressed or delta image, and appends its measurements to the result.
+ * The base of an update is placed in the primary slot first, and with
+ * --old-secondary in the secondary slot. With --drops the host stops at
+ * random offsets and the device is reset, as after a dropped link or a
+ * power cycle, then the host connects again; the measurements cover all
+ * the attempts.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int run_session(const bench_options_t *opt, const image_t *base, const image_t *image,
+                       const image_t *stream, uint32_t run, bench_result_t *result) {
+    sim_link_config_t link_config = {
+        .poll_interval_us = opt->poll_us,
+        .latency_us = opt->latency_us,
+        .loss_ppm = opt->loss_ppm,
+    };
+    sim_device_config_t device_config = {
+        .event_driven = opt->event_driven,
+        .window_size = opt->window,
+        .digest = opt->stream,
+    };
+    dfu_host_link_t link = { sim_link_host_send, sim_link_host_recv, NULL };
+    dfu_host_config_t host_config = {
+        .packet_data_size = opt->packet_size,
+        .row_size = CY_DFU_ROW_SIZE,
+        .timeout_ms = 1000u,
+        .retries = (opt->loss_ppm != 0u) ? 10u : 0u,
+        .window = opt->window,
+        .rto_ms = opt->rto_ms,
+        .resume = opt->resume,
+        .drop_offset = 0u,
+    };
+    dfu_host_t host;
+    dfu_flash_stats_t rows;
+    dfu_digest_stats_t digest;
+    sim_boot_result_t boot = { false, 0u, 0u };
+    uint32_t drops[BENCH_MAX_DROPS];
+    uint64_t start;
+    uint64_t transfer_end;
+    uint32_t tail;
+    int status;
+    bool handover = false;
+
+    sim_flash_port_set_timing(&opt->flash_timing);
+    if ((sim_flash_init() != 0) ||
+        ((base->data != NULL) && (sim_flash_load(PRIMARY_IMG_START, base->data, image_extent(base)) != 0)) ||
+        ((base->data != NULL) && opt->old_secondary &&
+         (sim_flash_load(SECONDARY_IMG_START, base->data, base->size) != 0))) {
+        return -1;
+    }
+    drop_offsets(opt, run, stream->size, drops);
+    result->commands = 0u;
+    result->wire_bytes = 0u;
+    result->fast_retransmits = 0u;
+    result->timeout_retransmits = 0u;
+    result->resumed_bytes = 0u;
+    memset(&result->rows, 0, sizeof(result->rows));
+    memset(&result->digest, 0, sizeof(result->digest));
+    result->boot_hashed = 0u;
+
+    start = sim_time_us();
+    for (uint32_t attempt = 0u; ; attempt++) {
+        uint32_t *latency;
+
+        if ((sim_link_open(&link_config) != 0) || (sim_device_start(&device_config) != 0)) {
+            return -1;
+        }
+        host_config.drop_offset = (attempt < opt->drops) ? drops[attempt] : 0u;
+        dfu_host_init(&host, &link, &host_config);
+        status = dfu_host_program_image(&host, stream, 1u);
+        if (attempt == opt->drops) {
+            transfer_end = sim_time_us();
+            handover = (status == CY_DFU_SUCCESS) && sim_device_wait_handover(BENCH_HANDOVER_TIMEOUT_MS);
+            result->session_us[run] = (uint32_t)(sim_time_us() - start);
+            result->transfer_us[run] = (uint32_t)(transfer_end - start);
+        }
+        sim_device_stop(&result->device);
+        if (handover) {
+            /* The bootloader validates the secondary slot after the reset */
+            sim_boot_validate(0u, &boot);
+        }
+        sim_link_stats_get(&result->link);
+        sim_link_close();
+        dfu_flash_stats_get(&rows);
+        result->rows.rows += rows.rows;
+        result->rows.programmed += rows.programmed;
+        result->rows.unchanged += rows.unchanged;
+        result->rows.blank += rows.blank;
+        result->rows.erased += rows.erased;
+        result->rows.restored += rows.restored;
+        dfu_digest_stats_get(&digest);
+        result->digest.streamed += digest.streamed;
+        result->digest.readback += digest.readback;
+        if (attempt == opt->drops) {
+            /* Validation latencies with the modelled hash time of the target */
+            result->verify_us[run] = (uint32_t)(host.stats.verify_us +
+                                                (uint64_t)digest.readback * opt->hash_us_per_kb / 1024u);
+            result->boot_us[run] = (uint32_t)(boot.time_us +
+                                              (uint64_t)boot.hashed * opt->hash_us_per_kb / 1024u);
+            result->boot_hashed = boot.hashed;
+        }
+
+        latency = realloc(result->latency_us,
+                          (result->latency_count + host.stats.latency_count) * sizeof(uint32_t));
+        if (latency != NULL) {
+            memcpy(&latency[result->latency_count], host.stats.latency_us,
+                   host.stats.latency_count * sizeof(uint32_t));
+            result->latency_us = latency;
+            result->latency_count += host.stats.latency_count;
+        }
+        result->commands += host.stats.commands;
+        result->wire_bytes += host.stats.wire_bytes;
+        result->fast_retransmits += host.stats.fast_retransmits;
+        result->timeout_retransmits += host.stats.timeout_retransmits;
+        result->resumed_bytes += host.stats.resume_offset;
+        dfu_host_deinit(&host);
+        if (attempt == opt->drops) {
+            break;
+        }
+        if (status != CY_DFU_ERROR_TIMEOUT) {
+            fprintf(stderr, "run %u attempt %u failed: status 0x%02x\n", run, attempt, status);
+            return -1;
+        }
+    }
+    sim_flash_stats_get(&result->flash);
+
+    /* The last row of an unpadded image is filled up with the erased value */
+    tail = (CY_DFU_ROW_SIZE - (image->size % CY_DFU_ROW_SIZE)) % CY_DFU_ROW_SIZE;
+    if (!handover || (memcmp(sim_flash_ptr(image->address, image->size), image->data, image->size) != 0) ||
+        !sim_flash_is_erased(image->address + image->size, tail)) {
+        fprintf(stderr, "run %u failed: status 0x%02x, handover %d\n", run, status, handover);
+        return -1;
+    }
+    if (!boot.valid) {
+        fprintf(stderr, "run %u failed: the bootloader rejects the image\n", run);
+        return -1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: report
+ ********************************************************************************
+ * Prints the benchmark results.
+ *******************************************************************************/
+static void report(const bench_options_t *opt, const image_t *image, const image_t *stream,
+                   const bench_result_t *result) {
+    const char *format = (opt->delta != 0u) ? "delta" : (opt->compress ? "compressed" : "plain");
+    const dfu_flash_stats_t *rows = &result->rows;
+    bench_stats_t session;
+    bench_stats_t transfer;
+    bench_stats_t latency;
+    bench_stats_t verify;
+    bench_stats_t boot;
+    double throughput;
+
+    bench_stats_compute(result->session_us, opt->runs, &session);
+    bench_stats_compute(result->transfer_us, opt->runs, &transfer);
+    bench_stats_compute(result->latency_us, result->latency_count, &latency);
+    bench_stats_compute(result->verify_us, opt->runs, &verify);
+    bench_stats_compute(result->boot_us, opt->runs, &boot);
+    throughput = (transfer.mean > 0.0) ? ((double)image->size * 1e6 / transfer.mean) : 0.0;
+
+    if (opt->json) {
+        printf("{\"image_bytes\": %u, \"stream_bytes\": %u, \"format\": \"%s\", \"packet_size\": %u, \"mode\": \"%s\", \"poll_us\": %u, \"runs\": %u, "
+               "\"commands\": %u, \"wire_bytes\": %llu, \"throughput_bps\": %.0f, "
+               "\"transfer_ms\": %.3f, \"session_ms\": %.3f, "
+               "\"latency_us\": {\"p50\": %u, \"p90\": %u, \"p99\": %u, \"max\": %u}, "
+               "\"flash\": {\"erases\": %u, \"programs\": %u, \"program_us\": %u, \"erase_us\": %u}, "
+               "\"rows\": {\"received\": %u, \"programmed\": %u, \"unchanged\": %u, \"blank\": %u, \"restored\": %u}, "
+               "\"window\": %u, \"link_latency_us\": %u, \"loss_ppm\": %u, "
+               "\"retransmits\": {\"fast\": %u, \"timeout\": %u}, \"link_dropped\": %u, "
+               "\"drops\": %u, \"resume\": %s, \"resumed_bytes\": %u, "
+               "\"validation\": {\"stream\": %s, \"hash_us_per_kb\": %u, \"app_us\": %.0f, \"boot_us\": %.0f, "
+               "\"streamed_bytes\": %u, \"readback_bytes\": %u, \"boot_hashed_bytes\": %u}}\n",
+               image->size, stream->size, format, opt->packet_size, opt->event_driven ? "event" : "poll", opt->poll_us, opt->runs, result->commands,
+               (unsigned long long)result->wire_bytes, throughput, transfer.mean / 1000.0,
+               session.mean / 1000.0, latency.p50, latency.p90, latency.p99, latency.max,
+               result->flash.erase_count, result->flash.program_count, opt->flash_timing.program_us,
+               opt->flash_timing.erase_us, rows->rows, rows->programmed, rows->unchanged, rows->blank,
+               rows->restored, opt->window, opt->latency_us, opt->loss_ppm,
+               result->fast_retransmits, result->timeout_retransmits, result->link.dropped,
+               opt->drops, opt->resume ? "true" : "false", result->resumed_bytes,
+               opt->stream ? "true" : "false", opt->hash_us_per_kb, verify.mean, boot.mean,
+               result->digest.streamed, result->digest.readback, result->boot_hashed);
+        return;
+    }
+
+    printf("DFU session benchmark\n");
+    printf("  image               : %u bytes at 0x%08x\n", image->size, image->address);
+    if (stream != image) {
+        printf("  %-20s: %u bytes (%.1f%% of the image)\n", (opt->delta != 0u) ? "delta image" : "compressed stream",
+               stream->size, 100.0 * (double)stream->size / (double)image->size);
+    }
+    printf("  packet payload      : %u bytes, %u commands, %llu wire bytes\n", opt->packet_size,
+           result->commands, (unsigned long long)result->wire_bytes);
+    printf("  session loop        : %s\n", opt->event_driven ? "event-driven" : "polled");
+    printf("  transport poll      : %u us\n", opt->poll_us);
+    printf("  link                : latency %u us, loss %u ppm, %u packets dropped\n", opt->latency_us,
+           opt->loss_ppm, result->link.dropped);
+    if (opt->window != 0u) {
+        printf("  window              : %u commands, %u fast / %u timeout retransmits\n", opt->window,
+               result->fast_retransmits, result->timeout_retransmits);
+    } else {
+        printf("  window              : stop-and-wait\n");
+    }
+    if (opt->drops != 0u) {
+        printf("  drops               : %u per session, %s, %u bytes not sent again\n", opt->drops,
+               opt->resume ? "resumed" : "restarted", result->resumed_bytes);
+    }
+    printf("  runs                : %u\n", opt->runs);
+    printf("  throughput          : %.1f B/s\n", throughput);
+    printf("  transfer time (ms)  : min %.3f  mean %.3f  max %.3f\n", transfer.min / 1000.0,
+           transfer.mean / 1000.0, transfer.max / 1000.0);
+    printf("  session time (ms)   : min %.3f  mean %.3f  max %.3f\n", session.min / 1000.0,
+           session.mean / 1000.0, session.max / 1000.0);
+    printf("  command latency (us): p50 %u  p90 %u  p99 %u  max %u\n", latency.p50, latency.p90,
+           latency.p99, latency.max);
+    printf("  flash               : %u erases, %u programs\n", result->flash.erase_count,
+           result->flash.program_count);
+    printf("  rows                : %u received, %u programmed, %u unchanged, %u blank, %u restored\n",
+           rows->rows, rows->programmed, rows->unchanged, rows->blank, rows->restored);
+    printf("  flash model         : program %u us/row, erase %u us/sector\n",
+           opt->flash_timing.program_us, opt->flash_timing.erase_us);
+    printf("  validation          : %s, hash model %u us/KB\n",
+           opt->stream ? "digest hashed while written" : "slot read back",
+           opt->hash_us_per_kb);
+    printf("  app validation (us) : min %u  mean %.0f  max %u\n", verify.min, verify.mean, verify.max);
+    printf("  boot validation (us): min %u  mean %.0f  max %u\n", boot.min, boot.mean, boot.max);
+    printf("  bytes hashed        : %u while written, %u read back, %u at boot\n",
+           result->digest.streamed, result->digest.readback, result->boot_hashed);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Parses the options, loads or builds the image and runs the sessions.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "image",       required_argument, NULL, 'i' },
+        { "code-size",   required_argument, NULL, 'c' },
+        { "unpadded",    no_argument,       NULL, 'n' },
+        { "packet-size", required_argument, NULL, 'p' },
+        { "poll-us",     required_argument, NULL, 'u' },
+        { "mode",        required_argument, NULL, 'm' },
+        { "flash-program-us", required_argument, NULL, 'P' },
+        { "flash-erase-us", required_argument, NULL, 'E' },
+        { "window",      required_argument, NULL, 'w' },
+        { "rto-ms",      required_argument, NULL, 'R' },
+        { "latency-us",  required_argument, NULL, 'l' },
+        { "loss-ppm",    required_argument, NULL, 'L' },
+        { "compress",    no_argument,       NULL, 'z' },
+        { "delta",       required_argument, NULL, 'D' },
+        { "update",      required_argument, NULL, 'U' },
+        { "old-secondary", no_argument,     NULL, 'o' },
+        { "drops",       required_argument, NULL, 'K' },
+        { "resume",      no_argument,       NULL, 'X' },
+        { "readback",    no_argument,       NULL, 'H' },
+        { "hash-us-per-kb", required_argument, NULL, 'G' },
+        { "seed",        required_argument, NULL, 'S' },
+        { "runs",        required_argument, NULL, 'r' },
+        { "json",        no_argument,       NULL, 'j' },
+        { "help",        no_argument,       NULL, 'h' },
+        { NULL,          0,                 NULL, 0 },
+    };
+    bench_options_t opt = {
+        .image_path = NULL,
+        .code_size = BENCH_DEFAULT_CODE_SIZE,
+        .unpadded = false,
+        .packet_size = BENCH_DEFAULT_PACKET_SIZE,
+        .poll_us = 1000u,
+        .event_driven = false,
+        .flash_timing = { 0u, 0u },
+        .window = 0u,
+        .rto_ms = BENCH_DEFAULT_RTO_MS,
+        .latency_us = 0u,
+        .loss_ppm = 0u,
+        .compress = false,
+        .delta = 0u,
+        .update = false,
+        .change_size = 0u,
+        .old_secondary = false,
+        .drops = 0u,
+        .resume = false,
+        .stream = true,
+        .hash_us_per_kb = 0u,
+        .seed = 1u,
+        .runs = 3u,
+        .json = 0,
+    };
+    bench_result_t result;
+    image_t base = { 0u, 0u, NULL };
+    image_t image;
+    image_t stream = { 0u, 0u, NULL };
+    const image_t *sent = &image;
+    int c;
+    int console;
+    int status = 0;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'i': opt.image_path = optarg; break;
+        case 'c': opt.code_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'n': opt.unpadded = true; break;
+        case 'p': opt.packet_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'u': opt.poll_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'm':
+            if ((strcmp(optarg, "event") != 0) && (strcmp(optarg, "poll") != 0)) {
+                usage(argv[0]);
+                return 2;
+            }
+            opt.event_driven = (strcmp(optarg, "event") == 0);
+            break;
+        case 'P': opt.flash_timing.program_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'E': opt.flash_timing.erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'w': opt.window = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'R': opt.rto_ms = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'l': opt.latency_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'L': opt.loss_ppm = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'z': opt.compress = true; break;
+        case 'D':
+            opt.delta = (uint32_t)strtoul(optarg, NULL, 0);
+            opt.update = true;
+            opt.change_size = opt.delta;
+            break;
+        case 'U':
+            opt.update = true;
+            opt.change_size = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'o': opt.old_secondary = true; break;
+        case 'K': opt.drops = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'X': opt.resume = true; break;
+        case 'H': opt.stream = false; break;
+        case 'G': opt.hash_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'S': opt.seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'r': opt.runs = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'j': opt.json = 1; break;
+        default: usage(argv[0]); return (c == 'h') ? 0 : 2;
+        }
+    }
+    if (opt.runs == 0u) {
+        opt.runs = 1u;
+    }
+    if (opt.window > DFU_WINDOW_SIZE) {
+        opt.window = DFU_WINDOW_SIZE;
+    }
+    if (opt.drops > BENCH_MAX_DROPS) {
+        opt.drops = BENCH_MAX_DROPS;
+    }
+
+    if (opt.image_path != NULL) {
+        if (image_load(opt.image_path, SECONDARY_IMG_START, &image) != 0) {
+            fprintf(stderr, "cannot load %s\n", opt.image_path);
+            return 1;
+        }
+    } else if (image_synthetic(SECONDARY_IMG_START, SLOT_SIZE, opt.code_size, 1u, &image) != 0) {
+        fprintf(stderr, "cannot build a synthetic image\n");
+        return 1;
+    }
+    if (opt.update) {
+        /* The image becomes the base of an update */
+        base = image;
+        if (image_synthetic_update(&base, opt.change_size, 2u, &image) != 0) {
+            fprintf(stderr, "cannot build the update\n");
+            image_free(&base);
+            return 1;
+        }
+    } else if (opt.old_secondary) {
+        /* The update is the image itself */
+        base.address = image.address;
+        base.size = image.size;
+        base.data = malloc(image.size);
+        if (base.data == NULL) {
+            image_free(&image);
+            return 1;
+        }
+        memcpy(base.data, image.data, image.size);
+    } else {
+        /* No base */
+    }
+    if (opt.unpadded && (opt.image_path == NULL)) {
+        /* Neither padding nor trailer, the slot keeps its erased value there */
+        image.size = image_extent(&image);
+    }
+    if (opt.delta != 0u) {
+        if (image_delta_create(&base, &image, DFU_LZ_WINDOW_BITS, &stream) != 0) {
+            fprintf(stderr, "cannot build the delta image\n");
+            image_free(&base);
+            image_free(&image);
+            return 1;
+        }
+        sent = &stream;
+    } else if (opt.compress) {
+        if (image_lz_compress(&image, DFU_LZ_WINDOW_BITS, &stream) != 0) {
+            fprintf(stderr, "cannot compress the image\n");
+            image_free(&image);
+            return 1;
+        }
+        sent = &stream;
+    }
+
+    memset(&result, 0, sizeof(result));
+    result.session_us = calloc(opt.runs, sizeof(uint32_t));
+    result.transfer_us = calloc(opt.runs, sizeof(uint32_t));
+    result.verify_us = calloc(opt.runs, sizeof(uint32_t));
+    result.boot_us = calloc(opt.runs, sizeof(uint32_t));
+
+    /* The device console (retarget-io on the target) goes to stderr */
+    fflush(stdout);
+    console = dup(STDOUT_FILENO);
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    for (uint32_t run = 0u; (run < opt.runs) && (status == 0); run++) {
+        status = run_session(&opt, &base, &image, sent, run, &result);
+    }
+    fflush(stdout);
+    dup2(console, STDOUT_FILENO);
+    close(console);
+
+    if (status == 0) {
+        report(&opt, &image, sent, &result);
+    }
+
+    free(result.session_us);
+    free(result.transfer_us);
+    free(result.verify_us);
+    free(result.boot_us);
+    free(result.latency_us);
+    image_free(&stream);
+    image_free(&base);
+    image_free(&image);
+    sim_flash_deinit();
+    return (status == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
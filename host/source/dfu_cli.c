@@ -0,0 +1,360 @@
+/******************************************************************************
+ * File Name:   dfu_cli.c
+ *
+ * Description: Command line DFU host for Linux, a scriptable counterpart of the DFU Host Tool.
+ *              Streams a signed UPGRADE image to one or more devices at once, over UART, CAN FD,
+ *              SPI or I2C, optionally with several commands in flight, and reports the time of each
+ *              phase of every session.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_stats.h"
+#include "cy_dfu.h"
+#include "dfu_host.h"
+#include "dfu_transport.h"
+#include "image_file.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define CLI_MAX_DEVICES             (64u)
+#define CLI_DEFAULT_TIMEOUT_MS      (1000u)
+#define CLI_DEFAULT_RETRIES         (3u)
+#define CLI_DEFAULT_RTO_MS          (100u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    const char *image_path;
+    uint32_t address;
+    uint8_t app_id;
+    dfu_host_config_t host;
+    int json;
+} cli_options_t;
+
+typedef struct {
+    const char *spec;
+    dfu_transport_config_t config;
+    /* Shared, read only: every session sends its rows from the loaded image */
+    const image_t *image;
+    const cli_options_t *opt;
+    pthread_t thread;
+    /* Results */
+    int status;
+    bool opened;
+    uint64_t session_us;
+    dfu_host_stats_t stats;
+    dfu_transport_stats_t link;
+    bench_stats_t latency;
+} cli_device_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const char *const cli_phase_names[DFU_HOST_PHASE_COUNT] = { "enter", "transfer", "verify", "exit" };
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name) {
+    printf("Usage: %s [options] IMAGE TRANSPORT...\n"
+           "  IMAGE               signed UPGRADE image, .hex or a raw binary\n"
+           "  TRANSPORT           uart:/dev/ttyUSB0[:baud]        (default %u 8N1)\n"
+           "                      can:can0[:tx_id[:rx_id]]        (default 0x%x, responses\n"
+           "                                                       with tx_id + 1)\n"
+           "                      spi:/dev/spidev0.0[:hz]         (default mode 0, %u Hz)\n"
+           "                      i2c:/dev/i2c-1[:address[:hz]]   (default address %u)\n"
+           "                      one session per transport, all of them at once\n"
+           "  --address N         address of a raw binary image (default 0x%x,\n"
+           "                      SECONDARY_IMG_START)\n"
+           "  --app-id N          application ID of Verify Application (default 1)\n"
+           "  --packet-size N     DFU packet payload size in bytes, up to %u (default %u)\n"
+           "  --window N          commands in flight, up to %u; 0 is stop-and-wait, which\n"
+           "                      SPI and I2C require (default 0)\n"
+           "  --rto-ms N          windowed mode retransmission timeout in ms (default %u)\n"
+           "  --timeout-ms N      response timeout in ms (default %u)\n"
+           "  --retries N         retries of a command without a response (default %u)\n"
+           "  --resume            continue after the progress record of the device\n"
+           "  --json              print the results as JSON\n",
+           name, DFU_TRANSPORT_UART_BAUD, DFU_TRANSPORT_CAN_TX_ID, DFU_TRANSPORT_SPI_HZ,
+           DFU_TRANSPORT_I2C_ADDRESS, SECONDARY_IMG_START, CY_DFU_MAX_PACKET_DATA, CY_DFU_MAX_PACKET_DATA,
+           DFU_WINDOW_SIZE, CLI_DEFAULT_RTO_MS, CLI_DEFAULT_TIMEOUT_MS, CLI_DEFAULT_RETRIES);
+}
+
+/*******************************************************************************
+ * Function Name: cli_session
+ ********************************************************************************
+ * Thread of one device: opens its transport and runs the DFU session.
+ *******************************************************************************/
+static void *cli_session(void *arg) {
+    cli_device_t *device = arg;
+    dfu_transport_t *transport = malloc(sizeof(*transport));
+    dfu_host_link_t link = { dfu_transport_send, dfu_transport_recv, transport };
+    dfu_host_t *host = malloc(sizeof(*host));
+    uint64_t start;
+
+    device->status = -1;
+    if ((transport == NULL) || (host == NULL) ||
+        (dfu_transport_open(transport, &device->config, false) != 0)) {
+        free(transport);
+        free(host);
+        return NULL;
+    }
+    device->opened = true;
+
+    dfu_host_init(host, &link, &device->opt->host);
+    start = sim_time_us();
+    device->status = dfu_host_program_image(host, device->image, device->opt->app_id);
+    device->session_us = sim_time_us() - start;
+
+    device->stats = host->stats;
+    bench_stats_compute(host->stats.latency_us, host->stats.latency_count, &device->latency);
+    device->link = transport->stats;
+    dfu_host_deinit(host);
+    dfu_transport_close(transport);
+    free(host);
+    free(transport);
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function Name: report
+ ********************************************************************************
+ * Prints the result of every session and the totals.
+ *******************************************************************************/
+static void report(const cli_options_t *opt, const image_t *image, const cli_device_t *devices,
+                   uint32_t count, uint64_t wall_us) {
+    uint32_t updated = 0u;
+
+    for (uint32_t i = 0u; i < count; i++) {
+        updated += (devices[i].status == CY_DFU_SUCCESS) ? 1u : 0u;
+    }
+
+    if (opt->json) {
+        printf("{\"image_bytes\": %u, \"address\": %u, \"packet_size\": %u, \"window\": %u, \"devices\": [",
+               image->size, image->address, opt->host.packet_data_size, opt->host.window);
+        for (uint32_t i = 0u; i < count; i++) {
+            const cli_device_t *d = &devices[i];
+            double throughput = (d->stats.phase_us[DFU_HOST_PHASE_TRANSFER] != 0u) ?
+                                ((double)(image->size - d->stats.resume_offset) * 1e6 /
+                                 (double)d->stats.phase_us[DFU_HOST_PHASE_TRANSFER]) : 0.0;
+
+            printf("%s{\"transport\": \"%s\", \"status\": %d, \"session_ms\": %.3f, \"phases_ms\": {", (i == 0u) ? "" : ", ",
+                   d->spec, d->opened ? d->status : -1, (double)d->session_us / 1000.0);
+            for (uint32_t p = 0u; p < DFU_HOST_PHASE_COUNT; p++) {
+                printf("%s\"%s\": %.3f", (p == 0u) ? "" : ", ", cli_phase_names[p], (double)d->stats.phase_us[p] / 1000.0);
+            }
+            printf("}, \"throughput_bps\": %.0f, \"resume_offset\": %u, \"commands\": %u, \"retries\": %u, "
+                   "\"retransmits\": {\"fast\": %u, \"timeout\": %u}, "
+                   "\"latency_us\": {\"p50\": %u, \"p90\": %u, \"p99\": %u, \"max\": %u}, "
+                   "\"link\": {\"tx_bytes\": %llu, \"rx_bytes\": %llu, \"tx_frames\": %u, \"rx_frames\": %u, \"resyncs\": %u}}",
+                   throughput, d->stats.resume_offset, d->stats.commands, d->stats.retries, d->stats.fast_retransmits,
+                   d->stats.timeout_retransmits, d->latency.p50, d->latency.p90, d->latency.p99, d->latency.max,
+                   (unsigned long long)d->link.tx_bytes, (unsigned long long)d->link.rx_bytes, d->link.tx_frames,
+                   d->link.rx_frames, d->link.resyncs);
+        }
+        printf("], \"updated\": %u, \"wall_ms\": %.3f, \"aggregate_bps\": %.0f}\n", updated, (double)wall_us / 1000.0,
+               (wall_us != 0u) ? ((double)image->size * updated * 1e6 / (double)wall_us) : 0.0);
+        return;
+    }
+
+    printf("DFU update\n");
+    printf("  image               : %u bytes at 0x%08x\n", image->size, image->address);
+    printf("  packet payload      : %u bytes\n", opt->host.packet_data_size);
+    if (opt->host.window != 0u) {
+        printf("  window              : %u commands, rto %u ms\n", opt->host.window, opt->host.rto_ms);
+    } else {
+        printf("  window              : stop-and-wait\n");
+    }
+    for (uint32_t i = 0u; i < count; i++) {
+        const cli_device_t *d = &devices[i];
+        double transfer_us = (double)d->stats.phase_us[DFU_HOST_PHASE_TRANSFER];
+
+        printf("  %s\n", d->spec);
+        if (!d->opened) {
+            printf("    result            : cannot open the transport\n");
+            continue;
+        }
+        if (d->status == CY_DFU_SUCCESS) {
+            printf("    result            : updated\n");
+        } else {
+            printf("    result            : failed, status %d\n", d->status);
+        }
+        printf("    session (ms)      : %.3f = enter %.3f + transfer %.3f + verify %.3f + exit %.3f\n",
+               (double)d->session_us / 1000.0, (double)d->stats.phase_us[DFU_HOST_PHASE_ENTER] / 1000.0,
+               transfer_us / 1000.0, (double)d->stats.phase_us[DFU_HOST_PHASE_VERIFY] / 1000.0,
+               (double)d->stats.phase_us[DFU_HOST_PHASE_EXIT] / 1000.0);
+        printf("    throughput        : %.1f B/s", (transfer_us > 0.0) ?
+               ((double)(image->size - d->stats.resume_offset) * 1e6 / transfer_us) : 0.0);
+        if (d->stats.resume_offset != 0u) {
+            printf(", resumed at %u", d->stats.resume_offset);
+        }
+        printf("\n");
+        printf("    commands          : %u, %u retries, %u fast / %u timeout retransmits\n", d->stats.commands,
+               d->stats.retries, d->stats.fast_retransmits, d->stats.timeout_retransmits);
+        printf("    command latency   : p50 %u  p90 %u  p99 %u  max %u us\n", d->latency.p50, d->latency.p90,
+               d->latency.p99, d->latency.max);
+        printf("    link              : %llu bytes / %u frames out, %llu bytes / %u frames in, %u bytes resynced\n",
+               (unsigned long long)d->link.tx_bytes, d->link.tx_frames, (unsigned long long)d->link.rx_bytes,
+               d->link.rx_frames, d->link.resyncs);
+    }
+    printf("  devices             : %u of %u updated\n", updated, count);
+    printf("  wall time           : %.3f ms, %.1f B/s aggregate\n", (double)wall_us / 1000.0,
+           (wall_us != 0u) ? ((double)image->size * updated * 1e6 / (double)wall_us) : 0.0);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Parses the options, loads the image and updates the devices.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "address",     required_argument, NULL, 'a' },
+        { "app-id",      required_argument, NULL, 'A' },
+        { "packet-size", required_argument, NULL, 'p' },
+        { "window",      required_argument, NULL, 'w' },
+        { "rto-ms",      required_argument, NULL, 'R' },
+        { "timeout-ms",  required_argument, NULL, 't' },
+        { "retries",     required_argument, NULL, 'r' },
+        { "resume",      no_argument,       NULL, 'X' },
+        { "json",        no_argument,       NULL, 'j' },
+        { "help",        no_argument,       NULL, 'h' },
+        { NULL,          0,                 NULL, 0 },
+    };
+    cli_options_t opt = {
+        .image_path = NULL,
+        .address = SECONDARY_IMG_START,
+        .app_id = 1u,
+        .host = {
+            .packet_data_size = CY_DFU_MAX_PACKET_DATA,
+            .row_size = CY_DFU_ROW_SIZE,
+            .timeout_ms = CLI_DEFAULT_TIMEOUT_MS,
+            .retries = CLI_DEFAULT_RETRIES,
+            .window = 0u,
+            .rto_ms = CLI_DEFAULT_RTO_MS,
+            .resume = false,
+            .drop_offset = 0u,
+        },
+        .json = 0,
+    };
+    static cli_device_t devices[CLI_MAX_DEVICES];
+    image_t image;
+    uint32_t count;
+    uint32_t started = 0u;
+    uint64_t start;
+    int status = 0;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'a': opt.address = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'A': opt.app_id = (uint8_t)strtoul(optarg, NULL, 0); break;
+        case 'p': opt.host.packet_data_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'w': opt.host.window = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'R': opt.host.rto_ms = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 't': opt.host.timeout_ms = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'r': opt.host.retries = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'X': opt.host.resume = true; break;
+        case 'j': opt.json = 1; break;
+        default: usage(argv[0]); return (c == 'h') ? 0 : 2;
+        }
+    }
+    if ((argc - optind < 2) || (argc - optind - 1 > (int)CLI_MAX_DEVICES) ||
+        (opt.host.packet_data_size <= 8u) || (opt.host.packet_data_size > CY_DFU_MAX_PACKET_DATA) ||
+        (opt.host.window > DFU_WINDOW_SIZE)) {
+        usage(argv[0]);
+        return 2;
+    }
+    opt.image_path = argv[optind];
+    count = (uint32_t)(argc - optind - 1);
+
+    for (uint32_t i = 0u; i < count; i++) {
+        cli_device_t *device = &devices[i];
+
+        device->spec = argv[optind + 1 + (int)i];
+        if (dfu_transport_parse(device->spec, &device->config) != 0) {
+            fprintf(stderr, "bad transport %s\n", device->spec);
+            return 2;
+        }
+        if ((opt.host.window != 0u) &&
+            ((device->config.type == DFU_TRANSPORT_SPI) || (device->config.type == DFU_TRANSPORT_I2C))) {
+            /* The slave only answers when it is read, nothing can ack the commands in flight */
+            fprintf(stderr, "%s: --window needs a UART or CAN transport\n", device->spec);
+            return 2;
+        }
+        device->config.windowed = (opt.host.window != 0u);
+    }
+
+    if (image_load(opt.image_path, opt.address, &image) != 0) {
+        fprintf(stderr, "cannot load %s\n", opt.image_path);
+        return 1;
+    }
+
+    start = sim_time_us();
+    for (uint32_t i = 0u; i < count; i++) {
+        devices[i].image = &image;
+        devices[i].opt = &opt;
+        if (pthread_create(&devices[i].thread, NULL, cli_session, &devices[i]) != 0) {
+            fprintf(stderr, "cannot start the session of %s\n", devices[i].spec);
+            break;
+        }
+        started++;
+    }
+    for (uint32_t i = 0u; i < started; i++) {
+        pthread_join(devices[i].thread, NULL);
+    }
+    report(&opt, &image, devices, started, sim_time_us() - start);
+
+    for (uint32_t i = 0u; i < count; i++) {
+        if ((i >= started) || (devices[i].status != CY_DFU_SUCCESS)) {
+            status = 1;
+        }
+    }
+    image_free(&image);
+    return status;
+}
+
+/* [] END OF FILE */
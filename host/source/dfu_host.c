@@ -0,0 +1,685 @@
+/******************************************************************************
+ * File Name:   dfu_host.c
+ *
+ * Description: Host-side DFU sender: frames DFU commands and pushes a signed image
+ *              row by row over a pluggable link, stop-and-wait like the DFU Host
+ *              Tool. Records the round trip time of every command.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "cy_dfu.h"
+#include "dfu_host.h"
+#include "dfu_packet.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Function Name: dfu_host_init
+ ********************************************************************************
+ * Initializes the sender.
+ *******************************************************************************/
+void dfu_host_init(dfu_host_t *host, const dfu_host_link_t *link, const dfu_host_config_t *config) {
+    memset(host, 0, sizeof(*host));
+    host->link = *link;
+    host->config = *config;
+    if (host->config.window > DFU_WINDOW_SACK_BITS) {
+        host->config.window = DFU_WINDOW_SACK_BITS;
+    }
+    if (host->config.rto_ms == 0u) {
+        host->config.rto_ms = host->config.timeout_ms;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dfu_host_deinit
+ ********************************************************************************
+ * Releases the latency log.
+ *******************************************************************************/
+void dfu_host_deinit(dfu_host_t *host) {
+    free(host->stats.latency_us);
+    memset(&host->stats, 0, sizeof(host->stats));
+}
+
+/*******************************************************************************
+ * Function Name: record_latency
+ ********************************************************************************
+ * Appends one round trip time to the latency log.
+ *******************************************************************************/
+static void record_latency(dfu_host_stats_t *stats, uint64_t latency_us) {
+    if (stats->latency_count == stats->latency_capacity) {
+        uint32_t capacity = (stats->latency_capacity == 0u) ? 1024u : stats->latency_capacity * 2u;
+        uint32_t *log = realloc(stats->latency_us, capacity * sizeof(uint32_t));
+
+        if (log == NULL) {
+            return;
+        }
+        stats->latency_us = log;
+        stats->latency_capacity = capacity;
+    }
+    stats->latency_us[stats->latency_count++] = (uint32_t)latency_us;
+}
+
+/*******************************************************************************
+ * Function Name: window_in_flight
+ ********************************************************************************
+ * Returns the number of unacknowledged commands.
+ *******************************************************************************/
+static uint32_t window_in_flight(const dfu_host_t *host) {
+    return (uint8_t)(host->window.next - host->window.base);
+}
+
+/*******************************************************************************
+ * Function Name: window_transmit
+ ********************************************************************************
+ * Sends, or resends, the frame of a command in flight.
+ *
+ * Return:
+ *  0 on success, -1 on a link failure.
+ *******************************************************************************/
+static int window_transmit(dfu_host_t *host, dfu_host_frame_t *frame) {
+    if (host->link.send(host->link.context, frame->frame, frame->length) != 0) {
+        return -1;
+    }
+    frame->sent_us = sim_time_us();
+    frame->sends++;
+    host->stats.commands++;
+    host->stats.wire_bytes += frame->length;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: window_ack
+ ********************************************************************************
+ * Releases the commands before the cumulative ack.
+ *******************************************************************************/
+static void window_ack(dfu_host_t *host, uint8_t ack) {
+    uint64_t now = sim_time_us();
+
+    if ((uint8_t)(ack - host->window.base) > window_in_flight(host)) {
+        return;
+    }
+    while (host->window.base != ack) {
+        dfu_host_frame_t *frame = &host->window.frames[host->window.base % DFU_WINDOW_SACK_BITS];
+
+        record_latency(&host->stats, now - frame->first_us);
+        host->window.base++;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: window_receive
+ ********************************************************************************
+ * Handles one frame from the device: a response or a selective ack. After a
+ * selective ack every missing command before the highest one received is
+ * retransmitted once.
+ *
+ * Return:
+ *  0 on success, -1 on a link failure.
+ *******************************************************************************/
+static int window_receive(dfu_host_t *host, const uint8_t *frame, uint32_t length) {
+    uint32_t sack;
+    uint8_t ack;
+
+    if (length < DFU_WINDOW_HEADER_SIZE) {
+        return 0;
+    }
+    ack = frame[2];
+    sack = (uint32_t)frame[3] | ((uint32_t)frame[4] << 8) | ((uint32_t)frame[5] << 16) |
+           ((uint32_t)frame[6] << 24);
+
+    if (frame[0] == DFU_WINDOW_FRAME_DATA) {
+        uint8_t status;
+        const uint8_t *payload;
+        uint32_t payload_len;
+
+        if (dfu_packet_parse(&frame[DFU_WINDOW_HEADER_SIZE], length - DFU_WINDOW_HEADER_SIZE, &status,
+                             &payload, &payload_len) != CY_DFU_SUCCESS) {
+            return 0;
+        }
+        if ((status != CY_DFU_SUCCESS) && (host->window.error == CY_DFU_SUCCESS)) {
+            host->window.error = status;
+        }
+        if (frame[1] == host->window.rsp_seq) {
+            host->window.rsp_valid = true;
+            host->window.rsp_status = status;
+            memcpy(host->window.rsp, payload, payload_len);
+            host->window.rsp_length = payload_len;
+        }
+    }
+    window_ack(host, ack);
+
+    if (sack != 0u) {
+        uint32_t highest = 31u - (uint32_t)__builtin_clz(sack);
+
+        for (uint32_t i = 0u; i <= highest + 1u; i++) {
+            uint8_t seq = (uint8_t)(ack + i);
+            dfu_host_frame_t *entry = &host->window.frames[seq % DFU_WINDOW_SACK_BITS];
+
+            if ((uint8_t)(seq - host->window.base) >= window_in_flight(host)) {
+                break;
+            }
+            if ((i > 0u) && ((sack & (1uL << (i - 1u))) != 0u)) {
+                entry->sacked = true;
+            } else if (!entry->sacked && !entry->fast_retransmitted) {
+                entry->fast_retransmitted = true;
+                host->stats.fast_retransmits++;
+                if (window_transmit(host, entry) != 0) {
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: window_pump
+ ********************************************************************************
+ * Waits for one frame from the device, or retransmits the commands whose
+ * retransmission timeout expired.
+ *
+ * Return:
+ *  0 on success, -1 on a link failure or when a command ran out of retries.
+ *******************************************************************************/
+static int window_pump(dfu_host_t *host) {
+    uint8_t frame[DFU_WINDOW_FRAME_SIZE];
+    uint64_t rto_us = (uint64_t)host->config.rto_ms * 1000u;
+    uint64_t now = sim_time_us();
+    uint64_t deadline = now + rto_us;
+    int received;
+
+    for (uint8_t seq = host->window.base; seq != host->window.next; seq++) {
+        dfu_host_frame_t *entry = &host->window.frames[seq % DFU_WINDOW_SACK_BITS];
+
+        if (!entry->sacked && (entry->sent_us + rto_us < deadline)) {
+            deadline = entry->sent_us + rto_us;
+        }
+    }
+
+    received = host->link.recv(host->link.context, frame, sizeof(frame),
+                               (deadline > now) ? (uint32_t)((deadline - now + 999u) / 1000u) : 0u);
+    if (received > 0) {
+        host->stats.wire_bytes += (uint64_t)received;
+        return window_receive(host, frame, (uint32_t)received);
+    }
+
+    now = sim_time_us();
+    for (uint8_t seq = host->window.base; seq != host->window.next; seq++) {
+        dfu_host_frame_t *entry = &host->window.frames[seq % DFU_WINDOW_SACK_BITS];
+
+        if (entry->sacked || (entry->sent_us + rto_us > now)) {
+            continue;
+        }
+        if (entry->sends > host->config.retries) {
+            return -1;
+        }
+        host->stats.timeout_retransmits++;
+        host->stats.retries++;
+        if (window_transmit(host, entry) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: window_submit
+ ********************************************************************************
+ * Sends a command once the window has room for it, without waiting for its
+ * response. A command without a response is sent but not tracked.
+ *
+ * Return:
+ *  CY_DFU_SUCCESS, the first error status reported by the device, or -1.
+ *******************************************************************************/
+static int window_submit(dfu_host_t *host, uint8_t cmd, const uint8_t *data, uint32_t length,
+                         bool expect_response) {
+    dfu_host_frame_t *entry;
+    uint8_t seq = host->window.next;
+
+    while ((host->window.error == CY_DFU_SUCCESS) && (window_in_flight(host) >= host->config.window)) {
+        if (window_pump(host) != 0) {
+            return -1;
+        }
+    }
+    if (host->window.error != CY_DFU_SUCCESS) {
+        return host->window.error;
+    }
+
+    entry = &host->window.frames[seq % DFU_WINDOW_SACK_BITS];
+    entry->frame[0] = DFU_WINDOW_FRAME_DATA;
+    entry->frame[1] = seq;
+    entry->length = DFU_WINDOW_HEADER_SIZE +
+                    dfu_packet_build(&entry->frame[DFU_WINDOW_HEADER_SIZE], cmd, data, length);
+    entry->sends = 0u;
+    entry->sacked = false;
+    entry->fast_retransmitted = false;
+    entry->first_us = sim_time_us();
+    host->window.next++;
+
+    if (window_transmit(host, entry) != 0) {
+        return -1;
+    }
+    if (!expect_response) {
+        /* Nothing will acknowledge it */
+        host->window.base = host->window.next;
+    }
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: window_drain
+ ********************************************************************************
+ * Waits until every command in flight is acknowledged.
+ *
+ * Return:
+ *  CY_DFU_SUCCESS, the first error status reported by the device, or -1.
+ *******************************************************************************/
+static int window_drain(dfu_host_t *host) {
+    while ((host->window.error == CY_DFU_SUCCESS) && (window_in_flight(host) != 0u)) {
+        if (window_pump(host) != 0) {
+            return -1;
+        }
+    }
+    return host->window.error;
+}
+
+/*******************************************************************************
+ * Function Name: window_command
+ ********************************************************************************
+ * Windowed counterpart of dfu_host_command(): sends a command after the ones
+ * in flight and waits for its response.
+ *******************************************************************************/
+static int window_command(dfu_host_t *host, uint8_t cmd, const uint8_t *data, uint32_t length,
+                          bool expect_response, uint8_t *rsp, uint32_t *rsp_length) {
+    int status;
+
+    host->window.rsp_seq = host->window.next;
+    host->window.rsp_valid = false;
+    status = window_submit(host, cmd, data, length, expect_response);
+    if ((status != CY_DFU_SUCCESS) || !expect_response) {
+        return status;
+    }
+    status = window_drain(host);
+    if (status != CY_DFU_SUCCESS) {
+        return status;
+    }
+    if (!host->window.rsp_valid) {
+        return -1;
+    }
+    if ((rsp != NULL) && (rsp_length != NULL)) {
+        memcpy(rsp, host->window.rsp, host->window.rsp_length);
+        *rsp_length = host->window.rsp_length;
+    }
+    return host->window.rsp_status;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_host_command
+ ********************************************************************************
+ * Sends one command and, if expected, waits for its response. A command
+ * whose response timed out is retried up to config.retries times. In the
+ * windowed mode the command is sent after the commands in flight.
+ *
+ * Parameters:
+ *  host             Sender.
+ *  cmd              DFU command code.
+ *  data, length     Command payload.
+ *  expect_response  false for Send Data without response, Sync and Exit.
+ *  rsp, rsp_length  Optional response payload (rsp must hold
+ *                   CY_DFU_MAX_PACKET_DATA bytes).
+ *
+ * Return:
+ *  Response status code (CY_DFU_SUCCESS when no response is expected),
+ *  -1 on a link failure or timeout.
+ *******************************************************************************/
+int dfu_host_command(dfu_host_t *host, uint8_t cmd, const uint8_t *data, uint32_t length,
+                     bool expect_response, uint8_t *rsp, uint32_t *rsp_length) {
+    uint8_t packet[CY_DFU_SIZEOF_CMD_BUFFER];
+    uint8_t response[CY_DFU_SIZEOF_CMD_BUFFER];
+    uint32_t size;
+
+    if (host->config.window != 0u) {
+        return window_command(host, cmd, data, length, expect_response, rsp, rsp_length);
+    }
+
+    size = dfu_packet_build(packet, cmd, data, length);
+    for (uint32_t attempt = 0u; attempt <= host->config.retries; attempt++) {
+        uint64_t start = sim_time_us();
+        int received;
+        uint8_t status;
+        const uint8_t *payload;
+        uint32_t payload_len;
+
+        if (attempt > 0u) {
+            host->stats.retries++;
+        }
+        if (host->link.send(host->link.context, packet, size) != 0) {
+            return -1;
+        }
+        host->stats.commands++;
+        host->stats.wire_bytes += size;
+        if (!expect_response) {
+            return CY_DFU_SUCCESS;
+        }
+
+        received = host->link.recv(host->link.context, response, sizeof(response),
+                                   host->config.timeout_ms);
+        if (received <= 0) {
+            continue;
+        }
+        record_latency(&host->stats, sim_time_us() - start);
+        host->stats.wire_bytes += (uint64_t)received;
+
+        if (dfu_packet_parse(response, (uint32_t)received, &status, &payload, &payload_len) !=
+            CY_DFU_SUCCESS) {
+            return CY_DFU_ERROR_DATA;
+        }
+        if ((rsp != NULL) && (rsp_length != NULL)) {
+            memcpy(rsp, payload, payload_len);
+            *rsp_length = payload_len;
+        }
+        return status;
+    }
+    return -1;
+}
+
+/*******************************************************************************
+ * Function Name: queue_command
+ ********************************************************************************
+ * Sends a data command. In the windowed mode it does not wait for the
+ * response; errors are reported by a later call.
+ *******************************************************************************/
+static int queue_command(dfu_host_t *host, uint8_t cmd, const uint8_t *data, uint32_t length) {
+    if (host->config.window != 0u) {
+        return window_submit(host, cmd, data, length, true);
+    }
+    return dfu_host_command(host, cmd, data, length, true, NULL, NULL);
+}
+
+/*******************************************************************************
+ * Function Name: resume_point
+ ********************************************************************************
+ * Reads the progress record of the device with Get Metadata: the number of
+ * bytes programmed from the start of the slot and their CRC-32C.
+ *
+ * Return:
+ *  Offset to continue from, 0 if the record does not match the image.
+ *******************************************************************************/
+static uint32_t resume_point(dfu_host_t *host, const image_t *image) {
+    static const uint8_t range[4] = { 0u, 0u, 8u, 0u };
+    uint8_t rsp[CY_DFU_SIZEOF_CMD_BUFFER];
+    uint32_t rsp_len = 0u;
+    uint32_t offset;
+
+    if ((dfu_host_command(host, CY_DFU_CMD_GET_METADATA, range, sizeof(range), true, rsp,
+                          &rsp_len) != CY_DFU_SUCCESS) || (rsp_len != 8u)) {
+        return 0u;
+    }
+    offset = dfu_packet_get_u32(&rsp[0]);
+    if ((offset > image->size) || ((offset % host->config.row_size) != 0u) ||
+        (dfu_packet_get_u32(&rsp[4]) != dfu_packet_crc32c(0u, image->data, offset))) {
+        return 0u;
+    }
+    return offset;
+}
+
+/*******************************************************************************
+ * Function Name: send_row
+ ********************************************************************************
+ * Sends one row of an image: Send Data packets for all but the tail of the
+ * row, then Program Data with the tail.
+ *
+ * Return:
+ *  CY_DFU_SUCCESS, the failing status code or -1.
+ *******************************************************************************/
+static int send_row(dfu_host_t *host, const image_t *image, uint32_t offset) {
+    uint8_t buf[CY_DFU_MAX_PACKET_DATA];
+    uint32_t chunk_max = host->config.packet_data_size;
+    const uint8_t *row = &image->data[offset];
+    uint32_t row_len = image->size - offset;
+    uint32_t sent = 0u;
+    int status;
+
+    if (row_len > host->config.row_size) {
+        row_len = host->config.row_size;
+    }
+
+    /* Everything but the tail of the row goes with Send Data */
+    while (row_len - sent > chunk_max - 8u) {
+        uint32_t len = row_len - sent - (chunk_max - 8u);
+
+        len = (len > chunk_max) ? chunk_max : len;
+        status = queue_command(host, CY_DFU_CMD_SEND_DATA, &row[sent], len);
+        if (status != CY_DFU_SUCCESS) {
+            return status;
+        }
+        sent += len;
+    }
+
+    dfu_packet_put_u32(&buf[0], image->address + offset);
+    dfu_packet_put_u32(&buf[4], dfu_packet_crc32c(0u, row, row_len));
+    memcpy(&buf[8], &row[sent], row_len - sent);
+    return queue_command(host, CY_DFU_CMD_PROGRAM_DATA, buf, 8u + row_len - sent);
+}
+
+/*******************************************************************************
+ * Function Name: verify_app
+ ********************************************************************************
+ * Sends Verify Application and accumulates its round trip time in
+ * stats.verify_us.
+ *
+ * Return:
+ *  CY_DFU_SUCCESS, CY_DFU_ERROR_VERIFY if the device reports the image as not
+ *  valid, otherwise the failing status code or -1.
+ *******************************************************************************/
+static int verify_app(dfu_host_t *host, uint8_t app_id) {
+    uint8_t rsp[CY_DFU_SIZEOF_CMD_BUFFER];
+    uint32_t rsp_len = 0u;
+    uint64_t verify_start = sim_time_us();
+    int status;
+
+    status = dfu_host_command(host, CY_DFU_CMD_VERIFY_APP, &app_id, 1u, true, rsp, &rsp_len);
+    host->stats.verify_us += sim_time_us() - verify_start;
+    if (status != CY_DFU_SUCCESS) {
+        return status;
+    }
+    return ((rsp_len == 1u) && (rsp[0] == 1u)) ? CY_DFU_SUCCESS : CY_DFU_ERROR_VERIFY;
+}
+
+/*******************************************************************************
+ * Function Name: phase_mark
+ ********************************************************************************
+ * Ends a phase of the session: records the time since *phase_start and
+ * starts the next phase.
+ *******************************************************************************/
+static void phase_mark(dfu_host_t *host, dfu_host_phase_t phase, uint64_t *phase_start) {
+    uint64_t now = sim_time_us();
+
+    host->stats.phase_us[phase] = now - *phase_start;
+    *phase_start = now;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_host_program_image
+ ********************************************************************************
+ * Runs a complete DFU session: Enter, one Program Data per row preceded by
+ * Send Data packets for the rest of the row, Verify Application and Exit.
+ * With config.resume the rows covered by the progress record of the device
+ * are not sent again. The time of each phase is kept in stats.phase_us.
+ *
+ * Return:
+ *  0 on success, CY_DFU_ERROR_TIMEOUT at config.drop_offset, otherwise the
+ *  failing status code or -1.
+ *******************************************************************************/
+int dfu_host_program_image(dfu_host_t *host, const image_t *image, uint8_t app_id) {
+    uint8_t rsp[CY_DFU_SIZEOF_CMD_BUFFER];
+    uint32_t rsp_len = 0u;
+    uint32_t chunk_max = host->config.packet_data_size;
+    uint32_t start = 0u;
+    uint64_t phase_start = sim_time_us();
+    int status;
+
+    if ((chunk_max <= 8u) || (chunk_max > CY_DFU_MAX_PACKET_DATA)) {
+        return -1;
+    }
+    memset(host->stats.phase_us, 0, sizeof(host->stats.phase_us));
+
+    status = dfu_host_command(host, CY_DFU_CMD_ENTER, NULL, 0u, true, rsp, &rsp_len);
+    if (status != CY_DFU_SUCCESS) {
+        return status;
+    }
+
+    if (host->config.resume) {
+        start = resume_point(host, image);
+    }
+    host->stats.resume_offset = start;
+    phase_mark(host, DFU_HOST_PHASE_ENTER, &phase_start);
+
+    for (uint32_t offset = start; offset < image->size; offset += host->config.row_size) {
+        uint32_t row_len = image->size - offset;
+
+        if (row_len > host->config.row_size) {
+            row_len = host->config.row_size;
+        }
+        if ((host->config.drop_offset != 0u) && (offset + row_len > host->config.drop_offset)) {
+            return CY_DFU_ERROR_TIMEOUT;
+        }
+        status = send_row(host, image, offset);
+        if (status != CY_DFU_SUCCESS) {
+            return status;
+        }
+    }
+    if (host->config.window != 0u) {
+        /* The rows in flight belong to the transfer, not to Verify */
+        status = window_drain(host);
+        if (status != CY_DFU_SUCCESS) {
+            return status;
+        }
+    }
+    phase_mark(host, DFU_HOST_PHASE_TRANSFER, &phase_start);
+
+    host->stats.verify_us = 0u;
+    status = verify_app(host, app_id);
+    if (status != CY_DFU_SUCCESS) {
+        return status;
+    }
+    phase_mark(host, DFU_HOST_PHASE_VERIFY, &phase_start);
+
+    status = dfu_host_command(host, CY_DFU_CMD_EXIT, NULL, 0u, false, NULL, NULL);
+    phase_mark(host, DFU_HOST_PHASE_EXIT, &phase_start);
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_host_program_images
+ ********************************************************************************
+ * Runs one DFU session that updates several images: Enter, the rows of every
+ * image, Verify Application of every image and Exit. The images are sent one
+ * after the other, each verified after its last row, or interleaved row by
+ * row and verified at the end. Plain images only: the rows of compressed and
+ * delta streams go through one decoder on the device and must not be
+ * interleaved. config.resume and config.drop_offset are not used.
+ *
+ * Parameters:
+ *  host           Sender.
+ *  images         Images, each at the address of its secondary slot.
+ *  app_ids        Application ID of each image in Verify Application.
+ *  count          Number of images.
+ *  interleave     Alternate the rows of the images.
+ *
+ * Return:
+ *  0 on success, otherwise the failing status code or -1.
+ *******************************************************************************/
+int dfu_host_program_images(dfu_host_t *host, const image_t *images, const uint8_t *app_ids,
+                            uint32_t count, bool interleave) {
+    uint8_t rsp[CY_DFU_SIZEOF_CMD_BUFFER];
+    uint32_t rsp_len = 0u;
+    uint32_t chunk_max = host->config.packet_data_size;
+    uint32_t rows = 0u;
+    int status;
+
+    if ((chunk_max <= 8u) || (chunk_max > CY_DFU_MAX_PACKET_DATA)) {
+        return -1;
+    }
+
+    status = dfu_host_command(host, CY_DFU_CMD_ENTER, NULL, 0u, true, rsp, &rsp_len);
+    if (status != CY_DFU_SUCCESS) {
+        return status;
+    }
+    host->stats.resume_offset = 0u;
+    host->stats.verify_us = 0u;
+
+    if (interleave) {
+        for (uint32_t i = 0u; i < count; i++) {
+            uint32_t image_rows = (images[i].size + host->config.row_size - 1u) / host->config.row_size;
+
+            rows = (image_rows > rows) ? image_rows : rows;
+        }
+        for (uint32_t row = 0u; row < rows; row++) {
+            for (uint32_t i = 0u; i < count; i++) {
+                uint32_t offset = row * host->config.row_size;
+
+                if (offset >= images[i].size) {
+                    continue;
+                }
+                status = send_row(host, &images[i], offset);
+                if (status != CY_DFU_SUCCESS) {
+                    return status;
+                }
+            }
+        }
+    }
+
+    for (uint32_t i = 0u; i < count; i++) {
+        if (!interleave) {
+            for (uint32_t offset = 0u; offset < images[i].size; offset += host->config.row_size) {
+                status = send_row(host, &images[i], offset);
+                if (status != CY_DFU_SUCCESS) {
+                    return status;
+                }
+            }
+        }
+        status = verify_app(host, app_ids[i]);
+        if (status != CY_DFU_SUCCESS) {
+            return status;
+        }
+    }
+
+    return dfu_host_command(host, CY_DFU_CMD_EXIT, NULL, 0u, false, NULL, NULL);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * File Name:   dfu_host.h
+ *
+ * Description: Host-side DFU sender: frames DFU commands and pushes a signed image
+ *              row by row over a pluggable link.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_HOST_H
+#define DFU_HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_dfu.h"
+#include "dfu_window.h"
+#include "image_file.h"
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Phases of dfu_host_program_image(), timed in dfu_host_stats_t */
+typedef enum {
+    /* Enter DFU, and Get Metadata with config.resume */
+    DFU_HOST_PHASE_ENTER,
+    /* Send Data and Program Data of the rows, until the last one is
+     * acknowledged */
+    DFU_HOST_PHASE_TRANSFER,
+    DFU_HOST_PHASE_VERIFY,
+    DFU_HOST_PHASE_EXIT,
+    DFU_HOST_PHASE_COUNT
+} dfu_host_phase_t;
+
+/* Link used by the sender; send/recv carry whole DFU packets */
+typedef struct {
+    int (*send)(void *context, const uint8_t *data, uint32_t length);
+    int (*recv)(void *context, uint8_t *data, uint32_t size, uint32_t timeout_ms);
+    void *context;
+} dfu_host_link_t;
+
+typedef struct {
+    /* Payload bytes per Send Data / Program Data packet */
+    uint32_t packet_data_size;
+    /* Bytes per Program Data row */
+    uint32_t row_size;
+    /* Response timeout, in milliseconds */
+    uint32_t timeout_ms;
+    /* Number of retries of a command that timed out */
+    uint32_t retries;
+    /* Commands in flight, up to DFU_WINDOW_SACK_BITS. 0 is stop-and-wait */
+    uint32_t window;
+    /* Windowed mode: retransmission timeout, in milliseconds */
+    uint32_t rto_ms;
+    /* Continue after the progress record of the device, if it matches the
+     * start of the image */
+    bool resume;
+    /* Stop before the row that contains this offset of the image, as a
+     * dropped link does. 0 sends the whole image */
+    uint32_t drop_offset;
+} dfu_host_config_t;
+
+typedef struct {
+    uint32_t commands;
+    uint32_t retries;
+    /* Windowed mode: retransmissions after a selective ack or a timeout */
+    uint32_t fast_retransmits;
+    uint32_t timeout_retransmits;
+    uint64_t wire_bytes;
+    /* Offset of the image the last session started from */
+    uint32_t resume_offset;
+    /* Round trip time of the Verify Application commands of the last session */
+    uint64_t verify_us;
+    /* Wall time of each phase of the last session */
+    uint64_t phase_us[DFU_HOST_PHASE_COUNT];
+    /* Round trip time of every command that expects a response */
+    uint32_t *latency_us;
+    uint32_t latency_count;
+    uint32_t latency_capacity;
+} dfu_host_stats_t;
+
+/* Windowed mode: command in flight */
+typedef struct {
+    uint8_t frame[DFU_WINDOW_FRAME_SIZE];
+    uint32_t length;
+    uint64_t first_us;
+    uint64_t sent_us;
+    uint32_t sends;
+    bool sacked;
+    bool fast_retransmitted;
+} dfu_host_frame_t;
+
+typedef struct {
+    dfu_host_frame_t frames[DFU_WINDOW_SACK_BITS];
+    /* Oldest unacknowledged and next sequence number */
+    uint8_t base;
+    uint8_t next;
+    /* First error status reported by the device */
+    int error;
+    /* Response of the command awaited by dfu_host_command() */
+    uint8_t rsp_seq;
+    bool rsp_valid;
+    uint8_t rsp_status;
+    uint8_t rsp[CY_DFU_MAX_PACKET_DATA];
+    uint32_t rsp_length;
+} dfu_host_window_t;
+
+typedef struct {
+    dfu_host_link_t link;
+    dfu_host_config_t config;
+    dfu_host_stats_t stats;
+    dfu_host_window_t window;
+} dfu_host_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+void dfu_host_init(dfu_host_t *host, const dfu_host_link_t *link, const dfu_host_config_t *config);
+void dfu_host_deinit(dfu_host_t *host);
+int dfu_host_command(dfu_host_t *host, uint8_t cmd, const uint8_t *data, uint32_t length,
+                     bool expect_response, uint8_t *rsp, uint32_t *rsp_length);
+int dfu_host_program_image(dfu_host_t *host, const image_t *image, uint8_t app_id);
+int dfu_host_program_images(dfu_host_t *host, const image_t *images, const uint8_t *app_ids,
+                            uint32_t count, bool interleave);
+
+#endif /* DFU_HOST_H */
+
+/* [] END OF FILE */
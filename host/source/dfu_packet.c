@@ -0,0 +1,160 @@
+/******************************************************************************
+ * File Name:   dfu_packet.c
+ *
+ * Description: DFU packet framing helpers shared by the simulated device and the
+ *              host-side sender. A packet is SOP, command or status code, 16-bit
+ *              data length, data, 16-bit checksum and EOP, all little-endian.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "cy_dfu.h"
+#include "dfu_packet.h"
+
+/*******************************************************************************
+ * Function Name: dfu_packet_checksum
+ ********************************************************************************
+ * Returns the two's complement of the 16-bit sum of the given bytes.
+ *******************************************************************************/
+uint16_t dfu_packet_checksum(const uint8_t *data, uint32_t length) {
+    uint16_t sum = 0u;
+
+    while (length-- > 0u) {
+        sum += *data++;
+    }
+    return (uint16_t)(1u + ~sum);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_packet_crc32c
+ ********************************************************************************
+ * Updates a CRC-32C (Castagnoli) over the given bytes, as used by the
+ * Program Data and Verify Data commands. Start with crc = 0.
+ *******************************************************************************/
+uint32_t dfu_packet_crc32c(uint32_t crc, const uint8_t *data, uint32_t length) {
+    crc = ~crc;
+    while (length-- > 0u) {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_packet_build
+ ********************************************************************************
+ * Frames a command or a response.
+ *
+ * Return:
+ *  Total packet length.
+ *******************************************************************************/
+uint32_t dfu_packet_build(uint8_t *packet, uint8_t code, const uint8_t *data, uint32_t length) {
+    uint16_t checksum;
+
+    packet[0] = CY_DFU_PACKET_SOP;
+    packet[1] = code;
+    packet[2] = (uint8_t)length;
+    packet[3] = (uint8_t)(length >> 8);
+    if ((length > 0u) && (data != &packet[CY_DFU_PACKET_HEADER_SIZE])) {
+        memmove(&packet[CY_DFU_PACKET_HEADER_SIZE], data, length);
+    }
+    checksum = dfu_packet_checksum(packet, CY_DFU_PACKET_HEADER_SIZE + length);
+    packet[CY_DFU_PACKET_HEADER_SIZE + length] = (uint8_t)checksum;
+    packet[CY_DFU_PACKET_HEADER_SIZE + length + 1u] = (uint8_t)(checksum >> 8);
+    packet[CY_DFU_PACKET_HEADER_SIZE + length + 2u] = CY_DFU_PACKET_EOP;
+
+    return length + CY_DFU_PACKET_OVERHEAD;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_packet_parse
+ ********************************************************************************
+ * Checks the framing of a received packet.
+ *
+ * Return:
+ *  CY_DFU_SUCCESS, CY_DFU_ERROR_LENGTH, CY_DFU_ERROR_DATA or
+ *  CY_DFU_ERROR_CHECKSUM.
+ *******************************************************************************/
+int dfu_packet_parse(const uint8_t *packet, uint32_t size, uint8_t *code,
+                     const uint8_t **data, uint32_t *length) {
+    uint32_t len;
+    uint16_t checksum;
+
+    if (size < CY_DFU_PACKET_OVERHEAD) {
+        return CY_DFU_ERROR_LENGTH;
+    }
+    len = (uint32_t)packet[2] | ((uint32_t)packet[3] << 8);
+    if (len + CY_DFU_PACKET_OVERHEAD != size) {
+        return CY_DFU_ERROR_LENGTH;
+    }
+    if ((packet[0] != CY_DFU_PACKET_SOP) || (packet[size - 1u] != CY_DFU_PACKET_EOP)) {
+        return CY_DFU_ERROR_DATA;
+    }
+    checksum = (uint16_t)(packet[size - 3u] | (packet[size - 2u] << 8));
+    if (checksum != dfu_packet_checksum(packet, CY_DFU_PACKET_HEADER_SIZE + len)) {
+        return CY_DFU_ERROR_CHECKSUM;
+    }
+    *code = packet[1];
+    *data = &packet[CY_DFU_PACKET_HEADER_SIZE];
+    *length = len;
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_packet_put_u32
+ ********************************************************************************
+ * Stores a little-endian 32-bit value.
+ *******************************************************************************/
+void dfu_packet_put_u32(uint8_t *dst, uint32_t value) {
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_packet_get_u32
+ ********************************************************************************
+ * Loads a little-endian 32-bit value.
+ *******************************************************************************/
+uint32_t dfu_packet_get_u32(const uint8_t *src) {
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) |
+           ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,310 @@
+/******************************************************************************
+ * File Name:   dfu_sim_core.c
+ *
+ * Description: Host model of the DFU middleware command engine: Cy_DFU_Init()
+ *              and Cy_DFU_Continue() with the DFU packet protocol, plus weak
+ *              defaults of the application level routines for the MCUboot flow.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include "cy_dfu.h"
+#include "dfu_packet.h"
+#include "sim_flash.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* MCUboot image header magic */
+#define DFU_SIM_IMAGE_MAGIC         (0x96f3b83du)
+
+/* Response to Enter: silicon ID, silicon revision, DFU SDK version */
+#define DFU_SIM_SILICON_ID          (0xE4700000u)
+#define DFU_SIM_SILICON_REV         (0x11u)
+#define DFU_SIM_ENTER_RSP_SIZE      (8u)
+
+/*******************************************************************************
+ * Function Name: send_response
+ ********************************************************************************
+ * Frames and sends a response packet built in the packet buffer.
+ *******************************************************************************/
+static void send_response(cy_stc_dfu_params_t *params, cy_en_dfu_status_t status,
+                          const uint8_t *data, uint32_t length) {
+    uint32_t count = 0u;
+    uint32_t size = dfu_packet_build(params->packetBuffer, (uint8_t)status, data, length);
+
+    (void)Cy_DFU_TransportWrite(params->packetBuffer, size, &count, params->timeout);
+}
+
+/*******************************************************************************
+ * Function Name: append_data
+ ********************************************************************************
+ * Appends packet data to the row being collected in the data buffer.
+ *******************************************************************************/
+static cy_en_dfu_status_t append_data(cy_stc_dfu_params_t *params, const uint8_t *data,
+                                      uint32_t length) {
+    if (params->dataOffset + length > CY_DFU_SIZEOF_DATA_BUFFER) {
+        params->dataOffset = 0u;
+        return CY_DFU_ERROR_LENGTH;
+    }
+    memcpy(&params->dataBuffer[params->dataOffset], data, length);
+    params->dataOffset += length;
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_Init
+ ********************************************************************************
+ * Resets the command engine.
+ *******************************************************************************/
+cy_en_dfu_status_t Cy_DFU_Init(uint32_t *state, cy_stc_dfu_params_t *params) {
+    if ((state == NULL) || (params == NULL)) {
+        return CY_DFU_ERROR_UNKNOWN;
+    }
+    *state = CY_DFU_STATE_NONE;
+    params->dataOffset = 0u;
+    params->appId = 0u;
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_Continue
+ ********************************************************************************
+ * Waits up to params->timeout for one command, executes it and sends the
+ * response.
+ *
+ * Return:
+ *  CY_DFU_ERROR_TIMEOUT if no command arrived, otherwise the command status.
+ *******************************************************************************/
+cy_en_dfu_status_t Cy_DFU_Continue(uint32_t *state, cy_stc_dfu_params_t *params) {
+    uint8_t rsp[CY_DFU_METADATA_MAX_SIZE];
+    uint32_t rsp_len = 0u;
+    bool respond = true;
+    uint32_t count = 0u;
+    uint8_t cmd = 0u;
+    const uint8_t *data = NULL;
+    uint32_t length = 0u;
+    cy_en_dfu_status_t status;
+
+    if ((*state == CY_DFU_STATE_FINISHED) || (*state == CY_DFU_STATE_FAILED)) {
+        return CY_DFU_SUCCESS;
+    }
+
+    status = Cy_DFU_TransportRead(params->packetBuffer, CY_DFU_SIZEOF_CMD_BUFFER, &count,
+                                  params->timeout);
+    if (status != CY_DFU_SUCCESS) {
+        return status;
+    }
+
+    status = (cy_en_dfu_status_t)dfu_packet_parse(params->packetBuffer, count, &cmd, &data, &length);
+    if (status != CY_DFU_SUCCESS) {
+        send_response(params, status, NULL, 0u);
+        return status;
+    }
+
+    if ((*state == CY_DFU_STATE_NONE) && (cmd != CY_DFU_CMD_ENTER)) {
+        send_response(params, CY_DFU_ERROR_CMD, NULL, 0u);
+        return CY_DFU_ERROR_CMD;
+    }
+
+    switch (cmd) {
+    case CY_DFU_CMD_ENTER:
+        *state = CY_DFU_STATE_UPDATING;
+        params->dataOffset = 0u;
+        dfu_packet_put_u32(&rsp[0], DFU_SIM_SILICON_ID);
+        rsp[4] = DFU_SIM_SILICON_REV;
+        rsp[5] = 0u;
+        rsp[6] = 0u;
+        rsp[7] = 5u;
+        rsp_len = DFU_SIM_ENTER_RSP_SIZE;
+        break;
+
+    case CY_DFU_CMD_SYNC:
+        params->dataOffset = 0u;
+        respond = false;
+        break;
+
+    case CY_DFU_CMD_SEND_DATA_WR:
+        respond = false;
+        /* Fall through */
+    case CY_DFU_CMD_SEND_DATA:
+        status = append_data(params, data, length);
+        break;
+
+    case CY_DFU_CMD_PROGRAM_DATA:
+    case CY_DFU_CMD_VERIFY_DATA:
+        if (length < 8u) {
+            status = CY_DFU_ERROR_LENGTH;
+            params->dataOffset = 0u;
+            break;
+        }
+        status = append_data(params, &data[8], length - 8u);
+        if (status == CY_DFU_SUCCESS) {
+            uint32_t address = dfu_packet_get_u32(&data[0]);
+            uint32_t crc = dfu_packet_get_u32(&data[4]);
+
+            if (crc != dfu_packet_crc32c(0u, params->dataBuffer, params->dataOffset)) {
+                status = CY_DFU_ERROR_CHECKSUM;
+            } else if (cmd == CY_DFU_CMD_PROGRAM_DATA) {
+                status = Cy_DFU_WriteData(address, params->dataOffset, CY_DFU_IOCTL_WRITE, params);
+            } else {
+                status = Cy_DFU_ReadData(address, params->dataOffset, CY_DFU_IOCTL_COMPARE, params);
+            }
+            params->dataOffset = 0u;
+        }
+        break;
+
+    case CY_DFU_CMD_ERASE_DATA:
+        status = (length == 4u) ?
+                 Cy_DFU_WriteData(dfu_packet_get_u32(data), 0u, CY_DFU_IOCTL_ERASE, params) :
+                 CY_DFU_ERROR_LENGTH;
+        break;
+
+    case CY_DFU_CMD_GET_METADATA:
+        /* Metadata bytes from offset "from" up to offset "to" */
+        if (length != 4u) {
+            status = CY_DFU_ERROR_LENGTH;
+            break;
+        }
+        {
+            uint32_t from = (uint32_t)data[0] | ((uint32_t)data[1] << 8);
+            uint32_t to = (uint32_t)data[2] | ((uint32_t)data[3] << 8);
+
+            if ((from > to) || (to - from > CY_DFU_METADATA_MAX_SIZE)) {
+                status = CY_DFU_ERROR_LENGTH;
+                break;
+            }
+            rsp_len = to - from;
+            status = Cy_DFU_ReadData(CY_DFU_METADATA_ADDR + from, rsp_len, CY_DFU_IOCTL_READ, params);
+            memcpy(rsp, params->dataBuffer, rsp_len);
+        }
+        break;
+
+    case CY_DFU_CMD_SET_METADATA:
+        status = (length == 9u) ? CY_DFU_SUCCESS : CY_DFU_ERROR_LENGTH;
+        break;
+
+    case CY_DFU_CMD_VERIFY_APP:
+        if (length != 1u) {
+            status = CY_DFU_ERROR_LENGTH;
+            break;
+        }
+        params->appId = data[0];
+        rsp[0] = (Cy_DFU_ValidateApp(data[0], params) == CY_DFU_SUCCESS) ? 1u : 0u;
+        rsp_len = 1u;
+        break;
+
+    case CY_DFU_CMD_EXIT:
+        *state = CY_DFU_STATE_FINISHED;
+        respond = false;
+        break;
+
+    default:
+        status = CY_DFU_ERROR_CMD;
+        break;
+    }
+
+    if (respond) {
+        send_response(params, status, rsp, (status == CY_DFU_SUCCESS) ? rsp_len : 0u);
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_WriteData
+ ********************************************************************************
+ * Default MCUboot flow write handler: accepts rows for the secondary slot,
+ * erases a sector when its first row is written and programs the row.
+ *******************************************************************************/
+__attribute__((weak))
+cy_en_dfu_status_t Cy_DFU_WriteData(uint32_t address, uint32_t length, uint32_t ctl,
+                                    cy_stc_dfu_params_t *params) {
+    uint32_t erase_size = sim_flash_erase_size(address);
+
+    if ((address < SECONDARY_IMG_START) ||
+        ((uint64_t)address + length > (uint64_t)SECONDARY_IMG_START + SLOT_SIZE) ||
+        (erase_size == 0u)) {
+        return CY_DFU_ERROR_ADDRESS;
+    }
+    if ((ctl & CY_DFU_IOCTL_ERASE) != 0u) {
+        return (sim_flash_erase(address) == 0) ? CY_DFU_SUCCESS : CY_DFU_ERROR_DATA;
+    }
+    if ((address % erase_size) == 0u) {
+        (void)sim_flash_erase(address);
+    }
+    return (sim_flash_program(address, params->dataBuffer, length) == 0) ?
+           CY_DFU_SUCCESS : CY_DFU_ERROR_DATA;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_ReadData
+ ********************************************************************************
+ * Default read handler: reads into, or compares against, the data buffer.
+ *******************************************************************************/
+__attribute__((weak))
+cy_en_dfu_status_t Cy_DFU_ReadData(uint32_t address, uint32_t length, uint32_t ctl,
+                                   cy_stc_dfu_params_t *params) {
+    const uint8_t *src = sim_flash_ptr(address, length);
+
+    if (src == NULL) {
+        return CY_DFU_ERROR_ADDRESS;
+    }
+    if ((ctl & CY_DFU_IOCTL_COMPARE) != 0u) {
+        return (memcmp(src, params->dataBuffer, length) == 0) ? CY_DFU_SUCCESS : CY_DFU_ERROR_VERIFY;
+    }
+    memcpy(params->dataBuffer, src, length);
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_ValidateApp
+ ********************************************************************************
+ * Default validation for the MCUboot flow: the secondary slot must start
+ * with an MCUboot image header, read through Cy_DFU_ReadData(). The
+ * signature is checked by the bootloader.
+ *******************************************************************************/
+__attribute__((weak))
+cy_en_dfu_status_t Cy_DFU_ValidateApp(uint32_t appId, cy_stc_dfu_params_t *params) {
+    (void)appId;
+    if (Cy_DFU_ReadData(SECONDARY_IMG_START, 4u, CY_DFU_IOCTL_READ, params) != CY_DFU_SUCCESS) {
+        return CY_DFU_ERROR_VERIFY;
+    }
+    return (dfu_packet_get_u32(params->dataBuffer) == DFU_SIM_IMAGE_MAGIC) ?
+           CY_DFU_SUCCESS : CY_DFU_ERROR_VERIFY;
+}
+
+/* [] END OF FILE */
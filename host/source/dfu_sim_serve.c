@@ -0,0 +1,443 @@
+/******************************************************************************
+ * File Name:   dfu_sim_serve.c
+ *
+ * Description: Simulated devices for the command line DFU host. Each device runs the DFU
+ *              application session loop against the flash model in a process of its own, on the
+ *              master of a pty or on a CAN interface, and reports whether the bootloader accepts
+ *              the image it received once the session hands over.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+/* posix_openpt() and ptsname_r() */
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <linux/can.h>
+#include "cy_dfu.h"
+#include "dfu_flash.h"
+#include "dfu_transport.h"
+#include "image_file.h"
+#include "sim_boot.h"
+#include "sim_device.h"
+#include "sim_flash.h"
+#include "sim_flash_port.h"
+#include "sim_link_transport.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define SERVE_MAX_DEVICES           (64u)
+#define SERVE_DEFAULT_TIMEOUT_MS    (30000u)
+#define SERVE_DEFAULT_CODE_SIZE     (0x10000u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t count;
+    const char *link_prefix;
+    const char *can_interface;
+    uint32_t can_id;
+    const char *ready_path;
+    sim_device_config_t device;
+    sim_flash_timing_t flash_timing;
+    uint32_t timeout_ms;
+    const char *image_out;
+    uint32_t code_size;
+    int json;
+} serve_options_t;
+
+typedef struct {
+    /* Specification the host opens the device with */
+    char spec[DFU_TRANSPORT_PATH_SIZE + 32u];
+    /* Device end: the master of the pty and its slave, kept open so that the
+     * master does not see a hang up between two sessions of the host */
+    dfu_transport_config_t config;
+    int master;
+    int slave;
+    char link[DFU_TRANSPORT_PATH_SIZE];
+    pid_t pid;
+} serve_device_t;
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name) {
+    printf("Usage: %s [options]\n"
+           "  --count N           number of devices, up to %u (default 1)\n"
+           "  --link PREFIX       link PREFIX0, PREFIX1, ... to the ptys of the devices\n"
+           "  --can IFACE         serve on a CAN interface instead of ptys\n"
+           "  --can-id N          host identifier of the first device, the next devices\n"
+           "                      take every second identifier after it (default 0x%x)\n"
+           "  --ready PATH        write the transport specifications of the devices to\n"
+           "                      PATH once they are listening\n"
+           "  --mode poll|event   DFU session loop mode (default poll)\n"
+           "  --window N          window size of the DFU transport, as --window of the\n"
+           "                      host; 0 is stop-and-wait (default 0)\n"
+           "  --flash-program-us N  modelled time to program one 0x%x-byte row (default 0)\n"
+           "  --flash-erase-us N  modelled time to erase one sector (default 0)\n"
+           "  --readback          the DFU application reads the slot back to validate it\n"
+           "  --timeout-ms N      give up on a device without a handover after N ms\n"
+           "                      (default %u)\n"
+           "  --write-image PATH  write a synthetic signed UPGRADE image the devices\n"
+           "                      accept as a raw binary and exit\n"
+           "  --code-size N       code size of the synthetic image (default 0x%x)\n"
+           "  --json              one JSON object per device\n",
+           name, SERVE_MAX_DEVICES, DFU_TRANSPORT_CAN_TX_ID, CY_DFU_ROW_SIZE, SERVE_DEFAULT_TIMEOUT_MS,
+           SERVE_DEFAULT_CODE_SIZE);
+}
+
+/*******************************************************************************
+ * Function Name: open_pty
+ ********************************************************************************
+ * Creates the pty of a device, in raw mode, and links it if asked to.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int open_pty(const serve_options_t *opt, uint32_t index, serve_device_t *device) {
+    struct termios tio;
+    char name[DFU_TRANSPORT_PATH_SIZE];
+
+    device->master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((device->master < 0) || (grantpt(device->master) != 0) || (unlockpt(device->master) != 0) ||
+        (ptsname_r(device->master, name, sizeof(name)) != 0)) {
+        return -1;
+    }
+    device->slave = open(name, O_RDWR | O_NOCTTY);
+    if ((device->slave < 0) || (tcgetattr(device->slave, &tio) != 0)) {
+        return -1;
+    }
+    cfmakeraw(&tio);
+    if (tcsetattr(device->slave, TCSANOW, &tio) != 0) {
+        return -1;
+    }
+    if (opt->link_prefix != NULL) {
+        if (snprintf(device->link, sizeof(device->link), "%s%u", opt->link_prefix, index) >=
+            (int)sizeof(device->link)) {
+            return -1;
+        }
+        (void)unlink(device->link);
+        if (symlink(name, device->link) != 0) {
+            device->link[0] = '\0';
+            return -1;
+        }
+        snprintf(device->spec, sizeof(device->spec), "uart:%s", device->link);
+    } else {
+        snprintf(device->spec, sizeof(device->spec), "uart:%s", name);
+    }
+    memset(&device->config, 0, sizeof(device->config));
+    device->config.type = DFU_TRANSPORT_UART;
+    device->config.speed = DFU_TRANSPORT_UART_BAUD;
+    device->config.windowed = (opt->device.window_size != 0u);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: serve_device
+ ********************************************************************************
+ * Body of the process of one device: answers one DFU session, then checks
+ * the secondary slot as the bootloader does after the reset.
+ *
+ * Return:
+ *  Exit status of the process, 0 if the bootloader accepts the image.
+ *******************************************************************************/
+static int serve_device(const serve_options_t *opt, uint32_t index, serve_device_t *device, int ready_fd) {
+    sim_boot_result_t boot = { false, 0u, 0u };
+    sim_device_stats_t stats;
+    dfu_transport_stats_t link;
+    dfu_flash_stats_t rows;
+    const char *result;
+    bool handover;
+
+    sim_flash_port_set_timing(&opt->flash_timing);
+    if ((sim_flash_init() != 0) || (sim_link_transport_open(&device->config, device->master) != 0) ||
+        (sim_device_start(&opt->device) != 0)) {
+        fprintf(stderr, "device %u: cannot open %s\n", index, device->spec);
+        return 1;
+    }
+    (void)write(ready_fd, "", 1);
+    close(ready_fd);
+
+    handover = sim_device_wait_handover(opt->timeout_ms);
+    sim_device_stop(&stats);
+    if (handover) {
+        sim_boot_validate(0u, &boot);
+    }
+    sim_link_transport_stats_get(&link);
+    sim_link_transport_close();
+    dfu_flash_stats_get(&rows);
+    sim_flash_deinit();
+
+    result = !handover ? "timeout" : (boot.valid ? "ok" : "rejected");
+    if (opt->json) {
+        printf("{\"device\": %u, \"transport\": \"%s\", \"result\": \"%s\", \"rows\": {\"received\": %u, "
+               "\"programmed\": %u, \"unchanged\": %u, \"blank\": %u}, \"frames\": {\"rx\": %u, \"tx\": %u}, "
+               "\"rx_bytes\": %llu, \"tx_bytes\": %llu, \"resyncs\": %u}\n",
+               index, device->spec, result, rows.rows, rows.programmed, rows.unchanged, rows.blank,
+               link.rx_frames, link.tx_frames, (unsigned long long)link.rx_bytes,
+               (unsigned long long)link.tx_bytes, link.resyncs);
+    } else {
+        printf("  device %-3u %-28s: %-8s %u rows received, %u programmed, %u frames in, %u out, %u bytes resynced\n",
+               index, device->spec, result, rows.rows, rows.programmed, link.rx_frames, link.tx_frames,
+               link.resyncs);
+    }
+    fflush(stdout);
+    return (handover && boot.valid) ? 0 : 1;
+}
+
+/*******************************************************************************
+ * Function Name: write_ready
+ ********************************************************************************
+ * Writes the transport specifications of the devices, one line, replacing
+ * the file at once so that a script waiting for it reads it whole.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int write_ready(const char *path, const serve_device_t *devices, uint32_t count) {
+    char tmp[DFU_TRANSPORT_PATH_SIZE * 2u];
+    FILE *file;
+
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp)) {
+        return -1;
+    }
+    file = fopen(tmp, "w");
+    if (file == NULL) {
+        return -1;
+    }
+    for (uint32_t i = 0u; i < count; i++) {
+        fprintf(file, "%s%s", (i == 0u) ? "" : " ", devices[i].spec);
+    }
+    fprintf(file, "\n");
+    if (fclose(file) != 0) {
+        return -1;
+    }
+    return rename(tmp, path);
+}
+
+/*******************************************************************************
+ * Function Name: write_image
+ ********************************************************************************
+ * Writes the synthetic signed image of dfu_bench, for the secondary slot of
+ * the memory map the devices are built with.
+ *
+ * Return:
+ *  Exit status.
+ *******************************************************************************/
+static int write_image(const serve_options_t *opt) {
+    image_t image;
+    int status;
+
+    if (image_synthetic(SECONDARY_IMG_START, SLOT_SIZE, opt->code_size, 1u, &image) != 0) {
+        fprintf(stderr, "cannot build a synthetic image\n");
+        return 1;
+    }
+    status = image_save_bin(opt->image_out, &image);
+    if (status != 0) {
+        fprintf(stderr, "cannot write %s\n", opt->image_out);
+    }
+    image_free(&image);
+    return (status == 0) ? 0 : 1;
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Parses the options, creates the devices and waits for their sessions.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "count",       required_argument, NULL, 'n' },
+        { "link",        required_argument, NULL, 'l' },
+        { "can",         required_argument, NULL, 'c' },
+        { "can-id",      required_argument, NULL, 'I' },
+        { "ready",       required_argument, NULL, 'r' },
+        { "mode",        required_argument, NULL, 'm' },
+        { "window",      required_argument, NULL, 'w' },
+        { "flash-program-us", required_argument, NULL, 'P' },
+        { "flash-erase-us", required_argument, NULL, 'E' },
+        { "readback",    no_argument,       NULL, 'H' },
+        { "timeout-ms",  required_argument, NULL, 't' },
+        { "write-image", required_argument, NULL, 'W' },
+        { "code-size",   required_argument, NULL, 's' },
+        { "json",        no_argument,       NULL, 'j' },
+        { "help",        no_argument,       NULL, 'h' },
+        { NULL,          0,                 NULL, 0 },
+    };
+    serve_options_t opt = {
+        .count = 1u,
+        .link_prefix = NULL,
+        .can_interface = NULL,
+        .can_id = DFU_TRANSPORT_CAN_TX_ID,
+        .ready_path = NULL,
+        .device = { false, 0u, true },
+        .flash_timing = { 0u, 0u },
+        .timeout_ms = SERVE_DEFAULT_TIMEOUT_MS,
+        .image_out = NULL,
+        .code_size = SERVE_DEFAULT_CODE_SIZE,
+        .json = 0,
+    };
+    static serve_device_t devices[SERVE_MAX_DEVICES];
+    int ready[2];
+    uint32_t started = 0u;
+    uint32_t failed = 0u;
+    char byte;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'n': opt.count = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'l': opt.link_prefix = optarg; break;
+        case 'c': opt.can_interface = optarg; break;
+        case 'I': opt.can_id = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'r': opt.ready_path = optarg; break;
+        case 'm':
+            if ((strcmp(optarg, "event") != 0) && (strcmp(optarg, "poll") != 0)) {
+                usage(argv[0]);
+                return 2;
+            }
+            opt.device.event_driven = (strcmp(optarg, "event") == 0);
+            break;
+        case 'w': opt.device.window_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'P': opt.flash_timing.program_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'E': opt.flash_timing.erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'H': opt.device.digest = false; break;
+        case 't': opt.timeout_ms = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'W': opt.image_out = optarg; break;
+        case 's': opt.code_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'j': opt.json = 1; break;
+        default: usage(argv[0]); return (c == 'h') ? 0 : 2;
+        }
+    }
+    if (opt.image_out != NULL) {
+        return write_image(&opt);
+    }
+    if ((opt.count == 0u) || (opt.count > SERVE_MAX_DEVICES) || (opt.device.window_size > DFU_WINDOW_SIZE) ||
+        ((opt.can_interface != NULL) && (opt.can_id + 2u * opt.count > CAN_SFF_MASK + 1u))) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    for (uint32_t i = 0u; i < opt.count; i++) {
+        serve_device_t *device = &devices[i];
+
+        device->master = -1;
+        device->slave = -1;
+        if (opt.can_interface == NULL) {
+            if (open_pty(&opt, i, device) != 0) {
+                fprintf(stderr, "cannot create the pty of device %u: %s\n", i, strerror(errno));
+                return 1;
+            }
+            continue;
+        }
+        snprintf(device->spec, sizeof(device->spec), "can:%s:0x%x", opt.can_interface, opt.can_id + 2u * i);
+        if (dfu_transport_parse(device->spec, &device->config) != 0) {
+            fprintf(stderr, "bad CAN interface %s\n", opt.can_interface);
+            return 2;
+        }
+        device->config.windowed = (opt.device.window_size != 0u);
+    }
+
+    if (!opt.json) {
+        printf("DFU simulated devices: %u on %s, %s session loop, window %u\n", opt.count,
+               (opt.can_interface != NULL) ? opt.can_interface : "ptys", opt.device.event_driven ? "event-driven" : "polled",
+               opt.device.window_size);
+        fflush(stdout);
+    }
+    if (pipe(ready) != 0) {
+        return 1;
+    }
+    for (uint32_t i = 0u; i < opt.count; i++) {
+        pid_t pid = fork();
+
+        if (pid == 0) {
+            close(ready[0]);
+            _exit(serve_device(&opt, i, &devices[i], ready[1]));
+        }
+        if (pid < 0) {
+            fprintf(stderr, "cannot start device %u\n", i);
+            break;
+        }
+        devices[i].pid = pid;
+        started++;
+    }
+    close(ready[1]);
+
+    /* Every device signals once it listens; a device that fails closes its end */
+    for (uint32_t i = 0u; i < started; i++) {
+        if (read(ready[0], &byte, 1) != 1) {
+            break;
+        }
+    }
+    close(ready[0]);
+    if ((opt.ready_path != NULL) && (write_ready(opt.ready_path, devices, started) != 0)) {
+        fprintf(stderr, "cannot write %s\n", opt.ready_path);
+    }
+
+    for (uint32_t i = 0u; i < started; i++) {
+        int status;
+
+        if ((waitpid(devices[i].pid, &status, 0) != devices[i].pid) || !WIFEXITED(status) ||
+            (WEXITSTATUS(status) != 0)) {
+            failed++;
+        }
+    }
+    for (uint32_t i = 0u; i < opt.count; i++) {
+        if (devices[i].link[0] != '\0') {
+            (void)unlink(devices[i].link);
+        }
+    }
+    if (opt.ready_path != NULL) {
+        (void)unlink(opt.ready_path);
+    }
+    if (!opt.json) {
+        printf("  %u of %u devices updated\n", started - failed, opt.count);
+    }
+    return ((failed == 0u) && (started == opt.count)) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,781 @@
+/******************************************************************************
+ * File Name:   dfu_transport.c
+ *
+ * Description: Transports of the command line DFU host on Linux. UART and CAN FD carry the frames
+ *              as a stream, which is parsed in place in the receive buffer: a frame is located by
+ *              its start of packet and its length field and is copied once, to the caller. spidev
+ *              and i2c-dev poll the slave for the start of the response, then read the rest of it.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <linux/i2c-dev.h>
+#include <linux/spi/spidev.h>
+#include "dfu_transport.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Interval at which SPI and I2C poll the slave for a response */
+#define DFU_TRANSPORT_BUS_POLL_US   (100u)
+
+/* Byte the SPI slave shifts out while it has no response */
+#define DFU_TRANSPORT_SPI_IDLE      (0xFFu)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t baud;
+    speed_t speed;
+} dfu_transport_baud_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const dfu_transport_baud_t transport_bauds[] = {
+    { 9600u, B9600 },
+    { 19200u, B19200 },
+    { 38400u, B38400 },
+    { 57600u, B57600 },
+    { 115200u, B115200 },
+    { 230400u, B230400 },
+    { 460800u, B460800 },
+    { 921600u, B921600 },
+    { 1000000u, B1000000 },
+    { 2000000u, B2000000 },
+    { 3000000u, B3000000 },
+    { 4000000u, B4000000 },
+};
+
+static const char *const transport_names[] = { "uart", "can", "spi", "i2c" };
+
+/*******************************************************************************
+ * Function Name: parse_number
+ ********************************************************************************
+ * Parses the next ':' separated number of a transport specification, if
+ * there is one.
+ *
+ * Return:
+ *  0 on success or when the field is absent, -1 on a malformed number.
+ *******************************************************************************/
+static int parse_number(const char **cursor, uint32_t *value) {
+    char *end;
+    unsigned long number;
+
+    if (**cursor != ':') {
+        return (**cursor == '\0') ? 0 : -1;
+    }
+    (*cursor)++;
+    errno = 0;
+    number = strtoul(*cursor, &end, 0);
+    if ((end == *cursor) || (errno != 0) || (number > UINT32_MAX) || ((*end != ':') && (*end != '\0'))) {
+        return -1;
+    }
+    *value = (uint32_t)number;
+    *cursor = end;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_transport_parse
+ ********************************************************************************
+ * Parses a transport specification:
+ *  uart:/dev/ttyUSB0[:baud]
+ *  can:can0[:tx_id[:rx_id]]
+ *  spi:/dev/spidev0.0[:hz]
+ *  i2c:/dev/i2c-1[:address[:hz]]
+ * Absent fields take the settings of the DFU transports of the application.
+ *
+ * Return:
+ *  0 on success, -1 on a malformed specification.
+ *******************************************************************************/
+int dfu_transport_parse(const char *spec, dfu_transport_config_t *config) {
+    const char *colon = strchr(spec, ':');
+    const char *path;
+    size_t path_len;
+    uint32_t type;
+
+    memset(config, 0, sizeof(*config));
+    if (colon == NULL) {
+        return -1;
+    }
+    for (type = 0u; type < sizeof(transport_names) / sizeof(transport_names[0]); type++) {
+        if ((strlen(transport_names[type]) == (size_t)(colon - spec)) &&
+            (strncmp(spec, transport_names[type], (size_t)(colon - spec)) == 0)) {
+            break;
+        }
+    }
+    if (type == sizeof(transport_names) / sizeof(transport_names[0])) {
+        return -1;
+    }
+    config->type = (dfu_transport_type_t)type;
+
+    path = colon + 1;
+    path_len = strcspn(path, ":");
+    if ((path_len == 0u) || (path_len >= sizeof(config->path))) {
+        return -1;
+    }
+    memcpy(config->path, path, path_len);
+    path += path_len;
+
+    switch (config->type) {
+    case DFU_TRANSPORT_UART:
+        config->speed = DFU_TRANSPORT_UART_BAUD;
+        if (parse_number(&path, &config->speed) != 0) {
+            return -1;
+        }
+        break;
+    case DFU_TRANSPORT_CAN:
+        config->tx_id = DFU_TRANSPORT_CAN_TX_ID;
+        if (parse_number(&path, &config->tx_id) != 0) {
+            return -1;
+        }
+        /* A single identifier selects the pair, the responses come with the next one */
+        config->rx_id = config->tx_id + 1u;
+        if ((parse_number(&path, &config->rx_id) != 0) || (config->tx_id > CAN_SFF_MASK) ||
+            (config->rx_id > CAN_SFF_MASK)) {
+            return -1;
+        }
+        break;
+    case DFU_TRANSPORT_SPI:
+        config->speed = DFU_TRANSPORT_SPI_HZ;
+        if (parse_number(&path, &config->speed) != 0) {
+            return -1;
+        }
+        break;
+    default:
+        config->address = DFU_TRANSPORT_I2C_ADDRESS;
+        config->speed = DFU_TRANSPORT_I2C_HZ;
+        if ((parse_number(&path, &config->address) != 0) || (parse_number(&path, &config->speed) != 0) ||
+            (config->address > 0x7Fu)) {
+            return -1;
+        }
+        break;
+    }
+    return (*path == '\0') ? 0 : -1;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_transport_name
+ ********************************************************************************
+ * Returns the name of a transport type, as in the specifications.
+ *******************************************************************************/
+const char *dfu_transport_name(dfu_transport_type_t type) {
+    return ((uint32_t)type < sizeof(transport_names) / sizeof(transport_names[0])) ? transport_names[type] : "?";
+}
+
+/*******************************************************************************
+ * Function Name: uart_setup
+ ********************************************************************************
+ * Puts a serial port or a pty in raw mode, 8N1 without flow control.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int uart_setup(int fd, uint32_t baud) {
+    struct termios tio;
+    uint32_t i;
+
+    for (i = 0u; i < sizeof(transport_bauds) / sizeof(transport_bauds[0]); i++) {
+        if (transport_bauds[i].baud == baud) {
+            break;
+        }
+    }
+    if ((i == sizeof(transport_bauds) / sizeof(transport_bauds[0])) || (tcgetattr(fd, &tio) != 0)) {
+        return -1;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    if ((cfsetspeed(&tio, transport_bauds[i].speed) != 0) || (tcsetattr(fd, TCSANOW, &tio) != 0)) {
+        return -1;
+    }
+    return tcflush(fd, TCIOFLUSH);
+}
+
+/*******************************************************************************
+ * Function Name: can_setup
+ ********************************************************************************
+ * Opens a raw CAN socket with CAN FD frames on the interface, receiving
+ * the identifier of the other end only.
+ *
+ * Return:
+ *  The socket, -1 on failure.
+ *******************************************************************************/
+static int can_setup(const char *name, uint32_t rx_id) {
+    struct can_filter filter = { .can_id = rx_id, .can_mask = CAN_SFF_MASK | CAN_EFF_FLAG | CAN_RTR_FLAG };
+    struct sockaddr_can addr;
+    int enable = 1;
+    int fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+
+    if (fd < 0) {
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = (int)if_nametoindex(name);
+    if ((addr.can_ifindex == 0) ||
+        (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) != 0) ||
+        (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter)) != 0) ||
+        (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*******************************************************************************
+ * Function Name: spi_setup
+ ********************************************************************************
+ * Sets SPI mode 0, MSB first, 8-bit words and the clock of the bus.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int spi_setup(int fd, uint32_t hz) {
+    uint8_t mode = SPI_MODE_0;
+    uint8_t lsb_first = 0u;
+    uint8_t bits = 8u;
+
+    if ((ioctl(fd, SPI_IOC_WR_MODE, &mode) < 0) || (ioctl(fd, SPI_IOC_WR_LSB_FIRST, &lsb_first) < 0) ||
+        (ioctl(fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) || (ioctl(fd, SPI_IOC_WR_MAX_SPEED_HZ, &hz) < 0)) {
+        return -1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_transport_open
+ ********************************************************************************
+ * Opens a transport. The I2C clock is a setting of the adapter and is not
+ * changed from here.
+ *
+ * Parameters:
+ *  transport      Transport to open.
+ *  config         Configuration, see dfu_transport_parse().
+ *  device         Open the device end: the CAN identifiers are swapped.
+ *                 SPI and I2C only have the host end.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int dfu_transport_open(dfu_transport_t *transport, const dfu_transport_config_t *config, bool device) {
+    int fd = -1;
+
+    memset(transport, 0, sizeof(*transport));
+    transport->config = *config;
+    transport->fd = -1;
+
+    switch (config->type) {
+    case DFU_TRANSPORT_UART:
+        fd = open(config->path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+        if ((fd >= 0) && (uart_setup(fd, config->speed) != 0)) {
+            close(fd);
+            fd = -1;
+        }
+        break;
+    case DFU_TRANSPORT_CAN:
+        if (device) {
+            transport->config.tx_id = config->rx_id;
+            transport->config.rx_id = config->tx_id;
+        }
+        fd = can_setup(config->path, transport->config.rx_id);
+        break;
+    case DFU_TRANSPORT_SPI:
+        fd = device ? -1 : open(config->path, O_RDWR | O_CLOEXEC);
+        if ((fd >= 0) && (spi_setup(fd, config->speed) != 0)) {
+            close(fd);
+            fd = -1;
+        }
+        break;
+    default:
+        fd = device ? -1 : open(config->path, O_RDWR | O_CLOEXEC);
+        if ((fd >= 0) && (ioctl(fd, I2C_SLAVE, (unsigned long)config->address) < 0)) {
+            close(fd);
+            fd = -1;
+        }
+        break;
+    }
+    transport->fd = fd;
+    return (fd >= 0) ? 0 : -1;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_transport_attach
+ ********************************************************************************
+ * Opens a UART transport on a descriptor that is already open, the master
+ * end of a pty for the device end of a loopback. The transport owns the
+ * descriptor.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int dfu_transport_attach(dfu_transport_t *transport, const dfu_transport_config_t *config, int fd) {
+    memset(transport, 0, sizeof(*transport));
+    transport->config = *config;
+    transport->fd = -1;
+    if ((config->type != DFU_TRANSPORT_UART) || (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0)) {
+        return -1;
+    }
+    transport->fd = fd;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_transport_close
+ ********************************************************************************
+ * Closes a transport.
+ *******************************************************************************/
+void dfu_transport_close(dfu_transport_t *transport) {
+    if (transport->fd >= 0) {
+        close(transport->fd);
+        transport->fd = -1;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: frame_length
+ ********************************************************************************
+ * Finds the frame at the start of the received bytes: a DFU packet, after
+ * the header of the DFU window in the windowed mode, where an ack frame is
+ * the header alone. The checksum is checked by the receiver of the packet.
+ *
+ * Return:
+ *  Length of the frame, 0 if more bytes are needed, -1 if the bytes do not
+ *  start a frame.
+ *******************************************************************************/
+static int frame_length(const uint8_t *p, uint32_t available, bool windowed) {
+    uint32_t header = 0u;
+    uint32_t length;
+
+    if (windowed) {
+        if (available == 0u) {
+            return 0;
+        }
+        if (p[0] == DFU_WINDOW_FRAME_ACK) {
+            return (available >= DFU_WINDOW_HEADER_SIZE) ? (int)DFU_WINDOW_HEADER_SIZE : 0;
+        }
+        if (p[0] != DFU_WINDOW_FRAME_DATA) {
+            return -1;
+        }
+        header = DFU_WINDOW_HEADER_SIZE;
+    }
+    if (available <= header) {
+        return 0;
+    }
+    if (p[header] != CY_DFU_PACKET_SOP) {
+        return -1;
+    }
+    if (available < header + CY_DFU_PACKET_HEADER_SIZE) {
+        return 0;
+    }
+    length = (uint32_t)p[header + 2u] | ((uint32_t)p[header + 3u] << 8);
+    if (length > CY_DFU_MAX_PACKET_DATA) {
+        return -1;
+    }
+    length += header + CY_DFU_PACKET_OVERHEAD;
+    if (available < length) {
+        return 0;
+    }
+    return (p[length - 1u] == CY_DFU_PACKET_EOP) ? (int)length : -1;
+}
+
+/*******************************************************************************
+ * Function Name: take_frame
+ ********************************************************************************
+ * Takes the next complete frame from the receive buffer, skipping the
+ * bytes that do not start one. A CAN message is padded to a CAN FD frame
+ * length, the rest of the message after the frame is dropped.
+ *
+ * Return:
+ *  Length of the frame, 0 if there is none yet, -1 if it does not fit.
+ *******************************************************************************/
+static int take_frame(dfu_transport_t *transport, uint8_t *data, uint32_t size) {
+    for (;;) {
+        uint32_t available = transport->rx_end - transport->rx_start;
+        const uint8_t *p = &transport->rx[transport->rx_start];
+        int length = frame_length(p, available, transport->config.windowed);
+
+        if (length < 0) {
+            /* A CAN message starts at a frame or not at all */
+            uint32_t skip = (transport->config.type == DFU_TRANSPORT_CAN) ? available : 1u;
+
+            transport->stats.resyncs += skip;
+            transport->rx_start += skip;
+            continue;
+        }
+        if (length == 0) {
+            if (transport->rx_start == transport->rx_end) {
+                transport->rx_start = 0u;
+                transport->rx_end = 0u;
+            }
+            return 0;
+        }
+        if ((uint32_t)length > size) {
+            transport->rx_start += (uint32_t)length;
+            return -1;
+        }
+        memcpy(data, p, (size_t)length);
+        transport->rx_start += (uint32_t)length;
+        if (transport->config.type == DFU_TRANSPORT_CAN) {
+            transport->rx_start = transport->rx_end;
+        }
+        transport->stats.rx_frames++;
+        return length;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: rx_space
+ ********************************************************************************
+ * Moves the bytes not taken yet to the start of the receive buffer when
+ * the free space at its end is short of `needed` bytes.
+ *
+ * Return:
+ *  Free space at the end of the receive buffer.
+ *******************************************************************************/
+static uint32_t rx_space(dfu_transport_t *transport, uint32_t needed) {
+    if ((DFU_TRANSPORT_RX_SIZE - transport->rx_end < needed) && (transport->rx_start != 0u)) {
+        memmove(transport->rx, &transport->rx[transport->rx_start], transport->rx_end - transport->rx_start);
+        transport->rx_end -= transport->rx_start;
+        transport->rx_start = 0u;
+    }
+    return DFU_TRANSPORT_RX_SIZE - transport->rx_end;
+}
+
+/*******************************************************************************
+ * Function Name: stream_fill
+ ********************************************************************************
+ * Reads what the UART or the CAN interface received. A CAN read returns one
+ * frame, whose payload is appended to the stream.
+ *
+ * Return:
+ *  Number of bytes appended, 0 if nothing was waiting, -1 on failure.
+ *******************************************************************************/
+static int stream_fill(dfu_transport_t *transport) {
+    ssize_t received;
+
+    if (transport->config.type == DFU_TRANSPORT_CAN) {
+        struct canfd_frame frame;
+
+        received = read(transport->fd, &frame, sizeof(frame));
+        if (received < 0) {
+            return ((errno == EAGAIN) || (errno == EINTR)) ? 0 : -1;
+        }
+        if ((received < (ssize_t)CAN_MTU) || (frame.len > CANFD_MAX_DLEN) ||
+            ((frame.can_id & CAN_SFF_MASK) != transport->config.rx_id)) {
+            return 0;
+        }
+        if (rx_space(transport, frame.len) < frame.len) {
+            /* Longer than any frame: start again at the next message */
+            transport->stats.resyncs += transport->rx_end - transport->rx_start;
+            transport->rx_start = 0u;
+            transport->rx_end = 0u;
+        }
+        memcpy(&transport->rx[transport->rx_end], frame.data, frame.len);
+        transport->rx_end += frame.len;
+        transport->stats.rx_bytes += frame.len;
+        return (int)frame.len;
+    }
+
+    if (rx_space(transport, DFU_WINDOW_FRAME_SIZE) == 0u) {
+        transport->stats.resyncs += transport->rx_end - transport->rx_start;
+        transport->rx_start = 0u;
+        transport->rx_end = 0u;
+    }
+    received = read(transport->fd, &transport->rx[transport->rx_end], DFU_TRANSPORT_RX_SIZE - transport->rx_end);
+    if (received < 0) {
+        /* EIO: the other end of the pty is not open (yet) */
+        return ((errno == EAGAIN) || (errno == EINTR) || (errno == EIO)) ? 0 : -1;
+    }
+    transport->rx_end += (uint32_t)received;
+    transport->stats.rx_bytes += (uint64_t)received;
+    return (int)received;
+}
+
+/*******************************************************************************
+ * Function Name: bus_fill
+ ********************************************************************************
+ * Polls the SPI or I2C slave once for its response. The start of the
+ * response is read first, up to the length field of the packet; the rest
+ * follows in the same SPI transfer sequence, while I2C reads the whole
+ * response again from its start, as the slave sends its buffer from the
+ * start on every read.
+ *
+ * Return:
+ *  Number of bytes appended, 0 if the slave has no response yet, -1 on
+ *  failure.
+ *******************************************************************************/
+static int bus_fill(dfu_transport_t *transport) {
+    uint32_t header = transport->config.windowed ? DFU_WINDOW_HEADER_SIZE : 0u;
+    uint32_t start_len = header + CY_DFU_PACKET_HEADER_SIZE;
+    uint8_t *p;
+    uint32_t length;
+    int frame;
+
+    if (rx_space(transport, DFU_WINDOW_FRAME_SIZE) < DFU_WINDOW_FRAME_SIZE) {
+        return -1;
+    }
+    p = &transport->rx[transport->rx_end];
+
+    if (transport->config.type == DFU_TRANSPORT_SPI) {
+        struct spi_ioc_transfer xfer;
+
+        memset(&xfer, 0, sizeof(xfer));
+        memset(p, DFU_TRANSPORT_SPI_IDLE, start_len);
+        xfer.tx_buf = (uintptr_t)p;
+        xfer.rx_buf = (uintptr_t)p;
+        xfer.len = start_len;
+        xfer.speed_hz = transport->config.speed;
+        xfer.bits_per_word = 8u;
+        /* Keep the slave selected: the rest of the response follows */
+        xfer.cs_change = 1u;
+        if (ioctl(transport->fd, SPI_IOC_MESSAGE(1), &xfer) < 0) {
+            return -1;
+        }
+        if (p[0] == DFU_TRANSPORT_SPI_IDLE) {
+            return 0;
+        }
+        frame = frame_length(p, start_len, transport->config.windowed);
+        if (frame < 0) {
+            transport->stats.resyncs += start_len;
+            return 0;
+        }
+        length = (frame > 0) ? (uint32_t)frame : (header + CY_DFU_PACKET_OVERHEAD +
+                                                  ((uint32_t)p[header + 2u] | ((uint32_t)p[header + 3u] << 8)));
+        if (length > start_len) {
+            memset(&p[start_len], DFU_TRANSPORT_SPI_IDLE, length - start_len);
+            xfer.tx_buf = (uintptr_t)&p[start_len];
+            xfer.rx_buf = (uintptr_t)&p[start_len];
+            xfer.len = length - start_len;
+            xfer.cs_change = 0u;
+            if (ioctl(transport->fd, SPI_IOC_MESSAGE(1), &xfer) < 0) {
+                return -1;
+            }
+        }
+    } else {
+        ssize_t received = read(transport->fd, p, start_len);
+
+        /* The slave does not acknowledge its address until it has a response */
+        if (received < 0) {
+            return ((errno == EREMOTEIO) || (errno == ENXIO) || (errno == EAGAIN)) ? 0 : -1;
+        }
+        if ((uint32_t)received < start_len) {
+            return 0;
+        }
+        frame = frame_length(p, start_len, transport->config.windowed);
+        if (frame < 0) {
+            transport->stats.resyncs += start_len;
+            return 0;
+        }
+        length = (frame > 0) ? (uint32_t)frame : (header + CY_DFU_PACKET_OVERHEAD +
+                                                  ((uint32_t)p[header + 2u] | ((uint32_t)p[header + 3u] << 8)));
+        if ((length > start_len) && (read(transport->fd, p, length) != (ssize_t)length)) {
+            return 0;
+        }
+    }
+    transport->rx_end += length;
+    transport->stats.rx_bytes += length;
+    return (int)length;
+}
+
+/*******************************************************************************
+ * Function Name: wait_writable
+ ********************************************************************************
+ * Waits until a full output queue has room again.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int wait_writable(int fd) {
+    struct pollfd pfd = { .fd = fd, .events = POLLOUT };
+
+    return ((errno == EAGAIN) || (errno == ENOBUFS) || (errno == EINTR)) && (poll(&pfd, 1, 1) >= 0) ? 0 : -1;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_transport_send
+ ********************************************************************************
+ * Sends one frame. UART, SPI and I2C write it from the buffer of the
+ * caller; CAN splits it into CAN FD frames of up to 64 bytes.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int dfu_transport_send(void *context, const uint8_t *data, uint32_t length) {
+    dfu_transport_t *transport = context;
+    uint32_t sent = 0u;
+
+    if (transport->config.type == DFU_TRANSPORT_CAN) {
+        struct canfd_frame frame;
+
+        memset(&frame, 0, sizeof(frame));
+        frame.can_id = transport->config.tx_id;
+        frame.flags = CANFD_BRS;
+        while (sent < length) {
+            frame.len = (uint8_t)(((length - sent) > CANFD_MAX_DLEN) ? CANFD_MAX_DLEN : (length - sent));
+            memcpy(frame.data, &data[sent], frame.len);
+            while (write(transport->fd, &frame, CANFD_MTU) != (ssize_t)CANFD_MTU) {
+                if (wait_writable(transport->fd) != 0) {
+                    return -1;
+                }
+            }
+            sent += frame.len;
+        }
+    } else if (transport->config.type == DFU_TRANSPORT_SPI) {
+        struct spi_ioc_transfer xfer;
+
+        memset(&xfer, 0, sizeof(xfer));
+        xfer.tx_buf = (uintptr_t)data;
+        xfer.len = length;
+        xfer.speed_hz = transport->config.speed;
+        xfer.bits_per_word = 8u;
+        if (ioctl(transport->fd, SPI_IOC_MESSAGE(1), &xfer) < 0) {
+            return -1;
+        }
+    } else {
+        while (sent < length) {
+            ssize_t written = write(transport->fd, &data[sent], length - sent);
+
+            if (written > 0) {
+                sent += (uint32_t)written;
+            } else if ((written < 0) && (wait_writable(transport->fd) != 0)) {
+                return -1;
+            }
+        }
+    }
+    transport->stats.tx_bytes += length;
+    transport->stats.tx_frames++;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_transport_recv
+ ********************************************************************************
+ * Waits for one frame.
+ *
+ * Return:
+ *  Number of bytes received, -1 on timeout or failure.
+ *******************************************************************************/
+int dfu_transport_recv(void *context, uint8_t *data, uint32_t size, uint32_t timeout_ms) {
+    dfu_transport_t *transport = context;
+    uint64_t deadline = sim_time_us() + ((uint64_t)timeout_ms * 1000u);
+    bool bus = (transport->config.type == DFU_TRANSPORT_SPI) || (transport->config.type == DFU_TRANSPORT_I2C);
+
+    for (;;) {
+        int length = take_frame(transport, data, size);
+        uint64_t now;
+        int filled;
+
+        if (length != 0) {
+            return length;
+        }
+        filled = bus ? bus_fill(transport) : stream_fill(transport);
+        if (filled < 0) {
+            return -1;
+        }
+        if (filled > 0) {
+            continue;
+        }
+        now = sim_time_us();
+        if (now >= deadline) {
+            return -1;
+        }
+        if (bus) {
+            sim_sleep_us(((deadline - now) < DFU_TRANSPORT_BUS_POLL_US) ? (deadline - now) :
+                         DFU_TRANSPORT_BUS_POLL_US);
+        } else {
+            struct pollfd pfd = { .fd = transport->fd, .events = POLLIN };
+
+            if ((poll(&pfd, 1, (int)((deadline - now + 999u) / 1000u)) > 0) && ((pfd.revents & POLLHUP) != 0) &&
+                ((pfd.revents & POLLIN) == 0)) {
+                /* Nobody on the other end of the pty, do not spin */
+                sim_sleep_us(1000u);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: dfu_transport_wait
+ ********************************************************************************
+ * Blocks the device end until bytes arrive, like a core sleeping until the
+ * transport RX interrupt.
+ *
+ * Return:
+ *  true if a frame is buffered or bytes are waiting, false on timeout.
+ *******************************************************************************/
+bool dfu_transport_wait(dfu_transport_t *transport, uint32_t timeout_ms) {
+    struct pollfd pfd = { .fd = transport->fd, .events = POLLIN };
+
+    if (frame_length(&transport->rx[transport->rx_start], transport->rx_end - transport->rx_start,
+                     transport->config.windowed) > 0) {
+        return true;
+    }
+    return (poll(&pfd, 1, (int)timeout_ms) > 0) && ((pfd.revents & POLLIN) != 0);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_transport_flush
+ ********************************************************************************
+ * Drops the bytes received and not taken yet.
+ *******************************************************************************/
+void dfu_transport_flush(dfu_transport_t *transport) {
+    transport->rx_start = 0u;
+    transport->rx_end = 0u;
+    while (stream_fill(transport) > 0) {
+        transport->rx_start = 0u;
+        transport->rx_end = 0u;
+    }
+}
+
+/* [] END OF FILE */
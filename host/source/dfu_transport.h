@@ -0,0 +1,135 @@
+/******************************************************************************
+ * File Name:   dfu_transport.h
+ *
+ * Description: Transports of the command line DFU host on Linux: UART (a serial port or a pty), CAN
+ *              FD over SocketCAN, spidev and i2c-dev. Frames the DFU packets, with the header of
+ *              the DFU window when it is used, over the byte streams and the CAN frames, and also
+ *              serves as the device end of the loopback tests.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_TRANSPORT_H
+#define DFU_TRANSPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_dfu.h"
+#include "dfu_window.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define DFU_TRANSPORT_PATH_SIZE     (64u)
+
+/* Received bytes not taken yet: a few frames, one read() fills it */
+#define DFU_TRANSPORT_RX_SIZE       (4u * DFU_WINDOW_FRAME_SIZE)
+
+/* Settings of the DFU transports of the application, see README.md */
+#define DFU_TRANSPORT_UART_BAUD     (115200u)
+#define DFU_TRANSPORT_SPI_HZ        (1000000u)
+#define DFU_TRANSPORT_I2C_ADDRESS   (12u)
+#define DFU_TRANSPORT_I2C_HZ        (400000u)
+
+/* CAN identifier of the host commands, the device responds with the next
+ * one */
+#define DFU_TRANSPORT_CAN_TX_ID     (0x100u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    DFU_TRANSPORT_UART,
+    DFU_TRANSPORT_CAN,
+    DFU_TRANSPORT_SPI,
+    DFU_TRANSPORT_I2C
+} dfu_transport_type_t;
+
+typedef struct {
+    dfu_transport_type_t type;
+    /* Device node, or name of the CAN interface */
+    char path[DFU_TRANSPORT_PATH_SIZE];
+    /* UART baud rate, SPI or I2C clock */
+    uint32_t speed;
+    /* CAN: identifier the host sends with and the one it receives, the
+     * device end swaps them */
+    uint32_t tx_id;
+    uint32_t rx_id;
+    /* I2C slave address */
+    uint32_t address;
+    /* Frames start with the header of the DFU window, the window of the
+     * sender is not 0 */
+    bool windowed;
+} dfu_transport_config_t;
+
+typedef struct {
+    uint64_t tx_bytes;
+    uint64_t rx_bytes;
+    uint32_t tx_frames;
+    uint32_t rx_frames;
+    /* Bytes skipped to find the start of a frame */
+    uint32_t resyncs;
+} dfu_transport_stats_t;
+
+typedef struct {
+    dfu_transport_config_t config;
+    int fd;
+    /* Received bytes, the frames are found in place in rx[rx_start, rx_end) */
+    uint8_t rx[DFU_TRANSPORT_RX_SIZE];
+    uint32_t rx_start;
+    uint32_t rx_end;
+    dfu_transport_stats_t stats;
+} dfu_transport_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+int dfu_transport_parse(const char *spec, dfu_transport_config_t *config);
+const char *dfu_transport_name(dfu_transport_type_t type);
+int dfu_transport_open(dfu_transport_t *transport, const dfu_transport_config_t *config, bool device);
+int dfu_transport_attach(dfu_transport_t *transport, const dfu_transport_config_t *config, int fd);
+void dfu_transport_close(dfu_transport_t *transport);
+
+/* Frames, match dfu_host_link_t with the transport as the context */
+int dfu_transport_send(void *context, const uint8_t *data, uint32_t length);
+int dfu_transport_recv(void *context, uint8_t *data, uint32_t size, uint32_t timeout_ms);
+
+/* Device end */
+bool dfu_transport_wait(dfu_transport_t *transport, uint32_t timeout_ms);
+void dfu_transport_flush(dfu_transport_t *transport);
+
+#endif /* DFU_TRANSPORT_H */
+
+/* [] END OF FILE */
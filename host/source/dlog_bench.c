@@ -0,0 +1,411 @@
+/******************************************************************************
+ * File Name:   dlog_bench.c
+ *
+ * Description: Per-call cost of the deferred log (DLOG=1) against the printf() of the console that
+ *              it replaces: the record written to the lane of the core against the formatting and
+ *              the UART time that a blocking printf() waits for. Checks the round trip of the
+ *              messages through the drained "@D" lines and the .dlog_fmt section of this program,
+ *              and can write the lines as a console capture for dlog_decode.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dlog.h"
+#include "dlog_elf.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define DLOG_BENCH_MESSAGES         (8u)
+#define DLOG_BENCH_TEXT_MAX         (160u)
+
+/* Records taken by the consumer of the cost loop, a quarter of the lane */
+#define DLOG_BENCH_BATCH            (8u)
+
+/* Writes a message to the lane and its expected text with snprintf() */
+#define DLOG_BENCH_MESSAGE(fmt, ...) \
+    do { \
+        DLOG_INF(fmt, ##__VA_ARGS__); \
+        bench_expect(fmt, ##__VA_ARGS__); \
+    } while (0)
+
+/* Message of the cost loop, a row written by the DFU session */
+#define DLOG_BENCH_FMT              "[DFU App] Row 0x%08x of image %u written\r\n"
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t calls;
+    uint32_t baud;
+    const char *capture;
+    const char *dump;
+    bool json;
+} dlog_bench_options_t;
+
+typedef struct {
+    /* Cost per call, in nanoseconds */
+    double dlog_ns;
+    double snprintf_ns;
+    /* Time a blocking printf() of the message waits for the UART */
+    double uart_us;
+    /* Bytes of the message: text, record and drained line */
+    uint32_t text_bytes;
+    uint32_t record_bytes;
+    uint32_t line_bytes;
+    /* Round trip of the messages */
+    uint32_t matched;
+    uint32_t messages;
+    uint32_t dropped;
+    bool drained;
+} dlog_bench_result_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static dlog_t bench_region;
+
+/* Expected texts of the round trip, and the drained lines */
+static char bench_expected[DLOG_BENCH_MESSAGES][DLOG_BENCH_TEXT_MAX];
+static uint32_t bench_expected_count = 0u;
+static char bench_lines[DLOG_BENCH_MESSAGES * 2u][DLOG_LINE_MAX + 1u];
+static uint32_t bench_line_count = 0u;
+
+/* Sink of the formatted messages of the cost loop, and its clock, a load
+ * as the cycle counter of the target */
+volatile uint32_t bench_sink;
+static volatile uint32_t bench_cycles;
+
+/* Start of the round trip */
+static uint64_t bench_start_us;
+
+/*******************************************************************************
+ * Function Name: dlog_region
+ ********************************************************************************
+ * Return:
+ *  The region of the host, in place of the RAM at DLOG_ADDR.
+ *******************************************************************************/
+dlog_t *dlog_region(void) {
+    return &bench_region;
+}
+
+/*******************************************************************************
+ * Function Name: bench_now
+ ********************************************************************************
+ * Return:
+ *  Timestamp of the records, in microseconds.
+ *******************************************************************************/
+static uint32_t bench_now(void) {
+    return (uint32_t)(sim_time_us() - bench_start_us);
+}
+
+/*******************************************************************************
+ * Function Name: bench_cycle_counter
+ ********************************************************************************
+ * Return:
+ *  Timestamp of the records of the cost loop.
+ *******************************************************************************/
+static uint32_t bench_cycle_counter(void) {
+    return bench_cycles;
+}
+
+/*******************************************************************************
+ * Function Name: bench_expect
+ ********************************************************************************
+ * Records the text that the decoder must print for the next message, the
+ * message without its line end.
+ *******************************************************************************/
+static void bench_expect(const char *fmt, ...) {
+    va_list args;
+    char *text;
+    size_t length;
+
+    if (bench_expected_count >= DLOG_BENCH_MESSAGES) {
+        return;
+    }
+    text = bench_expected[bench_expected_count++];
+    va_start(args, fmt);
+    (void)vsnprintf(text, DLOG_BENCH_TEXT_MAX, fmt, args);
+    va_end(args);
+    length = strlen(text);
+    while ((length != 0u) && ((text[length - 1u] == '\n') || (text[length - 1u] == '\r'))) {
+        text[--length] = '\0';
+    }
+}
+
+/*******************************************************************************
+ * Function Name: bench_out
+ ********************************************************************************
+ * Output of dlog_drain(), keeps the lines.
+ *******************************************************************************/
+static bool bench_out(const char *line, uint32_t length) {
+    if ((bench_line_count >= (DLOG_BENCH_MESSAGES * 2u)) || (length > DLOG_LINE_MAX)) {
+        return false;
+    }
+    memcpy(bench_lines[bench_line_count], line, length);
+    bench_lines[bench_line_count][length] = '\0';
+    bench_line_count++;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name, const dlog_bench_options_t *opt) {
+    printf("Usage: %s [options]\n"
+           "Per-call cost of the deferred log against the blocking printf() of the console.\n"
+           "  --calls N           log calls of the cost loop (default %u)\n"
+           "  --baud N            baud rate of the console UART (default %u)\n"
+           "  --capture FILE      write the drained lines of the round trip, for dlog_decode\n"
+           "  --dump FILE         write the region before the drain, as a RAM dump for dlog_decode --dump\n"
+           "  --json              machine-readable output\n",
+           name, opt->calls, opt->baud);
+}
+
+/*******************************************************************************
+ * Function Name: bench_cost
+ ********************************************************************************
+ * Measures the cost of a log call, and of the formatting of the same message.
+ * The cost loop takes the records in batches, as the drain of the DFU
+ * application does between the commands.
+ *******************************************************************************/
+static void bench_cost(const dlog_bench_options_t *opt, dlog_bench_result_t *r) {
+    dlog_lane_t *lane = &dlog_region()->lanes[DLOG_LANE_CM7_0];
+    uint32_t record[DLOG_RECORD_WORDS(DLOG_MAX_ARGS)];
+    char text[DLOG_BENCH_TEXT_MAX];
+    uint64_t start;
+    uint32_t words;
+
+    dlog_init(DLOG_LANE_CM7_0, bench_cycle_counter, 1000000u);
+    start = sim_time_us();
+    for (uint32_t i = 0u; i < opt->calls; i++) {
+        DLOG_INF(DLOG_BENCH_FMT, 0x10600000u + (i * 0x200u), 1u);
+        if ((i % DLOG_BENCH_BATCH) == (DLOG_BENCH_BATCH - 1u)) {
+            lane->tail = lane->head;
+        }
+    }
+    r->dlog_ns = (double)(sim_time_us() - start) * 1000.0 / opt->calls;
+    r->dropped = lane->dropped;
+
+    start = sim_time_us();
+    for (uint32_t i = 0u; i < opt->calls; i++) {
+        bench_sink += (uint32_t)snprintf(text, sizeof(text), DLOG_BENCH_FMT, 0x10600000u + (i * 0x200u), 1u);
+    }
+    r->snprintf_ns = (double)(sim_time_us() - start) * 1000.0 / opt->calls;
+
+    /* One message: its text on the UART, 10 bits a byte, its record and its
+     * drained line */
+    r->text_bytes = (uint32_t)snprintf(text, sizeof(text), DLOG_BENCH_FMT, 0x10600000u, 1u);
+    r->uart_us = (double)r->text_bytes * 10.0 * 1000000.0 / opt->baud;
+    dlog_init(DLOG_LANE_CM7_0, bench_now, 1000000u);
+    DLOG_INF(DLOG_BENCH_FMT, 0x10600000u, 1u);
+    words = dlog_read(lane, record, DLOG_RECORD_WORDS(DLOG_MAX_ARGS));
+    r->record_bytes = words * 4u;
+    r->line_bytes = dlog_format_line(DLOG_LANE_CM7_0, record, words, text);
+}
+
+/*******************************************************************************
+ * Function Name: bench_round_trip
+ ********************************************************************************
+ * Logs the messages of the boot and DFU paths, drains them and decodes the
+ * lines with the .dlog_fmt section of this program.
+ *
+ * Return:
+ *  0 on success, -1 if this program cannot be read.
+ *******************************************************************************/
+static int bench_round_trip(const dlog_bench_options_t *opt, dlog_bench_result_t *r) {
+    dlog_elf_t elf;
+    uint32_t message = 0u;
+    FILE *capture = NULL;
+
+    if (dlog_elf_load("/proc/self/exe", &elf) != 0) {
+        return -1;
+    }
+    memset(&bench_region, 0, sizeof(bench_region));
+    bench_start_us = sim_time_us();
+    bench_expected_count = 0u;
+    bench_line_count = 0u;
+
+    dlog_init(DLOG_LANE_CM0P, bench_now, 1000000u);
+    DLOG_BENCH_MESSAGE("Edge Protect Bootloader Started");
+    DLOG_BENCH_MESSAGE("Start slot Address: 0x%08" PRIx32, (uint32_t)0x10060400u);
+    DLOG_BENCH_MESSAGE("Boot of image %d failed %lu times, %d", 2, (unsigned long)3u, -1);
+    dlog_init(DLOG_LANE_CM7_0, bench_now, 1000000u);
+    DLOG_BENCH_MESSAGE("[DFU App] Restarted the DFU\r\n");
+    DLOG_BENCH_MESSAGE("[DFU App] Received response: %c\r\n", 'Y');
+    DLOG_BENCH_MESSAGE("[DFU App] %5d|%-6u|%+d|%#x|%02X|%%\r\n", -42, 7u, 3, 255u, 10u);
+    DLOG_BENCH_MESSAGE(DLOG_BENCH_FMT, 0x10600200u, 1u);
+    DLOG_BENCH_MESSAGE("[DFU App] Known-answer test %u of %u failed\r\n", 4u, 12u);
+    if (opt->dump != NULL) {
+        FILE *dump = fopen(opt->dump, "wb");
+
+        if (dump != NULL) {
+            (void)fwrite(&bench_region, 1u, sizeof(bench_region), dump);
+            fclose(dump);
+        }
+    }
+    (void)dlog_drain(bench_out);
+    r->drained = dlog_empty();
+
+    if (opt->capture != NULL) {
+        capture = fopen(opt->capture, "w");
+        if (capture != NULL) {
+            fprintf(capture, "[DFU App] Console text is kept as it is\r\n");
+        }
+    }
+    for (uint32_t i = 0u; i < bench_line_count; i++) {
+        const char *line = bench_lines[i];
+        uint32_t record[DLOG_RECORD_WORDS(DLOG_MAX_ARGS)];
+        char text[DLOG_BENCH_TEXT_MAX];
+        uint32_t words = 0u;
+
+        if (capture != NULL) {
+            fputs(line, capture);
+        }
+        if (line[3] != ':') {
+            /* Clock of a lane */
+            continue;
+        }
+        for (const char *p = &line[4]; (words < DLOG_RECORD_WORDS(DLOG_MAX_ARGS)) && (sscanf(p, "%8" SCNx32, &record[words]) == 1);
+             p += 8) {
+            words++;
+        }
+        if ((message < bench_expected_count) && (dlog_elf_text(&elf, record, words, text, sizeof(text)) == 0) &&
+            (strcmp(text, bench_expected[message]) == 0)) {
+            r->matched++;
+        } else if (message < bench_expected_count) {
+            fprintf(stderr, "message %u: \"%s\", expected \"%s\"\n", message, text, bench_expected[message]);
+        }
+        message++;
+    }
+    r->messages = bench_expected_count;
+    if (capture != NULL) {
+        fclose(capture);
+    }
+    dlog_elf_free(&elf);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: print_result
+ ********************************************************************************
+ * Prints the result.
+ *******************************************************************************/
+static void print_result(const dlog_bench_options_t *opt, const dlog_bench_result_t *r) {
+    printf("Log call of \"%.*s\", %u calls\n", (int)(sizeof(DLOG_BENCH_FMT) - 3u), DLOG_BENCH_FMT, opt->calls);
+    printf("  %-26s : %9.1f ns, record of %u bytes\n", "deferred log (DLOG=1)", r->dlog_ns, r->record_bytes);
+    printf("  %-26s : %9.1f ns\n", "snprintf of the message", r->snprintf_ns);
+    printf("  %-26s : %9.1f us, %u bytes at %u baud\n", "UART wait of printf", r->uart_us, r->text_bytes, opt->baud);
+    printf("  %-26s : %9u bytes, sent when the TX FIFO has room\n", "drained line", r->line_bytes);
+    printf("  %-26s : %u/%u messages\n", "round trip", r->matched, r->messages);
+    printf("Host times; on the target a blocking printf() waits for the UART once its TX FIFO is full.\n");
+}
+
+/*******************************************************************************
+ * Function Name: print_result_json
+ ********************************************************************************
+ * Prints the result as JSON.
+ *******************************************************************************/
+static void print_result_json(const dlog_bench_options_t *opt, const dlog_bench_result_t *r) {
+    printf("{\"calls\": %u, \"dlog_ns\": %.1f, \"snprintf_ns\": %.1f, \"uart_us\": %.1f, \"baud\": %u, "
+           "\"text_bytes\": %u, \"record_bytes\": %u, \"line_bytes\": %u, \"round_trip\": %u, \"messages\": %u}\n",
+           opt->calls, r->dlog_ns, r->snprintf_ns, r->uart_us, opt->baud, r->text_bytes, r->record_bytes,
+           r->line_bytes, r->matched, r->messages);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Runs the cost loop and the round trip and prints the report.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "calls",       required_argument, NULL, 'n' },
+        { "baud",        required_argument, NULL, 'b' },
+        { "capture",     required_argument, NULL, 'c' },
+        { "dump",        required_argument, NULL, 'd' },
+        { "json",        no_argument,       NULL, 'j' },
+        { "help",        no_argument,       NULL, 'h' },
+        { NULL,          0,                 NULL, 0 },
+    };
+    dlog_bench_options_t opt = {
+        .calls = 1000000u,
+        .baud = 115200u,
+        .capture = NULL,
+        .dump = NULL,
+        .json = false,
+    };
+    dlog_bench_result_t result;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'n': opt.calls = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'b': opt.baud = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'c': opt.capture = optarg; break;
+        case 'd': opt.dump = optarg; break;
+        case 'j': opt.json = true; break;
+        default: usage(argv[0], &opt); return (c == 'h') ? 0 : 2;
+        }
+    }
+    if ((opt.calls == 0u) || (opt.baud == 0u)) {
+        usage(argv[0], &opt);
+        return 2;
+    }
+
+    memset(&result, 0, sizeof(result));
+    bench_cost(&opt, &result);
+    if (bench_round_trip(&opt, &result) != 0) {
+        fprintf(stderr, "cannot read the .dlog_fmt section of this program\n");
+        return 1;
+    }
+    if (opt.json) {
+        print_result_json(&opt, &result);
+    } else {
+        print_result(&opt, &result);
+    }
+    return ((result.matched == result.messages) && (result.dropped == 0u) && result.drained) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,386 @@
+/******************************************************************************
+ * File Name:   dlog_decode.c
+ *
+ * Description: Host tool that decodes the deferred log (DLOG=1) with the ELF files of the cores: a
+ *              console capture in which the DFU application drained the records as "@D" lines, or a
+ *              binary dump of the RAM at DLOG_ADDR, for example taken by the debugger.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dlog.h"
+#include "dlog_elf.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define DLOG_DECODE_TEXT_MAX        (512u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Decoding state of a lane */
+typedef struct {
+    dlog_elf_t elf;
+    uint32_t tick_hz;
+    /* Ticks of the lane clock, extended over its wraps */
+    uint64_t ticks;
+    uint32_t last_ticks;
+    /* Sequence number of the next record */
+    uint32_t seq;
+    bool started;
+    uint32_t records;
+    uint32_t lost;
+} dlog_decode_lane_t;
+
+typedef struct {
+    dlog_decode_lane_t lanes[DLOG_LANE_COUNT];
+    bool json;
+    uint32_t records;
+} dlog_decode_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const char *const dlog_lane_names[DLOG_LANE_COUNT] = {
+    "cm0p",
+    "cm7_0",
+    "cm7_1",
+};
+
+static const char *const dlog_level_names[] = {
+    "---",
+    "ERR",
+    "WRN",
+    "INF",
+    "DBG",
+};
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name) {
+    printf("Usage: %s [options] INPUT\n"
+           "Decodes a console capture with the \"@D\" lines of the DFU application, or a RAM dump.\n"
+           "  --elf LANE:FILE     ELF file of the core of a lane, 0 bootloader (CM0+), 1 CM7_0, 2 CM7_1\n"
+           "  --tick-hz LANE:HZ   clock of the timestamps of a lane, when the capture does not give it\n"
+           "  --dump              INPUT is a binary dump of the RAM at DLOG_ADDR\n"
+           "  --offset N          offset of the region in the dump (default 0)\n"
+           "  --json              machine-readable output\n",
+           name);
+}
+
+/*******************************************************************************
+ * Function Name: parse_lane_arg
+ ********************************************************************************
+ * Splits a LANE:VALUE option.
+ *
+ * Return:
+ *  The lane, -1 if the option is not valid.
+ *******************************************************************************/
+static int parse_lane_arg(const char *arg, const char **value) {
+    char *end;
+    unsigned long lane = strtoul(arg, &end, 0);
+
+    if ((end == arg) || (*end != ':') || (lane >= DLOG_LANE_COUNT)) {
+        return -1;
+    }
+    *value = end + 1;
+    return (int)lane;
+}
+
+/*******************************************************************************
+ * Function Name: print_json_string
+ ********************************************************************************
+ * Prints a JSON string.
+ *******************************************************************************/
+static void print_json_string(const char *s) {
+    putchar('"');
+    for (; *s != '\0'; s++) {
+        if ((*s == '"') || (*s == '\\')) {
+            printf("\\%c", *s);
+        } else if ((unsigned char)*s < 0x20u) {
+            printf("\\u%04x", (unsigned char)*s);
+        } else {
+            putchar(*s);
+        }
+    }
+    putchar('"');
+}
+
+/*******************************************************************************
+ * Function Name: decode_record
+ ********************************************************************************
+ * Prints a record of a lane.
+ *******************************************************************************/
+static void decode_record(dlog_decode_t *d, uint32_t index, const uint32_t *record, uint32_t words) {
+    dlog_decode_lane_t *lane = &d->lanes[index];
+    uint32_t seq = DLOG_HDR_SEQ(record[0]);
+    uint32_t level = DLOG_HDR_LEVEL(record[0]);
+    char text[DLOG_DECODE_TEXT_MAX];
+    uint32_t lost = 0u;
+
+    if (lane->started) {
+        lane->ticks += (uint32_t)(record[1] - lane->last_ticks);
+        lost = (seq - lane->seq) & 0xFFu;
+    } else {
+        lane->ticks = record[1];
+        lane->started = true;
+    }
+    lane->last_ticks = record[1];
+    lane->seq = seq + 1u;
+    lane->lost += lost;
+    lane->records++;
+    (void)dlog_elf_text(&lane->elf, record, words, text, sizeof(text));
+
+    if (d->json) {
+        printf("%s{\"lane\": \"%s\", \"seq\": %u, \"level\": \"%s\", ", (d->records == 0u) ? "" : ",\n ",
+               dlog_lane_names[index], seq, dlog_level_names[(level < 5u) ? level : 0u]);
+        if (lane->tick_hz != 0u) {
+            printf("\"time_us\": %llu, ", (unsigned long long)(lane->ticks * 1000000u / lane->tick_hz));
+        } else {
+            printf("\"ticks\": %llu, ", (unsigned long long)lane->ticks);
+        }
+        printf("\"lost\": %u, \"text\": ", lost);
+        print_json_string(text);
+        printf("}");
+    } else {
+        if (lost != 0u) {
+            printf("[%-5s] ... %u records lost\n", dlog_lane_names[index], lost);
+        }
+        if (lane->tick_hz != 0u) {
+            printf("[%-5s %12.3f ms] %s\n", dlog_lane_names[index],
+                   (double)lane->ticks * 1000.0 / lane->tick_hz, text);
+        } else {
+            printf("[%-5s %12llu tk] %s\n", dlog_lane_names[index], (unsigned long long)lane->ticks, text);
+        }
+    }
+    d->records++;
+}
+
+/*******************************************************************************
+ * Function Name: hex_word
+ ********************************************************************************
+ * Return:
+ *  true if s starts with 8 hex digits, their value in value.
+ *******************************************************************************/
+static bool hex_word(const char *s, uint32_t *value) {
+    *value = 0u;
+    for (uint32_t i = 0u; i < 8u; i++) {
+        char c = s[i];
+        uint32_t digit;
+
+        if ((c >= '0') && (c <= '9')) {
+            digit = (uint32_t)(c - '0');
+        } else if ((c >= 'A') && (c <= 'F')) {
+            digit = (uint32_t)(c - 'A' + 10);
+        } else if ((c >= 'a') && (c <= 'f')) {
+            digit = (uint32_t)(c - 'a' + 10);
+        } else {
+            return false;
+        }
+        *value = (*value << 4) | digit;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: decode_capture
+ ********************************************************************************
+ * Decodes the "@D" lines of a console capture, the other lines are printed
+ * as they are. "@D<lane>=<hz>" gives the clock of a lane.
+ *
+ * Return:
+ *  Number of lines that could not be decoded.
+ *******************************************************************************/
+static uint32_t decode_capture(dlog_decode_t *d, FILE *file) {
+    char line[1024];
+    uint32_t bad = 0u;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char *p = strstr(line, DLOG_LINE_PREFIX);
+        uint32_t record[DLOG_RECORD_WORDS(DLOG_MAX_ARGS)];
+        uint32_t words = 0u;
+        uint32_t index;
+
+        if ((p == NULL) || (p[2] < '0') || (p[2] >= (char)('0' + DLOG_LANE_COUNT))) {
+            if (!d->json) {
+                fputs(line, stdout);
+            }
+            continue;
+        }
+        index = (uint32_t)(p[2] - '0');
+        if (p[3] == '=') {
+            if (hex_word(&p[4], &record[0])) {
+                d->lanes[index].tick_hz = record[0];
+            }
+            continue;
+        }
+        for (p += 4; (words < DLOG_RECORD_WORDS(DLOG_MAX_ARGS)) && hex_word(p, &record[words]); p += 8) {
+            words++;
+        }
+        if ((words < 2u) || (words != DLOG_RECORD_WORDS(DLOG_HDR_COUNT(record[0])))) {
+            bad++;
+            continue;
+        }
+        decode_record(d, index, record, words);
+    }
+    return bad;
+}
+
+/*******************************************************************************
+ * Function Name: decode_dump
+ ********************************************************************************
+ * Decodes the records of every valid lane of a RAM dump of the region.
+ *
+ * Return:
+ *  Number of lanes found.
+ *******************************************************************************/
+static uint32_t decode_dump(dlog_decode_t *d, dlog_t *region) {
+    uint32_t record[DLOG_RECORD_WORDS(DLOG_MAX_ARGS)];
+    uint32_t found = 0u;
+
+    for (uint32_t i = 0u; i < DLOG_LANE_COUNT; i++) {
+        dlog_lane_t *lane = &region->lanes[i];
+        uint32_t words;
+
+        if (!dlog_lane_valid(lane)) {
+            continue;
+        }
+        found++;
+        if (d->lanes[i].tick_hz == 0u) {
+            d->lanes[i].tick_hz = lane->tick_hz;
+        }
+        if (!d->json && (lane->dropped != 0u)) {
+            printf("[%-5s] %u records dropped, the lane was full\n", dlog_lane_names[i], lane->dropped);
+        }
+        while ((words = dlog_read(lane, record, DLOG_RECORD_WORDS(DLOG_MAX_ARGS))) != 0u) {
+            decode_record(d, i, record, words);
+        }
+    }
+    return found;
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Reads the ELF files and the input and prints the messages.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "elf",         required_argument, NULL, 'e' },
+        { "tick-hz",     required_argument, NULL, 't' },
+        { "dump",        no_argument,       NULL, 'd' },
+        { "offset",      required_argument, NULL, 'o' },
+        { "json",        no_argument,       NULL, 'j' },
+        { "help",        no_argument,       NULL, 'h' },
+        { NULL,          0,                 NULL, 0 },
+    };
+    static dlog_decode_t d;
+    static dlog_t region;
+    const char *value;
+    bool dump = false;
+    long offset = 0;
+    FILE *file;
+    int lane;
+    int rc = 0;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'e':
+            lane = parse_lane_arg(optarg, &value);
+            if ((lane < 0) || (dlog_elf_load(value, &d.lanes[lane].elf) != 0)) {
+                fprintf(stderr, "%s: not an ELF file with a .dlog_fmt section\n", optarg);
+                return 1;
+            }
+            break;
+        case 't':
+            lane = parse_lane_arg(optarg, &value);
+            if (lane < 0) {
+                usage(argv[0]);
+                return 2;
+            }
+            d.lanes[lane].tick_hz = (uint32_t)strtoul(value, NULL, 0);
+            break;
+        case 'd': dump = true; break;
+        case 'o': offset = strtol(optarg, NULL, 0); break;
+        case 'j': d.json = true; break;
+        default: usage(argv[0]); return (c == 'h') ? 0 : 2;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    file = fopen(argv[optind], dump ? "rb" : "r");
+    if (file == NULL) {
+        fprintf(stderr, "cannot open %s\n", argv[optind]);
+        return 1;
+    }
+    if (d.json) {
+        printf("{\"records\": [");
+    }
+    if (dump) {
+        if ((fseek(file, offset, SEEK_SET) != 0) || (fread(&region, 1u, sizeof(region), file) != sizeof(region))) {
+            fprintf(stderr, "%s: no region at offset %ld\n", argv[optind], offset);
+            rc = 1;
+        } else if (decode_dump(&d, &region) == 0u) {
+            fprintf(stderr, "%s: no deferred log, the cores were built without DLOG=1\n", argv[optind]);
+            rc = 1;
+        }
+    } else if (decode_capture(&d, file) != 0u) {
+        fprintf(stderr, "%s: lines with a damaged record\n", argv[optind]);
+        rc = 1;
+    }
+    fclose(file);
+    if (d.json) {
+        printf("], \"lost\": [%u, %u, %u]}\n", d.lanes[0].lost, d.lanes[1].lost, d.lanes[2].lost);
+    }
+    for (uint32_t i = 0u; i < DLOG_LANE_COUNT; i++) {
+        dlog_elf_free(&d.lanes[i].elf);
+    }
+    return rc;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,248 @@
+/******************************************************************************
+ * File Name:   dlog_elf.c
+ *
+ * Description: Host decoder of the deferred log records: reads the .dlog_fmt section of the ELF
+ *              file of a core, 32 or 64-bit little endian, and prints a record with the format
+ *              string that its ID points to, one argument word per conversion.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dlog.h"
+#include "dlog_elf.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define DLOG_ELF_SECTION            ".dlog_fmt"
+
+/* Longest conversion specification of a format string */
+#define DLOG_ELF_SPEC_MAX           (32u)
+
+/*******************************************************************************
+ * Function Name: read_le
+ ********************************************************************************
+ * Return:
+ *  Little endian number of size bytes at p.
+ *******************************************************************************/
+static uint64_t read_le(const uint8_t *p, uint32_t size) {
+    uint64_t value = 0u;
+
+    for (uint32_t i = size; i > 0u; i--) {
+        value = (value << 8) | p[i - 1u];
+    }
+    return value;
+}
+
+/*******************************************************************************
+ * Function Name: dlog_elf_load
+ ********************************************************************************
+ * Reads the format strings of an ELF file.
+ *
+ * Parameters:
+ *  path           ELF file of the core.
+ *  elf            Receives the format strings, free with dlog_elf_free().
+ *
+ * Return:
+ *  0 on success, -1 if the file is not a little endian ELF file with a
+ *  .dlog_fmt section.
+ *******************************************************************************/
+int dlog_elf_load(const char *path, dlog_elf_t *elf) {
+    FILE *file = fopen(path, "rb");
+    uint8_t *image = NULL;
+    long size;
+    int rc = -1;
+
+    memset(elf, 0, sizeof(*elf));
+    if (file == NULL) {
+        return -1;
+    }
+    if ((fseek(file, 0, SEEK_END) == 0) && ((size = ftell(file)) > 64) && (fseek(file, 0, SEEK_SET) == 0) &&
+        ((image = malloc((size_t)size)) != NULL) && (fread(image, 1u, (size_t)size, file) == (size_t)size) &&
+        (memcmp(image, "\177ELF", 4u) == 0) && (image[5] == 1u)) {
+        /* Offsets of the fields of the file and section headers, ELF32 or ELF64 */
+        bool is64 = (image[4] == 2u);
+        uint32_t word = is64 ? 8u : 4u;
+        uint64_t shoff = read_le(&image[is64 ? 0x28u : 0x20u], word);
+        uint32_t shentsize = (uint32_t)read_le(&image[is64 ? 0x3Au : 0x2Eu], 2u);
+        uint32_t shnum = (uint32_t)read_le(&image[is64 ? 0x3Cu : 0x30u], 2u);
+        uint32_t shstrndx = (uint32_t)read_le(&image[is64 ? 0x3Eu : 0x32u], 2u);
+        uint32_t off_pos = is64 ? 0x18u : 0x10u;
+        uint32_t size_pos = is64 ? 0x20u : 0x14u;
+
+        if ((shstrndx < shnum) && ((shoff + ((uint64_t)shnum * shentsize)) <= (uint64_t)size)) {
+            const uint8_t *strtab = &image[shoff + ((uint64_t)shstrndx * shentsize)];
+            uint64_t names = read_le(&strtab[off_pos], word);
+            uint64_t names_size = read_le(&strtab[size_pos], word);
+
+            for (uint32_t i = 0u; (i < shnum) && (names + names_size <= (uint64_t)size); i++) {
+                const uint8_t *sh = &image[shoff + ((uint64_t)i * shentsize)];
+                uint32_t name = (uint32_t)read_le(sh, 4u);
+                uint64_t offset = read_le(&sh[off_pos], word);
+                uint64_t length = read_le(&sh[size_pos], word);
+
+                if ((name < names_size) &&
+                    (strncmp((const char *)&image[names + name], DLOG_ELF_SECTION, names_size - name) == 0) &&
+                    (offset + length <= (uint64_t)size)) {
+                    /* Terminated, a truncated string ends at the section */
+                    elf->data = malloc((size_t)length + 1u);
+                    if (elf->data != NULL) {
+                        memcpy(elf->data, &image[offset], (size_t)length);
+                        elf->data[length] = '\0';
+                        elf->size = (uint32_t)length;
+                        rc = 0;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    free(image);
+    fclose(file);
+    return rc;
+}
+
+/*******************************************************************************
+ * Function Name: dlog_elf_free
+ ********************************************************************************
+ * Frees the format strings.
+ *******************************************************************************/
+void dlog_elf_free(dlog_elf_t *elf) {
+    free(elf->data);
+    memset(elf, 0, sizeof(*elf));
+}
+
+/*******************************************************************************
+ * Function Name: dlog_elf_text
+ ********************************************************************************
+ * Prints a record with its format string. The length modifiers are ignored,
+ * the arguments are 32-bit words: %s and %p print the address, the floating
+ * point conversions are not supported. A trailing line end is removed.
+ *
+ * Parameters:
+ *  elf            Format strings of the core of the record.
+ *  record         Header word, timestamp and arguments.
+ *  words          Words of the record.
+ *  text           Receives the message.
+ *  size           Size of text.
+ *
+ * Return:
+ *  0 on success, -1 if the ID is not in the section: the message is printed
+ *  as the ID and the arguments.
+ *******************************************************************************/
+int dlog_elf_text(const dlog_elf_t *elf, const uint32_t *record, uint32_t words, char *text, size_t size) {
+    uint32_t id = DLOG_HDR_ID(record[0]);
+    uint32_t count = words - 2u;
+    uint32_t arg = 0u;
+    size_t length = 0u;
+    const char *p;
+
+    if ((size == 0u) || (words < 2u)) {
+        return -1;
+    }
+    text[0] = '\0';
+    if ((elf->data == NULL) || (id >= elf->size)) {
+        length = (size_t)snprintf(text, size, "<format 0x%04x>", id);
+        for (uint32_t i = 0u; (i < count) && (length < size); i++) {
+            length += (size_t)snprintf(&text[length], size - length, " 0x%08x", record[2u + i]);
+        }
+        return -1;
+    }
+
+    for (p = &elf->data[id]; (*p != '\0') && (length + 1u < size); p++) {
+        char spec[DLOG_ELF_SPEC_MAX];
+        uint32_t n = 0u;
+        uint32_t value;
+
+        if (*p != '%') {
+            text[length++] = *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            text[length++] = '%';
+            p++;
+            continue;
+        }
+        /* Flags, width and precision are kept, the length modifiers dropped */
+        spec[n++] = '%';
+        for (p++; (*p != '\0') && (strchr("-+ #0123456789.*", *p) != NULL) && (n < DLOG_ELF_SPEC_MAX - 2u); p++) {
+            if (*p == '*') {
+                n += (uint32_t)snprintf(&spec[n], DLOG_ELF_SPEC_MAX - 2u - n, "%d",
+                                        (arg < count) ? (int)record[2u + arg] : 0);
+                arg++;
+                n = (n < DLOG_ELF_SPEC_MAX - 2u) ? n : DLOG_ELF_SPEC_MAX - 2u;
+            } else {
+                spec[n++] = *p;
+            }
+        }
+        while ((*p != '\0') && (strchr("hlLjzt", *p) != NULL)) {
+            p++;
+        }
+        if (*p == '\0') {
+            break;
+        }
+        value = (arg < count) ? record[2u + arg] : 0u;
+        if (arg >= count) {
+            length += (size_t)snprintf(&text[length], size - length, "<?>");
+        } else if (strchr("di", *p) != NULL) {
+            spec[n++] = 'd';
+            spec[n] = '\0';
+            length += (size_t)snprintf(&text[length], size - length, spec, (int)value);
+        } else if (strchr("uxXoc", *p) != NULL) {
+            spec[n++] = *p;
+            spec[n] = '\0';
+            length += (size_t)snprintf(&text[length], size - length, spec, value);
+        } else if (strchr("sp", *p) != NULL) {
+            length += (size_t)snprintf(&text[length], size - length, "<%s 0x%08x>", (*p == 's') ? "str" : "ptr",
+                                       value);
+        } else {
+            length += (size_t)snprintf(&text[length], size - length, "<?>");
+        }
+        arg++;
+        if (length >= size) {
+            length = size - 1u;
+        }
+    }
+    while ((length != 0u) && ((text[length - 1u] == '\n') || (text[length - 1u] == '\r'))) {
+        length--;
+    }
+    text[length] = '\0';
+    return 0;
+}
+
+/* [] END OF FILE */
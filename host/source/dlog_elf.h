@@ -0,0 +1,66 @@
+/******************************************************************************
+ * File Name:   dlog_elf.h
+ *
+ * Description: This file contains the declarations of the host decoder of the deferred log records,
+ *              with the format strings read from the .dlog_fmt section of an ELF file.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DLOG_ELF_H
+#define DLOG_ELF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Format strings of one ELF file */
+typedef struct {
+    char *data;
+    uint32_t size;
+} dlog_elf_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+int dlog_elf_load(const char *path, dlog_elf_t *elf);
+void dlog_elf_free(dlog_elf_t *elf);
+int dlog_elf_text(const dlog_elf_t *elf, const uint32_t *record, uint32_t words, char *text, size_t size);
+
+#endif /* DLOG_ELF_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,371 @@
+/******************************************************************************
+ * File Name:   enc_bench.c
+ *
+ * Description: Upgrade benchmark of the encrypted images of the bootloader. Runs the boot_go()
+ *              model of sim_loader.c with boot_enc.c over the flash areas of the overwrite memory
+ *              map: a plain upgrade, an encrypted upgrade decrypted row by row into the primary
+ *              slot, the boot after it and an upgrade with a damaged key TLV, and reports the
+ *              modelled upgrade time, the flash operations and an estimate of the decryption in
+ *              place after a plain copy.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "memorymap.h"
+#include "boot_crypto.h"
+#include "image_enc.h"
+#include "image_file.h"
+#include "sim_flash.h"
+#include "sim_loader.h"
+#include "sim_swap_port.h"
+#include "swap_journal.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Trailer magic at the end of the synthetic images */
+#define ENC_BENCH_MAGIC_SIZE        (16u)
+
+/* Offset of the key TLV from the end of the TLV area of an encrypted image,
+ * and of its HMAC in it */
+#define ENC_BENCH_KEY_TLV_OFF       (BOOT_CRYPTO_ECIES_SIZE + 4u)
+#define ENC_BENCH_TAG_OFF           (BOOT_CRYPTO_ECIES_TAG_OFF + 4u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t code_size;
+    uint32_t change_size;
+    uint32_t seed;
+    bool json;
+    sim_swap_timing_t timing;
+    sim_loader_cfg_t loader;
+} enc_bench_options_t;
+
+typedef struct {
+    sim_loader_rsp_t rsp;
+    sim_swap_port_stats_t stats;
+    /* The primary slot holds the expected image */
+    bool installed;
+} enc_bench_boot_t;
+
+typedef struct {
+    enc_bench_boot_t plain;
+    enc_bench_boot_t encrypted;
+    /* Boot after the encrypted upgrade */
+    enc_bench_boot_t next;
+    /* Upgrade with a damaged key TLV */
+    enc_bench_boot_t damaged;
+    /* Decryption in place after a plain copy: one more erase and program of
+     * the sectors of the image */
+    uint64_t in_place_us;
+} enc_bench_result_t;
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name, const enc_bench_options_t *opt) {
+    printf("Usage: %s [options]\n"
+           "Upgrade time of the encrypted images (ENC_IMG=1) on the overwrite flash map.\n"
+           "  --code-size N       code size of the image in the primary slot (default 0x%x)\n"
+           "  --change N          bytes of new code in the upgrade image (default 0x%x)\n"
+           "  --hash-us-per-kb N  modelled time to hash 1 KB of an image (default %u)\n"
+           "  --aes-us-per-kb N   modelled time to decrypt 1 KB of an image (default %u)\n"
+           "  --ecdh-us N         modelled time to unwrap the key of an image (default %u)\n"
+           "  --code-erase-us N   modelled time to erase a code flash sector (default %u)\n"
+           "  --code-program-us N modelled time to program a 512-byte code flash row (default %u)\n"
+           "  --seed N            seed of the images (default 1)\n"
+           "  --json              machine-readable output\n",
+           name, opt->code_size, opt->change_size, opt->loader.hash_us_per_kb, opt->loader.aes_us_per_kb,
+           opt->loader.ecdh_us, opt->timing.code_erase_us, opt->timing.code_program_us);
+}
+
+/*******************************************************************************
+ * Function Name: enc_bench_boot
+ ********************************************************************************
+ * Boots once after a power-on.
+ *
+ * Parameters:
+ *  expected       Image the primary slot holds after the boot.
+ *  boot           Receives the result of the boot.
+ *******************************************************************************/
+static void enc_bench_boot(const enc_bench_options_t *opt, const image_t *expected, enc_bench_boot_t *boot) {
+    sim_swap_port_stats_t before;
+    const uint8_t *p;
+    uint32_t extent = image_extent(expected);
+
+    sim_swap_port_power_on();
+    sim_swap_port_stats_get(&before);
+    sim_loader_boot_go(&opt->loader, &boot->rsp);
+    sim_swap_port_stats_get(&boot->stats);
+    boot->stats.code_erases -= before.code_erases;
+    boot->stats.code_programs -= before.code_programs;
+    boot->stats.time_us -= before.time_us;
+    p = sim_flash_ptr(PRIMARY_IMG_START, extent);
+    boot->installed = (p != NULL) && (memcmp(p, expected->data, extent) == 0);
+}
+
+/*******************************************************************************
+ * Function Name: enc_bench_upgrade
+ ********************************************************************************
+ * Loads the primary and the secondary slot, requests the upgrade and boots.
+ *
+ * Parameters:
+ *  primary        Image in the primary slot.
+ *  secondary      Upgrade image in the secondary slot.
+ *  expected       Image the primary slot holds after the boot.
+ *  boot           Receives the result of the boot.
+ *
+ * Return:
+ *  0 on success, -1 if the flash cannot be set up.
+ *******************************************************************************/
+static int enc_bench_upgrade(const enc_bench_options_t *opt, const image_t *primary, const image_t *secondary,
+                             const image_t *expected, enc_bench_boot_t *boot) {
+    if ((sim_flash_load(PRIMARY_IMG_START, primary->data, SLOT_SIZE) != 0) ||
+        (sim_flash_load(SECONDARY_IMG_START, secondary->data, SLOT_SIZE) != 0) ||
+        (sim_loader_set_pending(true) != 0)) {
+        return -1;
+    }
+    enc_bench_boot(opt, expected, boot);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: enc_bench_run
+ ********************************************************************************
+ * Runs the upgrades.
+ *
+ * Return:
+ *  0 on success, -1 if the images or the flash cannot be set up.
+ *******************************************************************************/
+static int enc_bench_run(const enc_bench_options_t *opt, const image_t *image_old, enc_bench_result_t *result) {
+    image_t image_new = { 0 };
+    image_t image_plain = { 0 };
+    image_t image_enc = { 0 };
+    uint32_t sector = swap_journal_port_erase_size(PRIMARY_IMG_START);
+    uint32_t row = swap_journal_port_program_size(PRIMARY_IMG_START);
+    uint32_t extent;
+    int rc = -1;
+
+    memset(result, 0, sizeof(*result));
+    if ((sector == 0u) || (row == 0u) ||
+        (image_synthetic_update(image_old, opt->change_size, opt->seed + 1u, &image_plain) != 0) ||
+        (image_synthetic_update(image_old, opt->change_size, opt->seed + 1u, &image_new) != 0) ||
+        (image_encrypt(&image_new, opt->seed + 2u, &image_enc) != 0)) {
+        goto done;
+    }
+
+    /* The same upgrade, plain and encrypted */
+    if ((enc_bench_upgrade(opt, image_old, &image_plain, &image_plain, &result->plain) != 0) ||
+        (enc_bench_upgrade(opt, image_old, &image_enc, &image_new, &result->encrypted) != 0)) {
+        goto done;
+    }
+    enc_bench_boot(opt, &image_new, &result->next);
+
+    /* The key TLV ends the TLV area: a damaged HMAC rejects the upgrade */
+    extent = image_extent(&image_enc);
+    image_enc.data[extent - ENC_BENCH_KEY_TLV_OFF + ENC_BENCH_TAG_OFF] ^= 0x01u;
+    if (enc_bench_upgrade(opt, image_old, &image_enc, image_old, &result->damaged) != 0) {
+        goto done;
+    }
+
+    /* Copy the ciphertext, then erase and program every sector of the image
+     * again with its code decrypted: the scratch copy that a power cut would
+     * need is not counted */
+    extent = image_extent(&image_new);
+    result->in_place_us = result->plain.rsp.time_us +
+                          ((uint64_t)(extent + sector - 1u) / sector) * opt->timing.code_erase_us +
+                          ((uint64_t)(extent + row - 1u) / row) * opt->timing.code_program_us +
+                          ((uint64_t)extent * opt->loader.aes_us_per_kb / 1024u) * 2u + opt->loader.ecdh_us;
+    rc = 0;
+
+done:
+    image_free(&image_new);
+    image_free(&image_plain);
+    image_free(&image_enc);
+    return rc;
+}
+
+/*******************************************************************************
+ * Function Name: print_boot
+ ********************************************************************************
+ * Prints one boot.
+ *******************************************************************************/
+static void print_boot(const char *name, const enc_bench_boot_t *b) {
+    printf("  %-20s : %9.3f ms, %s, %u erases, %u rows, %u B hashed, %u B decrypted, %u unwraps\n", name,
+           b->rsp.time_us / 1000.0, b->installed ? "installed" : "NOT INSTALLED", b->stats.code_erases,
+           b->stats.code_programs, b->rsp.hashed, b->rsp.decrypted, b->rsp.unwraps);
+}
+
+/*******************************************************************************
+ * Function Name: print_boot_json
+ ********************************************************************************
+ * Prints one boot as JSON.
+ *******************************************************************************/
+static void print_boot_json(const char *name, const enc_bench_boot_t *b) {
+    printf("\"%s\": {\"time_us\": %llu, \"booted\": %s, \"installed\": %s, \"swap_type\": %u, \"code_erases\": %u, "
+           "\"code_programs\": %u, \"hashed\": %u, \"decrypted\": %u, \"unwraps\": %u}",
+           name, (unsigned long long)b->rsp.time_us, b->rsp.booted ? "true" : "false",
+           b->installed ? "true" : "false", b->rsp.swap_type, b->stats.code_erases, b->stats.code_programs,
+           b->rsp.hashed, b->rsp.decrypted, b->rsp.unwraps);
+}
+
+/*******************************************************************************
+ * Function Name: print_result
+ ********************************************************************************
+ * Prints the result.
+ *******************************************************************************/
+static void print_result(uint32_t extent, const enc_bench_result_t *r) {
+    printf("Encrypted upgrade, image of 0x%x bytes\n", extent);
+    print_boot("plain upgrade", &r->plain);
+    print_boot("encrypted upgrade", &r->encrypted);
+    print_boot("next boot", &r->next);
+    printf("  %-20s : %s\n", "damaged key TLV",
+           ((r->damaged.rsp.swap_type == SIM_LOADER_SWAP_FAIL) && r->damaged.installed) ?
+           "upgrade rejected, old image kept" : "NOT REJECTED");
+    printf("  %-20s : %9.3f ms (estimate)\n", "decrypt in place", r->in_place_us / 1000.0);
+    printf("Modelled times: flash operations, --hash-us-per-kb, --aes-us-per-kb and --ecdh-us.\n");
+}
+
+/*******************************************************************************
+ * Function Name: print_result_json
+ ********************************************************************************
+ * Prints the result as JSON.
+ *******************************************************************************/
+static void print_result_json(uint32_t extent, const enc_bench_result_t *r) {
+    printf("{\"image_size\": %u, ", extent);
+    print_boot_json("plain", &r->plain);
+    printf(", ");
+    print_boot_json("encrypted", &r->encrypted);
+    printf(", ");
+    print_boot_json("next", &r->next);
+    printf(", ");
+    print_boot_json("damaged", &r->damaged);
+    printf(", \"in_place_us\": %llu}\n", (unsigned long long)r->in_place_us);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Runs the upgrades and prints the report.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "code-size",       required_argument, NULL, 'c' },
+        { "change",          required_argument, NULL, 'C' },
+        { "hash-us-per-kb",  required_argument, NULL, 'G' },
+        { "aes-us-per-kb",   required_argument, NULL, 'A' },
+        { "ecdh-us",         required_argument, NULL, 'D' },
+        { "code-erase-us",   required_argument, NULL, 'E' },
+        { "code-program-us", required_argument, NULL, 'P' },
+        { "seed",            required_argument, NULL, 'S' },
+        { "json",            no_argument,       NULL, 'j' },
+        { "help",            no_argument,       NULL, 'h' },
+        { NULL,              0,                 NULL, 0 },
+    };
+    /* Assumed typical durations, as boot_harness */
+    enc_bench_options_t opt = {
+        .code_size = 0x10000u,
+        .change_size = 0x400u,
+        .seed = 1u,
+        .json = false,
+        .timing = {
+            .code_erase_us = 45000u,
+            .work_erase_us = 20000u,
+            .small_erase_us = 8000u,
+            .code_program_us = 1300u,
+            .work_program_us = 70u,
+        },
+        .loader = {
+            .journal = false,
+            .hash_us_per_kb = 60u,
+            .aes_us_per_kb = 50u,
+            .ecdh_us = 60000u,
+        },
+    };
+    enc_bench_result_t result;
+    image_t image_old;
+    bool passed;
+    int c;
+    int rc;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'c': opt.code_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'C': opt.change_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'G': opt.loader.hash_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'A': opt.loader.aes_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'D': opt.loader.ecdh_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'E': opt.timing.code_erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'P': opt.timing.code_program_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'S': opt.seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'j': opt.json = true; break;
+        default: usage(argv[0], &opt); return (c == 'h') ? 0 : 2;
+        }
+    }
+
+    sim_swap_port_set_timing(&opt.timing);
+    if ((sim_flash_init() != 0) || (sim_loader_init() != 0) ||
+        (image_synthetic(PRIMARY_IMG_START, SLOT_SIZE, opt.code_size, opt.seed, &image_old) != 0)) {
+        fprintf(stderr, "cannot set up the images and the flash areas\n");
+        return 1;
+    }
+    /* Only the upgrade image carries the request */
+    memset(&image_old.data[SLOT_SIZE - ENC_BENCH_MAGIC_SIZE], 0xFF, ENC_BENCH_MAGIC_SIZE);
+
+    rc = enc_bench_run(&opt, &image_old, &result);
+    passed = (rc == 0) && result.plain.installed && result.encrypted.installed && result.encrypted.rsp.booted &&
+             result.next.rsp.booted && (result.next.rsp.decrypted == 0u) &&
+             (result.damaged.rsp.swap_type == SIM_LOADER_SWAP_FAIL) && result.damaged.installed;
+    if (rc != 0) {
+        fprintf(stderr, "cannot build the upgrade images\n");
+    } else if (opt.json) {
+        print_result_json(image_extent(&image_old), &result);
+    } else {
+        print_result(image_extent(&image_old), &result);
+    }
+    image_free(&image_old);
+    sim_flash_deinit();
+    return passed ? 0 : 1;
+}
+
+/* [] END OF FILE */
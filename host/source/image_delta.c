@@ -0,0 +1,300 @@
+/******************************************************************************
+ * File Name:   image_delta.c
+ *
+ * Description: This file contains the delta image generator of the host tools. It diffs
+ *              an upgrade image against the base image in the primary slot, bsdiff
+ *              style, into the delta image applied by dfu_cm7/source/dfu_delta.c, with
+ *              the same matcher as scripts/dfu_delta.py.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "dfu_delta.h"
+#include "dfu_packet.h"
+#include "image_delta.h"
+#include "image_lz.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define IMAGE_DELTA_HASH_BITS       (16u)
+#define IMAGE_DELTA_HASH_SIZE       (1u << IMAGE_DELTA_HASH_BITS)
+/* Shortest exact match that aligns the base, candidates tried per position
+ * and match length that ends the search */
+#define IMAGE_DELTA_BLOCK           (8u)
+#define IMAGE_DELTA_MAX_CHAIN       (16u)
+#define IMAGE_DELTA_GOOD_MATCH      (256u)
+/* A DIFF run continues over a mismatch if this many of the next LOOKAHEAD
+ * bytes match */
+#define IMAGE_DELTA_LOOKAHEAD       (16u)
+#define IMAGE_DELTA_LOOKAHEAD_MIN   (12u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint8_t *data;
+    uint32_t size;
+    uint32_t capacity;
+} image_delta_buf_t;
+
+/*******************************************************************************
+ * Function Name: image_delta_hash
+ ********************************************************************************
+ * Hashes the IMAGE_DELTA_BLOCK bytes at p.
+ *******************************************************************************/
+static uint32_t image_delta_hash(const uint8_t *p) {
+    uint32_t h = 0u;
+
+    for (uint32_t i = 0u; i < IMAGE_DELTA_BLOCK; i++) {
+        h = (h * 31u) + p[i];
+    }
+    return ((h * 2654435761u) >> (32u - IMAGE_DELTA_HASH_BITS)) & (IMAGE_DELTA_HASH_SIZE - 1u);
+}
+
+/*******************************************************************************
+ * Function Name: image_delta_put
+ ********************************************************************************
+ * Appends bytes to a growing buffer.
+ *******************************************************************************/
+static int image_delta_put(image_delta_buf_t *buf, const uint8_t *data, uint32_t length) {
+    if (buf->size + length > buf->capacity) {
+        uint32_t capacity = (buf->capacity * 2u) + length;
+        uint8_t *grown = realloc(buf->data, capacity);
+
+        if (grown == NULL) {
+            return -1;
+        }
+        buf->data = grown;
+        buf->capacity = capacity;
+    }
+    memcpy(&buf->data[buf->size], data, length);
+    buf->size += length;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: image_delta_op
+ ********************************************************************************
+ * Appends an operation and its LEB128 argument.
+ *******************************************************************************/
+static int image_delta_op(image_delta_buf_t *buf, uint8_t op, uint32_t arg) {
+    uint8_t bytes[6];
+    uint32_t n = 0u;
+
+    bytes[n++] = op;
+    do {
+        bytes[n] = (uint8_t)(arg & 0x7Fu);
+        arg >>= 7;
+        if (arg != 0u) {
+            bytes[n] |= 0x80u;
+        }
+        n++;
+    } while (arg != 0u);
+    return image_delta_put(buf, bytes, n);
+}
+
+/*******************************************************************************
+ * Function Name: image_delta_create
+ ********************************************************************************
+ * Creates the delta image that rebuilds image from base.
+ *
+ * Parameters:
+ *  base           Image in the primary slot, only its MCUboot extent is used.
+ *  image          Upgrade image.
+ *  window_bits    Window of the compressed patch, see image_lz_compress().
+ *  delta          Delta image at the address of image, free it with
+ *                 image_free().
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int image_delta_create(const image_t *base, const image_t *image, uint32_t window_bits,
+                       image_t *delta) {
+    const uint8_t *old = base->data;
+    const uint8_t *new = image->data;
+    uint32_t old_size = image_extent(base);
+    uint32_t new_size = image->size;
+    int32_t *head = malloc(IMAGE_DELTA_HASH_SIZE * sizeof(int32_t));
+    int32_t *prev = malloc(((size_t)old_size + 1u) * sizeof(int32_t));
+    image_delta_buf_t ops = { NULL, 0u, 0u };
+    image_t patch;
+    image_t stream = { 0u, 0u, NULL };
+    uint32_t n = 0u;
+    uint32_t o = 0u;
+    uint32_t extra = 0u;
+    uint32_t crc;
+    int status = -1;
+
+    if ((head == NULL) || (prev == NULL)) {
+        goto exit;
+    }
+    for (uint32_t h = 0u; h < IMAGE_DELTA_HASH_SIZE; h++) {
+        head[h] = -1;
+    }
+    for (uint32_t p = 0u; p + IMAGE_DELTA_BLOCK <= old_size; p++) {
+        uint32_t h = image_delta_hash(&old[p]);
+
+        prev[p] = head[h];
+        head[h] = (int32_t)p;
+    }
+
+    while (n + IMAGE_DELTA_BLOCK <= new_size) {
+        int32_t match = -1;
+        uint32_t len = 0u;
+
+        /* Prefer the base position that continues the previous run */
+        if ((o + IMAGE_DELTA_BLOCK <= old_size) && (memcmp(&old[o], &new[n], IMAGE_DELTA_BLOCK) == 0)) {
+            match = (int32_t)o;
+        } else {
+            int32_t cand = head[image_delta_hash(&new[n])];
+            uint32_t best = 0u;
+
+            for (uint32_t chain = 0u; (cand >= 0) && (chain < IMAGE_DELTA_MAX_CHAIN); chain++) {
+                uint32_t l = 0u;
+
+                while ((l < IMAGE_DELTA_GOOD_MATCH) && (n + l < new_size) && ((uint32_t)cand + l < old_size) &&
+                       (old[(uint32_t)cand + l] == new[n + l])) {
+                    l++;
+                }
+                if (l > best) {
+                    best = l;
+                    match = cand;
+                    if (best >= IMAGE_DELTA_GOOD_MATCH) {
+                        break;
+                    }
+                }
+                cand = prev[cand];
+            }
+            if (best < IMAGE_DELTA_BLOCK) {
+                match = -1;
+            }
+        }
+        if (match < 0) {
+            n++;
+            continue;
+        }
+
+        if (n > extra) {
+            if ((image_delta_op(&ops, DFU_DELTA_OP_EXTRA, n - extra) != 0) ||
+                (image_delta_put(&ops, &new[extra], n - extra) != 0)) {
+                goto exit;
+            }
+        }
+        if ((uint32_t)match != o) {
+            int64_t d = (int64_t)match - (int64_t)o;
+            uint32_t zigzag = (d >= 0) ? (uint32_t)(d * 2) : (uint32_t)((-d * 2) - 1);
+
+            if (image_delta_op(&ops, DFU_DELTA_OP_SEEK, zigzag) != 0) {
+                goto exit;
+            }
+            o = (uint32_t)match;
+        }
+
+        /* Extend the run over isolated changes */
+        while ((n + len < new_size) && (o + len < old_size)) {
+            uint32_t hits = 0u;
+
+            if (new[n + len] == old[o + len]) {
+                len++;
+                continue;
+            }
+            if ((n + len + IMAGE_DELTA_LOOKAHEAD > new_size) || (o + len + IMAGE_DELTA_LOOKAHEAD > old_size)) {
+                break;
+            }
+            for (uint32_t i = 0u; i < IMAGE_DELTA_LOOKAHEAD; i++) {
+                hits += (new[n + len + i] == old[o + len + i]) ? 1u : 0u;
+            }
+            if (hits < IMAGE_DELTA_LOOKAHEAD_MIN) {
+                break;
+            }
+            len++;
+        }
+
+        if (image_delta_op(&ops, DFU_DELTA_OP_DIFF, len) != 0) {
+            goto exit;
+        }
+        for (uint32_t i = 0u; i < len; i++) {
+            uint8_t d = (uint8_t)(new[n + i] - old[o + i]);
+
+            if (image_delta_put(&ops, &d, 1u) != 0) {
+                goto exit;
+            }
+        }
+        n += len;
+        o += len;
+        extra = n;
+    }
+    if (new_size > extra) {
+        if ((image_delta_op(&ops, DFU_DELTA_OP_EXTRA, new_size - extra) != 0) ||
+            (image_delta_put(&ops, &new[extra], new_size - extra) != 0)) {
+            goto exit;
+        }
+    }
+
+    patch.address = image->address;
+    patch.size = ops.size;
+    patch.data = ops.data;
+    if (image_lz_compress(&patch, window_bits, &stream) != 0) {
+        goto exit;
+    }
+
+    delta->address = image->address;
+    delta->size = DFU_DELTA_HEADER_SIZE + stream.size;
+    delta->data = malloc(delta->size);
+    if (delta->data == NULL) {
+        goto exit;
+    }
+    crc = dfu_packet_crc32c(0u, old, old_size);
+    memset(delta->data, 0, DFU_DELTA_HEADER_SIZE);
+    dfu_packet_put_u32(&delta->data[0], DFU_DELTA_MAGIC);
+    delta->data[4] = DFU_DELTA_VERSION;
+    dfu_packet_put_u32(&delta->data[8], new_size);
+    dfu_packet_put_u32(&delta->data[12], old_size);
+    dfu_packet_put_u32(&delta->data[16], crc);
+    memcpy(&delta->data[DFU_DELTA_HEADER_SIZE], stream.data, stream.size);
+    status = 0;
+
+exit:
+    free(head);
+    free(prev);
+    free(ops.data);
+    free(stream.data);
+    return status;
+}
+
+/* [] END OF FILE */
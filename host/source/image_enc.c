@@ -0,0 +1,221 @@
+/******************************************************************************
+ * File Name:   image_enc.c
+ *
+ * Description: This file contains the upgrade image encryption of the host tools. It
+ *              encrypts an image as imgtool sign --encrypt does with an EC P-256 key, for the
+ *              encrypted upgrade of the bootloader, ENC_IMG=1.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "boot_crypto.h"
+#include "dfu_packet.h"
+#include "dfu_sha256.h"
+#include "image_enc.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define IMAGE_ENC_MAGIC             (0x96f3b83du)
+#define IMAGE_ENC_FLAG              (0x04u)
+#define IMAGE_ENC_HEADER_SIZE       (32u)
+#define IMAGE_ENC_TLV_INFO_MAGIC    (0x6907u)
+#define IMAGE_ENC_TLV_SHA256        (0x10u)
+#define IMAGE_ENC_TLV_EC256         (0x32u)
+#define IMAGE_ENC_TRAILER_SIZE      (16u)
+#define IMAGE_ENC_INFO              "MCUBoot_ECIES_v1"
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+/* keys/cypress-test-enc-p256-pub.pem, X and Y */
+static const uint8_t image_enc_pub[BOOT_CRYPTO_P256_KEY_SIZE] = {
+    0xd6u, 0xffu, 0xb4u, 0x72u, 0x5bu, 0x94u, 0xe1u, 0x5au, 0x5bu, 0x62u, 0x2fu, 0xc0u,
+    0x4bu, 0xd2u, 0xefu, 0x0fu, 0x7bu, 0xafu, 0x66u, 0xc9u, 0xfdu, 0xb7u, 0xecu, 0x58u,
+    0x02u, 0x88u, 0x47u, 0xeeu, 0x8bu, 0xf6u, 0x74u, 0xd9u, 0x40u, 0x0du, 0xc5u, 0xcfu,
+    0xd3u, 0x57u, 0xdeu, 0x3fu, 0xe0u, 0x49u, 0xb9u, 0x2cu, 0xf0u, 0x24u, 0x6au, 0x36u,
+    0xddu, 0x63u, 0x5fu, 0x08u, 0x5bu, 0xd1u, 0xf4u, 0x17u, 0xafu, 0x5eu, 0xf0u, 0xbau,
+    0xc4u, 0x5cu, 0x33u, 0x54u,
+};
+
+/* Ephemeral key of the key wrap. imgtool draws one per image, the host
+ * tools use a fixed one so that the images are reproducible: test only */
+static const uint8_t image_enc_eph_priv[BOOT_CRYPTO_P256_PRIV_SIZE] = {
+    0x55u, 0x94u, 0xd2u, 0x68u, 0x21u, 0xd3u, 0xb5u, 0x7fu, 0x31u, 0xa4u, 0xddu, 0xaau,
+    0xc6u, 0xc7u, 0xccu, 0x66u, 0x53u, 0x2cu, 0xa3u, 0x7au, 0x6au, 0x2au, 0x63u, 0x3bu,
+    0xa2u, 0xbau, 0x7fu, 0x3fu, 0x6fu, 0x28u, 0x1au, 0x4bu,
+};
+
+static const uint8_t image_enc_eph_pub[BOOT_CRYPTO_ECIES_TAG_OFF] = {
+    0x04u, 0x5eu, 0xc4u, 0xb2u, 0x85u, 0x1du, 0xf7u, 0x3cu, 0xa0u, 0xc6u, 0x4cu, 0x15u,
+    0x14u, 0xa3u, 0x35u, 0x5au, 0xa9u, 0x65u, 0x1bu, 0xebu, 0xd6u, 0x20u, 0x90u, 0x78u,
+    0x72u, 0xacu, 0xc1u, 0xd0u, 0x08u, 0x0cu, 0x51u, 0x1eu, 0x5fu, 0xc1u, 0x4du, 0xbdu,
+    0x6cu, 0x54u, 0x70u, 0x6cu, 0x93u, 0x7du, 0xccu, 0x33u, 0x4du, 0xa4u, 0x32u, 0x87u,
+    0x1du, 0x7du, 0x6du, 0xe9u, 0x63u, 0x8bu, 0x5bu, 0xbdu, 0x9bu, 0x18u, 0x5bu, 0x4bu,
+    0xe6u, 0x6eu, 0x6au, 0xfdu, 0xeau,
+};
+
+/*******************************************************************************
+ * Function Name: image_enc_get16
+ ********************************************************************************
+ * Reads a little endian 16-bit field.
+ *******************************************************************************/
+static uint32_t image_enc_get16(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+/*******************************************************************************
+ * Function Name: image_enc_wrap
+ ********************************************************************************
+ * Wraps an image key into the value of an ENC_EC256 TLV, as imgtool does:
+ * the key derived from the ECDH secret of the ephemeral key and of the
+ * encryption key encrypts the image key, an HMAC-SHA256 authenticates it.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int image_enc_wrap(const uint8_t key[BOOT_CRYPTO_AES_KEY_SIZE], uint8_t tlv[BOOT_CRYPTO_ECIES_SIZE]) {
+    uint8_t shared[BOOT_CRYPTO_P256_PRIV_SIZE];
+    uint8_t derived[BOOT_CRYPTO_AES_KEY_SIZE + BOOT_CRYPTO_SHA256_SIZE];
+    boot_crypto_aes_t aes;
+
+    if (!boot_crypto_p256_ecdh(image_enc_eph_priv, image_enc_pub, shared) ||
+        !boot_crypto_hkdf_sha256(shared, sizeof(shared), NULL, 0u, (const uint8_t *)IMAGE_ENC_INFO,
+                                 (uint32_t)strlen(IMAGE_ENC_INFO), derived, sizeof(derived))) {
+        return -1;
+    }
+    memcpy(&tlv[BOOT_CRYPTO_ECIES_PUB_OFF], image_enc_eph_pub, sizeof(image_enc_eph_pub));
+    boot_crypto_aes_init(&aes, derived);
+    boot_crypto_aes_ctr(&aes, 0u, key, &tlv[BOOT_CRYPTO_ECIES_KEY_OFF], BOOT_CRYPTO_AES_KEY_SIZE);
+    boot_crypto_aes_free(&aes);
+    boot_crypto_hmac_sha256(&derived[BOOT_CRYPTO_AES_KEY_SIZE], BOOT_CRYPTO_SHA256_SIZE,
+                            &tlv[BOOT_CRYPTO_ECIES_KEY_OFF], BOOT_CRYPTO_AES_KEY_SIZE,
+                            &tlv[BOOT_CRYPTO_ECIES_TAG_OFF]);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: image_encrypt
+ ********************************************************************************
+ * Encrypts an image with a key drawn from the seed. The image is changed to
+ * the form the bootloader installs to the primary slot: the encrypted flag
+ * set in the header, the SHA256 TLV of the new header and an ENC_EC256 TLV
+ * appended to the TLV area. The encrypted image is a copy of it with the
+ * code encrypted with AES-128-CTR, as the DFU application stores it in the
+ * secondary slot.
+ *
+ * Parameters:
+ *  image          Image without protected TLVs, changed in place.
+ *  seed           Seed of the image key.
+ *  encrypted      Encrypted image, free it with image_free().
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int image_encrypt(image_t *image, uint32_t seed, image_t *encrypted) {
+    uint8_t key[BOOT_CRYPTO_AES_KEY_SIZE];
+    uint8_t *p = image->data;
+    uint32_t rnd = (seed != 0u) ? seed : 0x2545F491u;
+    uint32_t code_off;
+    uint32_t tlv_off;
+    uint32_t tlv_size;
+    uint32_t off;
+    dfu_sha256_t sha;
+    boot_crypto_aes_t aes;
+
+    encrypted->data = NULL;
+    if ((image->size < IMAGE_ENC_HEADER_SIZE) || (dfu_packet_get_u32(p) != IMAGE_ENC_MAGIC) ||
+        (image_enc_get16(&p[10]) != 0u)) {
+        return -1;
+    }
+    code_off = image_enc_get16(&p[8]);
+    tlv_off = code_off + dfu_packet_get_u32(&p[12]);
+    if ((tlv_off + 4u > image->size) || (image_enc_get16(&p[tlv_off]) != IMAGE_ENC_TLV_INFO_MAGIC)) {
+        return -1;
+    }
+    tlv_size = image_enc_get16(&p[tlv_off + 2u]);
+    if ((tlv_size + 4u + BOOT_CRYPTO_ECIES_SIZE > 0xFFFFu) ||
+        (tlv_off + tlv_size + 4u + BOOT_CRYPTO_ECIES_SIZE + IMAGE_ENC_TRAILER_SIZE > image->size)) {
+        return -1;
+    }
+
+    /* Header flag, then the SHA256 TLV over the new header */
+    p[16] |= IMAGE_ENC_FLAG;
+    for (off = tlv_off + 4u; off + 4u <= tlv_off + tlv_size; off += 4u + image_enc_get16(&p[off + 2u])) {
+        if ((p[off] == IMAGE_ENC_TLV_SHA256) && (image_enc_get16(&p[off + 2u]) == DFU_SHA256_SIZE)) {
+            dfu_sha256_init(&sha);
+            dfu_sha256_update(&sha, p, tlv_off);
+            dfu_sha256_final(&sha, &p[off + 4u]);
+            break;
+        }
+    }
+    if (off + 4u > tlv_off + tlv_size) {
+        return -1;
+    }
+
+    for (uint32_t i = 0u; i < sizeof(key); i++) {
+        rnd ^= rnd << 13;
+        rnd ^= rnd >> 17;
+        rnd ^= rnd << 5;
+        key[i] = (uint8_t)rnd;
+    }
+    off = tlv_off + tlv_size;
+    p[off] = IMAGE_ENC_TLV_EC256;
+    p[off + 1u] = 0u;
+    p[off + 2u] = (uint8_t)BOOT_CRYPTO_ECIES_SIZE;
+    p[off + 3u] = 0u;
+    if (image_enc_wrap(key, &p[off + 4u]) != 0) {
+        return -1;
+    }
+    tlv_size += 4u + BOOT_CRYPTO_ECIES_SIZE;
+    p[tlv_off + 2u] = (uint8_t)tlv_size;
+    p[tlv_off + 3u] = (uint8_t)(tlv_size >> 8);
+
+    encrypted->address = image->address;
+    encrypted->size = image->size;
+    encrypted->data = malloc(image->size);
+    if (encrypted->data == NULL) {
+        return -1;
+    }
+    memcpy(encrypted->data, p, image->size);
+    boot_crypto_aes_init(&aes, key);
+    boot_crypto_aes_ctr(&aes, 0u, &p[code_off], &encrypted->data[code_off], tlv_off - code_off);
+    boot_crypto_aes_free(&aes);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,524 @@
+/******************************************************************************
+ * File Name:   image_file.c
+ *
+ * Description: Loading of signed MCUboot images (Intel HEX or raw binary) and
+ *              generation of synthetic images for the host tools.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dfu_sha256.h"
+#include "image_file.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define IMAGE_ERASED_VALUE          (0xFFu)
+#define IMAGE_MAX_SIZE              (0x00830000u)
+
+/* MCUboot layout used by the synthetic image */
+#define IMAGE_MAGIC                 (0x96f3b83du)
+#define IMAGE_HEADER_SIZE           (0x400u)
+#define IMAGE_TLV_INFO_MAGIC        (0x6907u)
+#define IMAGE_TLV_SHA256            (0x10u)
+#define IMAGE_TLV_ECDSA_SIG         (0x22u)
+#define IMAGE_TLV_PROT_INFO_MAGIC   (0x6908u)
+#define IMAGE_TLV_SIZE              (4u + 36u + 76u)
+#define IMAGE_TRAILER_MAGIC_SIZE    (16u)
+/* IMAGE_F_RAM_LOAD of the header flags, and the offset of the reset handler
+ * of a RAM load image in its code */
+#define IMAGE_F_RAM_LOAD            (0x20u)
+#define IMAGE_RAM_RESET_OFF         (0x400u)
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const uint8_t trailer_magic[IMAGE_TRAILER_MAGIC_SIZE] = {
+    0x77u, 0xc2u, 0x95u, 0xf3u, 0x60u, 0xd2u, 0xefu, 0x7fu,
+    0x35u, 0x52u, 0x50u, 0x0fu, 0x2cu, 0xb6u, 0x79u, 0x80u,
+};
+
+/*******************************************************************************
+ * Function Name: hex_byte
+ ********************************************************************************
+ * Decodes two hex digits, returns -1 on a malformed digit.
+ *******************************************************************************/
+static int hex_byte(const char *s) {
+    int value = 0;
+
+    for (int i = 0; i < 2; i++) {
+        char c = s[i];
+
+        value <<= 4;
+        if ((c >= '0') && (c <= '9')) {
+            value |= c - '0';
+        } else if ((c >= 'a') && (c <= 'f')) {
+            value |= c - 'a' + 10;
+        } else if ((c >= 'A') && (c <= 'F')) {
+            value |= c - 'A' + 10;
+        } else {
+            return -1;
+        }
+    }
+    return value;
+}
+
+/*******************************************************************************
+ * Function Name: load_hex
+ ********************************************************************************
+ * Loads an Intel HEX file. Gaps between records are filled with the erased
+ * value, the image starts at the lowest record address.
+ *******************************************************************************/
+static int load_hex(FILE *file, image_t *image) {
+    uint8_t *mem = malloc(IMAGE_MAX_SIZE);
+    uint32_t base = 0u;
+    uint32_t low = UINT32_MAX;
+    uint32_t high = 0u;
+    uint32_t origin = UINT32_MAX;
+    char line[600];
+
+    if (mem == NULL) {
+        return -1;
+    }
+    memset(mem, IMAGE_ERASED_VALUE, IMAGE_MAX_SIZE);
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        uint8_t rec[256];
+        int len;
+        uint8_t sum = 0u;
+
+        if (line[0] != ':') {
+            continue;
+        }
+        len = hex_byte(&line[1]);
+        if (len < 0) {
+            goto error;
+        }
+        for (int i = 0; i < len + 5; i++) {
+            int b = hex_byte(&line[1 + (2 * i)]);
+
+            if (b < 0) {
+                goto error;
+            }
+            rec[i] = (uint8_t)b;
+            sum += (uint8_t)b;
+        }
+        if (sum != 0u) {
+            goto error;
+        }
+
+        uint32_t offset = ((uint32_t)rec[1] << 8) | rec[2];
+
+        switch (rec[3]) {
+        case 0x00u:
+        {
+            uint32_t address = base + offset;
+
+            if (origin == UINT32_MAX) {
+                origin = address;
+            }
+            if ((address < origin) || (address - origin + (uint32_t)len > IMAGE_MAX_SIZE)) {
+                goto error;
+            }
+            memcpy(&mem[address - origin], &rec[4], (size_t)len);
+            low = (address < low) ? address : low;
+            high = (address + (uint32_t)len > high) ? address + (uint32_t)len : high;
+            break;
+        }
+        case 0x02u:
+            base = (((uint32_t)rec[4] << 8) | rec[5]) << 4;
+            break;
+        case 0x04u:
+            base = (((uint32_t)rec[4] << 8) | rec[5]) << 16;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (low == UINT32_MAX) {
+        goto error;
+    }
+    image->address = low;
+    image->size = high - low;
+    image->data = malloc(image->size);
+    if (image->data == NULL) {
+        goto error;
+    }
+    memcpy(image->data, &mem[low - origin], image->size);
+    free(mem);
+    return 0;
+
+error:
+    free(mem);
+    return -1;
+}
+
+/*******************************************************************************
+ * Function Name: image_load
+ ********************************************************************************
+ * Loads an image. Files ending with ".hex" are parsed as Intel HEX, any
+ * other file is taken as a raw binary placed at default_address.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int image_load(const char *path, uint32_t default_address, image_t *image) {
+    const char *ext = strrchr(path, '.');
+    FILE *file = fopen(path, (ext != NULL) && (strcmp(ext, ".hex") == 0) ? "r" : "rb");
+    int result = -1;
+
+    memset(image, 0, sizeof(*image));
+    if (file == NULL) {
+        return -1;
+    }
+
+    if ((ext != NULL) && (strcmp(ext, ".hex") == 0)) {
+        result = load_hex(file, image);
+    } else if ((fseek(file, 0, SEEK_END) == 0) && (ftell(file) > 0)) {
+        image->size = (uint32_t)ftell(file);
+        image->address = default_address;
+        image->data = malloc(image->size);
+        rewind(file);
+        if ((image->data != NULL) && (fread(image->data, 1, image->size, file) == image->size)) {
+            result = 0;
+        }
+    }
+    fclose(file);
+
+    if (result != 0) {
+        image_free(image);
+    }
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: image_save_bin
+ ********************************************************************************
+ * Writes the image as a raw binary.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int image_save_bin(const char *path, const image_t *image) {
+    FILE *file = fopen(path, "wb");
+    int result = -1;
+
+    if (file != NULL) {
+        result = (fwrite(image->data, 1, image->size, file) == image->size) ? 0 : -1;
+        fclose(file);
+    }
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: next_random
+ ********************************************************************************
+ * xorshift32 generator, keeps synthetic images reproducible.
+ *******************************************************************************/
+static uint32_t next_random(uint32_t *state) {
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/*******************************************************************************
+ * Function Name: write_tlv
+ ********************************************************************************
+ * Writes the TLV area of a synthetic image at tlv_off: info header, the
+ * SHA256 of the header and code, as MCUboot checks it, and an ECDSA
+ * signature entry with random contents.
+ *******************************************************************************/
+static void write_tlv(uint8_t *image, uint32_t tlv_off, uint32_t *rnd) {
+    uint8_t *p = &image[tlv_off];
+    dfu_sha256_t sha;
+
+    p[0] = (uint8_t)IMAGE_TLV_INFO_MAGIC;
+    p[1] = (uint8_t)(IMAGE_TLV_INFO_MAGIC >> 8);
+    p[2] = IMAGE_TLV_SIZE;
+    p[3] = 0u;
+    p[4] = IMAGE_TLV_SHA256;
+    p[5] = 0u;
+    p[6] = 32u;
+    p[7] = 0u;
+    dfu_sha256_init(&sha);
+    dfu_sha256_update(&sha, image, tlv_off);
+    dfu_sha256_final(&sha, &p[8]);
+    p[40] = IMAGE_TLV_ECDSA_SIG;
+    p[41] = 0u;
+    p[42] = 72u;
+    p[43] = 0u;
+    for (uint32_t i = 44u; i < IMAGE_TLV_SIZE; i++) {
+        p[i] = (uint8_t)next_random(rnd);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: image_synthetic
+ ********************************************************************************
+ * Builds an MCUboot-style padded image: header, code_size bytes of code-like
+ * content (recurring instruction idioms, literal pools pointing into the
+ * slot), TLV area, erased padding and the trailer magic at the end of the
+ * slot, as the post-build step produces for an UPGRADE image.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int image_synthetic(uint32_t address, uint32_t slot_size, uint32_t code_size, uint32_t seed,
+                    image_t *image) {
+    uint16_t idioms[64];
+    uint32_t rnd = (seed != 0u) ? seed : 0x2545F491u;
+    uint32_t tlv_off = IMAGE_HEADER_SIZE + code_size;
+    uint32_t idiom_rnd = 0x9E3779B9u;
+    uint8_t *p;
+
+    if (tlv_off + IMAGE_TLV_SIZE + IMAGE_TRAILER_MAGIC_SIZE > slot_size) {
+        return -1;
+    }
+    image->address = address;
+    image->size = slot_size;
+    image->data = malloc(slot_size);
+    if (image->data == NULL) {
+        return -1;
+    }
+    p = image->data;
+    memset(p, IMAGE_ERASED_VALUE, slot_size);
+
+    /* Header */
+    memset(p, 0, IMAGE_HEADER_SIZE);
+    p[0] = (uint8_t)IMAGE_MAGIC;
+    p[1] = (uint8_t)(IMAGE_MAGIC >> 8);
+    p[2] = (uint8_t)(IMAGE_MAGIC >> 16);
+    p[3] = (uint8_t)(IMAGE_MAGIC >> 24);
+    p[8] = (uint8_t)IMAGE_HEADER_SIZE;
+    p[9] = (uint8_t)(IMAGE_HEADER_SIZE >> 8);
+    p[12] = (uint8_t)code_size;
+    p[13] = (uint8_t)(code_size >> 8);
+    p[14] = (uint8_t)(code_size >> 16);
+    p[20] = 2u;
+
+    /* The idiom table does not depend on the seed, so images built with
+     * different seeds share instruction patterns like real builds do */
+    for (size_t i = 0; i < sizeof(idioms) / sizeof(idioms[0]); i++) {
+        idioms[i] = (uint16_t)next_random(&idiom_rnd);
+    }
+
+    /* Code */
+    for (uint32_t off = IMAGE_HEADER_SIZE; off + 4u <= tlv_off;) {
+        uint32_t r = next_random(&rnd);
+        uint32_t kind = r % 10u;
+
+        if (kind < 7u) {
+            uint16_t op = idioms[(r >> 8) % 64u];
+
+            p[off++] = (uint8_t)op;
+            p[off++] = (uint8_t)(op >> 8);
+        } else if (kind < 9u) {
+            p[off++] = (uint8_t)(r >> 8);
+            p[off++] = (uint8_t)(r >> 16);
+        } else {
+            uint32_t literal = address + ((r >> 4) % slot_size & ~3u);
+
+            p[off++] = (uint8_t)literal;
+            p[off++] = (uint8_t)(literal >> 8);
+            p[off++] = (uint8_t)(literal >> 16);
+            p[off++] = (uint8_t)(literal >> 24);
+        }
+    }
+
+    write_tlv(image->data, tlv_off, &rnd);
+
+    /* Trailer magic */
+    memcpy(&image->data[slot_size - IMAGE_TRAILER_MAGIC_SIZE], trailer_magic,
+           IMAGE_TRAILER_MAGIC_SIZE);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: image_synthetic_update
+ ********************************************************************************
+ * Builds the next version of a synthetic image, as a small source change
+ * does: change_size bytes of new code inserted a third into the code, the
+ * code after it moved, a few constants changed, a new version and new TLVs.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int image_synthetic_update(const image_t *base, uint32_t change_size, uint32_t seed,
+                           image_t *update) {
+    uint32_t rnd = (seed != 0u) ? seed : 0x2545F491u;
+    uint32_t code_size;
+    uint32_t insert_off;
+    uint32_t tlv_off;
+    uint8_t *p;
+
+    if (base->size < IMAGE_HEADER_SIZE) {
+        return -1;
+    }
+    code_size = (uint32_t)base->data[12] | ((uint32_t)base->data[13] << 8) |
+                ((uint32_t)base->data[14] << 16);
+    tlv_off = IMAGE_HEADER_SIZE + code_size + change_size;
+    if ((code_size < 64u) || (tlv_off + IMAGE_TLV_SIZE + IMAGE_TRAILER_MAGIC_SIZE > base->size)) {
+        return -1;
+    }
+
+    update->address = base->address;
+    update->size = base->size;
+    update->data = malloc(base->size);
+    if (update->data == NULL) {
+        return -1;
+    }
+    p = update->data;
+    memset(p, IMAGE_ERASED_VALUE, base->size);
+
+    insert_off = IMAGE_HEADER_SIZE + ((code_size / 3u) & ~3u);
+    memcpy(p, base->data, insert_off);
+    for (uint32_t i = 0; i < change_size; i++) {
+        p[insert_off + i] = (uint8_t)next_random(&rnd);
+    }
+    memcpy(&p[insert_off + change_size], &base->data[insert_off],
+           IMAGE_HEADER_SIZE + code_size - insert_off);
+
+    code_size += change_size;
+    p[12] = (uint8_t)code_size;
+    p[13] = (uint8_t)(code_size >> 8);
+    p[14] = (uint8_t)(code_size >> 16);
+    p[20]++;
+
+    for (uint32_t i = 0; i < 8u; i++) {
+        uint32_t off = IMAGE_HEADER_SIZE + ((next_random(&rnd) % (code_size - 4u)) & ~3u);
+        uint32_t value = next_random(&rnd);
+
+        memcpy(&p[off], &value, sizeof(value));
+    }
+
+    write_tlv(p, tlv_off, &rnd);
+    memcpy(&p[base->size - IMAGE_TRAILER_MAGIC_SIZE], trailer_magic, IMAGE_TRAILER_MAGIC_SIZE);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: image_ram_load
+ ********************************************************************************
+ * Makes a synthetic image one the RAM load mode starts, as imgtool
+ * --load-addr and the linker script of the SRAM do: IMAGE_F_RAM_LOAD and the
+ * load address in the header, a vector table at the start of the code with
+ * the initial stack pointer and a reset handler 1 KB into the code, then new
+ * TLVs over the changed header and code.
+ *
+ * Parameters:
+ *  load_addr      Address in the SRAM the header is copied to.
+ *  stack_top      Initial stack pointer of the vector table.
+ *
+ * Return:
+ *  0 on success, -1 if the image has no room for the vector table.
+ *******************************************************************************/
+int image_ram_load(image_t *image, uint32_t load_addr, uint32_t stack_top) {
+    uint8_t *p = image->data;
+    uint32_t code_size;
+    uint32_t reset;
+    uint32_t flags;
+    uint32_t rnd = 0x2545F491u;
+
+    if (image->size < IMAGE_HEADER_SIZE) {
+        return -1;
+    }
+    code_size = (uint32_t)p[12] | ((uint32_t)p[13] << 8) | ((uint32_t)p[14] << 16);
+    if ((code_size <= IMAGE_RAM_RESET_OFF) ||
+        (IMAGE_HEADER_SIZE + code_size + IMAGE_TLV_SIZE > image->size)) {
+        return -1;
+    }
+    flags = (uint32_t)p[16] | ((uint32_t)p[17] << 8) | ((uint32_t)p[18] << 16) | ((uint32_t)p[19] << 24);
+    flags |= IMAGE_F_RAM_LOAD;
+    reset = (load_addr + IMAGE_HEADER_SIZE + IMAGE_RAM_RESET_OFF) | 1u;
+    for (uint32_t i = 0u; i < 4u; i++) {
+        p[4u + i] = (uint8_t)(load_addr >> (8u * i));
+        p[16u + i] = (uint8_t)(flags >> (8u * i));
+        p[IMAGE_HEADER_SIZE + i] = (uint8_t)(stack_top >> (8u * i));
+        p[IMAGE_HEADER_SIZE + 4u + i] = (uint8_t)(reset >> (8u * i));
+    }
+    write_tlv(p, IMAGE_HEADER_SIZE + code_size, &rnd);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: image_extent
+ ********************************************************************************
+ * Return:
+ *  Size of the MCUboot image at the start of the data: header, code and
+ *  TLV areas, without padding and trailer. The whole data if it does not
+ *  start with an MCUboot header.
+ *******************************************************************************/
+uint32_t image_extent(const image_t *image) {
+    const uint8_t *p = image->data;
+    uint32_t end;
+
+    if ((image->size < 32u) ||
+        (((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24)) !=
+         IMAGE_MAGIC)) {
+        return image->size;
+    }
+    end = ((uint32_t)p[8] | ((uint32_t)p[9] << 8)) +
+          ((uint32_t)p[12] | ((uint32_t)p[13] << 8) | ((uint32_t)p[14] << 16) | ((uint32_t)p[15] << 24));
+    if ((end + 4u <= image->size) &&
+        (((uint32_t)p[end] | ((uint32_t)p[end + 1u] << 8)) == IMAGE_TLV_PROT_INFO_MAGIC)) {
+        end += (uint32_t)p[end + 2u] | ((uint32_t)p[end + 3u] << 8);
+    }
+    if ((end + 4u <= image->size) &&
+        (((uint32_t)p[end] | ((uint32_t)p[end + 1u] << 8)) == IMAGE_TLV_INFO_MAGIC)) {
+        end += (uint32_t)p[end + 2u] | ((uint32_t)p[end + 3u] << 8);
+    }
+    return (end < image->size) ? end : image->size;
+}
+
+/*******************************************************************************
+ * Function Name: image_free
+ ********************************************************************************
+ * Releases the image data.
+ *******************************************************************************/
+void image_free(image_t *image) {
+    free(image->data);
+    image->data = NULL;
+    image->size = 0u;
+}
+
+/* [] END OF FILE */
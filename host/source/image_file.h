@@ -0,0 +1,72 @@
+/******************************************************************************
+ * File Name:   image_file.h
+ *
+ * Description: Loading of signed MCUboot images (Intel HEX or raw binary) and
+ *              generation of synthetic images for the host tools.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef IMAGE_FILE_H
+#define IMAGE_FILE_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    /* Flash address of the first byte */
+    uint32_t address;
+    uint32_t size;
+    uint8_t *data;
+} image_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+int image_load(const char *path, uint32_t default_address, image_t *image);
+int image_save_bin(const char *path, const image_t *image);
+int image_synthetic(uint32_t address, uint32_t slot_size, uint32_t code_size, uint32_t seed,
+                    image_t *image);
+int image_synthetic_update(const image_t *base, uint32_t change_size, uint32_t seed,
+                           image_t *update);
+int image_ram_load(image_t *image, uint32_t load_addr, uint32_t stack_top);
+uint32_t image_extent(const image_t *image);
+void image_free(image_t *image);
+
+#endif /* IMAGE_FILE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * File Name:   image_lz.c
+ *
+ * Description: This file contains the upgrade image compressor of the host tools. It
+ *              produces the compressed stream decompressed by dfu_cm7/source/dfu_lz.c,
+ *              with the same greedy matcher as scripts/dfu_compress.py.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "dfu_lz.h"
+#include "image_lz.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define IMAGE_LZ_HASH_BITS          (12u)
+#define IMAGE_LZ_HASH_SIZE          (1u << IMAGE_LZ_HASH_BITS)
+/* Candidates tried per position, and match length that ends the search */
+#define IMAGE_LZ_MAX_CHAIN          (64u)
+#define IMAGE_LZ_GOOD_MATCH         (1024u)
+
+/*******************************************************************************
+ * Function Name: image_lz_hash
+ ********************************************************************************
+ * Hashes the three bytes at p.
+ *******************************************************************************/
+static uint32_t image_lz_hash(const uint8_t *p) {
+    uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+
+    return ((v * 2654435761u) >> (32u - IMAGE_LZ_HASH_BITS)) & (IMAGE_LZ_HASH_SIZE - 1u);
+}
+
+/*******************************************************************************
+ * Function Name: image_lz_compress
+ ********************************************************************************
+ * Compresses an image into a compressed stream at the same address.
+ *
+ * Parameters:
+ *  image          Image to compress.
+ *  window_bits    Largest match distance, as a power of two, 8 to 12.
+ *  stream         Compressed stream, free it with image_free().
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int image_lz_compress(const image_t *image, uint32_t window_bits, image_t *stream) {
+    const uint8_t *in = image->data;
+    uint32_t size = image->size;
+    uint32_t window = 1u << window_bits;
+    int32_t *head = malloc(IMAGE_LZ_HASH_SIZE * sizeof(int32_t));
+    int32_t *prev = malloc(((size_t)size + 1u) * sizeof(int32_t));
+    /* Worst case: one flag byte per 8 literals */
+    uint8_t *out = malloc(DFU_LZ_HEADER_SIZE + (size_t)size + (size / 8u) + 1u);
+    uint32_t o = DFU_LZ_HEADER_SIZE;
+    uint32_t flag_pos = 0u;
+    uint32_t flag_bit = 8u;
+    uint32_t i = 0u;
+
+    if ((head == NULL) || (prev == NULL) || (out == NULL) || (window_bits < 8u) || (window_bits > 12u)) {
+        free(head);
+        free(prev);
+        free(out);
+        return -1;
+    }
+    for (uint32_t h = 0u; h < IMAGE_LZ_HASH_SIZE; h++) {
+        head[h] = -1;
+    }
+
+    out[0] = (uint8_t)DFU_LZ_MAGIC;
+    out[1] = (uint8_t)(DFU_LZ_MAGIC >> 8);
+    out[2] = (uint8_t)(DFU_LZ_MAGIC >> 16);
+    out[3] = (uint8_t)(DFU_LZ_MAGIC >> 24);
+    out[4] = DFU_LZ_VERSION;
+    out[5] = (uint8_t)window_bits;
+    out[6] = 0u;
+    out[7] = 0u;
+    out[8] = (uint8_t)size;
+    out[9] = (uint8_t)(size >> 8);
+    out[10] = (uint8_t)(size >> 16);
+    out[11] = (uint8_t)(size >> 24);
+
+    while (i < size) {
+        uint32_t best_len = 0u;
+        uint32_t best_dist = 0u;
+        uint32_t step;
+
+        if (i + DFU_LZ_MIN_MATCH <= size) {
+            int32_t cand = head[image_lz_hash(&in[i])];
+
+            for (uint32_t chain = 0u; (cand >= 0) && (chain < IMAGE_LZ_MAX_CHAIN) &&
+                 (i - (uint32_t)cand <= window); chain++) {
+                uint32_t len = 0u;
+
+                while ((i + len < size) && (in[(uint32_t)cand + len] == in[i + len])) {
+                    len++;
+                }
+                if (len > best_len) {
+                    best_len = len;
+                    best_dist = i - (uint32_t)cand;
+                    if ((best_len >= IMAGE_LZ_GOOD_MATCH) || (i + best_len == size)) {
+                        break;
+                    }
+                }
+                cand = prev[cand];
+            }
+        }
+
+        if (flag_bit == 8u) {
+            flag_pos = o++;
+            out[flag_pos] = 0u;
+            flag_bit = 0u;
+        }
+        if (best_len >= DFU_LZ_MIN_MATCH) {
+            uint32_t ext = best_len - DFU_LZ_MIN_MATCH;
+            uint32_t field = (ext < DFU_LZ_LENGTH_EXT) ? ext : DFU_LZ_LENGTH_EXT;
+            uint32_t v = (best_dist - 1u) | (field << 12);
+
+            out[flag_pos] |= (uint8_t)(1u << flag_bit);
+            out[o++] = (uint8_t)v;
+            out[o++] = (uint8_t)(v >> 8);
+            if (field == DFU_LZ_LENGTH_EXT) {
+                ext -= DFU_LZ_LENGTH_EXT;
+                while (ext >= 0xFFu) {
+                    out[o++] = 0xFFu;
+                    ext -= 0xFFu;
+                }
+                out[o++] = (uint8_t)ext;
+            }
+            step = best_len;
+        } else {
+            out[o++] = in[i];
+            step = 1u;
+        }
+        flag_bit++;
+
+        for (; step != 0u; step--, i++) {
+            if (i + DFU_LZ_MIN_MATCH <= size) {
+                uint32_t h = image_lz_hash(&in[i]);
+
+                prev[i] = head[h];
+                head[h] = (int32_t)i;
+            }
+        }
+    }
+
+    free(head);
+    free(prev);
+    stream->address = image->address;
+    stream->size = o;
+    stream->data = out;
+    return 0;
+}
+
+/* [] END OF FILE */
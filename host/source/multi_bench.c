@@ -0,0 +1,448 @@
+/******************************************************************************
+ * File Name:   multi_bench.c
+ *
+ * Description: Two image update benchmark. Updates the images of both CM7 cores through
+ *              the DFU application session loop, in two sessions or in one session with
+ *              the images sent one after the other or interleaved row by row, and
+ *              validates them as the bootloader does at the next boot, one image after
+ *              the other.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "bench_stats.h"
+#include "cy_dfu.h"
+#include "dfu_digest.h"
+#include "dfu_host.h"
+#include "dfu_image.h"
+#include "image_file.h"
+#include "sim_boot.h"
+#include "sim_device.h"
+#include "sim_flash.h"
+#include "sim_link.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define BENCH_DEFAULT_PACKET_SIZE   (64u)
+#define BENCH_DEFAULT_CODE_SIZE     (0x10000u)
+#define BENCH_HANDOVER_TIMEOUT_MS   (2000u)
+#define BENCH_DEFAULT_RTO_MS        (20u)
+
+#if (MCUBOOT_IMAGE_NUMBER < 2)
+#error "multi_bench needs a memory map with two images, see FLASH_MAP of the host Makefile"
+#endif
+
+/* Images updated, one per CM7 core */
+#define BENCH_IMAGES                (2u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    /* One session and one boot per image */
+    BENCH_MODE_SEPARATE,
+    /* One session, the images one after the other */
+    BENCH_MODE_SEQUENTIAL,
+    /* One session, the rows of the images interleaved */
+    BENCH_MODE_INTERLEAVED,
+    BENCH_MODE_COUNT
+} bench_mode_t;
+
+typedef struct {
+    uint32_t code_size[BENCH_IMAGES];
+    uint32_t packet_size;
+    uint32_t poll_us;
+    bool event_driven;
+    uint32_t window;
+    bool stream;
+    uint32_t hash_us_per_kb;
+    uint32_t runs;
+    int json;
+} bench_options_t;
+
+typedef struct {
+    uint32_t *session_us;
+    uint32_t *transfer_us;
+    uint32_t *verify_us;
+    uint32_t *boot_us;
+    uint32_t sessions;
+    uint32_t commands;
+    uint64_t wire_bytes;
+    uint32_t boot_hashed;
+} bench_result_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const char *const mode_names[BENCH_MODE_COUNT] = { "separate", "sequential", "interleaved" };
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name) {
+    printf("Usage: %s [options]\n"
+           "  --code-size N       code size of the synthetic image of CM7_0 (default 0x%x)\n"
+           "  --code-size-2 N     code size of the synthetic image of CM7_1 (default 0x%x)\n"
+           "  --packet-size N     DFU packet payload size in bytes (default %u)\n"
+           "  --poll-us N         device transport poll interval in us (default 1000)\n"
+           "  --mode poll|event   DFU session loop mode (default poll)\n"
+           "  --window N          commands in flight, up to %u; 0 is stop-and-wait (default 0)\n"
+           "  --readback          the DFU application reads the slots back to validate them\n"
+           "                      instead of hashing the rows while they are written\n"
+           "  --hash-us-per-kb N  modelled time to hash 1 KB on the target, added to the\n"
+           "                      validation latencies (default 0)\n"
+           "  --runs N            number of updates per mode (default 3)\n"
+           "  --json              machine-readable output\n",
+           name, BENCH_DEFAULT_CODE_SIZE, BENCH_DEFAULT_CODE_SIZE, BENCH_DEFAULT_PACKET_SIZE,
+           DFU_WINDOW_SIZE);
+}
+
+/*******************************************************************************
+ * Function Name: run_session
+ ********************************************************************************
+ * Runs one DFU session that sends images, then validates them as the
+ * bootloader does after the reset.
+ *
+ * Parameters:
+ *  opt            Options.
+ *  images         Images to send, at their secondary slots.
+ *  indexes        Index of each image in the memory map.
+ *  count          Number of images.
+ *  interleave     Alternate the rows of the images.
+ *  run            Index of the update.
+ *  result         Accumulates the measurements.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int run_session(const bench_options_t *opt, const image_t *images, const uint32_t *indexes,
+                       uint32_t count, bool interleave, uint32_t run, bench_result_t *result) {
+    sim_link_config_t link_config = {
+        .poll_interval_us = opt->poll_us,
+        .latency_us = 0u,
+        .loss_ppm = 0u,
+    };
+    sim_device_config_t device_config = {
+        .event_driven = opt->event_driven,
+        .window_size = opt->window,
+        .digest = opt->stream,
+    };
+    dfu_host_link_t link = { sim_link_host_send, sim_link_host_recv, NULL };
+    dfu_host_config_t host_config = {
+        .packet_data_size = opt->packet_size,
+        .row_size = CY_DFU_ROW_SIZE,
+        .timeout_ms = 1000u,
+        .retries = 0u,
+        .window = opt->window,
+        .rto_ms = BENCH_DEFAULT_RTO_MS,
+        .resume = false,
+        .drop_offset = 0u,
+    };
+    sim_device_stats_t device;
+    dfu_digest_stats_t digest;
+    dfu_host_t host;
+    uint8_t app_ids[BENCH_IMAGES];
+    uint64_t start;
+    uint64_t transfer_end;
+    int status;
+    bool handover;
+
+    for (uint32_t i = 0u; i < count; i++) {
+        app_ids[i] = (uint8_t)(indexes[i] + 1u);
+    }
+    if ((sim_link_open(&link_config) != 0) || (sim_device_start(&device_config) != 0)) {
+        return -1;
+    }
+    dfu_host_init(&host, &link, &host_config);
+    start = sim_time_us();
+    status = dfu_host_program_images(&host, images, app_ids, count, interleave);
+    transfer_end = sim_time_us();
+    handover = (status == CY_DFU_SUCCESS) && sim_device_wait_handover(BENCH_HANDOVER_TIMEOUT_MS);
+    result->session_us[run] += (uint32_t)(sim_time_us() - start);
+    result->transfer_us[run] += (uint32_t)(transfer_end - start);
+    sim_device_stop(&device);
+    sim_link_close();
+
+    dfu_digest_stats_get(&digest);
+    result->verify_us[run] += (uint32_t)(host.stats.verify_us +
+                                         (uint64_t)digest.readback * opt->hash_us_per_kb / 1024u);
+    result->commands += host.stats.commands;
+    result->wire_bytes += host.stats.wire_bytes;
+    result->sessions++;
+    dfu_host_deinit(&host);
+    if (!handover) {
+        fprintf(stderr, "run %u failed: status 0x%02x, handover %d\n", run, status, handover);
+        return -1;
+    }
+
+    /* The bootloader validates the secondary slot of every image after the
+     * reset, one image after the other on the CM0+ */
+    for (uint32_t i = 0u; i < count; i++) {
+        sim_boot_result_t boot;
+
+        if (memcmp(sim_flash_ptr(images[i].address, images[i].size), images[i].data,
+                   images[i].size) != 0) {
+            fprintf(stderr, "run %u failed: image %u differs\n", run, indexes[i] + 1u);
+            return -1;
+        }
+        sim_boot_validate(indexes[i], &boot);
+        if (!boot.valid) {
+            fprintf(stderr, "run %u failed: the bootloader rejects image %u\n", run, indexes[i] + 1u);
+            return -1;
+        }
+        result->boot_us[run] += (uint32_t)(boot.time_us +
+                                           (uint64_t)boot.hashed * opt->hash_us_per_kb / 1024u);
+        result->boot_hashed += boot.hashed;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: run_update
+ ********************************************************************************
+ * Updates both images in a mode, starting from erased secondary slots.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int run_update(const bench_options_t *opt, const image_t *images, bench_mode_t mode,
+                      uint32_t run, bench_result_t *result) {
+    static const uint32_t indexes[BENCH_IMAGES] = { 0u, 1u };
+
+    if (sim_flash_init() != 0) {
+        return -1;
+    }
+    if (mode == BENCH_MODE_SEPARATE) {
+        for (uint32_t i = 0u; i < BENCH_IMAGES; i++) {
+            if (run_session(opt, &images[i], &indexes[i], 1u, false, run, result) != 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+    return run_session(opt, images, indexes, BENCH_IMAGES, mode == BENCH_MODE_INTERLEAVED, run, result);
+}
+
+/*******************************************************************************
+ * Function Name: report
+ ********************************************************************************
+ * Prints the results of every mode.
+ *******************************************************************************/
+static void report(const bench_options_t *opt, const image_t *images, const bench_result_t *results) {
+    if (opt->json) {
+        printf("{\"image_bytes\": [%u, %u], \"packet_size\": %u, \"mode\": \"%s\", \"poll_us\": %u, "
+               "\"window\": %u, \"runs\": %u, \"stream\": %s, \"hash_us_per_kb\": %u, \"updates\": [",
+               images[0].size, images[1].size, opt->packet_size, opt->event_driven ? "event" : "poll",
+               opt->poll_us, opt->window, opt->runs, opt->stream ? "true" : "false",
+               opt->hash_us_per_kb);
+    } else {
+        printf("Two image update benchmark\n");
+        printf("  images              : %u bytes at 0x%08x, %u bytes at 0x%08x\n", images[0].size,
+               images[0].address, images[1].size, images[1].address);
+        printf("  packet payload      : %u bytes, %s session loop, poll %u us\n", opt->packet_size,
+               opt->event_driven ? "event-driven" : "polled", opt->poll_us);
+        printf("  validation          : %s, hash model %u us/KB\n",
+               opt->stream ? "digests hashed while written" : "slots read back",
+               opt->hash_us_per_kb);
+        printf("  runs                : %u per mode\n", opt->runs);
+    }
+
+    for (uint32_t mode = 0u; mode < BENCH_MODE_COUNT; mode++) {
+        const bench_result_t *result = &results[mode];
+        bench_stats_t session;
+        bench_stats_t transfer;
+        bench_stats_t verify;
+        bench_stats_t boot;
+        uint32_t sessions = result->sessions / opt->runs;
+
+        bench_stats_compute(result->session_us, opt->runs, &session);
+        bench_stats_compute(result->transfer_us, opt->runs, &transfer);
+        bench_stats_compute(result->verify_us, opt->runs, &verify);
+        bench_stats_compute(result->boot_us, opt->runs, &boot);
+
+        if (opt->json) {
+            printf("%s{\"update\": \"%s\", \"sessions\": %u, \"boots\": %u, \"commands\": %u, "
+                   "\"wire_bytes\": %llu, \"transfer_ms\": %.3f, \"session_ms\": %.3f, "
+                   "\"app_validation_us\": %.0f, \"boot_validation_us\": %.0f, "
+                   "\"boot_hashed_bytes\": %u, \"total_ms\": %.3f}",
+                   (mode == 0u) ? "" : ", ", mode_names[mode], sessions, sessions,
+                   result->commands / opt->runs, (unsigned long long)(result->wire_bytes / opt->runs),
+                   transfer.mean / 1000.0, session.mean / 1000.0, verify.mean, boot.mean,
+                   result->boot_hashed / opt->runs,
+                   (session.mean + boot.mean) / 1000.0);
+            continue;
+        }
+        printf("  %s\n", mode_names[mode]);
+        printf("    sessions / boots  : %u / %u, %u commands\n", sessions, sessions,
+               result->commands / opt->runs);
+        printf("    transfer time (ms): min %.3f  mean %.3f  max %.3f\n", transfer.min / 1000.0,
+               transfer.mean / 1000.0, transfer.max / 1000.0);
+        printf("    session time (ms) : min %.3f  mean %.3f  max %.3f\n", session.min / 1000.0,
+               session.mean / 1000.0, session.max / 1000.0);
+        printf("    app validation    : mean %.0f us\n", verify.mean);
+        printf("    boot validation   : mean %.0f us, %u bytes hashed one image after the other\n", boot.mean,
+               result->boot_hashed / opt->runs);
+        printf("    update time (ms)  : %.3f\n", (session.mean + boot.mean) / 1000.0);
+    }
+    if (opt->json) {
+        printf("]}\n");
+    }
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Parses the options, builds the images and runs the updates of every mode.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "code-size",   required_argument, NULL, 'c' },
+        { "code-size-2", required_argument, NULL, 'C' },
+        { "packet-size", required_argument, NULL, 'p' },
+        { "poll-us",     required_argument, NULL, 'u' },
+        { "mode",        required_argument, NULL, 'm' },
+        { "window",      required_argument, NULL, 'w' },
+        { "readback",    no_argument,       NULL, 'H' },
+        { "hash-us-per-kb", required_argument, NULL, 'G' },
+        { "runs",        required_argument, NULL, 'r' },
+        { "json",        no_argument,       NULL, 'j' },
+        { "help",        no_argument,       NULL, 'h' },
+        { NULL,          0,                 NULL, 0 },
+    };
+    bench_options_t opt = {
+        .code_size = { BENCH_DEFAULT_CODE_SIZE, BENCH_DEFAULT_CODE_SIZE },
+        .packet_size = BENCH_DEFAULT_PACKET_SIZE,
+        .poll_us = 1000u,
+        .event_driven = false,
+        .window = 0u,
+        .stream = true,
+        .hash_us_per_kb = 0u,
+        .runs = 3u,
+        .json = 0,
+    };
+    bench_result_t results[BENCH_MODE_COUNT];
+    image_t images[BENCH_IMAGES];
+    uint32_t built = 0u;
+    int c;
+    int console;
+    int status = 0;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'c': opt.code_size[0] = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'C': opt.code_size[1] = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'p': opt.packet_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'u': opt.poll_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'm':
+            if ((strcmp(optarg, "event") != 0) && (strcmp(optarg, "poll") != 0)) {
+                usage(argv[0]);
+                return 2;
+            }
+            opt.event_driven = (strcmp(optarg, "event") == 0);
+            break;
+        case 'w': opt.window = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'H': opt.stream = false; break;
+        case 'G': opt.hash_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'r': opt.runs = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'j': opt.json = 1; break;
+        default: usage(argv[0]); return (c == 'h') ? 0 : 2;
+        }
+    }
+    if (opt.runs == 0u) {
+        opt.runs = 1u;
+    }
+    if (opt.window > DFU_WINDOW_SIZE) {
+        opt.window = DFU_WINDOW_SIZE;
+    }
+
+    for (; built < BENCH_IMAGES; built++) {
+        const dfu_image_t *slots = dfu_image_get(built);
+
+        if (image_synthetic(slots->secondary, slots->size, opt.code_size[built], built + 1u,
+                            &images[built]) != 0) {
+            fprintf(stderr, "cannot build the synthetic image %u\n", built + 1u);
+            status = -1;
+            break;
+        }
+    }
+
+    memset(results, 0, sizeof(results));
+    for (uint32_t mode = 0u; mode < BENCH_MODE_COUNT; mode++) {
+        results[mode].session_us = calloc(opt.runs, sizeof(uint32_t));
+        results[mode].transfer_us = calloc(opt.runs, sizeof(uint32_t));
+        results[mode].verify_us = calloc(opt.runs, sizeof(uint32_t));
+        results[mode].boot_us = calloc(opt.runs, sizeof(uint32_t));
+    }
+
+    /* The device console (retarget-io on the target) goes to stderr */
+    fflush(stdout);
+    console = dup(STDOUT_FILENO);
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+    for (uint32_t mode = 0u; (mode < BENCH_MODE_COUNT) && (status == 0); mode++) {
+        for (uint32_t run = 0u; (run < opt.runs) && (status == 0); run++) {
+            status = run_update(&opt, images, (bench_mode_t)mode, run, &results[mode]);
+        }
+    }
+    fflush(stdout);
+    dup2(console, STDOUT_FILENO);
+    close(console);
+
+    if (status == 0) {
+        report(&opt, images, results);
+    }
+
+    for (uint32_t mode = 0u; mode < BENCH_MODE_COUNT; mode++) {
+        free(results[mode].session_us);
+        free(results[mode].transfer_us);
+        free(results[mode].verify_us);
+        free(results[mode].boot_us);
+    }
+    for (uint32_t i = 0u; i < built; i++) {
+        image_free(&images[i]);
+    }
+    sim_flash_deinit();
+    return (status == 0) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,381 @@
+/******************************************************************************
+ * File Name:   ram_load_bench.c
+ *
+ * Description: Boot scenarios and boot time of the RAM load mode (USE_MCUBOOT_RAM_LOAD=1): the
+ *              boot_go() model of the power failure harness on the RAM load flash map copies the
+ *              slot of the highest version to the SRAM, validates the copy and runs the launch
+ *              check of boot_ram.c on it. Each scenario checks the slot started, the SRAM and the
+ *              slots after the boot.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "memorymap.h"
+#include "image_file.h"
+#include "sim_flash.h"
+#include "sim_loader.h"
+#include "sim_swap_port.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Stack of the images at the end of the load window, as the linker script
+ * of the SRAM places it */
+#define RAM_BENCH_STACK_TOP         (IMAGE_EXECUTABLE_RAM_START + IMAGE_EXECUTABLE_RAM_SIZE)
+
+/* Vector table of the CM7 after the image header */
+#define RAM_BENCH_ENTRY             (IMAGE_EXECUTABLE_RAM_START + 0x400u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    /* The old image in the primary slot, the new one in the secondary */
+    RAM_IMAGE_OLD = 0,
+    RAM_IMAGE_NEW,
+    /* The new image with a flipped code byte */
+    RAM_IMAGE_CORRUPT,
+    /* The new image without IMAGE_F_RAM_LOAD */
+    RAM_IMAGE_NO_FLAG,
+    /* The new image loaded at an address it does not fit at in the window */
+    RAM_IMAGE_OUTSIDE,
+    /* The new image with its stack in its own code */
+    RAM_IMAGE_BAD_VECTORS,
+    RAM_IMAGE_COUNT,
+    /* Erased slot */
+    RAM_IMAGE_NONE = RAM_IMAGE_COUNT
+} ram_image_t;
+
+typedef struct {
+    const char *name;
+    const char *key;
+    ram_image_t primary;
+    ram_image_t secondary;
+    /* A bit of the copy flips in the SRAM before it is hashed */
+    bool ram_fault;
+    /* Expected result: the slot started, RAM_IMAGE_NONE if none; the slots
+     * erased by the boot */
+    ram_image_t started;
+    uint32_t slot;
+    bool primary_erased;
+    bool secondary_erased;
+} ram_scenario_t;
+
+typedef struct {
+    uint32_t code_size;
+    uint32_t seed;
+    bool json;
+    sim_swap_timing_t timing;
+    sim_loader_cfg_t loader;
+} ram_bench_options_t;
+
+typedef struct {
+    bool passed;
+    bool booted;
+    uint32_t entry;
+    uint32_t copied;
+    uint32_t hashed;
+    uint64_t time_us;
+} ram_bench_result_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const ram_scenario_t ram_scenarios[] = {
+    { "newest image in the secondary slot", "newest", RAM_IMAGE_OLD, RAM_IMAGE_NEW, false,
+      RAM_IMAGE_NEW, SECONDARY_IMG_START, false, false },
+    { "newest image in the primary slot", "newest_primary", RAM_IMAGE_NEW, RAM_IMAGE_OLD, false,
+      RAM_IMAGE_NEW, PRIMARY_IMG_START, false, false },
+    { "secondary slot erased", "single", RAM_IMAGE_OLD, RAM_IMAGE_NONE, false,
+      RAM_IMAGE_OLD, PRIMARY_IMG_START, false, true },
+    { "corrupt newest image", "corrupt", RAM_IMAGE_OLD, RAM_IMAGE_CORRUPT, false,
+      RAM_IMAGE_OLD, PRIMARY_IMG_START, false, true },
+    { "newest image without the RAM load flag", "no_flag", RAM_IMAGE_OLD, RAM_IMAGE_NO_FLAG, false,
+      RAM_IMAGE_OLD, PRIMARY_IMG_START, false, true },
+    { "newest image outside the load window", "outside", RAM_IMAGE_OLD, RAM_IMAGE_OUTSIDE, false,
+      RAM_IMAGE_OLD, PRIMARY_IMG_START, false, true },
+    { "bit flip in the SRAM copy", "ram_fault", RAM_IMAGE_OLD, RAM_IMAGE_NEW, true,
+      RAM_IMAGE_NONE, 0u, true, true },
+    { "newest image with a bad vector table", "bad_vectors", RAM_IMAGE_OLD, RAM_IMAGE_BAD_VECTORS, false,
+      RAM_IMAGE_NONE, 0u, false, false },
+};
+
+#define RAM_SCENARIOS               (sizeof(ram_scenarios) / sizeof(ram_scenarios[0]))
+
+static image_t ram_images[RAM_IMAGE_COUNT];
+static uint8_t ram_erased[SLOT_SIZE];
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name, const ram_bench_options_t *opt) {
+    printf("Usage: %s [options]\n"
+           "Boot scenarios and boot time of the RAM load mode (USE_MCUBOOT_RAM_LOAD=1), RAM load flash map.\n"
+           "  --code-size N       code size of the old image (default 0x%x)\n"
+           "  --copy-us-per-kb N  modelled time to copy 1 KB of an image to the SRAM (default %u)\n"
+           "  --hash-us-per-kb N  modelled time to hash 1 KB of an image (default %u)\n"
+           "  --code-erase-us N   modelled time to erase a code flash sector (default %u)\n"
+           "  --seed N            seed of the images (default 1)\n"
+           "  --json              machine-readable output\n",
+           name, opt->code_size, opt->loader.copy_us_per_kb, opt->loader.hash_us_per_kb,
+           opt->timing.code_erase_us);
+}
+
+/*******************************************************************************
+ * Function Name: ram_bench_images
+ ********************************************************************************
+ * Builds the images of the scenarios, linked for the load window unless the
+ * scenario breaks it.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+static int ram_bench_images(const ram_bench_options_t *opt) {
+    image_t *img = ram_images;
+    uint32_t size;
+
+    if ((image_synthetic(PRIMARY_IMG_START, SLOT_SIZE, opt->code_size, opt->seed, &img[RAM_IMAGE_OLD]) != 0) ||
+        (image_synthetic_update(&img[RAM_IMAGE_OLD], 0x400u, opt->seed + 1u, &img[RAM_IMAGE_NO_FLAG]) != 0) ||
+        (image_synthetic_update(&img[RAM_IMAGE_OLD], 0x400u, opt->seed + 1u, &img[RAM_IMAGE_NEW]) != 0) ||
+        (image_synthetic_update(&img[RAM_IMAGE_OLD], 0x400u, opt->seed + 1u, &img[RAM_IMAGE_CORRUPT]) != 0) ||
+        (image_synthetic_update(&img[RAM_IMAGE_OLD], 0x400u, opt->seed + 1u, &img[RAM_IMAGE_OUTSIDE]) != 0) ||
+        (image_synthetic_update(&img[RAM_IMAGE_OLD], 0x400u, opt->seed + 1u, &img[RAM_IMAGE_BAD_VECTORS]) != 0) ||
+        (image_ram_load(&img[RAM_IMAGE_OLD], IMAGE_EXECUTABLE_RAM_START, RAM_BENCH_STACK_TOP) != 0) ||
+        (image_ram_load(&img[RAM_IMAGE_NEW], IMAGE_EXECUTABLE_RAM_START, RAM_BENCH_STACK_TOP) != 0) ||
+        (image_ram_load(&img[RAM_IMAGE_CORRUPT], IMAGE_EXECUTABLE_RAM_START, RAM_BENCH_STACK_TOP) != 0) ||
+        /* The last byte of the image ends up past the window */
+        (image_ram_load(&img[RAM_IMAGE_OUTSIDE],
+                        IMAGE_EXECUTABLE_RAM_START + IMAGE_EXECUTABLE_RAM_SIZE -
+                        ((image_extent(&img[RAM_IMAGE_NEW]) + 0x3FFu) & ~0x3FFu) + 0x400u,
+                        RAM_BENCH_STACK_TOP) != 0) ||
+        /* Stack top in the code of the image */
+        (image_ram_load(&img[RAM_IMAGE_BAD_VECTORS], IMAGE_EXECUTABLE_RAM_START,
+                        IMAGE_EXECUTABLE_RAM_START + 0x800u) != 0)) {
+        return -1;
+    }
+    size = image_extent(&img[RAM_IMAGE_CORRUPT]);
+    img[RAM_IMAGE_CORRUPT].data[size / 2u] ^= 0x10u;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: ram_bench_slot
+ ********************************************************************************
+ * Returns true if a slot holds the image, or is erased for RAM_IMAGE_NONE.
+ *******************************************************************************/
+static bool ram_bench_slot(uint32_t address, ram_image_t image) {
+    const uint8_t *p;
+
+    if (image == RAM_IMAGE_NONE) {
+        return sim_flash_is_erased(address, SLOT_SIZE);
+    }
+    p = sim_flash_ptr(address, SLOT_SIZE);
+    return (p != NULL) && (memcmp(p, ram_images[image].data, SLOT_SIZE) == 0);
+}
+
+/*******************************************************************************
+ * Function Name: ram_bench_ram
+ ********************************************************************************
+ * Returns true if the load window holds a copy of the image, or is clear for
+ * RAM_IMAGE_NONE.
+ *******************************************************************************/
+static bool ram_bench_ram(ram_image_t image) {
+    uint32_t size;
+    const uint8_t *ram = sim_loader_ram(&size);
+
+    if (ram == NULL) {
+        return false;
+    }
+    if (image == RAM_IMAGE_NONE) {
+        for (uint32_t i = 0u; i < size; i++) {
+            if (ram[i] != 0u) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return memcmp(ram, ram_images[image].data, image_extent(&ram_images[image])) == 0;
+}
+
+/*******************************************************************************
+ * Function Name: ram_bench_run
+ ********************************************************************************
+ * Loads the slots of a scenario, boots once after a power-on and checks the
+ * result. A bad vector table leaves the validated copy in the SRAM and the
+ * slots as they are: main() does not start it.
+ *******************************************************************************/
+static void ram_bench_run(const ram_bench_options_t *opt, const ram_scenario_t *scenario, ram_bench_result_t *r) {
+    sim_loader_cfg_t loader = opt->loader;
+    sim_loader_rsp_t rsp;
+    ram_image_t in_ram = scenario->started;
+    bool loaded;
+
+    memset(r, 0, sizeof(*r));
+    loader.ram_fault = scenario->ram_fault;
+    loaded = (sim_flash_load(PRIMARY_IMG_START, (scenario->primary == RAM_IMAGE_NONE) ? ram_erased :
+                             ram_images[scenario->primary].data, SLOT_SIZE) == 0) &&
+             (sim_flash_load(SECONDARY_IMG_START, (scenario->secondary == RAM_IMAGE_NONE) ? ram_erased :
+                             ram_images[scenario->secondary].data, SLOT_SIZE) == 0);
+    if (!loaded) {
+        return;
+    }
+    sim_swap_port_power_on();
+    sim_loader_power_on();
+    sim_loader_boot_go(&loader, &rsp);
+    r->booted = rsp.booted;
+    r->entry = rsp.entry;
+    r->copied = rsp.copied;
+    r->hashed = rsp.hashed;
+    r->time_us = rsp.time_us;
+
+    if (scenario->secondary == RAM_IMAGE_BAD_VECTORS) {
+        in_ram = RAM_IMAGE_BAD_VECTORS;
+    }
+    r->passed = (rsp.booted == (scenario->started != RAM_IMAGE_NONE)) &&
+                (!rsp.booted || ((rsp.slot == scenario->slot) && (rsp.entry == RAM_BENCH_ENTRY))) &&
+                ram_bench_ram(in_ram) &&
+                ram_bench_slot(PRIMARY_IMG_START, scenario->primary_erased ? RAM_IMAGE_NONE : scenario->primary) &&
+                ram_bench_slot(SECONDARY_IMG_START,
+                               scenario->secondary_erased ? RAM_IMAGE_NONE : scenario->secondary);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Runs the scenarios and prints the report.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "code-size",      required_argument, NULL, 'c' },
+        { "copy-us-per-kb", required_argument, NULL, 'Y' },
+        { "hash-us-per-kb", required_argument, NULL, 'G' },
+        { "code-erase-us",  required_argument, NULL, 'E' },
+        { "seed",           required_argument, NULL, 'S' },
+        { "json",           no_argument,       NULL, 'j' },
+        { "help",           no_argument,       NULL, 'h' },
+        { NULL,             0,                 NULL, 0 },
+    };
+    /* Assumed typical durations, as boot_harness */
+    ram_bench_options_t opt = {
+        .code_size = 0x10000u,
+        .seed = 1u,
+        .json = false,
+        .timing = {
+            .code_erase_us = 45000u,
+            .work_erase_us = 20000u,
+            .small_erase_us = 8000u,
+            .code_program_us = 1300u,
+            .work_program_us = 70u,
+        },
+        .loader = {
+            .hash_us_per_kb = 60u,
+            .copy_us_per_kb = 15u,
+        },
+    };
+    ram_bench_result_t results[RAM_SCENARIOS];
+    uint32_t failures = 0u;
+    uint64_t in_place_us;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'c': opt.code_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'Y': opt.loader.copy_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'G': opt.loader.hash_us_per_kb = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'E': opt.timing.code_erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'S': opt.seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'j': opt.json = true; break;
+        default: usage(argv[0], &opt); return (c == 'h') ? 0 : 2;
+        }
+    }
+
+    sim_swap_port_set_timing(&opt.timing);
+    memset(ram_erased, 0xFF, sizeof(ram_erased));
+    if ((sim_flash_init() != 0) || (sim_loader_init() != 0) || (ram_bench_images(&opt) != 0)) {
+        fprintf(stderr, "cannot set up the images and the flash areas\n");
+        return 1;
+    }
+    for (uint32_t i = 0u; i < RAM_SCENARIOS; i++) {
+        ram_bench_run(&opt, &ram_scenarios[i], &results[i]);
+        if (!results[i].passed) {
+            failures++;
+            fprintf(stderr, "%s: unexpected result\n", ram_scenarios[i].name);
+        }
+    }
+    /* The direct XIP boot of the same image hashes it in place, no copy */
+    in_place_us = (uint64_t)results[0].hashed * opt.loader.hash_us_per_kb / 1024u;
+
+    if (opt.json) {
+        printf("{\"image_size\": %u, \"window\": %u, \"in_place_us\": %llu, \"scenarios\": {",
+               image_extent(&ram_images[RAM_IMAGE_NEW]), (uint32_t)IMAGE_EXECUTABLE_RAM_SIZE,
+               (unsigned long long)in_place_us);
+        for (uint32_t i = 0u; i < RAM_SCENARIOS; i++) {
+            const ram_bench_result_t *r = &results[i];
+
+            printf("%s\"%s\": {\"passed\": %s, \"booted\": %s, \"entry\": %u, \"copied\": %u, \"hashed\": %u, "
+                   "\"time_us\": %llu}", (i == 0u) ? "" : ", ", ram_scenarios[i].key, r->passed ? "true" : "false",
+                   r->booted ? "true" : "false", r->entry, r->copied, r->hashed, (unsigned long long)r->time_us);
+        }
+        printf("}}\n");
+    } else {
+        printf("RAM load, image of 0x%x bytes, load window 0x%x bytes at 0x%08x\n",
+               image_extent(&ram_images[RAM_IMAGE_NEW]), (uint32_t)IMAGE_EXECUTABLE_RAM_SIZE,
+               (uint32_t)IMAGE_EXECUTABLE_RAM_START);
+        for (uint32_t i = 0u; i < RAM_SCENARIOS; i++) {
+            const ram_bench_result_t *r = &results[i];
+
+            printf("  %-40s : %s, %s, copied 0x%05x, hashed 0x%05x, %8.3f ms\n", ram_scenarios[i].name,
+                   r->passed ? "ok  " : "FAIL", r->booted ? "started" : "stopped", r->copied, r->hashed,
+                   r->time_us / 1000.0);
+        }
+        printf("Boot of the newest image: %.3f ms, of which copy %.3f ms; validated in place %.3f ms\n",
+               results[0].time_us / 1000.0,
+               ((uint64_t)results[0].copied * opt.loader.copy_us_per_kb / 1024u) / 1000.0, in_place_us / 1000.0);
+        printf("Modelled times: flash operations, --copy-us-per-kb and --hash-us-per-kb.\n");
+    }
+    for (uint32_t i = 0u; i < RAM_IMAGE_COUNT; i++) {
+        image_free(&ram_images[i]);
+    }
+    sim_flash_deinit();
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
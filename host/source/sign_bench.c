@@ -0,0 +1,446 @@
+/******************************************************************************
+ * File Name:   sign_bench.c
+ *
+ * Description: Benchmark of the image signature types: verification time, code size of the
+ *              verifier, key and signature size for RSA-2048 PSS, ECDSA P-256 and Ed25519, each
+ *              with the test key of keys/ over the same image digest.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <errno.h>
+#include <getopt.h>
+#include <libgen.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "boot_crypto.h"
+#include "sign_rsa.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define BENCH_DEFAULT_MIN_MS        (500u)
+/* Modelled P-256 verification on the CM0+, as in boot_offload_bench */
+#define BENCH_DEFAULT_TARGET_P256_MS (60u)
+
+#define BENCH_PATH_MAX              (512u)
+
+/* ELF section flags */
+#define BENCH_SHF_WRITE             (0x1u)
+#define BENCH_SHF_ALLOC             (0x2u)
+#define BENCH_SHF_EXECINSTR         (0x4u)
+#define BENCH_SHT_NOBITS            (8u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t min_ms;
+    uint32_t target_p256_ms;
+    const char *objdir;
+    int json;
+} bench_options_t;
+
+typedef struct {
+    const char *name;
+    /* Object of the verifier, its code size is reported */
+    const char *object;
+    uint32_t key_size;
+    uint32_t sig_size;
+    bool (*verify)(void);
+    double verifies_per_s;
+    long code;
+    long rodata;
+} bench_sign_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+/* SHA-256 of "Edge Protect Bootloader", signed by each test key */
+static const uint8_t bench_hash[BOOT_CRYPTO_SHA256_SIZE] = {
+    0xaeu, 0x94u, 0x41u, 0xd0u, 0xfbu, 0x57u, 0x3fu, 0xbeu, 0xc7u, 0xbau, 0x9bu, 0xeeu,
+    0x8du, 0xb8u, 0xbdu, 0x57u, 0x24u, 0xbau, 0xdau, 0x27u, 0x4bu, 0x8du, 0xe6u, 0x30u,
+    0xb2u, 0x43u, 0xd0u, 0x90u, 0x99u, 0x7au, 0x88u, 0x65u,
+};
+
+/* keys/cypress-test-rsa2k.pem: the RSAPublicKey imgtool embeds, its modulus
+ * and a PSS signature with a 32-byte salt */
+static const uint8_t bench_rsa_key[] = {
+    0x30u, 0x82u, 0x01u, 0x0au, 0x02u, 0x82u, 0x01u, 0x01u, 0x00u, 0xc9u, 0xf3u, 0x3du,
+    0x90u, 0x90u, 0x24u, 0x0eu, 0xb4u, 0x89u, 0x8bu, 0x0du, 0xc8u, 0x7eu, 0x72u, 0x1bu,
+    0x43u, 0xdbu, 0xb9u, 0xfeu, 0x17u, 0x04u, 0x2du, 0x31u, 0xe8u, 0xa6u, 0xa3u, 0x11u,
+    0x9bu, 0x95u, 0x92u, 0xc8u, 0x97u, 0x8au, 0x39u, 0xf8u, 0xd0u, 0x7cu, 0xefu, 0xabu,
+    0x83u, 0xb4u, 0xa1u, 0x18u, 0x4bu, 0xc7u, 0x83u, 0xe4u, 0x2au, 0xc8u, 0x5cu, 0x03u,
+    0x2cu, 0x58u, 0x47u, 0x5fu, 0x66u, 0x1du, 0x29u, 0x06u, 0x36u, 0x68u, 0x68u, 0x5fu,
+    0x4eu, 0x04u, 0x7cu, 0x05u, 0xa3u, 0xcdu, 0xbfu, 0x29u, 0x72u, 0x21u, 0x6bu, 0x97u,
+    0xc7u, 0x34u, 0x57u, 0x61u, 0x83u, 0x52u, 0x38u, 0x94u, 0x3cu, 0x63u, 0x21u, 0xc4u,
+    0xb1u, 0x90u, 0xccu, 0x91u, 0x26u, 0xe5u, 0x1au, 0xa5u, 0x35u, 0xbbu, 0x9du, 0x63u,
+    0x40u, 0x2bu, 0x61u, 0x04u, 0x87u, 0x38u, 0x84u, 0xc0u, 0xbbu, 0xb0u, 0x9bu, 0x7au,
+    0x30u, 0x46u, 0x4fu, 0x09u, 0x00u, 0xc3u, 0x28u, 0xf5u, 0xb9u, 0x29u, 0x29u, 0xd2u,
+    0xd7u, 0xc7u, 0x0eu, 0x17u, 0x72u, 0x52u, 0xd2u, 0x3du, 0x1bu, 0xd4u, 0xa6u, 0x08u,
+    0x7bu, 0x03u, 0x8cu, 0xe4u, 0x10u, 0x29u, 0x68u, 0x27u, 0xf7u, 0x51u, 0x27u, 0x8au,
+    0xffu, 0x24u, 0xbcu, 0x62u, 0x13u, 0xbdu, 0x7au, 0xf8u, 0x38u, 0x99u, 0x13u, 0x57u,
+    0xbbu, 0x91u, 0x08u, 0x1au, 0xddu, 0x1du, 0x40u, 0x71u, 0xb2u, 0x51u, 0x50u, 0xcau,
+    0x14u, 0x12u, 0x16u, 0x1eu, 0x06u, 0x45u, 0x53u, 0x7du, 0x72u, 0x15u, 0x96u, 0x13u,
+    0xdbu, 0xd8u, 0x2bu, 0xeeu, 0xadu, 0xbbu, 0x5cu, 0x5eu, 0x6fu, 0xccu, 0x48u, 0x58u,
+    0x84u, 0xc8u, 0x0du, 0x31u, 0x80u, 0x5au, 0xd6u, 0x7cu, 0x2cu, 0xccu, 0x22u, 0x4bu,
+    0x82u, 0xf3u, 0xd8u, 0x4au, 0x90u, 0x22u, 0x21u, 0xdfu, 0x47u, 0x0eu, 0xeau, 0x28u,
+    0xf5u, 0xaau, 0x6fu, 0xceu, 0x8cu, 0xb5u, 0x6fu, 0xebu, 0xecu, 0x52u, 0x1au, 0xdbu,
+    0xfcu, 0x18u, 0x51u, 0x4bu, 0xd1u, 0x69u, 0x7bu, 0x52u, 0xe3u, 0x76u, 0x44u, 0xe5u,
+    0xbfu, 0x7fu, 0xbau, 0xf2u, 0x47u, 0x57u, 0xebu, 0x0cu, 0xb0u, 0xfdu, 0x32u, 0xd2u,
+    0x5bu, 0x02u, 0x03u, 0x01u, 0x00u, 0x01u,
+};
+static const uint8_t bench_rsa_n[SIGN_RSA_SIZE] = {
+    0xc9u, 0xf3u, 0x3du, 0x90u, 0x90u, 0x24u, 0x0eu, 0xb4u, 0x89u, 0x8bu, 0x0du, 0xc8u,
+    0x7eu, 0x72u, 0x1bu, 0x43u, 0xdbu, 0xb9u, 0xfeu, 0x17u, 0x04u, 0x2du, 0x31u, 0xe8u,
+    0xa6u, 0xa3u, 0x11u, 0x9bu, 0x95u, 0x92u, 0xc8u, 0x97u, 0x8au, 0x39u, 0xf8u, 0xd0u,
+    0x7cu, 0xefu, 0xabu, 0x83u, 0xb4u, 0xa1u, 0x18u, 0x4bu, 0xc7u, 0x83u, 0xe4u, 0x2au,
+    0xc8u, 0x5cu, 0x03u, 0x2cu, 0x58u, 0x47u, 0x5fu, 0x66u, 0x1du, 0x29u, 0x06u, 0x36u,
+    0x68u, 0x68u, 0x5fu, 0x4eu, 0x04u, 0x7cu, 0x05u, 0xa3u, 0xcdu, 0xbfu, 0x29u, 0x72u,
+    0x21u, 0x6bu, 0x97u, 0xc7u, 0x34u, 0x57u, 0x61u, 0x83u, 0x52u, 0x38u, 0x94u, 0x3cu,
+    0x63u, 0x21u, 0xc4u, 0xb1u, 0x90u, 0xccu, 0x91u, 0x26u, 0xe5u, 0x1au, 0xa5u, 0x35u,
+    0xbbu, 0x9du, 0x63u, 0x40u, 0x2bu, 0x61u, 0x04u, 0x87u, 0x38u, 0x84u, 0xc0u, 0xbbu,
+    0xb0u, 0x9bu, 0x7au, 0x30u, 0x46u, 0x4fu, 0x09u, 0x00u, 0xc3u, 0x28u, 0xf5u, 0xb9u,
+    0x29u, 0x29u, 0xd2u, 0xd7u, 0xc7u, 0x0eu, 0x17u, 0x72u, 0x52u, 0xd2u, 0x3du, 0x1bu,
+    0xd4u, 0xa6u, 0x08u, 0x7bu, 0x03u, 0x8cu, 0xe4u, 0x10u, 0x29u, 0x68u, 0x27u, 0xf7u,
+    0x51u, 0x27u, 0x8au, 0xffu, 0x24u, 0xbcu, 0x62u, 0x13u, 0xbdu, 0x7au, 0xf8u, 0x38u,
+    0x99u, 0x13u, 0x57u, 0xbbu, 0x91u, 0x08u, 0x1au, 0xddu, 0x1du, 0x40u, 0x71u, 0xb2u,
+    0x51u, 0x50u, 0xcau, 0x14u, 0x12u, 0x16u, 0x1eu, 0x06u, 0x45u, 0x53u, 0x7du, 0x72u,
+    0x15u, 0x96u, 0x13u, 0xdbu, 0xd8u, 0x2bu, 0xeeu, 0xadu, 0xbbu, 0x5cu, 0x5eu, 0x6fu,
+    0xccu, 0x48u, 0x58u, 0x84u, 0xc8u, 0x0du, 0x31u, 0x80u, 0x5au, 0xd6u, 0x7cu, 0x2cu,
+    0xccu, 0x22u, 0x4bu, 0x82u, 0xf3u, 0xd8u, 0x4au, 0x90u, 0x22u, 0x21u, 0xdfu, 0x47u,
+    0x0eu, 0xeau, 0x28u, 0xf5u, 0xaau, 0x6fu, 0xceu, 0x8cu, 0xb5u, 0x6fu, 0xebu, 0xecu,
+    0x52u, 0x1au, 0xdbu, 0xfcu, 0x18u, 0x51u, 0x4bu, 0xd1u, 0x69u, 0x7bu, 0x52u, 0xe3u,
+    0x76u, 0x44u, 0xe5u, 0xbfu, 0x7fu, 0xbau, 0xf2u, 0x47u, 0x57u, 0xebu, 0x0cu, 0xb0u,
+    0xfdu, 0x32u, 0xd2u, 0x5bu,
+};
+static const uint8_t bench_rsa_sig[SIGN_RSA_SIZE] = {
+    0xa3u, 0x19u, 0xa3u, 0x99u, 0x70u, 0x2cu, 0x27u, 0x69u, 0x03u, 0x31u, 0xabu, 0xdfu,
+    0xa5u, 0xf8u, 0x8bu, 0x28u, 0x4au, 0x17u, 0x2cu, 0x6au, 0x5du, 0xa4u, 0x79u, 0x6bu,
+    0xf9u, 0x0du, 0x66u, 0x53u, 0x65u, 0xefu, 0x8du, 0xffu, 0xe2u, 0xa7u, 0x70u, 0xd0u,
+    0xa2u, 0xa8u, 0xf8u, 0x42u, 0xadu, 0xceu, 0x92u, 0x36u, 0x41u, 0x90u, 0x4cu, 0xfau,
+    0x83u, 0xeeu, 0x7bu, 0x39u, 0x47u, 0x67u, 0x4fu, 0xa6u, 0x7eu, 0x55u, 0x49u, 0x8eu,
+    0x02u, 0xe8u, 0x2cu, 0x2du, 0x40u, 0x49u, 0xddu, 0xfbu, 0x5cu, 0x5cu, 0xd7u, 0xa8u,
+    0x83u, 0xeau, 0xacu, 0xd7u, 0x38u, 0x52u, 0x2fu, 0x9au, 0xb5u, 0x85u, 0xb8u, 0x7cu,
+    0x72u, 0x1bu, 0xc3u, 0x9cu, 0x1eu, 0x92u, 0x9du, 0x01u, 0xccu, 0xb2u, 0x7fu, 0x48u,
+    0x7du, 0x16u, 0x41u, 0x3cu, 0x26u, 0xe6u, 0xdcu, 0xcbu, 0x98u, 0x84u, 0x31u, 0x44u,
+    0xc2u, 0xb6u, 0x33u, 0xa5u, 0x76u, 0xacu, 0xc1u, 0x17u, 0x67u, 0x0cu, 0xc4u, 0xe0u,
+    0x8cu, 0x3du, 0xf8u, 0xe2u, 0xbbu, 0x1fu, 0x55u, 0x14u, 0x65u, 0x45u, 0x59u, 0x2eu,
+    0x97u, 0xbfu, 0x74u, 0x8eu, 0xd5u, 0xaeu, 0x9bu, 0xaeu, 0x95u, 0xf6u, 0x78u, 0x80u,
+    0x42u, 0x94u, 0x04u, 0x36u, 0x82u, 0xa3u, 0x54u, 0x87u, 0xb9u, 0xccu, 0xcbu, 0x7du,
+    0x56u, 0xc8u, 0xb3u, 0x38u, 0xa1u, 0x9cu, 0xa6u, 0xffu, 0xf2u, 0xa2u, 0x9eu, 0x80u,
+    0xd5u, 0x0cu, 0x70u, 0x8au, 0xd2u, 0x0du, 0x81u, 0x7bu, 0x29u, 0xc0u, 0xd4u, 0x2du,
+    0x6cu, 0x0bu, 0xbbu, 0x7fu, 0xc4u, 0xe1u, 0x68u, 0x44u, 0xefu, 0x5eu, 0xfdu, 0x4au,
+    0xb0u, 0x4eu, 0x81u, 0x8cu, 0x76u, 0xfau, 0xefu, 0x45u, 0x20u, 0x22u, 0xf8u, 0xfdu,
+    0x45u, 0xebu, 0x0au, 0x02u, 0x15u, 0xc7u, 0x44u, 0x82u, 0x8bu, 0x50u, 0x39u, 0x4bu,
+    0x59u, 0x88u, 0x17u, 0xf0u, 0x4du, 0x50u, 0x60u, 0x00u, 0x1fu, 0xddu, 0xfeu, 0x4fu,
+    0xe7u, 0xd9u, 0x6du, 0x87u, 0xc9u, 0xb4u, 0x4du, 0xeau, 0xe5u, 0x0fu, 0x80u, 0x38u,
+    0x2fu, 0x25u, 0x73u, 0x29u, 0xf8u, 0x87u, 0xb3u, 0x81u, 0xedu, 0x8cu, 0xceu, 0x6fu,
+    0x00u, 0xbfu, 0xc7u, 0xd8u,
+};
+
+/* keys/cypress-test-ec-p256.pem, as in boot_crypto_kat.c */
+static const uint8_t bench_p256_key[] = {
+    0x30u, 0x59u, 0x30u, 0x13u, 0x06u, 0x07u, 0x2au, 0x86u, 0x48u, 0xceu, 0x3du, 0x02u,
+    0x01u, 0x06u, 0x08u, 0x2au, 0x86u, 0x48u, 0xceu, 0x3du, 0x03u, 0x01u, 0x07u, 0x03u,
+    0x42u, 0x00u, 0x04u, 0x82u, 0x79u, 0x8fu, 0x11u, 0x17u, 0x8fu, 0x92u, 0xa7u, 0xb8u,
+    0x52u, 0x87u, 0xafu, 0x80u, 0x88u, 0x47u, 0x33u, 0xebu, 0x44u, 0x18u, 0x7cu, 0xf3u,
+    0xf5u, 0xefu, 0x9eu, 0xbfu, 0xdcu, 0x70u, 0xd9u, 0x81u, 0xf7u, 0xd8u, 0xe1u, 0xd0u,
+    0x40u, 0x2au, 0xcdu, 0xa9u, 0x89u, 0x97u, 0xa6u, 0x36u, 0x8cu, 0x5fu, 0x93u, 0x67u,
+    0xfeu, 0x55u, 0x85u, 0xe3u, 0x39u, 0xa2u, 0xdeu, 0xdfu, 0x97u, 0xafu, 0x6cu, 0x24u,
+    0xc9u, 0x74u, 0xffu, 0xeeu, 0x84u, 0x0eu, 0xfeu,
+};
+static const uint8_t bench_p256_sig[] = {
+    0x30u, 0x45u, 0x02u, 0x21u, 0x00u, 0xa7u, 0xddu, 0x1eu, 0xe0u, 0xd5u, 0x7fu, 0x26u,
+    0x1fu, 0x37u, 0x33u, 0x90u, 0x36u, 0x84u, 0x5eu, 0x35u, 0xdcu, 0xc2u, 0xc3u, 0x93u,
+    0x3fu, 0xe5u, 0xe2u, 0xd4u, 0x0au, 0xbbu, 0x1bu, 0xa3u, 0xb4u, 0x4bu, 0x5bu, 0x3cu,
+    0xacu, 0x02u, 0x20u, 0x1fu, 0xc4u, 0xceu, 0xdbu, 0xd7u, 0x44u, 0x48u, 0x7au, 0x14u,
+    0xb8u, 0x6bu, 0xbeu, 0xc4u, 0xa4u, 0x11u, 0x62u, 0x81u, 0xd9u, 0x99u, 0x56u, 0xdau,
+    0x19u, 0x25u, 0xe2u, 0xf5u, 0x00u, 0xa9u, 0xb8u, 0x78u, 0x1au, 0x01u, 0xb4u,
+};
+
+/* keys/cypress-test-ed25519.pem, as in boot_crypto_kat.c */
+static const uint8_t bench_ed25519_key[] = {
+    0x30u, 0x2au, 0x30u, 0x05u, 0x06u, 0x03u, 0x2bu, 0x65u, 0x70u, 0x03u, 0x21u, 0x00u,
+    0x74u, 0x63u, 0x0eu, 0x0cu, 0xabu, 0x8cu, 0xf4u, 0x90u, 0xbau, 0xf1u, 0x64u, 0x79u,
+    0x7cu, 0x92u, 0xefu, 0x3cu, 0x99u, 0x83u, 0x0cu, 0xcfu, 0xaau, 0x7eu, 0xdeu, 0xbeu,
+    0x9du, 0x83u, 0x0fu, 0xfau, 0xa8u, 0x43u, 0x72u, 0x2cu,
+};
+static const uint8_t bench_ed25519_sig[BOOT_CRYPTO_ED25519_SIG_SIZE] = {
+    0x92u, 0x9bu, 0x2du, 0x39u, 0x3eu, 0xaau, 0x75u, 0x89u, 0x3fu, 0x20u, 0xfbu, 0x9bu,
+    0x18u, 0x43u, 0x71u, 0xefu, 0x63u, 0xfeu, 0x61u, 0x85u, 0x3au, 0x4du, 0x99u, 0x3du,
+    0xc8u, 0x67u, 0x41u, 0xd4u, 0xa4u, 0xaeu, 0x8du, 0xa9u, 0xf0u, 0x76u, 0x78u, 0xd4u,
+    0x37u, 0x4eu, 0x6eu, 0x78u, 0x99u, 0xf2u, 0xdeu, 0xa2u, 0xcbu, 0x34u, 0xf8u, 0x6du,
+    0xf0u, 0x21u, 0xb7u, 0x74u, 0xdeu, 0x68u, 0x78u, 0x91u, 0x77u, 0xcdu, 0xd9u, 0x8cu,
+    0x3bu, 0xa4u, 0xd2u, 0x06u,
+};
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name) {
+    printf("Usage: %s [options]\n"
+           "  --min-ms N          minimum duration of each measurement (default %u)\n"
+           "  --target-p256-ms N  P-256 verification time on the target, scales the\n"
+           "                      modelled target column (default %u)\n"
+           "  --objdir DIR        objects of the verifiers, for the code size\n"
+           "                      (default: obj next to this program)\n"
+           "  --json              machine-readable output\n"
+           "The exit code is 1 if a signature does not verify.\n",
+           name, BENCH_DEFAULT_MIN_MS, BENCH_DEFAULT_TARGET_P256_MS);
+}
+
+/*******************************************************************************
+ * Function Name: verify_rsa
+ *******************************************************************************/
+static bool verify_rsa(void) {
+    return sign_rsa_verify(bench_rsa_n, bench_hash, bench_rsa_sig);
+}
+
+/*******************************************************************************
+ * Function Name: verify_p256
+ *******************************************************************************/
+static bool verify_p256(void) {
+    return boot_crypto_p256_verify_der(bench_p256_key, sizeof(bench_p256_key), bench_hash, bench_p256_sig,
+                                       sizeof(bench_p256_sig));
+}
+
+/*******************************************************************************
+ * Function Name: verify_ed25519
+ *******************************************************************************/
+static bool verify_ed25519(void) {
+    return boot_crypto_ed25519_verify_der(bench_ed25519_key, sizeof(bench_ed25519_key), bench_hash,
+                                          bench_ed25519_sig, sizeof(bench_ed25519_sig));
+}
+
+/*******************************************************************************
+ * Function Name: bench_verify
+ ********************************************************************************
+ * Verifies a signature again and again for at least min_ms.
+ *
+ * Return:
+ *  Verifications per second, 0 if the signature does not verify.
+ *******************************************************************************/
+static double bench_verify(bool (*verify)(void), uint32_t min_ms) {
+    uint64_t start = sim_time_us();
+    uint64_t elapsed;
+    uint32_t count = 0u;
+
+    do {
+        if (!verify()) {
+            return 0.0;
+        }
+        count++;
+        elapsed = sim_time_us() - start;
+    } while (elapsed < (uint64_t)min_ms * 1000u);
+    return (double)count * 1e6 / (double)elapsed;
+}
+
+/*******************************************************************************
+ * Function Name: get_le
+ ********************************************************************************
+ * Reads a little endian field of an ELF file.
+ *******************************************************************************/
+static uint64_t get_le(const uint8_t *p, uint32_t size) {
+    uint64_t value = 0u;
+
+    for (uint32_t i = size; i-- > 0u;) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+/*******************************************************************************
+ * Function Name: object_size
+ ********************************************************************************
+ * Adds up the sections of a little endian ELF object, 32 or 64 bits, so the
+ * objects of a target build can be given with --objdir as well.
+ *
+ * Parameters:
+ *  path           Object file.
+ *  code           Receives the bytes of the executable sections.
+ *  rodata         Receives the bytes of the other read-only sections.
+ *
+ * Return:
+ *  0 on success, -1 if the file is not a little endian ELF object.
+ *******************************************************************************/
+static int object_size(const char *path, long *code, long *rodata) {
+    FILE *file = fopen(path, "rb");
+    uint8_t *elf = NULL;
+    long size;
+    int rc = -1;
+
+    *code = 0;
+    *rodata = 0;
+    if (file == NULL) {
+        return -1;
+    }
+    if ((fseek(file, 0, SEEK_END) == 0) && ((size = ftell(file)) > 0x40) && (fseek(file, 0, SEEK_SET) == 0) &&
+        ((elf = malloc((size_t)size)) != NULL) && (fread(elf, 1u, (size_t)size, file) == (size_t)size) &&
+        (memcmp(elf, "\177ELF", 4u) == 0) && (elf[5] == 1u)) {
+        bool is64 = (elf[4] == 2u);
+        uint64_t shoff = is64 ? get_le(&elf[0x28], 8u) : get_le(&elf[0x20], 4u);
+        uint32_t shentsize = (uint32_t)get_le(&elf[is64 ? 0x3a : 0x2e], 2u);
+        uint32_t shnum = (uint32_t)get_le(&elf[is64 ? 0x3c : 0x30], 2u);
+
+        if (shoff + (uint64_t)shentsize * shnum <= (uint64_t)size) {
+            for (uint32_t i = 0u; i < shnum; i++) {
+                const uint8_t *sh = &elf[shoff + (uint64_t)shentsize * i];
+                uint32_t type = (uint32_t)get_le(&sh[4], 4u);
+                uint64_t flags = is64 ? get_le(&sh[8], 8u) : get_le(&sh[8], 4u);
+                long bytes = (long)(is64 ? get_le(&sh[32], 8u) : get_le(&sh[20], 4u));
+
+                if ((flags & BENCH_SHF_EXECINSTR) != 0u) {
+                    *code += bytes;
+                } else if (((flags & (BENCH_SHF_ALLOC | BENCH_SHF_WRITE)) == BENCH_SHF_ALLOC) &&
+                           (type != BENCH_SHT_NOBITS)) {
+                    *rodata += bytes;
+                }
+            }
+            rc = 0;
+        }
+    }
+    free(elf);
+    fclose(file);
+    return rc;
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Measures and prints the signature types.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "min-ms",         required_argument, NULL, 'm' },
+        { "target-p256-ms", required_argument, NULL, 't' },
+        { "objdir",         required_argument, NULL, 'o' },
+        { "json",           no_argument,       NULL, 'j' },
+        { "help",           no_argument,       NULL, 'h' },
+        { NULL,             0,                 NULL, 0 },
+    };
+    bench_sign_t signs[] = {
+        { "RSA-2048", "sign_rsa.o", sizeof(bench_rsa_key), sizeof(bench_rsa_sig), verify_rsa, 0.0, -1, -1 },
+        { "EC P-256", "boot_p256.o", sizeof(bench_p256_key), sizeof(bench_p256_sig), verify_p256, 0.0, -1, -1 },
+        { "Ed25519", "boot_ed25519.o", sizeof(bench_ed25519_key), sizeof(bench_ed25519_sig), verify_ed25519, 0.0,
+          -1, -1 },
+    };
+    bench_options_t opts = {
+        .min_ms = BENCH_DEFAULT_MIN_MS,
+        .target_p256_ms = BENCH_DEFAULT_TARGET_P256_MS,
+        .objdir = NULL,
+        .json = 0,
+    };
+    char objdir[BENCH_PATH_MAX];
+    char path[2u * BENCH_PATH_MAX];
+    double p256_per_s;
+    uint32_t failed = 0u;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'm':
+            opts.min_ms = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            opts.target_p256_ms = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'o':
+            opts.objdir = optarg;
+            break;
+        case 'j':
+            opts.json = 1;
+            break;
+        case 'h':
+            usage(argv[0]);
+            return 0;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (opts.objdir == NULL) {
+        snprintf(path, sizeof(path), "%s", argv[0]);
+        snprintf(objdir, sizeof(objdir), "%s/obj", dirname(path));
+        opts.objdir = objdir;
+    }
+
+    for (uint32_t i = 0u; i < sizeof(signs) / sizeof(signs[0]); i++) {
+        bench_sign_t *sign = &signs[i];
+
+        sign->verifies_per_s = bench_verify(sign->verify, opts.min_ms);
+        if (sign->verifies_per_s == 0.0) {
+            fprintf(stderr, "The %s signature does not verify\n", sign->name);
+            failed++;
+        }
+        snprintf(path, sizeof(path), "%s/%s", opts.objdir, sign->object);
+        if (object_size(path, &sign->code, &sign->rodata) != 0) {
+            sign->code = -1;
+            sign->rodata = -1;
+        }
+    }
+    p256_per_s = signs[1].verifies_per_s;
+
+    if (opts.json) {
+        printf("{\"signatures\": [");
+        for (uint32_t i = 0u; i < sizeof(signs) / sizeof(signs[0]); i++) {
+            printf("%s{\"name\": \"%s\", \"key_bytes\": %u, \"sig_bytes\": %u, \"verifies_per_s\": %.1f, "
+                   "\"code_bytes\": %ld, \"rodata_bytes\": %ld}", (i == 0u) ? "" : ", ", signs[i].name,
+                   signs[i].key_size, signs[i].sig_size, signs[i].verifies_per_s, signs[i].code, signs[i].rodata);
+        }
+        printf("]}\n");
+    } else {
+        printf("Signature  Key B  Sig B  Verify ms  Verifies/s  Target ms  Code B  Const B\n");
+        for (uint32_t i = 0u; i < sizeof(signs) / sizeof(signs[0]); i++) {
+            const bench_sign_t *sign = &signs[i];
+            double ms = (sign->verifies_per_s > 0.0) ? 1000.0 / sign->verifies_per_s : 0.0;
+            double target = ((sign->verifies_per_s > 0.0) && (p256_per_s > 0.0)) ?
+                            opts.target_p256_ms * p256_per_s / sign->verifies_per_s : 0.0;
+
+            printf("%-9s  %5u  %5u  %9.3f  %10.1f  %9.1f  %6ld  %7ld\n", sign->name, sign->key_size,
+                   sign->sig_size, ms, sign->verifies_per_s, target, sign->code, sign->rodata);
+        }
+        printf("Target ms scales the host times to a %u ms P-256 verification on the CM0+.\n"
+               "Code and const sizes are the sections of the objects in %s, SHA-256 excluded.\n",
+               opts.target_p256_ms, opts.objdir);
+    }
+    return (failed == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
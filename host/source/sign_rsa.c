@@ -0,0 +1,266 @@
+/******************************************************************************
+ * File Name:   sign_rsa.c
+ *
+ * Description: This file contains an RSA-2048 verification of the signature benchmark: RSASSA-PSS
+ *              with SHA-256, MGF1 and a 32-byte salt, e = 65537, as MCUboot verifies RSA signed
+ *              images. Montgomery arithmetic in 32-bit words, like boot_p256.c.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "dfu_sha256.h"
+#include "sign_rsa.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define RSA_WORDS                   (SIGN_RSA_SIZE / 4u)
+#define RSA_HASH_SIZE               (32u)
+#define RSA_SALT_SIZE               (32u)
+/* The encoded message is one byte of 0x00 top bit, then DB, H and 0xbc */
+#define RSA_DB_SIZE                 (SIGN_RSA_SIZE - RSA_HASH_SIZE - 1u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef uint32_t rsa_int_t[RSA_WORDS];
+
+/*******************************************************************************
+ * Function Name: rsa_from_bytes
+ ********************************************************************************
+ * Reads a big endian number.
+ *******************************************************************************/
+static void rsa_from_bytes(rsa_int_t r, const uint8_t *bytes) {
+    for (uint32_t i = 0u; i < RSA_WORDS; i++) {
+        const uint8_t *p = &bytes[SIGN_RSA_SIZE - 4u * (i + 1u)];
+
+        r[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+    }
+}
+
+/*******************************************************************************
+ * Function Name: rsa_cmp
+ ********************************************************************************
+ * Return:
+ *  -1, 0 or 1 as a is less than, equal to or greater than b.
+ *******************************************************************************/
+static int rsa_cmp(const rsa_int_t a, const rsa_int_t b) {
+    for (uint32_t i = RSA_WORDS; i-- > 0u;) {
+        if (a[i] != b[i]) {
+            return (a[i] < b[i]) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: rsa_sub
+ ********************************************************************************
+ * r = a - b, the borrow dropped.
+ *******************************************************************************/
+static void rsa_sub(rsa_int_t r, const rsa_int_t a, const rsa_int_t b) {
+    int64_t c = 0;
+
+    for (uint32_t i = 0u; i < RSA_WORDS; i++) {
+        c += (int64_t)a[i] - b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: rsa_mont_mul
+ ********************************************************************************
+ * r = a * b / 2^2048 mod n, a and b less than n.
+ *******************************************************************************/
+static void rsa_mont_mul(rsa_int_t r, const rsa_int_t a, const rsa_int_t b, const rsa_int_t n, uint32_t n0inv) {
+    uint32_t t[RSA_WORDS + 2u] = { 0u };
+
+    for (uint32_t i = 0u; i < RSA_WORDS; i++) {
+        uint64_t c = 0u;
+        uint32_t q;
+
+        for (uint32_t j = 0u; j < RSA_WORDS; j++) {
+            c += (uint64_t)t[j] + (uint64_t)a[j] * b[i];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[RSA_WORDS];
+        t[RSA_WORDS] = (uint32_t)c;
+        t[RSA_WORDS + 1u] = (uint32_t)(c >> 32);
+
+        q = t[0] * n0inv;
+        c = ((uint64_t)t[0] + (uint64_t)q * n[0]) >> 32;
+        for (uint32_t j = 1u; j < RSA_WORDS; j++) {
+            c += (uint64_t)t[j] + (uint64_t)q * n[j];
+            t[j - 1u] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[RSA_WORDS];
+        t[RSA_WORDS - 1u] = (uint32_t)c;
+        t[RSA_WORDS] = t[RSA_WORDS + 1u] + (uint32_t)(c >> 32);
+    }
+
+    if ((t[RSA_WORDS] != 0u) || (rsa_cmp(t, n) >= 0)) {
+        rsa_sub(t, t, n);
+    }
+    memcpy(r, t, sizeof(rsa_int_t));
+}
+
+/*******************************************************************************
+ * Function Name: rsa_mgf1
+ ********************************************************************************
+ * XORs MGF1-SHA-256 of the seed into the data.
+ *******************************************************************************/
+static void rsa_mgf1(uint8_t *data, uint32_t length, const uint8_t seed[RSA_HASH_SIZE]) {
+    uint8_t mask[RSA_HASH_SIZE];
+    dfu_sha256_t ctx;
+
+    for (uint32_t counter = 0u, off = 0u; off < length; counter++) {
+        uint8_t c[4] = { (uint8_t)(counter >> 24), (uint8_t)(counter >> 16), (uint8_t)(counter >> 8),
+                         (uint8_t)counter };
+
+        dfu_sha256_init(&ctx);
+        dfu_sha256_update(&ctx, seed, RSA_HASH_SIZE);
+        dfu_sha256_update(&ctx, c, sizeof(c));
+        dfu_sha256_final(&ctx, mask);
+        for (uint32_t i = 0u; (i < RSA_HASH_SIZE) && (off < length); i++, off++) {
+            data[off] ^= mask[i];
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sign_rsa_verify
+ ********************************************************************************
+ * Verifies an RSA-2048 PSS signature: computes sig^65537 mod n with 16
+ * Montgomery squarings and one multiplication, R^2 mod n included, then
+ * checks the PSS encoding of the hash.
+ *
+ * Parameters:
+ *  n              Modulus, big endian.
+ *  hash           SHA-256 of the message.
+ *  sig            Signature, big endian.
+ *
+ * Return:
+ *  true if the signature is valid.
+ *******************************************************************************/
+bool sign_rsa_verify(const uint8_t n[SIGN_RSA_SIZE], const uint8_t hash[32], const uint8_t sig[SIGN_RSA_SIZE]) {
+    static const uint8_t zeros[8] = { 0u };
+    rsa_int_t m;
+    rsa_int_t s;
+    rsa_int_t x;
+    rsa_int_t rr;
+    uint8_t em[SIGN_RSA_SIZE];
+    uint8_t h[RSA_HASH_SIZE];
+    dfu_sha256_t ctx;
+    uint32_t n0inv = 1u;
+
+    rsa_from_bytes(m, n);
+    rsa_from_bytes(s, sig);
+    if (((m[0] & 1u) == 0u) || (rsa_cmp(s, m) >= 0)) {
+        return false;
+    }
+
+    /* -n^-1 mod 2^32 by Newton iterations */
+    for (uint32_t i = 0u; i < 5u; i++) {
+        n0inv *= 2u - m[0] * n0inv;
+    }
+    n0inv = 0u - n0inv;
+
+    /* rr = 2^4096 mod n, by doubling 2^2047 */
+    memset(rr, 0, sizeof(rr));
+    rr[RSA_WORDS - 1u] = 0x80000000u;
+    if (rsa_cmp(rr, m) >= 0) {
+        rsa_sub(rr, rr, m);
+    }
+    for (uint32_t i = 0u; i < 2049u; i++) {
+        uint32_t carry = rr[RSA_WORDS - 1u] >> 31;
+
+        for (uint32_t j = RSA_WORDS - 1u; j > 0u; j--) {
+            rr[j] = (rr[j] << 1) | (rr[j - 1u] >> 31);
+        }
+        rr[0] <<= 1;
+        if ((carry != 0u) || (rsa_cmp(rr, m) >= 0)) {
+            rsa_sub(rr, rr, m);
+        }
+    }
+
+    /* x = s^65537 */
+    rsa_mont_mul(x, s, rr, m, n0inv);
+    memcpy(rr, x, sizeof(rr));
+    for (uint32_t i = 0u; i < 16u; i++) {
+        rsa_mont_mul(x, x, x, m, n0inv);
+    }
+    rsa_mont_mul(x, x, rr, m, n0inv);
+    memset(rr, 0, sizeof(rr));
+    rr[0] = 1u;
+    rsa_mont_mul(x, x, rr, m, n0inv);
+
+    for (uint32_t i = 0u; i < RSA_WORDS; i++) {
+        uint32_t w = x[RSA_WORDS - 1u - i];
+
+        em[4u * i] = (uint8_t)(w >> 24);
+        em[4u * i + 1u] = (uint8_t)(w >> 16);
+        em[4u * i + 2u] = (uint8_t)(w >> 8);
+        em[4u * i + 3u] = (uint8_t)w;
+    }
+
+    /* EM = maskedDB || H || 0xbc, DB = 0x00 ... 0x01 || salt */
+    if ((em[SIGN_RSA_SIZE - 1u] != 0xbcu) || ((em[0] & 0x80u) != 0u)) {
+        return false;
+    }
+    rsa_mgf1(em, RSA_DB_SIZE, &em[RSA_DB_SIZE]);
+    em[0] &= 0x7fu;
+    for (uint32_t i = 0u; i < RSA_DB_SIZE - RSA_SALT_SIZE - 1u; i++) {
+        if (em[i] != 0u) {
+            return false;
+        }
+    }
+    if (em[RSA_DB_SIZE - RSA_SALT_SIZE - 1u] != 0x01u) {
+        return false;
+    }
+
+    /* H = SHA-256(0^8 || hash || salt) */
+    dfu_sha256_init(&ctx);
+    dfu_sha256_update(&ctx, zeros, sizeof(zeros));
+    dfu_sha256_update(&ctx, hash, RSA_HASH_SIZE);
+    dfu_sha256_update(&ctx, &em[RSA_DB_SIZE - RSA_SALT_SIZE], RSA_SALT_SIZE);
+    dfu_sha256_final(&ctx, h);
+    return memcmp(h, &em[RSA_DB_SIZE], RSA_HASH_SIZE) == 0;
+}
+
+/* [] END OF FILE */
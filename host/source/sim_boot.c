@@ -0,0 +1,110 @@
+/******************************************************************************
+ * File Name:   sim_boot.c
+ *
+ * Description: Model of the validation of the secondary slot by the edge protect
+ *              bootloader after the DFU application hands the control over. Stands in
+ *              for boot_image_check_hook() and the regular MCUboot hash of the slot; the
+ *              signature check, which both take, is not modelled.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "dfu_digest.h"
+#include "dfu_image.h"
+#include "dfu_packet.h"
+#include "dfu_sha256.h"
+#include "sim_boot.h"
+#include "sim_flash.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Function Name: sim_boot_get_u16
+ ********************************************************************************
+ * Reads a little endian 16-bit value.
+ *******************************************************************************/
+static uint32_t sim_boot_get_u16(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+/*******************************************************************************
+ * Function Name: sim_boot_validate
+ ********************************************************************************
+ * Validates the image in a secondary slot as the bootloader does before an
+ * upgrade.
+ *
+ * Parameters:
+ *  image          Index of the image.
+ *  result         Receives the result.
+ *******************************************************************************/
+void sim_boot_validate(uint32_t image, sim_boot_result_t *result) {
+    const dfu_image_t *slots = dfu_image_get(image);
+    const uint8_t *p = (slots != NULL) ? sim_flash_ptr(slots->secondary, slots->size) : NULL;
+    uint64_t start = sim_time_us();
+    uint8_t digest[DFU_SHA256_SIZE];
+    dfu_sha256_t ctx;
+    uint32_t extent;
+    uint32_t tlv_size;
+
+    memset(result, 0, sizeof(*result));
+    if ((p == NULL) || (dfu_packet_get_u32(p) != DFU_DIGEST_IMAGE_MAGIC)) {
+        return;
+    }
+    extent = sim_boot_get_u16(&p[8]) + sim_boot_get_u16(&p[10]) + dfu_packet_get_u32(&p[12]);
+    if ((extent + 4u > slots->size) ||
+        (sim_boot_get_u16(&p[extent]) != DFU_DIGEST_TLV_INFO_MAGIC)) {
+        return;
+    }
+    tlv_size = sim_boot_get_u16(&p[extent + 2u]);
+
+    dfu_sha256_init(&ctx);
+    dfu_sha256_update(&ctx, p, extent);
+    dfu_sha256_final(&ctx, digest);
+    result->hashed = extent;
+
+    for (uint32_t off = 4u; (off + 4u <= tlv_size) && (extent + tlv_size <= slots->size);) {
+        const uint8_t *tlv = &p[extent + off];
+        uint32_t length = sim_boot_get_u16(&tlv[2]);
+
+        if ((sim_boot_get_u16(tlv) == DFU_DIGEST_TLV_SHA256) && (length == DFU_SHA256_SIZE)) {
+            result->valid = (memcmp(&tlv[4], digest, DFU_SHA256_SIZE) == 0);
+            break;
+        }
+        off += 4u + length;
+    }
+    result->time_us = sim_time_us() - start;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,227 @@
+/******************************************************************************
+ * File Name:   sim_device.c
+ *
+ * Description: Simulated DFU device: runs the DFU application session loop of
+ *              dfu_cm7 in a thread on top of the simulated transport and flash.
+ *              The handover to the bootloader ends the thread instead of a reset.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "cy_dfu.h"
+#include "dfu_digest.h"
+#include "dfu_flash.h"
+#include "dfu_session.h"
+#include "dfu_window.h"
+#include "sim_device.h"
+#include "sim_link.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Longest sleep of the event-driven device before it checks for a stop */
+#define DEVICE_STOP_POLL_MS         (10u)
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static pthread_t device_thread;
+static atomic_bool device_stop;
+static atomic_bool device_handover;
+static sim_device_stats_t device_stats;
+static sim_device_config_t device_config;
+
+/*******************************************************************************
+ * Function Name: device_led_toggle
+ ********************************************************************************
+ * Counts LED toggles.
+ *******************************************************************************/
+static void device_led_toggle(void) {
+    device_stats.led_toggles++;
+}
+
+/*******************************************************************************
+ * Function Name: device_delay_ms
+ ********************************************************************************
+ * Blocking delay.
+ *******************************************************************************/
+static void device_delay_ms(uint32_t milliseconds) {
+    sim_sleep_us((uint64_t)milliseconds * 1000u);
+}
+
+/*******************************************************************************
+ * Function Name: device_reset
+ ********************************************************************************
+ * Stands in for the soft reset into the bootloader.
+ *******************************************************************************/
+static void device_reset(void) {
+    device_stats.handovers++;
+    atomic_store(&device_handover, true);
+}
+
+/*******************************************************************************
+ * Function Name: device_get_tick_ms
+ ********************************************************************************
+ * Millisecond tick of the event-driven session.
+ *******************************************************************************/
+static uint32_t device_get_tick_ms(void) {
+    return (uint32_t)(sim_time_us() / 1000u);
+}
+
+/*******************************************************************************
+ * Function Name: device_wait_event
+ ********************************************************************************
+ * Sleeps until the link receives a packet. Wakes up every
+ * DEVICE_STOP_POLL_MS to notice sim_device_stop(), as a reset would.
+ *******************************************************************************/
+static bool device_wait_event(uint32_t timeout_ms) {
+    while (timeout_ms > DEVICE_STOP_POLL_MS) {
+        if (atomic_load(&device_stop)) {
+            return false;
+        }
+        if (sim_link_device_wait(DEVICE_STOP_POLL_MS)) {
+            return true;
+        }
+        timeout_ms -= DEVICE_STOP_POLL_MS;
+    }
+    return sim_link_device_wait(timeout_ms);
+}
+
+static const dfu_session_ops_t device_polled_ops = {
+    .led_toggle = device_led_toggle,
+    .delay_ms = device_delay_ms,
+    .reset = device_reset,
+};
+
+static const dfu_session_ops_t device_event_ops = {
+    .led_toggle = device_led_toggle,
+    .delay_ms = device_delay_ms,
+    .reset = device_reset,
+    .get_tick_ms = device_get_tick_ms,
+    .wait_event = device_wait_event,
+};
+
+/*******************************************************************************
+ * Function Name: device_main
+ ********************************************************************************
+ * Body of main() of the DFU application after the board initialization.
+ *******************************************************************************/
+static void *device_main(void *arg) {
+    static uint8_t buffer[CY_DFU_SIZEOF_DATA_BUFFER];
+    static uint8_t packet[CY_DFU_SIZEOF_CMD_BUFFER];
+    static cy_stc_dfu_params_t dfu_params;
+    static dfu_session_t session;
+
+    (void)arg;
+    memset(&dfu_params, 0, sizeof(dfu_params));
+    dfu_params.timeout = DFU_SESSION_TIMEOUT_MS;
+    dfu_params.dataBuffer = &buffer[0];
+    dfu_params.packetBuffer = &packet[0];
+
+    dfu_flash_init();
+    dfu_digest_init(device_config.digest);
+    dfu_window_init(device_config.window_size);
+    if (dfu_session_init(&session, &dfu_params,
+                         device_config.event_driven ? &device_event_ops : &device_polled_ops) != CY_DFU_SUCCESS) {
+        return NULL;
+    }
+    Cy_DFU_TransportStart(CY_DFU_USER);
+
+    while (!atomic_load(&device_stop) && !atomic_load(&device_handover)) {
+        dfu_session_step(&session);
+        device_stats.steps++;
+    }
+
+    Cy_DFU_TransportStop();
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function Name: sim_device_start
+ ********************************************************************************
+ * Starts the device thread. The link and the flash model must be set up.
+ *
+ * Parameters:
+ *  config         Device configuration.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int sim_device_start(const sim_device_config_t *config) {
+    device_config = *config;
+    memset(&device_stats, 0, sizeof(device_stats));
+    atomic_store(&device_stop, false);
+    atomic_store(&device_handover, false);
+    return (pthread_create(&device_thread, NULL, device_main, NULL) == 0) ? 0 : -1;
+}
+
+/*******************************************************************************
+ * Function Name: sim_device_wait_handover
+ ********************************************************************************
+ * Waits until the device hands the control over to the bootloader.
+ *
+ * Return:
+ *  true if the handover happened within the timeout.
+ *******************************************************************************/
+bool sim_device_wait_handover(uint32_t timeout_ms) {
+    uint64_t deadline = sim_time_us() + ((uint64_t)timeout_ms * 1000u);
+
+    while (!atomic_load(&device_handover)) {
+        if (sim_time_us() >= deadline) {
+            return false;
+        }
+        sim_sleep_us(100u);
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: sim_device_stop
+ ********************************************************************************
+ * Stops the device thread and returns its counters.
+ *******************************************************************************/
+void sim_device_stop(sim_device_stats_t *stats) {
+    atomic_store(&device_stop, true);
+    pthread_join(device_thread, NULL);
+    if (stats != NULL) {
+        *stats = device_stats;
+    }
+}
+
+/* [] END OF FILE */
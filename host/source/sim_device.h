@@ -0,0 +1,78 @@
+/******************************************************************************
+ * File Name:   sim_device.h
+ *
+ * Description: Simulated DFU device: runs the DFU application session loop of
+ *              dfu_cm7 in a thread on top of the simulated transport and flash.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef SIM_DEVICE_H
+#define SIM_DEVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    /* Run the session event-driven: sleep until the link receives a packet */
+    bool event_driven;
+    /* Window size of the DFU transport, 0 for stop-and-wait */
+    uint32_t window_size;
+    /* Hash the upgrade image while it is written, see dfu_digest_init() */
+    bool digest;
+} sim_device_config_t;
+
+typedef struct {
+    /* Number of times the session handed the control over to the bootloader */
+    uint32_t handovers;
+    /* Number of session loop iterations */
+    uint64_t steps;
+    /* Number of LED toggles */
+    uint32_t led_toggles;
+} sim_device_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+int sim_device_start(const sim_device_config_t *config);
+bool sim_device_wait_handover(uint32_t timeout_ms);
+void sim_device_stop(sim_device_stats_t *stats);
+
+#endif /* SIM_DEVICE_H */
+
+/* [] END OF FILE */
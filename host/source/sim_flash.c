@@ -0,0 +1,286 @@
+/******************************************************************************
+ * File Name:   sim_flash.c
+ *
+ * Description: RAM-backed model of the XMC7200 code and work flash used by the
+ *              host simulator. Program operations follow the NOR rules of the
+ *              device: the destination must be erased before it is programmed.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "sim_flash.h"
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t address;
+    uint32_t size;
+    uint32_t erase_size;
+    /* Size of a program operation */
+    uint32_t row_size;
+    uint8_t *mem;
+} sim_flash_region_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+/* INTERNAL_FLASH_CODE_LARGE, INTERNAL_FLASH_CODE_SMALL,
+ * INTERNAL_FLASH_WORK_LARGE, INTERNAL_FLASH_WORK_SMALL */
+static sim_flash_region_t regions[] = {
+    { 0x10000000u, 0x7F0000u, 0x8000u, 0x200u, NULL },
+    { 0x107F0000u, 0x40000u,  0x2000u, 0x200u, NULL },
+    { 0x14000000u, 0x30000u,  0x800u,  0x20u,  NULL },
+    { 0x14030000u, 0x10000u,  0x80u,   0x20u,  NULL },
+};
+
+static sim_flash_stats_t flash_stats;
+
+/*******************************************************************************
+ * Function Name: find_region
+ ********************************************************************************
+ * Returns the region that fully contains the given range, or NULL.
+ *******************************************************************************/
+static sim_flash_region_t *find_region(uint32_t address, uint32_t length) {
+    for (size_t i = 0; i < sizeof(regions) / sizeof(regions[0]); i++) {
+        sim_flash_region_t *region = &regions[i];
+
+        if ((address >= region->address) &&
+            ((uint64_t)address + length <= (uint64_t)region->address + region->size)) {
+            return region;
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_init
+ ********************************************************************************
+ * Allocates the flash model, all regions start erased.
+ *
+ * Return:
+ *  0 on success, -1 on allocation failure.
+ *******************************************************************************/
+int sim_flash_init(void) {
+    for (size_t i = 0; i < sizeof(regions) / sizeof(regions[0]); i++) {
+        if (regions[i].mem == NULL) {
+            regions[i].mem = malloc(regions[i].size);
+            if (regions[i].mem == NULL) {
+                return -1;
+            }
+        }
+        memset(regions[i].mem, SIM_FLASH_ERASED_VALUE, regions[i].size);
+    }
+    sim_flash_stats_reset();
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_deinit
+ ********************************************************************************
+ * Releases the flash model.
+ *******************************************************************************/
+void sim_flash_deinit(void) {
+    for (size_t i = 0; i < sizeof(regions) / sizeof(regions[0]); i++) {
+        free(regions[i].mem);
+        regions[i].mem = NULL;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_ptr
+ ********************************************************************************
+ * Returns a pointer for memory-mapped reads of the given range, or NULL if
+ * the range is not inside one flash region.
+ *******************************************************************************/
+const uint8_t *sim_flash_ptr(uint32_t address, uint32_t length) {
+    sim_flash_region_t *region = find_region(address, length);
+
+    return (region != NULL) ? &region->mem[address - region->address] : NULL;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_erase_size
+ ********************************************************************************
+ * Returns the erase sector size at the given address, 0 if not flash.
+ *******************************************************************************/
+uint32_t sim_flash_erase_size(uint32_t address) {
+    sim_flash_region_t *region = find_region(address, 1u);
+
+    return (region != NULL) ? region->erase_size : 0u;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_row_size
+ ********************************************************************************
+ * Returns the size of a program operation at the given address, 0 if not
+ * flash: a 512-byte row in the code flash, 32 bytes in the work flash.
+ *******************************************************************************/
+uint32_t sim_flash_row_size(uint32_t address) {
+    sim_flash_region_t *region = find_region(address, 1u);
+
+    return (region != NULL) ? region->row_size : 0u;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_erase
+ ********************************************************************************
+ * Erases the sector that contains the given address.
+ *
+ * Return:
+ *  0 on success, -1 if the address is not flash.
+ *******************************************************************************/
+int sim_flash_erase(uint32_t address) {
+    sim_flash_region_t *region = find_region(address, 1u);
+    uint32_t offset;
+
+    if (region == NULL) {
+        return -1;
+    }
+    offset = (address - region->address) & ~(region->erase_size - 1u);
+    memset(&region->mem[offset], SIM_FLASH_ERASED_VALUE, region->erase_size);
+
+    flash_stats.erase_count++;
+    flash_stats.bytes_erased += region->erase_size;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_program
+ ********************************************************************************
+ * Programs the given range. The destination must be erased.
+ *
+ * Return:
+ *  0 on success, -1 on an address error or a program over non-erased data.
+ *******************************************************************************/
+int sim_flash_program(uint32_t address, const uint8_t *data, uint32_t length) {
+    sim_flash_region_t *region = find_region(address, length);
+    uint8_t *dst;
+
+    if (region == NULL) {
+        flash_stats.program_errors++;
+        return -1;
+    }
+    dst = &region->mem[address - region->address];
+    for (uint32_t i = 0; i < length; i++) {
+        if (dst[i] != SIM_FLASH_ERASED_VALUE) {
+            flash_stats.program_errors++;
+            return -1;
+        }
+    }
+    memcpy(dst, data, length);
+
+    flash_stats.program_count++;
+    flash_stats.bytes_programmed += length;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_read
+ ********************************************************************************
+ * Copies the given range out of the flash model.
+ *
+ * Return:
+ *  0 on success, -1 if the range is not flash.
+ *******************************************************************************/
+int sim_flash_read(uint32_t address, uint8_t *data, uint32_t length) {
+    const uint8_t *src = sim_flash_ptr(address, length);
+
+    if (src == NULL) {
+        return -1;
+    }
+    memcpy(data, src, length);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_load
+ ********************************************************************************
+ * Places data into the flash model without counting it as an operation,
+ * as a programmer would do before the test starts.
+ *
+ * Return:
+ *  0 on success, -1 if the range is not flash.
+ *******************************************************************************/
+int sim_flash_load(uint32_t address, const uint8_t *data, uint32_t length) {
+    sim_flash_region_t *region = find_region(address, length);
+
+    if (region == NULL) {
+        return -1;
+    }
+    memcpy(&region->mem[address - region->address], data, length);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_is_erased
+ ********************************************************************************
+ * Returns true if every byte of the range holds the erased value.
+ *******************************************************************************/
+bool sim_flash_is_erased(uint32_t address, uint32_t length) {
+    const uint8_t *src = sim_flash_ptr(address, length);
+
+    if (src == NULL) {
+        return false;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        if (src[i] != SIM_FLASH_ERASED_VALUE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_stats_get
+ ********************************************************************************
+ * Returns the operation counters.
+ *******************************************************************************/
+void sim_flash_stats_get(sim_flash_stats_t *stats) {
+    *stats = flash_stats;
+}
+
+/*******************************************************************************
+ * Function Name: sim_flash_stats_reset
+ ********************************************************************************
+ * Clears the operation counters.
+ *******************************************************************************/
+void sim_flash_stats_reset(void) {
+    memset(&flash_stats, 0, sizeof(flash_stats));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * File Name:   sim_flash.h
+ *
+ * Description: RAM-backed model of the XMC7200 code and work flash used by the
+ *              host simulator. Regions follow flashmap/xmc7200_platform.json.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef SIM_FLASH_H
+#define SIM_FLASH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define SIM_FLASH_ERASED_VALUE      (0xFFu)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Operation counters, reset with sim_flash_stats_reset() */
+typedef struct {
+    uint32_t erase_count;
+    uint32_t program_count;
+    uint32_t program_errors;
+    uint64_t bytes_programmed;
+    uint64_t bytes_erased;
+} sim_flash_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+int sim_flash_init(void);
+void sim_flash_deinit(void);
+const uint8_t *sim_flash_ptr(uint32_t address, uint32_t length);
+uint32_t sim_flash_erase_size(uint32_t address);
+uint32_t sim_flash_row_size(uint32_t address);
+int sim_flash_erase(uint32_t address);
+int sim_flash_program(uint32_t address, const uint8_t *data, uint32_t length);
+int sim_flash_read(uint32_t address, uint8_t *data, uint32_t length);
+int sim_flash_load(uint32_t address, const uint8_t *data, uint32_t length);
+bool sim_flash_is_erased(uint32_t address, uint32_t length);
+void sim_flash_stats_get(sim_flash_stats_t *stats);
+void sim_flash_stats_reset(void);
+
+#endif /* SIM_FLASH_H */
+
+/* [] END OF FILE */
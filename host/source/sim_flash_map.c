@@ -0,0 +1,243 @@
+/******************************************************************************
+ * File Name:   sim_flash_map.c
+ *
+ * Description: Flash area API of the MCUboot flash map backend over the flash model, with the
+ *              areas and devices of the memory map that memorymap_xmc7000.py generates. Erases
+ *              and programs go through the power cut port of sim_swap_port.c.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "memorymap.h"
+#include "flash_map_backend.h"
+#include "swap_journal.h"
+
+/*******************************************************************************
+ * Function Name: find_device
+ ********************************************************************************
+ * Returns the flash device of a device ID. The generator lists the devices
+ * in the order of their IDs.
+ *******************************************************************************/
+static const struct flash_device *find_device(uint8_t fd_id) {
+    const struct flash_device *device = &flash_devices[fd_id];
+
+    return (device->device_id == fd_id) ? device : NULL;
+}
+
+/*******************************************************************************
+ * Function Name: area_address
+ ********************************************************************************
+ * Returns the address of a range of an area, 0 if the range is outside it.
+ *******************************************************************************/
+static uint32_t area_address(const struct flash_area *fa, uint32_t off, uint32_t len) {
+    const struct flash_device *device = find_device(fa->fa_device_id);
+
+    if ((device == NULL) || ((uint64_t)off + len > fa->fa_size)) {
+        return 0u;
+    }
+    return device->address + fa->fa_off + off;
+}
+
+/*******************************************************************************
+ * Function Name: flash_area_open
+ ********************************************************************************
+ * Return:
+ *  0 and the area of the ID, -1 if the memory map has none.
+ *******************************************************************************/
+int flash_area_open(uint8_t id, const struct flash_area **fa) {
+    for (uint32_t i = 0u; boot_area_descs[i] != NULL; i++) {
+        if (boot_area_descs[i]->fa_id == id) {
+            *fa = boot_area_descs[i];
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/*******************************************************************************
+ * Function Name: flash_area_close
+ ********************************************************************************
+ * Areas need no closing on the host.
+ *******************************************************************************/
+void flash_area_close(const struct flash_area *fa) {
+    (void)fa;
+}
+
+/*******************************************************************************
+ * Function Name: flash_area_read
+ ********************************************************************************
+ * Return:
+ *  0 on success, -1 if the range is outside the area.
+ *******************************************************************************/
+int flash_area_read(const struct flash_area *fa, uint32_t off, void *dst, uint32_t len) {
+    uint32_t address = area_address(fa, off, len);
+    const uint8_t *p = (address != 0u) ? swap_journal_port_ptr(address, len) : NULL;
+
+    if (p == NULL) {
+        return -1;
+    }
+    memcpy(dst, p, len);
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: flash_area_write
+ ********************************************************************************
+ * Programs whole program units, which must be erased.
+ *
+ * Return:
+ *  0 on success, -1 on a misaligned range, a flash error or a power cut.
+ *******************************************************************************/
+int flash_area_write(const struct flash_area *fa, uint32_t off, const void *src, uint32_t len) {
+    uint32_t address = area_address(fa, off, len);
+    const uint8_t *data = src;
+
+    if (address == 0u) {
+        return -1;
+    }
+    for (uint32_t done = 0u; done < len;) {
+        uint32_t unit = swap_journal_port_program_size(address + done);
+
+        if ((unit == 0u) || (len - done < unit) ||
+            (swap_journal_port_program(address + done, &data[done], unit) != 0)) {
+            return -1;
+        }
+        done += unit;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: flash_area_erase
+ ********************************************************************************
+ * Erases whole sectors.
+ *
+ * Return:
+ *  0 on success, -1 on a misaligned range, a flash error or a power cut.
+ *******************************************************************************/
+int flash_area_erase(const struct flash_area *fa, uint32_t off, uint32_t len) {
+    uint32_t address = area_address(fa, off, len);
+
+    if (address == 0u) {
+        return -1;
+    }
+    for (uint32_t done = 0u; done < len;) {
+        uint32_t erase_size = swap_journal_port_erase_size(address + done);
+
+        if ((erase_size == 0u) || (((address + done) % erase_size) != 0u) || (len - done < erase_size) ||
+            (swap_journal_port_erase(address + done) != 0)) {
+            return -1;
+        }
+        done += erase_size;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: flash_area_align
+ ********************************************************************************
+ * Return:
+ *  The program unit of the area.
+ *******************************************************************************/
+uint32_t flash_area_align(const struct flash_area *fa) {
+    uint32_t address = area_address(fa, 0u, 0u);
+
+    return (address != 0u) ? swap_journal_port_program_size(address) : 0u;
+}
+
+/*******************************************************************************
+ * Function Name: flash_area_erased_val
+ ********************************************************************************
+ * Return:
+ *  The value of erased bytes of the area.
+ *******************************************************************************/
+uint8_t flash_area_erased_val(const struct flash_area *fa) {
+    const struct flash_device *device = find_device(fa->fa_device_id);
+
+    return (device != NULL) ? device->erase_val : 0xFFu;
+}
+
+/*******************************************************************************
+ * Function Name: flash_device_base
+ ********************************************************************************
+ * Return:
+ *  0 and the start address of the device, -1 for an unknown device.
+ *******************************************************************************/
+int flash_device_base(uint8_t fd_id, uintptr_t *ret) {
+    const struct flash_device *device = find_device(fd_id);
+
+    if (device == NULL) {
+        return -1;
+    }
+    *ret = device->address;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: flash_area_get_sectors
+ ********************************************************************************
+ * Lists the erase sectors of an area.
+ *
+ * Parameters:
+ *  fa_id          Area.
+ *  count          Room in sectors on entry, number of sectors on return.
+ *  sectors        Receives the sectors.
+ *
+ * Return:
+ *  0 on success, -1 for an unknown area or too many sectors.
+ *******************************************************************************/
+int flash_area_get_sectors(int fa_id, uint32_t *count, struct flash_sector *sectors) {
+    const struct flash_area *fa;
+    const struct flash_device *device;
+    uint32_t n;
+
+    if ((flash_area_open((uint8_t)fa_id, &fa) != 0) || ((device = find_device(fa->fa_device_id)) == NULL) ||
+        (device->erase_size == 0u)) {
+        return -1;
+    }
+    n = fa->fa_size / device->erase_size;
+    if (n > *count) {
+        return -1;
+    }
+    for (uint32_t i = 0u; i < n; i++) {
+        sectors[i].fs_off = i * device->erase_size;
+        sectors[i].fs_size = device->erase_size;
+    }
+    *count = n;
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,190 @@
+/******************************************************************************
+ * File Name:   sim_flash_port.c
+ *
+ * Description: This file contains the host flash port of the DFU application. An
+ *              operation takes effect in the flash model once its modelled duration
+ *              has elapsed, like a non-blocking operation of the flash controller.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <sched.h>
+#include <stdbool.h>
+#include <string.h>
+#include "cy_dfu.h"
+#include "dfu_flash.h"
+#include "sim_flash.h"
+#include "sim_flash_port.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    SIM_FLASH_OP_NONE,
+    SIM_FLASH_OP_ERASE,
+    SIM_FLASH_OP_PROGRAM,
+} sim_flash_op_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static sim_flash_timing_t port_timing;
+static sim_flash_op_t port_op = SIM_FLASH_OP_NONE;
+static uint32_t port_address;
+static uint32_t port_length;
+static uint8_t port_data[CY_DFU_ROW_SIZE];
+static uint64_t port_done_us;
+static cy_en_dfu_status_t port_result = CY_DFU_SUCCESS;
+
+/*******************************************************************************
+ * Function Name: sim_flash_port_set_timing
+ ********************************************************************************
+ * Sets the duration of the flash operations.
+ *******************************************************************************/
+void sim_flash_port_set_timing(const sim_flash_timing_t *timing) {
+    port_timing = *timing;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_init
+ ********************************************************************************
+ * Forgets the running operation.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_port_init(void) {
+    port_op = SIM_FLASH_OP_NONE;
+    port_result = CY_DFU_SUCCESS;
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_erase_size
+ ********************************************************************************
+ * Returns the erase sector size at the address, 0 outside the flash.
+ *******************************************************************************/
+uint32_t dfu_flash_port_erase_size(uint32_t address) {
+    return sim_flash_erase_size(address);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_start_erase
+ ********************************************************************************
+ * Starts erasing the sector that contains the address.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_port_start_erase(uint32_t address) {
+    if (port_op != SIM_FLASH_OP_NONE) {
+        return CY_DFU_ERROR_UNKNOWN;
+    }
+    port_op = SIM_FLASH_OP_ERASE;
+    port_address = address;
+    port_done_us = sim_time_us() + port_timing.erase_us;
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_start_program
+ ********************************************************************************
+ * Starts programming a row. The data is copied, like the flash controller
+ * latches the row. As dfu_flash_port.c, accepts only a whole aligned row: 512
+ * bytes in the code flash, 32 bytes in the work flash.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_port_start_program(uint32_t address, const uint32_t *data,
+                                                uint32_t length) {
+    uint32_t row_size = sim_flash_row_size(address);
+
+    if (port_op != SIM_FLASH_OP_NONE) {
+        return CY_DFU_ERROR_UNKNOWN;
+    }
+    if ((row_size == 0u) || (length != row_size) || ((address % row_size) != 0u)) {
+        return CY_DFU_ERROR_ADDRESS;
+    }
+    port_op = SIM_FLASH_OP_PROGRAM;
+    port_address = address;
+    port_length = length;
+    memcpy(port_data, data, length);
+    port_done_us = sim_time_us() +
+                   (((uint64_t)port_timing.program_us * length) / CY_DFU_ROW_SIZE);
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_busy
+ ********************************************************************************
+ * Completes the running operation once its duration has elapsed.
+ *
+ * Return:
+ *  true while the operation is running.
+ *******************************************************************************/
+bool dfu_flash_port_busy(void) {
+    int status;
+
+    if (port_op == SIM_FLASH_OP_NONE) {
+        return false;
+    }
+    if (sim_time_us() < port_done_us) {
+        /* The host and the device share the CPUs of the simulation, the
+         * target waits on its own core */
+        sched_yield();
+        return true;
+    }
+    if (port_op == SIM_FLASH_OP_ERASE) {
+        status = sim_flash_erase(port_address);
+    } else {
+        status = sim_flash_program(port_address, port_data, port_length);
+    }
+    port_result = (status == 0) ? CY_DFU_SUCCESS : CY_DFU_ERROR_DATA;
+    port_op = SIM_FLASH_OP_NONE;
+    return false;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_result
+ ********************************************************************************
+ * Returns the status of the last completed operation.
+ *******************************************************************************/
+cy_en_dfu_status_t dfu_flash_port_result(void) {
+    return port_result;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_flash_port_ptr
+ ********************************************************************************
+ * Returns the flash content at the address.
+ *******************************************************************************/
+const uint8_t *dfu_flash_port_ptr(uint32_t address, uint32_t length) {
+    return sim_flash_ptr(address, length);
+}
+
+/* [] END OF FILE */
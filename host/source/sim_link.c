@@ -0,0 +1,306 @@
+/******************************************************************************
+ * File Name:   sim_link.c
+ *
+ * Description: Stand-in DFU transport for the host simulator. The device end
+ *              implements the Cy_DFU_Transport*() API used by Cy_DFU_Continue().
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include "cy_dfu.h"
+#include "sim_link.h"
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define SIM_LINK_DEVICE             (0)
+#define SIM_LINK_HOST               (1)
+
+/* Every packet travels with the time it is due at the receiver */
+#define SIM_LINK_STAMP_SIZE         (sizeof(uint64_t))
+#define SIM_LINK_PACKET_MAX         (2048u)
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static int link_fd[2] = { -1, -1 };
+static sim_link_config_t link_config;
+static sim_link_stats_t link_stats;
+static uint32_t link_random;
+static pthread_mutex_t link_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*******************************************************************************
+ * Function Name: sim_link_open
+ ********************************************************************************
+ * Creates the link between the host and the simulated device.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int sim_link_open(const sim_link_config_t *config) {
+    link_config = *config;
+    if (link_config.poll_interval_us == 0u) {
+        link_config.poll_interval_us = 1u;
+    }
+    memset(&link_stats, 0, sizeof(link_stats));
+    link_random = 0x2545F491u;
+    return socketpair(AF_UNIX, SOCK_SEQPACKET, 0, link_fd);
+}
+
+/*******************************************************************************
+ * Function Name: sim_link_close
+ ********************************************************************************
+ * Closes both ends of the link.
+ *******************************************************************************/
+void sim_link_close(void) {
+    for (int i = 0; i < 2; i++) {
+        if (link_fd[i] >= 0) {
+            close(link_fd[i]);
+            link_fd[i] = -1;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sim_link_stats_get
+ ********************************************************************************
+ * Returns the packet counters of the link.
+ *******************************************************************************/
+void sim_link_stats_get(sim_link_stats_t *stats) {
+    pthread_mutex_lock(&link_lock);
+    *stats = link_stats;
+    pthread_mutex_unlock(&link_lock);
+}
+
+/*******************************************************************************
+ * Function Name: link_send
+ ********************************************************************************
+ * Sends one packet stamped with its arrival time, or drops it.
+ *
+ * Return:
+ *  0 on success (also when the packet is dropped), -1 on failure.
+ *******************************************************************************/
+static int link_send(int end, const uint8_t *data, uint32_t length) {
+    uint8_t packet[SIM_LINK_STAMP_SIZE + SIM_LINK_PACKET_MAX];
+    uint64_t due = sim_time_us() + link_config.latency_us;
+    bool drop = false;
+
+    if (length > SIM_LINK_PACKET_MAX) {
+        return -1;
+    }
+    pthread_mutex_lock(&link_lock);
+    link_stats.packets++;
+    if (link_config.loss_ppm != 0u) {
+        /* xorshift32, the same losses for the same configuration */
+        link_random ^= link_random << 13;
+        link_random ^= link_random >> 17;
+        link_random ^= link_random << 5;
+        drop = ((link_random % 1000000u) < link_config.loss_ppm);
+        link_stats.dropped += drop ? 1u : 0u;
+    }
+    pthread_mutex_unlock(&link_lock);
+    if (drop) {
+        return 0;
+    }
+
+    memcpy(packet, &due, SIM_LINK_STAMP_SIZE);
+    memcpy(&packet[SIM_LINK_STAMP_SIZE], data, length);
+    length += SIM_LINK_STAMP_SIZE;
+    return (send(link_fd[end], packet, length, 0) == (ssize_t)length) ? 0 : -1;
+}
+
+/*******************************************************************************
+ * Function Name: link_recv
+ ********************************************************************************
+ * Receives one packet without blocking and waits until it is due.
+ *
+ * Return:
+ *  Number of bytes received, 0 if no packet is waiting, -1 on failure.
+ *******************************************************************************/
+static int link_recv(int end, uint8_t *data, uint32_t size) {
+    uint8_t packet[SIM_LINK_STAMP_SIZE + SIM_LINK_PACKET_MAX];
+    ssize_t received = recv(link_fd[end], packet, sizeof(packet), MSG_DONTWAIT);
+    uint64_t due;
+    uint64_t now;
+
+    if (received <= 0) {
+        return 0;
+    }
+    if ((received < (ssize_t)SIM_LINK_STAMP_SIZE) ||
+        ((uint32_t)received - SIM_LINK_STAMP_SIZE > size)) {
+        return -1;
+    }
+    memcpy(&due, packet, SIM_LINK_STAMP_SIZE);
+    now = sim_time_us();
+    if (due > now) {
+        sim_sleep_us(due - now);
+    }
+    received -= SIM_LINK_STAMP_SIZE;
+    memcpy(data, &packet[SIM_LINK_STAMP_SIZE], (size_t)received);
+    return (int)received;
+}
+
+/*******************************************************************************
+ * Function Name: sim_link_host_send
+ ********************************************************************************
+ * Sends one packet from the host to the device.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int sim_link_host_send(void *context, const uint8_t *data, uint32_t length) {
+    (void)context;
+    return link_send(SIM_LINK_HOST, data, length);
+}
+
+/*******************************************************************************
+ * Function Name: sim_link_host_recv
+ ********************************************************************************
+ * Waits for one packet from the device.
+ *
+ * Return:
+ *  Number of bytes received, -1 on timeout or failure.
+ *******************************************************************************/
+int sim_link_host_recv(void *context, uint8_t *data, uint32_t size, uint32_t timeout_ms) {
+    struct pollfd pfd = { .fd = link_fd[SIM_LINK_HOST], .events = POLLIN };
+    int received;
+
+    (void)context;
+    if (poll(&pfd, 1, (int)timeout_ms) <= 0) {
+        return -1;
+    }
+    received = link_recv(SIM_LINK_HOST, data, size);
+    return (received > 0) ? received : -1;
+}
+
+/*******************************************************************************
+ * Function Name: sim_link_device_wait
+ ********************************************************************************
+ * Blocks the device until the host sends a packet, like a core sleeping until
+ * the transport RX interrupt.
+ *
+ * Return:
+ *  true if a packet is waiting, false on timeout.
+ *******************************************************************************/
+bool sim_link_device_wait(uint32_t timeout_ms) {
+    struct pollfd pfd = { .fd = link_fd[SIM_LINK_DEVICE], .events = POLLIN };
+
+    return (poll(&pfd, 1, (int)timeout_ms) > 0) && ((pfd.revents & POLLIN) != 0);
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_TransportRead
+ ********************************************************************************
+ * Device-side read of one packet. Polls the link every poll_interval_us
+ * until a packet arrives or the timeout expires, like the target transports.
+ *******************************************************************************/
+cy_en_dfu_status_t Cy_DFU_TransportRead(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                        uint32_t timeout) {
+    uint64_t deadline = sim_time_us() + ((uint64_t)timeout * 1000u);
+
+    for (;;) {
+        int received = link_recv(SIM_LINK_DEVICE, buffer, size);
+        uint64_t now;
+
+        if (received < 0) {
+            *count = 0u;
+            return CY_DFU_ERROR_LENGTH;
+        }
+        if (received > 0) {
+            *count = (uint32_t)received;
+            return CY_DFU_SUCCESS;
+        }
+        now = sim_time_us();
+        if (now >= deadline) {
+            *count = 0u;
+            return CY_DFU_ERROR_TIMEOUT;
+        }
+        sim_sleep_us(((deadline - now) < link_config.poll_interval_us) ?
+                     (deadline - now) : link_config.poll_interval_us);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_TransportWrite
+ ********************************************************************************
+ * Device-side write of one response packet.
+ *******************************************************************************/
+cy_en_dfu_status_t Cy_DFU_TransportWrite(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                         uint32_t timeout) {
+    (void)timeout;
+    if (link_send(SIM_LINK_DEVICE, buffer, size) != 0) {
+        *count = 0u;
+        return CY_DFU_ERROR_UNKNOWN;
+    }
+    *count = size;
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_TransportStart
+ ********************************************************************************
+ * The link is created by sim_link_open(), nothing to do here.
+ *******************************************************************************/
+void Cy_DFU_TransportStart(cy_en_dfu_transport_t transport) {
+    (void)transport;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_TransportStop
+ ********************************************************************************
+ * The link is closed by sim_link_close(), nothing to do here.
+ *******************************************************************************/
+void Cy_DFU_TransportStop(void) {
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_TransportReset
+ ********************************************************************************
+ * Drops packets the device has not consumed yet.
+ *******************************************************************************/
+void Cy_DFU_TransportReset(void) {
+    uint8_t discard[SIM_LINK_STAMP_SIZE + SIM_LINK_PACKET_MAX];
+
+    while (recv(link_fd[SIM_LINK_DEVICE], discard, sizeof(discard), MSG_DONTWAIT) > 0) {
+    }
+}
+
+/* [] END OF FILE */
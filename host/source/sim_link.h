@@ -0,0 +1,83 @@
+/******************************************************************************
+ * File Name:   sim_link.h
+ *
+ * Description: Stand-in DFU transport for the host simulator. A SOCK_SEQPACKET
+ *              socketpair keeps packet boundaries, like an I2C/SPI transaction
+ *              or a CAN FD frame, in place of the target transports.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef SIM_LINK_H
+#define SIM_LINK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    /* Granularity of the polled device-side read, in microseconds. The DFU
+     * middleware transports poll for a complete packet once per millisecond */
+    uint32_t poll_interval_us;
+    /* One-way delay of every packet, in microseconds */
+    uint32_t latency_us;
+    /* Packets dropped per million, in both directions */
+    uint32_t loss_ppm;
+} sim_link_config_t;
+
+typedef struct {
+    uint32_t packets;
+    uint32_t dropped;
+} sim_link_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+int sim_link_open(const sim_link_config_t *config);
+void sim_link_close(void);
+void sim_link_stats_get(sim_link_stats_t *stats);
+
+/* Host end of the link, matches dfu_host_link_t */
+int sim_link_host_send(void *context, const uint8_t *data, uint32_t length);
+int sim_link_host_recv(void *context, uint8_t *data, uint32_t size, uint32_t timeout_ms);
+
+/* Device end, stands in for the transport RX interrupt */
+bool sim_link_device_wait(uint32_t timeout_ms);
+
+#endif /* SIM_LINK_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * File Name:   sim_link_transport.c
+ *
+ * Description: Device end of the link of the simulated device over a DFU transport. Implements the
+ *              DFU transport functions of the middleware and sim_link_device_wait() of sim_link.c
+ *              on the master of a pty or on a CAN interface, so that dfu_sim_serve answers the
+ *              command line DFU host as the DFU application would.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "cy_dfu.h"
+#include "dfu_transport.h"
+#include "sim_link.h"
+#include "sim_link_transport.h"
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static dfu_transport_t link_transport = { .fd = -1 };
+
+/*******************************************************************************
+ * Function Name: sim_link_transport_open
+ ********************************************************************************
+ * Opens the device end of the link: a UART on fd, the master of a pty, or
+ * the CAN interface of the configuration with the identifiers swapped.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int sim_link_transport_open(const dfu_transport_config_t *config, int fd) {
+    if (config->type == DFU_TRANSPORT_UART) {
+        return dfu_transport_attach(&link_transport, config, fd);
+    }
+    return dfu_transport_open(&link_transport, config, true);
+}
+
+/*******************************************************************************
+ * Function Name: sim_link_transport_close
+ ********************************************************************************
+ * Closes the device end of the link.
+ *******************************************************************************/
+void sim_link_transport_close(void) {
+    dfu_transport_close(&link_transport);
+}
+
+/*******************************************************************************
+ * Function Name: sim_link_transport_stats_get
+ ********************************************************************************
+ * Returns the counters of the device end of the link.
+ *******************************************************************************/
+void sim_link_transport_stats_get(dfu_transport_stats_t *stats) {
+    *stats = link_transport.stats;
+}
+
+/*******************************************************************************
+ * Function Name: sim_link_device_wait
+ ********************************************************************************
+ * Blocks the device until the host sends a frame, like a core sleeping until
+ * the transport RX interrupt.
+ *
+ * Return:
+ *  true if bytes are waiting, false on timeout.
+ *******************************************************************************/
+bool sim_link_device_wait(uint32_t timeout_ms) {
+    return dfu_transport_wait(&link_transport, timeout_ms);
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_TransportRead
+ ********************************************************************************
+ * Device-side read of one frame, assembled from the bytes or the CAN frames
+ * received until the timeout expires.
+ *******************************************************************************/
+cy_en_dfu_status_t Cy_DFU_TransportRead(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                        uint32_t timeout) {
+    int received = dfu_transport_recv(&link_transport, buffer, size, timeout);
+
+    *count = (received > 0) ? (uint32_t)received : 0u;
+    return (received > 0) ? CY_DFU_SUCCESS : CY_DFU_ERROR_TIMEOUT;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_TransportWrite
+ ********************************************************************************
+ * Device-side write of one response frame.
+ *******************************************************************************/
+cy_en_dfu_status_t Cy_DFU_TransportWrite(uint8_t buffer[], uint32_t size, uint32_t *count,
+                                         uint32_t timeout) {
+    (void)timeout;
+    if (dfu_transport_send(&link_transport, buffer, size) != 0) {
+        *count = 0u;
+        return CY_DFU_ERROR_UNKNOWN;
+    }
+    *count = size;
+    return CY_DFU_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_TransportStart
+ ********************************************************************************
+ * The link is opened by sim_link_transport_open(), nothing to do here.
+ *******************************************************************************/
+void Cy_DFU_TransportStart(cy_en_dfu_transport_t transport) {
+    (void)transport;
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_TransportStop
+ ********************************************************************************
+ * The link is closed by sim_link_transport_close(), nothing to do here.
+ *******************************************************************************/
+void Cy_DFU_TransportStop(void) {
+}
+
+/*******************************************************************************
+ * Function Name: Cy_DFU_TransportReset
+ ********************************************************************************
+ * Drops the bytes the device has not consumed yet.
+ *******************************************************************************/
+void Cy_DFU_TransportReset(void) {
+    dfu_transport_flush(&link_transport);
+}
+
+/* [] END OF FILE */
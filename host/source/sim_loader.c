@@ -0,0 +1,919 @@
+/******************************************************************************
+ * File Name:   sim_loader.c
+ *
+ * Description: Model of the boot_go() path of the edge protect bootloader for one image. The upgrade
+ *              steps follow MCUboot: the overwrite upgrade copies a valid secondary image with
+ *              the trailer magic to the primary slot and erases the secondary header and trailer.
+ *              The swap upgrade resumes a swap recorded in the swap status partition, else takes
+ *              the swap type from the trailers, validates the secondary image, swaps the slots and
+ *              writes the trailers; the journaled swap stands in for the swap as
+ *              boot_perform_update_hook() does, with the header and validation hooks of
+ *              boot_hooks.c. The trailers are kept in the first row of the swap status partition,
+ *              the swap progress in the other rows. The direct XIP mode starts the valid slot of the
+ *              highest version in place, the RAM load mode copies it to the SRAM and validates the
+ *              copy. Signatures are not modelled.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "memorymap.h"
+#include "flash_map_backend.h"
+#include "dfu_packet.h"
+#include "dfu_sha256.h"
+#include "boot_enc.h"
+#include "sim_loader.h"
+#include "sim_swap_port.h"
+#include "sim_swap_scratch.h"
+#include "swap_journal.h"
+#if defined(MCUBOOT_RAM_LOAD)
+#include "boot_ram.h"
+#endif /* MCUBOOT_RAM_LOAD */
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define LOADER_IMAGE_MAGIC          (0x96f3b83du)
+#define LOADER_TLV_INFO_MAGIC       (0x6907u)
+#define LOADER_TLV_SHA256           (0x10u)
+#define LOADER_HEADER_SIZE          (32u)
+#define LOADER_MAGIC_SIZE           (16u)
+#define LOADER_FLAG_SET             (0x01u)
+#define LOADER_FLAG_UNSET           (0xFFu)
+#define LOADER_READ_SIZE            (512u)
+#define LOADER_MAX_SECTORS          (64u)
+
+/* Upgrade by a swap of the slots: neither the overwrite, the direct XIP nor
+ * the RAM load mode */
+#if !defined(MCUBOOT_OVERWRITE_ONLY) && !defined(MCUBOOT_DIRECT_XIP) && !defined(MCUBOOT_RAM_LOAD)
+#define LOADER_SWAP                 (1)
+#else
+#define LOADER_SWAP                 (0)
+#endif
+
+/* The slot of the highest version starts, without an upgrade request: in
+ * place in the direct XIP mode, from its copy in the SRAM in the RAM load
+ * mode */
+#if defined(MCUBOOT_DIRECT_XIP) || defined(MCUBOOT_RAM_LOAD)
+#define LOADER_SELECT               (1)
+#else
+#define LOADER_SELECT               (0)
+#endif
+
+#if defined(MCUBOOT_RAM_LOAD)
+/* IMAGE_F_RAM_LOAD of the header flags */
+#define LOADER_F_RAM_LOAD           (0x20u)
+/* SRAM of the device, as CY_SRAM_BASE and CY_SRAM_SIZE of the XMC7200 */
+#define LOADER_SRAM_START           (0x28000000u)
+#define LOADER_SRAM_SIZE            (0x00100000u)
+#endif /* MCUBOOT_RAM_LOAD */
+
+#if (LOADER_SWAP)
+/* Trailer of a slot in the swap status partition, one program unit per
+ * field */
+#define LOADER_TRAILER_SIZE         (0x80u)
+#define LOADER_MAGIC_OFF            (0x00u)
+#define LOADER_SWAP_INFO_OFF        (0x20u)
+#define LOADER_COPY_DONE_OFF        (0x40u)
+#define LOADER_IMAGE_OK_OFF         (0x60u)
+#define LOADER_PRIMARY_TRAILER      (0x000u)
+#define LOADER_SECONDARY_TRAILER    (0x080u)
+/* Rows of the swap progress, after the trailers */
+#define LOADER_STATUS_OFF           (0x200u)
+#endif /* LOADER_SWAP */
+
+#if (BOOT_ENC)
+/* Private key of the encrypted images, as boot_keys.c embeds it */
+#include "cypress-test-enc-p256.priv"
+#endif /* BOOT_ENC */
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    bool magic;
+    uint8_t copy_done;
+    uint8_t image_ok;
+} loader_trailer_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+#if !(LOADER_SELECT)
+static const uint8_t loader_magic[LOADER_MAGIC_SIZE] = {
+    0x77u, 0xc2u, 0x95u, 0xf3u, 0x60u, 0xd2u, 0xefu, 0x7fu,
+    0x35u, 0x52u, 0x50u, 0x0fu, 0x2cu, 0xb6u, 0x79u, 0x80u,
+};
+#endif /* !LOADER_SELECT */
+
+static const struct flash_area *loader_primary = NULL;
+static const struct flash_area *loader_secondary = NULL;
+static uint8_t loader_buf[LOADER_READ_SIZE];
+
+#if defined(MCUBOOT_RAM_LOAD)
+/* Load window of the SRAM, lost at a power-on */
+static uint8_t loader_ram[IMAGE_EXECUTABLE_RAM_SIZE];
+#endif /* MCUBOOT_RAM_LOAD */
+
+#if (LOADER_SWAP)
+static const struct flash_area *loader_status = NULL;
+static sim_swap_scratch_cfg_t loader_scratch_cfg;
+static swap_journal_cfg_t loader_journal_cfg;
+#endif /* LOADER_SWAP */
+
+/*******************************************************************************
+ * Function Name: loader_read
+ ********************************************************************************
+ * Reads an image. Without an area, reads the upgrade image of the open
+ * journaled swap sector by sector where the journal places it, as
+ * boot_hooks_swap_check() does.
+ *
+ * Parameters:
+ *  fa             Area of the image, NULL for the open journaled swap.
+ *  off            Offset in the image.
+ *  buf            Receives the bytes.
+ *  length         Bytes to read.
+ *******************************************************************************/
+static int loader_read(const struct flash_area *fa, uint32_t off, void *buf, uint32_t length) {
+#if (LOADER_SWAP)
+    uint8_t *dst = buf;
+
+    if (fa != NULL) {
+        return flash_area_read(fa, off, buf, length);
+    }
+    while (length != 0u) {
+        uint32_t pos = off % loader_journal_cfg.sector_size;
+        uint32_t chunk = loader_journal_cfg.sector_size - pos;
+        uint32_t address = swap_journal_find_secondary(&loader_journal_cfg, off / loader_journal_cfg.sector_size);
+        const uint8_t *src;
+
+        chunk = (chunk < length) ? chunk : length;
+        src = (address != 0u) ? swap_journal_port_ptr(address + pos, chunk) : NULL;
+        if (src == NULL) {
+            return -1;
+        }
+        memcpy(dst, src, chunk);
+        dst += chunk;
+        off += chunk;
+        length -= chunk;
+    }
+    return 0;
+#else
+    return flash_area_read(fa, off, buf, length);
+#endif /* LOADER_SWAP */
+}
+
+/*******************************************************************************
+ * Function Name: loader_image_size
+ ********************************************************************************
+ * Returns the size of the image in an area from its header: header, code
+ * and TLV areas. 0 if the header is not an image header. Without an area,
+ * the image of the open journaled swap, which has the size of the secondary
+ * slot.
+ *******************************************************************************/
+static uint32_t loader_image_size(const struct flash_area *fa, const uint8_t *header) {
+    uint32_t size = (uint32_t)header[8] | ((uint32_t)header[9] << 8);
+    uint32_t area_size = (fa != NULL) ? fa->fa_size : loader_secondary->fa_size;
+    uint8_t tlv[4];
+
+    if (dfu_packet_get_u32(header) != LOADER_IMAGE_MAGIC) {
+        return 0u;
+    }
+    size += dfu_packet_get_u32(&header[12]);
+    if (((uint64_t)size + sizeof(tlv) > area_size) || (loader_read(fa, size, tlv, sizeof(tlv)) != 0) ||
+        (((uint32_t)tlv[0] | ((uint32_t)tlv[1] << 8)) != LOADER_TLV_INFO_MAGIC)) {
+        return 0u;
+    }
+    size += (uint32_t)tlv[2] | ((uint32_t)tlv[3] << 8);
+    return (size <= area_size) ? size : 0u;
+}
+
+#if !defined(MCUBOOT_RAM_LOAD)
+/*******************************************************************************
+ * Function Name: loader_check_digest
+ ********************************************************************************
+ * Compares a digest of the image in an area with its SHA256 TLV.
+ *
+ * Parameters:
+ *  fa             Area of the image.
+ *  hashed         Bytes covered by the digest, the header and the code.
+ *  size           Size of the image.
+ *  digest         Digest to compare.
+ *******************************************************************************/
+static bool loader_check_digest(const struct flash_area *fa, uint32_t hashed, uint32_t size,
+                                const uint8_t digest[DFU_SHA256_SIZE]) {
+    for (uint32_t off = hashed + 4u; off + 4u <= size;) {
+        uint8_t tlv[4 + DFU_SHA256_SIZE];
+        uint32_t length;
+
+        if (loader_read(fa, off, tlv, 4u) != 0) {
+            return false;
+        }
+        length = (uint32_t)tlv[2] | ((uint32_t)tlv[3] << 8);
+        if ((tlv[0] == LOADER_TLV_SHA256) && (length == DFU_SHA256_SIZE)) {
+            return (loader_read(fa, off + 4u, &tlv[4], DFU_SHA256_SIZE) == 0) &&
+                   (memcmp(&tlv[4], digest, DFU_SHA256_SIZE) == 0);
+        }
+        off += 4u + length;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ * Function Name: loader_validate
+ ********************************************************************************
+ * Validates the image in an area as MCUboot does without the signature: the
+ * SHA256 TLV must match the header and code. Without an area, validates the
+ * image of the open journaled swap.
+ *******************************************************************************/
+static bool loader_validate(const struct flash_area *fa, sim_loader_rsp_t *rsp) {
+    uint8_t header[LOADER_HEADER_SIZE];
+    uint8_t digest[DFU_SHA256_SIZE];
+    dfu_sha256_t ctx;
+    uint32_t hashed;
+    uint32_t size;
+
+    if ((loader_read(fa, 0u, header, sizeof(header)) != 0) ||
+        ((size = loader_image_size(fa, header)) == 0u)) {
+        return false;
+    }
+    hashed = ((uint32_t)header[8] | ((uint32_t)header[9] << 8)) + dfu_packet_get_u32(&header[12]);
+    dfu_sha256_init(&ctx);
+    for (uint32_t off = 0u; off < hashed;) {
+        uint32_t chunk = ((hashed - off) < LOADER_READ_SIZE) ? (hashed - off) : LOADER_READ_SIZE;
+
+        if (loader_read(fa, off, loader_buf, chunk) != 0) {
+            return false;
+        }
+        dfu_sha256_update(&ctx, loader_buf, chunk);
+        off += chunk;
+    }
+    dfu_sha256_final(&ctx, digest);
+    rsp->hashed += hashed;
+    return loader_check_digest(fa, hashed, size, digest);
+}
+#endif /* !MCUBOOT_RAM_LOAD */
+
+/*******************************************************************************
+ * Function Name: loader_erase_slot
+ ********************************************************************************
+ * Erases an invalid secondary image, as MCUboot does. The direct XIP mode
+ * erases an invalid image in either slot, the slots are equivalent.
+ *******************************************************************************/
+static int loader_erase_slot(const struct flash_area *fa) {
+    return flash_area_erase(fa, 0u, fa->fa_size);
+}
+
+/*******************************************************************************
+ * Function Name: loader_address
+ ********************************************************************************
+ * Returns the address of the start of an area.
+ *******************************************************************************/
+static uint32_t loader_address(const struct flash_area *fa) {
+    uintptr_t base = 0u;
+
+    (void)flash_device_base(fa->fa_device_id, &base);
+    return (uint32_t)base + fa->fa_off;
+}
+
+#if (LOADER_SELECT)
+/*******************************************************************************
+ * Function Name: loader_version
+ ********************************************************************************
+ * Reads the version of the image in an area from its header: major, minor,
+ * revision and build number, in the order MCUboot compares them.
+ *
+ * Return:
+ *  false if the area has no image header.
+ *******************************************************************************/
+static bool loader_version(const struct flash_area *fa, uint64_t *version) {
+    if ((flash_area_read(fa, 0u, loader_buf, LOADER_HEADER_SIZE) != 0) ||
+        (dfu_packet_get_u32(loader_buf) != LOADER_IMAGE_MAGIC)) {
+        return false;
+    }
+    *version = ((uint64_t)loader_buf[20] << 56) | ((uint64_t)loader_buf[21] << 48) |
+               ((uint64_t)((uint32_t)loader_buf[22] | ((uint32_t)loader_buf[23] << 8)) << 32) |
+               dfu_packet_get_u32(&loader_buf[24]);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: loader_select
+ ********************************************************************************
+ * Returns the slot the direct XIP or RAM load boot_go() tries first: the
+ * one of the highest image version, NULL if neither slot has an image
+ * header.
+ *******************************************************************************/
+static const struct flash_area *loader_select(void) {
+    uint64_t primary = 0u;
+    uint64_t secondary = 0u;
+    bool has_primary = loader_version(loader_primary, &primary);
+    bool has_secondary = loader_version(loader_secondary, &secondary);
+
+    if (has_secondary && (!has_primary || (secondary > primary))) {
+        return loader_secondary;
+    }
+    return has_primary ? loader_primary : NULL;
+}
+
+#if defined(MCUBOOT_RAM_LOAD)
+/*******************************************************************************
+ * Function Name: loader_ram_load
+ ********************************************************************************
+ * Copies the image in an area to its load address in the SRAM and validates
+ * the copy, as boot_load_image_to_sram() and boot_verify_ram_load_address()
+ * do: the header must carry IMAGE_F_RAM_LOAD and the whole image must fit in
+ * the load window. The SHA256 TLV is checked against the copy, not against
+ * the slot. A failed copy or validation clears the window.
+ *******************************************************************************/
+static bool loader_ram_load(const sim_loader_cfg_t *cfg, const struct flash_area *fa, sim_loader_rsp_t *rsp) {
+    static const boot_ram_window_t window = {
+        IMAGE_EXECUTABLE_RAM_START, IMAGE_EXECUTABLE_RAM_SIZE, LOADER_SRAM_START, LOADER_SRAM_SIZE,
+    };
+    uint8_t header[LOADER_HEADER_SIZE];
+    uint8_t digest[DFU_SHA256_SIZE];
+    dfu_sha256_t ctx;
+    uint32_t load_addr;
+    uint32_t hdr_size;
+    uint32_t hashed;
+    uint32_t size;
+    uint8_t *copy;
+
+    if ((flash_area_read(fa, 0u, header, sizeof(header)) != 0) || ((size = loader_image_size(fa, header)) == 0u) ||
+        ((dfu_packet_get_u32(&header[16]) & LOADER_F_RAM_LOAD) == 0u)) {
+        return false;
+    }
+    load_addr = dfu_packet_get_u32(&header[4]);
+    if ((load_addr < IMAGE_EXECUTABLE_RAM_START) ||
+        ((uint64_t)load_addr + size > (uint64_t)IMAGE_EXECUTABLE_RAM_START + IMAGE_EXECUTABLE_RAM_SIZE)) {
+        return false;
+    }
+    copy = &loader_ram[load_addr - IMAGE_EXECUTABLE_RAM_START];
+    if (flash_area_read(fa, 0u, copy, size) != 0) {
+        memset(loader_ram, 0, sizeof(loader_ram));
+        return false;
+    }
+    rsp->copied += size;
+    hdr_size = (uint32_t)header[8] | ((uint32_t)header[9] << 8);
+    hashed = hdr_size + dfu_packet_get_u32(&header[12]);
+    if (cfg->ram_fault) {
+        copy[hashed - 1u] ^= 0x01u;
+    }
+
+    dfu_sha256_init(&ctx);
+    dfu_sha256_update(&ctx, copy, hashed);
+    dfu_sha256_final(&ctx, digest);
+    rsp->hashed += hashed;
+    for (uint32_t off = hashed + 4u; off + 4u <= size;) {
+        uint32_t length = (uint32_t)copy[off + 2u] | ((uint32_t)copy[off + 3u] << 8);
+
+        if ((copy[off] == LOADER_TLV_SHA256) && (length == DFU_SHA256_SIZE) && (off + 4u + length <= size)) {
+            if (memcmp(&copy[off + 4u], digest, DFU_SHA256_SIZE) != 0) {
+                break;
+            }
+            /* main(): the launch check of the copy */
+            rsp->entry = boot_ram_entry(&window, copy, load_addr, hdr_size, hashed - hdr_size);
+            return true;
+        }
+        off += 4u + length;
+    }
+    memset(loader_ram, 0, sizeof(loader_ram));
+    return false;
+}
+#endif /* MCUBOOT_RAM_LOAD */
+#elif defined(MCUBOOT_OVERWRITE_ONLY)
+/*******************************************************************************
+ * Function Name: loader_sector_size
+ ********************************************************************************
+ * Returns the erase sector size of an area.
+ *******************************************************************************/
+static uint32_t loader_sector_size(const struct flash_area *fa) {
+    struct flash_sector sectors[LOADER_MAX_SECTORS];
+    uint32_t count = LOADER_MAX_SECTORS;
+
+    if ((flash_area_get_sectors(fa->fa_id, &count, sectors) != 0) || (count == 0u)) {
+        return 0u;
+    }
+    return sectors[0].fs_size;
+}
+
+/*******************************************************************************
+ * Function Name: loader_magic_row
+ ********************************************************************************
+ * Returns the offset of the last program unit of a slot, which ends with the
+ * trailer magic.
+ *******************************************************************************/
+static uint32_t loader_magic_row(const struct flash_area *fa) {
+    return fa->fa_size - flash_area_align(fa);
+}
+
+/*******************************************************************************
+ * Function Name: loader_overwrite
+ ********************************************************************************
+ * Copies the secondary image to the primary slot, then erases the header
+ * and the trailer of the secondary slot. An interrupted copy starts again
+ * at the next boot, the secondary slot is intact until the copy is done.
+ *******************************************************************************/
+static int loader_overwrite(uint32_t size) {
+    uint32_t sector = loader_sector_size(loader_primary);
+    uint32_t align = flash_area_align(loader_primary);
+    uint32_t end;
+
+    if ((sector == 0u) || (align == 0u) || (align > sizeof(loader_buf))) {
+        return -1;
+    }
+    end = ((size + sector - 1u) / sector) * sector;
+    if ((flash_area_erase(loader_primary, 0u, end) != 0) ||
+        ((end < loader_primary->fa_size) &&
+         (flash_area_erase(loader_primary, loader_primary->fa_size - sector, sector) != 0))) {
+        return -1;
+    }
+    for (uint32_t off = 0u; off < size; off += align) {
+        if ((flash_area_read(loader_secondary, off, loader_buf, align) != 0) ||
+            (flash_area_write(loader_primary, off, loader_buf, align) != 0)) {
+            return -1;
+        }
+    }
+    if ((flash_area_erase(loader_secondary, 0u, sector) != 0) ||
+        (flash_area_erase(loader_secondary, loader_secondary->fa_size - sector, sector) != 0)) {
+        return -1;
+    }
+    return 0;
+}
+
+#if (BOOT_ENC)
+/*******************************************************************************
+ * Function Name: loader_validate_encrypted
+ ********************************************************************************
+ * Validates the encrypted image in the secondary slot as boot_hooks.c does:
+ * the SHA256 TLV must match the header and the decrypted code.
+ *******************************************************************************/
+static bool loader_validate_encrypted(sim_loader_rsp_t *rsp) {
+    uint8_t header[LOADER_HEADER_SIZE];
+    uint8_t digest[DFU_SHA256_SIZE];
+    uint32_t hashed;
+    uint32_t size;
+
+    if ((flash_area_read(loader_secondary, 0u, header, sizeof(header)) != 0) ||
+        ((size = loader_image_size(loader_secondary, header)) == 0u) ||
+        !boot_enc_hash(loader_address(loader_secondary), loader_secondary->fa_size, digest)) {
+        return false;
+    }
+    hashed = ((uint32_t)header[8] | ((uint32_t)header[9] << 8)) + dfu_packet_get_u32(&header[12]);
+    rsp->hashed += hashed;
+    return loader_check_digest(loader_secondary, hashed, size, digest);
+}
+#endif /* BOOT_ENC */
+#else
+/*******************************************************************************
+ * Function Name: loader_read_trailer
+ ********************************************************************************
+ * Reads the trailer of a slot from the swap status partition.
+ *******************************************************************************/
+static void loader_read_trailer(uint32_t trailer, loader_trailer_t *state) {
+    uint8_t unit[LOADER_MAGIC_SIZE];
+    uint8_t flag;
+
+    state->magic = (flash_area_read(loader_status, trailer + LOADER_MAGIC_OFF, unit, sizeof(unit)) == 0) &&
+                   (memcmp(unit, loader_magic, sizeof(unit)) == 0);
+    state->copy_done = (flash_area_read(loader_status, trailer + LOADER_COPY_DONE_OFF, &flag, 1u) == 0) ?
+                       flag : 0u;
+    state->image_ok = (flash_area_read(loader_status, trailer + LOADER_IMAGE_OK_OFF, &flag, 1u) == 0) ?
+                      flag : 0u;
+}
+
+/*******************************************************************************
+ * Function Name: loader_write_field
+ ********************************************************************************
+ * Programs one field of a trailer, a program unit padded with erased bytes.
+ *******************************************************************************/
+static int loader_write_field(uint32_t off, const uint8_t *data, uint32_t length) {
+    uint32_t align = flash_area_align(loader_status);
+
+    if ((align == 0u) || (align > sizeof(loader_buf)) || (length > align)) {
+        return -1;
+    }
+    memset(loader_buf, flash_area_erased_val(loader_status), align);
+    memcpy(loader_buf, data, length);
+    return flash_area_write(loader_status, off, loader_buf, align);
+}
+
+/*******************************************************************************
+ * Function Name: loader_swap_type
+ ********************************************************************************
+ * Returns the swap type the trailers request, as boot_swap_type() does.
+ *******************************************************************************/
+static uint8_t loader_swap_type(void) {
+    loader_trailer_t primary;
+    loader_trailer_t secondary;
+
+    loader_read_trailer(LOADER_SECONDARY_TRAILER, &secondary);
+    if (secondary.magic) {
+        return (secondary.image_ok == LOADER_FLAG_SET) ? SIM_LOADER_SWAP_PERM : SIM_LOADER_SWAP_TEST;
+    }
+    loader_read_trailer(LOADER_PRIMARY_TRAILER, &primary);
+    if (primary.magic && (primary.copy_done == LOADER_FLAG_SET) && (primary.image_ok == LOADER_FLAG_UNSET)) {
+        return SIM_LOADER_SWAP_REVERT;
+    }
+    return SIM_LOADER_SWAP_NONE;
+}
+
+/*******************************************************************************
+ * Function Name: loader_write_trailers
+ ********************************************************************************
+ * Writes the trailers after a swap: a new primary trailer with the magic
+ * written last, then the secondary trailer is erased. Can be repeated.
+ *******************************************************************************/
+static int loader_write_trailers(uint8_t swap_type) {
+    const uint8_t set = LOADER_FLAG_SET;
+    uint8_t swap_info = swap_type;
+
+    if ((flash_area_erase(loader_status, LOADER_PRIMARY_TRAILER, LOADER_TRAILER_SIZE) != 0) ||
+        (loader_write_field(LOADER_PRIMARY_TRAILER + LOADER_SWAP_INFO_OFF, &swap_info, 1u) != 0) ||
+        ((swap_type != SIM_LOADER_SWAP_TEST) &&
+         (loader_write_field(LOADER_PRIMARY_TRAILER + LOADER_IMAGE_OK_OFF, &set, 1u) != 0)) ||
+        (loader_write_field(LOADER_PRIMARY_TRAILER + LOADER_COPY_DONE_OFF, &set, 1u) != 0) ||
+        (loader_write_field(LOADER_PRIMARY_TRAILER + LOADER_MAGIC_OFF, loader_magic, LOADER_MAGIC_SIZE) != 0) ||
+        (flash_area_erase(loader_status, LOADER_SECONDARY_TRAILER, LOADER_TRAILER_SIZE) != 0)) {
+        return -1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: loader_swap_scratch
+ ********************************************************************************
+ * Swap upgrade with the MCUboot swap using scratch.
+ *******************************************************************************/
+static int loader_swap_scratch(sim_loader_rsp_t *rsp) {
+    sim_swap_scratch_stats_t stats;
+    sim_swap_scratch_state_t state;
+    uint8_t swap_type = SIM_LOADER_SWAP_NONE;
+
+    state = sim_swap_scratch_state(&loader_scratch_cfg, &swap_type);
+    if (state == SIM_SWAP_SCRATCH_NONE) {
+        swap_type = loader_swap_type();
+        if (((swap_type == SIM_LOADER_SWAP_TEST) || (swap_type == SIM_LOADER_SWAP_PERM)) &&
+            !loader_validate(loader_secondary, rsp)) {
+            rsp->swap_type = SIM_LOADER_SWAP_FAIL;
+            return ((loader_erase_slot(loader_secondary) == 0) &&
+                    (flash_area_erase(loader_status, LOADER_SECONDARY_TRAILER, LOADER_TRAILER_SIZE) == 0)) ? 0 : -1;
+        }
+        if (swap_type == SIM_LOADER_SWAP_NONE) {
+            return 0;
+        }
+    }
+    rsp->swap_type = swap_type;
+    if (((state != SIM_SWAP_SCRATCH_SWAPPED) &&
+         (sim_swap_scratch_run(&loader_scratch_cfg, swap_type, &stats) != 0)) ||
+        (loader_write_trailers(swap_type) != 0) || (sim_swap_scratch_close(&loader_scratch_cfg) != 0)) {
+        return -1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: loader_swap_journal
+ ********************************************************************************
+ * Swap upgrade with the journaled swap, as boot_hooks.c does it: while a
+ * swap is open, the secondary image is validated where the journal places
+ * its sectors.
+ *******************************************************************************/
+static int loader_swap_journal(sim_loader_rsp_t *rsp) {
+    uint8_t swap_type = loader_swap_type();
+    loader_trailer_t secondary;
+
+    if ((swap_type == SIM_LOADER_SWAP_TEST) || (swap_type == SIM_LOADER_SWAP_PERM)) {
+        bool open = (swap_journal_find_secondary(&loader_journal_cfg, 0u) != 0u);
+
+        if (!loader_validate(open ? NULL : loader_secondary, rsp)) {
+            rsp->swap_type = SIM_LOADER_SWAP_FAIL;
+            return ((loader_erase_slot(loader_secondary) == 0) &&
+                    (flash_area_erase(loader_status, LOADER_SECONDARY_TRAILER, LOADER_TRAILER_SIZE) == 0)) ? 0 : -1;
+        }
+    }
+    if (swap_type == SIM_LOADER_SWAP_NONE) {
+        return 0;
+    }
+    rsp->swap_type = swap_type;
+
+    /* boot_hooks_swap() */
+    loader_read_trailer(LOADER_SECONDARY_TRAILER, &secondary);
+    if ((swap_journal_state(&loader_journal_cfg) == SWAP_JOURNAL_STATE_COMPLETE) && !secondary.magic &&
+        (swap_journal_close() != 0)) {
+        return -1;
+    }
+    if ((swap_journal_run(&loader_journal_cfg) != 0) || (loader_write_trailers(swap_type) != 0) ||
+        (swap_journal_close() != 0)) {
+        return -1;
+    }
+    return 0;
+}
+#endif /* LOADER_SELECT */
+
+/*******************************************************************************
+ * Function Name: sim_loader_power_on
+ ********************************************************************************
+ * Loses the RAM, as a power-on does: the next boot finds no copy in the SRAM.
+ *******************************************************************************/
+void sim_loader_power_on(void) {
+#if defined(MCUBOOT_RAM_LOAD)
+    memset(loader_ram, 0, sizeof(loader_ram));
+#endif /* MCUBOOT_RAM_LOAD */
+}
+
+/*******************************************************************************
+ * Function Name: sim_loader_ram
+ ********************************************************************************
+ * Returns the load window of the SRAM of the RAM load mode, as the last boot
+ * left it.
+ *
+ * Parameters:
+ *  size           Receives the size of the window.
+ *
+ * Return:
+ *  The window, which starts at IMAGE_EXECUTABLE_RAM_START. NULL in the other
+ *  modes.
+ *******************************************************************************/
+const uint8_t *sim_loader_ram(uint32_t *size) {
+#if defined(MCUBOOT_RAM_LOAD)
+    *size = sizeof(loader_ram);
+    return loader_ram;
+#else
+    *size = 0u;
+    return NULL;
+#endif /* MCUBOOT_RAM_LOAD */
+}
+
+/*******************************************************************************
+ * Function Name: sim_loader_init
+ ********************************************************************************
+ * Opens the flash areas of the image.
+ *
+ * Return:
+ *  0 on success, -1 if the memory map lacks an area.
+ *******************************************************************************/
+int sim_loader_init(void) {
+    if ((flash_area_open(memory_areas_primary[0], &loader_primary) != 0) ||
+        (flash_area_open(memory_areas_secondary[0], &loader_secondary) != 0)) {
+        return -1;
+    }
+#if (LOADER_SWAP)
+    {
+        const struct flash_area *scratch;
+
+        if ((flash_area_open(FLASH_AREA_IMAGE_SCRATCH, &scratch) != 0) ||
+            (flash_area_open(FLASH_AREA_IMAGE_SWAP_STATUS, &loader_status) != 0) ||
+            (loader_status->fa_size <= LOADER_STATUS_OFF) || (scratch->fa_size == 0u)) {
+            return -1;
+        }
+        loader_scratch_cfg.primary = loader_address(loader_primary);
+        loader_scratch_cfg.secondary = loader_address(loader_secondary);
+        loader_scratch_cfg.scratch = loader_address(scratch);
+        loader_scratch_cfg.scratch_size = scratch->fa_size;
+        loader_scratch_cfg.slot_size = loader_primary->fa_size;
+        loader_scratch_cfg.status = loader_address(loader_status) + LOADER_STATUS_OFF;
+        loader_scratch_cfg.status_size = loader_status->fa_size - LOADER_STATUS_OFF;
+
+        /* As boot_hooks_swap_cfg() */
+        loader_journal_cfg.primary = loader_scratch_cfg.primary;
+        loader_journal_cfg.secondary = loader_scratch_cfg.secondary;
+        loader_journal_cfg.scratch = loader_scratch_cfg.scratch;
+        loader_journal_cfg.sector_size = scratch->fa_size;
+        loader_journal_cfg.sector_count = loader_primary->fa_size / scratch->fa_size;
+    }
+#endif /* LOADER_SWAP */
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: sim_loader_set_pending
+ ********************************************************************************
+ * Requests the upgrade to the secondary image, as boot_set_pending() does.
+ * The direct XIP and RAM load modes have no request, the newest valid image
+ * starts.
+ *
+ * Parameters:
+ *  permanent      Swap upgrade: no revert unless the image is confirmed.
+ *
+ * Return:
+ *  0 on success, -1 on a flash error.
+ *******************************************************************************/
+int sim_loader_set_pending(bool permanent) {
+#if (LOADER_SELECT)
+    (void)permanent;
+    return 0;
+#elif defined(MCUBOOT_OVERWRITE_ONLY)
+    uint32_t row = loader_magic_row(loader_secondary);
+    uint32_t align = flash_area_align(loader_secondary);
+
+    (void)permanent;
+    if ((align < LOADER_MAGIC_SIZE) || (align > sizeof(loader_buf)) ||
+        (flash_area_read(loader_secondary, row, loader_buf, align) != 0)) {
+        return -1;
+    }
+    if (memcmp(&loader_buf[align - LOADER_MAGIC_SIZE], loader_magic, LOADER_MAGIC_SIZE) == 0) {
+        return 0;
+    }
+    memcpy(&loader_buf[align - LOADER_MAGIC_SIZE], loader_magic, LOADER_MAGIC_SIZE);
+    return flash_area_write(loader_secondary, row, loader_buf, align);
+#else
+    const uint8_t set = LOADER_FLAG_SET;
+
+    if ((flash_area_erase(loader_status, LOADER_SECONDARY_TRAILER, LOADER_TRAILER_SIZE) != 0) ||
+        (permanent && (loader_write_field(LOADER_SECONDARY_TRAILER + LOADER_IMAGE_OK_OFF, &set, 1u) != 0))) {
+        return -1;
+    }
+    return loader_write_field(LOADER_SECONDARY_TRAILER + LOADER_MAGIC_OFF, loader_magic, LOADER_MAGIC_SIZE);
+#endif /* LOADER_SELECT */
+}
+
+/*******************************************************************************
+ * Function Name: sim_loader_set_confirmed
+ ********************************************************************************
+ * Confirms the image in the primary slot, as boot_set_confirmed() does, so
+ * that a test upgrade is not reverted.
+ *
+ * Return:
+ *  0 on success, -1 on a flash error.
+ *******************************************************************************/
+int sim_loader_set_confirmed(void) {
+#if !(LOADER_SWAP)
+    return 0;
+#else
+    const uint8_t set = LOADER_FLAG_SET;
+    loader_trailer_t primary;
+
+    loader_read_trailer(LOADER_PRIMARY_TRAILER, &primary);
+    if (!primary.magic || (primary.image_ok != LOADER_FLAG_UNSET)) {
+        return 0;
+    }
+    return loader_write_field(LOADER_PRIMARY_TRAILER + LOADER_IMAGE_OK_OFF, &set, 1u);
+#endif /* LOADER_SWAP */
+}
+
+/*******************************************************************************
+ * Function Name: sim_loader_pending
+ ********************************************************************************
+ * Reads the headers and trailers as boot_fast_pending() does, before a boot.
+ *
+ * Return:
+ *  true if an upgrade or a revert is pending, a swap is interrupted or the
+ *  primary slot has no image header. In the direct XIP and RAM load modes,
+ *  true if neither slot has an image header.
+ *******************************************************************************/
+bool sim_loader_pending(void) {
+#if (LOADER_SELECT)
+    return (loader_select() == NULL);
+#else
+    if ((flash_area_read(loader_primary, 0u, loader_buf, LOADER_HEADER_SIZE) != 0) ||
+        (dfu_packet_get_u32(loader_buf) != LOADER_IMAGE_MAGIC)) {
+        return true;
+    }
+#if defined(MCUBOOT_OVERWRITE_ONLY)
+    return (flash_area_read(loader_secondary, loader_magic_row(loader_secondary) + flash_area_align(loader_secondary) -
+                            LOADER_MAGIC_SIZE, loader_buf, LOADER_MAGIC_SIZE) != 0) ||
+           (memcmp(loader_buf, loader_magic, LOADER_MAGIC_SIZE) == 0);
+#else
+    {
+        loader_trailer_t primary;
+        uint8_t swap_type;
+
+        loader_read_trailer(LOADER_PRIMARY_TRAILER, &primary);
+        return (loader_swap_type() != SIM_LOADER_SWAP_NONE) ||
+               (primary.magic && (primary.copy_done != LOADER_FLAG_SET)) ||
+               (sim_swap_scratch_state(&loader_scratch_cfg, &swap_type) != SIM_SWAP_SCRATCH_NONE);
+    }
+#endif /* MCUBOOT_OVERWRITE_ONLY */
+#endif /* LOADER_SELECT */
+}
+
+/*******************************************************************************
+ * Function Name: sim_loader_boot_go
+ ********************************************************************************
+ * One boot: the upgrade, if one is requested or interrupted, then the
+ * validation of the primary slot. In the direct XIP mode the slot of the
+ * highest version is validated and started in place, an invalid image is
+ * erased as boot_validate_slot() does and the other slot is tried. The RAM
+ * load mode copies the slot of the highest version to the SRAM and validates
+ * the copy, the image starts if its vector table passes the launch check.
+ *
+ * Parameters:
+ *  cfg            Loader configuration.
+ *  rsp            Receives the result. Not booted after a power cut.
+ *******************************************************************************/
+void sim_loader_boot_go(const sim_loader_cfg_t *cfg, sim_loader_rsp_t *rsp) {
+    const struct flash_area *boot = loader_primary;
+    sim_swap_port_stats_t before;
+    sim_swap_port_stats_t after;
+    int rc;
+
+    memset(rsp, 0, sizeof(*rsp));
+    rsp->swap_type = SIM_LOADER_SWAP_NONE;
+    sim_swap_port_stats_get(&before);
+#if (BOOT_ENC)
+    /* As the first check hook after a reset */
+    (void)boot_enc_init(enc_priv_key, enc_priv_key_len);
+#endif /* BOOT_ENC */
+
+#if defined(MCUBOOT_DIRECT_XIP)
+    rc = 0;
+    while ((rc == 0) && ((boot = loader_select()) != NULL) && !loader_validate(boot, rsp)) {
+        rc = loader_erase_slot(boot);
+    }
+    rsp->booted = (rc == 0) && (boot != NULL);
+#elif defined(MCUBOOT_RAM_LOAD)
+    rc = 0;
+    while ((rc == 0) && ((boot = loader_select()) != NULL) && !loader_ram_load(cfg, boot, rsp)) {
+        rc = loader_erase_slot(boot);
+    }
+    /* An image that fails the launch check is not erased, main() stops */
+    rsp->booted = (rc == 0) && (boot != NULL) && (rsp->entry != 0u);
+#elif defined(MCUBOOT_OVERWRITE_ONLY)
+    rc = 0;
+    if ((flash_area_read(loader_secondary, loader_magic_row(loader_secondary) + flash_area_align(loader_secondary) -
+                         LOADER_MAGIC_SIZE, loader_buf, LOADER_MAGIC_SIZE) == 0) &&
+        (memcmp(loader_buf, loader_magic, LOADER_MAGIC_SIZE) == 0) &&
+        (flash_area_read(loader_secondary, 0u, loader_buf, LOADER_HEADER_SIZE) == 0) &&
+        (dfu_packet_get_u32(loader_buf) == LOADER_IMAGE_MAGIC)) {
+        uint32_t size = loader_image_size(loader_secondary, loader_buf);
+#if (BOOT_ENC)
+        bool encrypted = boot_enc_is_encrypted(loader_address(loader_secondary));
+#else
+        bool encrypted = false;
+#endif /* BOOT_ENC */
+
+        if ((size != 0u) && !encrypted && loader_validate(loader_secondary, rsp)) {
+            rsp->swap_type = SIM_LOADER_SWAP_PERM;
+            rc = loader_overwrite(size);
+#if (BOOT_ENC)
+        } else if ((size != 0u) && encrypted && loader_validate_encrypted(rsp)) {
+            /* boot_perform_update_hook() */
+            rsp->swap_type = SIM_LOADER_SWAP_PERM;
+            rc = boot_enc_install(loader_address(loader_primary), loader_primary->fa_size,
+                                  loader_address(loader_secondary), loader_secondary->fa_size);
+#endif /* BOOT_ENC */
+        } else {
+            rsp->swap_type = SIM_LOADER_SWAP_FAIL;
+            rc = loader_erase_slot(loader_secondary);
+        }
+    }
+#else
+    swap_journal_port_init();
+    rc = cfg->journal ? loader_swap_journal(rsp) : loader_swap_scratch(rsp);
+#endif /* MCUBOOT_DIRECT_XIP */
+
+#if !(LOADER_SELECT)
+    rsp->booted = (rc == 0) && loader_validate(boot, rsp);
+#endif /* !LOADER_SELECT */
+    if (rsp->booted) {
+        rsp->slot = loader_address(boot);
+    }
+#if (BOOT_ENC)
+    {
+        boot_enc_stats_t stats;
+
+        boot_enc_stats_get(&stats);
+        rsp->decrypted = stats.hashed + stats.installed;
+        rsp->unwraps = stats.unwraps;
+    }
+#endif /* BOOT_ENC */
+    sim_swap_port_stats_get(&after);
+    rsp->time_us = (after.time_us - before.time_us) + ((uint64_t)rsp->hashed * cfg->hash_us_per_kb / 1024u) +
+                   ((uint64_t)rsp->decrypted * cfg->aes_us_per_kb / 1024u) + ((uint64_t)rsp->unwraps * cfg->ecdh_us) +
+                   ((uint64_t)rsp->copied * cfg->copy_us_per_kb / 1024u);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * File Name:   sim_loader.h
+ *
+ * Description: Model of the boot_go() path of the edge protect bootloader for one image, over the
+ *              flash areas of the generated memory map: the overwrite upgrade, or the swap
+ *              upgrade with the MCUboot swap using scratch or the journaled swap, the direct XIP
+ *              mode and the RAM load mode.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef SIM_LOADER_H
+#define SIM_LOADER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Swap types, as BOOT_SWAP_TYPE_* of MCUboot */
+#define SIM_LOADER_SWAP_NONE        (1u)
+#define SIM_LOADER_SWAP_TEST        (2u)
+#define SIM_LOADER_SWAP_PERM        (3u)
+#define SIM_LOADER_SWAP_REVERT      (4u)
+#define SIM_LOADER_SWAP_FAIL        (5u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    /* Swap upgrade: use the journaled swap of boot_perform_update_hook() */
+    bool journal;
+    /* Modelled time to hash 1 KB of an image */
+    uint32_t hash_us_per_kb;
+    /* Modelled time to decrypt 1 KB of an encrypted image, and to unwrap
+     * its key */
+    uint32_t aes_us_per_kb;
+    uint32_t ecdh_us;
+    /* RAM load: flip a bit of the copy in the SRAM before it is hashed */
+    bool ram_fault;
+    /* RAM load: modelled time to copy 1 KB of an image to the SRAM */
+    uint32_t copy_us_per_kb;
+} sim_loader_cfg_t;
+
+typedef struct {
+    /* A valid image was started, from the primary slot unless the mode is
+     * direct XIP or RAM load */
+    bool booted;
+    /* Address of the slot of the started image */
+    uint32_t slot;
+    /* Upgrade performed or resumed by this boot */
+    uint8_t swap_type;
+    /* Bytes of images hashed */
+    uint32_t hashed;
+    /* Bytes of encrypted code decrypted, and image keys unwrapped */
+    uint32_t decrypted;
+    uint32_t unwraps;
+    /* RAM load: address the CM7 starts at, and bytes copied to the SRAM */
+    uint32_t entry;
+    uint32_t copied;
+    /* Modelled time of the flash operations and the hashing */
+    uint64_t time_us;
+} sim_loader_rsp_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+int sim_loader_init(void);
+int sim_loader_set_pending(bool permanent);
+int sim_loader_set_confirmed(void);
+bool sim_loader_pending(void);
+void sim_loader_boot_go(const sim_loader_cfg_t *cfg, sim_loader_rsp_t *rsp);
+void sim_loader_power_on(void);
+const uint8_t *sim_loader_ram(uint32_t *size);
+
+#endif /* SIM_LOADER_H */
+
+/* [] END OF FILE */
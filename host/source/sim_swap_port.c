@@ -0,0 +1,296 @@
+/******************************************************************************
+ * File Name:   sim_swap_port.c
+ *
+ * Description: Host flash port of the journaled swap of the bootloader. Operations complete
+ *              at once in the flash model and add their modelled duration. A power cut
+ *              leaves the operation it interrupts half done, with unpredictable contents,
+ *              and fails all operations until the power is back.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "sim_flash.h"
+#include "sim_swap_port.h"
+#include "swap_journal.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define SIM_SWAP_CODE_ROW_SIZE      (512u)
+#define SIM_SWAP_WORK_ROW_SIZE      (32u)
+#define SIM_SWAP_WORK_LARGE_SIZE    (0x800u)
+#define SIM_SWAP_WORK_SMALL_SIZE    (0x80u)
+#define SIM_SWAP_MAX_SECTOR_SIZE    (0x8000u)
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static sim_swap_timing_t port_timing;
+static sim_swap_port_stats_t port_stats;
+
+/* Operations since the start, the power fails during operation port_cut */
+static uint64_t port_ops = 0u;
+static uint64_t port_cut = 0u;
+static uint32_t port_random = 1u;
+static bool port_powered = true;
+
+static uint8_t port_sector[SIM_SWAP_MAX_SECTOR_SIZE];
+
+/*******************************************************************************
+ * Function Name: port_next_random
+ ********************************************************************************
+ * Returns the next number of a xorshift32 sequence.
+ *******************************************************************************/
+static uint32_t port_next_random(void) {
+    uint32_t x = port_random;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    port_random = x;
+    return x;
+}
+
+/*******************************************************************************
+ * Function Name: port_start
+ ********************************************************************************
+ * Counts an operation.
+ *
+ * Return:
+ *  false if the power fails during the operation.
+ *******************************************************************************/
+static bool port_start(void) {
+    port_ops++;
+    if ((port_cut != 0u) && (port_ops == port_cut)) {
+        port_powered = false;
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: sim_swap_port_set_timing
+ ********************************************************************************
+ * Sets the duration of the flash operations.
+ *******************************************************************************/
+void sim_swap_port_set_timing(const sim_swap_timing_t *timing) {
+    port_timing = *timing;
+}
+
+/*******************************************************************************
+ * Function Name: sim_swap_port_stats_reset
+ ********************************************************************************
+ * Clears the operation counters.
+ *******************************************************************************/
+void sim_swap_port_stats_reset(void) {
+    memset(&port_stats, 0, sizeof(port_stats));
+}
+
+/*******************************************************************************
+ * Function Name: sim_swap_port_stats_get
+ ********************************************************************************
+ * Returns the operation counters.
+ *******************************************************************************/
+void sim_swap_port_stats_get(sim_swap_port_stats_t *stats) {
+    *stats = port_stats;
+}
+
+/*******************************************************************************
+ * Function Name: sim_swap_port_ops
+ ********************************************************************************
+ * Returns the number of operations started so far.
+ *******************************************************************************/
+uint64_t sim_swap_port_ops(void) {
+    return port_ops;
+}
+
+/*******************************************************************************
+ * Function Name: sim_swap_port_cut_after
+ ********************************************************************************
+ * Cuts the power during the given operation from now, 0 for none.
+ *
+ * Parameters:
+ *  ops            Operation, 1 for the next one.
+ *  seed           Seed of the contents left by the interrupted operation.
+ *******************************************************************************/
+void sim_swap_port_cut_after(uint64_t ops, uint32_t seed) {
+    port_cut = (ops != 0u) ? (port_ops + ops) : 0u;
+    port_random = (seed != 0u) ? seed : 1u;
+}
+
+/*******************************************************************************
+ * Function Name: sim_swap_port_powered
+ ********************************************************************************
+ * Return:
+ *  false after a power cut, until sim_swap_port_power_on().
+ *******************************************************************************/
+bool sim_swap_port_powered(void) {
+    return port_powered;
+}
+
+/*******************************************************************************
+ * Function Name: sim_swap_port_power_on
+ ********************************************************************************
+ * Restores the power after a cut.
+ *******************************************************************************/
+void sim_swap_port_power_on(void) {
+    port_powered = true;
+    port_cut = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: swap_journal_port_init
+ ********************************************************************************
+ * The flash model is always writable.
+ *******************************************************************************/
+void swap_journal_port_init(void) {
+}
+
+/*******************************************************************************
+ * Function Name: swap_journal_port_erase_size
+ ********************************************************************************
+ * Returns the erase sector size at the address, 0 outside the flash.
+ *******************************************************************************/
+uint32_t swap_journal_port_erase_size(uint32_t address) {
+    return sim_flash_erase_size(address);
+}
+
+/*******************************************************************************
+ * Function Name: swap_journal_port_program_size
+ ********************************************************************************
+ * Returns the program unit at the address: a row of the code flash, 32 bytes
+ * of the work flash, 0 outside the flash.
+ *******************************************************************************/
+uint32_t swap_journal_port_program_size(uint32_t address) {
+    uint32_t erase_size = sim_flash_erase_size(address);
+
+    if (erase_size == 0u) {
+        return 0u;
+    }
+    return ((erase_size == SIM_SWAP_WORK_LARGE_SIZE) || (erase_size == SIM_SWAP_WORK_SMALL_SIZE)) ?
+           SIM_SWAP_WORK_ROW_SIZE : SIM_SWAP_CODE_ROW_SIZE;
+}
+
+/*******************************************************************************
+ * Function Name: swap_journal_port_erase
+ ********************************************************************************
+ * Erases the sector that contains the address. A power cut leaves a random
+ * part of the sector erased and the other bytes with random bits set.
+ *
+ * Return:
+ *  0 on success, -1 on an address error or a power cut.
+ *******************************************************************************/
+int swap_journal_port_erase(uint32_t address) {
+    uint32_t erase_size = sim_flash_erase_size(address);
+    uint32_t start;
+
+    if (!port_powered || (erase_size == 0u) || (erase_size > SIM_SWAP_MAX_SECTOR_SIZE)) {
+        return -1;
+    }
+    start = address - (address % erase_size);
+    if (!port_start()) {
+        uint32_t erased = port_next_random() % erase_size;
+
+        (void)sim_flash_read(start, port_sector, erase_size);
+        memset(port_sector, SIM_FLASH_ERASED_VALUE, erased);
+        for (uint32_t i = erased; i < erase_size; i++) {
+            port_sector[i] |= (uint8_t)port_next_random();
+        }
+        (void)sim_flash_load(start, port_sector, erase_size);
+        return -1;
+    }
+
+    if (erase_size == SIM_SWAP_WORK_SMALL_SIZE) {
+        port_stats.small_erases++;
+        port_stats.time_us += port_timing.small_erase_us;
+    } else if (erase_size == SIM_SWAP_WORK_LARGE_SIZE) {
+        port_stats.work_erases++;
+        port_stats.time_us += port_timing.work_erase_us;
+    } else {
+        port_stats.code_erases++;
+        port_stats.time_us += port_timing.code_erase_us;
+    }
+    return sim_flash_erase(start);
+}
+
+/*******************************************************************************
+ * Function Name: swap_journal_port_program
+ ********************************************************************************
+ * Programs one program unit, which must be erased. A power cut leaves a
+ * random part of the data programmed and the other bytes with random bits
+ * cleared.
+ *
+ * Return:
+ *  0 on success, -1 on an address error or a power cut.
+ *******************************************************************************/
+int swap_journal_port_program(uint32_t address, const uint8_t *data, uint32_t length) {
+    uint32_t unit = swap_journal_port_program_size(address);
+
+    if (!port_powered || (unit == 0u) || (length != unit) || ((address % unit) != 0u)) {
+        return -1;
+    }
+    if (!port_start()) {
+        uint32_t programmed = port_next_random() % length;
+
+        memcpy(port_sector, data, programmed);
+        (void)sim_flash_read(address + programmed, &port_sector[programmed], length - programmed);
+        for (uint32_t i = programmed; i < length; i++) {
+            port_sector[i] &= (uint8_t)(data[i] | port_next_random());
+        }
+        (void)sim_flash_load(address, port_sector, length);
+        return -1;
+    }
+
+    if (unit == SIM_SWAP_WORK_ROW_SIZE) {
+        port_stats.work_programs++;
+        port_stats.time_us += port_timing.work_program_us;
+    } else {
+        port_stats.code_programs++;
+        port_stats.time_us += port_timing.code_program_us;
+    }
+    return sim_flash_program(address, data, length);
+}
+
+/*******************************************************************************
+ * Function Name: swap_journal_port_ptr
+ ********************************************************************************
+ * Returns a pointer for reads of a range of the flash model.
+ *******************************************************************************/
+const uint8_t *swap_journal_port_ptr(uint32_t address, uint32_t length) {
+    return sim_flash_ptr(address, length);
+}
+
+/* [] END OF FILE */
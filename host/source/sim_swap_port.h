@@ -0,0 +1,89 @@
+/******************************************************************************
+ * File Name:   sim_swap_port.h
+ *
+ * Description: Host flash port of the journaled swap of the bootloader. Operations complete
+ *              at once in the flash model, their modelled durations add up, and the power can
+ *              be cut in the middle of any operation.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef SIM_SWAP_PORT_H
+#define SIM_SWAP_PORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Duration of the flash operations, in microseconds */
+typedef struct {
+    /* Erasing a code flash sector */
+    uint32_t code_erase_us;
+    /* Erasing a large (2 KB) work flash sector */
+    uint32_t work_erase_us;
+    /* Erasing a small (128-byte) work flash sector */
+    uint32_t small_erase_us;
+    /* Programming a 512-byte code flash row */
+    uint32_t code_program_us;
+    /* Programming 32 bytes of work flash */
+    uint32_t work_program_us;
+} sim_swap_timing_t;
+
+/* Operation counters, reset with sim_swap_port_stats_reset() */
+typedef struct {
+    uint32_t code_erases;
+    uint32_t work_erases;
+    uint32_t small_erases;
+    uint32_t code_programs;
+    uint32_t work_programs;
+    uint64_t time_us;
+} sim_swap_port_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+void sim_swap_port_set_timing(const sim_swap_timing_t *timing);
+void sim_swap_port_stats_reset(void);
+void sim_swap_port_stats_get(sim_swap_port_stats_t *stats);
+uint64_t sim_swap_port_ops(void);
+void sim_swap_port_cut_after(uint64_t ops, uint32_t seed);
+bool sim_swap_port_powered(void);
+void sim_swap_port_power_on(void);
+
+#endif /* SIM_SWAP_PORT_H */
+
+/* [] END OF FILE */
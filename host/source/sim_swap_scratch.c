@@ -0,0 +1,310 @@
+/******************************************************************************
+ * File Name:   sim_swap_scratch.c
+ *
+ * Description: Model of the MCUboot swap using scratch with the swap status partition, for the
+ *              comparison with the journaled swap. The slots are swapped from their last used
+ *              scratch-sized chunk down to the first one, in three steps per chunk: secondary
+ *              to scratch, primary to secondary, scratch to primary. Each step erases its whole
+ *              destination, copies every byte, and is followed by a status update, which
+ *              rewrites a 512-byte row of the status partition with the progress. The rows
+ *              are used in turn, so an interrupted swap resumes from the last step recorded.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "dfu_packet.h"
+#include "sim_flash.h"
+#include "sim_swap_scratch.h"
+#include "swap_journal.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Status row of the swap status partition */
+#define SIM_SWAP_STATUS_ROW_SIZE    (512u)
+
+/*
+ * Status record at the start of a row, the other bytes of the row are zero:
+ * [0..3]   magic "SWPS"
+ * [4..7]   sequence number, the row is the sequence number modulo the rows
+ * [8]      SIM_SWAP_RECORD_OPEN or SIM_SWAP_RECORD_DONE
+ * [9]      swap type
+ * [10]     chunks of the swap
+ * [11]     chunk
+ * [12]     steps of the chunk done, 0 to 3
+ * [28..31] CRC-32C of bytes 0 to 27
+ */
+#define SIM_SWAP_RECORD_MAGIC       (0x53505753u)
+#define SIM_SWAP_RECORD_SIZE        (32u)
+#define SIM_SWAP_RECORD_OPEN        (1u)
+#define SIM_SWAP_RECORD_DONE        (2u)
+#define SIM_SWAP_STEPS              (3u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    bool valid;
+    uint32_t seq;
+    uint8_t state;
+    uint8_t swap_type;
+    uint8_t chunks;
+    uint8_t chunk;
+    uint8_t step;
+} scratch_record_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static uint8_t scratch_buf[SIM_SWAP_STATUS_ROW_SIZE];
+
+/*******************************************************************************
+ * Function Name: scratch_erase
+ ********************************************************************************
+ * Erases every sector of a range.
+ *******************************************************************************/
+static int scratch_erase(uint32_t address, uint32_t length) {
+    for (uint32_t off = 0u; off < length;) {
+        uint32_t erase_size = swap_journal_port_erase_size(address + off);
+
+        if ((erase_size == 0u) || (swap_journal_port_erase(address + off) != 0)) {
+            return -1;
+        }
+        off += erase_size;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: scratch_copy
+ ********************************************************************************
+ * Erases a range and copies another range to it, every program unit.
+ *******************************************************************************/
+static int scratch_copy(uint32_t dst, uint32_t src, uint32_t length) {
+    if (scratch_erase(dst, length) != 0) {
+        return -1;
+    }
+    for (uint32_t off = 0u; off < length;) {
+        uint32_t unit = swap_journal_port_program_size(dst + off);
+
+        if ((unit == 0u) || (unit > sizeof(scratch_buf)) ||
+            (sim_flash_read(src + off, scratch_buf, unit) != 0) ||
+            (swap_journal_port_program(dst + off, scratch_buf, unit) != 0)) {
+            return -1;
+        }
+        off += unit;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: scratch_latest
+ ********************************************************************************
+ * Finds the valid status record with the highest sequence number.
+ *******************************************************************************/
+static void scratch_latest(const sim_swap_scratch_cfg_t *cfg, scratch_record_t *record) {
+    uint32_t rows = cfg->status_size / SIM_SWAP_STATUS_ROW_SIZE;
+
+    memset(record, 0, sizeof(*record));
+    for (uint32_t row = 0u; row < rows; row++) {
+        const uint8_t *p = sim_flash_ptr(cfg->status + (row * SIM_SWAP_STATUS_ROW_SIZE), SIM_SWAP_RECORD_SIZE);
+        uint32_t seq;
+
+        if ((p == NULL) || (dfu_packet_get_u32(p) != SIM_SWAP_RECORD_MAGIC) ||
+            (dfu_packet_get_u32(&p[28]) != dfu_packet_crc32c(0u, p, 28u))) {
+            continue;
+        }
+        seq = dfu_packet_get_u32(&p[4]);
+        if (!record->valid || (seq > record->seq)) {
+            record->valid = true;
+            record->seq = seq;
+            record->state = p[8];
+            record->swap_type = p[9];
+            record->chunks = p[10];
+            record->chunk = p[11];
+            record->step = p[12];
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: scratch_status_update
+ ********************************************************************************
+ * Rewrites the next status row of the partition with the record.
+ *******************************************************************************/
+static int scratch_status_update(const sim_swap_scratch_cfg_t *cfg, scratch_record_t *record,
+                                 sim_swap_scratch_stats_t *stats) {
+    uint32_t rows = cfg->status_size / SIM_SWAP_STATUS_ROW_SIZE;
+    uint32_t row;
+
+    record->seq++;
+    row = cfg->status + ((record->seq % rows) * SIM_SWAP_STATUS_ROW_SIZE);
+    if (scratch_erase(row, SIM_SWAP_STATUS_ROW_SIZE) != 0) {
+        return -1;
+    }
+    memset(scratch_buf, 0, sizeof(scratch_buf));
+    dfu_packet_put_u32(scratch_buf, SIM_SWAP_RECORD_MAGIC);
+    dfu_packet_put_u32(&scratch_buf[4], record->seq);
+    scratch_buf[8] = record->state;
+    scratch_buf[9] = record->swap_type;
+    scratch_buf[10] = record->chunks;
+    scratch_buf[11] = record->chunk;
+    scratch_buf[12] = record->step;
+    dfu_packet_put_u32(&scratch_buf[28], dfu_packet_crc32c(0u, scratch_buf, 28u));
+    for (uint32_t off = 0u; off < SIM_SWAP_STATUS_ROW_SIZE;) {
+        uint32_t unit = swap_journal_port_program_size(row + off);
+
+        if ((unit == 0u) || (swap_journal_port_program(row + off, &scratch_buf[off], unit) != 0)) {
+            return -1;
+        }
+        off += unit;
+    }
+    stats->status_updates++;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: sim_swap_scratch_state
+ ********************************************************************************
+ * Reads the state of the latest swap from the status partition.
+ *
+ * Parameters:
+ *  cfg            Slots, scratch area and status partition.
+ *  swap_type      Receives the swap type of an open or swapped swap.
+ *******************************************************************************/
+sim_swap_scratch_state_t sim_swap_scratch_state(const sim_swap_scratch_cfg_t *cfg, uint8_t *swap_type) {
+    scratch_record_t record;
+
+    scratch_latest(cfg, &record);
+    if (!record.valid || (record.state != SIM_SWAP_RECORD_OPEN)) {
+        return SIM_SWAP_SCRATCH_NONE;
+    }
+    *swap_type = record.swap_type;
+    if ((record.chunks == 0u) || ((record.chunk == 0u) && (record.step == SIM_SWAP_STEPS))) {
+        return SIM_SWAP_SCRATCH_SWAPPED;
+    }
+    return SIM_SWAP_SCRATCH_OPEN;
+}
+
+/*******************************************************************************
+ * Function Name: sim_swap_scratch_run
+ ********************************************************************************
+ * Swaps the slots as the MCUboot swap using scratch does, or resumes the
+ * open swap from its last status update.
+ *
+ * Parameters:
+ *  cfg            Slots, scratch area and status partition.
+ *  swap_type      Swap type recorded for a new swap.
+ *  stats          Receives the number of chunks and status updates.
+ *
+ * Return:
+ *  0 on success, -1 on a flash error.
+ *******************************************************************************/
+int sim_swap_scratch_run(const sim_swap_scratch_cfg_t *cfg, uint8_t swap_type, sim_swap_scratch_stats_t *stats) {
+    uint32_t size = cfg->scratch_size;
+    scratch_record_t record;
+
+    memset(stats, 0, sizeof(*stats));
+    scratch_latest(cfg, &record);
+    if (!record.valid || (record.state != SIM_SWAP_RECORD_OPEN)) {
+        uint32_t chunks = 0u;
+
+        /* MCUboot swaps up to the end of the larger image */
+        for (uint32_t i = 0u; i < cfg->slot_size / size; i++) {
+            if (!sim_flash_is_erased(cfg->primary + (i * size), size) ||
+                !sim_flash_is_erased(cfg->secondary + (i * size), size)) {
+                chunks = i + 1u;
+            }
+        }
+        record.state = SIM_SWAP_RECORD_OPEN;
+        record.swap_type = swap_type;
+        record.chunks = (uint8_t)chunks;
+        record.chunk = (uint8_t)((chunks != 0u) ? (chunks - 1u) : 0u);
+        record.step = 0u;
+        if (scratch_status_update(cfg, &record, stats) != 0) {
+            return -1;
+        }
+    }
+
+    while ((record.chunks != 0u) && ((record.chunk != 0u) || (record.step < SIM_SWAP_STEPS))) {
+        uint32_t primary;
+        uint32_t secondary;
+        int rc;
+
+        if (record.step == SIM_SWAP_STEPS) {
+            record.chunk--;
+            record.step = 0u;
+        }
+        primary = cfg->primary + (record.chunk * size);
+        secondary = cfg->secondary + (record.chunk * size);
+        switch (record.step) {
+        case 0u: rc = scratch_copy(cfg->scratch, secondary, size); break;
+        case 1u: rc = scratch_copy(secondary, primary, size); break;
+        default: rc = scratch_copy(primary, cfg->scratch, size); break;
+        }
+        record.step++;
+        if ((rc != 0) || (scratch_status_update(cfg, &record, stats) != 0)) {
+            return -1;
+        }
+        if (record.step == SIM_SWAP_STEPS) {
+            stats->chunks++;
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: sim_swap_scratch_close
+ ********************************************************************************
+ * Records that the trailers of the swapped slots are written, so that the
+ * next swap starts from the first step.
+ *
+ * Return:
+ *  0 on success, -1 on a flash error.
+ *******************************************************************************/
+int sim_swap_scratch_close(const sim_swap_scratch_cfg_t *cfg) {
+    sim_swap_scratch_stats_t stats;
+    scratch_record_t record;
+
+    scratch_latest(cfg, &record);
+    if (!record.valid || (record.state != SIM_SWAP_RECORD_OPEN)) {
+        return 0;
+    }
+    record.state = SIM_SWAP_RECORD_DONE;
+    return scratch_status_update(cfg, &record, &stats);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * File Name:   sim_swap_scratch.h
+ *
+ * Description: Model of the MCUboot swap using scratch with the swap status partition of the
+ *              edge protect bootloader, as the reference of the journaled swap.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef SIM_SWAP_SCRATCH_H
+#define SIM_SWAP_SCRATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t primary;
+    uint32_t secondary;
+    uint32_t scratch;
+    /* Size of the scratch area, a multiple of the sectors of the slots */
+    uint32_t scratch_size;
+    uint32_t slot_size;
+    /* Swap status partition */
+    uint32_t status;
+    uint32_t status_size;
+} sim_swap_scratch_cfg_t;
+
+typedef enum {
+    /* No swap, or the latest one is closed */
+    SIM_SWAP_SCRATCH_NONE,
+    /* The latest swap was interrupted */
+    SIM_SWAP_SCRATCH_OPEN,
+    /* The latest swap swapped all chunks, the trailers may be outdated */
+    SIM_SWAP_SCRATCH_SWAPPED
+} sim_swap_scratch_state_t;
+
+typedef struct {
+    uint32_t chunks;
+    uint32_t status_updates;
+} sim_swap_scratch_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+sim_swap_scratch_state_t sim_swap_scratch_state(const sim_swap_scratch_cfg_t *cfg, uint8_t *swap_type);
+int sim_swap_scratch_run(const sim_swap_scratch_cfg_t *cfg, uint8_t swap_type, sim_swap_scratch_stats_t *stats);
+int sim_swap_scratch_close(const sim_swap_scratch_cfg_t *cfg);
+
+#endif /* SIM_SWAP_SCRATCH_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * File Name:   sim_time.c
+ *
+ * Description: Monotonic time helpers for the host simulator.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <time.h>
+#include "sim_time.h"
+
+/*******************************************************************************
+ * Function Name: sim_time_us
+ ********************************************************************************
+ * Returns the monotonic time, in microseconds.
+ *******************************************************************************/
+uint64_t sim_time_us(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000u) + ((uint64_t)ts.tv_nsec / 1000u);
+}
+
+/*******************************************************************************
+ * Function Name: sim_sleep_us
+ ********************************************************************************
+ * Sleeps for the given time, yielding the CPU.
+ *
+ * Parameters:
+ *  microseconds   Time to sleep.
+ *******************************************************************************/
+void sim_sleep_us(uint64_t microseconds) {
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(microseconds / 1000000u);
+    ts.tv_nsec = (long)((microseconds % 1000000u) * 1000u);
+    while (nanosleep(&ts, &ts) != 0) {
+    }
+}
+
+/*******************************************************************************
+ * Function Name: sim_busy_wait_us
+ ********************************************************************************
+ * Spins for the given time. Used where the modelled target operation keeps
+ * the core busy, e.g. a blocking flash program.
+ *
+ * Parameters:
+ *  microseconds   Time to spin.
+ *******************************************************************************/
+void sim_busy_wait_us(uint64_t microseconds) {
+    uint64_t end = sim_time_us() + microseconds;
+
+    while (sim_time_us() < end) {
+    }
+}
+
+/* [] END OF FILE */
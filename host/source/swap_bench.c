@@ -0,0 +1,514 @@
+/******************************************************************************
+ * File Name:   swap_bench.c
+ *
+ * Description: Benchmark and power failure test of the journaled swap of the bootloader. It
+ *              swaps two images in the flash model with the MCUboot swap using scratch and
+ *              with the journaled swap, reports their flash operations and modelled time, then
+ *              cuts the power at random operations of upgrade and revert swaps and checks that
+ *              the following boots complete them with the slots intact.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim_flash.h"
+#include "sim_swap_port.h"
+#include "sim_swap_scratch.h"
+#include "swap_journal.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define BENCH_DEFAULT_PRIMARY_SIZE  (0x11000u)
+#define BENCH_DEFAULT_SECONDARY_SIZE (0x12000u)
+#define BENCH_DEFAULT_TRIALS        (500u)
+
+/* Boots allowed to complete one swap in the power failure test */
+#define BENCH_MAX_BOOTS             (64u)
+
+/* Image trailers in the power failure test: the upgrade request of the
+ * secondary slot and the revert request of the primary slot, each a small
+ * sector of the swap status area */
+#define BENCH_REQUEST_ADDR          (SWAP_STATUS_ADDR)
+#define BENCH_REVERT_ADDR           (SWAP_STATUS_ADDR + 0x80u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t primary_size;
+    uint32_t secondary_size;
+    uint32_t same_size;
+    sim_swap_timing_t timing;
+    uint32_t trials;
+    uint32_t seed;
+    int json;
+} bench_options_t;
+
+typedef struct {
+    sim_swap_port_stats_t flash;
+    uint32_t status_updates;
+    swap_journal_stats_t journal;
+} bench_swap_t;
+
+typedef struct {
+    uint32_t trials;
+    uint32_t cuts;
+    uint32_t boots;
+    uint32_t resumed;
+    uint32_t failures;
+} bench_cuts_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const swap_journal_cfg_t swap_cfg = {
+    .primary = PRIMARY_IMG_START,
+    .secondary = SECONDARY_IMG_START,
+    .scratch = SWAP_SCRATCH_ADDR,
+    .sector_size = SWAP_SCRATCH_SIZE,
+    .sector_count = SLOT_SIZE / SWAP_SCRATCH_SIZE,
+};
+
+static uint8_t image_primary[SLOT_SIZE];
+static uint8_t image_secondary[SLOT_SIZE];
+
+/*******************************************************************************
+ * Function Name: usage
+ ********************************************************************************
+ * Prints the command line help.
+ *******************************************************************************/
+static void usage(const char *name, const bench_options_t *opt) {
+    printf("Usage: %s [options]\n"
+           "  --primary-size N    size of the image in the primary slot (default 0x%x)\n"
+           "  --secondary-size N  size of the image in the secondary slot (default 0x%x)\n"
+           "  --same N            leading bytes the images have in common (default 0)\n"
+           "  --code-erase-us N   modelled time to erase a code flash sector (default %u)\n"
+           "  --work-erase-us N   modelled time to erase a 2 KB work flash sector (default %u)\n"
+           "  --small-erase-us N  modelled time to erase a 128-byte work flash sector (default %u)\n"
+           "  --code-program-us N modelled time to program a 512-byte code flash row (default %u)\n"
+           "  --work-program-us N modelled time to program 32 bytes of work flash (default %u)\n"
+           "  --trials N          power failure trials, 0 to skip the test (default %u)\n"
+           "  --seed N            seed of the images and power cuts (default 1)\n"
+           "  --json              machine-readable output\n",
+           name, BENCH_DEFAULT_PRIMARY_SIZE, BENCH_DEFAULT_SECONDARY_SIZE, opt->timing.code_erase_us,
+           opt->timing.work_erase_us, opt->timing.small_erase_us, opt->timing.code_program_us,
+           opt->timing.work_program_us, BENCH_DEFAULT_TRIALS);
+}
+
+/*******************************************************************************
+ * Function Name: bench_random
+ ********************************************************************************
+ * Returns the next number of a xorshift32 sequence.
+ *******************************************************************************/
+static uint32_t bench_random(uint32_t *state) {
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/*******************************************************************************
+ * Function Name: bench_images
+ ********************************************************************************
+ * Builds the two images, random bytes followed by erased flash.
+ *******************************************************************************/
+static void bench_images(const bench_options_t *opt) {
+    uint32_t state = (opt->seed * 2654435761u) | 1u;
+
+    memset(image_primary, SIM_FLASH_ERASED_VALUE, SLOT_SIZE);
+    memset(image_secondary, SIM_FLASH_ERASED_VALUE, SLOT_SIZE);
+    for (uint32_t i = 0u; i < opt->primary_size; i++) {
+        image_primary[i] = (uint8_t)bench_random(&state);
+    }
+    for (uint32_t i = 0u; i < opt->secondary_size; i++) {
+        image_secondary[i] = ((i < opt->same_size) && (i < opt->primary_size)) ?
+                             image_primary[i] : (uint8_t)bench_random(&state);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: bench_load
+ ********************************************************************************
+ * Erases the flash model and places the images in the slots.
+ *******************************************************************************/
+static int bench_load(void) {
+    if ((sim_flash_init() != 0) ||
+        (sim_flash_load(PRIMARY_IMG_START, image_primary, SLOT_SIZE) != 0) ||
+        (sim_flash_load(SECONDARY_IMG_START, image_secondary, SLOT_SIZE) != 0)) {
+        return -1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: bench_slots_hold
+ ********************************************************************************
+ * Returns true if the slots hold the given images.
+ *******************************************************************************/
+static bool bench_slots_hold(const uint8_t *primary, const uint8_t *secondary) {
+    const uint8_t *p = sim_flash_ptr(PRIMARY_IMG_START, SLOT_SIZE);
+    const uint8_t *s = sim_flash_ptr(SECONDARY_IMG_START, SLOT_SIZE);
+
+    return (p != NULL) && (s != NULL) && (memcmp(p, primary, SLOT_SIZE) == 0) &&
+           (memcmp(s, secondary, SLOT_SIZE) == 0);
+}
+
+/*******************************************************************************
+ * Function Name: bench_set_request
+ ********************************************************************************
+ * Writes a request trailer of the power failure test.
+ *******************************************************************************/
+static void bench_set_request(uint32_t address) {
+    static const uint8_t request[4] = { 0x77u, 0xC2u, 0x95u, 0xF3u };
+
+    (void)sim_flash_load(address, request, sizeof(request));
+}
+
+/*******************************************************************************
+ * Function Name: bench_boot
+ ********************************************************************************
+ * One boot of the power failure test, as boot_perform_update_hook() with the
+ * journaled swap: the swap runs if there is a request, then the requests are
+ * erased, primary trailer first, and the swap is closed.
+ *
+ * Return:
+ *  0 once nothing is left to do, -1 if the power failed.
+ *******************************************************************************/
+static int bench_boot(bench_cuts_t *cuts) {
+    bool request = !sim_flash_is_erased(BENCH_REQUEST_ADDR, 4u);
+    bool revert = !sim_flash_is_erased(BENCH_REVERT_ADDR, 4u);
+    swap_journal_state_t state;
+
+    if (!request && !revert) {
+        return 0;
+    }
+    state = swap_journal_state(&swap_cfg);
+    if (state == SWAP_JOURNAL_STATE_OPEN) {
+        cuts->resumed++;
+    }
+    if ((state == SWAP_JOURNAL_STATE_COMPLETE) && !request) {
+        if (swap_journal_close() != 0) {
+            return -1;
+        }
+    }
+    if ((swap_journal_run(&swap_cfg) != 0) ||
+        (swap_journal_port_erase(BENCH_REVERT_ADDR) != 0) ||
+        (swap_journal_port_erase(BENCH_REQUEST_ADDR) != 0) ||
+        (swap_journal_close() != 0)) {
+        return -1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: bench_boot_until_done
+ ********************************************************************************
+ * Boots until the swap is done. After each power cut, the power may fail
+ * again at a random operation of the next boot.
+ *
+ * Return:
+ *  0 on success, -1 if the swap is not done after BENCH_MAX_BOOTS boots.
+ *******************************************************************************/
+static int bench_boot_until_done(uint64_t ops, uint32_t *state, bench_cuts_t *cuts) {
+    for (uint32_t boot = 0u; boot < BENCH_MAX_BOOTS; boot++) {
+        cuts->boots++;
+        if (bench_boot(cuts) == 0) {
+            return 0;
+        }
+        if (sim_swap_port_powered()) {
+            /* A flash error other than a power cut */
+            return -1;
+        }
+        cuts->cuts++;
+        sim_swap_port_power_on();
+        if ((bench_random(state) % 4u) == 0u) {
+            sim_swap_port_cut_after(1u + (bench_random(state) % ops), bench_random(state));
+        }
+    }
+    return -1;
+}
+
+/*******************************************************************************
+ * Function Name: bench_scratch
+ ********************************************************************************
+ * Swaps the slots with the model of the MCUboot swap using scratch.
+ *******************************************************************************/
+static int bench_scratch(bench_swap_t *result) {
+    const sim_swap_scratch_cfg_t cfg = {
+        .primary = PRIMARY_IMG_START,
+        .secondary = SECONDARY_IMG_START,
+        .scratch = SWAP_SCRATCH_ADDR,
+        .scratch_size = SWAP_SCRATCH_SIZE,
+        .slot_size = SLOT_SIZE,
+        .status = SWAP_STATUS_ADDR,
+        .status_size = SWAP_STATUS_SIZE,
+    };
+    sim_swap_scratch_stats_t stats;
+
+    memset(result, 0, sizeof(*result));
+    if (bench_load() != 0) {
+        return -1;
+    }
+    sim_swap_port_stats_reset();
+    if ((sim_swap_scratch_run(&cfg, 0u, &stats) != 0) || !bench_slots_hold(image_secondary, image_primary)) {
+        return -1;
+    }
+    sim_swap_port_stats_get(&result->flash);
+    result->status_updates = stats.status_updates;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: bench_journal
+ ********************************************************************************
+ * Swaps the slots with the journaled swap, and back.
+ *
+ * Parameters:
+ *  result         Receives the counters of the first swap.
+ *  ops            Receives the flash operations of both swaps.
+ *******************************************************************************/
+static int bench_journal(bench_swap_t *result, uint64_t *ops) {
+    uint64_t start;
+
+    memset(result, 0, sizeof(*result));
+    if (bench_load() != 0) {
+        return -1;
+    }
+    start = sim_swap_port_ops();
+    sim_swap_port_stats_reset();
+    if ((swap_journal_run(&swap_cfg) != 0) || (swap_journal_close() != 0) ||
+        !bench_slots_hold(image_secondary, image_primary)) {
+        return -1;
+    }
+    sim_swap_port_stats_get(&result->flash);
+    swap_journal_stats_get(&result->journal);
+
+    if ((swap_journal_run(&swap_cfg) != 0) || (swap_journal_close() != 0) ||
+        !bench_slots_hold(image_primary, image_secondary)) {
+        return -1;
+    }
+    *ops = sim_swap_port_ops() - start;
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: bench_cuts
+ ********************************************************************************
+ * Power failure test: each trial requests an upgrade swap and a revert
+ * swap, with the power cut at a random operation of the first boot and
+ * possibly again during the following ones.
+ *******************************************************************************/
+static int bench_cuts(const bench_options_t *opt, uint64_t ops, bench_cuts_t *cuts) {
+    uint32_t state = (opt->seed * 2246822519u) | 1u;
+
+    memset(cuts, 0, sizeof(*cuts));
+    for (uint32_t trial = 0u; trial < opt->trials; trial++) {
+        bool ok;
+
+        if (bench_load() != 0) {
+            return -1;
+        }
+        cuts->trials++;
+        sim_swap_port_power_on();
+        sim_swap_port_cut_after(1u + (bench_random(&state) % ops), bench_random(&state));
+
+        bench_set_request(BENCH_REQUEST_ADDR);
+        ok = (bench_boot_until_done(ops, &state, cuts) == 0) && bench_slots_hold(image_secondary, image_primary);
+        if (ok) {
+            bench_set_request(BENCH_REVERT_ADDR);
+            ok = (bench_boot_until_done(ops, &state, cuts) == 0) && bench_slots_hold(image_primary, image_secondary);
+        }
+        if (!ok) {
+            fprintf(stderr, "trial %u: the slots are not swapped\n", trial);
+            cuts->failures++;
+        }
+    }
+    sim_swap_port_power_on();
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: print_swap
+ ********************************************************************************
+ * Prints the counters of one swap.
+ *******************************************************************************/
+static void print_swap(const char *name, const bench_swap_t *swap) {
+    const sim_swap_port_stats_t *f = &swap->flash;
+
+    printf("  %-20s: %.1f ms, %u erases (%u code, %u work, %u small), %u programs (%u code, %u work)\n",
+           name, f->time_us / 1000.0, f->code_erases + f->work_erases + f->small_erases, f->code_erases,
+           f->work_erases, f->small_erases, f->code_programs + f->work_programs, f->code_programs,
+           f->work_programs);
+}
+
+/*******************************************************************************
+ * Function Name: print_swap_json
+ ********************************************************************************
+ * Prints the counters of one swap as JSON.
+ *******************************************************************************/
+static void print_swap_json(const bench_swap_t *swap) {
+    const sim_swap_port_stats_t *f = &swap->flash;
+
+    printf("{\"time_us\": %llu, \"code_erases\": %u, \"work_erases\": %u, \"small_erases\": %u, "
+           "\"code_programs\": %u, \"work_programs\": %u}",
+           (unsigned long long)f->time_us, f->code_erases, f->work_erases, f->small_erases, f->code_programs,
+           f->work_programs);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Runs the benchmark and the power failure test.
+ *******************************************************************************/
+int main(int argc, char *argv[]) {
+    static const struct option long_options[] = {
+        { "primary-size",   required_argument, NULL, 'p' },
+        { "secondary-size", required_argument, NULL, 's' },
+        { "same",           required_argument, NULL, 'm' },
+        { "code-erase-us",  required_argument, NULL, 'E' },
+        { "work-erase-us",  required_argument, NULL, 'W' },
+        { "small-erase-us", required_argument, NULL, 'V' },
+        { "code-program-us", required_argument, NULL, 'P' },
+        { "work-program-us", required_argument, NULL, 'Q' },
+        { "trials",         required_argument, NULL, 't' },
+        { "seed",           required_argument, NULL, 'S' },
+        { "json",           no_argument,       NULL, 'j' },
+        { "help",           no_argument,       NULL, 'h' },
+        { NULL,             0,                 NULL, 0 },
+    };
+    /* Assumed typical durations, set them from the datasheet of the device */
+    bench_options_t opt = {
+        .primary_size = BENCH_DEFAULT_PRIMARY_SIZE,
+        .secondary_size = BENCH_DEFAULT_SECONDARY_SIZE,
+        .same_size = 0u,
+        .timing = {
+            .code_erase_us = 45000u,
+            .work_erase_us = 20000u,
+            .small_erase_us = 8000u,
+            .code_program_us = 1300u,
+            .work_program_us = 70u,
+        },
+        .trials = BENCH_DEFAULT_TRIALS,
+        .seed = 1u,
+        .json = 0,
+    };
+    bench_swap_t scratch;
+    bench_swap_t journal;
+    bench_cuts_t cuts;
+    uint64_t ops = 0u;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'p': opt.primary_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 's': opt.secondary_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'm': opt.same_size = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'E': opt.timing.code_erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'W': opt.timing.work_erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'V': opt.timing.small_erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'P': opt.timing.code_program_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'Q': opt.timing.work_program_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 't': opt.trials = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'S': opt.seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'j': opt.json = 1; break;
+        default: usage(argv[0], &opt); return (c == 'h') ? 0 : 2;
+        }
+    }
+    if ((opt.primary_size > SLOT_SIZE) || (opt.secondary_size > SLOT_SIZE)) {
+        fprintf(stderr, "the images do not fit in the 0x%x-byte slots\n", SLOT_SIZE);
+        return 2;
+    }
+
+    sim_swap_port_set_timing(&opt.timing);
+    bench_images(&opt);
+    if (bench_scratch(&scratch) != 0) {
+        fprintf(stderr, "the swap using scratch failed\n");
+        return 1;
+    }
+    if (bench_journal(&journal, &ops) != 0) {
+        fprintf(stderr, "the journaled swap failed\n");
+        return 1;
+    }
+    if ((opt.trials != 0u) && (bench_cuts(&opt, ops, &cuts) != 0)) {
+        fprintf(stderr, "cannot run the power failure test\n");
+        return 1;
+    }
+    if (opt.trials == 0u) {
+        memset(&cuts, 0, sizeof(cuts));
+    }
+
+    if (opt.json) {
+        printf("{\"primary_size\": %u, \"secondary_size\": %u, \"same\": %u, \"sector_size\": %u, \"scratch\": ",
+               opt.primary_size, opt.secondary_size, opt.same_size, SWAP_SCRATCH_SIZE);
+        print_swap_json(&scratch);
+        printf(", \"status_updates\": %u, \"journal\": ", scratch.status_updates);
+        print_swap_json(&journal);
+        printf(", \"journal_entries\": %u, \"sectors_scratch\": %u, \"sectors_direct\": %u, "
+               "\"sectors_skipped\": %u, \"scratch_in_slot\": %s, "
+               "\"trials\": %u, \"cuts\": %u, \"boots\": %u, \"resumed\": %u, \"failures\": %u}\n",
+               journal.journal.entries, journal.journal.sectors_scratch, journal.journal.sectors_direct,
+               journal.journal.sectors_skipped, (journal.journal.scratch_in_slot != 0u) ? "true" : "false",
+               cuts.trials, cuts.cuts, cuts.boots, cuts.resumed, cuts.failures);
+    } else {
+        printf("Swap benchmark\n");
+        printf("  images              : 0x%x and 0x%x bytes, 0x%x in common, 0x%x-byte slots\n",
+               opt.primary_size, opt.secondary_size, opt.same_size, SLOT_SIZE);
+        printf("  flash model         : erase %u/%u/%u us (code/work/small), program %u/%u us (code/work)\n",
+               opt.timing.code_erase_us, opt.timing.work_erase_us, opt.timing.small_erase_us,
+               opt.timing.code_program_us, opt.timing.work_program_us);
+        print_swap("swap using scratch", &scratch);
+        printf("  %-20s: %u status updates\n", "", scratch.status_updates);
+        print_swap("journaled swap", &journal);
+        printf("  %-20s: %u journal entries, sectors: %u through %s scratch, %u direct, %u equal\n", "",
+               journal.journal.entries, journal.journal.sectors_scratch,
+               (journal.journal.scratch_in_slot != 0u) ? "slot" : "work flash", journal.journal.sectors_direct,
+               journal.journal.sectors_skipped);
+        if (opt.trials != 0u) {
+            printf("  power failures      : %u trials, %u cuts, %u boots, %u resumed, %u failures\n",
+                   cuts.trials, cuts.cuts, cuts.boots, cuts.resumed, cuts.failures);
+        }
+    }
+    sim_flash_deinit();
+    return (cuts.failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,201 @@
+"""
+Copyright 2025 Cypress Semiconductor Corporation (an Infineon company)
+or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import sys
+import struct
+import argparse
+
+# Compressed stream format, see dfu_cm7/source/dfu_lz.h
+LZ_MAGIC = 0x5A554644
+LZ_VERSION = 1
+LZ_MIN_MATCH = 3
+LZ_LENGTH_EXT = 15
+
+# Matcher settings, identical to host/source/image_lz.c
+HASH_BITS = 12
+MAX_CHAIN = 64
+GOOD_MATCH = 1024
+
+HEX_RECORD_SIZE = 16
+
+# Code flash row, CY_DFU_ROW_SIZE: the DFU application programs whole rows
+ROW_SIZE = 0x200
+
+
+def hex_load(path, base, erased_value):
+    '''
+        Returns the bytes of an Intel HEX file from base to the end of the
+        row of its last data byte, gaps filled with the erased value
+    '''
+    data = {}
+    upper = 0
+    with open(path, 'r') as file:
+        for line in file:
+            line = line.strip()
+            if not line.startswith(':'):
+                continue
+            record = bytes.fromhex(line[1:])
+            if sum(record) & 0xFF:
+                raise ValueError('checksum error in ' + path)
+            length, offset, kind = record[0], (record[1] << 8) | record[2], record[3]
+            payload = record[4:4 + length]
+            if kind == 0x00:
+                for i, byte in enumerate(payload):
+                    data[upper + offset + i] = byte
+            elif kind == 0x02:
+                upper = ((payload[0] << 8) | payload[1]) << 4
+            elif kind == 0x04:
+                upper = ((payload[0] << 8) | payload[1]) << 16
+            elif kind == 0x01:
+                break
+
+    addresses = [address for address in data if address >= base]
+    if not addresses:
+        raise ValueError('no data at 0x%08x in %s' % (base, path))
+    size = max(addresses) - base + 1
+    size = (size + ROW_SIZE - 1) // ROW_SIZE * ROW_SIZE
+    image = bytearray([erased_value]) * size
+    for address in addresses:
+        image[address - base] = data[address]
+    return bytes(image)
+
+
+def hex_save(path, base, data):
+    '''
+        Writes data at base as an Intel HEX file
+    '''
+    def record(kind, offset, payload):
+        raw = bytes([len(payload), (offset >> 8) & 0xFF, offset & 0xFF, kind]) + payload
+        return ':%s%02X\n' % (raw.hex().upper(), (-sum(raw)) & 0xFF)
+
+    upper = None
+    with open(path, 'w') as file:
+        for pos in range(0, len(data), HEX_RECORD_SIZE):
+            address = base + pos
+            if (address >> 16) != upper:
+                upper = address >> 16
+                file.write(record(0x04, 0, struct.pack('>H', upper)))
+            file.write(record(0x00, address & 0xFFFF, data[pos:pos + HEX_RECORD_SIZE]))
+        file.write(record(0x01, 0, b''))
+
+
+def lz_hash(data, pos):
+    value = data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16)
+    return ((value * 2654435761) & 0xFFFFFFFF) >> (32 - HASH_BITS)
+
+
+def lz_compress(data, window_bits):
+    '''
+        Compresses data into a compressed stream
+    '''
+    size = len(data)
+    window = 1 << window_bits
+    head = [-1] * (1 << HASH_BITS)
+    prev = [-1] * (size + 1)
+    out = bytearray(struct.pack('<IBBHI', LZ_MAGIC, LZ_VERSION, window_bits, 0, size))
+    flag_pos = 0
+    flag_bit = 8
+    i = 0
+
+    while i < size:
+        best_len = 0
+        best_dist = 0
+        if i + LZ_MIN_MATCH <= size:
+            cand = head[lz_hash(data, i)]
+            chain = 0
+            while cand >= 0 and chain < MAX_CHAIN and i - cand <= window:
+                length = 0
+                while i + length < size and data[cand + length] == data[i + length]:
+                    length += 1
+                if length > best_len:
+                    best_len = length
+                    best_dist = i - cand
+                    if best_len >= GOOD_MATCH or i + best_len == size:
+                        break
+                cand = prev[cand]
+                chain += 1
+
+        if flag_bit == 8:
+            flag_pos = len(out)
+            out.append(0)
+            flag_bit = 0
+        if best_len >= LZ_MIN_MATCH:
+            ext = best_len - LZ_MIN_MATCH
+            field = min(ext, LZ_LENGTH_EXT)
+            out[flag_pos] |= 1 << flag_bit
+            out += struct.pack('<H', (best_dist - 1) | (field << 12))
+            if field == LZ_LENGTH_EXT:
+                ext -= LZ_LENGTH_EXT
+                while ext >= 0xFF:
+                    out.append(0xFF)
+                    ext -= 0xFF
+                out.append(ext)
+            step = best_len
+        else:
+            out.append(data[i])
+            step = 1
+        flag_bit += 1
+
+        for pos in range(i, i + step):
+            if pos + LZ_MIN_MATCH <= size:
+                h = lz_hash(data, pos)
+                prev[pos] = head[h]
+                head[h] = pos
+        i += step
+
+    return bytes(out)
+
+
+def run(input_file, output_file, address, window_bits, erased_value):
+    '''
+        Compresses a signed upgrade image for the DFU application
+    '''
+    base = int(address, 0)
+    if not 8 <= window_bits <= 12:
+        print('ERROR: window_bits must be 8 to 12', file=sys.stderr)
+        sys.exit(-1)
+    try:
+        image = hex_load(input_file, base, int(erased_value, 0))
+        stream = lz_compress(image, window_bits)
+        hex_save(output_file, base, stream)
+    except (OSError, ValueError) as error:
+        print('\nERROR: ', error, file=sys.stderr)
+        sys.exit(-1)
+    print('Compressed %d bytes to %d bytes (%.1f%%)' %
+          (len(image), len(stream), 100.0 * len(stream) / len(image)))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compresses a signed upgrade image for the DFU application',
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument('-i', '--input', dest='input_file', required=True,
+                        help='signed image (.hex)')
+    parser.add_argument('-o', '--output', dest='output_file', required=True,
+                        help='compressed image (.hex)')
+    parser.add_argument('-a', '--address', required=True,
+                        help='start address of the image and of the compressed stream')
+    parser.add_argument('-w', '--window_bits', type=int, default=12,
+                        help='largest match distance as a power of two, 8 to 12')
+    parser.add_argument('-R', '--erased_value', default='0xff',
+                        help='value of the gaps of the image')
+    args = parser.parse_args()
+    run(args.input_file, args.output_file, args.address, args.window_bits, args.erased_value)
+
+
+if __name__ == '__main__':
+    main()
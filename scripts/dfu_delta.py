@@ -0,0 +1,222 @@
+"""
+Copyright 2025 Cypress Semiconductor Corporation (an Infineon company)
+or an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import sys
+import struct
+import argparse
+
+from dfu_compress import hex_load, hex_save, lz_compress
+
+# Delta image format, see dfu_cm7/source/dfu_delta.h
+DELTA_MAGIC = 0x44554644
+DELTA_VERSION = 1
+OP_DIFF = 0x01
+OP_EXTRA = 0x02
+OP_SEEK = 0x03
+
+# MCUboot image layout
+IMAGE_MAGIC = 0x96f3b83d
+TLV_INFO_MAGIC = 0x6907
+TLV_PROT_INFO_MAGIC = 0x6908
+
+# Matcher settings, identical to host/source/image_delta.c
+HASH_BITS = 16
+BLOCK = 8
+MAX_CHAIN = 16
+GOOD_MATCH = 256
+LOOKAHEAD = 16
+LOOKAHEAD_MIN = 12
+
+
+def crc32c(data):
+    table = []
+    for i in range(256):
+        crc = i
+        for _ in range(8):
+            crc = (crc >> 1) ^ (0x82F63B78 if crc & 1 else 0)
+        table.append(crc)
+    crc = 0xFFFFFFFF
+    for byte in data:
+        crc = (crc >> 8) ^ table[(crc ^ byte) & 0xFF]
+    return crc ^ 0xFFFFFFFF
+
+
+def image_extent(data):
+    '''
+        Returns the size of the MCUboot image: header, code and TLV areas,
+        without padding and trailer
+    '''
+    if len(data) < 32 or struct.unpack_from('<I', data, 0)[0] != IMAGE_MAGIC:
+        return len(data)
+    hdr_size = struct.unpack_from('<H', data, 8)[0]
+    img_size = struct.unpack_from('<I', data, 12)[0]
+    end = hdr_size + img_size
+    for magic in (TLV_PROT_INFO_MAGIC, TLV_INFO_MAGIC):
+        if end + 4 <= len(data):
+            tlv_magic, tlv_size = struct.unpack_from('<HH', data, end)
+            if tlv_magic == magic:
+                end += tlv_size
+    return min(end, len(data))
+
+
+def block_hash(data, pos):
+    h = 0
+    for i in range(BLOCK):
+        h = (h * 31 + data[pos + i]) & 0xFFFFFFFF
+    return ((h * 2654435761) & 0xFFFFFFFF) >> (32 - HASH_BITS)
+
+
+def leb128(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return out
+
+
+def delta_ops(old, new):
+    '''
+        Diffs new against old into DIFF, EXTRA and SEEK operations
+    '''
+    old_size = len(old)
+    new_size = len(new)
+    head = [-1] * (1 << HASH_BITS)
+    prev = [-1] * (old_size + 1)
+    for pos in range(old_size - BLOCK + 1):
+        h = block_hash(old, pos)
+        prev[pos] = head[h]
+        head[h] = pos
+
+    ops = bytearray()
+    n = 0
+    o = 0
+    extra = 0
+    while n + BLOCK <= new_size:
+        match = -1
+        if o + BLOCK <= old_size and old[o:o + BLOCK] == new[n:n + BLOCK]:
+            match = o
+        else:
+            cand = head[block_hash(new, n)]
+            best = 0
+            chain = 0
+            while cand >= 0 and chain < MAX_CHAIN:
+                length = 0
+                while (length < GOOD_MATCH and n + length < new_size and
+                       cand + length < old_size and old[cand + length] == new[n + length]):
+                    length += 1
+                if length > best:
+                    best = length
+                    match = cand
+                    if best >= GOOD_MATCH:
+                        break
+                cand = prev[cand]
+                chain += 1
+            if best < BLOCK:
+                match = -1
+        if match < 0:
+            n += 1
+            continue
+
+        if n > extra:
+            ops.append(OP_EXTRA)
+            ops += leb128(n - extra)
+            ops += new[extra:n]
+        if match != o:
+            d = match - o
+            ops.append(OP_SEEK)
+            ops += leb128(d * 2 if d >= 0 else -d * 2 - 1)
+            o = match
+
+        length = 0
+        while n + length < new_size and o + length < old_size:
+            if new[n + length] == old[o + length]:
+                length += 1
+                continue
+            if n + length + LOOKAHEAD > new_size or o + length + LOOKAHEAD > old_size:
+                break
+            hits = sum(1 for i in range(LOOKAHEAD) if new[n + length + i] == old[o + length + i])
+            if hits < LOOKAHEAD_MIN:
+                break
+            length += 1
+
+        ops.append(OP_DIFF)
+        ops += leb128(length)
+        ops += bytes((new[n + i] - old[o + i]) & 0xFF for i in range(length))
+        n += length
+        o += length
+        extra = n
+
+    if new_size > extra:
+        ops.append(OP_EXTRA)
+        ops += leb128(new_size - extra)
+        ops += new[extra:]
+    return bytes(ops)
+
+
+def run(base, base_address, input_file, address, output_file, window_bits, erased_value):
+    '''
+        Creates a delta image that the DFU application applies to the image
+        in the primary slot
+    '''
+    if not 8 <= window_bits <= 12:
+        print('ERROR: window_bits must be 8 to 12', file=sys.stderr)
+        sys.exit(-1)
+    try:
+        erased = int(erased_value, 0)
+        old = hex_load(base, int(base_address, 0), erased)
+        old = old[:image_extent(old)]
+        new = hex_load(input_file, int(address, 0), erased)
+        stream = lz_compress(delta_ops(old, new), window_bits)
+        header = struct.pack('<IB3xIII', DELTA_MAGIC, DELTA_VERSION, len(new), len(old), crc32c(old))
+        hex_save(output_file, int(address, 0), header + stream)
+    except (OSError, ValueError) as error:
+        print('\nERROR: ', error, file=sys.stderr)
+        sys.exit(-1)
+    print('Delta of %d bytes against a %d-byte base: %d bytes (%.1f%%)' %
+          (len(new), len(old), len(header) + len(stream), 100.0 * (len(header) + len(stream)) / len(new)))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Creates a delta image that the DFU application applies to the image '
+                    'in the primary slot',
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument('-b', '--base', required=True,
+                        help='signed image running from the primary slot (.hex)')
+    parser.add_argument('-B', '--base_address', required=True,
+                        help='start address of the primary slot')
+    parser.add_argument('-i', '--input', dest='input_file', required=True,
+                        help='signed upgrade image (.hex)')
+    parser.add_argument('-a', '--address', required=True,
+                        help='start address of the upgrade image and of the delta image')
+    parser.add_argument('-o', '--output', dest='output_file', required=True,
+                        help='delta image (.hex)')
+    parser.add_argument('-w', '--window_bits', type=int, default=12,
+                        help='window of the compressed patch, 8 to 12')
+    parser.add_argument('-R', '--erased_value', default='0xff',
+                        help='value of the gaps of the images')
+    args = parser.parse_args()
+    run(args.base, args.base_address, args.input_file, args.address, args.output_file,
+        args.window_bits, args.erased_value)
+
+
+if __name__ == '__main__':
+    main()
@@ -17,6 +17,7 @@ limitations under the License.
 
 import sys
 import json
+import itertools
 import click
 
 APP_LIMIT = 8
@@ -24,6 +25,7 @@ APP_LIMIT = 8
 settings_dict = {
         'overwrite'                 :   'USE_OVERWRITE'
     ,   'swap'                      :   'USE_SWAP'
+    ,   'direct_xip'                :   'USE_DIRECT_XIP'
     ,   'status'                    :   'USE_STATUS'
     ,   'scratch'                   :   'USE_SCRATCH'
     ,   'measured_boot'             :   'USE_MEASURED_BOOT'
@@ -95,6 +97,25 @@ class MemoryRegion(Memory):
         self.erase_sz   : int   = erase_sz
         self.erase_val  : int   = erase_val
         self.type               = type
+        # Optional, used by the layout analysis
+        self.program_sz         : int   = None
+        self.erase_time_us      : int   = None
+        self.program_time_us    : int   = None
+
+    @property
+    def has_timing(self) -> bool:
+        return None not in (self.program_sz, self.erase_time_us, self.program_time_us)
+
+def first_free(region : MemoryRegion, sz : int, placed : list) -> int:
+    ''' First erase sector of a region where sz bytes overlap no placed area
+        @return Address or None
+    '''
+    area = Memory(region.addr, sz)
+    while area.addr + sz <= region.addr + region.sz:
+        if not any(area.overlaps_with(other) for other in placed):
+            return area.addr
+        area.addr += region.erase_sz
+    return None
 
 class BootloaderLayout:
     '''
@@ -108,6 +129,9 @@ class BootloaderLayout:
         self.shared_data        : Memory    = None
         self.shared_upgrade     : Memory    = None
         self.core_name          : int       = None
+        self.area_regions       : dict      = {}
+        # Images run in place from the slot of the highest version
+        self.direct_xip         : bool      = False
 
     @property
     def has_shared_upgrade(self) -> bool:
@@ -135,13 +159,21 @@ class BootloaderLayout:
             for field in fields:
                 area = section.get(field)
                 if area:
-                    setattr(self, field, Memory(int(area['address'], 0),
-                                                int(area['size'], 0)))
+                    # Flash areas may name a region instead of an address,
+                    # they are then placed in it by the memory map
+                    if 'address' not in area and 'region' in area:
+                        self.area_regions[field] = str(area['region'])
+                        setattr(self, field, Memory(None, int(area['size'], 0)))
+                    else:
+                        setattr(self, field, Memory(int(area['address'], 0),
+                                                    int(area['size'], 0)))
 
             core = section.get('core')
             if core:
                 self.core_name = core
 
+            self.direct_xip = bool(section.get('direct_xip', False))
+
         except KeyError as key:
             print('Malformed JSON:', key, 'is missing')
 
@@ -255,7 +287,15 @@ class MemoryMap:
                 if type not in self.region_types:
                     self.region_types.append(type)
 
-                self.regions.append(MemoryRegion(addr, size, erase_size, erase_value, type))
+                memory_region = MemoryRegion(addr, size, erase_size, erase_value, type)
+                if 'program_size' in region:
+                    memory_region.program_sz = int(region['program_size'], 0)
+                if 'erase_time_us' in region:
+                    memory_region.erase_time_us = int(region['erase_time_us'], 0)
+                if 'program_time_us' in region:
+                    memory_region.program_time_us = int(region['program_time_us'], 0)
+
+                self.regions.append(memory_region)
             except KeyError as key:
                 print('Malformed JSON:', key, 'is missing')
 
@@ -268,6 +308,166 @@ class MemoryMap:
                     # TODO: Notify regions overlap
                     raise Exception()
 
+    def flash_areas(self) -> list:
+        ''' Flash areas of the map, with their names '''
+        boot = self.boot_layout
+        areas = [('bootloader_area', boot.bootloader_area)]
+        for field in ('scratch_area', 'status_area'):
+            area = getattr(boot, field)
+            if area is not None:
+                areas.append((field, area))
+        for app_id, app in enumerate(self.apps, 1):
+            areas.append((f'application_{app_id} boot slot', app.boot_area))
+            areas.append((f'application_{app_id} upgrade slot', app.upgrade_area))
+        return areas
+
+    def __memory_areas_place(self):
+        ''' Place the bootloader areas that name a region at the first
+            erase sector of the region that is free
+        '''
+        boot = self.boot_layout
+        for field, region_type in boot.area_regions.items():
+            region = next((r for r in self.regions if r.type == region_type), None)
+            if region is None:
+                print('\nERROR:', field, 'names the unknown region', region_type, file=sys.stderr)
+                sys.exit(-1)
+
+            area = getattr(boot, field)
+            placed = [a for _, a in self.flash_areas() if a.addr is not None]
+            area.addr = first_free(region, area.sz, placed)
+            if area.addr is None:
+                print('\nERROR: no room for', field, 'in', region_type, file=sys.stderr)
+                sys.exit(-1)
+
+    def __memory_areas_check(self, warn : bool):
+        ''' Check that the flash areas fit a region, start and end on its
+            erase sectors and do not overlap
+        '''
+        areas = self.flash_areas()
+        for name, area in areas:
+            region_id = self.__memory_area_find_region_id(area)
+            if region_id is None:
+                print('\nERROR:', name, 'does not fit a memory region', file=sys.stderr)
+                sys.exit(-1)
+            region = self.regions[region_id]
+            if not is_aligned(area.addr, region.erase_sz) or \
+               not is_aligned(area.sz, region.erase_sz):
+                print('\nERROR:', name, 'is not aligned to the erase size',
+                      hex(region.erase_sz), 'of', region.type, file=sys.stderr)
+                sys.exit(-1)
+
+        for index, (name, area) in enumerate(areas):
+            for other_name, other in areas[index + 1:]:
+                if area.overlaps_with(other):
+                    print('\nERROR:', name, 'overlaps', other_name, file=sys.stderr)
+                    sys.exit(-1)
+
+        # Direct XIP executes both slots, it neither copies nor swaps them
+        boot = self.boot_layout
+        if boot.direct_xip:
+            if boot.has_scratch_area or boot.has_status_area:
+                print('\nERROR: direct_xip takes no scratch_area or status_area', file=sys.stderr)
+                sys.exit(-1)
+            for name, area in areas[1:]:
+                if 'CODE' not in self.region_of(area).type:
+                    print('\nERROR:', name, 'is not in the code flash, direct_xip executes it',
+                          file=sys.stderr)
+                    sys.exit(-1)
+
+        # The RAM load copies the image of the highest version to the SRAM
+        # and runs it there, both slots stay as the DFU application wrote them
+        ram_apps = [app for app in self.apps if app.has_ram_boot]
+        if ram_apps:
+            if len(self.apps) != 1:
+                print('\nERROR: ram_boot supports a single image', file=sys.stderr)
+                sys.exit(-1)
+            if boot.direct_xip or boot.has_scratch_area or boot.has_status_area:
+                print('\nERROR: ram_boot takes no direct_xip, scratch_area or status_area', file=sys.stderr)
+                sys.exit(-1)
+            app = ram_apps[0]
+            if any(app.ram_boot.overlaps_with(region) for region in self.regions):
+                print('\nERROR: ram_boot is in the flash, it must be in the SRAM', file=sys.stderr)
+                sys.exit(-1)
+            for name, ram in (('bootloader ram', boot.ram), ('application_1 ram', app.ram)):
+                if ram is not None and app.ram_boot.overlaps_with(ram):
+                    print('\nERROR: ram_boot overlaps', name, file=sys.stderr)
+                    sys.exit(-1)
+            if warn and app.ram_boot.sz < app.boot_area.sz:
+                print('WARNING: ram_boot of', hex(app.ram_boot.sz), 'bytes is smaller than the slots,'
+                      ' larger images are not started', file=sys.stderr)
+
+        # The swap status holds the trailers, updated on every confirm
+        if warn and self.boot_layout.has_status_area:
+            region = self.region_of(self.boot_layout.status_area)
+            smallest = min(self.regions, key=lambda r: r.erase_sz)
+            if region.erase_sz > smallest.erase_sz:
+                print('WARNING: status_area is in', region.type, 'with erase size',
+                      hex(region.erase_sz) + ',', smallest.type, 'erases',
+                      hex(smallest.erase_sz), file=sys.stderr)
+
+    def region_of(self, area : Memory) -> MemoryRegion:
+        return self.regions[self.__memory_area_find_region_id(area)]
+
+    def trailer_region(self, app) -> MemoryRegion:
+        ''' Region of the image trailers of an application: the swap
+            status if there is one, else the end of the slots. The overwrite
+            mode has no status area, MCUboot and imgtool keep its trailers at
+            the end of the slots, in a sector of the code flash
+        '''
+        if self.boot_layout.has_status_area:
+            return self.region_of(self.boot_layout.status_area)
+        return self.region_of(app.boot_area)
+
+    def trailer_size(self, app) -> int:
+        ''' Bytes of an image trailer: the flags, and the swap status
+            entries of the slot sectors when the trailer is in the slot
+        '''
+        region = self.trailer_region(app)
+        size = BOOT_TRAILER_SIZE
+        if self.boot_layout.has_scratch_area and not self.boot_layout.has_status_area:
+            size += self.max_sectors * BOOT_STATUS_ENTRY_SIZE
+        return round_up(size, region.program_sz or 1)
+
+    @property
+    def trailer_page_size(self) -> int:
+        ''' Largest erase sector holding an image trailer '''
+        return max(self.trailer_region(app).erase_sz for app in self.apps)
+
+    def __trailers_check(self):
+        ''' Each image trailer fits the erase sector it is rewritten in '''
+        for app_id, app in enumerate(self.apps, 1):
+            region = self.trailer_region(app)
+            if self.trailer_size(app) > region.erase_sz:
+                print('\nERROR: The trailer of image', app_id, 'takes', hex(self.trailer_size(app)),
+                      'bytes, more than the erase size', hex(region.erase_sz), 'of', region.type,
+                      file=sys.stderr)
+                sys.exit(-1)
+
+    def __erase_report_gen(self):
+        ''' Erases of a trailer update and of a full slot upgrade '''
+        boot = self.boot_layout
+        print('# Erase cost')
+        for app_id, app in enumerate(self.apps, 1):
+            slot = self.region_of(app.boot_area)
+            trailer = self.trailer_region(app)
+            sectors = app.boot_area.sz // slot.erase_sz
+            in_slot = '' if trailer is slot else f' (1 x {hex(slot.erase_sz)} in the slot)'
+            if boot.direct_xip:
+                print(f'#   Image {app_id} direct XIP     : none, the slot of the highest version runs')
+                continue
+            if app.has_ram_boot:
+                print(f'#   Image {app_id} RAM load       : none, the slot of the highest version is copied'
+                      f' to {hex(app.ram_boot.addr)}')
+                continue
+            print(f'#   Image {app_id} trailer update : 1 x {hex(trailer.erase_sz)} in {trailer.type}{in_slot}')
+            if boot.has_scratch_area:
+                scratch = self.region_of(boot.scratch_area)
+                per_sector = slot.erase_sz // scratch.erase_sz
+                print(f'#   Image {app_id} swap           : {2 * sectors} x {hex(slot.erase_sz)} in {slot.type},'
+                      f' {sectors * per_sector} x {hex(scratch.erase_sz)} in {scratch.type}')
+            else:
+                print(f'#   Image {app_id} overwrite      : {sectors + 1} x {hex(slot.erase_sz)} in {slot.type}')
+
     def __memory_area_find_region_id(self, area : Memory) -> int:
         for region_id, region in enumerate(self.regions):
             if area.fits_with(region):
@@ -406,6 +606,13 @@ class MemoryMap:
             f_out.write(f'#include <stdint.h>\n')
             f_out.write(f'#include "flash_map_backend.h"\n\n')
             f_out.write(f'#define MEMORYMAP_GENERATED_AREAS 1\n\n')
+            # PLATFORM_MAX_TRAILER_PAGE_SIZE may be set apart from this map
+            trailer_size = max(self.trailer_size(app) for app in self.apps)
+            f_out.write(f'#define MEMORYMAP_TRAILER_SIZE {hex(trailer_size)}U\n')
+            f_out.write('#if defined(PLATFORM_MAX_TRAILER_PAGE_SIZE) && '
+                        '(MEMORYMAP_TRAILER_SIZE > PLATFORM_MAX_TRAILER_PAGE_SIZE)\n')
+            f_out.write('#error "The image trailer does not fit PLATFORM_MAX_TRAILER_PAGE_SIZE"\n')
+            f_out.write('#endif\n\n')
             f_out.write('extern struct flash_device flash_devices[];\n')
             f_out.write('extern struct flash_area *boot_area_descs[];\n\n')
             f_out.write('extern uint8_t memory_areas_primary[];\n')
@@ -424,7 +631,12 @@ class MemoryMap:
     def __bootloader_mk_file_gen(self):
         boot = self.boot_layout
         # Upgrade mode
-        if boot.scratch_area is None and boot.status_area is None:
+        if boot.direct_xip:
+            print(settings_dict['overwrite'], ':= 0')
+            print(settings_dict['direct_xip'], ':= 1')
+        elif self.apps[0].has_ram_boot:
+            print(settings_dict['overwrite'], ':= 0')
+        elif boot.scratch_area is None and boot.status_area is None:
             print(settings_dict['overwrite'], ':= 1')
         else:
             print(settings_dict['overwrite'], ':= 0')
@@ -494,12 +706,24 @@ class MemoryMap:
         print('# Mcuboot')
         print(settings_dict['application_count'], f'= {len(self.apps)}')
         print(settings_dict['sectors_count'], f'= {self.max_sectors}')
+        print(f'PLATFORM_MAX_TRAILER_PAGE_SIZE := {hex(self.trailer_page_size)}')
+
+        self.__erase_report_gen()
 
     def __application_mk_file_gen(self):
+        if not 1 <= self.app_id <= len(self.apps):
+            print(f'\nERROR: The memory map has no application_{self.app_id}', file=sys.stderr)
+            sys.exit(-1)
+
         app = self.apps[self.app_id-1]
         boot = self.boot_layout
         # Upgrade mode
-        if boot.scratch_area is None and boot.status_area is None:
+        if boot.direct_xip:
+            print(settings_dict['overwrite'], ':= 0')
+            print(settings_dict['direct_xip'], ':= 1')
+        elif self.apps[0].has_ram_boot:
+            print(settings_dict['overwrite'], ':= 0')
+        elif boot.scratch_area is None and boot.status_area is None:
             print(settings_dict['overwrite'], ':= 1')
         else:
             print(settings_dict['overwrite'], ':= 0')
@@ -512,21 +736,45 @@ class MemoryMap:
         print(settings_dict['primary_image_start'], ':=', hex(app.boot_area.addr))
         print(settings_dict['secondary_image_start'], ':=', hex(app.upgrade_area.addr))
         print(settings_dict['image_size'], ':=', hex(app.boot_area.sz))
+        # Slots of all the images, the DFU application updates every image
+        for id, other in enumerate(self.apps):
+            print(f'APPLICATION_{id+1}_BOOT_SLOT_ADDRESS := {hex(other.boot_area.addr)}')
+            print(f'APPLICATION_{id+1}_BOOT_SLOT_SIZE := {hex(other.boot_area.sz)}')
+            print(f'APPLICATION_{id+1}_UPGRADE_SLOT_ADDRESS := {hex(other.upgrade_area.addr)}')
+            print(f'APPLICATION_{id+1}_UPGRADE_SLOT_SIZE := {hex(other.upgrade_area.sz)}')
         if app.ram_boot:
             print(settings_dict['ram_load'], ':= 1')
+            print(f'{settings_dict["ram_load_address"]} :=', hex(app.ram_boot.addr))
+            print(f'{settings_dict["ram_load_size"]} :=', hex(app.ram_boot.sz))
         if app.ram:
             print(settings_dict['image_ram_address'], ':=',  hex(app.ram.addr))
             print(settings_dict['image_ram_size'], ':=',  hex(app.ram.sz))
         if app.core_name:
             print(settings_dict['core'], ':=',  app.core_name)
+        print(f'PLATFORM_MAX_TRAILER_PAGE_SIZE := {hex(self.trailer_page_size)}')
+
+    def load(self, map_json : json, platform_json : json, warn : bool = True):
+        '''
+            Build and check the layout of a memory map.
+        '''
+        self.map_json       = map_json
+        self.platform_json  = platform_json
+
+        self.__memory_regions_init()
+        self.__boot_layout_init()
+        self.__apps_init()
+        self.__memory_areas_place()
+        self.__memory_areas_check(warn)
+        self.__memory_areas_create()
+        self.__trailers_check()
 
     def parse(self, memory_map, platform_config, output_folder, output_name, app_id):
         try:
             with open(memory_map, "r", encoding='UTF-8') as f_in:
-                self.map_json = json.load(f_in)
+                map_json = json.load(f_in)
 
             with open(platform_config, "r", encoding='UTF-8') as f_in:
-                self.platform_json = json.load(f_in)
+                platform_json = json.load(f_in)
 
             self.output_folder  = output_folder
             self.output_name    = output_name
@@ -534,10 +782,7 @@ class MemoryMap:
             if app_id is not None:
                 self.app_id = int(app_id)
 
-            self.__memory_regions_init()
-            self.__boot_layout_init()
-            self.__apps_init()
-            self.__memory_areas_create()
+            self.load(map_json, platform_json)
 
             self.__source_gen()
             self.__header_gen()
@@ -552,6 +797,319 @@ class MemoryMap:
             sys.exit(-1)
 
 
+# MCUboot swap status row, rewritten on each status update
+SWAP_STATUS_ROW_SIZE = 0x200
+# Image trailer: magic, swap info, copy done and image OK, 8-byte aligned
+BOOT_TRAILER_SIZE = 0x28
+# Swap status entries of a slot sector in a trailer
+BOOT_STATUS_ENTRY_SIZE = 3 * 8
+# Trailer writes of a swap: magic, swap info, copy done, image OK
+SWAP_TRAILER_WRITES = 4
+
+def round_up(value : int, align : int) -> int:
+    return (value + align - 1) // align * align
+
+class FlashCost:
+    '''
+        Erase and program operations of a flash update, per region
+    '''
+    def __init__(self):
+        self.ops : dict = {}
+
+    def __entry(self, region : MemoryRegion) -> list:
+        return self.ops.setdefault(region.type, [region, 0, 0])
+
+    def erase(self, region : MemoryRegion, sz : int):
+        ''' Erase the sectors of sz bytes '''
+        self.__entry(region)[1] += round_up(sz, region.erase_sz) // region.erase_sz
+
+    def program(self, region : MemoryRegion, sz : int):
+        ''' Program sz bytes '''
+        self.__entry(region)[2] += round_up(sz, region.program_sz) // region.program_sz
+
+    def add(self, other, times : int = 1):
+        for region, erases, programs in other.ops.values():
+            entry = self.__entry(region)
+            entry[1] += erases * times
+            entry[2] += programs * times
+
+    @property
+    def time_us(self) -> int:
+        return sum(erases * region.erase_time_us + programs * region.program_time_us
+                   for region, erases, programs in self.ops.values())
+
+    @property
+    def erase_bytes(self) -> int:
+        return sum(erases * region.erase_sz for region, erases, _ in self.ops.values())
+
+    def as_dict(self) -> dict:
+        return {
+            'erase'         : {name: {'count': erases, 'bytes': erases * region.erase_sz}
+                               for name, (region, erases, _) in self.ops.items() if erases},
+            'program'       : {name: {'count': programs, 'bytes': programs * region.program_sz}
+                               for name, (region, _, programs) in self.ops.items() if programs},
+            'erase_bytes'   : self.erase_bytes,
+            'time_us'       : self.time_us
+        }
+
+class LayoutAnalyzer:
+    '''
+        Flash operations and time of the upgrades of a memory map. The
+        model follows the host flash model of host/source: the overwrite
+        erases the sectors of the image and the last sector of the primary
+        slot, then the first and last sectors of the secondary slot; the
+        swap using scratch moves each sector through the scratch area and
+        rewrites a status row after each of the three copies; the direct
+        XIP writes nothing, the bootloader starts the newer slot in place,
+        and neither does the RAM load, which copies it to the SRAM.
+    '''
+    def __init__(self, memory_map : MemoryMap):
+        self.map = memory_map
+
+        for region in self.map.regions:
+            if not region.has_timing:
+                print('\nERROR:', region.type, 'has no program_size, erase_time_us'
+                      ' or program_time_us', file=sys.stderr)
+                sys.exit(-1)
+
+    def trailer_in_slot(self, app : ApplicationLayout) -> bool:
+        return not self.map.boot_layout.has_status_area
+
+    def trailer_overhead(self, app : ApplicationLayout) -> int:
+        ''' Bytes at the end of the slots reserved for the trailer '''
+        if not self.trailer_in_slot(app) or self.mode in ('direct_xip', 'ram_load'):
+            return 0
+        size = BOOT_TRAILER_SIZE
+        if self.mode == 'swap':
+            size += self.map.max_sectors * BOOT_STATUS_ENTRY_SIZE
+        return round_up(size, self.map.region_of(app.boot_area).program_sz)
+
+    def max_image_size(self, app : ApplicationLayout) -> int:
+        size = app.boot_area.sz - self.trailer_overhead(app)
+        # The RAM load copies the header, the image and the TLVs
+        if self.mode == 'ram_load':
+            size = min(size, app.ram_boot.sz)
+        return size
+
+    def trailer_update(self, app : ApplicationLayout) -> FlashCost:
+        ''' Confirm, or any other update of a trailer '''
+        cost = FlashCost()
+        region = self.map.trailer_region(app)
+        if self.trailer_in_slot(app):
+            cost.erase(region, region.erase_sz)
+            cost.program(region, region.program_sz)
+        else:
+            row = max(SWAP_STATUS_ROW_SIZE, region.erase_sz)
+            cost.erase(region, row)
+            cost.program(region, row)
+        return cost
+
+    def overwrite(self, app : ApplicationLayout, image_size : int) -> FlashCost:
+        cost = FlashCost()
+        primary = self.map.region_of(app.boot_area)
+        secondary = self.map.region_of(app.upgrade_area)
+
+        covered = round_up(image_size, primary.erase_sz)
+        cost.erase(primary, min(covered, app.boot_area.sz))
+        if covered < app.boot_area.sz:
+            cost.erase(primary, primary.erase_sz)
+        cost.program(primary, image_size)
+        cost.erase(secondary, 2 * secondary.erase_sz)
+        return cost
+
+    def swap(self, app : ApplicationLayout, image_size : int) -> FlashCost:
+        ''' One swap, of an upgrade or a revert '''
+        boot = self.map.boot_layout
+        if not boot.has_scratch_area:
+            return None
+
+        primary = self.map.region_of(app.boot_area)
+        secondary = self.map.region_of(app.upgrade_area)
+        scratch = self.map.region_of(boot.scratch_area)
+        sector_sz = max(primary.erase_sz, secondary.erase_sz)
+        sectors = round_up(image_size, sector_sz) // sector_sz
+        if self.trailer_in_slot(app):
+            sectors += 1
+
+        sector = FlashCost()
+        for region in (scratch, secondary, primary):
+            sector.erase(region, sector_sz)
+            sector.program(region, sector_sz)
+
+        update = self.trailer_update(app)
+        if self.trailer_in_slot(app):
+            # The trailer records the progress without erases
+            update = FlashCost()
+            update.program(primary, primary.program_sz)
+
+        cost = FlashCost()
+        cost.add(sector, sectors)
+        cost.add(update, 3 * sectors)
+        cost.add(self.trailer_update(app), SWAP_TRAILER_WRITES)
+        return cost
+
+    def direct_xip(self, app : ApplicationLayout, image_size : int) -> FlashCost:
+        ''' The newer slot is started where the DFU application wrote it '''
+        return FlashCost()
+
+    def ram_load(self, app : ApplicationLayout, image_size : int) -> FlashCost:
+        ''' The newer slot is copied to the SRAM on each boot '''
+        return FlashCost()
+
+    @property
+    def mode(self) -> str:
+        boot = self.map.boot_layout
+        if boot.direct_xip:
+            return 'direct_xip'
+        if any(app.has_ram_boot for app in self.map.apps):
+            return 'ram_load'
+        return 'overwrite' if boot.scratch_area is None and boot.status_area is None else 'swap'
+
+    def upgrade(self, app : ApplicationLayout, image_size : int) -> FlashCost:
+        ''' Upgrade in the mode of the memory map '''
+        if self.mode == 'direct_xip':
+            return self.direct_xip(app, image_size)
+        if self.mode == 'ram_load':
+            return self.ram_load(app, image_size)
+        if self.mode == 'overwrite':
+            return self.overwrite(app, image_size)
+        return self.swap(app, image_size)
+
+    def analyze(self, image_size : int = None) -> dict:
+        images = []
+        upgrade_time_us = 0
+        for app_id, app in enumerate(self.map.apps, 1):
+            size = self.max_image_size(app) if image_size is None else image_size
+            trailer = self.map.trailer_region(app)
+            swap = self.swap(app, size)
+            upgrade = self.upgrade(app, size)
+            upgrade_time_us += upgrade.time_us if upgrade else 0
+
+            images.append({
+                'image'             : app_id,
+                'slot_size'         : app.boot_area.sz,
+                'slot_region'       : self.map.region_of(app.boot_area).type,
+                'slot_sectors'      : app.boot_area.sz // self.map.region_of(app.boot_area).erase_sz,
+                'trailer_region'    : trailer.type,
+                'trailer_page_size' : trailer.erase_sz,
+                'trailer_overhead'  : self.trailer_overhead(app),
+                'max_image_size'    : self.max_image_size(app),
+                'image_size'        : size,
+                'fits'              : size <= self.max_image_size(app),
+                'overwrite'         : self.overwrite(app, size).as_dict(),
+                'swap'              : swap.as_dict() if swap else None,
+                'direct_xip'        : self.direct_xip(app, size).as_dict(),
+                'ram_load'          : self.ram_load(app, size).as_dict(),
+                'trailer_update'    : self.trailer_update(app).as_dict()
+            })
+
+        return {
+            'mode'              : self.mode,
+            'max_sectors'       : self.map.max_sectors,
+            'trailer_page_size' : self.map.trailer_page_size,
+            'images'            : images,
+            'upgrade_time_us'   : upgrade_time_us
+        }
+
+class LayoutOptimizer:
+    '''
+        Search of the regions of the slots, scratch and status areas that
+        give the fastest (or least erasing) upgrade of an image size. The
+        bootloader area and the number of applications come from a base
+        memory map. The slots stay in the code flash, which executes them
+        and which the DFU application writes; all areas are placed at the
+        first free erase sectors.
+    '''
+    def __init__(self, base_json : json, platform_json : json):
+        self.base_json      = base_json
+        self.platform_json  = platform_json
+        self.base           = MemoryMap()
+        self.base.load(base_json, platform_json)
+        LayoutAnalyzer(self.base)
+
+    def __candidate_json(self, mode, image_size, regions) -> json:
+        ''' Memory map of an assignment of regions, None if it does not fit '''
+        base = self.base
+        boot = base.boot_layout
+        primary, secondary = regions[0], regions[1]
+        placed = [boot.bootloader_area]
+
+        def place(region, sz):
+            addr = first_free(region, sz, placed)
+            if addr is not None:
+                placed.append(Memory(addr, sz))
+            return addr
+
+        bootloader = {'bootloader_area': {'address': hex(boot.bootloader_area.addr),
+                                          'size': hex(boot.bootloader_area.sz)}}
+        for field in ('shared_data', 'ram'):
+            area = getattr(boot, field)
+            if area is not None:
+                bootloader[field] = {'address': hex(area.addr), 'size': hex(area.sz)}
+
+        if mode == 'direct_xip':
+            bootloader['direct_xip'] = True
+
+        # Trailers in the slots follow the image
+        overhead = round_up(BOOT_TRAILER_SIZE, primary.program_sz) if mode == 'overwrite' else 0
+        slot_sz = round_up(image_size + overhead, max(primary.erase_sz, secondary.erase_sz))
+
+        map_json = {'bootloader': bootloader}
+        for app_id in range(1, len(base.apps) + 1):
+            boot_addr = place(primary, slot_sz)
+            upgrade_addr = place(secondary, slot_sz)
+            if boot_addr is None or upgrade_addr is None:
+                return None
+            section = self.base_json[f'application_{app_id}']
+            section = {key: value for key, value in section.items() if key != 'slots'}
+            section['slots'] = {'boot': hex(boot_addr), 'upgrade': hex(upgrade_addr),
+                                'size': hex(slot_sz)}
+            map_json[f'application_{app_id}'] = section
+
+        if mode == 'swap':
+            scratch, status = regions[2], regions[3]
+            scratch_sz = round_up(max(primary.erase_sz, secondary.erase_sz), scratch.erase_sz)
+            status_sz = boot.status_area.sz if boot.has_status_area else 0x2800
+            status_sz = round_up(status_sz, status.erase_sz)
+            scratch_addr = place(scratch, scratch_sz)
+            status_addr = place(status, status_sz)
+            if scratch_addr is None or status_addr is None:
+                return None
+            bootloader['scratch_area'] = {'address': hex(scratch_addr), 'size': hex(scratch_sz)}
+            bootloader['status_area'] = {'address': hex(status_addr), 'size': hex(status_sz)}
+
+        return map_json
+
+    def optimize(self, mode : str, image_size : int, objective : str) -> list:
+        ''' Candidates, best first '''
+        regions = self.base.regions
+        code = [region for region in regions if 'CODE' in region.type]
+        choices = [code, code]
+        if mode == 'swap':
+            choices += [regions, regions]
+
+        candidates = []
+        for assignment in itertools.product(*choices):
+            map_json = self.__candidate_json(mode, image_size, assignment)
+            if map_json is None:
+                continue
+            memory_map = MemoryMap()
+            memory_map.load(map_json, self.platform_json, warn=False)
+            analysis = LayoutAnalyzer(memory_map).analyze(image_size)
+            upgrade = [image[mode] for image in analysis['images']]
+            candidates.append({
+                'regions'           : [region.type for region in assignment],
+                'upgrade_time_us'   : sum(cost['time_us'] for cost in upgrade),
+                'erase_bytes'       : sum(cost['erase_bytes'] for cost in upgrade),
+                'analysis'          : analysis,
+                'memory_map'        : map_json
+            })
+
+        key = ('upgrade_time_us', 'erase_bytes') if objective == 'time' else \
+              ('erase_bytes', 'upgrade_time_us')
+        candidates.sort(key=lambda c: tuple(c[k] for k in key))
+        return candidates
+
 @click.group()
 def cli():
     '''
@@ -578,5 +1136,86 @@ def run(memory_config, platform_config, output_folder, output_name, image_id):
               output_name,
               image_id)
 
+def load_json(path):
+    try:
+        with open(path, "r", encoding='UTF-8') as f_in:
+            return json.load(f_in)
+    except (FileNotFoundError, OSError):
+        print('\nERROR: Cannot open ', path, file=sys.stderr)
+        sys.exit(-1)
+
+@cli.command()
+@click.option('-i', '--memory_config', required=True,
+              help='memory configuration file path')
+@click.option('-p', '--platform_config', required=True,
+              help='platform configuration file path')
+@click.option('-s', '--image_size', required=False,
+              help='image size, the largest that fits the slots by default')
+@click.option('-t', '--max_upgrade_us', required=False, type=int,
+              help='fail if the upgrade takes longer')
+
+def analyze(memory_config, platform_config, image_size, max_upgrade_us):
+    '''
+        Flash operations and time of the upgrades of a memory map, as JSON
+    '''
+    map = MemoryMap()
+    map.load(load_json(memory_config), load_json(platform_config))
+    report = LayoutAnalyzer(map).analyze(None if image_size is None else int(image_size, 0))
+    print(json.dumps(report, indent=4))
+
+    if not all(image['fits'] for image in report['images']):
+        print('\nERROR: the image does not fit the slots', file=sys.stderr)
+        sys.exit(1)
+    if max_upgrade_us is not None and report['upgrade_time_us'] > max_upgrade_us:
+        print('\nERROR: the upgrade takes', report['upgrade_time_us'], 'us, more than',
+              max_upgrade_us, file=sys.stderr)
+        sys.exit(1)
+
+@cli.command()
+@click.option('-i', '--memory_config', required=True,
+              help='base memory configuration file path')
+@click.option('-p', '--platform_config', required=True,
+              help='platform configuration file path')
+@click.option('-s', '--image_size', required=True,
+              help='image size')
+@click.option('-m', '--mode', type=click.Choice(['overwrite', 'swap', 'direct_xip']), required=False,
+              help='upgrade mode, that of the base memory map by default')
+@click.option('-b', '--objective', type=click.Choice(['time', 'wear']), default='time',
+              help='minimise the upgrade time or the erased bytes')
+@click.option('-n', '--count', type=int, default=5,
+              help='number of candidates reported')
+@click.option('-o', '--output', required=False,
+              help='memory configuration file written with the best layout')
+
+def optimize(memory_config, platform_config, image_size, mode, objective, count, output):
+    '''
+        Layout of the slots, scratch and status areas with the fastest
+        upgrade, as JSON
+    '''
+    optimizer = LayoutOptimizer(load_json(memory_config), load_json(platform_config))
+    if mode is None:
+        mode = LayoutAnalyzer(optimizer.base).mode
+
+    candidates = optimizer.optimize(mode, int(image_size, 0), objective)
+    if not candidates:
+        print('\nERROR: no layout fits the image', file=sys.stderr)
+        sys.exit(1)
+
+    report = {
+        'mode'          : mode,
+        'image_size'    : int(image_size, 0),
+        'objective'     : objective,
+        'base'          : LayoutAnalyzer(optimizer.base).analyze(int(image_size, 0)),
+        'candidates'    : [{key: value for key, value in candidate.items() if key != 'analysis'}
+                           for candidate in candidates[:count]],
+        'best'          : candidates[0]['analysis']
+    }
+    print(json.dumps(report, indent=4))
+
+    if output:
+        with open(output, "w", encoding='UTF-8') as f_out:
+            json.dump(candidates[0]['memory_map'], f_out, indent=4)
+            f_out.write('\n')
+
 if __name__ == '__main__':
     cli()
\ No newline at end of file
@@ -0,0 +1,255 @@
+/******************************************************************************
+ * File Name:   boot_aes.c
+ *
+ * Description: This file contains a compact software AES-128 (FIPS 197) with one 1 KB round table,
+ *              and the counter mode of the MCUboot image encryption: the counter of a byte is its
+ *              offset in the image body divided by the block size, big endian in the last four
+ *              bytes of the block, so that any row can be decrypted on its own.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "boot_aes.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define BOOT_AES_ROL(x, n)          (((x) << (n)) | ((x) >> (32u - (n))))
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const uint8_t aes_sbox[256] = {
+    0x63u, 0x7cu, 0x77u, 0x7bu, 0xf2u, 0x6bu, 0x6fu, 0xc5u, 0x30u, 0x01u, 0x67u, 0x2bu, 0xfeu, 0xd7u, 0xabu, 0x76u,
+    0xcau, 0x82u, 0xc9u, 0x7du, 0xfau, 0x59u, 0x47u, 0xf0u, 0xadu, 0xd4u, 0xa2u, 0xafu, 0x9cu, 0xa4u, 0x72u, 0xc0u,
+    0xb7u, 0xfdu, 0x93u, 0x26u, 0x36u, 0x3fu, 0xf7u, 0xccu, 0x34u, 0xa5u, 0xe5u, 0xf1u, 0x71u, 0xd8u, 0x31u, 0x15u,
+    0x04u, 0xc7u, 0x23u, 0xc3u, 0x18u, 0x96u, 0x05u, 0x9au, 0x07u, 0x12u, 0x80u, 0xe2u, 0xebu, 0x27u, 0xb2u, 0x75u,
+    0x09u, 0x83u, 0x2cu, 0x1au, 0x1bu, 0x6eu, 0x5au, 0xa0u, 0x52u, 0x3bu, 0xd6u, 0xb3u, 0x29u, 0xe3u, 0x2fu, 0x84u,
+    0x53u, 0xd1u, 0x00u, 0xedu, 0x20u, 0xfcu, 0xb1u, 0x5bu, 0x6au, 0xcbu, 0xbeu, 0x39u, 0x4au, 0x4cu, 0x58u, 0xcfu,
+    0xd0u, 0xefu, 0xaau, 0xfbu, 0x43u, 0x4du, 0x33u, 0x85u, 0x45u, 0xf9u, 0x02u, 0x7fu, 0x50u, 0x3cu, 0x9fu, 0xa8u,
+    0x51u, 0xa3u, 0x40u, 0x8fu, 0x92u, 0x9du, 0x38u, 0xf5u, 0xbcu, 0xb6u, 0xdau, 0x21u, 0x10u, 0xffu, 0xf3u, 0xd2u,
+    0xcdu, 0x0cu, 0x13u, 0xecu, 0x5fu, 0x97u, 0x44u, 0x17u, 0xc4u, 0xa7u, 0x7eu, 0x3du, 0x64u, 0x5du, 0x19u, 0x73u,
+    0x60u, 0x81u, 0x4fu, 0xdcu, 0x22u, 0x2au, 0x90u, 0x88u, 0x46u, 0xeeu, 0xb8u, 0x14u, 0xdeu, 0x5eu, 0x0bu, 0xdbu,
+    0xe0u, 0x32u, 0x3au, 0x0au, 0x49u, 0x06u, 0x24u, 0x5cu, 0xc2u, 0xd3u, 0xacu, 0x62u, 0x91u, 0x95u, 0xe4u, 0x79u,
+    0xe7u, 0xc8u, 0x37u, 0x6du, 0x8du, 0xd5u, 0x4eu, 0xa9u, 0x6cu, 0x56u, 0xf4u, 0xeau, 0x65u, 0x7au, 0xaeu, 0x08u,
+    0xbau, 0x78u, 0x25u, 0x2eu, 0x1cu, 0xa6u, 0xb4u, 0xc6u, 0xe8u, 0xddu, 0x74u, 0x1fu, 0x4bu, 0xbdu, 0x8bu, 0x8au,
+    0x70u, 0x3eu, 0xb5u, 0x66u, 0x48u, 0x03u, 0xf6u, 0x0eu, 0x61u, 0x35u, 0x57u, 0xb9u, 0x86u, 0xc1u, 0x1du, 0x9eu,
+    0xe1u, 0xf8u, 0x98u, 0x11u, 0x69u, 0xd9u, 0x8eu, 0x94u, 0x9bu, 0x1eu, 0x87u, 0xe9u, 0xceu, 0x55u, 0x28u, 0xdfu,
+    0x8cu, 0xa1u, 0x89u, 0x0du, 0xbfu, 0xe6u, 0x42u, 0x68u, 0x41u, 0x99u, 0x2du, 0x0fu, 0xb0u, 0x54u, 0xbbu, 0x16u,
+};
+
+/* SubBytes and MixColumns of a byte of row 0: 2s, s, s, 3s from the low
+ * byte up. Rows 1 to 3 use the table rotated by 8, 16 and 24 bits */
+static const uint32_t aes_te[256] = {
+    0xa56363c6u, 0x847c7cf8u, 0x997777eeu, 0x8d7b7bf6u, 0x0df2f2ffu, 0xbd6b6bd6u, 0xb16f6fdeu, 0x54c5c591u,
+    0x50303060u, 0x03010102u, 0xa96767ceu, 0x7d2b2b56u, 0x19fefee7u, 0x62d7d7b5u, 0xe6abab4du, 0x9a7676ecu,
+    0x45caca8fu, 0x9d82821fu, 0x40c9c989u, 0x877d7dfau, 0x15fafaefu, 0xeb5959b2u, 0xc947478eu, 0x0bf0f0fbu,
+    0xecadad41u, 0x67d4d4b3u, 0xfda2a25fu, 0xeaafaf45u, 0xbf9c9c23u, 0xf7a4a453u, 0x967272e4u, 0x5bc0c09bu,
+    0xc2b7b775u, 0x1cfdfde1u, 0xae93933du, 0x6a26264cu, 0x5a36366cu, 0x413f3f7eu, 0x02f7f7f5u, 0x4fcccc83u,
+    0x5c343468u, 0xf4a5a551u, 0x34e5e5d1u, 0x08f1f1f9u, 0x937171e2u, 0x73d8d8abu, 0x53313162u, 0x3f15152au,
+    0x0c040408u, 0x52c7c795u, 0x65232346u, 0x5ec3c39du, 0x28181830u, 0xa1969637u, 0x0f05050au, 0xb59a9a2fu,
+    0x0907070eu, 0x36121224u, 0x9b80801bu, 0x3de2e2dfu, 0x26ebebcdu, 0x6927274eu, 0xcdb2b27fu, 0x9f7575eau,
+    0x1b090912u, 0x9e83831du, 0x742c2c58u, 0x2e1a1a34u, 0x2d1b1b36u, 0xb26e6edcu, 0xee5a5ab4u, 0xfba0a05bu,
+    0xf65252a4u, 0x4d3b3b76u, 0x61d6d6b7u, 0xceb3b37du, 0x7b292952u, 0x3ee3e3ddu, 0x712f2f5eu, 0x97848413u,
+    0xf55353a6u, 0x68d1d1b9u, 0x00000000u, 0x2cededc1u, 0x60202040u, 0x1ffcfce3u, 0xc8b1b179u, 0xed5b5bb6u,
+    0xbe6a6ad4u, 0x46cbcb8du, 0xd9bebe67u, 0x4b393972u, 0xde4a4a94u, 0xd44c4c98u, 0xe85858b0u, 0x4acfcf85u,
+    0x6bd0d0bbu, 0x2aefefc5u, 0xe5aaaa4fu, 0x16fbfbedu, 0xc5434386u, 0xd74d4d9au, 0x55333366u, 0x94858511u,
+    0xcf45458au, 0x10f9f9e9u, 0x06020204u, 0x817f7ffeu, 0xf05050a0u, 0x443c3c78u, 0xba9f9f25u, 0xe3a8a84bu,
+    0xf35151a2u, 0xfea3a35du, 0xc0404080u, 0x8a8f8f05u, 0xad92923fu, 0xbc9d9d21u, 0x48383870u, 0x04f5f5f1u,
+    0xdfbcbc63u, 0xc1b6b677u, 0x75dadaafu, 0x63212142u, 0x30101020u, 0x1affffe5u, 0x0ef3f3fdu, 0x6dd2d2bfu,
+    0x4ccdcd81u, 0x140c0c18u, 0x35131326u, 0x2fececc3u, 0xe15f5fbeu, 0xa2979735u, 0xcc444488u, 0x3917172eu,
+    0x57c4c493u, 0xf2a7a755u, 0x827e7efcu, 0x473d3d7au, 0xac6464c8u, 0xe75d5dbau, 0x2b191932u, 0x957373e6u,
+    0xa06060c0u, 0x98818119u, 0xd14f4f9eu, 0x7fdcdca3u, 0x66222244u, 0x7e2a2a54u, 0xab90903bu, 0x8388880bu,
+    0xca46468cu, 0x29eeeec7u, 0xd3b8b86bu, 0x3c141428u, 0x79dedea7u, 0xe25e5ebcu, 0x1d0b0b16u, 0x76dbdbadu,
+    0x3be0e0dbu, 0x56323264u, 0x4e3a3a74u, 0x1e0a0a14u, 0xdb494992u, 0x0a06060cu, 0x6c242448u, 0xe45c5cb8u,
+    0x5dc2c29fu, 0x6ed3d3bdu, 0xefacac43u, 0xa66262c4u, 0xa8919139u, 0xa4959531u, 0x37e4e4d3u, 0x8b7979f2u,
+    0x32e7e7d5u, 0x43c8c88bu, 0x5937376eu, 0xb76d6ddau, 0x8c8d8d01u, 0x64d5d5b1u, 0xd24e4e9cu, 0xe0a9a949u,
+    0xb46c6cd8u, 0xfa5656acu, 0x07f4f4f3u, 0x25eaeacfu, 0xaf6565cau, 0x8e7a7af4u, 0xe9aeae47u, 0x18080810u,
+    0xd5baba6fu, 0x887878f0u, 0x6f25254au, 0x722e2e5cu, 0x241c1c38u, 0xf1a6a657u, 0xc7b4b473u, 0x51c6c697u,
+    0x23e8e8cbu, 0x7cdddda1u, 0x9c7474e8u, 0x211f1f3eu, 0xdd4b4b96u, 0xdcbdbd61u, 0x868b8b0du, 0x858a8a0fu,
+    0x907070e0u, 0x423e3e7cu, 0xc4b5b571u, 0xaa6666ccu, 0xd8484890u, 0x05030306u, 0x01f6f6f7u, 0x120e0e1cu,
+    0xa36161c2u, 0x5f35356au, 0xf95757aeu, 0xd0b9b969u, 0x91868617u, 0x58c1c199u, 0x271d1d3au, 0xb99e9e27u,
+    0x38e1e1d9u, 0x13f8f8ebu, 0xb398982bu, 0x33111122u, 0xbb6969d2u, 0x70d9d9a9u, 0x898e8e07u, 0xa7949433u,
+    0xb69b9b2du, 0x221e1e3cu, 0x92878715u, 0x20e9e9c9u, 0x49cece87u, 0xff5555aau, 0x78282850u, 0x7adfdfa5u,
+    0x8f8c8c03u, 0xf8a1a159u, 0x80898909u, 0x170d0d1au, 0xdabfbf65u, 0x31e6e6d7u, 0xc6424284u, 0xb86868d0u,
+    0xc3414182u, 0xb0999929u, 0x772d2d5au, 0x110f0f1eu, 0xcbb0b07bu, 0xfc5454a8u, 0xd6bbbb6du, 0x3a16162cu,
+};
+
+static const uint8_t aes_rcon[BOOT_AES_ROUNDS] = {
+    0x01u, 0x02u, 0x04u, 0x08u, 0x10u, 0x20u, 0x40u, 0x80u, 0x1bu, 0x36u,
+};
+
+/*******************************************************************************
+ * Function Name: aes_get32
+ ********************************************************************************
+ * Reads a column, row 0 in the low byte.
+ *******************************************************************************/
+static uint32_t aes_get32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*******************************************************************************
+ * Function Name: aes_put32
+ ********************************************************************************
+ * Writes a column, row 0 from the low byte.
+ *******************************************************************************/
+static void aes_put32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/*******************************************************************************
+ * Function Name: aes_sub_word
+ ********************************************************************************
+ * Applies the S-box to the four bytes of a word.
+ *******************************************************************************/
+static uint32_t aes_sub_word(uint32_t w) {
+    return (uint32_t)aes_sbox[w & 0xffu] | ((uint32_t)aes_sbox[(w >> 8) & 0xffu] << 8) |
+           ((uint32_t)aes_sbox[(w >> 16) & 0xffu] << 16) | ((uint32_t)aes_sbox[w >> 24] << 24);
+}
+
+/*******************************************************************************
+ * Function Name: boot_aes_init
+ ********************************************************************************
+ * Expands an AES-128 key into the round keys.
+ *
+ * Parameters:
+ *  ctx            Receives the round keys.
+ *  key            Key.
+ *******************************************************************************/
+void boot_aes_init(boot_aes_t *ctx, const uint8_t key[BOOT_AES_KEY_SIZE]) {
+    uint32_t *rk = ctx->rk;
+
+    for (uint32_t i = 0u; i < 4u; i++) {
+        rk[i] = aes_get32(&key[4u * i]);
+    }
+    for (uint32_t i = 4u; i < 4u * (BOOT_AES_ROUNDS + 1u); i++) {
+        uint32_t t = rk[i - 1u];
+
+        if ((i % 4u) == 0u) {
+            /* RotWord moves row 1 to row 0, the low byte */
+            t = aes_sub_word((t >> 8) | (t << 24)) ^ aes_rcon[(i / 4u) - 1u];
+        }
+        rk[i] = rk[i - 4u] ^ t;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: boot_aes_encrypt
+ ********************************************************************************
+ * Encrypts one block.
+ *
+ * Parameters:
+ *  ctx            Round keys.
+ *  in             Plaintext block.
+ *  out            Receives the ciphertext block, may be in.
+ *******************************************************************************/
+void boot_aes_encrypt(const boot_aes_t *ctx, const uint8_t in[BOOT_AES_BLOCK_SIZE],
+                      uint8_t out[BOOT_AES_BLOCK_SIZE]) {
+    const uint32_t *rk = ctx->rk;
+    uint32_t s[4];
+    uint32_t t[4];
+
+    for (uint32_t c = 0u; c < 4u; c++) {
+        s[c] = aes_get32(&in[4u * c]) ^ rk[c];
+    }
+    for (uint32_t r = 1u; r < BOOT_AES_ROUNDS; r++) {
+        rk += 4;
+        /* Row i of column c comes from column c + i, ShiftRows */
+        for (uint32_t c = 0u; c < 4u; c++) {
+            t[c] = aes_te[s[c] & 0xffu] ^ BOOT_AES_ROL(aes_te[(s[(c + 1u) & 3u] >> 8) & 0xffu], 8u) ^
+                   BOOT_AES_ROL(aes_te[(s[(c + 2u) & 3u] >> 16) & 0xffu], 16u) ^
+                   BOOT_AES_ROL(aes_te[s[(c + 3u) & 3u] >> 24], 24u) ^ rk[c];
+        }
+        memcpy(s, t, sizeof(s));
+    }
+    rk += 4;
+    for (uint32_t c = 0u; c < 4u; c++) {
+        t[c] = ((uint32_t)aes_sbox[s[c] & 0xffu] | ((uint32_t)aes_sbox[(s[(c + 1u) & 3u] >> 8) & 0xffu] << 8) |
+                ((uint32_t)aes_sbox[(s[(c + 2u) & 3u] >> 16) & 0xffu] << 16) |
+                ((uint32_t)aes_sbox[s[(c + 3u) & 3u] >> 24] << 24)) ^ rk[c];
+    }
+    for (uint32_t c = 0u; c < 4u; c++) {
+        aes_put32(&out[4u * c], t[c]);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: boot_aes_ctr
+ ********************************************************************************
+ * Encrypts or decrypts bytes in counter mode, as MCUboot does for an image
+ * body. A call may start at any offset, so the body can be processed one
+ * row at a time in any order.
+ *
+ * Parameters:
+ *  ctx            Round keys.
+ *  offset         Offset of the first byte in the image body.
+ *  in             Input bytes.
+ *  out            Receives the output bytes, may be in.
+ *  length         Number of bytes.
+ *******************************************************************************/
+void boot_aes_ctr(const boot_aes_t *ctx, uint32_t offset, const uint8_t *in, uint8_t *out, uint32_t length) {
+    uint8_t counter[BOOT_AES_BLOCK_SIZE];
+    uint8_t stream[BOOT_AES_BLOCK_SIZE];
+    uint32_t pos = offset % BOOT_AES_BLOCK_SIZE;
+    uint32_t block = offset / BOOT_AES_BLOCK_SIZE;
+
+    memset(counter, 0, sizeof(counter));
+    while (length > 0u) {
+        uint32_t chunk = BOOT_AES_BLOCK_SIZE - pos;
+
+        if (chunk > length) {
+            chunk = length;
+        }
+        counter[12] = (uint8_t)(block >> 24);
+        counter[13] = (uint8_t)(block >> 16);
+        counter[14] = (uint8_t)(block >> 8);
+        counter[15] = (uint8_t)block;
+        boot_aes_encrypt(ctx, counter, stream);
+        for (uint32_t i = 0u; i < chunk; i++) {
+            out[i] = in[i] ^ stream[pos + i];
+        }
+        in += chunk;
+        out += chunk;
+        length -= chunk;
+        pos = 0u;
+        block++;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * File Name:   boot_aes.h
+ *
+ * Description: This file contains the declarations of the software AES-128 of the crypto backend,
+ *              used in counter mode to decrypt the encrypted upgrade images.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef BOOT_AES_H
+#define BOOT_AES_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define BOOT_AES_KEY_SIZE           (16u)
+#define BOOT_AES_BLOCK_SIZE         (16u)
+#define BOOT_AES_ROUNDS             (10u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    /* Round keys, one little endian word per column */
+    uint32_t rk[4u * (BOOT_AES_ROUNDS + 1u)];
+} boot_aes_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+void boot_aes_init(boot_aes_t *ctx, const uint8_t key[BOOT_AES_KEY_SIZE]);
+void boot_aes_encrypt(const boot_aes_t *ctx, const uint8_t in[BOOT_AES_BLOCK_SIZE],
+                      uint8_t out[BOOT_AES_BLOCK_SIZE]);
+void boot_aes_ctr(const boot_aes_t *ctx, uint32_t offset, const uint8_t *in, uint8_t *out, uint32_t length);
+
+#endif /* BOOT_AES_H */
+
+/* [] END OF FILE */
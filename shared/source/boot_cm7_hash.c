@@ -0,0 +1,153 @@
+/******************************************************************************
+ * File Name:   boot_cm7_hash.c
+ *
+ * Description: This file contains the hashing job that the bootloader hands to a CM7 core at
+ *              boot: the CM0+ requests the SHA-256 of a slot, the stub on the CM7 hashes
+ *              it and returns the digest through the SRAM.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "boot_cm7_hash.h"
+#include "dfu_sha256.h"
+
+#if (BOOT_CM7_HASH)
+/*******************************************************************************
+ * Function Name: boot_cm7_hash_job
+ ********************************************************************************
+ * Return:
+ *  The job, at BOOT_CM7_HASH_ADDR.
+ *******************************************************************************/
+__attribute__((weak))
+boot_cm7_hash_job_t *boot_cm7_hash_job(void) {
+    return (boot_cm7_hash_job_t *)BOOT_CM7_HASH_ADDR;
+}
+
+/*******************************************************************************
+ * Function Name: boot_cm7_hash_flash
+ ********************************************************************************
+ * Return:
+ *  Pointer to flash contents, the internal flash is memory mapped.
+ *******************************************************************************/
+__attribute__((weak))
+const uint8_t *boot_cm7_hash_flash(uint32_t address, uint32_t length) {
+    (void)length;
+    return (const uint8_t *)(uintptr_t)address;
+}
+
+/*******************************************************************************
+ * Function Name: boot_cm7_hash_request
+ ********************************************************************************
+ * Writes a job for the stub. Call before the CM7 is started.
+ *
+ * Parameters:
+ *  address        Flash address of the first byte.
+ *  length         Bytes to hash.
+ *******************************************************************************/
+void boot_cm7_hash_request(uint32_t address, uint32_t length) {
+    boot_cm7_hash_job_t *job = boot_cm7_hash_job();
+
+    job->state = BOOT_CM7_HASH_IDLE;
+    job->address = address;
+    job->length = length;
+    job->hashed = 0u;
+    memset(job->digest, 0, sizeof(job->digest));
+    __sync_synchronize();
+    job->state = BOOT_CM7_HASH_REQUEST;
+}
+
+/*******************************************************************************
+ * Function Name: boot_cm7_hash_run
+ ********************************************************************************
+ * Body of the stub on the CM7: hashes the requested bytes and publishes the
+ * digest. A core started without a request does nothing.
+ *******************************************************************************/
+void boot_cm7_hash_run(void) {
+    boot_cm7_hash_job_t *job = boot_cm7_hash_job();
+    uint8_t digest[BOOT_CM7_HASH_DIGEST_SIZE];
+    dfu_sha256_t ctx;
+    const uint8_t *data;
+    uint32_t length;
+
+    if (job->state != BOOT_CM7_HASH_REQUEST) {
+        return;
+    }
+    job->state = BOOT_CM7_HASH_BUSY;
+    length = job->length;
+    data = boot_cm7_hash_flash(job->address, length);
+    if (data == NULL) {
+        /* The CM0+ times out and hashes the slot itself */
+        return;
+    }
+
+    dfu_sha256_init(&ctx);
+    for (uint32_t off = 0u; off < length; off += BOOT_CM7_HASH_CHUNK) {
+        uint32_t chunk = ((length - off) < BOOT_CM7_HASH_CHUNK) ? (length - off) : BOOT_CM7_HASH_CHUNK;
+
+        dfu_sha256_update(&ctx, &data[off], chunk);
+        job->hashed = off + chunk;
+    }
+    dfu_sha256_final(&ctx, digest);
+
+    memcpy(job->digest, digest, sizeof(digest));
+    __sync_synchronize();
+    job->state = BOOT_CM7_HASH_DONE;
+}
+
+/*******************************************************************************
+ * Function Name: boot_cm7_hash_done
+ ********************************************************************************
+ * Polls the job.
+ *
+ * Parameters:
+ *  digest         Receives the SHA-256 once the stub is done.
+ *
+ * Return:
+ *  true if the stub is done.
+ *******************************************************************************/
+bool boot_cm7_hash_done(uint8_t *digest) {
+    boot_cm7_hash_job_t *job = boot_cm7_hash_job();
+
+    if (job->state != BOOT_CM7_HASH_DONE) {
+        return false;
+    }
+    __sync_synchronize();
+    memcpy(digest, job->digest, BOOT_CM7_HASH_DIGEST_SIZE);
+    return true;
+}
+#endif /* BOOT_CM7_HASH */
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * File Name:   boot_cm7_hash.h
+ *
+ * Description: This file contains the declarations of the hashing job that the bootloader hands to
+ *              a CM7 core at boot, and of the stub that runs it.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef BOOT_CM7_HASH_H
+#define BOOT_CM7_HASH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Set to 1 to hash the images on a CM7 core while the CM0+ reads the TLVs */
+#ifndef BOOT_CM7_HASH
+#define BOOT_CM7_HASH               (0)
+#endif
+
+/* RAM address of the job and of the stack of the stub, used only until the
+ * launch of the application. The default is the start of the non-cacheable
+ * SRAM of the XMC7200 (BASE_SRAM_NON_CACHE) */
+#ifndef BOOT_CM7_HASH_ADDR
+#define BOOT_CM7_HASH_ADDR          (0x280E0000uL)
+#endif
+#define BOOT_CM7_HASH_SIZE          (0x800u)
+
+#define BOOT_CM7_HASH_DIGEST_SIZE   (32u)
+
+/* Bytes hashed between two updates of the progress */
+#define BOOT_CM7_HASH_CHUNK         (0x1000u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef enum {
+    BOOT_CM7_HASH_IDLE = 0,
+    /* Written by the CM0+ once the job is complete */
+    BOOT_CM7_HASH_REQUEST = 0x51455248,
+    /* Written by the stub */
+    BOOT_CM7_HASH_BUSY = 0x59535542,
+    BOOT_CM7_HASH_DONE = 0x454E4F44,
+} boot_cm7_hash_state_t;
+
+/*
+ * The job sits at the start of BOOT_CM7_HASH_ADDR, the stack of the stub
+ * grows down from BOOT_CM7_HASH_ADDR + BOOT_CM7_HASH_SIZE. state is
+ * written last by each side.
+ */
+typedef struct {
+    volatile uint32_t state;
+    uint32_t address;
+    uint32_t length;
+    /* Bytes hashed so far */
+    volatile uint32_t hashed;
+    uint8_t digest[BOOT_CM7_HASH_DIGEST_SIZE];
+} boot_cm7_hash_job_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+boot_cm7_hash_job_t *boot_cm7_hash_job(void);
+const uint8_t *boot_cm7_hash_flash(uint32_t address, uint32_t length);
+void boot_cm7_hash_request(uint32_t address, uint32_t length);
+void boot_cm7_hash_run(void);
+bool boot_cm7_hash_done(uint8_t *digest);
+
+#endif /* BOOT_CM7_HASH_H */
+
+/* [] END OF FILE */
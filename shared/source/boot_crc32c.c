@@ -0,0 +1,78 @@
+/******************************************************************************
+ * File Name:   boot_crc32c.c
+ *
+ * Description: This file contains the CRC-32C (Castagnoli) shared by the bootloader and the DFU
+ *              application, computed a nibble at a time from a 64-byte table.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include "boot_crc32c.h"
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+/* CRC-32C of a nibble */
+static const uint32_t boot_crc32c_table[16] = {
+    0x00000000uL, 0x105EC76FuL, 0x20BD8EDEuL, 0x30E349B1uL,
+    0x417B1DBCuL, 0x5125DAD3uL, 0x61C69362uL, 0x7198540DuL,
+    0x82F63B78uL, 0x92A8FC17uL, 0xA24BB5A6uL, 0xB21572C9uL,
+    0xC38D26C4uL, 0xD3D3E1ABuL, 0xE330A81AuL, 0xF36E6F75uL
+};
+
+/*******************************************************************************
+ * Function Name: boot_crc32c
+ ********************************************************************************
+ * Updates a CRC-32C over the given bytes. Start with crc = 0, the result of
+ * one call continues the CRC in the next.
+ *
+ * Parameters:
+ *  crc            CRC-32C of the bytes before, 0 for none.
+ *  data, length   Bytes.
+ *
+ * Return:
+ *  CRC-32C of the bytes before and of the given bytes.
+ *******************************************************************************/
+uint32_t boot_crc32c(uint32_t crc, const uint8_t *data, uint32_t length) {
+    crc = ~crc;
+    while (length-- > 0u) {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ boot_crc32c_table[crc & 0x0Fu];
+        crc = (crc >> 4) ^ boot_crc32c_table[crc & 0x0Fu];
+    }
+    return ~crc;
+}
+
+/* [] END OF FILE */
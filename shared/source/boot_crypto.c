@@ -0,0 +1,779 @@
+/******************************************************************************
+ * File Name:   boot_crypto.c
+ *
+ * Description: This file contains the crypto backend of the image validation and decryption. The
+ *              software backend uses the SHA-256 of the DFU application, the ECDSA P-256
+ *              verification of boot_p256.c and the AES-128 of boot_aes.c; the hardware backend
+ *              drives the crypto block with the crypto driver of the PDL. Both read the key and the
+ *              signature in the DER encoding of imgtool, verify Ed25519 signatures with
+ *              boot_ed25519.c and recover the key of an encrypted image from its ECIES-P256 key TLV
+ *              with the ECDH of boot_p256.c.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "boot_crypto.h"
+#include "boot_ed25519.h"
+#include "boot_p256.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define BOOT_CRYPTO_DER_SEQUENCE    (0x30u)
+#define BOOT_CRYPTO_DER_INTEGER     (0x02u)
+#define BOOT_CRYPTO_DER_OCTETS      (0x04u)
+#define BOOT_CRYPTO_HMAC_BLOCK      (64u)
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+/* SubjectPublicKeyInfo of a P-256 key up to the uncompressed point, as
+ * imgtool getpub writes it */
+static const uint8_t boot_crypto_p256_spki[] = {
+    0x30u, 0x59u, 0x30u, 0x13u, 0x06u, 0x07u, 0x2au, 0x86u, 0x48u, 0xceu, 0x3du, 0x02u, 0x01u,
+    0x06u, 0x08u, 0x2au, 0x86u, 0x48u, 0xceu, 0x3du, 0x03u, 0x01u, 0x07u, 0x03u, 0x42u, 0x00u,
+    0x04u,
+};
+
+/* SubjectPublicKeyInfo of an Ed25519 key up to the 32-byte encoded point */
+static const uint8_t boot_crypto_ed25519_spki[] = {
+    0x30u, 0x2au, 0x30u, 0x05u, 0x06u, 0x03u, 0x2bu, 0x65u, 0x70u, 0x03u, 0x21u, 0x00u,
+};
+
+/* AlgorithmIdentifier of a PKCS #8 P-256 private key: id-ecPublicKey and
+ * prime256v1 */
+static const uint8_t boot_crypto_p256_alg[] = {
+    0x30u, 0x13u, 0x06u, 0x07u, 0x2au, 0x86u, 0x48u, 0xceu, 0x3du, 0x02u, 0x01u,
+    0x06u, 0x08u, 0x2au, 0x86u, 0x48u, 0xceu, 0x3du, 0x03u, 0x01u, 0x07u,
+};
+
+/* HKDF info of the ECIES-P256 key TLV of imgtool */
+static const uint8_t boot_crypto_ecies_info[] = "MCUBoot_ECIES_v1";
+
+#if (BOOT_CRYPTO == BOOT_CRYPTO_HW)
+static bool crypto_enabled = false;
+#endif
+
+#if (BOOT_CRYPTO == BOOT_CRYPTO_HW)
+/*******************************************************************************
+ * Function Name: boot_crypto_reverse
+ ********************************************************************************
+ * Copies a big endian number in the little endian order of the crypto driver.
+ *******************************************************************************/
+static void boot_crypto_reverse(uint8_t *dst, const uint8_t *src, uint32_t length) {
+    for (uint32_t i = 0u; i < length; i++) {
+        dst[i] = src[length - 1u - i];
+    }
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_init
+ ********************************************************************************
+ * Enables the crypto block. Call before any other function of the backend.
+ *
+ * Return:
+ *  0 on success, -1 on failure.
+ *******************************************************************************/
+int boot_crypto_init(void) {
+    crypto_enabled = (CY_CRYPTO_SUCCESS == Cy_Crypto_Core_Enable(CRYPTO));
+    return crypto_enabled ? 0 : -1;
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_deinit
+ ********************************************************************************
+ * Disables the crypto block, before the launch of the next core image.
+ *******************************************************************************/
+void boot_crypto_deinit(void) {
+    if (crypto_enabled) {
+        (void)Cy_Crypto_Core_Disable(CRYPTO);
+        crypto_enabled = false;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_ready
+ ********************************************************************************
+ * Return:
+ *  true if the crypto block is enabled.
+ *******************************************************************************/
+bool boot_crypto_ready(void) {
+    return crypto_enabled;
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_name
+ ********************************************************************************
+ * Return:
+ *  Name of the backend.
+ *******************************************************************************/
+const char *boot_crypto_name(void) {
+    return "hw";
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_sha256_init
+ ********************************************************************************
+ * Starts a SHA-256 on the crypto block.
+ *******************************************************************************/
+void boot_crypto_sha256_init(boot_crypto_sha256_t *ctx) {
+    (void)Cy_Crypto_Core_Sha_Init(CRYPTO, &ctx->state, CY_CRYPTO_MODE_SHA256, &ctx->buffers);
+    (void)Cy_Crypto_Core_Sha_Start(CRYPTO, &ctx->state);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_sha256_update
+ ********************************************************************************
+ * Hashes bytes. The crypto block reads them from memory, so the data cache
+ * of a CM7 is cleaned first.
+ *******************************************************************************/
+void boot_crypto_sha256_update(boot_crypto_sha256_t *ctx, const uint8_t *data, uint32_t length) {
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr((volatile void *)data, (int32_t)length);
+#endif
+    (void)Cy_Crypto_Core_Sha_Update(CRYPTO, &ctx->state, data, length);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_sha256_final
+ ********************************************************************************
+ * Completes the SHA-256 and releases the context.
+ *******************************************************************************/
+void boot_crypto_sha256_final(boot_crypto_sha256_t *ctx, uint8_t digest[BOOT_CRYPTO_SHA256_SIZE]) {
+    (void)Cy_Crypto_Core_Sha_Finish(CRYPTO, &ctx->state, digest);
+    (void)Cy_Crypto_Core_Sha_Free(CRYPTO, &ctx->state);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_p256_verify
+ ********************************************************************************
+ * Verifies an ECDSA P-256 signature on the crypto block.
+ *
+ * Parameters:
+ *  pub            Public key, x then y, big endian.
+ *  hash           SHA-256 of the message.
+ *  sig            Signature, r then s, big endian.
+ *
+ * Return:
+ *  true if the signature is valid.
+ *******************************************************************************/
+bool boot_crypto_p256_verify(const uint8_t pub[BOOT_CRYPTO_P256_KEY_SIZE],
+                             const uint8_t hash[BOOT_CRYPTO_SHA256_SIZE],
+                             const uint8_t sig[BOOT_CRYPTO_P256_SIG_SIZE]) {
+    uint8_t qx[BOOT_CRYPTO_P256_KEY_SIZE / 2u];
+    uint8_t qy[BOOT_CRYPTO_P256_KEY_SIZE / 2u];
+    uint8_t rs[BOOT_CRYPTO_P256_SIG_SIZE];
+    uint8_t e[BOOT_CRYPTO_SHA256_SIZE];
+    cy_stc_crypto_ecc_key key;
+    uint8_t stat = 0u;
+
+    boot_crypto_reverse(qx, pub, sizeof(qx));
+    boot_crypto_reverse(qy, &pub[sizeof(qx)], sizeof(qy));
+    boot_crypto_reverse(rs, sig, sizeof(rs) / 2u);
+    boot_crypto_reverse(&rs[sizeof(rs) / 2u], &sig[sizeof(rs) / 2u], sizeof(rs) / 2u);
+    boot_crypto_reverse(e, hash, sizeof(e));
+
+    memset(&key, 0, sizeof(key));
+    key.type = PK_PUBLIC;
+    key.curveID = CY_CRYPTO_ECC_ECP_SECP256R1;
+    key.pubkey.x = qx;
+    key.pubkey.y = qy;
+
+    return (CY_CRYPTO_SUCCESS == Cy_Crypto_Core_ECC_VerifyHash(CRYPTO, rs, e, sizeof(e), &stat, &key)) &&
+           (stat == 1u);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_aes_init
+ ********************************************************************************
+ * Loads an AES-128 key into the crypto block.
+ *******************************************************************************/
+void boot_crypto_aes_init(boot_crypto_aes_t *ctx, const uint8_t key[BOOT_CRYPTO_AES_KEY_SIZE]) {
+    (void)Cy_Crypto_Core_Aes_Init(CRYPTO, key, CY_CRYPTO_KEY_AES_128, &ctx->state, &ctx->buffers);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_aes_ctr
+ ********************************************************************************
+ * Encrypts or decrypts bytes in the counter mode of the MCUboot image
+ * encryption on the crypto block, see boot_aes_ctr(). A call that starts
+ * inside a block takes its key stream from an ECB encryption of the
+ * counter. The data cache of a CM7 is cleaned before and invalidated after.
+ *
+ * Parameters:
+ *  ctx            Key.
+ *  offset         Offset of the first byte in the image body.
+ *  in             Input bytes.
+ *  out            Receives the output bytes, may be in.
+ *  length         Number of bytes.
+ *******************************************************************************/
+void boot_crypto_aes_ctr(boot_crypto_aes_t *ctx, uint32_t offset, const uint8_t *in, uint8_t *out,
+                         uint32_t length) {
+    uint8_t counter[BOOT_CRYPTO_AES_BLOCK_SIZE];
+    uint8_t stream[BOOT_CRYPTO_AES_BLOCK_SIZE];
+    uint32_t block = offset / BOOT_CRYPTO_AES_BLOCK_SIZE;
+    uint32_t pos = offset % BOOT_CRYPTO_AES_BLOCK_SIZE;
+
+    memset(counter, 0, sizeof(counter));
+    counter[12] = (uint8_t)(block >> 24);
+    counter[13] = (uint8_t)(block >> 16);
+    counter[14] = (uint8_t)(block >> 8);
+    counter[15] = (uint8_t)block;
+    memset(stream, 0, sizeof(stream));
+    if (pos != 0u) {
+        (void)Cy_Crypto_Core_Aes_Ecb(CRYPTO, CY_CRYPTO_ENCRYPT, stream, counter, &ctx->state);
+        block++;
+        counter[12] = (uint8_t)(block >> 24);
+        counter[13] = (uint8_t)(block >> 16);
+        counter[14] = (uint8_t)(block >> 8);
+        counter[15] = (uint8_t)block;
+    }
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr((volatile void *)in, (int32_t)length);
+#endif
+    (void)Cy_Crypto_Core_Aes_Ctr(CRYPTO, &ctx->state, length, &pos, counter, stream, out, in);
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr((volatile void *)out, (int32_t)length);
+#endif
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_aes_free
+ ********************************************************************************
+ * Clears the key from the crypto block.
+ *******************************************************************************/
+void boot_crypto_aes_free(boot_crypto_aes_t *ctx) {
+    (void)Cy_Crypto_Core_Aes_Free(CRYPTO, &ctx->state);
+    memset(ctx, 0, sizeof(*ctx));
+}
+#else
+/*******************************************************************************
+ * Function Name: boot_crypto_init
+ ********************************************************************************
+ * Return:
+ *  0, the software backend needs no initialization.
+ *******************************************************************************/
+int boot_crypto_init(void) {
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_deinit
+ ********************************************************************************
+ * Nothing to release.
+ *******************************************************************************/
+void boot_crypto_deinit(void) {
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_ready
+ ********************************************************************************
+ * Return:
+ *  true, the software backend is always ready.
+ *******************************************************************************/
+bool boot_crypto_ready(void) {
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_name
+ ********************************************************************************
+ * Return:
+ *  Name of the backend.
+ *******************************************************************************/
+const char *boot_crypto_name(void) {
+    return "sw";
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_sha256_init
+ ********************************************************************************
+ * Starts a SHA-256.
+ *******************************************************************************/
+void boot_crypto_sha256_init(boot_crypto_sha256_t *ctx) {
+    dfu_sha256_init(&ctx->sw);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_sha256_update
+ ********************************************************************************
+ * Hashes bytes.
+ *******************************************************************************/
+void boot_crypto_sha256_update(boot_crypto_sha256_t *ctx, const uint8_t *data, uint32_t length) {
+    dfu_sha256_update(&ctx->sw, data, length);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_sha256_final
+ ********************************************************************************
+ * Completes the SHA-256.
+ *******************************************************************************/
+void boot_crypto_sha256_final(boot_crypto_sha256_t *ctx, uint8_t digest[BOOT_CRYPTO_SHA256_SIZE]) {
+    dfu_sha256_final(&ctx->sw, digest);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_p256_verify
+ ********************************************************************************
+ * Verifies an ECDSA P-256 signature in software.
+ *
+ * Parameters:
+ *  pub            Public key, x then y, big endian.
+ *  hash           SHA-256 of the message.
+ *  sig            Signature, r then s, big endian.
+ *
+ * Return:
+ *  true if the signature is valid.
+ *******************************************************************************/
+bool boot_crypto_p256_verify(const uint8_t pub[BOOT_CRYPTO_P256_KEY_SIZE],
+                             const uint8_t hash[BOOT_CRYPTO_SHA256_SIZE],
+                             const uint8_t sig[BOOT_CRYPTO_P256_SIG_SIZE]) {
+    return boot_p256_verify(pub, hash, sig);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_aes_init
+ ********************************************************************************
+ * Expands an AES-128 key.
+ *******************************************************************************/
+void boot_crypto_aes_init(boot_crypto_aes_t *ctx, const uint8_t key[BOOT_CRYPTO_AES_KEY_SIZE]) {
+    boot_aes_init(&ctx->sw, key);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_aes_ctr
+ ********************************************************************************
+ * Encrypts or decrypts bytes in the counter mode of the MCUboot image
+ * encryption, see boot_aes_ctr().
+ *******************************************************************************/
+void boot_crypto_aes_ctr(boot_crypto_aes_t *ctx, uint32_t offset, const uint8_t *in, uint8_t *out,
+                         uint32_t length) {
+    boot_aes_ctr(&ctx->sw, offset, in, out, length);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_aes_free
+ ********************************************************************************
+ * Clears the round keys.
+ *******************************************************************************/
+void boot_crypto_aes_free(boot_crypto_aes_t *ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+#endif /* BOOT_CRYPTO */
+
+/*******************************************************************************
+ * Function Name: boot_crypto_der_integer
+ ********************************************************************************
+ * Reads a positive DER INTEGER of up to 32 bytes as a 32-byte big endian
+ * number.
+ *
+ * Parameters:
+ *  der            Encoding.
+ *  length         Bytes left in the encoding.
+ *  value          Receives the number.
+ *
+ * Return:
+ *  Bytes of the INTEGER, 0 if it is not a valid one.
+ *******************************************************************************/
+static uint32_t boot_crypto_der_integer(const uint8_t *der, uint32_t length, uint8_t value[32]) {
+    uint32_t size;
+    uint32_t skip = 0u;
+
+    if ((length < 3u) || (der[0] != BOOT_CRYPTO_DER_INTEGER) || (der[1] == 0u) || (der[1] > 33u) ||
+        (2u + (uint32_t)der[1] > length) || ((der[2] & 0x80u) != 0u)) {
+        return 0u;
+    }
+    size = der[1];
+    /* A leading zero only keeps the number positive */
+    if ((size > 1u) && (der[2] == 0u)) {
+        skip = 1u;
+    }
+    if (size - skip > 32u) {
+        return 0u;
+    }
+    memset(value, 0, 32u);
+    memcpy(&value[32u - (size - skip)], &der[2u + skip], size - skip);
+    return 2u + size;
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_p256_verify_der
+ ********************************************************************************
+ * Verifies an ECDSA P-256 signature of an image: the key is the
+ * SubjectPublicKeyInfo of the built-in key and the signature the
+ * ECDSA-Sig-Value of the signature TLV.
+ *
+ * Parameters:
+ *  key            DER public key.
+ *  key_len        Bytes of the key.
+ *  hash           SHA-256 of the image.
+ *  sig            DER signature.
+ *  sig_len        Bytes of the signature.
+ *
+ * Return:
+ *  true if the signature is valid.
+ *******************************************************************************/
+bool boot_crypto_p256_verify_der(const uint8_t *key, uint32_t key_len,
+                                 const uint8_t hash[BOOT_CRYPTO_SHA256_SIZE],
+                                 const uint8_t *sig, uint32_t sig_len) {
+    uint8_t rs[BOOT_CRYPTO_P256_SIG_SIZE];
+    uint32_t off = 2u;
+    uint32_t size;
+
+    if ((key_len != sizeof(boot_crypto_p256_spki) + BOOT_CRYPTO_P256_KEY_SIZE) ||
+        (memcmp(key, boot_crypto_p256_spki, sizeof(boot_crypto_p256_spki)) != 0)) {
+        return false;
+    }
+    if ((sig_len < 2u) || (sig[0] != BOOT_CRYPTO_DER_SEQUENCE) || (2u + (uint32_t)sig[1] > sig_len)) {
+        return false;
+    }
+
+    size = boot_crypto_der_integer(&sig[off], 2u + sig[1] - off, rs);
+    off += size;
+    if (size != 0u) {
+        size = boot_crypto_der_integer(&sig[off], 2u + sig[1] - off, &rs[BOOT_CRYPTO_P256_SIG_SIZE / 2u]);
+        off += size;
+    }
+    if ((size == 0u) || (off != 2u + (uint32_t)sig[1])) {
+        return false;
+    }
+    return boot_crypto_p256_verify(&key[sizeof(boot_crypto_p256_spki)], hash, rs);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_ed25519_verify
+ ********************************************************************************
+ * Verifies an Ed25519 signature in software, with both backends: the crypto
+ * block has no Edwards curve arithmetic.
+ *
+ * Parameters:
+ *  pub            Public key, the encoded point.
+ *  msg            Message.
+ *  msg_len        Length of the message.
+ *  sig            Signature, R then S.
+ *
+ * Return:
+ *  true if the signature is valid.
+ *******************************************************************************/
+bool boot_crypto_ed25519_verify(const uint8_t pub[BOOT_CRYPTO_ED25519_KEY_SIZE], const uint8_t *msg,
+                                uint32_t msg_len, const uint8_t sig[BOOT_CRYPTO_ED25519_SIG_SIZE]) {
+    return boot_ed25519_verify(pub, msg, msg_len, sig);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_ed25519_verify_der
+ ********************************************************************************
+ * Verifies the Ed25519 signature of an image: the key is the
+ * SubjectPublicKeyInfo of the built-in key, the signature the 64 bytes of
+ * the signature TLV and the message the SHA-256 of the image, as signed by
+ * imgtool.
+ *
+ * Parameters:
+ *  key            DER public key.
+ *  key_len        Bytes of the key.
+ *  hash           SHA-256 of the image.
+ *  sig            Signature.
+ *  sig_len        Bytes of the signature.
+ *
+ * Return:
+ *  true if the signature is valid.
+ *******************************************************************************/
+bool boot_crypto_ed25519_verify_der(const uint8_t *key, uint32_t key_len,
+                                    const uint8_t hash[BOOT_CRYPTO_SHA256_SIZE],
+                                    const uint8_t *sig, uint32_t sig_len) {
+    if ((key_len != sizeof(boot_crypto_ed25519_spki) + BOOT_CRYPTO_ED25519_KEY_SIZE) ||
+        (memcmp(key, boot_crypto_ed25519_spki, sizeof(boot_crypto_ed25519_spki)) != 0) ||
+        (sig_len != BOOT_CRYPTO_ED25519_SIG_SIZE)) {
+        return false;
+    }
+    return boot_crypto_ed25519_verify(&key[sizeof(boot_crypto_ed25519_spki)], hash, BOOT_CRYPTO_SHA256_SIZE,
+                                      sig);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_p256_ecdh
+ ********************************************************************************
+ * Computes the ECDH shared secret of the key of an encrypted image, in
+ * software with both backends: one per upgrade.
+ *
+ * Parameters:
+ *  priv           Private key, big endian.
+ *  pub            Public key of the peer, x then y, big endian.
+ *  shared         Receives the x coordinate of the shared point.
+ *
+ * Return:
+ *  true on success, false if a key is not valid.
+ *******************************************************************************/
+bool boot_crypto_p256_ecdh(const uint8_t priv[BOOT_CRYPTO_P256_PRIV_SIZE],
+                           const uint8_t pub[BOOT_CRYPTO_P256_KEY_SIZE],
+                           uint8_t shared[BOOT_CRYPTO_P256_PRIV_SIZE]) {
+    return boot_p256_ecdh(priv, pub, shared);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_der_header
+ ********************************************************************************
+ * Reads the tag and the length of a DER element, in short or one or two
+ * byte long form.
+ *
+ * Parameters:
+ *  der            Encoding.
+ *  length         Bytes left in the encoding.
+ *  tag            Expected tag.
+ *  size           Receives the length of the contents.
+ *
+ * Return:
+ *  Bytes of the tag and length, 0 if the element does not fit or has
+ *  another tag.
+ *******************************************************************************/
+static uint32_t boot_crypto_der_header(const uint8_t *der, uint32_t length, uint8_t tag, uint32_t *size) {
+    uint32_t header = 2u;
+
+    if ((length < 2u) || (der[0] != tag)) {
+        return 0u;
+    }
+    *size = der[1];
+    if (der[1] == 0x81u) {
+        header = 3u;
+        *size = (length >= 3u) ? der[2] : 0u;
+    } else if (der[1] == 0x82u) {
+        header = 4u;
+        *size = (length >= 4u) ? (((uint32_t)der[2] << 8) | der[3]) : 0u;
+    } else if (der[1] > 0x7fu) {
+        return 0u;
+    } else {
+        /* Short form */
+    }
+    return (header + *size <= length) ? header : 0u;
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_p256_priv_der
+ ********************************************************************************
+ * Reads the P-256 private key of the image encryption, the PKCS #8
+ * PrivateKeyInfo that imgtool getpriv writes or the ECPrivateKey it holds.
+ *
+ * Parameters:
+ *  der            DER private key.
+ *  der_len        Bytes of the key.
+ *  priv           Receives the private key, big endian.
+ *
+ * Return:
+ *  true if the key is a P-256 private key.
+ *******************************************************************************/
+bool boot_crypto_p256_priv_der(const uint8_t *der, uint32_t der_len, uint8_t priv[BOOT_CRYPTO_P256_PRIV_SIZE]) {
+    uint32_t size = 0u;
+    uint32_t off = boot_crypto_der_header(der, der_len, BOOT_CRYPTO_DER_SEQUENCE, &size);
+    uint32_t end = off + size;
+    uint32_t header;
+
+    /* version: 0 for PrivateKeyInfo, 1 for ECPrivateKey */
+    if ((off == 0u) || (off + 3u > end) || (der[off] != BOOT_CRYPTO_DER_INTEGER) || (der[off + 1u] != 1u)) {
+        return false;
+    }
+    if (der[off + 2u] == 0u) {
+        off += 3u;
+        if ((off + sizeof(boot_crypto_p256_alg) > end) ||
+            (memcmp(&der[off], boot_crypto_p256_alg, sizeof(boot_crypto_p256_alg)) != 0)) {
+            return false;
+        }
+        off += sizeof(boot_crypto_p256_alg);
+        header = boot_crypto_der_header(&der[off], end - off, BOOT_CRYPTO_DER_OCTETS, &size);
+        return (header != 0u) && boot_crypto_p256_priv_der(&der[off + header], size, priv);
+    }
+    if (der[off + 2u] != 1u) {
+        return false;
+    }
+    off += 3u;
+    header = boot_crypto_der_header(&der[off], end - off, BOOT_CRYPTO_DER_OCTETS, &size);
+    if ((header == 0u) || (size != BOOT_CRYPTO_P256_PRIV_SIZE)) {
+        return false;
+    }
+    memcpy(priv, &der[off + header], BOOT_CRYPTO_P256_PRIV_SIZE);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_hmac_sha256
+ ********************************************************************************
+ * Computes an HMAC-SHA256 (RFC 2104) with the SHA-256 of the backend.
+ *
+ * Parameters:
+ *  key            Key.
+ *  key_len        Bytes of the key, hashed first if longer than a block.
+ *  data           Message.
+ *  length         Bytes of the message.
+ *  mac            Receives the MAC.
+ *******************************************************************************/
+void boot_crypto_hmac_sha256(const uint8_t *key, uint32_t key_len, const uint8_t *data, uint32_t length,
+                             uint8_t mac[BOOT_CRYPTO_SHA256_SIZE]) {
+    boot_crypto_sha256_t ctx;
+    uint8_t pad[BOOT_CRYPTO_HMAC_BLOCK];
+    uint8_t inner[BOOT_CRYPTO_SHA256_SIZE];
+
+    memset(pad, 0, sizeof(pad));
+    if (key_len > sizeof(pad)) {
+        boot_crypto_sha256_init(&ctx);
+        boot_crypto_sha256_update(&ctx, key, key_len);
+        boot_crypto_sha256_final(&ctx, pad);
+    } else {
+        memcpy(pad, key, key_len);
+    }
+
+    for (uint32_t i = 0u; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36u;
+    }
+    boot_crypto_sha256_init(&ctx);
+    boot_crypto_sha256_update(&ctx, pad, sizeof(pad));
+    boot_crypto_sha256_update(&ctx, data, length);
+    boot_crypto_sha256_final(&ctx, inner);
+
+    /* 0x36 ^ 0x5c turns the inner pad into the outer pad */
+    for (uint32_t i = 0u; i < sizeof(pad); i++) {
+        pad[i] ^= 0x36u ^ 0x5cu;
+    }
+    boot_crypto_sha256_init(&ctx);
+    boot_crypto_sha256_update(&ctx, pad, sizeof(pad));
+    boot_crypto_sha256_update(&ctx, inner, sizeof(inner));
+    boot_crypto_sha256_final(&ctx, mac);
+    memset(pad, 0, sizeof(pad));
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_hkdf_sha256
+ ********************************************************************************
+ * Derives keys with HKDF-SHA256 (RFC 5869).
+ *
+ * Parameters:
+ *  ikm            Input keying material.
+ *  ikm_len        Bytes of the input keying material.
+ *  salt           Salt, NULL for none: a block of zeros.
+ *  salt_len       Bytes of the salt.
+ *  info           Context.
+ *  info_len       Bytes of the context.
+ *  okm            Receives the output keying material.
+ *  okm_len        Bytes to derive, up to 255 hashes.
+ *
+ * Return:
+ *  true on success, false if okm_len is too large.
+ *******************************************************************************/
+bool boot_crypto_hkdf_sha256(const uint8_t *ikm, uint32_t ikm_len, const uint8_t *salt, uint32_t salt_len,
+                             const uint8_t *info, uint32_t info_len, uint8_t *okm, uint32_t okm_len) {
+    static const uint8_t zeros[BOOT_CRYPTO_SHA256_SIZE] = { 0u };
+    uint8_t prk[BOOT_CRYPTO_SHA256_SIZE];
+    uint8_t t[BOOT_CRYPTO_SHA256_SIZE + BOOT_CRYPTO_HMAC_BLOCK + 1u];
+    uint8_t block[BOOT_CRYPTO_SHA256_SIZE];
+    uint32_t t_len = 0u;
+
+    if ((okm_len > 255u * BOOT_CRYPTO_SHA256_SIZE) || (info_len > BOOT_CRYPTO_HMAC_BLOCK)) {
+        return false;
+    }
+    if (salt == NULL) {
+        salt = zeros;
+        salt_len = sizeof(zeros);
+    }
+    boot_crypto_hmac_sha256(salt, salt_len, ikm, ikm_len, prk);
+
+    /* T(i) = HMAC(PRK, T(i - 1) | info | i) */
+    for (uint32_t i = 1u; okm_len > 0u; i++) {
+        uint32_t chunk = (okm_len < sizeof(block)) ? okm_len : sizeof(block);
+
+        memcpy(&t[t_len], info, info_len);
+        t[t_len + info_len] = (uint8_t)i;
+        boot_crypto_hmac_sha256(prk, sizeof(prk), t, t_len + info_len + 1u, block);
+        memcpy(okm, block, chunk);
+        memcpy(t, block, sizeof(block));
+        t_len = sizeof(block);
+        okm += chunk;
+        okm_len -= chunk;
+    }
+    memset(prk, 0, sizeof(prk));
+    memset(t, 0, sizeof(t));
+    memset(block, 0, sizeof(block));
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_ecies_p256_unwrap
+ ********************************************************************************
+ * Recovers the AES-128 key of an image encrypted by imgtool with an EC
+ * P-256 key: the ECDH of the private key and the ephemeral public key of
+ * the TLV, HKDF-SHA256 of the shared secret into an AES-128 key and an
+ * HMAC-SHA256 key, the tag checked over the encrypted key, and the key
+ * decrypted in counter mode from a zero counter.
+ *
+ * Parameters:
+ *  priv           Private key of the image encryption.
+ *  tlv            ENC_EC256 TLV of the image.
+ *  key            Receives the key of the image.
+ *
+ * Return:
+ *  true if the tag is valid.
+ *******************************************************************************/
+bool boot_crypto_ecies_p256_unwrap(const uint8_t priv[BOOT_CRYPTO_P256_PRIV_SIZE],
+                                   const uint8_t tlv[BOOT_CRYPTO_ECIES_SIZE],
+                                   uint8_t key[BOOT_CRYPTO_AES_KEY_SIZE]) {
+    boot_crypto_aes_t aes;
+    uint8_t shared[BOOT_CRYPTO_P256_PRIV_SIZE];
+    uint8_t derived[BOOT_CRYPTO_AES_KEY_SIZE + BOOT_CRYPTO_SHA256_SIZE];
+    uint8_t tag[BOOT_CRYPTO_SHA256_SIZE];
+    uint8_t diff = 0u;
+    bool valid;
+
+    if ((tlv[BOOT_CRYPTO_ECIES_PUB_OFF] != 0x04u) ||
+        !boot_crypto_p256_ecdh(priv, &tlv[BOOT_CRYPTO_ECIES_PUB_OFF + 1u], shared)) {
+        return false;
+    }
+    valid = boot_crypto_hkdf_sha256(shared, sizeof(shared), NULL, 0u, boot_crypto_ecies_info,
+                                    sizeof(boot_crypto_ecies_info) - 1u, derived, sizeof(derived));
+    memset(shared, 0, sizeof(shared));
+
+    boot_crypto_hmac_sha256(&derived[BOOT_CRYPTO_AES_KEY_SIZE], BOOT_CRYPTO_SHA256_SIZE,
+                            &tlv[BOOT_CRYPTO_ECIES_KEY_OFF], BOOT_CRYPTO_AES_KEY_SIZE, tag);
+    for (uint32_t i = 0u; i < sizeof(tag); i++) {
+        diff |= tag[i] ^ tlv[BOOT_CRYPTO_ECIES_TAG_OFF + i];
+    }
+    valid = valid && (diff == 0u);
+    if (valid) {
+        boot_crypto_aes_init(&aes, derived);
+        boot_crypto_aes_ctr(&aes, 0u, &tlv[BOOT_CRYPTO_ECIES_KEY_OFF], key, BOOT_CRYPTO_AES_KEY_SIZE);
+        boot_crypto_aes_free(&aes);
+    }
+    memset(derived, 0, sizeof(derived));
+    return valid;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * File Name:   boot_crypto.h
+ *
+ * Description: This file contains the declarations of the crypto backend of the image validation:
+ *              SHA-256 and ECDSA P-256 in software, or on the crypto block of the device, and
+ *              Ed25519 in software. It also decrypts the encrypted images: AES-128 in counter mode
+ *              in software or on the crypto block, and the ECIES-P256 key unwrap of imgtool.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef BOOT_CRYPTO_H
+#define BOOT_CRYPTO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Backends, selected with BOOT_CRYPTO in user_config.mk */
+#define BOOT_CRYPTO_SW              (0)
+#define BOOT_CRYPTO_HW              (1)
+
+#ifndef BOOT_CRYPTO
+#define BOOT_CRYPTO                 BOOT_CRYPTO_SW
+#endif
+
+/* Set to 1 to run the known-answer tests at the start of the DFU application */
+#ifndef BOOT_CRYPTO_KAT
+#define BOOT_CRYPTO_KAT             (0)
+#endif
+
+#define BOOT_CRYPTO_SHA256_SIZE     (32u)
+/* Public key, x then y, and signature, r then s, big endian */
+#define BOOT_CRYPTO_P256_KEY_SIZE   (64u)
+#define BOOT_CRYPTO_P256_SIG_SIZE   (64u)
+/* Encoded point, and signature, R then S */
+#define BOOT_CRYPTO_ED25519_KEY_SIZE    (32u)
+#define BOOT_CRYPTO_ED25519_SIG_SIZE    (64u)
+/* Private key and ECDH shared secret, big endian */
+#define BOOT_CRYPTO_P256_PRIV_SIZE  (32u)
+#define BOOT_CRYPTO_AES_KEY_SIZE    (16u)
+#define BOOT_CRYPTO_AES_BLOCK_SIZE  (16u)
+/* ECIES-P256 key TLV of imgtool: ephemeral public key, uncompressed, then
+ * the HMAC-SHA256 tag and the AES-128 key of the image, encrypted */
+#define BOOT_CRYPTO_ECIES_PUB_OFF   (0u)
+#define BOOT_CRYPTO_ECIES_TAG_OFF   (65u)
+#define BOOT_CRYPTO_ECIES_KEY_OFF   (97u)
+#define BOOT_CRYPTO_ECIES_SIZE      (113u)
+
+#if (BOOT_CRYPTO == BOOT_CRYPTO_HW)
+#include "cy_pdl.h"
+#else
+#include "boot_aes.h"
+#include "dfu_sha256.h"
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+#if (BOOT_CRYPTO == BOOT_CRYPTO_HW)
+    cy_stc_crypto_sha_state_t state;
+    cy_stc_crypto_v2_sha256_buffers_t buffers;
+#else
+    dfu_sha256_t sw;
+#endif
+} boot_crypto_sha256_t;
+
+typedef struct {
+#if (BOOT_CRYPTO == BOOT_CRYPTO_HW)
+    cy_stc_crypto_aes_state_t state;
+    cy_stc_crypto_aes_buffers_t buffers;
+#else
+    boot_aes_t sw;
+#endif
+} boot_crypto_aes_t;
+
+/* Called with the result of every known-answer test */
+typedef void (*boot_crypto_kat_report_t)(const char *name, bool passed);
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+int boot_crypto_init(void);
+void boot_crypto_deinit(void);
+bool boot_crypto_ready(void);
+const char *boot_crypto_name(void);
+void boot_crypto_sha256_init(boot_crypto_sha256_t *ctx);
+void boot_crypto_sha256_update(boot_crypto_sha256_t *ctx, const uint8_t *data, uint32_t length);
+void boot_crypto_sha256_final(boot_crypto_sha256_t *ctx, uint8_t digest[BOOT_CRYPTO_SHA256_SIZE]);
+bool boot_crypto_p256_verify(const uint8_t pub[BOOT_CRYPTO_P256_KEY_SIZE],
+                             const uint8_t hash[BOOT_CRYPTO_SHA256_SIZE],
+                             const uint8_t sig[BOOT_CRYPTO_P256_SIG_SIZE]);
+bool boot_crypto_p256_verify_der(const uint8_t *key, uint32_t key_len,
+                                 const uint8_t hash[BOOT_CRYPTO_SHA256_SIZE],
+                                 const uint8_t *sig, uint32_t sig_len);
+bool boot_crypto_ed25519_verify(const uint8_t pub[BOOT_CRYPTO_ED25519_KEY_SIZE], const uint8_t *msg,
+                                uint32_t msg_len, const uint8_t sig[BOOT_CRYPTO_ED25519_SIG_SIZE]);
+bool boot_crypto_ed25519_verify_der(const uint8_t *key, uint32_t key_len,
+                                    const uint8_t hash[BOOT_CRYPTO_SHA256_SIZE],
+                                    const uint8_t *sig, uint32_t sig_len);
+void boot_crypto_aes_init(boot_crypto_aes_t *ctx, const uint8_t key[BOOT_CRYPTO_AES_KEY_SIZE]);
+void boot_crypto_aes_ctr(boot_crypto_aes_t *ctx, uint32_t offset, const uint8_t *in, uint8_t *out,
+                         uint32_t length);
+void boot_crypto_aes_free(boot_crypto_aes_t *ctx);
+bool boot_crypto_p256_ecdh(const uint8_t priv[BOOT_CRYPTO_P256_PRIV_SIZE],
+                           const uint8_t pub[BOOT_CRYPTO_P256_KEY_SIZE],
+                           uint8_t shared[BOOT_CRYPTO_P256_PRIV_SIZE]);
+bool boot_crypto_p256_priv_der(const uint8_t *der, uint32_t der_len, uint8_t priv[BOOT_CRYPTO_P256_PRIV_SIZE]);
+void boot_crypto_hmac_sha256(const uint8_t *key, uint32_t key_len, const uint8_t *data, uint32_t length,
+                             uint8_t mac[BOOT_CRYPTO_SHA256_SIZE]);
+bool boot_crypto_hkdf_sha256(const uint8_t *ikm, uint32_t ikm_len, const uint8_t *salt, uint32_t salt_len,
+                             const uint8_t *info, uint32_t info_len, uint8_t *okm, uint32_t okm_len);
+bool boot_crypto_ecies_p256_unwrap(const uint8_t priv[BOOT_CRYPTO_P256_PRIV_SIZE],
+                                   const uint8_t tlv[BOOT_CRYPTO_ECIES_SIZE],
+                                   uint8_t key[BOOT_CRYPTO_AES_KEY_SIZE]);
+uint32_t boot_crypto_kat_run(boot_crypto_kat_report_t report);
+
+#endif /* BOOT_CRYPTO_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,637 @@
+/******************************************************************************
+ * File Name:   boot_crypto_kat.c
+ *
+ * Description: This file contains the known-answer tests of the crypto backend: SHA-256 vectors of
+ *              FIPS 180-2, ECDSA P-256 vectors of RFC 6979 and a signature of the test key of
+ *              keys/, Ed25519 vectors of RFC 8032 and a signature of the Ed25519 test key, with
+ *              tampered copies that must fail. The host crypto bench and the DFU application run
+ *              the same tests.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "boot_crypto.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* The one million 'a' vector is hashed in updates of this size */
+#define KAT_MILLION_CHUNK           (64u)
+#define KAT_MILLION_LENGTH          (1000000u)
+#define KAT_CTR_LENGTH              (64u)
+#define KAT_HKDF_LENGTH             (42u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    const char *name;
+    const char *message;
+    uint8_t digest[BOOT_CRYPTO_SHA256_SIZE];
+} kat_sha256_t;
+
+typedef struct {
+    const char *name;
+    uint8_t hash[BOOT_CRYPTO_SHA256_SIZE];
+    uint8_t sig[BOOT_CRYPTO_P256_SIG_SIZE];
+} kat_p256_t;
+
+typedef struct {
+    const char *name;
+    uint8_t message[2];
+    uint32_t message_len;
+    uint8_t pub[BOOT_CRYPTO_ED25519_KEY_SIZE];
+    uint8_t sig[BOOT_CRYPTO_ED25519_SIG_SIZE];
+} kat_ed25519_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const kat_sha256_t kat_sha256[] = {
+    {
+        "sha256 empty", "",
+        {
+            0xe3u, 0xb0u, 0xc4u, 0x42u, 0x98u, 0xfcu, 0x1cu, 0x14u, 0x9au, 0xfbu, 0xf4u, 0xc8u,
+            0x99u, 0x6fu, 0xb9u, 0x24u, 0x27u, 0xaeu, 0x41u, 0xe4u, 0x64u, 0x9bu, 0x93u, 0x4cu,
+            0xa4u, 0x95u, 0x99u, 0x1bu, 0x78u, 0x52u, 0xb8u, 0x55u,
+        },
+    },
+    {
+        "sha256 abc", "abc",
+        {
+            0xbau, 0x78u, 0x16u, 0xbfu, 0x8fu, 0x01u, 0xcfu, 0xeau, 0x41u, 0x41u, 0x40u, 0xdeu,
+            0x5du, 0xaeu, 0x22u, 0x23u, 0xb0u, 0x03u, 0x61u, 0xa3u, 0x96u, 0x17u, 0x7au, 0x9cu,
+            0xb4u, 0x10u, 0xffu, 0x61u, 0xf2u, 0x00u, 0x15u, 0xadu,
+        },
+    },
+    {
+        "sha256 two blocks",
+        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+        {
+            0x24u, 0x8du, 0x6au, 0x61u, 0xd2u, 0x06u, 0x38u, 0xb8u, 0xe5u, 0xc0u, 0x26u, 0x93u,
+            0x0cu, 0x3eu, 0x60u, 0x39u, 0xa3u, 0x3cu, 0xe4u, 0x59u, 0x64u, 0xffu, 0x21u, 0x67u,
+            0xf6u, 0xecu, 0xedu, 0xd4u, 0x19u, 0xdbu, 0x06u, 0xc1u,
+        },
+    },
+    {
+        "sha256 three blocks",
+        "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+        "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+        {
+            0xcfu, 0x5bu, 0x16u, 0xa7u, 0x78u, 0xafu, 0x83u, 0x80u, 0x03u, 0x6cu, 0xe5u, 0x9eu,
+            0x7bu, 0x04u, 0x92u, 0x37u, 0x0bu, 0x24u, 0x9bu, 0x11u, 0xe8u, 0xf0u, 0x7au, 0x51u,
+            0xafu, 0xacu, 0x45u, 0x03u, 0x7au, 0xfeu, 0xe9u, 0xd1u,
+        },
+    },
+};
+
+static const uint8_t kat_sha256_million[BOOT_CRYPTO_SHA256_SIZE] = {
+    0xcdu, 0xc7u, 0x6eu, 0x5cu, 0x99u, 0x14u, 0xfbu, 0x92u, 0x81u, 0xa1u, 0xc7u, 0xe2u,
+    0x84u, 0xd7u, 0x3eu, 0x67u, 0xf1u, 0x80u, 0x9au, 0x48u, 0xa4u, 0x97u, 0x20u, 0x0eu,
+    0x04u, 0x6du, 0x39u, 0xccu, 0xc7u, 0x11u, 0x2cu, 0xd0u,
+};
+
+/* Key of RFC 6979 A.2.5 */
+static const uint8_t kat_p256_rfc6979_pub[BOOT_CRYPTO_P256_KEY_SIZE] = {
+    0x60u, 0xfeu, 0xd4u, 0xbau, 0x25u, 0x5au, 0x9du, 0x31u, 0xc9u, 0x61u, 0xebu, 0x74u,
+    0xc6u, 0x35u, 0x6du, 0x68u, 0xc0u, 0x49u, 0xb8u, 0x92u, 0x3bu, 0x61u, 0xfau, 0x6cu,
+    0xe6u, 0x69u, 0x62u, 0x2eu, 0x60u, 0xf2u, 0x9fu, 0xb6u, 0x79u, 0x03u, 0xfeu, 0x10u,
+    0x08u, 0xb8u, 0xbcu, 0x99u, 0xa4u, 0x1au, 0xe9u, 0xe9u, 0x56u, 0x28u, 0xbcu, 0x64u,
+    0xf2u, 0xf1u, 0xb2u, 0x0cu, 0x2du, 0x7eu, 0x9fu, 0x51u, 0x77u, 0xa3u, 0xc2u, 0x94u,
+    0xd4u, 0x46u, 0x22u, 0x99u,
+};
+
+static const kat_p256_t kat_p256[] = {
+    {
+        "p256 rfc6979 sample",
+        {
+            0xafu, 0x2bu, 0xdbu, 0xe1u, 0xaau, 0x9bu, 0x6eu, 0xc1u, 0xe2u, 0xadu, 0xe1u, 0xd6u,
+            0x94u, 0xf4u, 0x1fu, 0xc7u, 0x1au, 0x83u, 0x1du, 0x02u, 0x68u, 0xe9u, 0x89u, 0x15u,
+            0x62u, 0x11u, 0x3du, 0x8au, 0x62u, 0xadu, 0xd1u, 0xbfu,
+        },
+        {
+            0xefu, 0xd4u, 0x8bu, 0x2au, 0xacu, 0xb6u, 0xa8u, 0xfdu, 0x11u, 0x40u, 0xddu, 0x9cu,
+            0xd4u, 0x5eu, 0x81u, 0xd6u, 0x9du, 0x2cu, 0x87u, 0x7bu, 0x56u, 0xaau, 0xf9u, 0x91u,
+            0xc3u, 0x4du, 0x0eu, 0xa8u, 0x4eu, 0xafu, 0x37u, 0x16u, 0xf7u, 0xcbu, 0x1cu, 0x94u,
+            0x2du, 0x65u, 0x7cu, 0x41u, 0xd4u, 0x36u, 0xc7u, 0xa1u, 0xb6u, 0xe2u, 0x9fu, 0x65u,
+            0xf3u, 0xe9u, 0x00u, 0xdbu, 0xb9u, 0xafu, 0xf4u, 0x06u, 0x4du, 0xc4u, 0xabu, 0x2fu,
+            0x84u, 0x3au, 0xcdu, 0xa8u,
+        },
+    },
+    {
+        "p256 rfc6979 test",
+        {
+            0x9fu, 0x86u, 0xd0u, 0x81u, 0x88u, 0x4cu, 0x7du, 0x65u, 0x9au, 0x2fu, 0xeau, 0xa0u,
+            0xc5u, 0x5au, 0xd0u, 0x15u, 0xa3u, 0xbfu, 0x4fu, 0x1bu, 0x2bu, 0x0bu, 0x82u, 0x2cu,
+            0xd1u, 0x5du, 0x6cu, 0x15u, 0xb0u, 0xf0u, 0x0au, 0x08u,
+        },
+        {
+            0xf1u, 0xabu, 0xb0u, 0x23u, 0x51u, 0x83u, 0x51u, 0xcdu, 0x71u, 0xd8u, 0x81u, 0x56u,
+            0x7bu, 0x1eu, 0xa6u, 0x63u, 0xedu, 0x3eu, 0xfcu, 0xf6u, 0xc5u, 0x13u, 0x2bu, 0x35u,
+            0x4fu, 0x28u, 0xd3u, 0xb0u, 0xb7u, 0xd3u, 0x83u, 0x67u, 0x01u, 0x9fu, 0x41u, 0x13u,
+            0x74u, 0x2au, 0x2bu, 0x14u, 0xbdu, 0x25u, 0x92u, 0x6bu, 0x49u, 0xc6u, 0x49u, 0x15u,
+            0x5fu, 0x26u, 0x7eu, 0x60u, 0xd3u, 0x81u, 0x4bu, 0x4cu, 0x0cu, 0xc8u, 0x42u, 0x50u,
+            0xe4u, 0x6fu, 0x00u, 0x83u,
+        },
+    },
+};
+
+/* keys/cypress-test-ec-p256.pem as imgtool embeds it, and its signature of
+ * "Edge Protect Bootloader" in the encoding of the signature TLV */
+static const uint8_t kat_p256_test_key[] = {
+    0x30u, 0x59u, 0x30u, 0x13u, 0x06u, 0x07u, 0x2au, 0x86u, 0x48u, 0xceu, 0x3du, 0x02u,
+    0x01u, 0x06u, 0x08u, 0x2au, 0x86u, 0x48u, 0xceu, 0x3du, 0x03u, 0x01u, 0x07u, 0x03u,
+    0x42u, 0x00u, 0x04u, 0x82u, 0x79u, 0x8fu, 0x11u, 0x17u, 0x8fu, 0x92u, 0xa7u, 0xb8u,
+    0x52u, 0x87u, 0xafu, 0x80u, 0x88u, 0x47u, 0x33u, 0xebu, 0x44u, 0x18u, 0x7cu, 0xf3u,
+    0xf5u, 0xefu, 0x9eu, 0xbfu, 0xdcu, 0x70u, 0xd9u, 0x81u, 0xf7u, 0xd8u, 0xe1u, 0xd0u,
+    0x40u, 0x2au, 0xcdu, 0xa9u, 0x89u, 0x97u, 0xa6u, 0x36u, 0x8cu, 0x5fu, 0x93u, 0x67u,
+    0xfeu, 0x55u, 0x85u, 0xe3u, 0x39u, 0xa2u, 0xdeu, 0xdfu, 0x97u, 0xafu, 0x6cu, 0x24u,
+    0xc9u, 0x74u, 0xffu, 0xeeu, 0x84u, 0x0eu, 0xfeu,
+};
+
+static const uint8_t kat_p256_test_hash[BOOT_CRYPTO_SHA256_SIZE] = {
+    0xaeu, 0x94u, 0x41u, 0xd0u, 0xfbu, 0x57u, 0x3fu, 0xbeu, 0xc7u, 0xbau, 0x9bu, 0xeeu,
+    0x8du, 0xb8u, 0xbdu, 0x57u, 0x24u, 0xbau, 0xdau, 0x27u, 0x4bu, 0x8du, 0xe6u, 0x30u,
+    0xb2u, 0x43u, 0xd0u, 0x90u, 0x99u, 0x7au, 0x88u, 0x65u,
+};
+
+static const uint8_t kat_p256_test_sig[] = {
+    0x30u, 0x45u, 0x02u, 0x21u, 0x00u, 0xa7u, 0xddu, 0x1eu, 0xe0u, 0xd5u, 0x7fu, 0x26u,
+    0x1fu, 0x37u, 0x33u, 0x90u, 0x36u, 0x84u, 0x5eu, 0x35u, 0xdcu, 0xc2u, 0xc3u, 0x93u,
+    0x3fu, 0xe5u, 0xe2u, 0xd4u, 0x0au, 0xbbu, 0x1bu, 0xa3u, 0xb4u, 0x4bu, 0x5bu, 0x3cu,
+    0xacu, 0x02u, 0x20u, 0x1fu, 0xc4u, 0xceu, 0xdbu, 0xd7u, 0x44u, 0x48u, 0x7au, 0x14u,
+    0xb8u, 0x6bu, 0xbeu, 0xc4u, 0xa4u, 0x11u, 0x62u, 0x81u, 0xd9u, 0x99u, 0x56u, 0xdau,
+    0x19u, 0x25u, 0xe2u, 0xf5u, 0x00u, 0xa9u, 0xb8u, 0x78u, 0x1au, 0x01u, 0xb4u,
+};
+
+/* RFC 8032 7.1, tests 1 to 3 */
+static const kat_ed25519_t kat_ed25519[] = {
+    {
+        "ed25519 rfc8032 test 1",
+        { 0x00u },
+        0u,
+        {
+            0xd7u, 0x5au, 0x98u, 0x01u, 0x82u, 0xb1u, 0x0au, 0xb7u, 0xd5u, 0x4bu, 0xfeu, 0xd3u,
+            0xc9u, 0x64u, 0x07u, 0x3au, 0x0eu, 0xe1u, 0x72u, 0xf3u, 0xdau, 0xa6u, 0x23u, 0x25u,
+            0xafu, 0x02u, 0x1au, 0x68u, 0xf7u, 0x07u, 0x51u, 0x1au,
+        },
+        {
+            0xe5u, 0x56u, 0x43u, 0x00u, 0xc3u, 0x60u, 0xacu, 0x72u, 0x90u, 0x86u, 0xe2u, 0xccu,
+            0x80u, 0x6eu, 0x82u, 0x8au, 0x84u, 0x87u, 0x7fu, 0x1eu, 0xb8u, 0xe5u, 0xd9u, 0x74u,
+            0xd8u, 0x73u, 0xe0u, 0x65u, 0x22u, 0x49u, 0x01u, 0x55u, 0x5fu, 0xb8u, 0x82u, 0x15u,
+            0x90u, 0xa3u, 0x3bu, 0xacu, 0xc6u, 0x1eu, 0x39u, 0x70u, 0x1cu, 0xf9u, 0xb4u, 0x6bu,
+            0xd2u, 0x5bu, 0xf5u, 0xf0u, 0x59u, 0x5bu, 0xbeu, 0x24u, 0x65u, 0x51u, 0x41u, 0x43u,
+            0x8eu, 0x7au, 0x10u, 0x0bu,
+        },
+    },
+    {
+        "ed25519 rfc8032 test 2",
+        { 0x72u },
+        1u,
+        {
+            0x3du, 0x40u, 0x17u, 0xc3u, 0xe8u, 0x43u, 0x89u, 0x5au, 0x92u, 0xb7u, 0x0au, 0xa7u,
+            0x4du, 0x1bu, 0x7eu, 0xbcu, 0x9cu, 0x98u, 0x2cu, 0xcfu, 0x2eu, 0xc4u, 0x96u, 0x8cu,
+            0xc0u, 0xcdu, 0x55u, 0xf1u, 0x2au, 0xf4u, 0x66u, 0x0cu,
+        },
+        {
+            0x92u, 0xa0u, 0x09u, 0xa9u, 0xf0u, 0xd4u, 0xcau, 0xb8u, 0x72u, 0x0eu, 0x82u, 0x0bu,
+            0x5fu, 0x64u, 0x25u, 0x40u, 0xa2u, 0xb2u, 0x7bu, 0x54u, 0x16u, 0x50u, 0x3fu, 0x8fu,
+            0xb3u, 0x76u, 0x22u, 0x23u, 0xebu, 0xdbu, 0x69u, 0xdau, 0x08u, 0x5au, 0xc1u, 0xe4u,
+            0x3eu, 0x15u, 0x99u, 0x6eu, 0x45u, 0x8fu, 0x36u, 0x13u, 0xd0u, 0xf1u, 0x1du, 0x8cu,
+            0x38u, 0x7bu, 0x2eu, 0xaeu, 0xb4u, 0x30u, 0x2au, 0xeeu, 0xb0u, 0x0du, 0x29u, 0x16u,
+            0x12u, 0xbbu, 0x0cu, 0x00u,
+        },
+    },
+    {
+        "ed25519 rfc8032 test 3",
+        { 0xafu, 0x82u },
+        2u,
+        {
+            0xfcu, 0x51u, 0xcdu, 0x8eu, 0x62u, 0x18u, 0xa1u, 0xa3u, 0x8du, 0xa4u, 0x7eu, 0xd0u,
+            0x02u, 0x30u, 0xf0u, 0x58u, 0x08u, 0x16u, 0xedu, 0x13u, 0xbau, 0x33u, 0x03u, 0xacu,
+            0x5du, 0xebu, 0x91u, 0x15u, 0x48u, 0x90u, 0x80u, 0x25u,
+        },
+        {
+            0x62u, 0x91u, 0xd6u, 0x57u, 0xdeu, 0xecu, 0x24u, 0x02u, 0x48u, 0x27u, 0xe6u, 0x9cu,
+            0x3au, 0xbeu, 0x01u, 0xa3u, 0x0cu, 0xe5u, 0x48u, 0xa2u, 0x84u, 0x74u, 0x3au, 0x44u,
+            0x5eu, 0x36u, 0x80u, 0xd7u, 0xdbu, 0x5au, 0xc3u, 0xacu, 0x18u, 0xffu, 0x9bu, 0x53u,
+            0x8du, 0x16u, 0xf2u, 0x90u, 0xaeu, 0x67u, 0xf7u, 0x60u, 0x98u, 0x4du, 0xc6u, 0x59u,
+            0x4au, 0x7cu, 0x15u, 0xe9u, 0x71u, 0x6eu, 0xd2u, 0x8du, 0xc0u, 0x27u, 0xbeu, 0xceu,
+            0xeau, 0x1eu, 0xc4u, 0x0au,
+        },
+    },
+};
+
+/* keys/cypress-test-ed25519.pem as imgtool embeds it, and its signature of
+ * the SHA-256 of "Edge Protect Bootloader", kat_p256_test_hash */
+static const uint8_t kat_ed25519_test_key[] = {
+    0x30u, 0x2au, 0x30u, 0x05u, 0x06u, 0x03u, 0x2bu, 0x65u, 0x70u, 0x03u, 0x21u, 0x00u,
+    0x74u, 0x63u, 0x0eu, 0x0cu, 0xabu, 0x8cu, 0xf4u, 0x90u, 0xbau, 0xf1u, 0x64u, 0x79u,
+    0x7cu, 0x92u, 0xefu, 0x3cu, 0x99u, 0x83u, 0x0cu, 0xcfu, 0xaau, 0x7eu, 0xdeu, 0xbeu,
+    0x9du, 0x83u, 0x0fu, 0xfau, 0xa8u, 0x43u, 0x72u, 0x2cu,
+};
+
+static const uint8_t kat_ed25519_test_sig[BOOT_CRYPTO_ED25519_SIG_SIZE] = {
+    0x92u, 0x9bu, 0x2du, 0x39u, 0x3eu, 0xaau, 0x75u, 0x89u, 0x3fu, 0x20u, 0xfbu, 0x9bu,
+    0x18u, 0x43u, 0x71u, 0xefu, 0x63u, 0xfeu, 0x61u, 0x85u, 0x3au, 0x4du, 0x99u, 0x3du,
+    0xc8u, 0x67u, 0x41u, 0xd4u, 0xa4u, 0xaeu, 0x8du, 0xa9u, 0xf0u, 0x76u, 0x78u, 0xd4u,
+    0x37u, 0x4eu, 0x6eu, 0x78u, 0x99u, 0xf2u, 0xdeu, 0xa2u, 0xcbu, 0x34u, 0xf8u, 0x6du,
+    0xf0u, 0x21u, 0xb7u, 0x74u, 0xdeu, 0x68u, 0x78u, 0x91u, 0x77u, 0xcdu, 0xd9u, 0x8cu,
+    0x3bu, 0xa4u, 0xd2u, 0x06u,
+};
+
+/* Key and plaintext of SP 800-38A F.5.1, encrypted from the zero counter
+ * block of the image encryption instead of its initial counter block */
+static const uint8_t kat_aes_ctr_key[BOOT_CRYPTO_AES_KEY_SIZE] = {
+    0x2bu, 0x7eu, 0x15u, 0x16u, 0x28u, 0xaeu, 0xd2u, 0xa6u, 0xabu, 0xf7u, 0x15u, 0x88u,
+    0x09u, 0xcfu, 0x4fu, 0x3cu,
+};
+
+static const uint8_t kat_aes_ctr_pt[KAT_CTR_LENGTH] = {
+    0x6bu, 0xc1u, 0xbeu, 0xe2u, 0x2eu, 0x40u, 0x9fu, 0x96u, 0xe9u, 0x3du, 0x7eu, 0x11u,
+    0x73u, 0x93u, 0x17u, 0x2au, 0xaeu, 0x2du, 0x8au, 0x57u, 0x1eu, 0x03u, 0xacu, 0x9cu,
+    0x9eu, 0xb7u, 0x6fu, 0xacu, 0x45u, 0xafu, 0x8eu, 0x51u, 0x30u, 0xc8u, 0x1cu, 0x46u,
+    0xa3u, 0x5cu, 0xe4u, 0x11u, 0xe5u, 0xfbu, 0xc1u, 0x19u, 0x1au, 0x0au, 0x52u, 0xefu,
+    0xf6u, 0x9fu, 0x24u, 0x45u, 0xdfu, 0x4fu, 0x9bu, 0x17u, 0xadu, 0x2bu, 0x41u, 0x7bu,
+    0xe6u, 0x6cu, 0x37u, 0x10u,
+};
+
+static const uint8_t kat_aes_ctr_ct[KAT_CTR_LENGTH] = {
+    0x16u, 0x36u, 0xd5u, 0xeeu, 0x34u, 0xf8u, 0x06u, 0x25u, 0xd7u, 0x7fu, 0x8eu, 0x56u,
+    0xcau, 0x88u, 0x43u, 0x45u, 0xf9u, 0x3fu, 0xf7u, 0x17u, 0x2au, 0xb2u, 0x12u, 0x23u,
+    0x30u, 0x43u, 0x09u, 0x15u, 0x82u, 0xddu, 0xe1u, 0x97u, 0xa7u, 0xf7u, 0x32u, 0xb5u,
+    0xebu, 0x25u, 0x06u, 0x13u, 0x9au, 0xecu, 0xf5u, 0x29u, 0x25u, 0xf8u, 0x4du, 0x66u,
+    0xb0u, 0x03u, 0x5bu, 0x8eu, 0xaau, 0x9au, 0x42u, 0xb6u, 0x19u, 0x33u, 0x8au, 0xe2u,
+    0x9du, 0x65u, 0x96u, 0x95u,
+};
+
+/* RFC 4231 test case 2 */
+static const uint8_t kat_hmac_rfc4231_mac[BOOT_CRYPTO_SHA256_SIZE] = {
+    0x5bu, 0xdcu, 0xc1u, 0x46u, 0xbfu, 0x60u, 0x75u, 0x4eu, 0x6au, 0x04u, 0x24u, 0x26u,
+    0x08u, 0x95u, 0x75u, 0xc7u, 0x5au, 0x00u, 0x3fu, 0x08u, 0x9du, 0x27u, 0x39u, 0x83u,
+    0x9du, 0xecu, 0x58u, 0xb9u, 0x64u, 0xecu, 0x38u, 0x43u,
+};
+
+/* RFC 5869 A.1, and A.3 without salt and info */
+static const uint8_t kat_hkdf_rfc5869_okm[2][KAT_HKDF_LENGTH] = {
+    {
+        0x3cu, 0xb2u, 0x5fu, 0x25u, 0xfau, 0xacu, 0xd5u, 0x7au, 0x90u, 0x43u, 0x4fu, 0x64u,
+        0xd0u, 0x36u, 0x2fu, 0x2au, 0x2du, 0x2du, 0x0au, 0x90u, 0xcfu, 0x1au, 0x5au, 0x4cu,
+        0x5du, 0xb0u, 0x2du, 0x56u, 0xecu, 0xc4u, 0xc5u, 0xbfu, 0x34u, 0x00u, 0x72u, 0x08u,
+        0xd5u, 0xb8u, 0x87u, 0x18u, 0x58u, 0x65u,
+    },
+    {
+        0x8du, 0xa4u, 0xe7u, 0x75u, 0xa5u, 0x63u, 0xc1u, 0x8fu, 0x71u, 0x5fu, 0x80u, 0x2au,
+        0x06u, 0x3cu, 0x5au, 0x31u, 0xb8u, 0xa1u, 0x1fu, 0x5cu, 0x5eu, 0xe1u, 0x87u, 0x9eu,
+        0xc3u, 0x45u, 0x4eu, 0x5fu, 0x3cu, 0x73u, 0x8du, 0x2du, 0x9du, 0x20u, 0x13u, 0x95u,
+        0xfau, 0xa4u, 0xb6u, 0x1au, 0x96u, 0xc8u,
+    },
+};
+
+/* keys/cypress-test-enc-p256.pem as imgtool getpriv embeds it, an
+ * ENC_EC256 TLV of imgtool for it, with the ECDH secret and the image key
+ * it holds, and the SP 800-38A plaintext encrypted as an image body with
+ * that key */
+static const uint8_t kat_enc_test_key[] = {
+    0x30u, 0x81u, 0x87u, 0x02u, 0x01u, 0x00u, 0x30u, 0x13u, 0x06u, 0x07u, 0x2au, 0x86u,
+    0x48u, 0xceu, 0x3du, 0x02u, 0x01u, 0x06u, 0x08u, 0x2au, 0x86u, 0x48u, 0xceu, 0x3du,
+    0x03u, 0x01u, 0x07u, 0x04u, 0x6du, 0x30u, 0x6bu, 0x02u, 0x01u, 0x01u, 0x04u, 0x20u,
+    0xf2u, 0xd4u, 0xd2u, 0x16u, 0x4cu, 0x53u, 0xeau, 0xc2u, 0xc7u, 0x5au, 0xfdu, 0xdcu,
+    0x80u, 0xf3u, 0x14u, 0xb5u, 0x5au, 0x33u, 0x47u, 0x0du, 0x03u, 0xe6u, 0xcdu, 0xf1u,
+    0xd1u, 0x2eu, 0xbfu, 0x37u, 0x32u, 0x91u, 0x8cu, 0xf0u, 0xa1u, 0x44u, 0x03u, 0x42u,
+    0x00u, 0x04u, 0xd6u, 0xffu, 0xb4u, 0x72u, 0x5bu, 0x94u, 0xe1u, 0x5au, 0x5bu, 0x62u,
+    0x2fu, 0xc0u, 0x4bu, 0xd2u, 0xefu, 0x0fu, 0x7bu, 0xafu, 0x66u, 0xc9u, 0xfdu, 0xb7u,
+    0xecu, 0x58u, 0x02u, 0x88u, 0x47u, 0xeeu, 0x8bu, 0xf6u, 0x74u, 0xd9u, 0x40u, 0x0du,
+    0xc5u, 0xcfu, 0xd3u, 0x57u, 0xdeu, 0x3fu, 0xe0u, 0x49u, 0xb9u, 0x2cu, 0xf0u, 0x24u,
+    0x6au, 0x36u, 0xddu, 0x63u, 0x5fu, 0x08u, 0x5bu, 0xd1u, 0xf4u, 0x17u, 0xafu, 0x5eu,
+    0xf0u, 0xbau, 0xc4u, 0x5cu, 0x33u, 0x54u,
+};
+
+static const uint8_t kat_enc_test_tlv[BOOT_CRYPTO_ECIES_SIZE] = {
+    0x04u, 0x5eu, 0xc4u, 0xb2u, 0x85u, 0x1du, 0xf7u, 0x3cu, 0xa0u, 0xc6u, 0x4cu, 0x15u,
+    0x14u, 0xa3u, 0x35u, 0x5au, 0xa9u, 0x65u, 0x1bu, 0xebu, 0xd6u, 0x20u, 0x90u, 0x78u,
+    0x72u, 0xacu, 0xc1u, 0xd0u, 0x08u, 0x0cu, 0x51u, 0x1eu, 0x5fu, 0xc1u, 0x4du, 0xbdu,
+    0x6cu, 0x54u, 0x70u, 0x6cu, 0x93u, 0x7du, 0xccu, 0x33u, 0x4du, 0xa4u, 0x32u, 0x87u,
+    0x1du, 0x7du, 0x6du, 0xe9u, 0x63u, 0x8bu, 0x5bu, 0xbdu, 0x9bu, 0x18u, 0x5bu, 0x4bu,
+    0xe6u, 0x6eu, 0x6au, 0xfdu, 0xeau, 0x82u, 0x52u, 0xbbu, 0x11u, 0x61u, 0xaau, 0x59u,
+    0x3au, 0xe4u, 0x92u, 0x47u, 0x39u, 0x0au, 0x16u, 0x3au, 0x8cu, 0x4fu, 0xa7u, 0x3au,
+    0x9fu, 0x4au, 0x00u, 0x1cu, 0x10u, 0x2bu, 0x36u, 0x84u, 0xe8u, 0x1bu, 0x40u, 0x97u,
+    0x87u, 0x57u, 0xaeu, 0x0eu, 0xfbu, 0x38u, 0xc5u, 0x86u, 0x2du, 0xc2u, 0x38u, 0x59u,
+    0x89u, 0xfbu, 0x1fu, 0xe4u, 0x92u,
+};
+
+static const uint8_t kat_enc_test_shared[BOOT_CRYPTO_P256_PRIV_SIZE] = {
+    0x3au, 0x16u, 0x91u, 0x03u, 0x05u, 0x2fu, 0x72u, 0x8fu, 0x98u, 0xfau, 0xb9u, 0xfdu,
+    0x38u, 0x4au, 0x31u, 0x75u, 0x93u, 0x78u, 0xe0u, 0x41u, 0x8cu, 0x90u, 0xb2u, 0xafu,
+    0x6au, 0xe0u, 0x44u, 0x50u, 0x16u, 0x33u, 0xa3u, 0xceu,
+};
+
+static const uint8_t kat_enc_test_aes_key[BOOT_CRYPTO_AES_KEY_SIZE] = {
+    0xe2u, 0x4au, 0x2bu, 0x83u, 0xf1u, 0x59u, 0x51u, 0x98u, 0x68u, 0xd9u, 0x0du, 0x06u,
+    0xf5u, 0xcau, 0x9fu, 0x3au,
+};
+
+static const uint8_t kat_enc_test_body[KAT_CTR_LENGTH] = {
+    0x6bu, 0xabu, 0x3eu, 0x79u, 0x2cu, 0x86u, 0xb1u, 0x59u, 0x61u, 0x33u, 0x13u, 0x60u,
+    0x70u, 0x2du, 0xd6u, 0x6eu, 0x42u, 0xbau, 0x39u, 0xd6u, 0x32u, 0xe8u, 0x77u, 0x49u,
+    0x5au, 0xf6u, 0x06u, 0x9fu, 0x6du, 0x09u, 0x30u, 0x50u, 0x32u, 0x76u, 0x47u, 0x78u,
+    0xe7u, 0xfcu, 0x10u, 0x9fu, 0x73u, 0x36u, 0x21u, 0x39u, 0xa2u, 0x7cu, 0x01u, 0x6fu,
+    0x77u, 0xf7u, 0x61u, 0x20u, 0xe8u, 0x53u, 0xebu, 0xc4u, 0xc0u, 0xe8u, 0xecu, 0xffu,
+    0xbfu, 0xf4u, 0x26u, 0x3au,
+};
+
+/*******************************************************************************
+ * Function Name: kat_check
+ ********************************************************************************
+ * Reports the result of a test.
+ *
+ * Return:
+ *  1 if the test failed, 0 otherwise.
+ *******************************************************************************/
+static uint32_t kat_check(boot_crypto_kat_report_t report, const char *name, bool passed) {
+    if (report != NULL) {
+        report(name, passed);
+    }
+    return passed ? 0u : 1u;
+}
+
+/*******************************************************************************
+ * Function Name: kat_sha256_split
+ ********************************************************************************
+ * Hashes a message in updates of 1 byte, then of 63 bytes, then the rest, to
+ * cover the partial blocks of the backend.
+ *******************************************************************************/
+static void kat_sha256_split(const char *message, uint8_t digest[BOOT_CRYPTO_SHA256_SIZE]) {
+    boot_crypto_sha256_t ctx;
+    uint32_t length = (uint32_t)strlen(message);
+    uint32_t off = 0u;
+    uint32_t chunk = 1u;
+
+    boot_crypto_sha256_init(&ctx);
+    while (off < length) {
+        uint32_t size = ((length - off) < chunk) ? (length - off) : chunk;
+
+        boot_crypto_sha256_update(&ctx, (const uint8_t *)&message[off], size);
+        off += size;
+        chunk = (chunk == 1u) ? 63u : length;
+    }
+    boot_crypto_sha256_final(&ctx, digest);
+}
+
+/*******************************************************************************
+ * Function Name: boot_crypto_kat_run
+ ********************************************************************************
+ * Runs the known-answer tests on the selected backend. Every valid signature
+ * is also checked with a flipped bit in the hash, in r and in s, with r and s
+ * out of range and with a key off the curve, the Ed25519 ones with a changed
+ * message, a flipped bit in R and in S, S + L and a non-canonical key. The
+ * encrypted image tests unwrap an imgtool key TLV and decrypt a body with
+ * it, then reject the TLV with a flipped bit in the tag, in the wrapped key
+ * and in the ephemeral point.
+ *
+ * Parameters:
+ *  report         Called with the result of every test, may be NULL.
+ *
+ * Return:
+ *  Number of failed tests.
+ *******************************************************************************/
+uint32_t boot_crypto_kat_run(boot_crypto_kat_report_t report) {
+    static const uint8_t n[BOOT_CRYPTO_P256_SIG_SIZE / 2u] = {
+        0xffu, 0xffu, 0xffu, 0xffu, 0x00u, 0x00u, 0x00u, 0x00u, 0xffu, 0xffu, 0xffu, 0xffu,
+        0xffu, 0xffu, 0xffu, 0xffu, 0xbcu, 0xe6u, 0xfau, 0xadu, 0xa7u, 0x17u, 0x9eu, 0x84u,
+        0xf3u, 0xb9u, 0xcau, 0xc2u, 0xfcu, 0x63u, 0x25u, 0x51u,
+    };
+    /* Order of the Ed25519 base point, little endian */
+    static const uint8_t l[BOOT_CRYPTO_ED25519_KEY_SIZE] = {
+        0xedu, 0xd3u, 0xf5u, 0x5cu, 0x1au, 0x63u, 0x12u, 0x58u, 0xd6u, 0x9cu, 0xf7u, 0xa2u,
+        0xdeu, 0xf9u, 0xdeu, 0x14u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+        0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x10u,
+    };
+    uint8_t digest[BOOT_CRYPTO_SHA256_SIZE];
+    uint8_t block[KAT_MILLION_CHUNK];
+    uint8_t hash[BOOT_CRYPTO_SHA256_SIZE];
+    uint8_t sig[BOOT_CRYPTO_P256_SIG_SIZE];
+    uint8_t pub[BOOT_CRYPTO_P256_KEY_SIZE];
+    uint8_t priv[BOOT_CRYPTO_P256_PRIV_SIZE];
+    uint8_t key[BOOT_CRYPTO_AES_KEY_SIZE];
+    uint8_t tlv[BOOT_CRYPTO_ECIES_SIZE];
+    uint8_t ikm[22];
+    uint8_t okm[KAT_HKDF_LENGTH];
+    uint8_t salt[13];
+    uint8_t info[10];
+    boot_crypto_sha256_t ctx;
+    boot_crypto_aes_t aes;
+    bool passed;
+    uint32_t failed = 0u;
+
+    for (uint32_t i = 0u; i < sizeof(kat_sha256) / sizeof(kat_sha256[0]); i++) {
+        const kat_sha256_t *kat = &kat_sha256[i];
+
+        boot_crypto_sha256_init(&ctx);
+        boot_crypto_sha256_update(&ctx, (const uint8_t *)kat->message, (uint32_t)strlen(kat->message));
+        boot_crypto_sha256_final(&ctx, digest);
+        failed += kat_check(report, kat->name, memcmp(digest, kat->digest, sizeof(digest)) == 0);
+    }
+    kat_sha256_split(kat_sha256[3].message, digest);
+    failed += kat_check(report, "sha256 split updates",
+                        memcmp(digest, kat_sha256[3].digest, sizeof(digest)) == 0);
+
+    memset(block, 'a', sizeof(block));
+    boot_crypto_sha256_init(&ctx);
+    for (uint32_t off = 0u; off < KAT_MILLION_LENGTH; off += KAT_MILLION_CHUNK) {
+        uint32_t size = ((KAT_MILLION_LENGTH - off) < KAT_MILLION_CHUNK) ? (KAT_MILLION_LENGTH - off) :
+                        KAT_MILLION_CHUNK;
+
+        boot_crypto_sha256_update(&ctx, block, size);
+    }
+    boot_crypto_sha256_final(&ctx, digest);
+    failed += kat_check(report, "sha256 million a",
+                        memcmp(digest, kat_sha256_million, sizeof(digest)) == 0);
+
+    for (uint32_t i = 0u; i < sizeof(kat_p256) / sizeof(kat_p256[0]); i++) {
+        const kat_p256_t *kat = &kat_p256[i];
+
+        failed += kat_check(report, kat->name,
+                            boot_crypto_p256_verify(kat_p256_rfc6979_pub, kat->hash, kat->sig));
+    }
+
+    failed += kat_check(report, "p256 test key der",
+                        boot_crypto_p256_verify_der(kat_p256_test_key, sizeof(kat_p256_test_key),
+                                                    kat_p256_test_hash, kat_p256_test_sig,
+                                                    sizeof(kat_p256_test_sig)));
+
+    /* Tampered copies of the first RFC 6979 vector */
+    memcpy(hash, kat_p256[0].hash, sizeof(hash));
+    hash[BOOT_CRYPTO_SHA256_SIZE - 1u] ^= 0x01u;
+    failed += kat_check(report, "p256 reject hash",
+                        !boot_crypto_p256_verify(kat_p256_rfc6979_pub, hash, kat_p256[0].sig));
+
+    memcpy(sig, kat_p256[0].sig, sizeof(sig));
+    sig[0] ^= 0x80u;
+    failed += kat_check(report, "p256 reject r",
+                        !boot_crypto_p256_verify(kat_p256_rfc6979_pub, kat_p256[0].hash, sig));
+
+    memcpy(sig, kat_p256[0].sig, sizeof(sig));
+    sig[BOOT_CRYPTO_P256_SIG_SIZE - 1u] ^= 0x01u;
+    failed += kat_check(report, "p256 reject s",
+                        !boot_crypto_p256_verify(kat_p256_rfc6979_pub, kat_p256[0].hash, sig));
+
+    memcpy(sig, kat_p256[0].sig, sizeof(sig));
+    memset(&sig[BOOT_CRYPTO_P256_SIG_SIZE / 2u], 0, BOOT_CRYPTO_P256_SIG_SIZE / 2u);
+    failed += kat_check(report, "p256 reject s zero",
+                        !boot_crypto_p256_verify(kat_p256_rfc6979_pub, kat_p256[0].hash, sig));
+
+    memcpy(sig, kat_p256[0].sig, sizeof(sig));
+    memcpy(sig, n, sizeof(n));
+    failed += kat_check(report, "p256 reject r n",
+                        !boot_crypto_p256_verify(kat_p256_rfc6979_pub, kat_p256[0].hash, sig));
+
+    memcpy(pub, kat_p256_rfc6979_pub, sizeof(pub));
+    pub[BOOT_CRYPTO_P256_KEY_SIZE - 1u] ^= 0x01u;
+    failed += kat_check(report, "p256 reject key off curve",
+                        !boot_crypto_p256_verify(pub, kat_p256[0].hash, kat_p256[0].sig));
+
+    failed += kat_check(report, "p256 reject der",
+                        !boot_crypto_p256_verify_der(kat_p256_test_key, sizeof(kat_p256_test_key),
+                                                     kat_p256[0].hash, kat_p256_test_sig,
+                                                     sizeof(kat_p256_test_sig)));
+
+    for (uint32_t i = 0u; i < sizeof(kat_ed25519) / sizeof(kat_ed25519[0]); i++) {
+        const kat_ed25519_t *kat = &kat_ed25519[i];
+
+        failed += kat_check(report, kat->name,
+                            boot_crypto_ed25519_verify(kat->pub, kat->message, kat->message_len, kat->sig));
+    }
+    failed += kat_check(report, "ed25519 test key der",
+                        boot_crypto_ed25519_verify_der(kat_ed25519_test_key, sizeof(kat_ed25519_test_key),
+                                                       kat_p256_test_hash, kat_ed25519_test_sig,
+                                                       sizeof(kat_ed25519_test_sig)));
+
+    failed += kat_check(report, "ed25519 reject message",
+                        !boot_crypto_ed25519_verify(kat_ed25519[1].pub, (const uint8_t *)"s", 1u,
+                                                    kat_ed25519[1].sig));
+    memcpy(sig, kat_ed25519[1].sig, sizeof(sig));
+    sig[0] ^= 0x01u;
+    failed += kat_check(report, "ed25519 reject r",
+                        !boot_crypto_ed25519_verify(kat_ed25519[1].pub, kat_ed25519[1].message, 1u, sig));
+    memcpy(sig, kat_ed25519[1].sig, sizeof(sig));
+    sig[BOOT_CRYPTO_ED25519_KEY_SIZE] ^= 0x01u;
+    failed += kat_check(report, "ed25519 reject s",
+                        !boot_crypto_ed25519_verify(kat_ed25519[1].pub, kat_ed25519[1].message, 1u, sig));
+    /* S + L verifies the same equation but is not canonical */
+    memcpy(sig, kat_ed25519[1].sig, sizeof(sig));
+    for (uint32_t i = 0u, carry = 0u; i < BOOT_CRYPTO_ED25519_KEY_SIZE; i++) {
+        carry += (uint32_t)sig[BOOT_CRYPTO_ED25519_KEY_SIZE + i] + l[i];
+        sig[BOOT_CRYPTO_ED25519_KEY_SIZE + i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+    failed += kat_check(report, "ed25519 reject s l",
+                        !boot_crypto_ed25519_verify(kat_ed25519[1].pub, kat_ed25519[1].message, 1u, sig));
+    /* y = p */
+    memset(pub, 0xff, BOOT_CRYPTO_ED25519_KEY_SIZE);
+    pub[0] = 0xedu;
+    pub[BOOT_CRYPTO_ED25519_KEY_SIZE - 1u] = 0x7fu;
+    failed += kat_check(report, "ed25519 reject key",
+                        !boot_crypto_ed25519_verify(pub, kat_ed25519[1].message, 1u, kat_ed25519[1].sig));
+    failed += kat_check(report, "ed25519 reject der",
+                        !boot_crypto_ed25519_verify_der(kat_ed25519_test_key, sizeof(kat_ed25519_test_key),
+                                                        kat_p256[0].hash, kat_ed25519_test_sig,
+                                                        sizeof(kat_ed25519_test_sig)));
+
+    /* The image key is used from any offset in the body: whole, and cut at
+     * offsets within a block and across blocks */
+    boot_crypto_aes_init(&aes, kat_aes_ctr_key);
+    boot_crypto_aes_ctr(&aes, 0u, kat_aes_ctr_pt, block, KAT_CTR_LENGTH);
+    failed += kat_check(report, "aes ctr", memcmp(block, kat_aes_ctr_ct, KAT_CTR_LENGTH) == 0);
+    boot_crypto_aes_ctr(&aes, 0u, kat_aes_ctr_pt, block, 7u);
+    boot_crypto_aes_ctr(&aes, 7u, &kat_aes_ctr_pt[7], &block[7], 30u);
+    boot_crypto_aes_ctr(&aes, 37u, &kat_aes_ctr_pt[37], &block[37], KAT_CTR_LENGTH - 37u);
+    failed += kat_check(report, "aes ctr split", memcmp(block, kat_aes_ctr_ct, KAT_CTR_LENGTH) == 0);
+    boot_crypto_aes_ctr(&aes, 16u, &kat_aes_ctr_ct[16], block, 16u);
+    failed += kat_check(report, "aes ctr offset", memcmp(block, &kat_aes_ctr_pt[16], 16u) == 0);
+    boot_crypto_aes_free(&aes);
+
+    boot_crypto_hmac_sha256((const uint8_t *)"Jefe", 4u, (const uint8_t *)"what do ya want for nothing?",
+                            28u, digest);
+    failed += kat_check(report, "hmac sha256 rfc4231 2",
+                        memcmp(digest, kat_hmac_rfc4231_mac, sizeof(digest)) == 0);
+
+    memset(ikm, 0x0b, sizeof(ikm));
+    for (uint32_t i = 0u; i < sizeof(salt); i++) {
+        salt[i] = (uint8_t)i;
+    }
+    for (uint32_t i = 0u; i < sizeof(info); i++) {
+        info[i] = (uint8_t)(0xf0u + i);
+    }
+    failed += kat_check(report, "hkdf sha256 rfc5869 1",
+                        boot_crypto_hkdf_sha256(ikm, sizeof(ikm), salt, sizeof(salt), info, sizeof(info),
+                                                okm, KAT_HKDF_LENGTH) &&
+                        (memcmp(okm, kat_hkdf_rfc5869_okm[0], KAT_HKDF_LENGTH) == 0));
+    failed += kat_check(report, "hkdf sha256 rfc5869 3",
+                        boot_crypto_hkdf_sha256(ikm, sizeof(ikm), NULL, 0u, NULL, 0u, okm, KAT_HKDF_LENGTH) &&
+                        (memcmp(okm, kat_hkdf_rfc5869_okm[1], KAT_HKDF_LENGTH) == 0));
+
+    passed = boot_crypto_p256_priv_der(kat_enc_test_key, sizeof(kat_enc_test_key), priv);
+    failed += kat_check(report, "p256 test enc key der", passed);
+    failed += kat_check(report, "p256 ecdh",
+                        passed && boot_crypto_p256_ecdh(priv, &kat_enc_test_tlv[BOOT_CRYPTO_ECIES_PUB_OFF + 1u],
+                                                        digest) &&
+                        (memcmp(digest, kat_enc_test_shared, sizeof(digest)) == 0));
+    passed = passed && boot_crypto_ecies_p256_unwrap(priv, kat_enc_test_tlv, key) &&
+             (memcmp(key, kat_enc_test_aes_key, sizeof(key)) == 0);
+    failed += kat_check(report, "ecies p256 unwrap", passed);
+    if (passed) {
+        boot_crypto_aes_init(&aes, key);
+        boot_crypto_aes_ctr(&aes, 0u, kat_enc_test_body, block, KAT_CTR_LENGTH);
+        boot_crypto_aes_free(&aes);
+    }
+    failed += kat_check(report, "ecies p256 body",
+                        passed && (memcmp(block, kat_aes_ctr_pt, KAT_CTR_LENGTH) == 0));
+
+    memcpy(tlv, kat_enc_test_tlv, sizeof(tlv));
+    tlv[BOOT_CRYPTO_ECIES_TAG_OFF] ^= 0x01u;
+    failed += kat_check(report, "ecies p256 reject tag", !boot_crypto_ecies_p256_unwrap(priv, tlv, key));
+    memcpy(tlv, kat_enc_test_tlv, sizeof(tlv));
+    tlv[BOOT_CRYPTO_ECIES_KEY_OFF] ^= 0x01u;
+    failed += kat_check(report, "ecies p256 reject key", !boot_crypto_ecies_p256_unwrap(priv, tlv, key));
+    memcpy(tlv, kat_enc_test_tlv, sizeof(tlv));
+    tlv[BOOT_CRYPTO_ECIES_TAG_OFF - 1u] ^= 0x01u;
+    failed += kat_check(report, "ecies p256 reject point", !boot_crypto_ecies_p256_unwrap(priv, tlv, key));
+
+    return failed;
+}
+
+/* [] END OF FILE */
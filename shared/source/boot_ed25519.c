@@ -0,0 +1,682 @@
+/******************************************************************************
+ * File Name:   boot_ed25519.c
+ *
+ * Description: This file contains the Ed25519 signature verification of the crypto backend (RFC
+ *              8032), with its SHA-512, in 32-bit arithmetic modulo 2^255 - 19 and extended twisted
+ *              Edwards coordinates. It handles public data only and is not constant time.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "boot_ed25519.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* 32-bit words of a field element or a scalar, least significant first */
+#define ED_WORDS                    (8u)
+
+#define ED_SHA512_BLOCK_SIZE        (128u)
+#define ED_SHA512_SIZE              (64u)
+
+#define ED_ROTR64(x, n)             (((x) >> (n)) | ((x) << (64u - (n))))
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* Field element below 2^256, reduced modulo p = 2^255 - 19 only to compare
+ * and encode */
+typedef uint32_t ed_fe_t[ED_WORDS];
+
+/* Extended coordinates: x = X / Z, y = Y / Z, x * y = T / Z */
+typedef struct {
+    ed_fe_t x;
+    ed_fe_t y;
+    ed_fe_t z;
+    ed_fe_t t;
+} ed_point_t;
+
+typedef struct {
+    uint64_t state[8];
+    uint64_t length;
+    uint8_t block[ED_SHA512_BLOCK_SIZE];
+    uint32_t used;
+} ed_sha512_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const ed_fe_t ed_p = {
+    0xffffffedu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0x7fffffffu,
+};
+static const ed_fe_t ed_d = {
+    0x135978a3u, 0x75eb4dcau, 0x4141d8abu, 0x00700a4du, 0x7779e898u, 0x8cc74079u, 0x2b6ffe73u, 0x52036ceeu,
+};
+static const ed_fe_t ed_d2 = {
+    0x26b2f159u, 0xebd69b94u, 0x8283b156u, 0x00e0149au, 0xeef3d130u, 0x198e80f2u, 0x56dffce7u, 0x2406d9dcu,
+};
+/* sqrt(-1) = 2^((p - 1) / 4) */
+static const ed_fe_t ed_sqrtm1 = {
+    0x4a0ea0b0u, 0xc4ee1b27u, 0xad2fe478u, 0x2f431806u, 0x3dfbd7a7u, 0x2b4d0099u, 0x4fc1df0bu, 0x2b832480u,
+};
+static const ed_fe_t ed_bx = {
+    0x8f25d51au, 0xc9562d60u, 0x9525a7b2u, 0x692cc760u, 0xfdd6dc5cu, 0xc0a4e231u, 0xcd6e53feu, 0x216936d3u,
+};
+static const ed_fe_t ed_by = {
+    0x66666658u, 0x66666666u, 0x66666666u, 0x66666666u, 0x66666666u, 0x66666666u, 0x66666666u, 0x66666666u,
+};
+/* Order of the base point */
+static const ed_fe_t ed_l = {
+    0x5cf5d3edu, 0x5812631au, 0xa2f79cd6u, 0x14def9deu, 0x00000000u, 0x00000000u, 0x00000000u, 0x10000000u,
+};
+/* L again, bytes least significant first, for the reduction of the hash */
+static const uint8_t ed_l_bytes[32] = {
+    0xedu, 0xd3u, 0xf5u, 0x5cu, 0x1au, 0x63u, 0x12u, 0x58u, 0xd6u, 0x9cu, 0xf7u, 0xa2u, 0xdeu, 0xf9u, 0xdeu, 0x14u,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x10u,
+};
+/* Exponents of the inversion, p - 2, and of the square root, (p - 5) / 8 */
+static const ed_fe_t ed_p_minus_2 = {
+    0xffffffebu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0x7fffffffu,
+};
+static const ed_fe_t ed_p_minus_5_div_8 = {
+    0xfffffffdu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0x0fffffffu,
+};
+
+static const uint64_t ed_sha512_k[80] = {
+    0x428a2f98d728ae22ull, 0x7137449123ef65cdull, 0xb5c0fbcfec4d3b2full, 0xe9b5dba58189dbbcull,
+    0x3956c25bf348b538ull, 0x59f111f1b605d019ull, 0x923f82a4af194f9bull, 0xab1c5ed5da6d8118ull,
+    0xd807aa98a3030242ull, 0x12835b0145706fbeull, 0x243185be4ee4b28cull, 0x550c7dc3d5ffb4e2ull,
+    0x72be5d74f27b896full, 0x80deb1fe3b1696b1ull, 0x9bdc06a725c71235ull, 0xc19bf174cf692694ull,
+    0xe49b69c19ef14ad2ull, 0xefbe4786384f25e3ull, 0x0fc19dc68b8cd5b5ull, 0x240ca1cc77ac9c65ull,
+    0x2de92c6f592b0275ull, 0x4a7484aa6ea6e483ull, 0x5cb0a9dcbd41fbd4ull, 0x76f988da831153b5ull,
+    0x983e5152ee66dfabull, 0xa831c66d2db43210ull, 0xb00327c898fb213full, 0xbf597fc7beef0ee4ull,
+    0xc6e00bf33da88fc2ull, 0xd5a79147930aa725ull, 0x06ca6351e003826full, 0x142929670a0e6e70ull,
+    0x27b70a8546d22ffcull, 0x2e1b21385c26c926ull, 0x4d2c6dfc5ac42aedull, 0x53380d139d95b3dfull,
+    0x650a73548baf63deull, 0x766a0abb3c77b2a8ull, 0x81c2c92e47edaee6ull, 0x92722c851482353bull,
+    0xa2bfe8a14cf10364ull, 0xa81a664bbc423001ull, 0xc24b8b70d0f89791ull, 0xc76c51a30654be30ull,
+    0xd192e819d6ef5218ull, 0xd69906245565a910ull, 0xf40e35855771202aull, 0x106aa07032bbd1b8ull,
+    0x19a4c116b8d2d0c8ull, 0x1e376c085141ab53ull, 0x2748774cdf8eeb99ull, 0x34b0bcb5e19b48a8ull,
+    0x391c0cb3c5c95a63ull, 0x4ed8aa4ae3418acbull, 0x5b9cca4f7763e373ull, 0x682e6ff3d6b2b8a3ull,
+    0x748f82ee5defb2fcull, 0x78a5636f43172f60ull, 0x84c87814a1f0ab72ull, 0x8cc702081a6439ecull,
+    0x90befffa23631e28ull, 0xa4506cebde82bde9ull, 0xbef9a3f7b2c67915ull, 0xc67178f2e372532bull,
+    0xca273eceea26619cull, 0xd186b8c721c0c207ull, 0xeada7dd6cde0eb1eull, 0xf57d4f7fee6ed178ull,
+    0x06f067aa72176fbaull, 0x0a637dc5a2c898a6ull, 0x113f9804bef90daeull, 0x1b710b35131c471bull,
+    0x28db77f523047d84ull, 0x32caab7b40c72493ull, 0x3c9ebe0a15c9bebcull, 0x431d67c49c100d4cull,
+    0x4cc5d4becb3e42b6ull, 0x597f299cfc657e2aull, 0x5fcb6fab3ad6faecull, 0x6c44198c4a475817ull,
+};
+
+/*******************************************************************************
+ * Function Name: ed_sha512_compress
+ ********************************************************************************
+ * Processes one 128-byte block.
+ *******************************************************************************/
+static void ed_sha512_compress(ed_sha512_t *ctx, const uint8_t *block) {
+    uint64_t w[80];
+    uint64_t s[8];
+
+    for (uint32_t i = 0u; i < 16u; i++) {
+        w[i] = 0u;
+        for (uint32_t j = 0u; j < 8u; j++) {
+            w[i] = (w[i] << 8) | block[8u * i + j];
+        }
+    }
+    for (uint32_t i = 16u; i < 80u; i++) {
+        uint64_t s0 = ED_ROTR64(w[i - 15u], 1u) ^ ED_ROTR64(w[i - 15u], 8u) ^ (w[i - 15u] >> 7);
+        uint64_t s1 = ED_ROTR64(w[i - 2u], 19u) ^ ED_ROTR64(w[i - 2u], 61u) ^ (w[i - 2u] >> 6);
+
+        w[i] = w[i - 16u] + s0 + w[i - 7u] + s1;
+    }
+
+    memcpy(s, ctx->state, sizeof(s));
+    for (uint32_t i = 0u; i < 80u; i++) {
+        uint64_t t1 = s[7] + (ED_ROTR64(s[4], 14u) ^ ED_ROTR64(s[4], 18u) ^ ED_ROTR64(s[4], 41u)) +
+                      ((s[4] & s[5]) ^ (~s[4] & s[6])) + ed_sha512_k[i] + w[i];
+        uint64_t t2 = (ED_ROTR64(s[0], 28u) ^ ED_ROTR64(s[0], 34u) ^ ED_ROTR64(s[0], 39u)) +
+                      ((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+
+        s[7] = s[6];
+        s[6] = s[5];
+        s[5] = s[4];
+        s[4] = s[3] + t1;
+        s[3] = s[2];
+        s[2] = s[1];
+        s[1] = s[0];
+        s[0] = t1 + t2;
+    }
+    for (uint32_t i = 0u; i < 8u; i++) {
+        ctx->state[i] += s[i];
+    }
+}
+
+/*******************************************************************************
+ * Function Name: ed_sha512_init
+ *******************************************************************************/
+static void ed_sha512_init(ed_sha512_t *ctx) {
+    static const uint64_t iv[8] = {
+        0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull, 0xa54ff53a5f1d36f1ull,
+        0x510e527fade682d1ull, 0x9b05688c2b3e6c1full, 0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull,
+    };
+
+    memcpy(ctx->state, iv, sizeof(iv));
+    ctx->length = 0u;
+    ctx->used = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: ed_sha512_update
+ *******************************************************************************/
+static void ed_sha512_update(ed_sha512_t *ctx, const uint8_t *data, uint32_t length) {
+    ctx->length += length;
+    while (length > 0u) {
+        uint32_t chunk = ED_SHA512_BLOCK_SIZE - ctx->used;
+
+        if (chunk > length) {
+            chunk = length;
+        }
+        memcpy(&ctx->block[ctx->used], data, chunk);
+        ctx->used += chunk;
+        data += chunk;
+        length -= chunk;
+        if (ctx->used == ED_SHA512_BLOCK_SIZE) {
+            ed_sha512_compress(ctx, ctx->block);
+            ctx->used = 0u;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: ed_sha512_final
+ *******************************************************************************/
+static void ed_sha512_final(ed_sha512_t *ctx, uint8_t digest[ED_SHA512_SIZE]) {
+    uint64_t bits = ctx->length << 3;
+
+    ctx->block[ctx->used++] = 0x80u;
+    if (ctx->used > ED_SHA512_BLOCK_SIZE - 16u) {
+        memset(&ctx->block[ctx->used], 0, ED_SHA512_BLOCK_SIZE - ctx->used);
+        ed_sha512_compress(ctx, ctx->block);
+        ctx->used = 0u;
+    }
+    /* The length is below 2^61 bytes, the upper 64 bits of the 128-bit
+     * length are 0 */
+    memset(&ctx->block[ctx->used], 0, ED_SHA512_BLOCK_SIZE - ctx->used);
+    for (uint32_t i = 0u; i < 8u; i++) {
+        ctx->block[ED_SHA512_BLOCK_SIZE - 1u - i] = (uint8_t)(bits >> (8u * i));
+    }
+    ed_sha512_compress(ctx, ctx->block);
+
+    for (uint32_t i = 0u; i < ED_SHA512_SIZE; i++) {
+        digest[i] = (uint8_t)(ctx->state[i / 8u] >> (56u - 8u * (i % 8u)));
+    }
+}
+
+/*******************************************************************************
+ * Function Name: ed_from_bytes
+ ********************************************************************************
+ * Reads a little endian number of 32 bytes.
+ *******************************************************************************/
+static void ed_from_bytes(ed_fe_t r, const uint8_t *bytes) {
+    for (uint32_t i = 0u; i < ED_WORDS; i++) {
+        const uint8_t *p = &bytes[4u * i];
+
+        r[i] = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: ed_cmp
+ ********************************************************************************
+ * Return:
+ *  -1, 0 or 1 as a is less than, equal to or greater than b.
+ *******************************************************************************/
+static int ed_cmp(const ed_fe_t a, const ed_fe_t b) {
+    for (uint32_t i = ED_WORDS; i-- > 0u;) {
+        if (a[i] != b[i]) {
+            return (a[i] < b[i]) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: ed_fold
+ ********************************************************************************
+ * Adds carry * 2^256 = carry * 38 mod p back into r.
+ *******************************************************************************/
+static void ed_fold(ed_fe_t r, uint32_t carry) {
+    while (carry != 0u) {
+        uint64_t c = (uint64_t)carry * 38u;
+
+        for (uint32_t i = 0u; i < ED_WORDS; i++) {
+            c += r[i];
+            r[i] = (uint32_t)c;
+            c >>= 32;
+        }
+        carry = (uint32_t)c;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: ed_add
+ ********************************************************************************
+ * r = a + b mod p.
+ *******************************************************************************/
+static void ed_add(ed_fe_t r, const ed_fe_t a, const ed_fe_t b) {
+    uint64_t c = 0u;
+
+    for (uint32_t i = 0u; i < ED_WORDS; i++) {
+        c += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    ed_fold(r, (uint32_t)c);
+}
+
+/*******************************************************************************
+ * Function Name: ed_sub
+ ********************************************************************************
+ * r = a - b mod p. Each borrow adds 2^256 = 38 mod p, taken away again.
+ *******************************************************************************/
+static void ed_sub(ed_fe_t r, const ed_fe_t a, const ed_fe_t b) {
+    int64_t c = 0;
+
+    for (uint32_t i = 0u; i < ED_WORDS; i++) {
+        c += (int64_t)a[i] - b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    while (c != 0) {
+        c = -38;
+        for (uint32_t i = 0u; i < ED_WORDS; i++) {
+            c += r[i];
+            r[i] = (uint32_t)c;
+            c >>= 32;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: ed_mul
+ ********************************************************************************
+ * r = a * b mod p: the 512-bit product, its upper half folded in times 38.
+ *******************************************************************************/
+static void ed_mul(ed_fe_t r, const ed_fe_t a, const ed_fe_t b) {
+    uint32_t t[2u * ED_WORDS] = { 0u };
+    uint64_t c;
+
+    for (uint32_t i = 0u; i < ED_WORDS; i++) {
+        c = 0u;
+        for (uint32_t j = 0u; j < ED_WORDS; j++) {
+            c += (uint64_t)t[i + j] + (uint64_t)a[i] * b[j];
+            t[i + j] = (uint32_t)c;
+            c >>= 32;
+        }
+        t[i + ED_WORDS] = (uint32_t)c;
+    }
+
+    c = 0u;
+    for (uint32_t i = 0u; i < ED_WORDS; i++) {
+        c += (uint64_t)t[i] + (uint64_t)t[i + ED_WORDS] * 38u;
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    ed_fold(r, (uint32_t)c);
+}
+
+/*******************************************************************************
+ * Function Name: ed_pow
+ ********************************************************************************
+ * r = a^e mod p.
+ *******************************************************************************/
+static void ed_pow(ed_fe_t r, const ed_fe_t a, const ed_fe_t e) {
+    ed_fe_t x = { 1u };
+
+    for (uint32_t i = 256u; i-- > 0u;) {
+        ed_mul(x, x, x);
+        if (((e[i / 32u] >> (i % 32u)) & 1u) != 0u) {
+            ed_mul(x, x, a);
+        }
+    }
+    memcpy(r, x, sizeof(ed_fe_t));
+}
+
+/*******************************************************************************
+ * Function Name: ed_reduce
+ ********************************************************************************
+ * r = a mod p, the canonical value below p.
+ *******************************************************************************/
+static void ed_reduce(ed_fe_t r, const ed_fe_t a) {
+    memcpy(r, a, sizeof(ed_fe_t));
+    /* a < 2^256 < 3 * p */
+    while (ed_cmp(r, ed_p) >= 0) {
+        int64_t c = 0;
+
+        for (uint32_t i = 0u; i < ED_WORDS; i++) {
+            c += (int64_t)r[i] - ed_p[i];
+            r[i] = (uint32_t)c;
+            c >>= 32;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: ed_equal
+ ********************************************************************************
+ * Return:
+ *  true if a = b mod p.
+ *******************************************************************************/
+static bool ed_equal(const ed_fe_t a, const ed_fe_t b) {
+    ed_fe_t ra;
+    ed_fe_t rb;
+
+    ed_reduce(ra, a);
+    ed_reduce(rb, b);
+    return ed_cmp(ra, rb) == 0;
+}
+
+/*******************************************************************************
+ * Function Name: ed_point_add
+ ********************************************************************************
+ * r = a + b, with the complete addition formulas for a = -1, which also
+ * double and add the neutral point.
+ *******************************************************************************/
+static void ed_point_add(ed_point_t *r, const ed_point_t *a, const ed_point_t *b) {
+    ed_fe_t ta;
+    ed_fe_t tb;
+    ed_fe_t tc;
+    ed_fe_t td;
+    ed_fe_t t0;
+    ed_fe_t t1;
+
+    /* A = (Y1 - X1) * (Y2 - X2), B = (Y1 + X1) * (Y2 + X2) */
+    ed_sub(t0, a->y, a->x);
+    ed_sub(t1, b->y, b->x);
+    ed_mul(ta, t0, t1);
+    ed_add(t0, a->y, a->x);
+    ed_add(t1, b->y, b->x);
+    ed_mul(tb, t0, t1);
+
+    /* C = 2 * d * T1 * T2, D = 2 * Z1 * Z2 */
+    ed_mul(tc, a->t, b->t);
+    ed_mul(tc, tc, ed_d2);
+    ed_mul(td, a->z, b->z);
+    ed_add(td, td, td);
+
+    /* E = B - A, F = D - C, G = D + C, H = B + A */
+    ed_sub(t0, tb, ta);
+    ed_sub(t1, td, tc);
+    ed_add(td, td, tc);
+    ed_add(tb, tb, ta);
+
+    ed_mul(r->x, t0, t1);
+    ed_mul(r->y, td, tb);
+    ed_mul(r->t, t0, tb);
+    ed_mul(r->z, t1, td);
+}
+
+/*******************************************************************************
+ * Function Name: ed_point_double
+ ********************************************************************************
+ * r = 2 * a, with the dedicated doubling formulas for a = -1.
+ *******************************************************************************/
+static void ed_point_double(ed_point_t *r, const ed_point_t *a) {
+    ed_fe_t ta;
+    ed_fe_t tb;
+    ed_fe_t tc;
+    ed_fe_t te;
+    ed_fe_t tg;
+    ed_fe_t th;
+
+    /* A = X1^2, B = Y1^2, C = 2 * Z1^2 */
+    ed_mul(ta, a->x, a->x);
+    ed_mul(tb, a->y, a->y);
+    ed_mul(tc, a->z, a->z);
+    ed_add(tc, tc, tc);
+
+    /* E = (X1 + Y1)^2 - A - B, G = B - A, F = G - C, H = -A - B */
+    ed_add(te, a->x, a->y);
+    ed_mul(te, te, te);
+    ed_sub(te, te, ta);
+    ed_sub(te, te, tb);
+    ed_sub(tg, tb, ta);
+    ed_sub(tc, tg, tc);
+    ed_add(th, ta, tb);
+    memset(ta, 0, sizeof(ta));
+    ed_sub(th, ta, th);
+
+    ed_mul(r->x, te, tc);
+    ed_mul(r->y, tg, th);
+    ed_mul(r->t, te, th);
+    ed_mul(r->z, tc, tg);
+}
+
+/*******************************************************************************
+ * Function Name: ed_point_decode
+ ********************************************************************************
+ * Decodes a point: y, and the sign of x in the top bit. x is recovered from
+ * x^2 = (y^2 - 1) / (d * y^2 + 1).
+ *
+ * Return:
+ *  true if the encoding is canonical and the point is on the curve.
+ *******************************************************************************/
+static bool ed_point_decode(ed_point_t *r, const uint8_t bytes[BOOT_ED25519_KEY_SIZE]) {
+    ed_fe_t one = { 1u };
+    ed_fe_t u;
+    ed_fe_t v;
+    ed_fe_t v3;
+    ed_fe_t t0;
+    ed_fe_t x;
+    uint32_t sign;
+
+    ed_from_bytes(r->y, bytes);
+    sign = r->y[ED_WORDS - 1u] >> 31;
+    r->y[ED_WORDS - 1u] &= 0x7fffffffu;
+    if (ed_cmp(r->y, ed_p) >= 0) {
+        return false;
+    }
+
+    /* u = y^2 - 1, v = d * y^2 + 1 */
+    ed_mul(t0, r->y, r->y);
+    ed_sub(u, t0, one);
+    ed_mul(v, t0, ed_d);
+    ed_add(v, v, one);
+
+    /* x = u * v^3 * (u * v^7)^((p - 5) / 8) */
+    ed_mul(v3, v, v);
+    ed_mul(v3, v3, v);
+    ed_mul(t0, v3, v3);
+    ed_mul(t0, t0, v);
+    ed_mul(t0, t0, u);
+    ed_pow(t0, t0, ed_p_minus_5_div_8);
+    ed_mul(t0, t0, v3);
+    ed_mul(x, t0, u);
+
+    /* v * x^2 is u, or -u when x needs a factor sqrt(-1) */
+    ed_mul(t0, x, x);
+    ed_mul(t0, t0, v);
+    if (!ed_equal(t0, u)) {
+        ed_add(t0, t0, u);
+        memset(v, 0, sizeof(v));
+        if (!ed_equal(t0, v)) {
+            return false;
+        }
+        ed_mul(x, x, ed_sqrtm1);
+    }
+
+    ed_reduce(r->x, x);
+    if ((r->x[0] & 1u) != sign) {
+        memset(v, 0, sizeof(v));
+        if (ed_equal(r->x, v)) {
+            return false;
+        }
+        ed_sub(r->x, ed_p, r->x);
+    }
+    memcpy(r->z, one, sizeof(ed_fe_t));
+    ed_mul(r->t, r->x, r->y);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: ed_point_encode
+ ********************************************************************************
+ * Encodes a point: y = Y / Z, and the sign of x = X / Z in the top bit.
+ *******************************************************************************/
+static void ed_point_encode(uint8_t bytes[BOOT_ED25519_KEY_SIZE], const ed_point_t *a) {
+    ed_fe_t zinv;
+    ed_fe_t x;
+    ed_fe_t y;
+
+    ed_pow(zinv, a->z, ed_p_minus_2);
+    ed_mul(x, a->x, zinv);
+    ed_mul(y, a->y, zinv);
+    ed_reduce(x, x);
+    ed_reduce(y, y);
+    y[ED_WORDS - 1u] |= (x[0] & 1u) << 31;
+    for (uint32_t i = 0u; i < BOOT_ED25519_KEY_SIZE; i++) {
+        bytes[i] = (uint8_t)(y[i / 4u] >> (8u * (i % 4u)));
+    }
+}
+
+/*******************************************************************************
+ * Function Name: ed_reduce_scalar
+ ********************************************************************************
+ * r = h mod L for the 64-byte little endian hash h, one byte at a time from
+ * the top: 2^252 = -(L - 2^252) mod L.
+ *******************************************************************************/
+static void ed_reduce_scalar(ed_fe_t r, const uint8_t h[ED_SHA512_SIZE]) {
+    int64_t x[ED_SHA512_SIZE];
+    uint8_t bytes[BOOT_ED25519_KEY_SIZE];
+    int64_t carry;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0u; i < ED_SHA512_SIZE; i++) {
+        x[i] = h[i];
+    }
+    for (i = ED_SHA512_SIZE - 1u; i >= 32u; i--) {
+        carry = 0;
+        for (j = i - 32u; j < i - 12u; j++) {
+            x[j] += carry - 16 * x[i] * ed_l_bytes[j - (i - 32u)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+    carry = 0;
+    for (j = 0u; j < 32u; j++) {
+        x[j] += carry - (x[31] >> 4) * ed_l_bytes[j];
+        carry = x[j] >> 8;
+        x[j] &= 0xff;
+    }
+    for (j = 0u; j < 32u; j++) {
+        x[j] -= carry * ed_l_bytes[j];
+    }
+    for (i = 0u; i < 32u; i++) {
+        x[i + 1u] += x[i] >> 8;
+        bytes[i] = (uint8_t)(x[i] & 0xff);
+    }
+    ed_from_bytes(r, bytes);
+}
+
+/*******************************************************************************
+ * Function Name: boot_ed25519_verify
+ ********************************************************************************
+ * Verifies an Ed25519 signature (RFC 8032): computes S * B - k * A with
+ * k = SHA-512(R || A || message) mod L, both scalars at once, and compares
+ * its encoding with R.
+ *
+ * Parameters:
+ *  pub            Public key, the encoded point A.
+ *  msg            Message, the SHA-256 of the image for MCUboot.
+ *  msg_len        Length of the message.
+ *  sig            Signature, the encoded point R then the scalar S.
+ *
+ * Return:
+ *  true if the signature is valid.
+ *******************************************************************************/
+bool boot_ed25519_verify(const uint8_t pub[BOOT_ED25519_KEY_SIZE], const uint8_t *msg, uint32_t msg_len,
+                         const uint8_t sig[BOOT_ED25519_SIG_SIZE]) {
+    ed_sha512_t sha;
+    uint8_t h[ED_SHA512_SIZE];
+    uint8_t encoded[BOOT_ED25519_KEY_SIZE];
+    ed_point_t table[4];
+    ed_point_t acc;
+    ed_fe_t s;
+    ed_fe_t k;
+
+    /* S must be canonical, below L */
+    ed_from_bytes(s, &sig[BOOT_ED25519_KEY_SIZE]);
+    if (ed_cmp(s, ed_l) >= 0) {
+        return false;
+    }
+
+    /* table[1] = B, table[2] = -A, table[3] = B - A */
+    memset(&table[0], 0, sizeof(table[0]));
+    table[0].y[0] = 1u;
+    table[0].z[0] = 1u;
+    memcpy(table[1].x, ed_bx, sizeof(ed_fe_t));
+    memcpy(table[1].y, ed_by, sizeof(ed_fe_t));
+    memcpy(table[1].z, table[0].z, sizeof(ed_fe_t));
+    ed_mul(table[1].t, ed_bx, ed_by);
+    if (!ed_point_decode(&table[2], pub)) {
+        return false;
+    }
+    ed_sub(table[2].x, table[0].x, table[2].x);
+    ed_sub(table[2].t, table[0].x, table[2].t);
+    ed_point_add(&table[3], &table[1], &table[2]);
+
+    ed_sha512_init(&sha);
+    ed_sha512_update(&sha, sig, BOOT_ED25519_KEY_SIZE);
+    ed_sha512_update(&sha, pub, BOOT_ED25519_KEY_SIZE);
+    ed_sha512_update(&sha, msg, msg_len);
+    ed_sha512_final(&sha, h);
+    ed_reduce_scalar(k, h);
+
+    acc = table[0];
+    for (uint32_t i = 253u; i-- > 0u;) {
+        uint32_t index = ((s[i / 32u] >> (i % 32u)) & 1u) | (((k[i / 32u] >> (i % 32u)) & 1u) << 1);
+
+        ed_point_double(&acc, &acc);
+        if (index != 0u) {
+            ed_point_add(&acc, &acc, &table[index]);
+        }
+    }
+
+    ed_point_encode(encoded, &acc);
+    return memcmp(encoded, sig, BOOT_ED25519_KEY_SIZE) == 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,620 @@
+/******************************************************************************
+ * File Name:   boot_p256.c
+ *
+ * Description: This file contains the ECDSA P-256 signature verification of the software crypto
+ *              backend, in 32-bit Montgomery arithmetic and Jacobian coordinates, and the ECDH of
+ *              the key of encrypted images. The verification handles public data only and is not
+ *              constant time; the ECDH runs the same point operations for every bit of the private
+ *              key.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "boot_p256.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* 32-bit words of a number, least significant first */
+#define P256_WORDS                  (8u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef uint32_t p256_int_t[P256_WORDS];
+
+/* Modulus of the Montgomery arithmetic: R = 2^256 */
+typedef struct {
+    const uint32_t *m;
+    /* R^2 mod m */
+    const uint32_t *rr;
+    /* -m^-1 mod 2^32 */
+    uint32_t m0inv;
+} p256_mod_t;
+
+/* Jacobian point in the Montgomery domain of p, z = 0 is the infinity */
+typedef struct {
+    p256_int_t x;
+    p256_int_t y;
+    p256_int_t z;
+} p256_point_t;
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const p256_int_t p256_p = {
+    0xffffffffu, 0xffffffffu, 0xffffffffu, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000001u, 0xffffffffu,
+};
+static const p256_int_t p256_rr_p = {
+    0x00000003u, 0x00000000u, 0xffffffffu, 0xfffffffbu, 0xfffffffeu, 0xffffffffu, 0xfffffffdu, 0x00000004u,
+};
+static const p256_int_t p256_n = {
+    0xfc632551u, 0xf3b9cac2u, 0xa7179e84u, 0xbce6faadu, 0xffffffffu, 0xffffffffu, 0x00000000u, 0xffffffffu,
+};
+static const p256_int_t p256_rr_n = {
+    0xbe79eea2u, 0x83244c95u, 0x49bd6fa6u, 0x4699799cu, 0x2b6bec59u, 0x2845b239u, 0xf3d95620u, 0x66e12d94u,
+};
+static const p256_int_t p256_b = {
+    0x27d2604bu, 0x3bce3c3eu, 0xcc53b0f6u, 0x651d06b0u, 0x769886bcu, 0xb3ebbd55u, 0xaa3a93e7u, 0x5ac635d8u,
+};
+static const p256_int_t p256_gx = {
+    0xd898c296u, 0xf4a13945u, 0x2deb33a0u, 0x77037d81u, 0x63a440f2u, 0xf8bce6e5u, 0xe12c4247u, 0x6b17d1f2u,
+};
+static const p256_int_t p256_gy = {
+    0x37bf51f5u, 0xcbb64068u, 0x6b315eceu, 0x2bce3357u, 0x7c0f9e16u, 0x8ee7eb4au, 0xfe1a7f9bu, 0x4fe342e2u,
+};
+
+static const p256_mod_t p256_mod_p = { p256_p, p256_rr_p, 0x00000001u };
+static const p256_mod_t p256_mod_n = { p256_n, p256_rr_n, 0xee00bc4fu };
+
+/*******************************************************************************
+ * Function Name: p256_from_bytes
+ ********************************************************************************
+ * Reads a big endian number.
+ *******************************************************************************/
+static void p256_from_bytes(p256_int_t r, const uint8_t *bytes) {
+    for (uint32_t i = 0u; i < P256_WORDS; i++) {
+        const uint8_t *p = &bytes[BOOT_P256_SIZE - 4u * (i + 1u)];
+
+        r[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+    }
+}
+
+/*******************************************************************************
+ * Function Name: p256_to_bytes
+ ********************************************************************************
+ * Writes a big endian number.
+ *******************************************************************************/
+static void p256_to_bytes(uint8_t *bytes, const p256_int_t a) {
+    for (uint32_t i = 0u; i < P256_WORDS; i++) {
+        uint8_t *p = &bytes[BOOT_P256_SIZE - 4u * (i + 1u)];
+
+        p[0] = (uint8_t)(a[i] >> 24);
+        p[1] = (uint8_t)(a[i] >> 16);
+        p[2] = (uint8_t)(a[i] >> 8);
+        p[3] = (uint8_t)a[i];
+    }
+}
+
+/*******************************************************************************
+ * Function Name: p256_cmp
+ ********************************************************************************
+ * Return:
+ *  -1, 0 or 1 as a is less than, equal to or greater than b.
+ *******************************************************************************/
+static int p256_cmp(const p256_int_t a, const p256_int_t b) {
+    for (uint32_t i = P256_WORDS; i-- > 0u;) {
+        if (a[i] != b[i]) {
+            return (a[i] < b[i]) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Function Name: p256_is_zero
+ ********************************************************************************
+ * Return:
+ *  true if the number is 0.
+ *******************************************************************************/
+static bool p256_is_zero(const p256_int_t a) {
+    uint32_t bits = 0u;
+
+    for (uint32_t i = 0u; i < P256_WORDS; i++) {
+        bits |= a[i];
+    }
+    return bits == 0u;
+}
+
+/*******************************************************************************
+ * Function Name: p256_add
+ ********************************************************************************
+ * r = a + b.
+ *
+ * Return:
+ *  The carry.
+ *******************************************************************************/
+static uint32_t p256_add(p256_int_t r, const p256_int_t a, const p256_int_t b) {
+    uint64_t c = 0u;
+
+    for (uint32_t i = 0u; i < P256_WORDS; i++) {
+        c += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    return (uint32_t)c;
+}
+
+/*******************************************************************************
+ * Function Name: p256_sub
+ ********************************************************************************
+ * r = a - b.
+ *
+ * Return:
+ *  The borrow.
+ *******************************************************************************/
+static uint32_t p256_sub(p256_int_t r, const p256_int_t a, const p256_int_t b) {
+    int64_t c = 0;
+
+    for (uint32_t i = 0u; i < P256_WORDS; i++) {
+        c += (int64_t)a[i] - b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    return (uint32_t)(c & 1);
+}
+
+/*******************************************************************************
+ * Function Name: p256_mod_add
+ ********************************************************************************
+ * r = a + b mod m, a and b less than m.
+ *******************************************************************************/
+static void p256_mod_add(p256_int_t r, const p256_int_t a, const p256_int_t b, const p256_mod_t *mod) {
+    uint32_t carry = p256_add(r, a, b);
+
+    if ((carry != 0u) || (p256_cmp(r, mod->m) >= 0)) {
+        (void)p256_sub(r, r, mod->m);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: p256_mod_sub
+ ********************************************************************************
+ * r = a - b mod m, a and b less than m.
+ *******************************************************************************/
+static void p256_mod_sub(p256_int_t r, const p256_int_t a, const p256_int_t b, const p256_mod_t *mod) {
+    if (p256_sub(r, a, b) != 0u) {
+        (void)p256_add(r, r, mod->m);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: p256_mont_mul
+ ********************************************************************************
+ * r = a * b / R mod m, the Montgomery product of a and b less than m.
+ *******************************************************************************/
+static void p256_mont_mul(p256_int_t r, const p256_int_t a, const p256_int_t b, const p256_mod_t *mod) {
+    uint32_t t[P256_WORDS + 2u] = { 0u };
+
+    for (uint32_t i = 0u; i < P256_WORDS; i++) {
+        uint64_t c = 0u;
+        uint32_t q;
+
+        for (uint32_t j = 0u; j < P256_WORDS; j++) {
+            c += (uint64_t)t[j] + (uint64_t)a[j] * b[i];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[P256_WORDS];
+        t[P256_WORDS] = (uint32_t)c;
+        t[P256_WORDS + 1u] = (uint32_t)(c >> 32);
+
+        /* Add q * m to clear the low word, then shift by one word */
+        q = t[0] * mod->m0inv;
+        c = ((uint64_t)t[0] + (uint64_t)q * mod->m[0]) >> 32;
+        for (uint32_t j = 1u; j < P256_WORDS; j++) {
+            c += (uint64_t)t[j] + (uint64_t)q * mod->m[j];
+            t[j - 1u] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[P256_WORDS];
+        t[P256_WORDS - 1u] = (uint32_t)c;
+        t[P256_WORDS] = t[P256_WORDS + 1u] + (uint32_t)(c >> 32);
+    }
+
+    if ((t[P256_WORDS] != 0u) || (p256_cmp(t, mod->m) >= 0)) {
+        (void)p256_sub(t, t, mod->m);
+    }
+    memcpy(r, t, sizeof(p256_int_t));
+}
+
+/*******************************************************************************
+ * Function Name: p256_to_mont
+ ********************************************************************************
+ * r = a * R mod m.
+ *******************************************************************************/
+static void p256_to_mont(p256_int_t r, const p256_int_t a, const p256_mod_t *mod) {
+    p256_mont_mul(r, a, mod->rr, mod);
+}
+
+/*******************************************************************************
+ * Function Name: p256_mont_inv
+ ********************************************************************************
+ * r = a^-1 in the Montgomery domain, as a^(m - 2) for the prime m.
+ *******************************************************************************/
+static void p256_mont_inv(p256_int_t r, const p256_int_t a, const p256_mod_t *mod) {
+    static const p256_int_t two = { 2u };
+    p256_int_t e;
+    p256_int_t x;
+    p256_int_t one = { 1u };
+
+    (void)p256_sub(e, mod->m, two);
+    p256_to_mont(x, one, mod);
+    for (uint32_t i = 256u; i-- > 0u;) {
+        p256_mont_mul(x, x, x, mod);
+        if (((e[i / 32u] >> (i % 32u)) & 1u) != 0u) {
+            p256_mont_mul(x, x, a, mod);
+        }
+    }
+    memcpy(r, x, sizeof(p256_int_t));
+}
+
+/*******************************************************************************
+ * Function Name: p256_point_double
+ ********************************************************************************
+ * r = 2 * a, with the doubling formulas for a curve coefficient of -3.
+ *******************************************************************************/
+static void p256_point_double(p256_point_t *r, const p256_point_t *a) {
+    const p256_mod_t *mod = &p256_mod_p;
+    p256_int_t delta;
+    p256_int_t gamma;
+    p256_int_t beta;
+    p256_int_t alpha;
+    p256_int_t t0;
+    p256_int_t t1;
+
+    if (p256_is_zero(a->z)) {
+        *r = *a;
+        return;
+    }
+    p256_mont_mul(delta, a->z, a->z, mod);
+    p256_mont_mul(gamma, a->y, a->y, mod);
+    p256_mont_mul(beta, a->x, gamma, mod);
+
+    /* alpha = 3 * (x - delta) * (x + delta) */
+    p256_mod_sub(t0, a->x, delta, mod);
+    p256_mod_add(t1, a->x, delta, mod);
+    p256_mont_mul(alpha, t0, t1, mod);
+    p256_mod_add(t0, alpha, alpha, mod);
+    p256_mod_add(alpha, t0, alpha, mod);
+
+    /* z3 = (y + z)^2 - gamma - delta */
+    p256_mod_add(t0, a->y, a->z, mod);
+    p256_mont_mul(t0, t0, t0, mod);
+    p256_mod_sub(t0, t0, gamma, mod);
+    p256_mod_sub(r->z, t0, delta, mod);
+
+    /* x3 = alpha^2 - 8 * beta */
+    p256_mod_add(beta, beta, beta, mod);
+    p256_mod_add(beta, beta, beta, mod);
+    p256_mod_add(t1, beta, beta, mod);
+    p256_mont_mul(t0, alpha, alpha, mod);
+    p256_mod_sub(r->x, t0, t1, mod);
+
+    /* y3 = alpha * (4 * beta - x3) - 8 * gamma^2 */
+    p256_mod_sub(t0, beta, r->x, mod);
+    p256_mont_mul(t0, alpha, t0, mod);
+    p256_mont_mul(t1, gamma, gamma, mod);
+    p256_mod_add(t1, t1, t1, mod);
+    p256_mod_add(t1, t1, t1, mod);
+    p256_mod_add(t1, t1, t1, mod);
+    p256_mod_sub(r->y, t0, t1, mod);
+}
+
+/*******************************************************************************
+ * Function Name: p256_point_add
+ ********************************************************************************
+ * r = a + b, for any two points.
+ *******************************************************************************/
+static void p256_point_add(p256_point_t *r, const p256_point_t *a, const p256_point_t *b) {
+    const p256_mod_t *mod = &p256_mod_p;
+    p256_int_t z1z1;
+    p256_int_t z2z2;
+    p256_int_t u1;
+    p256_int_t u2;
+    p256_int_t s1;
+    p256_int_t s2;
+    p256_int_t h;
+    p256_int_t rr;
+    p256_int_t i;
+    p256_int_t j;
+    p256_int_t v;
+    p256_int_t t0;
+
+    if (p256_is_zero(a->z)) {
+        *r = *b;
+        return;
+    }
+    if (p256_is_zero(b->z)) {
+        *r = *a;
+        return;
+    }
+
+    p256_mont_mul(z1z1, a->z, a->z, mod);
+    p256_mont_mul(z2z2, b->z, b->z, mod);
+    p256_mont_mul(u1, a->x, z2z2, mod);
+    p256_mont_mul(u2, b->x, z1z1, mod);
+    p256_mont_mul(s1, a->y, b->z, mod);
+    p256_mont_mul(s1, s1, z2z2, mod);
+    p256_mont_mul(s2, b->y, a->z, mod);
+    p256_mont_mul(s2, s2, z1z1, mod);
+    p256_mod_sub(h, u2, u1, mod);
+    p256_mod_sub(rr, s2, s1, mod);
+
+    if (p256_is_zero(h)) {
+        if (p256_is_zero(rr)) {
+            p256_point_double(r, a);
+        } else {
+            memset(r, 0, sizeof(*r));
+        }
+        return;
+    }
+    p256_mod_add(rr, rr, rr, mod);
+
+    /* i = (2 * h)^2, j = h * i, v = u1 * i */
+    p256_mod_add(i, h, h, mod);
+    p256_mont_mul(i, i, i, mod);
+    p256_mont_mul(j, h, i, mod);
+    p256_mont_mul(v, u1, i, mod);
+
+    /* z3 = ((z1 + z2)^2 - z1z1 - z2z2) * h, before a or b is overwritten */
+    p256_mod_add(t0, a->z, b->z, mod);
+    p256_mont_mul(t0, t0, t0, mod);
+    p256_mod_sub(t0, t0, z1z1, mod);
+    p256_mod_sub(t0, t0, z2z2, mod);
+    p256_mont_mul(r->z, t0, h, mod);
+
+    /* x3 = rr^2 - j - 2 * v */
+    p256_mont_mul(t0, rr, rr, mod);
+    p256_mod_sub(t0, t0, j, mod);
+    p256_mod_sub(t0, t0, v, mod);
+    p256_mod_sub(r->x, t0, v, mod);
+
+    /* y3 = rr * (v - x3) - 2 * s1 * j */
+    p256_mod_sub(t0, v, r->x, mod);
+    p256_mont_mul(t0, rr, t0, mod);
+    p256_mont_mul(s1, s1, j, mod);
+    p256_mod_add(s1, s1, s1, mod);
+    p256_mod_sub(r->y, t0, s1, mod);
+}
+
+/*******************************************************************************
+ * Function Name: p256_point_from_affine
+ ********************************************************************************
+ * Converts affine coordinates into a point, checking that they are on the
+ * curve: y^2 = x^3 - 3x + b.
+ *
+ * Return:
+ *  true if the point is on the curve.
+ *******************************************************************************/
+static bool p256_point_from_affine(p256_point_t *r, const p256_int_t x, const p256_int_t y) {
+    const p256_mod_t *mod = &p256_mod_p;
+    p256_int_t one = { 1u };
+    p256_int_t lhs;
+    p256_int_t rhs;
+    p256_int_t t0;
+
+    if ((p256_cmp(x, p256_p) >= 0) || (p256_cmp(y, p256_p) >= 0)) {
+        return false;
+    }
+    p256_to_mont(r->x, x, mod);
+    p256_to_mont(r->y, y, mod);
+    p256_to_mont(r->z, one, mod);
+
+    p256_mont_mul(lhs, r->y, r->y, mod);
+    p256_mont_mul(rhs, r->x, r->x, mod);
+    p256_mont_mul(rhs, rhs, r->x, mod);
+    p256_mod_add(t0, r->x, r->x, mod);
+    p256_mod_add(t0, t0, r->x, mod);
+    p256_mod_sub(rhs, rhs, t0, mod);
+    p256_to_mont(t0, p256_b, mod);
+    p256_mod_add(rhs, rhs, t0, mod);
+    return p256_cmp(lhs, rhs) == 0;
+}
+
+/*******************************************************************************
+ * Function Name: boot_p256_verify
+ ********************************************************************************
+ * Verifies an ECDSA P-256 signature: computes u1 * G + u2 * Q with
+ * u1 = e / s and u2 = r / s mod n, both scalars at once, and compares its x
+ * coordinate with r.
+ *
+ * Parameters:
+ *  pub            Public key Q, x then y, big endian.
+ *  hash           SHA-256 of the message.
+ *  sig            Signature, r then s, big endian.
+ *
+ * Return:
+ *  true if the signature is valid.
+ *******************************************************************************/
+bool boot_p256_verify(const uint8_t pub[2u * BOOT_P256_SIZE], const uint8_t hash[BOOT_P256_SIZE],
+                      const uint8_t sig[2u * BOOT_P256_SIZE]) {
+    const p256_mod_t *mod_n = &p256_mod_n;
+    p256_point_t table[4];
+    p256_point_t acc;
+    p256_int_t qx;
+    p256_int_t qy;
+    p256_int_t r;
+    p256_int_t s;
+    p256_int_t e;
+    p256_int_t w;
+    p256_int_t u1;
+    p256_int_t u2;
+    p256_int_t x;
+
+    p256_from_bytes(r, sig);
+    p256_from_bytes(s, &sig[BOOT_P256_SIZE]);
+    if (p256_is_zero(r) || p256_is_zero(s) || (p256_cmp(r, p256_n) >= 0) || (p256_cmp(s, p256_n) >= 0)) {
+        return false;
+    }
+
+    /* table[1] = G, table[2] = Q, table[3] = G + Q */
+    p256_from_bytes(qx, pub);
+    p256_from_bytes(qy, &pub[BOOT_P256_SIZE]);
+    memset(&table[0], 0, sizeof(table[0]));
+    if (!p256_point_from_affine(&table[1], p256_gx, p256_gy) ||
+        !p256_point_from_affine(&table[2], qx, qy)) {
+        return false;
+    }
+    p256_point_add(&table[3], &table[1], &table[2]);
+
+    /* w = s^-1 in the Montgomery domain of n, u = (e or r) * w / R */
+    p256_from_bytes(e, hash);
+    if (p256_cmp(e, p256_n) >= 0) {
+        (void)p256_sub(e, e, p256_n);
+    }
+    p256_to_mont(w, s, mod_n);
+    p256_mont_inv(w, w, mod_n);
+    p256_mont_mul(u1, e, w, mod_n);
+    p256_mont_mul(u2, r, w, mod_n);
+
+    memset(&acc, 0, sizeof(acc));
+    for (uint32_t i = 256u; i-- > 0u;) {
+        uint32_t index = ((u1[i / 32u] >> (i % 32u)) & 1u) | (((u2[i / 32u] >> (i % 32u)) & 1u) << 1);
+
+        p256_point_double(&acc, &acc);
+        if (index != 0u) {
+            p256_point_add(&acc, &acc, &table[index]);
+        }
+    }
+    if (p256_is_zero(acc.z)) {
+        return false;
+    }
+
+    /* x = X / Z^2, out of the Montgomery domain, then mod n */
+    p256_mont_inv(w, acc.z, &p256_mod_p);
+    p256_mont_mul(w, w, w, &p256_mod_p);
+    p256_mont_mul(x, acc.x, w, &p256_mod_p);
+    memset(w, 0, sizeof(w));
+    w[0] = 1u;
+    p256_mont_mul(x, x, w, &p256_mod_p);
+    if (p256_cmp(x, p256_n) >= 0) {
+        (void)p256_sub(x, x, p256_n);
+    }
+    return p256_cmp(x, r) == 0;
+}
+
+/*******************************************************************************
+ * Function Name: p256_point_swap
+ ********************************************************************************
+ * Swaps two points if swap is 1, with the same memory accesses otherwise.
+ *******************************************************************************/
+static void p256_point_swap(p256_point_t *a, p256_point_t *b, uint32_t swap) {
+    uint32_t mask = 0u - swap;
+    uint32_t *pa = (uint32_t *)a;
+    uint32_t *pb = (uint32_t *)b;
+
+    for (uint32_t i = 0u; i < sizeof(p256_point_t) / sizeof(uint32_t); i++) {
+        uint32_t t = (pa[i] ^ pb[i]) & mask;
+
+        pa[i] ^= t;
+        pb[i] ^= t;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: boot_p256_ecdh
+ ********************************************************************************
+ * Computes the ECDH shared secret, the x coordinate of d * Q, for the key
+ * of an encrypted image. The Montgomery ladder runs the same point
+ * operations for every bit of the private key.
+ *
+ * Parameters:
+ *  priv           Private key d, big endian.
+ *  pub            Public key Q of the peer, x then y, big endian.
+ *  shared         Receives the x coordinate, big endian.
+ *
+ * Return:
+ *  true on success, false if a key is not valid.
+ *******************************************************************************/
+bool boot_p256_ecdh(const uint8_t priv[BOOT_P256_SIZE], const uint8_t pub[2u * BOOT_P256_SIZE],
+                    uint8_t shared[BOOT_P256_SIZE]) {
+    const p256_mod_t *mod = &p256_mod_p;
+    p256_point_t r0;
+    p256_point_t r1;
+    p256_int_t d;
+    p256_int_t qx;
+    p256_int_t qy;
+    p256_int_t w;
+    p256_int_t x;
+    uint32_t bit = 0u;
+    bool valid;
+
+    p256_from_bytes(d, priv);
+    p256_from_bytes(qx, pub);
+    p256_from_bytes(qy, &pub[BOOT_P256_SIZE]);
+    if (p256_is_zero(d) || (p256_cmp(d, p256_n) >= 0) || !p256_point_from_affine(&r1, qx, qy)) {
+        return false;
+    }
+
+    /* r0 = k * Q and r1 = (k + 1) * Q for the bits k of d read so far */
+    memset(&r0, 0, sizeof(r0));
+    for (uint32_t i = 256u; i-- > 0u;) {
+        uint32_t next = (d[i / 32u] >> (i % 32u)) & 1u;
+
+        p256_point_swap(&r0, &r1, bit ^ next);
+        bit = next;
+        p256_point_add(&r1, &r0, &r1);
+        p256_point_double(&r0, &r0);
+    }
+    p256_point_swap(&r0, &r1, bit);
+    memset(d, 0, sizeof(d));
+    valid = !p256_is_zero(r0.z);
+
+    /* x = X / Z^2, out of the Montgomery domain */
+    p256_mont_inv(w, r0.z, mod);
+    p256_mont_mul(w, w, w, mod);
+    p256_mont_mul(x, r0.x, w, mod);
+    memset(w, 0, sizeof(w));
+    w[0] = 1u;
+    p256_mont_mul(x, x, w, mod);
+    p256_to_bytes(shared, x);
+    memset(&r0, 0, sizeof(r0));
+    memset(&r1, 0, sizeof(r1));
+    return valid;
+}
+
+/* [] END OF FILE */
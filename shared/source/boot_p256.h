@@ -0,0 +1,64 @@
+/******************************************************************************
+ * File Name:   boot_p256.h
+ *
+ * Description: This file contains the declarations of the software ECDSA P-256 signature
+ *              verification and ECDH of the software crypto backend.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef BOOT_P256_H
+#define BOOT_P256_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Size of a coordinate, a scalar and the hash, big endian */
+#define BOOT_P256_SIZE              (32u)
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+bool boot_p256_verify(const uint8_t pub[2u * BOOT_P256_SIZE], const uint8_t hash[BOOT_P256_SIZE],
+                      const uint8_t sig[2u * BOOT_P256_SIZE]);
+bool boot_p256_ecdh(const uint8_t priv[BOOT_P256_SIZE], const uint8_t pub[2u * BOOT_P256_SIZE],
+                    uint8_t shared[BOOT_P256_SIZE]);
+
+#endif /* BOOT_P256_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,268 @@
+/******************************************************************************
+ * File Name:   boot_timing.c
+ *
+ * Description: This file contains the boot time probes of the edge protect bootloader. The
+ *              bootloader counts the CPU clock with the SysTick, extended by its interrupt,
+ *              and records the start of every boot phase in microseconds. The DFU
+ *              application and the host tools decode the table.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "boot_timing.h"
+
+#if (BOOT_TIMING)
+#if defined(BOOT_CM0P)
+#include "cy_pdl.h"
+#endif /* BOOT_CM0P */
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define BOOT_TIMING_SYSTICK_RANGE   (0x01000000uL)
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const char *const boot_timing_names[BOOT_PHASE_COUNT] = {
+    "bsp init",
+    "retarget-io init",
+    "boot_go",
+    "read header",
+    "validate",
+    "update",
+    "update done",
+    "wdt init",
+    "deinit",
+    "launch",
+    "cm7 hash start",
+    "cm7 hash wait",
+    "verify signature",
+    "fast check",
+};
+
+#if defined(BOOT_CM0P)
+/* SysTick periods elapsed, and the time of the last entry */
+static volatile uint32_t timing_wraps = 0u;
+static uint64_t timing_last_ticks = 0u;
+static uint32_t timing_last_us = 0u;
+static bool timing_running = false;
+#endif /* BOOT_CM0P */
+
+/*******************************************************************************
+ * Function Name: boot_timing_table
+ ********************************************************************************
+ * Return:
+ *  The table, at BOOT_TIMING_ADDR.
+ *******************************************************************************/
+__attribute__((weak))
+boot_timing_t *boot_timing_table(void) {
+    return (boot_timing_t *)BOOT_TIMING_ADDR;
+}
+
+#if defined(BOOT_CM0P)
+/*******************************************************************************
+ * Function Name: boot_timing_wrap
+ ********************************************************************************
+ * SysTick callback, counts the periods of the SysTick.
+ *******************************************************************************/
+static void boot_timing_wrap(void) {
+    timing_wraps++;
+}
+
+/*******************************************************************************
+ * Function Name: boot_timing_ticks
+ ********************************************************************************
+ * Return:
+ *  CPU clock cycles since boot_timing_start(). A wrap pending while the
+ *  interrupts are disabled is counted as well.
+ *******************************************************************************/
+static uint64_t boot_timing_ticks(void) {
+    uint32_t wraps;
+    uint32_t value;
+
+    do {
+        wraps = timing_wraps;
+        value = SysTick->VAL;
+    } while (wraps != timing_wraps);
+    if (((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0u) && (value > BOOT_TIMING_SYSTICK_RANGE / 2u)) {
+        wraps++;
+    }
+    return ((uint64_t)wraps * BOOT_TIMING_SYSTICK_RANGE) + (BOOT_TIMING_SYSTICK_RANGE - 1u - value);
+}
+
+/*******************************************************************************
+ * Function Name: boot_timing_start
+ ********************************************************************************
+ * Starts the SysTick and clears the table. Call first in main().
+ *******************************************************************************/
+void boot_timing_start(void) {
+    memset(boot_timing_table(), 0, sizeof(boot_timing_t));
+    timing_wraps = 0u;
+    timing_last_ticks = 0u;
+    timing_last_us = 0u;
+    Cy_SysTick_Init(CY_SYSTICK_CLOCK_SOURCE_CLK_CPU, BOOT_TIMING_SYSTICK_RANGE - 1u);
+    (void)Cy_SysTick_SetCallback(0u, &boot_timing_wrap);
+    timing_running = true;
+}
+
+/*******************************************************************************
+ * Function Name: boot_timing_mark
+ ********************************************************************************
+ * Records the start of a phase. The cycles since the previous entry are
+ * converted with the current CPU clock, so a phase that changes the clock,
+ * such as the BSP initialization, is measured with the clock at its end.
+ *
+ * Parameters:
+ *  phase          Phase starting.
+ *  arg            Slot or image index, 0xFFFF if none.
+ *******************************************************************************/
+void boot_timing_mark(boot_phase_t phase, uint32_t arg) {
+    boot_timing_t *table = boot_timing_table();
+    uint32_t ticks_per_us = SystemCoreClock / 1000000u;
+    uint64_t ticks;
+
+    if (!timing_running) {
+        return;
+    }
+    ticks = boot_timing_ticks();
+    if (ticks_per_us != 0u) {
+        timing_last_us += (uint32_t)((ticks - timing_last_ticks) / ticks_per_us);
+    }
+    timing_last_ticks = ticks;
+
+    if (table->count < BOOT_TIMING_MAX_ENTRIES) {
+        boot_timing_entry_t *entry = &table->entries[table->count];
+
+        entry->phase = (uint16_t)phase;
+        entry->arg = (uint16_t)arg;
+        entry->time_us = timing_last_us;
+        table->count++;
+    } else {
+        table->dropped++;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: boot_timing_now_us
+ ********************************************************************************
+ * Return:
+ *  Microseconds from the start of the bootloader main(), without an entry.
+ *  Clock of the deferred log of the bootloader.
+ *******************************************************************************/
+uint32_t boot_timing_now_us(void) {
+    uint32_t ticks_per_us = SystemCoreClock / 1000000u;
+
+    if (!timing_running || (ticks_per_us == 0u)) {
+        return timing_last_us;
+    }
+    return timing_last_us + (uint32_t)((boot_timing_ticks() - timing_last_ticks) / ticks_per_us);
+}
+
+/*******************************************************************************
+ * Function Name: boot_timing_stop
+ ********************************************************************************
+ * Records the last phase, stops the SysTick and validates the table.
+ *
+ * Parameters:
+ *  phase          Last phase, usually BOOT_PHASE_LAUNCH.
+ *******************************************************************************/
+void boot_timing_stop(boot_phase_t phase) {
+    boot_timing_t *table = boot_timing_table();
+
+    if (!timing_running) {
+        return;
+    }
+    boot_timing_mark(phase, 0xFFFFu);
+    timing_running = false;
+    Cy_SysTick_Disable();
+    table->version = BOOT_TIMING_VERSION;
+    table->cpu_hz = SystemCoreClock;
+    table->magic = BOOT_TIMING_MAGIC;
+}
+#endif /* BOOT_CM0P */
+
+/*******************************************************************************
+ * Function Name: boot_timing_valid
+ ********************************************************************************
+ * Return:
+ *  true if the table was completed by the bootloader.
+ *******************************************************************************/
+bool boot_timing_valid(const boot_timing_t *table) {
+    return (table->magic == BOOT_TIMING_MAGIC) && (table->version == BOOT_TIMING_VERSION) &&
+           (table->count != 0u) && (table->count <= BOOT_TIMING_MAX_ENTRIES);
+}
+
+/*******************************************************************************
+ * Function Name: boot_timing_phase_name
+ ********************************************************************************
+ * Return:
+ *  Name of the phase.
+ *******************************************************************************/
+const char *boot_timing_phase_name(uint32_t phase) {
+    return (phase < BOOT_PHASE_COUNT) ? boot_timing_names[phase] : "unknown";
+}
+
+/*******************************************************************************
+ * Function Name: boot_timing_print
+ ********************************************************************************
+ * Prints the duration of every phase and the time of the launch.
+ *******************************************************************************/
+void boot_timing_print(const boot_timing_t *table) {
+    if (!boot_timing_valid(table)) {
+        printf("[Boot timing] No boot timing table\r\n");
+        return;
+    }
+    for (uint32_t i = 0u; i + 1u < table->count; i++) {
+        const boot_timing_entry_t *entry = &table->entries[i];
+
+        if (entry->arg != 0xFFFFu) {
+            printf("[Boot timing] %-16s %u : %10lu us\r\n", boot_timing_phase_name(entry->phase),
+                   (unsigned int)entry->arg,
+                   (unsigned long)(table->entries[i + 1u].time_us - entry->time_us));
+        } else {
+            printf("[Boot timing] %-18s : %10lu us\r\n", boot_timing_phase_name(entry->phase),
+                   (unsigned long)(table->entries[i + 1u].time_us - entry->time_us));
+        }
+    }
+    printf("[Boot timing] %-18s : %10lu us%s\r\n", boot_timing_phase_name(table->entries[table->count - 1u].phase),
+           (unsigned long)table->entries[table->count - 1u].time_us,
+           (table->dropped != 0u) ? " (phases dropped)" : "");
+}
+#endif /* BOOT_TIMING */
+
+/* [] END OF FILE */
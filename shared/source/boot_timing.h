@@ -0,0 +1,140 @@
+/******************************************************************************
+ * File Name:   boot_timing.h
+ *
+ * Description: This file contains the boot time probes of the edge protect bootloader. The
+ *              bootloader records the start of every boot phase in a table in RAM, which
+ *              the DFU application prints after the launch and a host tool decodes from a
+ *              memory dump.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef BOOT_TIMING_H
+#define BOOT_TIMING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Set to 1 to record the boot phases */
+#ifndef BOOT_TIMING
+#define BOOT_TIMING                 (0)
+#endif
+
+/* RAM address of the table, kept over the launch of the CM7 and used by
+ * neither the bootloader nor the DFU application otherwise. The default is
+ * 128 bytes below the end of the SRAM */
+#ifndef BOOT_TIMING_ADDR
+#define BOOT_TIMING_ADDR            (0x280FFE80uL)
+#endif
+
+#define BOOT_TIMING_MAGIC           (0x4D495442uL)
+#define BOOT_TIMING_VERSION         (1u)
+#define BOOT_TIMING_MAX_ENTRIES     (30u)
+
+/* Probe of the bootloader, removed unless BOOT_TIMING is set */
+#if (BOOT_TIMING) && defined(BOOT_CM0P)
+#define BOOT_TIMING_MARK(phase, arg)    boot_timing_mark((phase), (arg))
+#else
+#define BOOT_TIMING_MARK(phase, arg)
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/* A phase lasts from its entry to the next entry */
+typedef enum {
+    BOOT_PHASE_BSP_INIT = 0,
+    BOOT_PHASE_RETARGET_INIT,
+    BOOT_PHASE_BOOT_GO,
+    BOOT_PHASE_READ_HEADER,
+    BOOT_PHASE_VALIDATE,
+    BOOT_PHASE_UPDATE,
+    BOOT_PHASE_UPDATE_DONE,
+    BOOT_PHASE_WDT_INIT,
+    BOOT_PHASE_DEINIT,
+    BOOT_PHASE_LAUNCH,
+    /* CM7 hashing stub started, the CM0+ reads the TLVs meanwhile */
+    BOOT_PHASE_HASH_START,
+    /* The CM0+ waits for the digest of the stub */
+    BOOT_PHASE_HASH_WAIT,
+    /* Signature verification over a digest of the hooks */
+    BOOT_PHASE_VERIFY_SIG,
+    /* Fast boot profile: headers and trailers read before boot_go() */
+    BOOT_PHASE_FAST_CHECK,
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+typedef struct {
+    /* boot_phase_t */
+    uint16_t phase;
+    /* Slot or image index, 0xFFFF if none */
+    uint16_t arg;
+    /* Microseconds from the start of the bootloader main() */
+    uint32_t time_us;
+} boot_timing_entry_t;
+
+/*
+ * The table is valid once magic is set, when the bootloader launches the
+ * application. dropped counts the phases that did not fit.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint16_t dropped;
+    uint16_t reserved;
+    /* Clock of the bootloader core at the launch */
+    uint32_t cpu_hz;
+    boot_timing_entry_t entries[BOOT_TIMING_MAX_ENTRIES];
+} boot_timing_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+boot_timing_t *boot_timing_table(void);
+void boot_timing_start(void);
+void boot_timing_mark(boot_phase_t phase, uint32_t arg);
+uint32_t boot_timing_now_us(void);
+void boot_timing_stop(boot_phase_t phase);
+bool boot_timing_valid(const boot_timing_t *table);
+const char *boot_timing_phase_name(uint32_t phase);
+void boot_timing_print(const boot_timing_t *table);
+
+#endif /* BOOT_TIMING_H */
+
+/* [] END OF FILE */
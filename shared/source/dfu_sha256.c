@@ -0,0 +1,193 @@
+/******************************************************************************
+ * File Name:   dfu_sha256.c
+ *
+ * Description: This file contains a compact SHA-256 (FIPS 180-4) for the DFU application, which
+ *              does not link the crypto library of the bootloader. It hashes the upgrade
+ *              image one row at a time, and runs the hashing stub the bootloader starts on
+ *              the CM7 (boot_cm7_hash.c).
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <string.h>
+#include "dfu_sha256.h"
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define DFU_SHA256_ROR(x, n)        (((x) >> (n)) | ((x) << (32u - (n))))
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+static const uint32_t sha256_k[64] = {
+    0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+    0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+    0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+    0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+    0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+    0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+    0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+    0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u,
+};
+
+/*******************************************************************************
+ * Function Name: dfu_sha256_block
+ ********************************************************************************
+ * Hashes one 64-byte block into the state.
+ *******************************************************************************/
+static void dfu_sha256_block(uint32_t *state, const uint8_t *block) {
+    uint32_t w[64];
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
+
+    for (uint32_t i = 0u; i < 16u; i++) {
+        w[i] = ((uint32_t)block[4u * i] << 24) | ((uint32_t)block[4u * i + 1u] << 16) |
+               ((uint32_t)block[4u * i + 2u] << 8) | (uint32_t)block[4u * i + 3u];
+    }
+    for (uint32_t i = 16u; i < 64u; i++) {
+        uint32_t s0 = DFU_SHA256_ROR(w[i - 15u], 7u) ^ DFU_SHA256_ROR(w[i - 15u], 18u) ^ (w[i - 15u] >> 3);
+        uint32_t s1 = DFU_SHA256_ROR(w[i - 2u], 17u) ^ DFU_SHA256_ROR(w[i - 2u], 19u) ^ (w[i - 2u] >> 10);
+
+        w[i] = w[i - 16u] + s0 + w[i - 7u] + s1;
+    }
+    for (uint32_t i = 0u; i < 64u; i++) {
+        uint32_t s1 = DFU_SHA256_ROR(e, 6u) ^ DFU_SHA256_ROR(e, 11u) ^ DFU_SHA256_ROR(e, 25u);
+        uint32_t t1 = h + s1 + ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+        uint32_t s0 = DFU_SHA256_ROR(a, 2u) ^ DFU_SHA256_ROR(a, 13u) ^ DFU_SHA256_ROR(a, 22u);
+        uint32_t t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_sha256_init
+ ********************************************************************************
+ * Starts a hash.
+ *******************************************************************************/
+void dfu_sha256_init(dfu_sha256_t *ctx) {
+    ctx->state[0] = 0x6a09e667u;
+    ctx->state[1] = 0xbb67ae85u;
+    ctx->state[2] = 0x3c6ef372u;
+    ctx->state[3] = 0xa54ff53au;
+    ctx->state[4] = 0x510e527fu;
+    ctx->state[5] = 0x9b05688cu;
+    ctx->state[6] = 0x1f83d9abu;
+    ctx->state[7] = 0x5be0cd19u;
+    ctx->length = 0u;
+}
+
+/*******************************************************************************
+ * Function Name: dfu_sha256_update
+ ********************************************************************************
+ * Hashes the next bytes of the message.
+ *******************************************************************************/
+void dfu_sha256_update(dfu_sha256_t *ctx, const uint8_t *data, uint32_t length) {
+    uint32_t fill = (uint32_t)(ctx->length % DFU_SHA256_BLOCK_SIZE);
+
+    ctx->length += length;
+    if (fill != 0u) {
+        uint32_t take = DFU_SHA256_BLOCK_SIZE - fill;
+
+        if (take > length) {
+            take = length;
+        }
+        memcpy(&ctx->block[fill], data, take);
+        data += take;
+        length -= take;
+        if (fill + take < DFU_SHA256_BLOCK_SIZE) {
+            return;
+        }
+        dfu_sha256_block(ctx->state, ctx->block);
+    }
+    while (length >= DFU_SHA256_BLOCK_SIZE) {
+        dfu_sha256_block(ctx->state, data);
+        data += DFU_SHA256_BLOCK_SIZE;
+        length -= DFU_SHA256_BLOCK_SIZE;
+    }
+    memcpy(ctx->block, data, length);
+}
+
+/*******************************************************************************
+ * Function Name: dfu_sha256_final
+ ********************************************************************************
+ * Pads the message and returns the digest.
+ *******************************************************************************/
+void dfu_sha256_final(dfu_sha256_t *ctx, uint8_t digest[DFU_SHA256_SIZE]) {
+    uint64_t bits = ctx->length * 8u;
+    uint32_t fill = (uint32_t)(ctx->length % DFU_SHA256_BLOCK_SIZE);
+
+    ctx->block[fill++] = 0x80u;
+    if (fill > DFU_SHA256_BLOCK_SIZE - 8u) {
+        memset(&ctx->block[fill], 0, DFU_SHA256_BLOCK_SIZE - fill);
+        dfu_sha256_block(ctx->state, ctx->block);
+        fill = 0u;
+    }
+    memset(&ctx->block[fill], 0, DFU_SHA256_BLOCK_SIZE - 8u - fill);
+    for (uint32_t i = 0u; i < 8u; i++) {
+        ctx->block[DFU_SHA256_BLOCK_SIZE - 1u - i] = (uint8_t)(bits >> (8u * i));
+    }
+    dfu_sha256_block(ctx->state, ctx->block);
+    for (uint32_t i = 0u; i < 8u; i++) {
+        digest[4u * i] = (uint8_t)(ctx->state[i] >> 24);
+        digest[4u * i + 1u] = (uint8_t)(ctx->state[i] >> 16);
+        digest[4u * i + 2u] = (uint8_t)(ctx->state[i] >> 8);
+        digest[4u * i + 3u] = (uint8_t)ctx->state[i];
+    }
+}
+
+/* [] END OF FILE */
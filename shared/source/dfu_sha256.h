@@ -0,0 +1,72 @@
+/******************************************************************************
+ * File Name:   dfu_sha256.h
+ *
+ * Description: This file contains the declarations of the SHA-256 used by the DFU application
+ *              to hash the upgrade image.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DFU_SHA256_H
+#define DFU_SHA256_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define DFU_SHA256_SIZE             (32u)
+#define DFU_SHA256_BLOCK_SIZE       (64u)
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+typedef struct {
+    uint32_t state[8];
+    /* Bytes hashed so far */
+    uint64_t length;
+    uint8_t block[DFU_SHA256_BLOCK_SIZE];
+} dfu_sha256_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+void dfu_sha256_init(dfu_sha256_t *ctx);
+void dfu_sha256_update(dfu_sha256_t *ctx, const uint8_t *data, uint32_t length);
+void dfu_sha256_final(dfu_sha256_t *ctx, uint8_t digest[DFU_SHA256_SIZE]);
+
+#endif /* DFU_SHA256_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,322 @@
+/******************************************************************************
+ * File Name:   dlog.c
+ *
+ * Description: This file contains the deferred log. Every core writes its records to its own single
+ *              producer lane, so a log call takes no lock shared by the cores and does not wait for
+ *              the UART; the DFU application drains the lanes to the console when there is room in
+ *              the TX FIFO, and a RAM dump of the region can be decoded as well.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "dlog.h"
+
+#if (DLOG)
+#if defined(__arm__)
+#include "cmsis_compiler.h"
+#endif /* __arm__ */
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+#define DLOG_LANE_MASK              (DLOG_LANE_WORDS - 1u)
+
+/* The record of a core is reserved and published with the interrupts
+ * disabled, an interrupt handler may log as well */
+#if defined(__arm__)
+#define DLOG_ENTER(state)           do { (state) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define DLOG_EXIT(state)            __set_PRIMASK(state)
+#else
+#define DLOG_ENTER(state)           ((state) = 0u)
+#define DLOG_EXIT(state)            ((void)(state))
+#endif /* __arm__ */
+
+/* Orders the words of a record and the update of head or tail for the other
+ * core */
+#define DLOG_BARRIER()              __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/*******************************************************************************
+ * Global Variables
+ ********************************************************************************/
+/* Lane of this core and its clock, set by dlog_init() */
+static dlog_lane_t *dlog_own = NULL;
+static uint32_t (*dlog_now)(void) = NULL;
+
+/* Line of dlog_drain() that the output had no room for */
+static char dlog_pending[DLOG_LINE_MAX];
+static uint32_t dlog_pending_length = 0u;
+
+/* Lanes whose clock was written by dlog_drain(), a bit each */
+static uint32_t dlog_clocks_written = 0u;
+
+/*******************************************************************************
+ * Function Name: dlog_region
+ ********************************************************************************
+ * Return:
+ *  The region, at DLOG_ADDR.
+ *******************************************************************************/
+__attribute__((weak))
+dlog_t *dlog_region(void) {
+    return (dlog_t *)DLOG_ADDR;
+}
+
+/*******************************************************************************
+ * Function Name: dlog_init
+ ********************************************************************************
+ * Clears the lane of this core and selects it for dlog_write(). The records
+ * of the previous run of the core are dropped.
+ *
+ * Parameters:
+ *  lane           DLOG_LANE of the core.
+ *  now            Timestamp of a record, NULL if the core has no clock.
+ *  tick_hz        Ticks per second of now().
+ *******************************************************************************/
+void dlog_init(uint32_t lane, uint32_t (*now)(void), uint32_t tick_hz) {
+    dlog_lane_t *own;
+
+    if (lane >= DLOG_LANE_COUNT) {
+        return;
+    }
+    own = &dlog_region()->lanes[lane];
+    own->magic = 0u;
+    DLOG_BARRIER();
+    own->version = DLOG_VERSION;
+    own->words = DLOG_LANE_WORDS;
+    own->head = 0u;
+    own->tail = 0u;
+    own->dropped = 0u;
+    own->tick_hz = (now != NULL) ? tick_hz : 0u;
+    own->seq = 0u;
+    own->reserved = 0u;
+    DLOG_BARRIER();
+    own->magic = DLOG_MAGIC;
+    dlog_now = now;
+    dlog_own = own;
+}
+
+/*******************************************************************************
+ * Function Name: dlog_write
+ ********************************************************************************
+ * Writes a record to the lane of this core, or counts it as dropped if the
+ * lane is full. Called by DLOG_WRITE().
+ *
+ * Parameters:
+ *  level          DLOG_LEVEL_*.
+ *  id             Address of the format string in the .dlog_fmt section.
+ *  args           Arguments.
+ *  count          Number of arguments, up to DLOG_MAX_ARGS.
+ *******************************************************************************/
+void dlog_write(uint32_t level, uint32_t id, const uint32_t *args, uint32_t count) {
+    dlog_lane_t *lane = dlog_own;
+    uint32_t words = DLOG_RECORD_WORDS(count);
+    uint32_t state;
+    uint32_t head;
+
+    if ((lane == NULL) || (count > DLOG_MAX_ARGS)) {
+        return;
+    }
+    DLOG_ENTER(state);
+    head = lane->head;
+    if ((DLOG_LANE_WORDS - (head - lane->tail)) < words) {
+        lane->dropped++;
+    } else {
+        lane->ring[head & DLOG_LANE_MASK] = DLOG_HDR(id, count, level, lane->seq);
+        lane->ring[(head + 1u) & DLOG_LANE_MASK] = (dlog_now != NULL) ? dlog_now() : 0u;
+        for (uint32_t i = 0u; i < count; i++) {
+            lane->ring[(head + 2u + i) & DLOG_LANE_MASK] = args[i];
+        }
+        DLOG_BARRIER();
+        lane->head = head + words;
+    }
+    /* A gap in the sequence numbers shows the dropped records */
+    lane->seq++;
+    DLOG_EXIT(state);
+}
+
+/*******************************************************************************
+ * Function Name: dlog_lane_valid
+ ********************************************************************************
+ * Return:
+ *  true if the lane was set up by dlog_init() of this version.
+ *******************************************************************************/
+bool dlog_lane_valid(const dlog_lane_t *lane) {
+    return (lane->magic == DLOG_MAGIC) && (lane->version == DLOG_VERSION) && (lane->words == DLOG_LANE_WORDS) &&
+           ((uint32_t)(lane->head - lane->tail) <= DLOG_LANE_WORDS);
+}
+
+/*******************************************************************************
+ * Function Name: dlog_read
+ ********************************************************************************
+ * Takes the oldest record of a lane. A lane that is not consistent, written
+ * over by the application or not set up, is emptied.
+ *
+ * Parameters:
+ *  lane           Lane, valid.
+ *  record         Receives the record.
+ *  max_words      Size of record in words, at least
+ *                 DLOG_RECORD_WORDS(DLOG_MAX_ARGS).
+ *
+ * Return:
+ *  Words of the record, 0 if the lane is empty.
+ *******************************************************************************/
+uint32_t dlog_read(dlog_lane_t *lane, uint32_t *record, uint32_t max_words) {
+    uint32_t head = lane->head;
+    uint32_t tail = lane->tail;
+    uint32_t words;
+
+    if ((head == tail) || ((uint32_t)(head - tail) > DLOG_LANE_WORDS)) {
+        lane->tail = head;
+        return 0u;
+    }
+    DLOG_BARRIER();
+    words = DLOG_RECORD_WORDS(DLOG_HDR_COUNT(lane->ring[tail & DLOG_LANE_MASK]));
+    if ((words > DLOG_RECORD_WORDS(DLOG_MAX_ARGS)) || (words > (uint32_t)(head - tail)) || (words > max_words)) {
+        lane->tail = head;
+        return 0u;
+    }
+    for (uint32_t i = 0u; i < words; i++) {
+        record[i] = lane->ring[(tail + i) & DLOG_LANE_MASK];
+    }
+    DLOG_BARRIER();
+    lane->tail = tail + words;
+    return words;
+}
+
+/*******************************************************************************
+ * Function Name: dlog_format_line
+ ********************************************************************************
+ * Formats a record as an output line, "@D<lane>:" and the words in hex. A
+ * single word is the clock of the lane, "@D<lane>=" and the ticks per second.
+ *
+ * Parameters:
+ *  lane           Index of the lane.
+ *  record         Record read by dlog_read().
+ *  words          Words of the record.
+ *  line           Receives the line, DLOG_LINE_MAX bytes, not terminated.
+ *
+ * Return:
+ *  Length of the line.
+ *******************************************************************************/
+uint32_t dlog_format_line(uint32_t lane, const uint32_t *record, uint32_t words, char *line) {
+    static const char hex[] = "0123456789ABCDEF";
+    uint32_t length = 0u;
+
+    line[length++] = DLOG_LINE_PREFIX[0];
+    line[length++] = DLOG_LINE_PREFIX[1];
+    line[length++] = hex[lane & 0xFu];
+    line[length++] = (words == 1u) ? '=' : ':';
+    for (uint32_t i = 0u; i < words; i++) {
+        for (int32_t shift = 28; shift >= 0; shift -= 4) {
+            line[length++] = hex[(record[i] >> shift) & 0xFu];
+        }
+    }
+    line[length++] = '\r';
+    line[length++] = '\n';
+    return length;
+}
+
+/*******************************************************************************
+ * Function Name: dlog_empty
+ ********************************************************************************
+ * Return:
+ *  true if dlog_drain() has nothing left to write.
+ *******************************************************************************/
+bool dlog_empty(void) {
+    if (dlog_pending_length != 0u) {
+        return false;
+    }
+    for (uint32_t i = 0u; i < DLOG_LANE_COUNT; i++) {
+        const dlog_lane_t *lane = &dlog_region()->lanes[i];
+
+        if (dlog_lane_valid(lane) && (lane->head != lane->tail)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: dlog_drain
+ ********************************************************************************
+ * Writes the records of all lanes to the output, a line each, until the
+ * lanes are empty or the output has no room. The line that did not fit is
+ * written first by the next call. The clock of a lane comes before its first
+ * record.
+ *
+ * Parameters:
+ *  out            Output of the lines.
+ *
+ * Return:
+ *  Number of lines written.
+ *******************************************************************************/
+uint32_t dlog_drain(dlog_out_t out) {
+    uint32_t record[DLOG_RECORD_WORDS(DLOG_MAX_ARGS)];
+    uint32_t lines = 0u;
+
+    for (uint32_t i = 0u; i < DLOG_LANE_COUNT; i++) {
+        dlog_lane_t *lane = &dlog_region()->lanes[i];
+
+        for (;;) {
+            uint32_t words;
+
+            if (dlog_pending_length != 0u) {
+                if (!out(dlog_pending, dlog_pending_length)) {
+                    return lines;
+                }
+                dlog_pending_length = 0u;
+                lines++;
+            }
+            if (!dlog_lane_valid(lane)) {
+                break;
+            }
+            if ((dlog_clocks_written & (1uL << i)) == 0u) {
+                dlog_clocks_written |= (1uL << i);
+                dlog_pending_length = dlog_format_line(i, &lane->tick_hz, 1u, dlog_pending);
+                continue;
+            }
+            words = dlog_read(lane, record, DLOG_RECORD_WORDS(DLOG_MAX_ARGS));
+            if (words == 0u) {
+                break;
+            }
+            dlog_pending_length = dlog_format_line(i, record, words, dlog_pending);
+        }
+    }
+    return lines;
+}
+#endif /* DLOG */
+
+/* [] END OF FILE */
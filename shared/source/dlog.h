@@ -0,0 +1,192 @@
+/******************************************************************************
+ * File Name:   dlog.h
+ *
+ * Description: This file contains the declarations of the deferred log: a log call writes a compact
+ *              binary record, the ID of its format string and its arguments, to the lane of its
+ *              core in a RAM region shared by the cores. The format strings stay in the ELF file
+ *              and the host tool dlog_decode turns the records back into text.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2023-2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+#ifndef DLOG_H
+#define DLOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ********************************************************************************/
+/* Set to 1 to defer the messages of the boot and DFU paths, DLOG=1 */
+#ifndef DLOG
+#define DLOG                        (0)
+#endif
+
+/* RAM address of the region, kept over the launch of the CM7 and used by
+ * neither the bootloader nor the DFU application otherwise. The default is
+ * 2 KB below the end of the SRAM */
+#ifndef DLOG_ADDR
+#define DLOG_ADDR                   (0x280FF800uL)
+#endif
+
+#define DLOG_MAGIC                  (0x474F4C44uL)
+#define DLOG_VERSION                (1u)
+
+/* One lane per core, each written by its own core only */
+#define DLOG_LANE_CM0P              (0u)
+#define DLOG_LANE_CM7_0             (1u)
+#define DLOG_LANE_CM7_1             (2u)
+#define DLOG_LANE_COUNT             (3u)
+
+/* Words of the ring of a lane, a power of two */
+#define DLOG_LANE_WORDS             (128u)
+
+/* Record: the header word, the timestamp and up to DLOG_MAX_ARGS arguments */
+#define DLOG_MAX_ARGS               (8u)
+#define DLOG_RECORD_WORDS(count)    (2u + (count))
+
+/* Header word of a record */
+#define DLOG_HDR_ID_Pos             (16u)
+#define DLOG_HDR_COUNT_Pos          (12u)
+#define DLOG_HDR_LEVEL_Pos          (8u)
+#define DLOG_HDR(id, count, level, seq) \
+    ((((uint32_t)(id) & 0xFFFFu) << DLOG_HDR_ID_Pos) | (((uint32_t)(count) & 0xFu) << DLOG_HDR_COUNT_Pos) | \
+     (((uint32_t)(level) & 0xFu) << DLOG_HDR_LEVEL_Pos) | ((uint32_t)(seq) & 0xFFu))
+#define DLOG_HDR_ID(hdr)            ((hdr) >> DLOG_HDR_ID_Pos)
+#define DLOG_HDR_COUNT(hdr)         (((hdr) >> DLOG_HDR_COUNT_Pos) & 0xFu)
+#define DLOG_HDR_LEVEL(hdr)         (((hdr) >> DLOG_HDR_LEVEL_Pos) & 0xFu)
+#define DLOG_HDR_SEQ(hdr)           ((hdr) & 0xFFu)
+
+#define DLOG_LEVEL_ERR              (1u)
+#define DLOG_LEVEL_WRN              (2u)
+#define DLOG_LEVEL_INF              (3u)
+#define DLOG_LEVEL_DBG              (4u)
+
+/* Output line of a drained record: "@D", the lane, ':' and the words in hex */
+#define DLOG_LINE_PREFIX            "@D"
+#define DLOG_LINE_MAX               (4u + (DLOG_RECORD_WORDS(DLOG_MAX_ARGS) * 8u) + 2u)
+
+/* Lane of the core that builds this file */
+#ifndef DLOG_LANE
+#if defined(BOOT_CM0P)
+#define DLOG_LANE                   DLOG_LANE_CM0P
+#elif defined(USER_APP_IMG_ID) && (USER_APP_IMG_ID == 2)
+#define DLOG_LANE                   DLOG_LANE_CM7_1
+#else
+#define DLOG_LANE                   DLOG_LANE_CM7_0
+#endif
+#endif /* DLOG_LANE */
+
+/*
+ * DLOG_WRITE(level, fmt, ...) records a message of printf format fmt. The
+ * format string is placed in the .dlog_fmt section, which the linker scripts
+ * keep in the ELF file only: its offset in the section is the ID of the
+ * message. The arguments are converted to 32-bit words, so they are integers,
+ * characters or addresses; %s prints the address of the string.
+ */
+#if (DLOG)
+#define DLOG_WRITE(level, fmt, ...) \
+    do { \
+        static const char dlog_fmt_[] __attribute__((section(".dlog_fmt"), used, aligned(1))) = fmt; \
+        const uint32_t dlog_args_[] = { 0u, ##__VA_ARGS__ }; \
+        _Static_assert((sizeof(dlog_args_) / sizeof(dlog_args_[0])) <= (DLOG_MAX_ARGS + 1u), \
+                       "too many arguments of a deferred log"); \
+        dlog_write((level), (uint32_t)(uintptr_t)dlog_fmt_, &dlog_args_[1], \
+                   (uint32_t)(sizeof(dlog_args_) / sizeof(dlog_args_[0])) - 1u); \
+    } while (0)
+#else
+#define DLOG_WRITE(level, fmt, ...)
+#endif /* DLOG */
+
+#define DLOG_ERR(fmt, ...)          DLOG_WRITE(DLOG_LEVEL_ERR, fmt, ##__VA_ARGS__)
+#define DLOG_WRN(fmt, ...)          DLOG_WRITE(DLOG_LEVEL_WRN, fmt, ##__VA_ARGS__)
+#define DLOG_INF(fmt, ...)          DLOG_WRITE(DLOG_LEVEL_INF, fmt, ##__VA_ARGS__)
+#define DLOG_DBG(fmt, ...)          DLOG_WRITE(DLOG_LEVEL_DBG, fmt, ##__VA_ARGS__)
+
+/* printf() of the console messages that are deferred with DLOG=1 */
+#if (DLOG)
+#define DLOG_PRINTF(fmt, ...)       DLOG_INF(fmt, ##__VA_ARGS__)
+#else
+#define DLOG_PRINTF(fmt, ...)       printf(fmt, ##__VA_ARGS__)
+#endif
+
+/*******************************************************************************
+ * Data Structures
+ ********************************************************************************/
+/*
+ * Single producer ring of a core. head and tail count the words written and
+ * read since dlog_init(), a record is published by the update of head.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t words;
+    volatile uint32_t head;
+    /* Written by the core that drains the region */
+    volatile uint32_t tail;
+    /* Records that did not fit */
+    volatile uint32_t dropped;
+    /* Ticks per second of the timestamps, 0 if the core has no clock */
+    uint32_t tick_hz;
+    /* Sequence number of the next record */
+    uint32_t seq;
+    uint32_t reserved;
+    uint32_t ring[DLOG_LANE_WORDS];
+} dlog_lane_t;
+
+typedef struct {
+    dlog_lane_t lanes[DLOG_LANE_COUNT];
+} dlog_t;
+
+/* Output of dlog_drain(): queues a whole line and returns true, or returns
+ * false without writing if there is no room for it yet */
+typedef bool (*dlog_out_t)(const char *line, uint32_t length);
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+dlog_t *dlog_region(void);
+void dlog_init(uint32_t lane, uint32_t (*now)(void), uint32_t tick_hz);
+void dlog_write(uint32_t level, uint32_t id, const uint32_t *args, uint32_t count);
+bool dlog_lane_valid(const dlog_lane_t *lane);
+uint32_t dlog_read(dlog_lane_t *lane, uint32_t *record, uint32_t max_words);
+uint32_t dlog_format_line(uint32_t lane, const uint32_t *record, uint32_t words, char *line);
+uint32_t dlog_drain(dlog_out_t out);
+bool dlog_empty(void);
+
+#endif /* DLOG_H */
+
+/* [] END OF FILE */
@@ -32,7 +32,9 @@
 # Include the common make file
 include ../common.mk
 
-# Flashmap JSON file name
+# Flashmap JSON file name. xmc7000_direct_xip_single.json starts the newest
+# image in place from either slot, see XIP_SLOT in common_app.mk;
+# xmc7000_ram_load_single.json copies it to the CM7 SRAM and runs it there
 FLASH_MAP?=xmc7000_overwrite_single.json
 
 # Device family name. Ex: PSOC6, XMC7000
@@ -47,7 +49,8 @@ PLATFORM_CONFIG=$(if $(filter CAT1C4M,$(DEVICE_COMPONENTS)),xmc7100_platform.jso
 
 # Application core ID. 
 # Ex: APP_CORE_ID=0 for user app run by CM7_0, APP_CORE_ID=1 for user app run by CM7_1
-APP_CORE_ID?=0
+# Image 2 of a two-image FLASH_MAP runs on CM7_1 by default.
+APP_CORE_ID?=$(if $(filter 2,$(IMG_ID)),1,0)
 
 # User app core
 APP_CORE=CM7
@@ -58,8 +61,16 @@ APP_CORE=CM7
 # 2. Passed as a parameter to the Python module "imgtool" for signing the image
 #    in the DFU app Makefile. The path of this key file is set in the DFU
 #    app Makefile.
+#
+# cypress-test-ec-p256: EC P-256 signature, verified by MCUboot.
+# cypress-test-ed25519: Ed25519 signature, 64 bytes, verified by the image
+#                       access hooks of the bootloader (boot_ed25519.c).
 SIGN_KEY_FILE=cypress-test-ec-p256
 
+# Signature type of the key file: ED25519 for a key file named *ed25519*,
+# otherwise EC256
+SIGN_KEY_TYPE=$(if $(findstring ed25519,$(SIGN_KEY_FILE)),ED25519,EC256)
+
 # Path of the key file passed as a parameter to the imgtool or cysecuretools for
 # signing the image. Name of the key file is set in shared_config.mk
 # as a common parameter to both the Bootloader app and Blinky app.
@@ -94,14 +105,29 @@ PLATFORM_CHUNK_SIZE=0x200
 
 # Minimum erase size of underlying memory hardware
 PLATFORM_MEMORY_ALIGN=0x200
+
+# Erase sector of the image trailers. The memorymap.mk generated from FLASH_MAP
+# replaces it with the erase size of the region that holds them: the swap
+# status area, else the end of the slots, as in the overwrite mode. The
+# generated memory map header stops the build if a trailer does not fit it.
 PLATFORM_MAX_TRAILER_PAGE_SIZE=0x8000
 
-# Encrypted image support
-# This code example not supported the encrypted image at the moment
-ENC_IMG=0
+# Encrypted upgrade images.
+#
+# 0: the upgrade images are signed only.
+# 1: imgtool encrypts the code of the UPGRADE image with AES-128-CTR and wraps
+#    its key for keys/$(ENC_KEY_FILE)-pub.pem (ECIES-P256, ENC_EC256 TLV). The
+#    bootloader unwraps the key with keys/$(ENC_KEY_FILE).priv, validates the
+#    image decrypted and installs it to the primary slot with its code
+#    decrypted row by row, in the image access hooks. The DFU application
+#    cannot check the digest of an encrypted image and leaves it to the
+#    bootloader. Requires USE_OVERWRITE=1: the swap would move the decrypted
+#    code of the primary slot to the secondary slot.
+ENC_IMG?=0
+ENC_KEY_FILE=cypress-test-enc-p256
 
-ifneq ($(ENC_IMG), 0)
-$(error This code example not supported the encrypted image at the moment)
+ifeq ($(filter $(ENC_IMG),0 1),)
+$(error ENC_IMG must be 0 or 1)
 endif
 
 ################################################################################
@@ -132,6 +158,153 @@ USE_BOOTSTRAP?=1
 # Select transport here, as required.
 SELECTED_TRANSPORT?=I2C
 
+# DFU session loop mode.
+#
+# When set to `1`, the DFU application sleeps until the DFU transport receives
+# data and takes the DFU timeouts from a low power timer tick.
+# When set to `0`, Cy_DFU_Continue() is polled every 20 ms.
+DFU_EVENT_DRIVEN?=0
+
+# Largest flash erase sector, in bytes, whose rows the DFU application
+# compares with the flash before erasing it.
+#
+# Rows equal to the flash and erased rows over erased flash are never
+# programmed, and a sector is erased only if a row differs from it. Sectors
+# up to this size are kept until then, at the cost of a static RAM buffer of
+# this size in the CM7 image; larger sectors are erased at their first row
+# unless they are blank.
+# 0: no buffer, a sector that is not blank is erased at its first row.
+# 0x2000 covers the small sectors of the code flash (8 KB of RAM), 0x8000
+# also the large ones (32 KB of RAM).
+DFU_FLASH_RESTORE_SIZE?=0
+
+# Resumable DFU sessions.
+#
+# 0: a session that fails or times out starts again from the first row.
+# 1: the DFU application records the rows of a plain image programmed so far
+#    in the work flash, every 8 rows. After a reset or a dropped link the host
+#    reads the record with Get Metadata and sends only the rows that follow
+#    it. Requires DFU_FLASH_RESTORE_SIZE other than 0. With two images the
+#    record covers image 1.
+DFU_RESUME?=0
+
+# Sliding window DFU protocol.
+#
+# 0: one command per round trip (stop-and-wait), compatible with the DFU Host Tool.
+# 2, 4, 8, 16 or 32: the host may send that many commands before the first
+#    response. Requires a host that speaks the windowed protocol, such as
+#    the host simulator sender, and the GCC_ARM toolchain.
+DFU_WINDOW_SIZE?=0
+
+# Compressed upgrade images.
+#
+# 0: the DFU application accepts plain images only.
+# 1: the DFU application also accepts compressed images, decompressed into the
+#    secondary slot with a 4 KB window in RAM. The UPGRADE build additionally
+#    produces <APPNAME>_compressed.hex, send it in place of <APPNAME>.hex.
+DFU_COMPRESSION?=0
+
+# Delta upgrade images.
+#
+# 0: no delta images.
+# 1: the DFU application also accepts delta images, rebuilt from the image in
+#    the primary slot and a compressed patch (implies DFU_COMPRESSION=1). The
+#    UPGRADE build additionally produces <APPNAME>_delta.hex against the image
+#    given by DFU_DELTA_BASE, by default the BOOT build of this application.
+DFU_DELTA?=0
+
+# Digest of the upgrade image hashed while it is written.
+#
+# 0: the DFU application checks the upgrade image with the DFU middleware.
+# 1: the DFU application hashes every row as it is written and checks the
+#    digest against the SHA256 TLV of the image instead of reading the slot
+#    back. The bootloader hashes the secondary slot before it upgrades either
+#    way: it does not take a digest from the CM7.
+DFU_HASH_STREAM?=0
+
+# Boot time probes.
+#
+# 0: no probes.
+# 1: the bootloader records the start of every boot phase (BSP and
+#    retarget-io initialization, boot_go with the header reads, validations
+#    and updates, WDT initialization, launch) in microseconds, in a table
+#    near the end of the SRAM (BOOT_TIMING_ADDR). The DFU application prints
+#    it at the start.
+BOOT_TIMING?=0
+BOOT_TIMING_ADDR=$(if $(filter XMC7100,$(PLATFORM)),0x280BFE80,0x280FFE80)
+
+# Image hashing on the CM7 at boot.
+#
+# 0: the CM0+ hashes every slot it validates.
+# 1: the bootloader starts a hashing stub of its own image on the CM7 core of
+#    the application, which hashes the slot while the CM0+ reads the TLVs and
+#    finds the key, and returns the digest in the non-cacheable SRAM at
+#    BOOT_CM7_HASH_ADDR (2 KB, used only until the launch). The CM0+ verifies
+#    the signature over it. The CM0+ hashes the slot itself if the stub stalls.
+BOOT_CM7_HASH?=0
+BOOT_CM7_HASH_ADDR=$(if $(filter XMC7100,$(PLATFORM)),0x280A0000,0x280E0000)
+
+# Crypto backend of the image validation in the bootloader hooks and of the
+# digest of the DFU application (shared/source/boot_crypto.c).
+#
+# SW: SHA-256 and ECDSA P-256 in software, the MCUboot validation is unchanged.
+# HW: SHA-256 and ECDSA P-256 on the crypto block. The bootloader hashes the
+#     memory mapped slot and verifies the EC P-256 signature on it, with the
+#     MCUboot validation as the fallback.
+BOOT_CRYPTO?=SW
+
+# Set to 1 to run the known-answer tests of the crypto backend at the start of
+# the DFU application. The host runs them with host/build/crypto_bench.
+BOOT_CRYPTO_KAT?=0
+
+# Swap of the slots in the swap upgrade mode.
+#
+# 0: the MCUboot swap using scratch.
+# 1: the journaled swap of the bootloader: whole 32 KB sectors move in three
+#    steps, or two when the sector is erased in one slot, through a slot
+#    sector erased in both slots if there is one, else the scratch area. One
+#    journal entry per sector in the work flash at BOOT_SWAP_JOURNAL_ADDR
+#    replaces the status updates of every step. Requires USE_OVERWRITE=0.
+BOOT_SWAP_JOURNAL?=0
+BOOT_SWAP_JOURNAL_ADDR=0x14032800
+
+# Fast boot profile of the bootloader.
+#
+# 0: the bootloader initializes retarget-io, clears the terminal and prints
+#    its messages and those of MCUboot on every boot.
+# 1: the bootloader reads the image headers and trailers first. When no image
+#    has an upgrade or a revert pending or a swap interrupted, it runs boot_go()
+#    and launches the CM7 application without initializing the console. The
+#    console is initialized on the upgrade and recovery paths and at the first
+#    error. MCUboot is built without messages, which could come before the
+#    console is initialized (MCUBOOT_LOG_LEVEL is ignored); set DLOG=1 to keep
+#    the messages of the boot path.
+BOOT_FAST?=0
+
+ifeq ($(filter $(BOOT_FAST),0 1),)
+$(error BOOT_FAST must be 0 or 1)
+endif
+
+# Deferred log.
+#
+# 0: the bootloader and the DFU application print their messages with
+#    retarget-io and wait for the UART.
+# 1: the messages of the boot path (bootloader main.c) and of the DFU session
+#    are written as binary records, the ID of the format string and the
+#    arguments, to a lane per core in the SRAM at DLOG_ADDR (1632 bytes),
+#    which must not be used otherwise. The format strings are kept in the ELF
+#    files only. The DFU application drains the lanes to the console as "@D"
+#    lines when the TX FIFO has room, and host/build/dlog_decode prints them
+#    with the ELF files. The errors are printed as they occur, and MCUboot
+#    prints its errors only. The records of the bootloader are timestamped
+#    with BOOT_TIMING=1.
+DLOG?=0
+DLOG_ADDR=$(if $(filter XMC7100,$(PLATFORM)),0x280BF800,0x280FF800)
+
+ifeq ($(filter $(DLOG),0 1),)
+$(error DLOG must be 0 or 1)
+endif
+
 # image type can be BOOT or UPGRADE
 IMG_TYPES:=BOOT UPGRADE
 
@@ -144,9 +317,16 @@ IMG_TYPES:=BOOT UPGRADE
 #          --pad argument is passed to the imgtool or cysecuretools.
 IMG_TYPE?=BOOT
 
-# Image ID
-IMG_ID=1
+# Image ID.
+#
+# 1: the DFU application, run by CM7_0.
+# 2: the image of CM7_1 in a two-image FLASH_MAP such as
+#    xmc7000_overwrite_multi.json. It is built from this application without
+#    the DFU transport and only blinks its LED. The DFU application of image 1
+#    updates both images in one session, and the bootloader validates both
+#    and launches both cores.
+IMG_ID?=1
 
-ifneq ($(IMG_ID), 1)
-$(error This code example not supported the multi-image configuration at the moment)
+ifeq ($(filter $(IMG_ID),1 2),)
+$(error IMG_ID must be 1 or 2)
 endif